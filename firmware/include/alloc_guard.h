@@ -0,0 +1,57 @@
+/*
+  Allocation Guard for Chess Clock
+
+  This file defines a debug check that no heap memory is allocated while
+  a player's time is running. Build the esp32-s3-allocguard environment:
+  it defines ALLOC_GUARD and wraps malloc, calloc, realloc and the
+  heap_caps variants with the linker, so every allocation of the watched
+  tasks is checked. The tasks on the way from a press to the screen
+  (time, render, SPI bus and touch) watch themselves; the network and
+  flash writer tasks are left out on purpose, WiFi and NVS allocate.
+  While the guard is armed, an allocation is logged with its caller
+  address and aborts the firmware (see ALLOC_GUARD_ABORT).
+
+  Without ALLOC_GUARD all functions are empty and cost nothing.
+*/
+
+#ifndef ALLOC_GUARD_H
+#define ALLOC_GUARD_H
+
+#include <stdint.h>
+
+#define ALLOC_GUARD_MAX_TASKS 8
+
+#ifdef ALLOC_GUARD
+
+/**
+ * @brief Add the calling task to the watched tasks
+ *
+ * Call it once at the start of the task, at most ALLOC_GUARD_MAX_TASKS
+ * tasks are watched.
+ */
+void allocGuardWatchCurrentTask();
+
+/**
+ * @brief Arm or disarm the guard
+ *
+ * @param armed true while a player's time is running
+ */
+void allocGuardSetArmed(bool armed);
+
+/**
+ * @brief Number of allocations seen while the guard was armed
+ */
+uint32_t allocGuardViolations();
+
+inline bool allocGuardEnabled() { return true; }
+
+#else
+
+inline void allocGuardWatchCurrentTask() {}
+inline void allocGuardSetArmed(bool) {}
+inline uint32_t allocGuardViolations() { return 0; }
+inline bool allocGuardEnabled() { return false; }
+
+#endif // ALLOC_GUARD
+
+#endif // ALLOC_GUARD_H
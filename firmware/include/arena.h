@@ -0,0 +1,76 @@
+/*
+  Arena Allocator for Chess Clock
+
+  This file defines a simple bump allocator. One block is allocated up
+  front (normally from PSRAM) and handed out piece by piece; everything
+  is given back at once by reset() or release(). There is no per-object
+  free, which means no fragmentation and constant-time allocation.
+*/
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <new>
+
+class Arena {
+public:
+  Arena();
+  ~Arena();
+
+  /**
+   * @brief Allocate the backing block
+   *
+   * @param capacity Size of the block in bytes
+   * @param caps heap_caps flags, e.g. MALLOC_CAP_SPIRAM
+   * @return true if the block could be allocated
+   */
+  bool begin(size_t capacity, uint32_t caps);
+
+  /**
+   * @brief Free the backing block
+   */
+  void release();
+
+  /**
+   * @brief Forget all allocations but keep the backing block
+   */
+  void reset();
+
+  /**
+   * @brief Allocate raw memory from the arena
+   *
+   * @param size Number of bytes
+   * @param alignment Power of two alignment
+   * @return void* Memory or nullptr if the arena is exhausted
+   */
+  void* allocate(size_t size, size_t alignment = alignof(max_align_t));
+
+  /**
+   * @brief Allocate and construct an object
+   *
+   * The destructor is never called, only use it for trivially
+   * destructible types.
+   */
+  template <typename T, typename... Args>
+  T* create(Args&&... args) {
+    void* memory = allocate(sizeof(T), alignof(T));
+    return memory != nullptr ? new (memory) T(static_cast<Args&&>(args)...) : nullptr;
+  }
+
+  bool isReady() const { return block != nullptr; }
+  size_t capacity() const { return size; }
+  size_t used() const { return offset; }
+  size_t highWater() const { return peak; }
+  uint32_t failedAllocations() const { return failures; }
+
+private:
+  uint8_t* block;
+  size_t size;
+  size_t offset;
+  size_t peak;
+  uint32_t failures;
+};
+
+#endif // ARENA_H
@@ -0,0 +1,140 @@
+/*
+  Asset Pack for Chess Clock
+
+  This file defines the reader of CAP1 asset packs created by
+  tools/asset_pack.py: images and animations as palette indices or RGB565
+  pixels, every frame compressed on its own with LZSS. AssetDecoder
+  produces a frame row by row into a caller buffer, so only the rows of
+  one band are ever held in RAM; the compressed data is pulled through a
+  small input buffer.
+
+  Like the delta patch decoder, the classes contain no Arduino code. All
+  file access goes through the read callback given to AssetPack::open().
+*/
+
+#ifndef ASSET_PACK_H
+#define ASSET_PACK_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "config.h"
+
+#define ASSET_NAME_LENGTH 16
+
+/**
+ * @brief Read bytes of the asset pack
+ *
+ * @return true if all bytes could be read
+ */
+typedef bool (*AssetReadCallback)(void* context, uint32_t offset, uint8_t* target, uint32_t length);
+
+/**
+ * @brief Index entry of one asset
+ */
+struct AssetInfo {
+  char name[ASSET_NAME_LENGTH + 1];
+  uint16_t width;
+  uint16_t height;
+  uint16_t frames;                // 1 for a still image
+  uint16_t paletteSize;           // 0: two bytes RGB565 per pixel
+  uint32_t paletteOffset;
+  uint32_t frameTableOffset;      // frames + 1 offsets of the compressed frames
+};
+
+class AssetPack {
+public:
+  AssetPack();
+
+  /**
+   * @brief Read and check the header
+   *
+   * @return true if it is a CAP1 pack the decoder can handle
+   */
+  bool open(AssetReadCallback read, void* context);
+
+  /**
+   * @brief Find an asset by name
+   *
+   * @return int32_t Index or -1
+   */
+  int32_t find(const char* name) const;
+
+  /**
+   * @brief Read the index entry of an asset
+   */
+  bool info(uint16_t index, AssetInfo* info) const;
+
+  bool read(uint32_t offset, uint8_t* target, uint32_t length) const;
+
+  bool isOpen() const { return reader != nullptr; }
+  uint16_t count() const { return assetCount; }
+  uint8_t windowBits() const { return window; }
+  uint8_t lookaheadBits() const { return lookahead; }
+
+private:
+  AssetReadCallback reader;
+  void* readerContext;
+  uint16_t assetCount;
+  uint8_t window;
+  uint8_t lookahead;
+};
+
+class AssetDecoder {
+public:
+  AssetDecoder();
+
+  /**
+   * @brief Start decoding one frame of an asset
+   *
+   * @return true if the asset and frame exist
+   */
+  bool begin(const AssetPack& pack, const AssetInfo& info, uint16_t frame);
+
+  /**
+   * @brief Decode the next rows of the frame
+   *
+   * Pixels are RGB565 in display byte order (high byte first), ready for
+   * a DMA transfer.
+   *
+   * @param target Space for rows * width pixels
+   * @param rows Maximum number of rows
+   * @return uint16_t Rows produced, 0 at the end of the frame or on an error
+   */
+  uint16_t readRows(uint16_t* target, uint16_t rows);
+
+  bool failed() const { return error; }
+  uint16_t rowsLeft() const { return height - row; }
+
+private:
+  bool nextByte(uint8_t* value);
+  bool readBits(uint8_t count, uint32_t* value);
+  bool refill();
+
+  const AssetPack* source;
+  uint16_t width;
+  uint16_t height;
+  uint16_t row;
+  bool indexed;
+  bool error;
+
+  // Compressed input
+  uint32_t inputPosition;         // Next byte to read from the pack
+  uint32_t inputEnd;
+  uint8_t input[ASSET_INPUT_BUFFER_SIZE];
+  uint16_t inputLength;
+  uint16_t inputIndex;
+
+  // LZSS state
+  uint32_t bitBuffer;
+  uint8_t bitCount;
+  uint8_t windowBits;
+  uint8_t lookaheadBits;
+  uint16_t windowHead;
+  uint16_t matchDistance;
+  uint16_t matchLeft;
+  uint8_t window[1 << ASSET_MAX_WINDOW_BITS];
+
+  uint16_t palette[256];
+};
+
+#endif // ASSET_PACK_H
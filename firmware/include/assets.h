@@ -0,0 +1,69 @@
+/*
+  Assets for Chess Clock
+
+  This file defines drawing of the images and animations in the asset
+  pack (ASSET_PACK_FILE in SPIFFS, see tools/asset_pack.py). A frame is
+  decompressed band by band into two small DMA buffers: while the SPI
+  bus sends one band, the next one is decoded into the other buffer. No
+  full frame is ever held in RAM.
+*/
+
+#ifndef ASSETS_H
+#define ASSETS_H
+
+#include <stdint.h>
+#include "asset_pack.h"
+
+/**
+ * @brief Drawing statistics
+ */
+struct AssetStats {
+  uint32_t framesDrawn;
+  uint32_t failures;              // Missing assets or corrupt data
+  uint32_t maxFrameUs;            // Slowest frame (decode + transfer)
+  uint64_t totalFrameUs;
+  uint64_t totalDecodeUs;         // Part of the frame time spent decoding
+  uint64_t pixels;
+};
+
+/**
+ * @brief Open the asset pack and allocate the band buffers
+ *
+ * SPIFFS must already be mounted.
+ *
+ * @return true if the pack could be opened
+ */
+bool assetsInit();
+
+/**
+ * @brief Look up an asset
+ *
+ * @return true if the pack contains the asset
+ */
+bool assetsFind(const char* name, AssetInfo* info);
+
+/**
+ * @brief Draw one frame of an asset
+ *
+ * Waits until the frame was sent. Must not be called while the bus is
+ * held with spiBusAcquire().
+ *
+ * @param name Asset name given to the packer
+ * @param frame Frame of an animation, 0 for an image
+ * @param x Left edge on the screen
+ * @param y Top edge on the screen
+ * @return true if the frame was drawn
+ */
+bool assetsDraw(const char* name, uint16_t frame, int32_t x, int32_t y);
+
+/**
+ * @brief Statistics since boot
+ */
+const AssetStats& assetsStats();
+
+/**
+ * @brief Print frame times and decode throughput
+ */
+void assetsPrintStats();
+
+#endif // ASSETS_H
@@ -0,0 +1,47 @@
+/*
+  Boot Sequence for Chess Clock
+
+  This file defines the init graph that brings up the subsystems at boot.
+  Each phase runs in its own short-lived task on the configured core as
+  soon as the phases it depends on are done, so independent subsystems
+  (display, WiFi, storage, ...) start in parallel on both cores.
+
+  Every phase is timed in microseconds since reset. The clock counts as
+  usable when all phases marked as required are done; slower background
+  phases may still be running at that point.
+*/
+
+#ifndef BOOT_H
+#define BOOT_H
+
+#include <stdint.h>
+#include "boot_graph.h"
+
+/**
+ * @brief Start all phases of the init graph
+ *
+ * @param phases The phases, dependencies must point to lower indices
+ * @param count Number of phases (max. BOOT_MAX_PHASES)
+ * @return true if the table is valid and all phase tasks could be started
+ */
+bool bootStart(const BootPhase* phases, uint8_t count);
+
+/**
+ * @brief Wait until all required phases are done
+ *
+ * @param timeoutMs Maximum time to wait
+ * @return true if all required phases finished successfully
+ */
+bool bootWaitUntilUsable(uint32_t timeoutMs);
+
+/**
+ * @brief Check whether every phase (including background ones) is done
+ */
+bool bootFinished();
+
+/**
+ * @brief Print per-phase timings and the time until the clock was usable
+ */
+void bootPrintReport();
+
+#endif // BOOT_H
@@ -0,0 +1,111 @@
+/*
+  Boot Graph for Chess Clock
+
+  This file defines the bookkeeping of the init graph (see boot.h): the
+  phases, which of them are done or failed and how long each one took.
+  Phases finish concurrently on both cores, so the done and failed masks
+  are atomic and only ever grow with fetch_or. A phase whose dependency
+  failed is skipped and counts as failed itself, so the failure reaches
+  everything that depends on it.
+
+  The class contains no Arduino code. Waiting for dependencies, the
+  tasks and the time source belong to the caller.
+*/
+
+#ifndef BOOT_GRAPH_H
+#define BOOT_GRAPH_H
+
+#include <stdint.h>
+#include <atomic>
+
+#define BOOT_MAX_PHASES 16
+
+/**
+ * @brief One node of the init graph
+ */
+struct BootPhase {
+  const char* name;               // Name shown in the boot report
+  bool (*init)();                 // Init function, returns false on error
+  int8_t core;                    // Core to run on (0, 1, or -1 for any)
+  uint32_t dependsOn;             // Bit mask of phase indices that must finish first
+  bool required;                  // Clock is not usable before this phase is done
+  uint32_t stackSize;             // Stack of the phase task in bytes
+};
+
+/**
+ * @brief Bit of a phase index for BootPhase::dependsOn
+ */
+#define BOOT_AFTER(index) (1UL << (index))
+
+/**
+ * @brief Measured timing of one phase
+ */
+struct BootPhaseTiming {
+  int64_t startUs;                // Since reset
+  int64_t endUs;
+  int8_t core;                    // Core the phase actually ran on
+  bool ok;
+  bool skipped;                   // Not run because a dependency failed
+};
+
+class BootGraph {
+public:
+  BootGraph();
+
+  /**
+   * @brief Set the phases, before any of them runs
+   *
+   * @param phases The phases, dependencies must point to lower indices
+   * @param count Number of phases (max. BOOT_MAX_PHASES)
+   * @return false if the table is too long or a dependency points forward
+   */
+  bool begin(const BootPhase* phases, uint8_t count);
+
+  /**
+   * @brief Run one phase whose dependencies are done
+   *
+   * Calls its init function unless a dependency failed. May be called
+   * for different phases at the same time.
+   *
+   * @param index Phase index
+   * @param core Core the caller runs on
+   * @param now Returns the current time in microseconds
+   * @return true if the phase succeeded
+   */
+  bool run(uint8_t index, int8_t core, int64_t (*now)());
+
+  /**
+   * @brief Mark a phase as failed without running it (e.g. no task)
+   */
+  void fail(uint8_t index);
+
+  const BootPhase& phase(uint8_t index) const { return phases[index]; }
+  const BootPhaseTiming& timing(uint8_t index) const { return timings[index]; }
+  uint8_t count() const { return phaseCount; }
+
+  uint32_t allMask() const { return all; }
+  uint32_t requiredMask() const { return required; }
+  uint32_t doneMask() const { return done.load(std::memory_order_acquire); }
+  uint32_t failedMask() const { return failed.load(std::memory_order_acquire); }
+
+  /**
+   * @brief All required phases are done and none of them failed
+   */
+  bool usable() const;
+
+  /**
+   * @brief Every phase is done
+   */
+  bool finished() const { return (doneMask() & all) == all; }
+
+private:
+  const BootPhase* phases;
+  uint8_t phaseCount;
+  uint32_t all;
+  uint32_t required;
+  std::atomic<uint32_t> done;
+  std::atomic<uint32_t> failed;
+  BootPhaseTiming timings[BOOT_MAX_PHASES];
+};
+
+#endif // BOOT_GRAPH_H
@@ -0,0 +1,73 @@
+/*
+  Checkpoint for Chess Clock
+
+  This file defines saving and restoring of the running game (see
+  game_checkpoint.h for the encoding). Every snapshot goes to RTC slow
+  memory at once, which survives resets and brown-outs and costs no
+  flash wear. The flash copy in NVS only covers a complete power loss:
+  it is written by the flash writer (see flash_writer.h), at most every
+  CHECKPOINT_FLASH_MIN_INTERVAL_MS while a time runs, and snapshots in
+  between are coalesced into the next write. When a game ends, the RTC
+  slots are marked as ended first, so a reset before the flash copy is
+  erased does not resume the finished game.
+*/
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <stdint.h>
+#include "game_checkpoint.h"
+
+/**
+ * @brief Checkpoint statistics since boot
+ */
+struct CheckpointStats {
+  uint32_t rtcWrites;
+  uint32_t restoreUs;             // Time since reset when the resumed game entered PAUSE
+  CheckpointSource source;        // Where the resumed game came from
+};
+
+/**
+ * @brief Read the snapshot left by the last run
+ *
+ * Called first thing in setup(), before the boot phases.
+ *
+ * @param snapshot Filled with the game to resume
+ * @return true if there is a game to resume
+ */
+bool checkpointRestore(GameSnapshot* snapshot);
+
+/**
+ * @brief Note that the resumed game is in PAUSE, measures restoreUs
+ */
+void checkpointResumed();
+
+/**
+ * @brief Save a snapshot to RTC memory
+ *
+ * Only copies 16 bytes, can be called from the time task.
+ *
+ * @param snapshot Current game, sequence is set here
+ * @param toFlash Also schedule a flash copy (after a move or pause, not on periodic refreshes)
+ */
+void checkpointSave(const GameSnapshot& snapshot, bool toFlash);
+
+/**
+ * @brief Forget the game, it ended normally
+ *
+ * Writes "ended" snapshots to both RTC slots and schedules the erase of
+ * the flash copy.
+ */
+void checkpointClear();
+
+/**
+ * @brief Statistics since boot
+ */
+const CheckpointStats& checkpointStats();
+
+/**
+ * @brief Print writes, coalesced snapshots and the restore time
+ */
+void checkpointPrintStats();
+
+#endif // CHECKPOINT_H
@@ -0,0 +1,68 @@
+/*
+  Clock Bus for Chess Clock
+
+  This file defines the events that the state machine publishes on the
+  event bus (see event_bus.h) and the bus instance. Modules that react
+  to the clock subscribe in the table of main.cpp instead of being
+  called from the state machine; their handlers run in their own tasks,
+  so the time task only pays for handing out one pointer per subscriber.
+*/
+
+#ifndef CLOCK_BUS_H
+#define CLOCK_BUS_H
+
+#include <stdint.h>
+#include "config.h"
+#include "event_bus.h"
+#include "state_machine.h"
+#include "time_engine.h"
+
+/**
+ * @brief Topics, one bit each
+ */
+enum ClockTopic : uint32_t {
+  TOPIC_STATE = 1UL << 0,         // State transition
+  TOPIC_MOVE = 1UL << 1,          // A player finished a move
+};
+
+/**
+ * @brief One published event
+ */
+struct ClockBusEvent {
+  ClockTopic topic;
+  ChessClockState state;          // State after the event
+  ChessClockState previous;       // State before a transition
+  Side side;                      // Player who moved
+  uint32_t moveMs;                // Time the move took
+  uint32_t whiteMs;               // Remaining time at the event
+  uint32_t blackMs;
+  int64_t timestampUs;            // esp_timer time of the event
+};
+
+typedef EventBus<ClockBusEvent, CLOCK_BUS_POOL_SIZE, CLOCK_BUS_MAX_SUBSCRIBERS, CLOCK_BUS_INBOX_LENGTH> ClockBus;
+
+extern ClockBus clockBus;
+
+/**
+ * @brief Set the subscriber table, the owner of a subscriber is its task
+ *        index in the task topology
+ *
+ * @param subscribers The subscribers, must stay valid
+ * @param count Number of subscribers (max. CLOCK_BUS_MAX_SUBSCRIBERS)
+ * @return true if the table fits
+ */
+bool clockBusStart(const ClockBus::Subscriber* subscribers, uint8_t count);
+
+/**
+ * @brief Handle the events waiting for all subscribers of a task
+ *
+ * @param task Index of the calling task in the task topology
+ */
+void clockBusDrain(uint8_t task);
+
+/**
+ * @brief Print delivery latency and drops of every subscriber
+ */
+void clockBusPrintStats();
+
+#endif // CLOCK_BUS_H
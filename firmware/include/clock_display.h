@@ -0,0 +1,70 @@
+/*
+  Clock Display for Chess Clock
+
+  This file defines the game screen: the remaining time of both players
+  side by side, the side whose time runs highlighted. It draws into the
+  shadow screen (see shadow_screen.h), so a frame only sends the tiles
+  of the digits that changed.
+
+  When frames are drawn is decided by the frame governor (see
+  frame_governor.h): one frame per second, on the second boundary, while
+  whole seconds are shown, tenths or hundredths below
+  CLOCK_FINE_BELOW_MS, and nothing at all while the clock is stopped.
+*/
+
+#ifndef CLOCK_DISPLAY_H
+#define CLOCK_DISPLAY_H
+
+#include <stdint.h>
+#include "frame_governor.h"
+#include "time_engine.h"
+
+/**
+ * @brief Frame statistics since boot
+ */
+struct ClockDisplayStats {
+  uint32_t frames;
+  uint32_t maxFrameUs;            // Slowest frame (drawing + push)
+  uint64_t totalFrameUs;
+};
+
+/**
+ * @brief Configure the frame governor
+ */
+void clockDisplayInit();
+
+/**
+ * @brief Switch between the normal and the power saving frame rate cap
+ */
+void clockDisplaySetPower(FramePower power);
+
+/**
+ * @brief Draw the whole screen with the next frame (state change, press)
+ */
+void clockDisplayInvalidate();
+
+/**
+ * @brief Draw a frame if one is due
+ *
+ * @param engine Remaining times and the active side
+ * @param white Name of white, may be empty
+ * @param black Name of black, may be empty
+ * @param banner Shown below the times (start, pause), nullptr for none
+ * @param nowUs Current time
+ * @return int64_t Time of the next frame, INT64_MAX if nothing will change
+ */
+int64_t clockDisplayRun(const TimeEngine& engine, const char* white, const char* black, const char* banner,
+                        int64_t nowUs);
+
+/**
+ * @brief Statistics since boot
+ */
+const ClockDisplayStats& clockDisplayStats();
+const FrameGovernorStats& clockDisplayGovernorStats();
+
+/**
+ * @brief Print frame counts, frame times and how late frames started
+ */
+void clockDisplayPrintStats();
+
+#endif // CLOCK_DISPLAY_H
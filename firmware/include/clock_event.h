@@ -0,0 +1,90 @@
+/*
+  Clock Events for Chess Clock
+
+  This file defines the small objects that are passed around while a
+  game runs: input and timer events. They come from a fixed-size pool,
+  so creating them never touches the heap and works from interrupt
+  handlers.
+
+  Events from all sources (edge capture, flag alarm, touch, ...) are posted to
+  one queue and handled by the main loop in the order they were posted.
+*/
+
+#ifndef CLOCK_EVENT_H
+#define CLOCK_EVENT_H
+
+#include <stdint.h>
+#include "config.h"
+#include "object_pool.h"
+
+/**
+ * @brief Kind of a clock event
+ */
+enum class ClockEventType : uint8_t {
+  NONE,
+  BUTTON_PRESSED,                 // Main button
+  BUTTON_RELEASED,
+  ROCKER_WHITE,                   // Rocker moved to white's side
+  ROCKER_BLACK,                   // Rocker moved to black's side
+  FLAG_FALL,                      // A player's time ran out
+  LATENCY_PROBE,                  // Synthetic event of the latency benchmark
+  TOUCH_GESTURE                   // value: TouchGestureType (see touch_filter.h)
+};
+
+/**
+ * @brief One input or timer event
+ */
+struct ClockEvent {
+  ClockEventType type;
+  uint8_t source;                 // Pin or timer that produced the event
+  uint32_t value;                 // Type specific, e.g. remaining milliseconds
+  int64_t timestampUs;            // esp_timer time of the event
+};
+
+extern ObjectPool<ClockEvent, CLOCK_EVENT_POOL_SIZE> clockEventPool;
+
+/**
+ * @brief Create the event queue
+ *
+ * @return true if the queue could be created
+ */
+bool clockEventQueueInit();
+
+/**
+ * @brief Post an event from a task
+ *
+ * The event is released to the pool if the queue is full.
+ *
+ * @param event Event from clockEventPool
+ * @return true if the event was queued
+ */
+bool clockEventPost(ClockEvent* event);
+
+/**
+ * @brief Post an event from an interrupt handler
+ *
+ * @param event Event from clockEventPool
+ * @param woken Set to true if a higher priority task was woken
+ * @return true if the event was queued
+ */
+bool clockEventPostFromIsr(ClockEvent* event, bool* woken);
+
+/**
+ * @brief Take the next event
+ *
+ * @return ClockEvent* The event (give it back with clockEventPool.release)
+ *         or nullptr if no event is waiting
+ */
+ClockEvent* clockEventNext();
+
+#define CLOCK_EVENT_WAIT_FOREVER UINT32_MAX
+
+/**
+ * @brief Wait for the next event
+ *
+ * @param timeoutMs Maximum wait or CLOCK_EVENT_WAIT_FOREVER
+ * @return ClockEvent* The event or nullptr on timeout
+ */
+ClockEvent* clockEventWait(uint32_t timeoutMs);
+
+#endif // CLOCK_EVENT_H
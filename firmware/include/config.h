@@ -10,6 +10,28 @@
 
 // System Configuration
 #define SERIAL_BAUD_RATE 115200             // Serial monitor baud rate
+#define BOOT_USABLE_BUDGET_MS 300           // Boot report warns if the clock is usable later
+#define BOOT_TIMEOUT_MS     5000            // Max. wait for the required boot phases
+#define BOOT_PHASE_PRIORITY 2               // Priority of the boot phase tasks
+
+// WiFi Configuration
+#define WIFI_SSID           ""              // Leave empty to run without WiFi
+#define WIFI_PASSWORD       ""
+
+// Wall Clock Configuration (IDLE time display)
+#define NTP_SERVER          "pool.ntp.org"  // SNTP server (may be a local host)
+#define NTP_PORT            123             // SNTP server port
+#define NTP_TIMEOUT_MS      1000            // Timeout for a single SNTP reply
+#define SNTP_LOCAL_PORT     2390            // Local UDP port for SNTP replies
+#define TIMEZONE            "CET-1CEST,M3.5.0,M10.5.0/3" // POSIX TZ string
+#define WALL_CLOCK_BURST_SIZE       4       // Requests per sync, best one is used
+#define WALL_CLOCK_MIN_POLL_S       64      // Shortest interval between syncs
+#define WALL_CLOCK_MAX_POLL_S       14400   // Longest interval between syncs (4 h)
+#define WALL_CLOCK_RETRY_S          30      // Retry interval after a failed sync
+#define WALL_CLOCK_MAX_DELAY_MS     500     // Samples with a longer round trip are dropped
+#define WALL_CLOCK_TARGET_ERROR_MS  50      // Prediction error that still widens the interval
+#define WALL_CLOCK_STEP_THRESHOLD_MS 2000   // Larger errors restart the drift estimation
+#define WALL_CLOCK_MAX_DRIFT_PPM    200     // Limit for the estimated oscillator drift
 
 // NFC Configuration
 #define NFC_IRQ_PIN         8               // PN532 IRQ pin
@@ -17,16 +39,150 @@
 
 // Display Configuration
 #define TFT_BACKLIGHT_PIN   1               // TFT backlight pin (PWM capable)
+#define LVGL_DRAW_BUFFER_LINES 20           // Lines per LVGL draw buffer (2 buffers, internal RAM)
+#define SPI_BUS_CHUNK_LINES 8               // Lines per DMA chunk, touch waits at most one chunk
+
+// Touch Configuration (XPT2046, TOUCH_CS in platformio.ini)
+#define TOUCH_IRQ_PIN       18              // PENIRQ of the XPT2046 (active low)
+#define TOUCH_SAMPLE_MS     10              // Sample interval while the pen is down
+#define TOUCH_OVERSAMPLE    5               // Raw readings per sample, the median is used
+#define TOUCH_BUS_TIMEOUT_MS 100            // Max. wait for the bus task to run a sample
+#define TOUCH_Z_THRESHOLD   300             // Minimum pressure of a valid sample
+#define TOUCH_IIR_SHIFT     2               // Smoothing: new = old + (sample - old) / 2^shift
+#define TOUCH_CAL_RAW_X_MIN 300             // Raw values at the screen edges
+#define TOUCH_CAL_RAW_X_MAX 3800
+#define TOUCH_CAL_RAW_Y_MIN 300
+#define TOUCH_CAL_RAW_Y_MAX 3800
+#define TOUCH_CAL_SWAP_XY   1               // Raw X runs along the screen's Y axis (landscape)
+#define TOUCH_CAL_INVERT_X  0
+#define TOUCH_CAL_INVERT_Y  1
+#define TOUCH_TAP_MAX_MS    300             // Longer touches are no tap
+#define TOUCH_LONG_PRESS_MS 800             // Holding still this long is a long press
+#define TOUCH_MOVE_MAX_PX   10              // Movement still counted as holding still
+#define TOUCH_SWIPE_MIN_PX  40              // Minimum travel of a swipe
+#define TOUCH_GESTURE_QUEUE_LENGTH 4        // Gestures waiting for the render task
+
+// Player Configuration
+#define PLAYER_NAME_MAX_LENGTH 24           // Max. characters of first and last name
+#define PLAYER_ROSTER_FILE  "/players.txt"  // Club roster in SPIFFS, one "First Last" per line
+#define PLAYER_ROSTER_MAX   4096            // Max. players (4 bytes each in PSRAM)
+#define PLAYER_LIST_CACHE_ROWS 16           // Rendered rows kept in PSRAM
+#define PLAYER_LIST_ROW_PADDING 2           // Lines above and below the name of a row
+
+// Font Configuration
+#define PLAYER_FONT_FILE    "/PlayerFont20.vlw" // Smooth font for names (TFT_eSPI vlw) in SPIFFS
+#define PLAYER_FONT_MAX_GLYPHS 400          // Size of the glyph metrics table (PSRAM)
+#define GLYPH_CACHE_SIZE    (96 * 1024)     // Decoded glyph bitmaps (PSRAM)
+
+// Asset Configuration (tools/asset_pack.py)
+#define ASSET_PACK_FILE     "/assets.cap"   // Compressed images and animations in SPIFFS
+#define ASSET_MAX_WINDOW_BITS 11            // Largest LZSS history accepted (2 KB)
+#define ASSET_INPUT_BUFFER_SIZE 512         // Compressed bytes read from SPIFFS at once
+#define ASSET_BAND_LINES    8               // Lines per DMA band (two bands in internal RAM)
+#define ASSET_MAX_WIDTH     320             // Widest asset that can be drawn
+
+// Checkpoint Configuration (resume a game after a reset or power loss)
+#define CHECKPOINT_REFRESH_MS 250           // RTC copy of the running time
+#define CHECKPOINT_FLASH_MIN_INTERVAL_MS 10000 // Min. time between two flash copies during a game
+#define CHECKPOINT_NVS_NAMESPACE "clock"    // NVS namespace of the flash copy
+#define CHECKPOINT_FLASH_BUDGET_US 20000    // Expected NVS write + commit until one was measured
+#define CHECKPOINT_RESTORE_BUDGET_MS 50     // Max. time from reset until a resumed game is in PAUSE
+
+// Flash Write Configuration (writes stall both caches)
+#define FLASH_WRITE_PRESS_WINDOW_MS 200     // While a time runs, writes must start and end this soon after a press
+#define FLASH_WRITE_FLAG_MARGIN_MS 500      // No write may end closer than this to a flag fall
+#define FLASH_WRITER_POLL_MS 50             // Re-check of writes held back by their interval
+
+// Shadow Screen Configuration
+#define SHADOW_BAND_LINES   8               // Lines per DMA band (two bands in internal RAM)
+#define SHADOW_MAX_RECTS    32              // Changed areas per push, more are sent as one box
+
+// Clock Display Configuration (frames only when a shown digit changes)
+#define CLOCK_FRAME_MAX_FPS 60              // Frame rate cap while fractions are shown
+#define CLOCK_FRAME_SAVING_FPS 30           // Same in power saving mode
+#define CLOCK_FRAME_POWER_SAVING 0          // 1: start in power saving mode
+#define CLOCK_FINE_BELOW_MS 10000           // Show fractions below this remaining time (max. 60 s)
+#define CLOCK_FINE_DECIMALS 1               // 1: tenths, 2: hundredths
+#define CLOCK_STOPPED_DIM_ALPHA 128         // Dimming of the times while the clock is stopped (0-255)
+
+// Pixel Kernel Configuration
+#define PIXEL_SIMD          1               // 1: use the S3 vector unit if it matches the scalar kernels
+#define PIXEL_BENCHMARK     0               // 1: print cycles per pixel at boot
+
+// Game Record Configuration
+#define GAME_MAX_PLIES      600             // Max. recorded half-moves per game
+#define RESULT_QR_MAX_PAYLOAD 2953          // Max. bytes in the result QR (version 40-L)
+#define RESULT_QR_BAND_LINES 16             // Lines per DMA band when drawing the QR code
+
+// Game Session Memory Configuration
+#define GAME_SESSION_ARENA_SIZE (16 * 1024) // PSRAM arena per game (record, notes, ...)
+#define CLOCK_EVENT_POOL_SIZE   32          // Input/timer events in flight
+#define CLOCK_EVENT_QUEUE_LENGTH 16         // Events waiting for the main loop
+#define CLOCK_BUS_POOL_SIZE 24              // Bus events in flight, subscribers x (inbox + 1) + 1 never run dry
+#define CLOCK_BUS_MAX_SUBSCRIBERS 16        // Longest subscriber table
+#define CLOCK_BUS_INBOX_LENGTH 8            // Events waiting per subscriber, power of two
+#define ALLOC_GUARD_ABORT       1           // 1: abort on heap use while a time runs, 0: only log
+
+// Latency Benchmark Configuration
+#define LATENCY_BENCHMARK   0               // 1: background load + press-to-charge latency report
+#define LATENCY_BENCH_PROBE_MS 20           // Interval of the synthetic probe events
+#define LATENCY_BENCH_FLASH_PERIOD_MS 100   // Sector erase + write in the bench partition
+#define LATENCY_BENCH_PARTITION "bench"     // Scratch data partition of partitions.csv
+#define LATENCY_BENCH_FLASH_SCHEDULED 1     // 1: flash load goes through the flash writer, 0: writes directly
+#define LATENCY_BENCH_FLASH_BUDGET_US 80000 // Expected sector erase + write until one was measured
+#define LATENCY_BENCH_UDP_PORT 4210         // Broadcast port of the network bursts
+#define LATENCY_BENCH_UDP_BURST 16          // 1 KB packets per burst (stand-in for MQTT)
+#define LATENCY_BENCH_REPORT_S 10           // Report interval
+
+// Profiler Configuration (tools/profiler.py)
+#define PROFILER_ENABLED    0               // 1: sample PC and task of both cores and stream them
+#define PROFILER_SAMPLE_HZ  997             // Per core, not a multiple of the 1 kHz tick
+#define PROFILER_RING_SAMPLES 8192          // Per core, 8 bytes each in PSRAM, power of two
+#define PROFILER_DRAIN_MS   20              // Interval of the streaming task
+#define PROFILER_MAX_TASKS  24              // Tasks with a name of their own, others count as "other"
+#define PROFILER_TIMER_GROUP 1              // Timer group used: timer 0 samples core 0, timer 1 core 1
+
+// Trace Configuration (tools/trace.py)
+#define TRACE_ENABLED       0               // 1: record trace events and dump them after a late input
+#define TRACE_RING_EVENTS   4096            // Per core, 20 bytes each in PSRAM, power of two
+#define TRACE_TRIGGER_US    5000            // Input handled this long after its edge stops recording
+#define TRACE_DUMP_WINDOW_MS 250            // Time before the trigger that is printed
+
+// Deadline Monitor Configuration
+#define DEADLINE_MONITOR    1               // 1: check run time budgets of jobs, capture interrupt and clock events
+#define DEADLINE_WINDOW_RUNS 200            // Runs per p99 check of a stage
+#define DEADLINE_CAPTURE_BUDGET_US 40       // Edge capture interrupt handler
+#define DEADLINE_EVENT_BUDGET_US 1000       // Release from the resolve window (flag falls: expiry) until the main loop handled it
+#define DEADLINE_ALARM_SERIAL 1             // 1: print an "@W" line when a stage's p99 exceeds its budget
+#define DEADLINE_ALARM_LED_PIN -1           // LED (active high) flashed on p99 breaches, -1: none
+#define DEADLINE_ALARM_FLASH_MS 300         // Duration of the LED flash
 
 // LED Strip Configuration
 #define LED_STRIP_PIN       14              // WS2812B data pin
 #define LED_STRIP_COUNT     36              // Number of LEDs in the strip
 
+// OTA Configuration
+#define OTA_PATCH_URL_FORMAT ""             // e.g. "http://192.168.1.10/patches/%s.cdp", %s = build id
+#define OTA_DOWNLOAD_TIMEOUT_MS 10000       // Abort the update if no data arrives for this long
+#define DELTA_PATCH_MAX_WINDOW_BITS 12      // Largest LZSS history accepted (4 KB)
+#define DELTA_PATCH_OLD_BUFFER_SIZE 1024    // Read cache for the running image
+#define DELTA_PATCH_OUT_BUFFER_SIZE 4096    // Write block for the inactive slot (one flash sector)
+#define OTA_FLASH_BLOCK_BUDGET_US 60000     // Expected erase + write time of one block
+
 // Input Configuration
 #define ROTARY_PIN_A 5
 #define ROTARY_PIN_B 4
 
 #define BUTTON_PIN 0
+#define ROCKER_PIN 17                       // Rocker ("Wippe"): HIGH = raised on white's side
+
+// Edge Capture Configuration
+#define EDGE_CAPTURE_TICKS_PER_US 80        // MCPWM capture timer runs on the 80 MHz APB clock
+#define ROCKER_DEBOUNCE_MS  20              // Edges this soon after a rocker change are bounce
+#define BUTTON_DEBOUNCE_MS  20              // Edges this soon after a button change are bounce
+#define INPUT_RESOLVE_WINDOW_US 2000        // Events are ordered by timestamp within this window
+#define FLAG_ALARM_GUARD_US 100             // Flag alarm fires this long after the expiry, above any capture interrupt latency
+#define INPUT_GLITCH_FILTER 1               // Use the GPIO glitch filter on chips that have one
 
 // Buzzer Configuration
 #define BUZZER_PIN 21
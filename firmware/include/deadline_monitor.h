@@ -0,0 +1,189 @@
+/*
+  Deadline Monitor for Chess Clock
+
+  This file defines the deadline monitor. Time-critical work (scheduler
+  jobs, interrupt handlers, the path from an edge to its handling) is
+  registered as a stage with a time budget. Every run of a stage is
+  recorded with its duration; a run over budget is an overrun and is
+  logged with its start time and the stage.
+
+  Besides the totals, every stage keeps a histogram in eighths of its
+  budget, from which percentiles are estimated. Runs are also counted in
+  windows of a fixed number of runs: when more than 1 % of the runs of a
+  window were over budget, the 99th percentile exceeded the budget and
+  the stage is marked as breached until takeBreaches() collects it.
+
+  record() takes constant time, does not block and may be called from
+  interrupt handlers, also from IRAM handlers if the monitor is in
+  internal RAM. Each stage must be recorded from one context only; the
+  overrun log is shared by all of them.
+
+  The class contains no Arduino code. Time is passed in by the caller.
+*/
+
+#ifndef DEADLINE_MONITOR_H
+#define DEADLINE_MONITOR_H
+
+#include <stdint.h>
+#include <atomic>
+
+#define DEADLINE_MAX_STAGES        32   // One bit each in the breach mask
+#define DEADLINE_BUCKETS_PER_BUDGET 8
+#define DEADLINE_BUCKETS           32   // Up to 4x the budget, the last one collects the rest
+#define DEADLINE_LOG_SIZE          16   // Overruns kept, power of two
+
+/**
+ * @brief One monitored stage
+ *
+ * The stage is owned by the caller and must stay valid while it is
+ * registered. Only name and budgetUs are set by the caller, the other
+ * fields belong to the monitor.
+ */
+struct DeadlineStage {
+  const char* name;               // Name shown in the report
+  uint32_t budgetUs;              // Longest run that is on time
+
+  // Statistics
+  uint32_t runs;
+  uint32_t overruns;
+  uint32_t breaches;              // Windows whose 99th percentile was over budget
+  uint32_t maxUs;
+  uint64_t totalUs;
+  uint32_t histogram[DEADLINE_BUCKETS];
+
+  // Intern
+  uint32_t bucketUs;
+  uint32_t windowRuns;
+  uint32_t windowOverruns;
+  uint8_t index;
+};
+
+/**
+ * @brief One logged overrun
+ */
+struct DeadlineOverrun {
+  uint32_t sequence;              // Slot + 1 once complete, 0 while written
+  uint32_t durationUs;
+  int64_t startUs;
+  uint8_t stage;                  // Index of the stage
+};
+
+/**
+ * @brief Budgets, overrun log and p99 breach detection of all stages
+ */
+class DeadlineMonitor {
+public:
+  /**
+   * @param windowRuns Runs per window of the p99 check
+   */
+  explicit DeadlineMonitor(uint32_t windowRuns);
+
+  /**
+   * @brief Register a stage, clears its statistics
+   *
+   * @return false if the budget is 0 or there are too many stages
+   */
+  bool add(DeadlineStage* stage);
+
+  /**
+   * @brief Record one run of a stage
+   *
+   * @param stage Registered stage
+   * @param startUs When the run started (or the event it handled happened)
+   * @param durationUs How long it took
+   */
+  __attribute__((always_inline)) void record(DeadlineStage* stage, int64_t startUs, uint32_t durationUs) {
+    uint32_t bucket = durationUs / stage->bucketUs;
+    stage->histogram[bucket < DEADLINE_BUCKETS ? bucket : DEADLINE_BUCKETS - 1]++;
+    stage->runs++;
+    stage->totalUs += durationUs;
+    if (durationUs > stage->maxUs) {
+      stage->maxUs = durationUs;
+    }
+
+    stage->windowRuns++;
+    if (durationUs > stage->budgetUs) {
+      stage->overruns++;
+      stage->windowOverruns++;
+      logOverrun(stage->index, startUs, durationUs);
+    }
+    if (stage->windowRuns >= windowRuns) {
+      if (stage->windowOverruns * 100 > stage->windowRuns) {
+        stage->breaches++;
+        breached.fetch_or(1UL << stage->index, std::memory_order_relaxed);
+      }
+      stage->windowRuns = 0;
+      stage->windowOverruns = 0;
+    }
+  }
+
+  /**
+   * @brief Collect the stages that breached since the last call
+   *
+   * @return One bit per stage index
+   */
+  uint32_t takeBreaches() { return breached.exchange(0, std::memory_order_relaxed); }
+
+  /**
+   * @brief Number of registered stages
+   */
+  uint8_t stageCount() const;
+
+  /**
+   * @brief Registered stage by index, nullptr while it is being added
+   */
+  DeadlineStage* stage(uint8_t index) const;
+
+  /**
+   * @brief Number of overruns logged since start, the next log slot
+   */
+  uint32_t logged() const { return written.load(std::memory_order_acquire); }
+
+  /**
+   * @brief Oldest log slot that may still be kept
+   */
+  uint32_t oldestLogged() const;
+
+  /**
+   * @brief Copy a logged overrun
+   *
+   * @return false if the slot is being written or was overwritten
+   */
+  bool readOverrun(uint32_t slot, DeadlineOverrun* overrun) const;
+
+  /**
+   * @brief Estimate a percentile of the run time from the histogram
+   *
+   * @param stage The stage
+   * @param percent 1 to 100
+   * @return Upper end of the bucket that holds the percentile, the
+   *         maximum if it lies beyond the histogram, 0 without runs
+   */
+  static uint32_t percentileUs(const DeadlineStage* stage, uint8_t percent);
+
+  /**
+   * @brief Clear the statistics of a stage
+   */
+  static void resetStats(DeadlineStage* stage);
+
+private:
+  __attribute__((always_inline)) void logOverrun(uint8_t stage, int64_t startUs, uint32_t durationUs) {
+    uint32_t slot = written.fetch_add(1, std::memory_order_relaxed);
+    DeadlineOverrun& overrun = log[slot & (DEADLINE_LOG_SIZE - 1)];
+    __atomic_store_n(&overrun.sequence, 0, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    overrun.durationUs = durationUs;
+    overrun.startUs = startUs;
+    overrun.stage = stage;
+    __atomic_store_n(&overrun.sequence, slot + 1, __ATOMIC_RELEASE);
+  }
+
+  uint32_t windowRuns;
+  std::atomic<uint32_t> breached;
+  std::atomic<uint32_t> registered;
+  DeadlineStage* stages[DEADLINE_MAX_STAGES];
+  std::atomic<uint32_t> written;
+  DeadlineOverrun log[DEADLINE_LOG_SIZE];
+};
+
+#endif // DEADLINE_MONITOR_H
@@ -0,0 +1,42 @@
+/*
+  Deadlines for Chess Clock
+
+  This file defines the device side of the deadline monitor (see
+  deadline_monitor.h, DEADLINE_MONITOR in config.h). Scheduler jobs with
+  a budget, the edge capture interrupt and the way of every clock event
+  from its edge (or flag fall) to the main loop are monitored. When the
+  99th percentile of a stage exceeds its budget, an alarm goes off: an
+  "@W" line on the serial port and a flash of DEADLINE_ALARM_LED_PIN.
+  The line format is
+
+    @W <stage> p99 <us> budget <us> overruns <count>
+*/
+
+#ifndef DEADLINES_H
+#define DEADLINES_H
+
+#include "deadline_monitor.h"
+
+extern DeadlineMonitor deadlineMonitor;
+
+/**
+ * @brief Set up the alarm LED
+ *
+ * @return true
+ */
+bool deadlinesInit();
+
+/**
+ * @brief Raise the alarm for stages that breached and end LED flashes
+ *
+ * Call it periodically from a task, it prints.
+ */
+void deadlinesCheckAlarms();
+
+/**
+ * @brief Print budget, percentiles and overruns of every stage and the
+ *        latest overruns
+ */
+void deadlinesPrintReport();
+
+#endif // DEADLINES_H
@@ -0,0 +1,136 @@
+/*
+  Delta Patch Decoder for Chess Clock
+
+  This file defines the streaming decoder for CDP1 delta patches created
+  by tools/delta_patch.py. The patch is fed in arbitrary chunks as it
+  arrives from the network; the new image is rebuilt from the old image
+  and written out in fixed-size blocks. All buffers are part of the
+  decoder object, so RAM use is bounded and known at compile time.
+
+  The decoder does not know about flash or partitions, all I/O goes
+  through the callbacks in DeltaPatchIo (see ota_delta.h).
+*/
+
+#ifndef DELTA_PATCH_H
+#define DELTA_PATCH_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "config.h"
+
+#define DELTA_PATCH_HEADER_SIZE 80
+
+/**
+ * @brief Header of a CDP1 patch
+ */
+struct DeltaPatchHeader {
+  uint8_t windowBits;             // LZSS history size (log2)
+  uint8_t lookaheadBits;          // LZSS match length bits
+  uint32_t oldSize;               // Size of the image the patch applies to
+  uint32_t newSize;               // Size of the resulting image
+  uint8_t oldSha256[32];          // SHA-256 of the old image
+  uint8_t newSha256[32];          // SHA-256 of the new image
+};
+
+/**
+ * @brief Callbacks used by the decoder
+ */
+struct DeltaPatchIo {
+  void* context;
+
+  // Called once the header is complete, return false to reject the patch
+  bool (*checkHeader)(void* context, const DeltaPatchHeader& header);
+
+  // Read bytes of the old image
+  bool (*readOld)(void* context, uint32_t offset, uint8_t* buffer, size_t length);
+
+  // Write the next bytes of the new image
+  bool (*writeNew)(void* context, const uint8_t* data, size_t length);
+};
+
+/**
+ * @brief Result of feeding data into the decoder
+ */
+enum class DeltaPatchStatus {
+  NEED_MORE,                      // All data consumed, image not complete yet
+  DONE,                           // New image completely written
+  BAD_HEADER,                     // Not a CDP1 patch or rejected by checkHeader
+  BAD_BODY,                       // Corrupt body (out of range or oversized)
+  READ_ERROR,                     // readOld failed
+  WRITE_ERROR                     // writeNew failed
+};
+
+/**
+ * @brief Streaming CDP1 patch decoder
+ */
+class DeltaPatchDecoder {
+public:
+  /**
+   * @brief Start decoding a new patch
+   *
+   * @param io Callbacks for header check and image I/O
+   */
+  void begin(const DeltaPatchIo& io);
+
+  /**
+   * @brief Feed the next chunk of the patch
+   *
+   * @param data Patch bytes
+   * @param length Number of bytes
+   * @return DeltaPatchStatus NEED_MORE while the image is incomplete
+   */
+  DeltaPatchStatus write(const uint8_t* data, size_t length);
+
+  /**
+   * @brief Header of the patch (valid after checkHeader was called)
+   */
+  const DeltaPatchHeader& header() const { return patchHeader; }
+
+  /**
+   * @brief Number of bytes of the new image produced so far
+   */
+  uint32_t bytesWritten() const { return newPosition; }
+
+private:
+  enum class Field : uint8_t { ADD_LENGTH, EXTRA_LENGTH, SEEK, ADD_BYTES, EXTRA_BYTES };
+
+  bool parseHeader();
+  DeltaPatchStatus bodyByte(uint8_t value);
+  void nextField();
+  DeltaPatchStatus emit(uint8_t value);
+  DeltaPatchStatus flush();
+  bool readOldByte(uint32_t offset, uint8_t* value);
+
+  DeltaPatchIo io;
+  DeltaPatchHeader patchHeader;
+  DeltaPatchStatus status;
+
+  uint8_t headerBuffer[DELTA_PATCH_HEADER_SIZE];
+  size_t headerLength;
+
+  // LZSS state
+  uint32_t bitBuffer;
+  uint8_t bitCount;
+  uint16_t windowHead;
+  uint8_t window[1 << DELTA_PATCH_MAX_WINDOW_BITS];
+
+  // Record state
+  Field field;
+  uint32_t varintValue;
+  uint8_t varintShift;
+  uint32_t addLength;
+  uint32_t extraLength;
+  uint32_t remaining;              // Bytes left in the current add/extra field
+  uint32_t seekTarget;             // Old position once the record is done
+  uint32_t oldPosition;
+  uint32_t newPosition;
+
+  // Old image read cache and new image write buffer
+  uint8_t oldBuffer[DELTA_PATCH_OLD_BUFFER_SIZE];
+  uint32_t oldBufferStart;
+  uint32_t oldBufferLength;
+  uint8_t outBuffer[DELTA_PATCH_OUT_BUFFER_SIZE];
+  uint32_t outLength;
+};
+
+#endif // DELTA_PATCH_H
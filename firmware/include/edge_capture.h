@@ -0,0 +1,56 @@
+/*
+  Edge Capture for Chess Clock
+
+  This file defines the input path of the rocker ("Wippe") and the main
+  button while a game is running. Both pins are connected to the MCPWM
+  capture unit, which latches its timer on every edge in hardware. The
+  capture value is converted to the esp_timer time base, so each edge
+  carries the instant it happened on the pin instead of the (varying)
+  moment the interrupt handler ran.
+
+  Edges are posted to the main loop as ClockEvents (see clock_event.h).
+*/
+
+#ifndef EDGE_CAPTURE_H
+#define EDGE_CAPTURE_H
+
+#include <stdint.h>
+#include "clock_event.h"
+
+/**
+ * @brief Interrupt jitter that the hardware timestamps removed
+ *
+ * Latencies are measured relative to the fastest interrupt seen so far,
+ * which serves as the reference for the capture timer offset.
+ */
+struct EdgeCaptureStats {
+  uint32_t edges;                 // Captured edges
+  uint32_t dropped;               // Edges lost because pool or queue were full
+  uint32_t minLatencyUs;          // Edge to interrupt handler
+  uint32_t maxLatencyUs;
+  uint64_t totalLatencyUs;
+};
+
+/**
+ * @brief Connect rocker and button to the MCPWM capture unit
+ *
+ * @return true if the capture channels could be set up
+ */
+bool edgeCaptureInit();
+
+/**
+ * @brief Get the jitter statistics since the last reset
+ */
+EdgeCaptureStats edgeCaptureStats();
+
+/**
+ * @brief Clear the jitter statistics
+ */
+void edgeCaptureResetStats();
+
+/**
+ * @brief Print the jitter statistics (min/avg/max)
+ */
+void edgeCapturePrintStats();
+
+#endif // EDGE_CAPTURE_H
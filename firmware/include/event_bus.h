@@ -0,0 +1,261 @@
+/*
+  Event Bus for Chess Clock
+
+  This file defines a publish/subscribe bus between firmware modules.
+  The subscribers are one fixed table, set once before the first event;
+  each one names the topics it wants, its handler and the task that runs
+  it. A publisher claims an event from a pool, fills it in place and
+  publishes it. Every interested subscriber gets a pointer to the same
+  event in its inbox, and the last one that handled it gives it back to
+  the pool, so the event is never copied.
+
+  Nothing touches the heap and every step is bounded: publishing visits
+  each subscriber once and never waits; an event that does not fit into
+  a full inbox is dropped for that subscriber and counted. Handlers run
+  in the subscriber's task when it calls drain(), which should happen
+  right after it was woken.
+
+  The class contains no Arduino code. Waking a subscriber's task and the
+  time source are passed in by the caller.
+*/
+
+#ifndef EVENT_BUS_H
+#define EVENT_BUS_H
+
+#include <stdint.h>
+#include <atomic>
+#include "object_pool.h"
+
+/**
+ * @brief One subscriber of the bus
+ */
+template <typename T>
+struct BusSubscriber {
+  const char* name;               // Name shown in the report
+  uint32_t topics;                // Topic bits it is interested in
+  void (*handle)(const T& event); // Called in the subscriber's task, must not keep the reference
+  uint8_t owner;                  // Passed to the wake function, e.g. a task index
+};
+
+/**
+ * @brief Delivery statistics of one subscriber
+ */
+struct BusSubscriberStats {
+  uint32_t delivered;             // Events handled
+  uint32_t dropped;               // Events lost because the inbox was full
+  uint32_t maxLatencyUs;          // Publish until the handler started
+  uint64_t totalLatencyUs;
+};
+
+/**
+ * @brief Zero-copy publish/subscribe bus
+ *
+ * @tparam T Event type
+ * @tparam POOL Events in flight
+ * @tparam MAX_SUBSCRIBERS Largest subscriber table
+ * @tparam INBOX Events waiting per subscriber, power of two
+ */
+template <typename T, uint16_t POOL, uint8_t MAX_SUBSCRIBERS, uint16_t INBOX>
+class EventBus {
+  static_assert(INBOX > 0 && (INBOX & (INBOX - 1)) == 0, "Inbox length must be a power of two");
+
+  struct Entry {
+    T event;
+    uint32_t topic;
+    int64_t publishedUs;
+    std::atomic<uint8_t> references;
+  };
+
+  // Bounded lock-free queue for many publishers and one subscriber
+  struct Inbox {
+    struct Cell {
+      std::atomic<uint32_t> sequence;
+      Entry* entry;
+    };
+    Cell cells[INBOX];
+    std::atomic<uint32_t> tail;
+    uint32_t head;
+
+    void reset() {
+      for (uint16_t i = 0; i < INBOX; i++) {
+        cells[i].sequence.store(i, std::memory_order_relaxed);
+      }
+      tail.store(0, std::memory_order_relaxed);
+      head = 0;
+    }
+
+    bool push(Entry* entry) {
+      uint32_t position = tail.load(std::memory_order_relaxed);
+      for (;;) {
+        Cell& cell = cells[position & (INBOX - 1)];
+        int32_t difference = (int32_t)(cell.sequence.load(std::memory_order_acquire) - position);
+        if (difference == 0) {
+          if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+            cell.entry = entry;
+            cell.sequence.store(position + 1, std::memory_order_release);
+            return true;
+          }
+        } else if (difference < 0) {
+          return false;   // Full
+        } else {
+          position = tail.load(std::memory_order_relaxed);
+        }
+      }
+    }
+
+    Entry* pop() {
+      Cell& cell = cells[head & (INBOX - 1)];
+      if ((int32_t)(cell.sequence.load(std::memory_order_acquire) - (head + 1)) < 0) {
+        return nullptr;
+      }
+      Entry* entry = cell.entry;
+      cell.sequence.store(head + INBOX, std::memory_order_release);
+      head++;
+      return entry;
+    }
+  };
+
+public:
+  typedef BusSubscriber<T> Subscriber;
+
+  EventBus() : subscribers(nullptr), count(0), nowUs(nullptr), wake(nullptr), unclaimed(0) {}
+
+  /**
+   * @brief Set the subscriber table, before the first event
+   *
+   * @param table Subscribers, must stay valid
+   * @param subscriberCount Number of subscribers (max. MAX_SUBSCRIBERS)
+   * @param now Returns the current time in microseconds
+   * @param wakeOwner Wakes the task of a subscriber (its owner), may be nullptr
+   * @return false if the table is too long
+   */
+  bool begin(const Subscriber* table, uint8_t subscriberCount, int64_t (*now)(), void (*wakeOwner)(uint8_t owner)) {
+    if (subscriberCount > MAX_SUBSCRIBERS) {
+      return false;
+    }
+    for (uint8_t i = 0; i < subscriberCount; i++) {
+      inboxes[i].reset();
+      stats[i] = BusSubscriberStats();
+    }
+    nowUs = now;
+    wake = wakeOwner;
+    subscribers = table;
+    count = subscriberCount;
+    return true;
+  }
+
+  /**
+   * @brief Take an event out of the pool to fill in
+   *
+   * @return T* Default constructed event or nullptr if the pool is empty
+   */
+  T* claim() {
+    Entry* entry = pool.acquire();
+    return entry != nullptr ? &entry->event : nullptr;
+  }
+
+  /**
+   * @brief Deliver a claimed event to every subscriber of its topic
+   *
+   * The event belongs to the bus afterwards.
+   *
+   * @param event Event from claim()
+   * @param topic One topic bit
+   * @return Number of subscribers it was delivered to
+   */
+  uint8_t publish(T* event, uint32_t topic) {
+    Entry* entry = (Entry*)event;   // The event is the first member
+    entry->topic = topic;
+    entry->publishedUs = nowUs();
+
+    // One reference for the publisher keeps the event alive while it is handed out
+    entry->references.store(1, std::memory_order_relaxed);
+    uint32_t woken = 0;
+    uint8_t delivered = 0;
+    for (uint8_t i = 0; i < count; i++) {
+      if ((subscribers[i].topics & topic) == 0) {
+        continue;
+      }
+      entry->references.fetch_add(1, std::memory_order_relaxed);
+      if (!inboxes[i].push(entry)) {
+        entry->references.fetch_sub(1, std::memory_order_relaxed);
+        stats[i].dropped++;
+        continue;
+      }
+      delivered++;
+      // Each owner once, several subscribers may share a task
+      uint32_t ownerBit = 1UL << (subscribers[i].owner & 31);
+      if (wake != nullptr && (woken & ownerBit) == 0) {
+        woken |= ownerBit;
+        wake(subscribers[i].owner);
+      }
+    }
+    if (delivered == 0) {
+      unclaimed++;
+    }
+    release(entry);
+    return delivered;
+  }
+
+  /**
+   * @brief Handle all events waiting for a subscriber
+   *
+   * Call it only from the subscriber's task.
+   *
+   * @param subscriber Index in the table
+   * @return Number of events handled
+   */
+  uint16_t drain(uint8_t subscriber) {
+    if (subscriber >= count) {
+      return 0;
+    }
+    Inbox& inbox = inboxes[subscriber];
+    BusSubscriberStats& stat = stats[subscriber];
+    uint16_t handled = 0;
+    Entry* entry;
+    // At most one inbox length, so a busy publisher cannot keep the task here
+    while (handled < INBOX && (entry = inbox.pop()) != nullptr) {
+      uint32_t latencyUs = (uint32_t)(nowUs() - entry->publishedUs);
+      stat.delivered++;
+      stat.totalLatencyUs += latencyUs;
+      if (latencyUs > stat.maxLatencyUs) {
+        stat.maxLatencyUs = latencyUs;
+      }
+      subscribers[subscriber].handle(entry->event);
+      release(entry);
+      handled++;
+    }
+    return handled;
+  }
+
+  uint8_t subscriberCount() const { return count; }
+  const Subscriber& subscriber(uint8_t index) const { return subscribers[index]; }
+  BusSubscriberStats subscriberStats(uint8_t index) const { return stats[index]; }
+
+  /**
+   * @brief Events that no subscriber wanted or could take
+   */
+  uint32_t unclaimedCount() const { return unclaimed; }
+
+  uint16_t poolUsed() const { return pool.used(); }
+  uint16_t poolHighWater() const { return pool.highWater(); }
+  uint32_t poolExhausted() const { return pool.exhaustedCount(); }
+
+private:
+  void release(Entry* entry) {
+    if (entry->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      pool.release(entry);
+    }
+  }
+
+  ObjectPool<Entry, POOL> pool;
+  Inbox inboxes[MAX_SUBSCRIBERS];
+  BusSubscriberStats stats[MAX_SUBSCRIBERS];
+  const Subscriber* subscribers;
+  uint8_t count;
+  int64_t (*nowUs)();
+  void (*wake)(uint8_t owner);
+  uint32_t unclaimed;
+};
+
+#endif // EVENT_BUS_H
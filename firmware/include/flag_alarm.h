@@ -0,0 +1,70 @@
+/*
+  Flag Alarm for Chess Clock
+
+  This file defines the one-shot timer that fires at the exact instant the
+  running side runs out of time. It is re-armed whenever the expiry moves
+  (start, move, increment, resume) and cancelled on pause, so flag fall is
+  detected without polling the remaining time.
+
+  The timer is dispatched from its interrupt, not from the esp_timer
+  task, and fires FLAG_ALARM_GUARD_US after the expiry. By then every
+  capture interrupt of an edge from before the expiry has posted its
+  event, so the input engine can pass the flag fall on without holding
+  it for the resolve window (see input_engine.h).
+
+  When the alarm fires, a FLAG_FALL ClockEvent is posted (see
+  clock_event.h). Its timestamp is the expiry it was armed for; the value
+  carries how late the timer interrupt ran, in microseconds.
+*/
+
+#ifndef FLAG_ALARM_H
+#define FLAG_ALARM_H
+
+#include <stdint.h>
+
+/**
+ * @brief Detection delay of the fired alarms
+ */
+struct FlagAlarmStats {
+  uint32_t armed;                 // Number of arm calls
+  uint32_t fired;                 // Alarms that reached their expiry
+  uint32_t dropped;               // FLAG_FALL events lost because the pool was empty
+  uint32_t maxLateUs;             // Callback time minus expiry and guard
+  uint64_t totalLateUs;
+};
+
+/**
+ * @brief Create the one-shot timer
+ *
+ * @return true if the timer could be created
+ */
+bool flagAlarmInit();
+
+/**
+ * @brief Let the alarm fire at an absolute time, replacing an armed one
+ *
+ * @param expiryUs esp_timer time of the flag fall (fires at once if passed)
+ */
+void flagAlarmArm(int64_t expiryUs);
+
+/**
+ * @brief Stop an armed alarm
+ */
+void flagAlarmCancel();
+
+/**
+ * @brief Get the statistics since the last reset
+ */
+FlagAlarmStats flagAlarmStats();
+
+/**
+ * @brief Clear the statistics
+ */
+void flagAlarmResetStats();
+
+/**
+ * @brief Print the statistics (fired alarms, avg/max delay)
+ */
+void flagAlarmPrintStats();
+
+#endif // FLAG_ALARM_H
@@ -0,0 +1,70 @@
+/*
+  Flash Window for Chess Clock
+
+  This file defines when a flash write may start. Erasing and writing
+  flash disables the caches of both cores: every task and interrupt
+  handler that is not in IRAM stops until the write is done. Outside a
+  game this does not matter. While a time runs, a write is only allowed
+  right after a press (the player who just moved will not press again
+  soon, the opponent has to think first) and only if it ends well
+  before the running time could run out.
+
+  The class contains no Arduino code and only works on timestamps passed
+  in by the caller.
+*/
+
+#ifndef FLASH_WINDOW_H
+#define FLASH_WINDOW_H
+
+#include <stdint.h>
+
+/**
+ * @brief Decides whether a flash write of a given length may start
+ */
+class FlashWindow {
+public:
+  FlashWindow();
+
+  /**
+   * @brief Set the size of the windows
+   *
+   * @param pressWindowUs Time after a press in which writes may start and must end
+   * @param flagMarginUs Minimum time left between the end of a write and a flag fall
+   */
+  void begin(uint32_t pressWindowUs, uint32_t flagMarginUs);
+
+  /**
+   * @brief Tell whether a time runs
+   *
+   * @param running true while a time runs
+   * @param expiryUs Point in time at which the running time runs out
+   */
+  void setGame(bool running, int64_t expiryUs);
+
+  /**
+   * @brief A player pressed, a window opens
+   *
+   * @param timestampUs Time of the edge
+   */
+  void pressed(int64_t timestampUs);
+
+  /**
+   * @brief Check whether a write may start now
+   *
+   * @param nowUs Current time
+   * @param durationUs Expected duration of the write
+   * @return true if the write ends inside the current window
+   */
+  bool allows(int64_t nowUs, uint32_t durationUs) const;
+
+  bool gameRunning() const { return running; }
+
+private:
+  uint32_t pressWindowUs;
+  uint32_t flagMarginUs;
+  int64_t lastPressUs;
+  int64_t expiryUs;
+  bool running;
+};
+
+#endif // FLASH_WINDOW_H
@@ -0,0 +1,95 @@
+/*
+  Flash Writer for Chess Clock
+
+  This file defines the single place from which flash is written (NVS,
+  SPIFFS, raw partitions). Modules do not write themselves, they request
+  a write job. The flash writer task runs it as soon as the flash window
+  allows it (see flash_window.h): at once outside a game and in pause,
+  right after a press while a time runs.
+
+  A job that is requested again before it ran is written only once, and
+  a job is not run more often than its minIntervalMs unless the request
+  is urgent.
+
+  Meanwhile the time-critical path stays in IRAM: the edge capture
+  interrupt stamps and posts a press even during a write, and since the
+  time is charged by these timestamps, a late time task never costs a
+  player time.
+*/
+
+#ifndef FLASH_WRITER_H
+#define FLASH_WRITER_H
+
+#include <stdint.h>
+
+#define FLASH_WRITER_MAX_JOBS 8
+
+/**
+ * @brief One kind of flash write
+ *
+ * The job is owned by the caller and must stay valid forever. Only name,
+ * write, context, minIntervalMs and budgetUs are set by the caller, the
+ * other fields belong to the flash writer.
+ */
+struct FlashWriteJob {
+  const char* name;               // Name shown in the report
+  bool (*write)(void* context);   // Writes the current data, false on error
+  void* context;                  // Passed to write
+  uint32_t minIntervalMs;         // Coalesce requests within this time
+  uint32_t budgetUs;              // Expected duration until the first write was measured
+
+  // Statistics
+  uint32_t writes;
+  uint32_t failures;
+  uint32_t coalesced;             // Requests merged into a later write
+  uint32_t deferred;              // Requests the window held back at least once
+  uint32_t duringGame;            // Writes while a time ran
+  uint32_t maxWriteUs;
+  uint32_t maxWaitUs;             // Longest time from request to write
+
+  // Intern
+  volatile bool pending;
+  volatile bool urgent;
+  bool registered;
+  bool held;                      // The pending request was deferred
+  int64_t requestedUs;
+  int64_t lastWriteUs;
+};
+
+/**
+ * @brief Request a write of a job
+ *
+ * May be called from any task, not from an interrupt handler.
+ *
+ * @param job The job, registered on the first request
+ * @param urgent Ignore minIntervalMs (pause, end of a game)
+ * @return false if the job could not be registered (more than
+ *         FLASH_WRITER_MAX_JOBS jobs), it is never written then
+ */
+bool flashWriterRequest(FlashWriteJob* job, bool urgent);
+
+/**
+ * @brief Tell the flash writer whether a time runs
+ *
+ * Called by the time task on every state change.
+ */
+void flashWriterSetGame(bool running, int64_t expiryUs);
+
+/**
+ * @brief A player pressed, start deferred writes now
+ *
+ * @param timestampUs Time of the edge
+ */
+void flashWriterPressed(int64_t timestampUs);
+
+/**
+ * @brief Task that runs the writes (low priority, core 0)
+ */
+void flashWriterTask(void* context);
+
+/**
+ * @brief Print writes, coalesced requests and waits per job
+ */
+void flashWriterPrintStats();
+
+#endif // FLASH_WRITER_H
@@ -0,0 +1,116 @@
+/*
+  Frame Governor for Chess Clock
+
+  This file defines when the clock display draws a frame. With plenty of
+  time left only whole seconds are shown, and a frame is drawn exactly
+  when the remaining time crosses a second boundary, so the digits change
+  in step with the real clock and nothing is drawn in between. Below a
+  threshold tenths or hundredths are shown; frames then follow their
+  boundaries as well, but never faster than the frame rate cap of the
+  power mode.
+
+  A stopped clock draws nothing unless something changed (dirty).
+
+  The class contains no Arduino code and only works on timestamps passed
+  in by the caller.
+*/
+
+#ifndef FRAME_GOVERNOR_H
+#define FRAME_GOVERNOR_H
+
+#include <stdint.h>
+
+/**
+ * @brief Frame rate cap
+ */
+enum class FramePower : uint8_t {
+  NORMAL,
+  SAVING
+};
+
+/**
+ * @brief Frame statistics since the last reset
+ */
+struct FrameGovernorStats {
+  uint32_t frames;
+  uint32_t coarseFrames;          // Whole seconds
+  uint32_t fineFrames;            // Tenths or hundredths
+  uint32_t dirtyFrames;           // Drawn because something else changed
+  uint32_t maxLateUs;             // Frame start after its boundary
+  uint64_t totalLateUs;
+};
+
+/**
+ * @brief Picks the time of the next frame
+ */
+class FrameGovernor {
+public:
+  FrameGovernor();
+
+  /**
+   * @brief Configure the governor
+   *
+   * @param maxFps Frame rate cap in normal mode
+   * @param savingFps Frame rate cap in power saving mode
+   * @param fineBelowMs Show fractions below this remaining time (max. 60 s)
+   * @param fineDecimals 1 for tenths, 2 for hundredths
+   */
+  void begin(uint16_t maxFps, uint16_t savingFps, uint32_t fineBelowMs, uint8_t fineDecimals);
+
+  void setPower(FramePower power);
+
+  /**
+   * @brief Draw the next frame as soon as possible (state change, press)
+   */
+  void markDirty();
+
+  /**
+   * @brief Decimals to show for a remaining time
+   */
+  uint8_t decimals(int64_t remainingUs) const;
+
+  /**
+   * @brief Value shown for a remaining time, rounded up
+   *
+   * @return uint32_t Remaining time in units of 10^-decimals seconds
+   */
+  static uint32_t value(int64_t remainingUs, uint8_t decimals);
+
+  /**
+   * @brief Time of the next frame
+   *
+   * @param nowUs Current time
+   * @param remainingUs Remaining time of the running (or shown) side at nowUs
+   * @param running The time is running
+   * @return int64_t nowUs if a frame is due, INT64_MAX if nothing will change
+   */
+  int64_t nextFrameUs(int64_t nowUs, int64_t remainingUs, bool running) const;
+
+  /**
+   * @brief A frame was drawn
+   *
+   * @param nowUs Time the frame was drawn
+   * @param plannedUs Time it was planned for (from nextFrameUs()), for the lateness
+   * @param remainingUs Remaining time that was shown
+   */
+  void frameDrawn(int64_t nowUs, int64_t plannedUs, int64_t remainingUs);
+
+  const FrameGovernorStats& stats() const { return counters; }
+  void resetStats();
+
+private:
+  uint32_t minIntervalUs() const;
+
+  uint16_t maxFps;
+  uint16_t savingFps;
+  int64_t fineBelowUs;
+  uint8_t fineDecimals;
+  FramePower power;
+  bool dirty;
+  int64_t lastFrameUs;
+  uint32_t lastValue;
+  uint8_t lastDecimals;
+  FrameGovernorStats counters;
+};
+
+#endif // FRAME_GOVERNOR_H
@@ -0,0 +1,94 @@
+/*
+  Game Checkpoint for Chess Clock
+
+  This file defines the bit-packed snapshot of a running game that lets
+  the clock continue after a brown-out or reset. Two encodings exist:
+
+  - Full: 16 bytes with millisecond times, a sequence number and a CRC.
+    It is written to RTC slow memory after every press, alternating
+    between two slots, so a write torn by a reset leaves the previous
+    slot intact. When a game ends, both slots get an "ended" snapshot
+    with the next sequence numbers, so the older flash copy can never
+    bring a finished game back, even before its erase is written.
+  - Compact: one 64 bit word with centisecond times for the flash copy,
+    which survives a complete power loss. One NVS entry per write keeps
+    write amplification at a minimum; NVS checks the entry itself.
+
+  The functions contain no Arduino code, they only pack and unpack.
+*/
+
+#ifndef GAME_CHECKPOINT_H
+#define GAME_CHECKPOINT_H
+
+#include <stdint.h>
+
+#define GAME_CHECKPOINT_SIZE 16
+#define GAME_CHECKPOINT_MAX_MS ((1UL << 27) - 1)   // About 37 hours per side
+#define GAME_CHECKPOINT_ENDED 0xF                  // State of the snapshot written when a game ends
+
+/**
+ * @brief Where a restored snapshot came from
+ */
+enum class CheckpointSource : uint8_t {
+  NONE,
+  RTC,
+  FLASH,
+  ENDED                           // The newest RTC snapshot says the game ended
+};
+
+/**
+ * @brief State of a running game
+ */
+struct GameSnapshot {
+  uint8_t state;                  // ChessClockState at the time of the snapshot
+  uint8_t activeSide;             // Side to move (0 = white)
+  uint8_t timeControl;            // Index into TIME_CONTROLS
+  uint16_t plies;                 // Half-moves played so far
+  uint32_t whiteMs;               // Remaining time
+  uint32_t blackMs;
+  uint16_t sequence;              // Incremented on every snapshot (full encoding only)
+};
+
+/**
+ * @brief Encode the full snapshot
+ */
+void checkpointPack(const GameSnapshot& snapshot, uint8_t* out);
+
+/**
+ * @brief Decode a full snapshot
+ *
+ * @return false if the magic or CRC does not match (torn or never written)
+ */
+bool checkpointUnpack(const uint8_t* in, GameSnapshot* snapshot);
+
+/**
+ * @brief Encode the compact snapshot (no state, no sequence)
+ *
+ * @return uint64_t Never 0, 0 marks "no game"
+ */
+uint64_t checkpointPackCompact(const GameSnapshot& snapshot);
+
+/**
+ * @brief Decode a compact snapshot
+ *
+ * @return false for 0 ("no game")
+ */
+bool checkpointUnpackCompact(uint64_t word, GameSnapshot* snapshot);
+
+/**
+ * @brief Pick the newest valid snapshot
+ *
+ * The RTC slots are always at least as new as the flash copy, so the
+ * flash copy is only used if both slots are invalid. If the newest slot
+ * is an "ended" snapshot, the flash copy is stale and ignored.
+ *
+ * @param slotA First RTC slot
+ * @param slotB Second RTC slot
+ * @param compact Flash copy, 0 if there is none
+ * @param snapshot Filled with the selected snapshot (for ENDED only the sequence counts)
+ * @return CheckpointSource Where it came from, NONE or ENDED if there is no game to resume
+ */
+CheckpointSource checkpointSelect(const uint8_t* slotA, const uint8_t* slotB, uint64_t compact,
+                                  GameSnapshot* snapshot);
+
+#endif // GAME_CHECKPOINT_H
@@ -0,0 +1,84 @@
+/*
+  Game Record for Chess Clock
+
+  This file defines the record of a single game: the players, the
+  selected time control, the result and the time used for every move.
+  The record is filled while the game runs and shared at
+  SAVE_GAME_RESULT.
+*/
+
+#ifndef GAME_RECORD_H
+#define GAME_RECORD_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "config.h"
+
+/**
+ * @brief Result of a game
+ */
+enum class GameResult : uint8_t {
+  UNDECIDED,                      // Game still running or aborted
+  WHITE_WINS,                     // 1-0
+  BLACK_WINS,                     // 0-1
+  DRAW                            // 1/2-1/2
+};
+
+/**
+ * @brief Everything that is recorded about one game
+ *
+ * Move times are stored per half-move (ply), white's first move first,
+ * in milliseconds.
+ */
+struct GameRecord {
+  char whiteName[2 * PLAYER_NAME_MAX_LENGTH + 2];   // "First Last"
+  char blackName[2 * PLAYER_NAME_MAX_LENGTH + 2];
+  uint8_t timeControl;            // Index into TIME_CONTROLS
+  GameResult result;
+  uint16_t plyCount;              // Number of entries in moveTimesMs
+  uint32_t revision;              // Incremented on every change
+  uint32_t moveTimesMs[GAME_MAX_PLIES];
+};
+
+/**
+ * @brief Clear a record for a new game
+ *
+ * @param record The record to clear
+ * @param timeControl Index into TIME_CONTROLS
+ */
+void gameRecordReset(GameRecord& record, uint8_t timeControl);
+
+/**
+ * @brief Append the time used for one half-move
+ *
+ * @param record The record to update
+ * @param timeMs Time the player spent on the move
+ * @return false if the record is full
+ */
+bool gameRecordAddMove(GameRecord& record, uint32_t timeMs);
+
+/**
+ * @brief Set the result of the game
+ */
+void gameRecordSetResult(GameRecord& record, GameResult result);
+
+/**
+ * @brief Get the result in PGN notation ("1-0", "0-1", "1/2-1/2", "*")
+ */
+const char* gameResultToString(GameResult result);
+
+/**
+ * @brief Write the record as compact, human readable text
+ *
+ * Format: "CC1;W=<white>;B=<black>;R=<result>;TC=<base>+<inc>;T=<t1>,<t2>,..."
+ * with move times in tenths of a second. If the buffer is too small, the
+ * move list is cut and ends with "~".
+ *
+ * @param record The record to serialize
+ * @param buffer Output buffer
+ * @param size Size of the output buffer
+ * @return size_t Length of the text without terminator
+ */
+size_t gameRecordSerialize(const GameRecord& record, char* buffer, size_t size);
+
+#endif // GAME_RECORD_H
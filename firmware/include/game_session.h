@@ -0,0 +1,55 @@
+/*
+  Game Session for Chess Clock
+
+  This file defines the memory of one game. A session starts at
+  WAIT_FOR_WHITE_START: one arena is taken from PSRAM and everything the
+  game needs (the game record, ...) is placed inside it. While the times
+  run nothing else is allocated. The session ends after
+  SAVE_GAME_RESULT, which gives the whole arena back at once.
+*/
+
+#ifndef GAME_SESSION_H
+#define GAME_SESSION_H
+
+#include <stdint.h>
+#include "arena.h"
+#include "game_record.h"
+
+/**
+ * @brief Start a new game session
+ *
+ * Ends a still running session first.
+ *
+ * @param timeControl Index into TIME_CONTROLS
+ * @return true if the arena and the game record could be allocated
+ */
+bool gameSessionBegin(uint8_t timeControl);
+
+/**
+ * @brief End the session and free its arena
+ */
+void gameSessionEnd();
+
+/**
+ * @brief Check whether a session is running
+ */
+bool gameSessionActive();
+
+/**
+ * @brief Get the record of the running game
+ *
+ * @return GameRecord* The record or nullptr without a session
+ */
+GameRecord* gameSessionRecord();
+
+/**
+ * @brief Get the arena of the running game for further allocations
+ */
+Arena& gameSessionArena();
+
+/**
+ * @brief Print arena, pool and alloc guard usage of the session
+ */
+void gameSessionPrintStats();
+
+#endif // GAME_SESSION_H
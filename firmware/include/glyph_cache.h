@@ -0,0 +1,143 @@
+/*
+  Glyph Cache for Chess Clock
+
+  This file defines a cache for the alpha bitmaps of vlw fonts (see
+  vlw_font.h). Every glyph is read from the font file once and kept in a
+  fixed-size slot of a memory block supplied by the caller (normally in
+  PSRAM); when all slots are in use, the least recently used glyph is
+  replaced. Glyphs are keyed by font, size and code point.
+
+  Measured text widths are kept in a second, small cache, so layout code
+  can ask for the width of the same name again and again. An entry keeps
+  a copy of its text, so two names whose hashes collide never share a
+  width. Text is UTF-8, so names with umlauts render like any other text
+  as long as the font contains the glyphs. Only the Basic Multilingual
+  Plane is supported (see vlw_font.h).
+
+  The class contains no Arduino code. All calls must come from the same
+  task.
+*/
+
+#ifndef GLYPH_CACHE_H
+#define GLYPH_CACHE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "vlw_font.h"
+
+#define GLYPH_CACHE_WIDTH_ENTRIES 64
+#define GLYPH_CACHE_WIDTH_TEXT    52      // Longest cached text + 1, a full player name fits
+
+/**
+ * @brief Cache statistics
+ */
+struct GlyphCacheStats {
+  uint32_t hits;                  // Glyphs found in the cache
+  uint32_t misses;                // Glyphs read from the font file
+  uint32_t evictions;             // Glyphs replaced to make room
+  uint32_t uncached;              // Glyphs larger than a slot, read every time
+  uint32_t bytesRead;             // Bitmap bytes read from font files
+  uint32_t widthHits;             // Text widths found in the cache
+  uint32_t widthMisses;
+  uint32_t widthCollisions;       // Same hash, different text or font
+};
+
+class GlyphCache {
+public:
+  GlyphCache();
+
+  /**
+   * @brief Split a memory block into glyph slots
+   *
+   * @param memory Block for the slots and their bookkeeping
+   * @param bytes Size of the block
+   * @param slotBytes Largest bitmap that is cached (VlwFont::maxBitmapBytes())
+   * @return true if at least one slot fits
+   */
+  bool begin(uint8_t* memory, size_t bytes, uint16_t slotBytes);
+
+  /**
+   * @brief Forget all glyphs and widths, e.g. after a font was reloaded
+   */
+  void clear();
+
+  /**
+   * @brief Get the alpha bitmap of a glyph
+   *
+   * @param scratch Used for glyphs larger than a slot (width * height bytes)
+   * @return const uint8_t* Bitmap, valid until the next call, nullptr on a read error
+   */
+  const uint8_t* bitmap(const VlwFont& font, const VlwGlyph& glyph, uint8_t* scratch);
+
+  /**
+   * @brief Width of a UTF-8 text in pixels
+   */
+  int32_t textWidth(const VlwFont& font, const char* text);
+
+  /**
+   * @brief Draw a UTF-8 text into an RGB565 buffer
+   *
+   * Pixels are blended between the foreground and background colour and
+   * stored in the byte order of the display (high byte first), like the
+   * LVGL draw buffers. Only glyph pixels are written, the buffer must
+   * already hold the background. Everything outside it is clipped.
+   *
+   * @param x Cursor position of the first character in the buffer
+   * @param y Top of the text line in the buffer
+   * @param scratch At least VlwFont::maxBitmapBytes() bytes
+   * @return int32_t Cursor position after the last character
+   */
+  int32_t drawText(const VlwFont& font, const char* text, int32_t x, int32_t y, uint16_t* buffer,
+                   int32_t bufferWidth, int32_t bufferHeight, uint16_t foreground, uint16_t background,
+                   uint8_t* scratch);
+
+  /**
+   * @brief Decode the next UTF-8 character and advance the text
+   *
+   * @return uint32_t Code point, 0xFFFD for a malformed sequence, 0 at the end
+   */
+  static uint32_t nextCodepoint(const char** text);
+
+  uint16_t slotCount() const { return slots; }
+  uint16_t usedSlots() const { return used; }
+  const GlyphCacheStats& stats() const { return counters; }
+  void resetStats();
+
+private:
+  static const uint16_t NONE = 0xFFFF;
+
+  struct Entry {
+    uint32_t key;                 // Font id, size and code point, 0 if free
+    uint16_t newer;               // LRU list
+    uint16_t older;
+    uint16_t chain;               // Next entry in the same bucket
+  };
+
+  struct WidthEntry {
+    uint32_t hash;                // FNV-1a of font id and text, 0 if free
+    int32_t width;
+    uint8_t fontId;
+    uint8_t fontSize;
+    char text[GLYPH_CACHE_WIDTH_TEXT];
+  };
+
+  static uint32_t keyOf(const VlwFont& font, const VlwGlyph& glyph);
+  void unlink(uint16_t index);
+  void pushNewest(uint16_t index);
+  void pushOldest(uint16_t index);
+  void removeFromBucket(uint16_t index);
+
+  Entry* entries;
+  uint16_t* buckets;
+  uint8_t* bitmaps;
+  uint16_t slots;
+  uint16_t bucketMask;
+  uint16_t slotSize;
+  uint16_t used;
+  uint16_t newest;
+  uint16_t oldest;
+  WidthEntry widths[GLYPH_CACHE_WIDTH_ENTRIES];
+  GlyphCacheStats counters;
+};
+
+#endif // GLYPH_CACHE_H
@@ -0,0 +1,175 @@
+/*
+  Input Engine for Chess Clock
+
+  This file defines how raw input edges become clock events. A classic
+  debounce waits until the contact is stable and therefore reports a
+  press one debounce window late, which is charged to the wrong player.
+  Here the first edge of a contact change is accepted at once and keeps
+  its own timestamp; the following bounce edges are only ignored for the
+  input state. An edge to the level that was accepted last is never a
+  change, and when the lockout ends the pin level is read back, so a
+  contact that settled on the other level inside the lockout (a very
+  short tap) is not lost.
+
+  Accepted events are held back for a short resolve window and released
+  in timestamp order, so near-simultaneous events from different sources
+  (rocker, button, flag alarm) are always handled in the same order no
+  matter which interrupt ran first. Equal timestamps are ordered by a
+  fixed priority: flag fall, then rocker, then button.
+
+  A flag fall is not held back. The flag alarm fires FLAG_ALARM_GUARD_US
+  after the expiry (see flag_alarm.h), so every edge from before the
+  expiry has already been pushed when it arrives; it only waits for
+  older events that are still held.
+
+  The classes contain no Arduino code and only work on the timestamps
+  passed in by the caller.
+*/
+
+#ifndef INPUT_ENGINE_H
+#define INPUT_ENGINE_H
+
+#include <stdint.h>
+#include "clock_event.h"
+
+#define INPUT_ENGINE_MAX_PENDING 8
+
+/**
+ * @brief Debounce of one contact that reports the first edge
+ */
+class Debouncer {
+public:
+  Debouncer();
+
+  /**
+   * @brief Forget the last edge, the level is unknown until the next one
+   *
+   * @param windowUs Time after an accepted edge in which edges are bounce
+   */
+  void reset(uint32_t windowUs);
+
+  /**
+   * @brief Feed one raw edge
+   *
+   * @param timestampUs Time of the edge
+   * @param level Pin level after the edge
+   * @return true if the edge is a new contact change, false for bounce
+   *         or an edge to the level that is already accepted
+   */
+  bool accept(int64_t timestampUs, bool level);
+
+  /**
+   * @brief Time at which the pin level has to be read back
+   *
+   * @return int64_t End of the lockout, or INT64_MAX if nothing is to check
+   */
+  int64_t checkDueUs() const { return checkPending ? lockoutEndUs : INT64_MAX; }
+
+  /**
+   * @brief Compare the pin level with the accepted level after the lockout
+   *
+   * @param nowUs Current time
+   * @param pinLevel Level read from the pin
+   * @param timestampUs Set to the time of the change if there is one: the
+   *        last edge to pinLevel, or the end of the lockout if that edge
+   *        was lost
+   * @return true if the contact settled on the other level
+   */
+  bool check(int64_t nowUs, bool pinLevel, int64_t* timestampUs);
+
+  uint32_t bounces() const { return ignored; }
+
+private:
+  int64_t lockoutEndUs;
+  int64_t lastEdgeUs;             // Last raw edge, accepted or not
+  uint32_t windowUs;
+  uint32_t ignored;
+  bool haveEdge;
+  bool level;                     // Accepted level
+  bool lastLevel;                 // Level after the last raw edge
+  bool checkPending;
+};
+
+/**
+ * @brief Statistics of the input engine
+ */
+struct InputEngineStats {
+  uint32_t accepted;              // Events passed on
+  uint32_t rockerBounces;         // Rocker edges ignored as bounce
+  uint32_t buttonBounces;         // Button edges ignored as bounce
+  uint32_t reordered;             // Events that arrived before an older one
+  uint32_t overflows;             // Events dropped because too many were pending
+  uint32_t confirmed;             // Changes only found by reading the pin back
+};
+
+/**
+ * @brief Debounce and ordering of all clock events
+ */
+class InputEngine {
+public:
+  InputEngine();
+
+  /**
+   * @brief Drop pending events and set the debounce windows
+   */
+  void reset(uint32_t rockerWindowUs, uint32_t buttonWindowUs, uint32_t resolveWindowUs);
+
+  /**
+   * @brief Hand over an event from clockEventNext()
+   *
+   * Bounce is released to clockEventPool right away.
+   */
+  void push(ClockEvent* event);
+
+  /**
+   * @brief Time at which a pin has to be read back (see Debouncer::check)
+   *
+   * @return int64_t Timestamp, or INT64_MAX if nothing is to check
+   */
+  int64_t nextCheckUs() const;
+
+  /**
+   * @brief Read back the pins whose lockout has ended, a contact that
+   *        settled on the other level becomes a new pending event
+   *
+   * @param nowUs Current time, push all queued events first
+   * @param rockerLevel Level of the rocker pin (HIGH = white's side)
+   * @param buttonLevel Level of the button pin (active low)
+   */
+  void check(int64_t nowUs, bool rockerLevel, bool buttonLevel);
+
+  /**
+   * @brief Take the oldest event whose resolve window has passed (flag
+   *        falls have none)
+   *
+   * @param nowUs Current time
+   * @return ClockEvent* The event (give it back with clockEventPool.release)
+   *         or nullptr if none is due
+   */
+  ClockEvent* pop(int64_t nowUs);
+
+  /**
+   * @brief Time at which the oldest pending event becomes due
+   *
+   * @return int64_t Timestamp, or INT64_MAX if nothing is pending
+   */
+  int64_t nextDueUs() const;
+
+  InputEngineStats stats() const;
+
+private:
+  void confirm(ClockEventType type, uint8_t source, int64_t timestampUs);
+  void insert(ClockEvent* event);
+
+  Debouncer rocker;
+  Debouncer button;
+  ClockEvent* pending[INPUT_ENGINE_MAX_PENDING];   // Sorted, oldest first
+  uint8_t pendingCount;
+  uint32_t resolveWindowUs;
+  uint32_t accepted;
+  uint32_t reordered;
+  uint32_t overflows;
+  uint32_t confirmed;
+};
+
+#endif // INPUT_ENGINE_H
@@ -0,0 +1,80 @@
+/*
+  Latency Benchmark for Chess Clock
+
+  This file defines the on-device benchmark of the press-to-charge
+  latency: the time from an input edge until the time task has charged
+  it. It is enabled with LATENCY_BENCHMARK in config.h.
+
+  Synthetic probe events are posted every LATENCY_BENCH_PROBE_MS; real
+  presses are measured as well. Meanwhile the other core is kept under
+  worst-case load: flash sector erases and writes (which stall the
+  caches of both cores), UDP bursts as stand-in for MQTT traffic and
+  full-screen redraws. The flash load erases and writes the last sector
+  of the "bench" data partition (partitions.csv), which holds nothing
+  else.
+
+  With LATENCY_BENCH_FLASH_SCHEDULED the flash load is requested from the
+  flash writer instead of writing directly, as all other flash writes
+  are. Real presses get a histogram of their own: during a game their
+  p99 must be the same with and without the sustained flash load.
+*/
+
+#ifndef LATENCY_BENCH_H
+#define LATENCY_BENCH_H
+
+#include <stdint.h>
+#include <TFT_eSPI.h>
+#include "clock_event.h"
+
+#define LATENCY_BENCH_BUCKET_US 50
+#define LATENCY_BENCH_BUCKETS   200     // Last bucket also counts everything above
+
+/**
+ * @brief Latency distribution of one measuring point
+ */
+struct LatencyHistogram {
+  uint32_t samples;
+  uint32_t minUs;
+  uint32_t maxUs;
+  uint64_t totalUs;
+  uint32_t buckets[LATENCY_BENCH_BUCKETS];
+};
+
+/**
+ * @brief Start the probe timer
+ *
+ * @return true if the timer could be started
+ */
+bool latencyBenchStart();
+
+/**
+ * @brief Record that the time task received an event from the queue
+ */
+void latencyBenchRecordWake(const ClockEvent& event);
+
+/**
+ * @brief Record that the time task has charged an event
+ */
+void latencyBenchRecordCharge(const ClockEvent& event);
+
+/**
+ * @brief Task function of the flash load
+ */
+void latencyBenchFlashLoad(void* context);
+
+/**
+ * @brief Task function of the network load
+ */
+void latencyBenchNetworkLoad(void* context);
+
+/**
+ * @brief Draw the whole screen once (display load)
+ */
+void latencyBenchRedraw(TFT_eSPI* tft);
+
+/**
+ * @brief Print the latency distributions and the load counters
+ */
+void latencyBenchPrintReport();
+
+#endif // LATENCY_BENCH_H
@@ -0,0 +1,73 @@
+/*
+  LVGL Port for Chess Clock
+
+  This file connects LVGL to the TFT_eSPI display, the rotary encoder
+  (see rotary_decoder.h) and the touch controller (see touch.h).
+  LVGL renders into two small draw buffers in internal, DMA-capable RAM
+  which are queued on the SPI bus (see spi_bus.h) and pushed to the
+  ILI9341 with DMA while the next part of the frame is rendered. Everything else LVGL allocates (screens, styles,
+  images) lives in PSRAM, see LV_MEM_CUSTOM in platformio.ini.
+*/
+
+#ifndef LVGL_PORT_H
+#define LVGL_PORT_H
+
+#include <stdint.h>
+#include <TFT_eSPI.h>
+#include <lvgl.h>
+
+/**
+ * @brief Rendering statistics of the LVGL port
+ *
+ * A frame is one LVGL refresh that flushed at least one area.
+ */
+struct LvglPortStats {
+  uint32_t frames;                // Number of rendered frames
+  uint32_t flushes;               // Number of flushed areas
+  uint32_t flushBytes;            // Bytes sent to the display
+  uint32_t lastFrameUs;           // Render + flush time of the last frame
+  uint32_t maxFrameUs;            // Slowest frame since the last reset
+  uint64_t totalFrameUs;          // Sum of all frame times
+};
+
+/**
+ * @brief Initialize LVGL, the display driver and the encoder and touch input
+ *
+ * @param display The already initialized TFT
+ * @return true if the draw buffers, DMA and the encoder interrupt could be
+ *         set up
+ */
+bool lvglPortInit(TFT_eSPI* display);
+
+/**
+ * @brief Run LVGL timers and rendering, must be called regularly
+ *
+ * Rendered areas are only queued on the SPI bus and may still be sent
+ * after it returns. Code that draws with TFT_eSPI directly must hold the
+ * bus with spiBusAcquire() like everywhere else.
+ */
+void lvglPortLoop();
+
+/**
+ * @brief Route the encoder to the widgets of a group
+ *
+ * @param group Group of the screen that is currently shown
+ */
+void lvglPortSetGroup(lv_group_t* group);
+
+/**
+ * @brief Encoder steps since the last read, for screens outside LVGL
+ */
+int16_t lvglPortEncoderSteps();
+
+/**
+ * @brief Rendering statistics since the last reset
+ */
+const LvglPortStats& lvglPortStats();
+
+/**
+ * @brief Reset the rendering statistics
+ */
+void lvglPortResetStats();
+
+#endif // LVGL_PORT_H
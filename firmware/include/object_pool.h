@@ -0,0 +1,103 @@
+/*
+  Object Pool for Chess Clock
+
+  This file defines a fixed-size pool of objects with static storage.
+  acquire() and release() are lock-free and take constant time, so they
+  may be used from both cores and from interrupt handlers. Both are always
+  inlined, so inside an IRAM interrupt handler they are in IRAM as well.
+  The pool never touches the heap.
+*/
+
+#ifndef OBJECT_POOL_H
+#define OBJECT_POOL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+#include <new>
+
+template <typename T, uint16_t N>
+class ObjectPool {
+  static_assert(N > 0 && N < 0xFFFF, "Pool size must be 1..65534");
+
+public:
+  ObjectPool() : inUse(0), peak(0), exhausted(0) {
+    for (uint16_t i = 0; i < N; i++) {
+      next[i] = (i + 1 < N) ? (uint16_t)(i + 1) : EMPTY;
+    }
+    head.store(0);
+  }
+
+  /**
+   * @brief Take an object out of the pool
+   *
+   * @return T* Default constructed object or nullptr if the pool is empty
+   */
+  __attribute__((always_inline)) T* acquire() {
+    uint32_t current = head.load(std::memory_order_acquire);
+    uint16_t index;
+    do {
+      index = (uint16_t)current;
+      if (index == EMPTY) {
+        exhausted.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+      }
+      // The tag in the upper half changes on every update and protects against ABA
+    } while (!head.compare_exchange_weak(current, ((current + 0x10000) & 0xFFFF0000) | next[index],
+                                         std::memory_order_acq_rel, std::memory_order_acquire));
+
+    uint32_t count = inUse.fetch_add(1, std::memory_order_relaxed) + 1;
+    uint32_t highest = peak.load(std::memory_order_relaxed);
+    while (count > highest && !peak.compare_exchange_weak(highest, count, std::memory_order_relaxed)) {
+    }
+    return new (&storage[index]) T();
+  }
+
+  /**
+   * @brief Give an object back to the pool
+   *
+   * @param object Object returned by acquire() of this pool
+   */
+  __attribute__((always_inline)) void release(T* object) {
+    if (object == nullptr) {
+      return;
+    }
+    object->~T();
+    uint16_t index = (uint16_t)((Slot*)object - storage);
+
+    uint32_t current = head.load(std::memory_order_acquire);
+    do {
+      next[index] = (uint16_t)current;
+    } while (!head.compare_exchange_weak(current, ((current + 0x10000) & 0xFFFF0000) | index,
+                                         std::memory_order_acq_rel, std::memory_order_acquire));
+    inUse.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Check whether an object belongs to this pool
+   */
+  bool owns(const T* object) const {
+    return (const Slot*)object >= storage && (const Slot*)object < storage + N;
+  }
+
+  uint16_t capacity() const { return N; }
+  uint16_t used() const { return (uint16_t)inUse.load(std::memory_order_relaxed); }
+  uint16_t highWater() const { return (uint16_t)peak.load(std::memory_order_relaxed); }
+  uint32_t exhaustedCount() const { return exhausted.load(std::memory_order_relaxed); }
+
+private:
+  static const uint16_t EMPTY = 0xFFFF;
+
+  struct Slot {
+    alignas(T) uint8_t bytes[sizeof(T)];
+  };
+
+  Slot storage[N];
+  uint16_t next[N];
+  std::atomic<uint32_t> head;       // Tag (upper 16 bits) and index of the first free slot
+  std::atomic<uint32_t> inUse;       // 32 bit: native atomics on the ESP32-S3
+  std::atomic<uint32_t> peak;
+  std::atomic<uint32_t> exhausted;
+};
+
+#endif // OBJECT_POOL_H
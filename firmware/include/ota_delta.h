@@ -0,0 +1,76 @@
+/*
+  Delta OTA Update for Chess Clock
+
+  This file defines the OTA update that downloads a CDP1 delta patch and
+  applies it while streaming: the old image is read from the running app
+  slot (app0/app1 of default_16MB.csv), the new image is written to the
+  inactive slot. Patches are created with tools/delta_patch.py.
+
+  The slot is not erased up front. Every block of the new image is
+  handed to the flash writer (see flash_writer.h), which erases and
+  writes one sector at a time, and the download waits for it. The update
+  is only allowed in IDLE and is aborted at the next block once the
+  clock leaves IDLE.
+*/
+
+#ifndef OTA_DELTA_H
+#define OTA_DELTA_H
+
+#include <stddef.h>
+
+/**
+ * @brief Outcome of an update attempt
+ */
+enum class OtaDeltaResult {
+  UPDATED,                        // New image written and selected for the next boot
+  NO_UPDATE,                      // Server has no patch for this build
+  WRONG_BASE,                     // Patch was made for a different running image
+  DOWNLOAD_FAILED,                // HTTP error or connection lost
+  PATCH_FAILED,                   // Corrupt patch
+  VERIFY_FAILED,                  // SHA-256 of the new image does not match
+  FLASH_FAILED,                   // Reading or writing a partition failed
+  CANCELLED                       // The clock left IDLE
+};
+
+/**
+ * @brief Get a human-readable string of an update result
+ */
+const char* otaDeltaResultToString(OtaDeltaResult result);
+
+/**
+ * @brief Build id of the running firmware
+ *
+ * The first 16 hex digits of the ELF SHA-256, which is also the file name
+ * tools/delta_patch.py gives the patch for this build.
+ *
+ * @param buffer Output buffer, at least 17 bytes
+ * @param size Size of the output buffer
+ */
+void otaDeltaBuildId(char* buffer, size_t size);
+
+/**
+ * @brief Allow or stop updates
+ *
+ * Called by the time task on every state change, only IDLE allows them.
+ */
+void otaDeltaSetAllowed(bool allowed);
+
+/**
+ * @brief Download a patch and apply it to the inactive app slot
+ *
+ * Blocks until the download is complete or cancelled, not to be called
+ * from the flash writer task.
+ *
+ * @param url HTTP URL of the patch
+ * @return OtaDeltaResult UPDATED if the next boot starts the new image
+ */
+OtaDeltaResult otaDeltaApplyFromUrl(const char* url);
+
+/**
+ * @brief Look for a patch for this build under OTA_PATCH_URL_FORMAT
+ *
+ * Restarts the clock after a successful update.
+ */
+void otaDeltaCheckForUpdate();
+
+#endif // OTA_DELTA_H
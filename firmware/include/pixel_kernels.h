@@ -0,0 +1,94 @@
+/*
+  Pixel Kernels for Chess Clock
+
+  This file defines the per-pixel loops over RGB565 buffers: fill, byte
+  swap and blending towards a color (dimming, fades). Buffers are in
+  display byte order (high byte first in memory), like the sprite and
+  DMA band buffers, colors are passed as usual RGB565 values.
+
+  Each kernel has a scalar version, which is the reference. On the
+  ESP32-S3 the same kernels also exist for the PIE vector unit (128 bit,
+  8 pixels per instruction). The vector versions are only used after
+  pixelKernelsVerify() found them bit-exact with the scalar ones; buffers
+  that do not share their 16-byte alignment are handled by the scalar
+  versions.
+
+  The file contains no Arduino code.
+*/
+
+#ifndef PIXEL_KERNELS_H
+#define PIXEL_KERNELS_H
+
+#include <stdint.h>
+
+#if defined(ESP_PLATFORM)
+#include <sdkconfig.h>
+#endif
+
+#if defined(CONFIG_IDF_TARGET_ESP32S3)
+#define PIXEL_KERNELS_HAVE_SIMD 1
+#else
+#define PIXEL_KERNELS_HAVE_SIMD 0
+#endif
+
+/**
+ * @brief Set pixels to one color
+ *
+ * @param target Pixels in display byte order
+ * @param color RGB565 color
+ * @param count Number of pixels
+ */
+void pixelFillScalar(uint16_t* target, uint16_t color, uint32_t count);
+
+/**
+ * @brief Swap the bytes of every pixel (between RGB565 and display byte order)
+ *
+ * @param target Result, may be the same as source
+ * @param source Pixels to convert
+ * @param count Number of pixels
+ */
+void pixelSwapScalar(uint16_t* target, const uint16_t* source, uint32_t count);
+
+/**
+ * @brief Blend pixels towards a color
+ *
+ * Every channel becomes (color * w + pixel * (32 - w)) >> 5 with the
+ * weight w = (alpha + 4) >> 3, as in TFT_eSPI::alphaBlend().
+ *
+ * @param target Result in display byte order, may be the same as source
+ * @param source Pixels in display byte order
+ * @param color RGB565 color blended in
+ * @param alpha 0 keeps the pixels, 255 gives the color
+ * @param count Number of pixels
+ */
+void pixelBlendScalar(uint16_t* target, const uint16_t* source, uint16_t color, uint8_t alpha, uint32_t count);
+
+/**
+ * @brief Same as the scalar kernels, with the vector unit if enabled
+ */
+void pixelFill(uint16_t* target, uint16_t color, uint32_t count);
+void pixelSwap(uint16_t* target, const uint16_t* source, uint32_t count);
+void pixelBlend(uint16_t* target, const uint16_t* source, uint16_t color, uint8_t alpha, uint32_t count);
+
+/**
+ * @brief Compare the vector kernels with the scalar ones
+ *
+ * Runs all kernels over patterned pixels with every alignment, lengths
+ * around the vector width and every alpha value.
+ *
+ * @return true if all results are identical, false if they differ or
+ * there is no vector unit
+ */
+bool pixelKernelsVerify();
+
+/**
+ * @brief Use the vector kernels (ignored without vector unit)
+ */
+void pixelKernelsSetSimd(bool enabled);
+
+/**
+ * @brief Check whether the vector kernels are used
+ */
+bool pixelKernelsSimd();
+
+#endif // PIXEL_KERNELS_H
@@ -0,0 +1,26 @@
+/*
+  Pixels for Chess Clock
+
+  This file defines the start-up check of the pixel kernels (see
+  pixel_kernels.h): the vector kernels are compared with the scalar ones
+  and only enabled if they give identical results. With PIXEL_BENCHMARK
+  the cycles per pixel of both versions are printed afterwards, for a
+  DMA band in internal RAM and for a full screen in PSRAM.
+*/
+
+#ifndef PIXELS_H
+#define PIXELS_H
+
+/**
+ * @brief Check the vector kernels and enable them if they are exact
+ *
+ * @return true, the scalar kernels work in any case
+ */
+bool pixelsInit();
+
+/**
+ * @brief Print cycles per pixel of every kernel, scalar and vector
+ */
+void pixelsPrintBenchmark();
+
+#endif // PIXELS_H
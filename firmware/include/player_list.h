@@ -0,0 +1,85 @@
+/*
+  Player List for Chess Clock
+
+  This file defines the player selection screen over the club roster
+  (PLAYER_ROSTER_FILE in SPIFFS, see player_roster.h). Only the visible
+  rows are drawn (see virtual_list.h). Rendered rows are kept in a small
+  cache in PSRAM, so scrolling back and forth only copies pixels.
+
+  In portrait orientation the list scrolls with the ILI9341 hardware
+  scrolling: one encoder step moves the scroll start (VSCRSADD) and
+  sends the single row that came into view. The hardware only scrolls
+  along the panel's 320 line axis, so in landscape every scroll redraws
+  the visible rows from the cache instead.
+*/
+
+#ifndef PLAYER_LIST_H
+#define PLAYER_LIST_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <TFT_eSPI.h>
+
+/**
+ * @brief Scrolling statistics since boot
+ */
+struct PlayerListStats {
+  uint32_t updates;               // Encoder moves handled
+  uint32_t hardwareScrolls;       // Of these scrolled with VSCRSADD
+  uint32_t rowsDrawn;
+  uint32_t cacheHits;
+  uint32_t cacheMisses;
+  uint32_t maxUpdateUs;           // Slowest move (render + transfer)
+  uint64_t totalUpdateUs;
+};
+
+/**
+ * @brief Index the roster and allocate the row cache
+ *
+ * SPIFFS must be mounted and the player font loaded.
+ *
+ * @param display The display
+ * @return true if the roster could be read
+ */
+bool playerListInit(TFT_eSPI* display);
+
+/**
+ * @brief Show the list with the first player selected
+ *
+ * Must not be called while the bus is held with spiBusAcquire(), like
+ * all functions that draw.
+ *
+ * @param title Shown above the list
+ */
+void playerListShow(const char* title);
+
+/**
+ * @brief Move the selection
+ *
+ * @param steps Encoder steps, negative towards the start of the list
+ */
+void playerListScroll(int16_t steps);
+
+/**
+ * @brief Leave the list and reset the hardware scrolling
+ */
+void playerListHide();
+
+/**
+ * @brief Name of the selected player
+ *
+ * @return false if the roster is empty
+ */
+bool playerListSelectedName(char* buffer, size_t size);
+
+/**
+ * @brief Statistics since boot
+ */
+const PlayerListStats& playerListStats();
+
+/**
+ * @brief Print scroll times and row cache hits
+ */
+void playerListPrintStats();
+
+#endif // PLAYER_LIST_H
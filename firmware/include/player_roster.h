@@ -0,0 +1,68 @@
+/*
+  Player Roster for Chess Clock
+
+  This file defines the index of the club roster, a text file with one
+  "First Last" name per line (UTF-8). Only the offset of every line is
+  kept (4 bytes per player), names are read from the file when a row
+  becomes visible.
+
+  The class contains no Arduino code and reads the file through a
+  callback.
+*/
+
+#ifndef PLAYER_ROSTER_H
+#define PLAYER_ROSTER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief Reads bytes of the roster file
+ *
+ * @return true if all bytes could be read
+ */
+typedef bool (*RosterReadCallback)(void* context, uint32_t offset, uint8_t* target, uint32_t length);
+
+/**
+ * @brief Line index of the roster file
+ */
+class PlayerRoster {
+public:
+  PlayerRoster();
+
+  /**
+   * @brief Index the file
+   *
+   * Empty lines are skipped, lines beyond the capacity are ignored.
+   *
+   * @param read Reads the file
+   * @param context Passed to read
+   * @param fileSize Size of the file
+   * @param offsets Storage for one offset per player
+   * @param capacity Number of offsets in the storage
+   * @return true if the file could be read
+   */
+  bool load(RosterReadCallback read, void* context, uint32_t fileSize, uint32_t* offsets,
+            uint32_t capacity);
+
+  /**
+   * @brief Read the name of a player
+   *
+   * @param index Player number, 0 .. count() - 1
+   * @param buffer Receives the zero-terminated name, cut off if too long
+   * @param size Size of the buffer
+   * @return true if the name could be read
+   */
+  bool name(uint32_t index, char* buffer, size_t size) const;
+
+  uint32_t count() const { return players; }
+
+private:
+  RosterReadCallback read;
+  void* context;
+  uint32_t fileSize;
+  uint32_t* offsets;
+  uint32_t players;
+};
+
+#endif // PLAYER_ROSTER_H
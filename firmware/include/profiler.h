@@ -0,0 +1,57 @@
+/*
+  Profiler for Chess Clock
+
+  This file defines the optional sampling profiler (PROFILER_ENABLED in
+  config.h). A hardware timer per core interrupts PROFILER_SAMPLE_HZ
+  times per second and records the interrupted program counter and task
+  into a ring in PSRAM (see sample_ring.h). The profiler task drains the
+  rings and streams the samples over the serial port as text lines:
+
+    @T <id> <task name>           first sample of a task
+    @S <core> <id> <pc>           one sample, pc in hex
+    @D <core> <dropped>           samples lost because the ring was full
+
+  tools/profiler.py symbolizes them against the firmware ELF into a flat
+  profile and a flame graph (core, task, function).
+
+  The interrupted PC is taken from the frame that the interrupt entry
+  saved for the task. Code that runs with interrupts disabled is not
+  sampled; its time shows up at the instruction that enables them again.
+  At full rate the stream needs the USB CDC port, a 115200 baud UART
+  drops samples (counted in @D).
+*/
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdint.h>
+
+/**
+ * @brief Profiler statistics since start
+ */
+struct ProfilerStats {
+  uint32_t samples[2];            // Per core
+  uint32_t dropped[2];
+  uint32_t streamed;
+};
+
+/**
+ * @brief Allocate the rings and start sampling on the calling core
+ *
+ * The other core starts sampling when the profiler task runs on it.
+ *
+ * @return true if the rings and the timer could be set up
+ */
+bool profilerStart();
+
+/**
+ * @brief Task that starts sampling on its core and streams the samples
+ */
+void profilerTask(void*);
+
+/**
+ * @brief Statistics since start
+ */
+const ProfilerStats& profilerStats();
+
+#endif // PROFILER_H
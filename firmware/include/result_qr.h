@@ -0,0 +1,52 @@
+/*
+  Result QR Code for Chess Clock
+
+  This file defines the QR code shown at SAVE_GAME_RESULT. The game record
+  is encoded only once per record revision into a 1-bit bitmap cached in
+  PSRAM. Showing it again just expands the cached bitmap to RGB565 with
+  the chosen scale and streams it to the display.
+*/
+
+#ifndef RESULT_QR_H
+#define RESULT_QR_H
+
+#include <stdint.h>
+#include <TFT_eSPI.h>
+#include "game_record.h"
+
+/**
+ * @brief Statistics of the last QR encoding
+ */
+struct ResultQrStats {
+  uint32_t encodeUs;              // Serialization + QR encoding time
+  uint32_t blitUs;                // Time of the last display transfer
+  uint16_t payloadBytes;          // Length of the encoded text
+  uint8_t version;                // QR version (1..40)
+  uint8_t modules;                // Modules per side
+};
+
+/**
+ * @brief Show the QR code of a game record
+ *
+ * Encodes the record if it changed since the last call.
+ *
+ * @param display The TFT to draw on
+ * @param record The record to share
+ * @param x Left edge of the QR area
+ * @param y Top edge of the QR area
+ * @param maxSize Width and height available for the QR code in pixels
+ * @return true if the QR code was drawn
+ */
+bool resultQrShow(TFT_eSPI* display, const GameRecord& record, int32_t x, int32_t y, int32_t maxSize);
+
+/**
+ * @brief Drop the cached bitmap and free its memory
+ */
+void resultQrRelease();
+
+/**
+ * @brief Statistics of the cached QR code
+ */
+const ResultQrStats& resultQrStats();
+
+#endif // RESULT_QR_H
@@ -0,0 +1,78 @@
+/*
+  Rotary Decoder for Chess Clock
+
+  This file defines the quadrature decoder of the rotary encoder. Both
+  encoder pins interrupt on every change and the handler passes their
+  levels to update(), so no transition is lost however seldom the steps
+  are read. A step counts when the pins are back in the detent (both
+  high) after more than half a cycle in one direction; contact bounce
+  between two neighbouring states cancels out. A transition in which
+  both pins changed at once (an interrupt was missed) has no direction
+  and is only counted.
+
+  update() is called by one interrupt handler and is always inlined, so
+  it is in IRAM together with the handler. take() may run in any task.
+  The class contains no Arduino code.
+*/
+
+#ifndef ROTARY_DECODER_H
+#define ROTARY_DECODER_H
+
+#include <stdint.h>
+#include <atomic>
+
+class RotaryDecoder {
+public:
+  RotaryDecoder();
+
+  /**
+   * @brief Start from the current pin levels
+   */
+  void reset(bool a, bool b);
+
+  /**
+   * @brief Feed the pin levels after a change (interrupt handler only)
+   */
+  __attribute__((always_inline)) void update(bool a, bool b) {
+    uint8_t current = (uint8_t)((a ? 1 : 0) | (b ? 2 : 0));
+    if (current == state) {
+      return;
+    }
+    if ((current ^ state) == 3) {
+      skipped++;
+    } else {
+      quarters += DIRECTION[(state << 2) | current];
+    }
+    state = current;
+
+    if (current == DETENT) {
+      int8_t step = quarters >= 2 ? 1 : (quarters <= -2 ? -1 : 0);
+      quarters = 0;
+      if (step != 0) {
+        counted.store(counted.load(std::memory_order_relaxed) + step, std::memory_order_release);
+      }
+    }
+  }
+
+  /**
+   * @brief Steps since the last call, positive is clockwise
+   */
+  int16_t take();
+
+  /**
+   * @brief Transitions that skipped a state
+   */
+  uint32_t skippedCount() const { return skipped; }
+
+private:
+  static const uint8_t DETENT = 3;
+  static const int8_t DIRECTION[16];   // Quarter step of each transition, index old << 2 | new
+
+  std::atomic<int32_t> counted;   // Written by update() only
+  int32_t taken;                  // Read by take() only
+  uint8_t state;
+  int8_t quarters;                // Progress since the last detent
+  volatile uint32_t skipped;
+};
+
+#endif // ROTARY_DECODER_H
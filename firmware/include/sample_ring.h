@@ -0,0 +1,77 @@
+/*
+  Sample Ring for Chess Clock
+
+  This file defines the ring buffer of the sampling profiler (see
+  profiler.h): one producer, normally a timer interrupt, and one consumer
+  on any core. push() and pop() are lock-free and take constant time. A
+  full ring drops the new sample and counts it, so the producer never
+  waits. The storage is passed in by the caller (PSRAM on the device).
+*/
+
+#ifndef SAMPLE_RING_H
+#define SAMPLE_RING_H
+
+#include <stdint.h>
+#include <atomic>
+
+/**
+ * @brief One profiler sample
+ */
+struct ProfileSample {
+  uint32_t pc;                    // Interrupted instruction
+  uint32_t task;                  // Interrupted task (handle)
+};
+
+/**
+ * @brief Single producer, single consumer ring of samples
+ */
+class SampleRing {
+public:
+  SampleRing();
+
+  /**
+   * @brief Set the storage
+   *
+   * @param storage Sample buffer
+   * @param capacity Number of samples, must be a power of two
+   * @return false if the capacity is not a power of two
+   */
+  bool begin(ProfileSample* storage, uint32_t capacity);
+
+  /**
+   * @brief Add a sample (producer only)
+   *
+   * @return false if the ring was full and the sample was dropped
+   */
+  __attribute__((always_inline)) bool push(uint32_t pc, uint32_t task) {
+    uint32_t tail = written.load(std::memory_order_relaxed);
+    if (tail - read.load(std::memory_order_acquire) >= capacity) {
+      lost++;
+      return false;
+    }
+    ProfileSample& sample = samples[tail & (capacity - 1)];
+    sample.pc = pc;
+    sample.task = task;
+    written.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Take the oldest sample (consumer only)
+   *
+   * @return false if the ring is empty
+   */
+  bool pop(ProfileSample* sample);
+
+  uint32_t size() const;
+  uint32_t dropped() const { return lost; }
+
+private:
+  ProfileSample* samples;
+  uint32_t capacity;
+  std::atomic<uint32_t> written;
+  std::atomic<uint32_t> read;
+  volatile uint32_t lost;
+};
+
+#endif // SAMPLE_RING_H
@@ -0,0 +1,138 @@
+/*
+  Scheduler for Chess Clock
+
+  This file defines the cooperative scheduler that runs all periodic and
+  one-shot work of the main loop (display refresh, SNTP, input handling,
+  ...). Jobs are kept in a hierarchical timing wheel: four levels of 64
+  slots with a 1 ms tick cover about 4.6 hours, and adding, cancelling
+  and expiring a job takes constant time regardless of how many jobs
+  exist.
+
+  For every job the scheduler records how often it ran, how long it took
+  and how late it started. A job that starts later than its tolerance
+  counts as a deadline miss. Jobs with a run time budget are also
+  recorded in a deadline monitor (see deadline_monitor.h), if one is set.
+
+  The class contains no Arduino code. Time is passed in by the caller and
+  read through a function pointer, so it also runs in virtual time.
+*/
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <stdint.h>
+#include "deadline_monitor.h"
+
+#define SCHEDULER_TICK_US     1000
+#define SCHEDULER_LEVELS      4
+#define SCHEDULER_SLOT_BITS   6
+#define SCHEDULER_SLOTS       (1 << SCHEDULER_SLOT_BITS)
+
+/**
+ * @brief One job of the scheduler
+ *
+ * The job is owned by the caller and must stay valid while it is
+ * scheduled. Only name, run, context, periodMs, toleranceMs and budgetUs
+ * are set by the caller, the other fields belong to the scheduler.
+ */
+struct SchedulerJob {
+  const char* name;               // Name shown in the report
+  void (*run)(void* context);     // Work to do
+  void* context;                  // Passed to run
+  uint32_t periodMs;              // Interval, 0 for a one-shot job
+  uint32_t toleranceMs;           // Allowed start delay before it counts as a miss
+  uint32_t budgetUs;              // Run time budget for the deadline monitor, 0 if not monitored
+
+  // Statistics
+  uint32_t runs;
+  uint32_t misses;                // Started later than toleranceMs
+  uint32_t maxRunUs;
+  uint64_t totalRunUs;
+  uint32_t maxLateUs;
+
+  // Intern
+  uint64_t dueTick;
+  SchedulerJob* next;
+  SchedulerJob* prev;
+  SchedulerJob** head;            // List the job is in, nullptr if not scheduled
+  DeadlineStage deadline;         // Registered on the first add() with a monitor
+};
+
+/**
+ * @brief Hierarchical timing wheel
+ */
+class Scheduler {
+public:
+  /**
+   * @brief Set the time source and the start of tick 0
+   *
+   * @param now Returns the current time in microseconds
+   */
+  void begin(int64_t (*now)());
+
+  /**
+   * @brief Record the run times of jobs with a budget in a deadline monitor
+   *
+   * Call it before adding the jobs.
+   *
+   * @param monitor The monitor, nullptr to stop recording
+   */
+  void setMonitor(DeadlineMonitor* monitor);
+
+  /**
+   * @brief Schedule a job, replacing an earlier schedule of the same job
+   *
+   * @param job The job
+   * @param delayMs Time until the first run
+   */
+  void add(SchedulerJob* job, uint32_t delayMs);
+
+  /**
+   * @brief Remove a job, it may be added again later
+   */
+  void cancel(SchedulerJob* job);
+
+  /**
+   * @brief Run all jobs that are due
+   *
+   * Jobs may add and cancel jobs, including themselves.
+   */
+  void run();
+
+  /**
+   * @brief Time until the next job is due, so the caller can sleep until
+   *        then instead of polling every tick
+   *
+   * @return uint32_t Milliseconds (0 if a job is already due), or
+   *         UINT32_MAX if no job is scheduled
+   */
+  uint32_t nextDueMs() const;
+
+  /**
+   * @brief Check whether a job is scheduled
+   */
+  static bool isScheduled(const SchedulerJob* job) { return job->head != nullptr; }
+
+  /**
+   * @brief Clear the statistics of a job
+   */
+  static void resetStats(SchedulerJob* job);
+
+private:
+  void insert(SchedulerJob* job, uint64_t earliestTick);
+  void cascade(uint8_t level);
+  uint64_t nextDueTick() const;
+
+  static void link(SchedulerJob** head, SchedulerJob* job);
+  static void unlink(SchedulerJob* job);
+
+  int64_t (*nowUs)();
+  DeadlineMonitor* monitor;
+  int64_t originUs;
+  uint64_t currentTick;           // Last tick that was processed
+  SchedulerJob* runningJob;
+  bool runningCancelled;          // runningJob cancelled itself
+  SchedulerJob* slots[SCHEDULER_LEVELS][SCHEDULER_SLOTS];
+};
+
+#endif // SCHEDULER_H
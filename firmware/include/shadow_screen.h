@@ -0,0 +1,75 @@
+/*
+  Shadow Screen for Chess Clock
+
+  This file defines drawing of the screens that are not LVGL menus (idle
+  clock, result, ...) through a full-screen sprite in PSRAM. Code draws
+  into the canvas with the usual TFT_eSPI calls and then calls
+  shadowScreenPush(): only the 16x16 tiles that changed since the last
+  push are sent (see tile_diff.h), copied band by band into two small DMA
+  buffers while the SPI bus sends the other one.
+
+  Whatever is drawn onto the display directly (logo, QR code) stays as
+  long as the canvas does not change below it. After LVGL or anything
+  else has drawn a whole screen, call shadowScreenInvalidate().
+*/
+
+#ifndef SHADOW_SCREEN_H
+#define SHADOW_SCREEN_H
+
+#include <stdint.h>
+#include <TFT_eSPI.h>
+#include "tile_diff.h"
+
+/**
+ * @brief Push statistics since boot
+ */
+struct ShadowScreenStats {
+  uint32_t pushes;
+  uint32_t maxPushUs;             // Slowest push (hashing + transfer)
+  uint64_t totalPushUs;
+  uint64_t totalHashUs;           // Part of the push time spent hashing
+};
+
+/**
+ * @brief Allocate the canvas and the band buffers
+ *
+ * @param display The display, sets the size of the canvas
+ * @return true if the buffers could be allocated
+ */
+bool shadowScreenInit(TFT_eSPI* display);
+
+/**
+ * @brief Check whether the canvas exists
+ */
+bool shadowScreenReady();
+
+/**
+ * @brief The canvas to draw into (same size as the display)
+ */
+TFT_eSprite& shadowScreenCanvas();
+
+/**
+ * @brief Send the changed parts of the canvas
+ *
+ * Waits until they were sent. Must not be called while the bus is held
+ * with spiBusAcquire().
+ */
+void shadowScreenPush();
+
+/**
+ * @brief Send the whole canvas with the next push
+ */
+void shadowScreenInvalidate();
+
+/**
+ * @brief Diff and push statistics
+ */
+const TileDiffStats& shadowScreenDiffStats();
+const ShadowScreenStats& shadowScreenStats();
+
+/**
+ * @brief Print the bytes sent compared with full redraws
+ */
+void shadowScreenPrintStats();
+
+#endif // SHADOW_SCREEN_H
@@ -0,0 +1,86 @@
+/*
+  Smooth Text for Chess Clock
+
+  This file defines drawing of anti-aliased text with the player font
+  (PLAYER_FONT_FILE in SPIFFS). Unlike TFT_eSPI's own smooth font
+  rendering, which reads every glyph from the file system again for every
+  character, the glyphs are decoded once into the PSRAM glyph cache (see
+  glyph_cache.h). A text line is rendered into a band buffer and sent as
+  one DMA transfer through the SPI bus (see spi_bus.h).
+
+  Names are UTF-8, so umlauts work if the font contains them (create it
+  with the Latin-1 range).
+*/
+
+#ifndef SMOOTH_TEXT_H
+#define SMOOTH_TEXT_H
+
+#include <stdint.h>
+#include "glyph_cache.h"
+
+/**
+ * @brief Load the player font and allocate the cache
+ *
+ * SPIFFS must already be mounted.
+ *
+ * @param maxWidth Widest line that will be drawn (normally the screen width)
+ * @return true if the font could be loaded
+ */
+bool smoothTextInit(int32_t maxWidth);
+
+/**
+ * @brief Check whether the font was loaded
+ */
+bool smoothTextReady();
+
+/**
+ * @brief Height of one text line in pixels
+ */
+int16_t smoothTextLineHeight();
+
+/**
+ * @brief Width of a UTF-8 text in pixels (cached)
+ */
+int32_t smoothTextWidth(const char* text);
+
+/**
+ * @brief Draw one line of text including its background box
+ *
+ * Waits until the line was sent. Must not be called while the bus is
+ * held with spiBusAcquire().
+ *
+ * @param x Left edge of the box on the screen
+ * @param y Top edge of the box
+ * @param width Width of the box (max. the width given to smoothTextInit())
+ * @param text UTF-8 text, cut off at the box
+ * @param foreground Text colour (RGB565)
+ * @param background Box colour (RGB565)
+ * @param centered Center the text in the box instead of starting at the left
+ */
+void smoothTextDraw(int32_t x, int32_t y, int32_t width, const char* text, uint16_t foreground,
+                    uint16_t background, bool centered);
+
+/**
+ * @brief Render one line of text into a buffer instead of the screen
+ *
+ * @param target width * smoothTextLineHeight() pixels in display byte order
+ * @param width Width of the buffer
+ * @param text UTF-8 text, cut off at the buffer
+ * @param foreground Text colour (RGB565)
+ * @param background Box colour (RGB565)
+ * @param centered Center the text instead of starting at the left
+ */
+void smoothTextRender(uint16_t* target, int32_t width, const char* text, uint16_t foreground,
+                      uint16_t background, bool centered);
+
+/**
+ * @brief Glyph cache statistics since the last reset
+ */
+const GlyphCacheStats& smoothTextStats();
+
+/**
+ * @brief Print cache hits, misses and bytes read from the file system
+ */
+void smoothTextPrintStats();
+
+#endif // SMOOTH_TEXT_H
@@ -0,0 +1,32 @@
+/*
+  SNTP Client for Chess Clock
+
+  This file defines a small non-blocking SNTP client that feeds bursts of
+  timestamped exchanges into a WallClock. The packets are built and
+  checked in sntp_packet.h. The server is taken from config.h, so a
+  local SNTP stand-in can be used for testing.
+*/
+
+#ifndef SNTP_CLIENT_H
+#define SNTP_CLIENT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "sntp_packet.h"
+#include "wall_clock.h"
+
+/**
+ * @brief Start the client
+ *
+ * @param clock The wall clock that receives the samples
+ */
+void sntpClientBegin(WallClock* clock);
+
+/**
+ * @brief Run the client, must be called regularly from loop()
+ *
+ * Never blocks. Requests are only sent while Wi-Fi is connected.
+ */
+void sntpClientLoop();
+
+#endif // SNTP_CLIENT_H
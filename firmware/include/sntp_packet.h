@@ -0,0 +1,38 @@
+/*
+  SNTP Packets for Chess Clock
+
+  This file defines the SNTP (RFC 4330) client request and the checks
+  of the server reply. The sntp_client.h UDP client uses them. They
+  contain no Arduino or network code, so they can be tested on the host.
+*/
+
+#ifndef SNTP_PACKET_H
+#define SNTP_PACKET_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define SNTP_PACKET_SIZE 48
+
+/**
+ * @brief Build an SNTP client request
+ *
+ * @param packet Buffer of SNTP_PACKET_SIZE bytes
+ * @param token Value placed in the transmit timestamp, echoed by the server
+ */
+void sntpBuildRequest(uint8_t* packet, uint64_t token);
+
+/**
+ * @brief Parse an SNTP server reply
+ *
+ * @param packet Received packet
+ * @param length Length of the received packet
+ * @param token Token of the request this reply must answer
+ * @param serverRecvUs Receive timestamp of the server (Unix, microseconds)
+ * @param serverSendUs Transmit timestamp of the server (Unix, microseconds)
+ * @return true if the reply is valid and answers the request
+ */
+bool sntpParseReply(const uint8_t* packet, size_t length, uint64_t token,
+                    int64_t* serverRecvUs, int64_t* serverSendUs);
+
+#endif // SNTP_PACKET_H
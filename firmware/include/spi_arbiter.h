@@ -0,0 +1,149 @@
+/*
+  SPI Arbiter for Chess Clock
+
+  This file defines the scheduling of SPI transactions of the devices on
+  the shared FSPI bus (display and touch controller). Every device has
+  its own FIFO queue and a fixed priority. Pixel transfers are split into
+  chunks of a few lines, and before each chunk the queues are checked
+  again, so a short touch sample waits at most for one chunk instead of a
+  whole frame.
+
+  Pixel chunks that continue the address window of the chunk before
+  (same columns, next line, nothing else on the bus in between) are
+  marked, so the executor can send them without a new address window and
+  chip select cycle. Consecutive LVGL bands are coalesced this way.
+
+  The class contains no Arduino code: it only decides what runs next and
+  keeps bus statistics, the executor (see spi_bus.h) does the transfers.
+  All calls must be serialized by the caller.
+*/
+
+#ifndef SPI_ARBITER_H
+#define SPI_ARBITER_H
+
+#include <stdint.h>
+
+/**
+ * @brief Devices on the bus, lower values have higher priority
+ */
+enum class SpiDevice : uint8_t {
+  TOUCH,
+  DISPLAY,
+  COUNT
+};
+
+struct SpiTransaction;
+
+/**
+ * @brief Called by the executor when a transaction is finished
+ */
+typedef void (*SpiDoneCallback)(SpiTransaction* transaction);
+
+/**
+ * @brief One queued transaction
+ *
+ * A transaction with pixels is a block transfer to the display, one
+ * without pixels runs its command callback as a whole.
+ */
+struct SpiTransaction {
+  SpiDevice device;
+  int32_t x;                      // Target area of a pixel transfer
+  int32_t y;
+  int32_t width;
+  int32_t height;
+  const uint16_t* pixels;         // nullptr for a command transaction
+  void (*command)(void* context); // Runs the transfer of a command transaction
+  SpiDoneCallback done;           // Optional
+  void* context;
+
+  // Intern
+  int32_t sentLines;
+  int64_t enqueuedUs;
+  bool started;
+  SpiTransaction* next;
+};
+
+/**
+ * @brief Piece of work selected by SpiArbiter::next()
+ */
+struct SpiWork {
+  SpiTransaction* transaction;
+  int32_t firstLine;              // First line of the chunk (pixel transfers)
+  int32_t lines;                  // Lines in this chunk, 0 for a command
+  bool continuesWindow;           // Follows the previous chunk directly
+  bool lastChunk;                 // Transaction is finished after this chunk
+};
+
+/**
+ * @brief Statistics of one device
+ */
+struct SpiDeviceStats {
+  uint32_t transactions;          // Finished transactions
+  uint32_t chunks;
+  uint32_t coalesced;             // Chunks that reused the open address window
+  uint64_t busyUs;                // Time the device used the bus
+  uint64_t totalWaitUs;           // Enqueue until the first chunk started
+  uint32_t maxWaitUs;
+};
+
+class SpiArbiter {
+public:
+  SpiArbiter();
+
+  /**
+   * @brief Drop all queues and statistics
+   *
+   * @param chunkLines Max. lines of one pixel chunk
+   * @param nowUs Start of the statistics period
+   */
+  void reset(int32_t chunkLines, int64_t nowUs);
+
+  /**
+   * @brief Append a transaction to the queue of its device
+   */
+  void enqueue(SpiTransaction* transaction, int64_t nowUs);
+
+  /**
+   * @brief Select the next chunk of the highest priority device
+   *
+   * @param work Filled with the selected chunk
+   * @return false if all queues are empty
+   */
+  bool next(SpiWork& work, int64_t nowUs);
+
+  /**
+   * @brief Report that a chunk selected by next() was sent
+   *
+   * @param busyUs Time the chunk occupied the bus
+   * @return true if the transaction is finished (call its done callback)
+   */
+  bool complete(const SpiWork& work, uint32_t busyUs);
+
+  /**
+   * @brief Forget the open address window (another bus user came in between)
+   */
+  void breakWindow() { windowOpen = false; }
+
+  bool idle() const;
+  const SpiDeviceStats& stats(SpiDevice device) const { return deviceStats[(int)device]; }
+
+  /**
+   * @brief Bus utilization since reset() in percent
+   */
+  uint32_t utilizationPercent(int64_t nowUs) const;
+
+private:
+  SpiTransaction* heads[(int)SpiDevice::COUNT];
+  SpiTransaction* tails[(int)SpiDevice::COUNT];
+  SpiDeviceStats deviceStats[(int)SpiDevice::COUNT];
+  int32_t chunkLines;
+  int64_t periodStartUs;
+
+  // Address window of the last pixel chunk
+  bool windowOpen;
+  int32_t windowX;
+  int32_t windowWidth;
+  int32_t windowNextY;
+};
+
+#endif // SPI_ARBITER_H
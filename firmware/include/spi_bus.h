@@ -0,0 +1,57 @@
+/*
+  SPI Bus for Chess Clock
+
+  This file defines the owner of the shared FSPI bus. Transactions of the
+  display and the touch controller are submitted from any task and run
+  by the spi_bus task in the order chosen by SpiArbiter (see
+  spi_arbiter.h). Pixel transfers use DMA chunk by chunk.
+
+  Code that draws with TFT_eSPI directly (text, fills, ...) must hold the
+  bus with spiBusAcquire() / spiBusRelease(); the bus task finishes its
+  current chunk and closes the display window first.
+*/
+
+#ifndef SPI_BUS_H
+#define SPI_BUS_H
+
+#include <stdint.h>
+#include <TFT_eSPI.h>
+#include "spi_arbiter.h"
+
+/**
+ * @brief Set up the bus owner
+ *
+ * @param display The display on the bus (also used for the touch controller)
+ * @return true if the bus could be set up
+ */
+bool spiBusInit(TFT_eSPI* display);
+
+/**
+ * @brief Queue a transaction
+ *
+ * The transaction and its pixels must stay valid until its done
+ * callback ran.
+ */
+void spiBusSubmit(SpiTransaction* transaction);
+
+/**
+ * @brief Take the bus for direct TFT_eSPI drawing
+ */
+void spiBusAcquire();
+
+/**
+ * @brief Give the bus back after spiBusAcquire()
+ */
+void spiBusRelease();
+
+/**
+ * @brief Task function of the bus owner (see the task topology)
+ */
+void spiBusTask(void* context);
+
+/**
+ * @brief Print utilization, queueing delay and coalesced chunks per device
+ */
+void spiBusPrintStats();
+
+#endif // SPI_BUS_H
@@ -0,0 +1,52 @@
+/*
+  Task Topology for Chess Clock
+
+  This file defines the long-running FreeRTOS tasks of the clock. All of
+  them are described in one table with their core and priority, so the
+  split between the cores is visible in one place: input and time
+  keeping run alone on one core at high priority, rendering, network and
+  storage share the other core.
+*/
+
+#ifndef TASK_TOPOLOGY_H
+#define TASK_TOPOLOGY_H
+
+#include <stdint.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#define TASK_TOPOLOGY_MAX_TASKS 10
+
+/**
+ * @brief One task of the topology
+ */
+struct TaskSpec {
+  const char* name;               // Name shown in the task report
+  void (*run)(void* context);     // Task function, must not return
+  int8_t core;                    // Core to run on (0, 1, or -1 for any)
+  uint8_t priority;               // FreeRTOS priority
+  uint32_t stackSize;             // Stack in bytes
+};
+
+/**
+ * @brief Create all tasks of the table
+ *
+ * @param tasks The tasks
+ * @param count Number of tasks (max. TASK_TOPOLOGY_MAX_TASKS)
+ * @return true if all tasks could be created
+ */
+bool taskTopologyStart(const TaskSpec* tasks, uint8_t count);
+
+/**
+ * @brief Get the handle of a task by its index in the table
+ *
+ * @return TaskHandle_t The handle or nullptr if the task was not created
+ */
+TaskHandle_t taskTopologyHandle(uint8_t index);
+
+/**
+ * @brief Print core, priority and unused stack of every task
+ */
+void taskTopologyPrintReport();
+
+#endif // TASK_TOPOLOGY_H
@@ -0,0 +1,107 @@
+/*
+  Tile Diff for Chess Clock
+
+  This file defines the change detection of the shadow screen (see
+  shadow_screen.h). The frame is split into 16x16 tiles and every tile is
+  hashed. Only tiles whose hash differs from the last pushed frame are
+  sent, and adjacent dirty tiles are merged into as few rectangles as
+  possible: runs of dirty tiles in one tile row become one span, and
+  spans with the same columns in consecutive rows become one rectangle.
+
+  The hash is 32 bit, so a changed tile is missed with a chance of about
+  1 in 4 billion; a full redraw after every screen change keeps such an
+  error from lasting.
+
+  The class contains no Arduino code, the frame and the hash table are
+  passed in by the caller.
+*/
+
+#ifndef TILE_DIFF_H
+#define TILE_DIFF_H
+
+#include <stdint.h>
+
+#define TILE_DIFF_SIZE        16
+#define TILE_DIFF_MAX_COLUMNS 64      // Widest frame: 1024 pixels
+
+/**
+ * @brief Area to send, in pixels
+ */
+struct TileRect {
+  int16_t x;
+  int16_t y;
+  int16_t width;
+  int16_t height;
+};
+
+/**
+ * @brief Counters since the last reset
+ */
+struct TileDiffStats {
+  uint32_t frames;
+  uint32_t tilesDirty;
+  uint32_t rects;
+  uint32_t overflows;             // Frames sent as one bounding box (too many rectangles)
+  uint64_t pixelsSent;
+  uint64_t pixelsFull;            // What full redraws would have sent
+};
+
+/**
+ * @brief Finds the changed parts of a frame
+ */
+class TileDiff {
+public:
+  TileDiff();
+
+  /**
+   * @brief Number of hashes needed for a frame size
+   */
+  static uint32_t tileCount(int32_t width, int32_t height);
+
+  /**
+   * @brief Set the frame size
+   *
+   * @param width Frame width (max. TILE_DIFF_MAX_COLUMNS tiles)
+   * @param height Frame height
+   * @param hashes Storage for tileCount() hashes
+   * @param capacity Number of hashes in the storage
+   * @return false if the frame is too wide or the storage too small
+   */
+  bool begin(int32_t width, int32_t height, uint32_t* hashes, uint32_t capacity);
+
+  /**
+   * @brief Treat every tile as changed in the next diff()
+   *
+   * Called when something else has drawn onto the screen.
+   */
+  void invalidate();
+
+  /**
+   * @brief Compare a frame with the last one and list the changed areas
+   *
+   * The frame becomes the new reference, so the caller must send all
+   * returned rectangles.
+   *
+   * @param frame Pixels, width * height, any byte order
+   * @param rects Receives the rectangles
+   * @param maxRects Size of rects; with more changed areas one bounding box is returned
+   * @return uint16_t Number of rectangles, 0 if nothing changed
+   */
+  uint16_t diff(const uint16_t* frame, TileRect* rects, uint16_t maxRects);
+
+  const TileDiffStats& stats() const { return counters; }
+  void resetStats();
+
+private:
+  uint32_t hashTile(const uint16_t* frame, int32_t column, int32_t row) const;
+
+  int32_t width;
+  int32_t height;
+  int32_t columns;
+  int32_t rows;
+  uint32_t* hashes;
+  bool invalid;
+  TileDiffStats counters;
+};
+
+#endif // TILE_DIFF_H
@@ -0,0 +1,32 @@
+/*
+  Time Controls for Chess Clock
+
+  This file defines the selectable game modes (base time and increment
+  per move) offered in the WAIT_FOR_MODE_SELECTION state.
+*/
+
+#ifndef TIME_CONTROL_H
+#define TIME_CONTROL_H
+
+#include <stdint.h>
+
+/**
+ * @brief A time control with base time and Fischer increment
+ */
+struct TimeControl {
+  const char* name;               // Name shown in the mode selection
+  uint32_t baseSeconds;           // Starting time per player
+  uint32_t incrementSeconds;      // Time added after each move
+};
+
+/**
+ * @brief All selectable time controls
+ */
+extern const TimeControl TIME_CONTROLS[];
+
+/**
+ * @brief Number of entries in TIME_CONTROLS
+ */
+extern const uint8_t TIME_CONTROL_COUNT;
+
+#endif // TIME_CONTROL_H
@@ -0,0 +1,110 @@
+/*
+  Time Engine for Chess Clock
+
+  This file defines the bookkeeping of both players' remaining time. It
+  is driven only by timestamps of the input edges (see edge_capture.h),
+  not by the time at which the main loop gets around to handle them, so
+  a late loop iteration never charges time to the wrong player.
+
+  The class contains no Arduino code and only works on timestamps passed
+  in by the caller.
+*/
+
+#ifndef TIME_ENGINE_H
+#define TIME_ENGINE_H
+
+#include <stdint.h>
+
+/**
+ * @brief One of the two players
+ */
+enum class Side : uint8_t {
+  WHITE,
+  BLACK
+};
+
+/**
+ * @brief Remaining time of both players with Fischer increment
+ */
+class TimeEngine {
+public:
+  TimeEngine();
+
+  /**
+   * @brief Set both clocks to the base time and stop them
+   *
+   * @param baseMs Starting time per player
+   * @param incrementMs Time added after each move
+   */
+  void reset(uint32_t baseMs, uint32_t incrementMs);
+
+  /**
+   * @brief Continue a saved game, stopped like after pause()
+   *
+   * @param whiteMs Remaining time of white
+   * @param blackMs Remaining time of black
+   * @param incrementMs Time added after each move
+   * @param side Side to move, its clock starts with resume()
+   */
+  void restore(uint32_t whiteMs, uint32_t blackMs, uint32_t incrementMs, Side side);
+
+  /**
+   * @brief Start the clock of one side
+   *
+   * @param side Side whose time starts running
+   * @param timestampUs Time of the starting edge
+   */
+  void start(Side side, int64_t timestampUs);
+
+  /**
+   * @brief The running side finished its move, start the other clock
+   *
+   * @param timestampUs Time of the edge that ended the move
+   * @return uint32_t Time the move took in milliseconds
+   */
+  uint32_t press(int64_t timestampUs);
+
+  /**
+   * @brief Stop the running clock
+   */
+  void pause(int64_t timestampUs);
+
+  /**
+   * @brief Continue the clock that was running before pause()
+   */
+  void resume(int64_t timestampUs);
+
+  /**
+   * @brief Remaining time of a side at a point in time
+   *
+   * @return int64_t Remaining microseconds, 0 once the flag has fallen
+   */
+  int64_t remainingUs(Side side, int64_t nowUs) const;
+
+  /**
+   * @brief Point in time at which the running side runs out of time
+   *
+   * @return int64_t Timestamp, or INT64_MAX if no clock is running
+   */
+  int64_t expiryUs() const;
+
+  /**
+   * @brief Check whether the running side has run out of time
+   */
+  bool flagFallen(int64_t nowUs) const;
+
+  bool isRunning() const { return running; }
+  Side activeSide() const { return active; }
+
+private:
+  void charge(int64_t timestampUs);
+
+  int64_t remaining[2];           // Remaining time at lastEventUs
+  int64_t incrementUs;
+  int64_t lastEventUs;            // Timestamp of the last start, press or resume
+  int64_t moveStartUs;            // Remaining time of the active side when its move began
+  Side active;                    // Running side, or the side to resume
+  bool running;
+};
+
+#endif // TIME_ENGINE_H
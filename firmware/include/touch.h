@@ -0,0 +1,71 @@
+/*
+  Touch Input for Chess Clock
+
+  This file defines the driver of the XPT2046 touch controller. Nothing
+  polls the controller while the screen is not touched: the falling edge
+  of its PENIRQ line wakes the touch task, which then samples through the
+  SPI bus (see spi_bus.h) every TOUCH_SAMPLE_MS until the pen is lifted,
+  and goes back to sleep on the interrupt.
+
+  The readings are filtered and calibrated by TouchFilter (see
+  touch_filter.h). The filtered position is kept for the LVGL pointer
+  input, recognized gestures are posted as TOUCH_GESTURE ClockEvents to
+  the state machine (see clock_event.h).
+*/
+
+#ifndef TOUCH_H
+#define TOUCH_H
+
+#include <stdint.h>
+#include <TFT_eSPI.h>
+#include "touch_filter.h"
+
+/**
+ * @brief Sampling statistics
+ */
+struct TouchStats {
+  uint32_t wakeups;               // Pen down interrupts
+  uint32_t samples;               // Accepted samples
+  uint32_t weakSamples;           // Samples below TOUCH_Z_THRESHOLD (pen lifting)
+  uint32_t gestures;              // Posted gestures
+  uint32_t dropped;               // Gestures lost because the pool or queue was full
+  uint32_t maxBusWaitUs;          // Submit to end of a sample transaction
+  uint32_t busTimeouts;           // Sample transactions not done within TOUCH_BUS_TIMEOUT_MS
+};
+
+/**
+ * @brief Set up the PENIRQ pin and the filter
+ *
+ * @param display The display that owns the touch controller
+ * @param width Screen width in pixels (after rotation)
+ * @param height Screen height in pixels
+ * @return true if the driver could be set up
+ */
+bool touchInit(TFT_eSPI* display, int16_t width, int16_t height);
+
+/**
+ * @brief Task function of the touch driver (see the task topology)
+ */
+void touchTask(void* context);
+
+/**
+ * @brief Current filtered position, pressed is false without a touch
+ */
+TouchPoint touchPoint();
+
+/**
+ * @brief Statistics since the last reset
+ */
+TouchStats touchStats();
+
+/**
+ * @brief Reset the statistics
+ */
+void touchResetStats();
+
+/**
+ * @brief Print the statistics to Serial
+ */
+void touchPrintStats();
+
+#endif // TOUCH_H
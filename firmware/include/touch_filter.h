@@ -0,0 +1,117 @@
+/*
+  Touch Filter for Chess Clock
+
+  This file defines the processing of raw XPT2046 readings: a median over
+  the oversampled readings removes single outliers, an IIR filter smooths
+  the remaining jitter, and the calibration maps raw values to screen
+  pixels. A small recognizer turns the filtered track of one touch into
+  a gesture (tap, long press or swipe).
+
+  The class contains no Arduino code and only works on the readings and
+  timestamps passed in by the caller, so recorded sample streams can be
+  replayed through it.
+*/
+
+#ifndef TOUCH_FILTER_H
+#define TOUCH_FILTER_H
+
+#include <stdint.h>
+
+#define TOUCH_FILTER_MAX_READINGS 9
+
+/**
+ * @brief Mapping of raw readings to screen pixels
+ */
+struct TouchCalibration {
+  uint16_t rawXMin;               // Raw values at the screen edges
+  uint16_t rawXMax;
+  uint16_t rawYMin;
+  uint16_t rawYMax;
+  bool swapXY;                    // Raw X runs along the screen's Y axis
+  bool invertX;                   // Applied after swapping
+  bool invertY;
+  int16_t width;                  // Screen size in pixels
+  int16_t height;
+};
+
+/**
+ * @brief Kind of a recognized gesture
+ */
+enum class TouchGestureType : uint8_t {
+  NONE,
+  TAP,
+  LONG_PRESS,
+  SWIPE_LEFT,
+  SWIPE_RIGHT,
+  SWIPE_UP,
+  SWIPE_DOWN
+};
+
+/**
+ * @brief One recognized gesture
+ */
+struct TouchGesture {
+  TouchGestureType type;
+  int16_t x;                      // Where the touch started
+  int16_t y;
+  int64_t timestampUs;            // When the gesture was recognized
+};
+
+/**
+ * @brief Filtered position of the pen
+ */
+struct TouchPoint {
+  int16_t x;
+  int16_t y;
+  bool pressed;
+};
+
+class TouchFilter {
+public:
+  TouchFilter();
+
+  /**
+   * @brief Set the calibration and forget the current touch
+   */
+  void begin(const TouchCalibration& calibration);
+
+  /**
+   * @brief Add one sample while the pen is down
+   *
+   * @param rawX Oversampled raw X readings
+   * @param rawY Oversampled raw Y readings
+   * @param count Number of readings (1..TOUCH_FILTER_MAX_READINGS)
+   * @param nowUs Time of the sample
+   * @param gesture Set if a long press was recognized
+   * @return true if gesture was set
+   */
+  bool addSample(const uint16_t* rawX, const uint16_t* rawY, uint8_t count, int64_t nowUs,
+                 TouchGesture* gesture);
+
+  /**
+   * @brief End the current touch
+   *
+   * @param nowUs Time the pen was lifted
+   * @param gesture Set if the touch was a tap or a swipe
+   * @return true if gesture was set
+   */
+  bool penUp(int64_t nowUs, TouchGesture* gesture);
+
+  TouchPoint point() const;
+
+private:
+  static uint16_t median(const uint16_t* values, uint8_t count);
+  void calibrate(uint16_t rawX, uint16_t rawY, int32_t* x, int32_t* y) const;
+
+  TouchCalibration cal;
+  bool pressed;
+  bool longPressSent;
+  bool moved;                     // Left the TOUCH_MOVE_MAX_PX circle around the start
+  int32_t filteredX;              // Screen pixels << 8
+  int32_t filteredY;
+  int16_t startX;
+  int16_t startY;
+  int64_t startUs;
+};
+
+#endif // TOUCH_FILTER_H
@@ -0,0 +1,114 @@
+/*
+  Trace for Chess Clock
+
+  This file defines the optional event trace (TRACE_ENABLED in config.h).
+  State transitions, input events, render passes, SPI chunks, flash writes and
+  network sends record begin/end or instant events into one ring per core
+  (see trace_ring.h) in PSRAM. Every event carries the cycle counter of
+  its core and the common microsecond time, so the host can line up both
+  cores with cycle resolution.
+
+  When an input takes longer than TRACE_TRIGGER_US from edge to handling,
+  recording stops and the last TRACE_DUMP_WINDOW_MS before it are printed
+  as text lines:
+
+    @F <cpu MHz>
+    @N <point> <name>
+    @K <task> <task name>
+    @E <core> <cycles> <us> <task> <point> <phase> <arg>
+    @X                            end of the dump
+
+  tools/trace.py converts them to Chrome trace JSON, which the Perfetto
+  UI and chrome://tracing open.
+
+  Recording is lock-free and may happen from tasks and interrupt
+  handlers, but not from IRAM handlers that run while the flash cache is
+  disabled (the rings are in PSRAM).
+*/
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+#include "config.h"
+#include "trace_ring.h"
+
+/**
+ * @brief Places that record events
+ */
+enum class TracePoint : uint16_t {
+  STATE,                          // State transition, arg = new state
+  EVENT,                          // Input or timer event handled, arg = event type
+  RENDER_STATE,                   // Screen of a new state, arg = state
+  CLOCK_FRAME,                    // Frame of the game clock
+  SHADOW_PUSH,                    // Changed tiles sent
+  SPI_CHUNK,                      // One DMA chunk on the SPI bus, arg = device
+  FLASH_WRITE,                    // Flash writer job, caches stalled
+  NETWORK_SEND,                   // Network packets (MQTT, benchmark bursts)
+  TRIGGER,                        // Recording stopped, arg = late ms
+  COUNT
+};
+
+/**
+ * @brief Allocate the rings and start recording
+ *
+ * @return true if the rings could be allocated
+ */
+bool traceInit();
+
+/**
+ * @brief Record an event on the calling core
+ */
+void traceRecord(TracePoint point, TracePhase phase, uint8_t arg);
+
+inline void traceBegin(TracePoint point, uint8_t arg = 0) {
+  if (TRACE_ENABLED) {
+    traceRecord(point, TracePhase::BEGIN, arg);
+  }
+}
+
+inline void traceEnd(TracePoint point, uint8_t arg = 0) {
+  if (TRACE_ENABLED) {
+    traceRecord(point, TracePhase::END, arg);
+  }
+}
+
+inline void traceInstant(TracePoint point, uint8_t arg = 0) {
+  if (TRACE_ENABLED) {
+    traceRecord(point, TracePhase::INSTANT, arg);
+  }
+}
+
+/**
+ * @brief Begin and end event around a block
+ */
+class TraceScope {
+public:
+  explicit TraceScope(TracePoint point, uint8_t arg = 0) : point(point), arg(arg) {
+    traceBegin(point, arg);
+  }
+  ~TraceScope() {
+    traceEnd(point, arg);
+  }
+
+private:
+  TracePoint point;
+  uint8_t arg;
+};
+
+/**
+ * @brief Check how late an input was handled, stop recording if too late
+ *
+ * @param lateUs Time from the edge until the input was handled
+ */
+void traceCheckLatency(uint32_t lateUs);
+
+/**
+ * @brief Print the events before the trigger and record again
+ *
+ * Does nothing if recording did not stop. Call it from a task with low
+ * priority, printing takes a while.
+ */
+void traceDumpIfTriggered();
+
+#endif // TRACE_H
@@ -0,0 +1,104 @@
+/*
+  Trace Ring for Chess Clock
+
+  This file defines the ring buffer of the event trace (see trace.h). It
+  is a flight recorder: record() never blocks and never fails, the oldest
+  events are overwritten. Any number of writers may record at the same
+  time (tasks and the interrupts that preempt them); a slot is claimed
+  with one atomic increment and stamped with its sequence number when
+  complete, so a reader can tell complete events from ones that are being
+  written or were overwritten meanwhile.
+
+  The storage is passed in by the caller. The class contains no Arduino
+  code.
+*/
+
+#ifndef TRACE_RING_H
+#define TRACE_RING_H
+
+#include <stdint.h>
+#include <atomic>
+
+/**
+ * @brief Kind of a trace event, the values are the Chrome trace phases
+ */
+enum class TracePhase : uint8_t {
+  BEGIN = 'B',
+  END = 'E',
+  INSTANT = 'i'
+};
+
+/**
+ * @brief One recorded event
+ */
+struct TraceEvent {
+  uint32_t sequence;              // Slot + 1 once complete, 0 while written
+  uint32_t cycles;                // CPU cycle counter of the recording core
+  uint32_t timeUs;                // Common time of both cores (lower 32 bits)
+  uint32_t task;                  // Recording task (handle)
+  uint16_t point;                 // What happened (see trace.h)
+  TracePhase phase;
+  uint8_t arg;                    // Point specific (state, device, ...)
+};
+
+/**
+ * @brief Multi-writer flight recorder of trace events
+ */
+class TraceRing {
+public:
+  TraceRing();
+
+  /**
+   * @brief Set the storage
+   *
+   * @param storage Event buffer
+   * @param capacity Number of events, must be a power of two
+   * @return false if the capacity is not a power of two
+   */
+  bool begin(TraceEvent* storage, uint32_t capacity);
+
+  /**
+   * @brief Record an event, overwriting the oldest one
+   */
+  __attribute__((always_inline)) void record(uint32_t cycles, uint32_t timeUs, uint32_t task, uint16_t point,
+                                             TracePhase phase, uint8_t arg) {
+    if (events == nullptr) {
+      return;
+    }
+    uint32_t slot = written.fetch_add(1, std::memory_order_relaxed);
+    TraceEvent& event = events[slot & (capacity - 1)];
+    __atomic_store_n(&event.sequence, 0, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    event.cycles = cycles;
+    event.timeUs = timeUs;
+    event.task = task;
+    event.point = point;
+    event.phase = phase;
+    event.arg = arg;
+    __atomic_store_n(&event.sequence, slot + 1, __ATOMIC_RELEASE);
+  }
+
+  /**
+   * @brief Number of events recorded since begin(), the next slot
+   */
+  uint32_t recorded() const { return written.load(std::memory_order_acquire); }
+
+  /**
+   * @brief Oldest slot that may still be in the ring
+   */
+  uint32_t oldest() const;
+
+  /**
+   * @brief Copy the event of a slot
+   *
+   * @return false if the slot is being written or was overwritten
+   */
+  bool read(uint32_t slot, TraceEvent* event) const;
+
+private:
+  TraceEvent* events;
+  uint32_t capacity;
+  std::atomic<uint32_t> written;
+};
+
+#endif // TRACE_RING_H
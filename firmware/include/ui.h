@@ -0,0 +1,44 @@
+/*
+  User Interface for Chess Clock
+
+  This file shows the LVGL screens of the menu states (see
+  ui_screens.h) on the display and reports their frame statistics.
+*/
+
+#ifndef UI_H
+#define UI_H
+
+#include <stdint.h>
+#include <TFT_eSPI.h>
+#include "state_machine.h"
+#include "ui_screens.h"
+
+/**
+ * @brief Initialize LVGL and the menu screens
+ *
+ * @param display The already initialized TFT
+ * @param onTransition Callback for transitions triggered by the user
+ * @return true on success
+ */
+bool uiInit(TFT_eSPI* display, UiTransitionCallback onTransition);
+
+/**
+ * @brief Show the screen of a state
+ *
+ * Prints the frame statistics of the previous screen over serial.
+ *
+ * @param state The new state
+ */
+void uiShowState(ChessClockState state);
+
+/**
+ * @brief Run the UI, must be called regularly while a UI state is active
+ */
+void uiLoop();
+
+/**
+ * @brief Encoder steps since the last read, for screens that LVGL does not handle
+ */
+int16_t uiEncoderSteps();
+
+#endif // UI_H
@@ -0,0 +1,70 @@
+/*
+  UI Screens for Chess Clock
+
+  This file defines the LVGL screens of the menu states: MAIN_MENU,
+  WAIT_FOR_MODE_SELECTION and ENTER_PLAYER_NAME, and what the user
+  entered on them. Screens are built once on first use and kept for
+  later visits.
+
+  The screens contain no Arduino code and do not know the display; ui.h
+  shows them through the LVGL port, the host tests render them into
+  memory.
+*/
+
+#ifndef UI_SCREENS_H
+#define UI_SCREENS_H
+
+#include <stdint.h>
+#include <lvgl.h>
+#include "state_machine.h"
+
+/**
+ * @brief Called when the user triggers a transition on a screen
+ *
+ * @param next The state the user asked for
+ */
+typedef void (*UiTransitionCallback)(ChessClockState next);
+
+/**
+ * @brief A screen together with the input group of its widgets
+ */
+struct UiScreen {
+  lv_obj_t* screen;
+  lv_group_t* group;
+};
+
+/**
+ * @brief Set the callback for transitions triggered by the user
+ *
+ * LVGL must be initialized before the first screen is built.
+ */
+void uiScreensBegin(UiTransitionCallback onTransition);
+
+/**
+ * @brief Check whether a state is drawn by the LVGL screens
+ */
+bool uiHandlesState(ChessClockState state);
+
+/**
+ * @brief Screen of a state, built on first use
+ *
+ * @return nullptr if the state has no LVGL screen
+ */
+UiScreen* uiScreenForState(ChessClockState state);
+
+/**
+ * @brief Index into TIME_CONTROLS of the last selected mode
+ */
+uint8_t uiSelectedTimeControl();
+
+/**
+ * @brief First name of the last saved player entry
+ */
+const char* uiPlayerFirstName();
+
+/**
+ * @brief Last name of the last saved player entry
+ */
+const char* uiPlayerLastName();
+
+#endif // UI_SCREENS_H
@@ -0,0 +1,92 @@
+/*
+  Virtual List for Chess Clock
+
+  This file defines the bookkeeping of a list that is far longer than
+  the screen (the club roster). Only the visible rows exist on screen;
+  for every move of the selection the list tells which rows have to be
+  drawn, so one step of the encoder draws one or two rows, not the whole
+  list.
+
+  In ring mode the visible rows are kept in a ring of screen slots, as
+  the ILI9341 hardware scrolling (VSCRSADD) shows them: scrolling by one
+  row only moves the scroll start and draws the row that comes into
+  view. Without hardware scrolling every scroll redraws all visible rows.
+
+  The class contains no Arduino code.
+*/
+
+#ifndef VIRTUAL_LIST_H
+#define VIRTUAL_LIST_H
+
+#include <stdint.h>
+
+/**
+ * @brief What changed by a move
+ */
+struct ListUpdate {
+  int32_t scrolled;               // Rows the view moved, positive towards the end
+  bool full;                      // Redraw all visible rows
+  uint32_t newFirst;              // Rows that came into view (ring mode)
+  uint32_t newCount;
+  uint32_t oldSelected;           // Redraw without highlight if still visible
+  uint32_t selected;              // Redraw with highlight
+  bool selectionChanged;
+};
+
+/**
+ * @brief Selection and view of a virtual list
+ */
+class VirtualList {
+public:
+  VirtualList();
+
+  /**
+   * @brief Set the list size, select the first row
+   *
+   * @param count Number of rows
+   * @param visible Rows that fit on the screen
+   * @param ring Visible rows are kept in a ring of slots (hardware scrolling)
+   */
+  void begin(uint32_t count, uint16_t visible, bool ring);
+
+  /**
+   * @brief Move the selection
+   *
+   * @param delta Rows to move, clamped to the list
+   * @return ListUpdate Rows to draw
+   */
+  ListUpdate move(int32_t delta);
+
+  /**
+   * @brief Screen slot of a visible row
+   *
+   * @return uint16_t 0 for the first line of the list area, in ring mode
+   *         the slot in video memory (see scrollSlot())
+   */
+  uint16_t slot(uint32_t index) const;
+
+  /**
+   * @brief Slot shown in the first line of the list area (ring mode)
+   */
+  uint16_t scrollSlot() const;
+
+  /**
+   * @brief Check whether a row is on the screen
+   */
+  bool isVisible(uint32_t index) const;
+
+  uint32_t count() const { return rows; }
+  uint32_t selected() const { return selection; }
+  uint32_t top() const { return first; }
+  uint16_t visible() const { return visibleRows; }
+  bool ring() const { return ringMode; }
+
+private:
+  uint32_t rows;
+  uint32_t selection;
+  uint32_t first;                 // First visible row
+  uint16_t visibleRows;
+  bool ringMode;
+};
+
+#endif // VIRTUAL_LIST_H
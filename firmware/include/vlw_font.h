@@ -0,0 +1,98 @@
+/*
+  VLW Font for Chess Clock
+
+  This file defines access to anti-aliased fonts in the vlw format of
+  TFT_eSPI (created with Processing or the TFT_eSPI font converter).
+  The glyph metrics are read once into a table supplied by the caller;
+  the 8 bit alpha bitmaps stay in the font file and are read on demand
+  through a read callback, so the font can live in a file system, in
+  flash or in memory.
+
+  Only glyphs of the Basic Multilingual Plane (up to U+FFFF) are loaded,
+  glyphs beyond it are skipped.
+
+  The class contains no Arduino code, the caller supplies the read
+  callback and the metrics storage.
+*/
+
+#ifndef VLW_FONT_H
+#define VLW_FONT_H
+
+#include <stdint.h>
+
+/**
+ * @brief Read bytes of the font file
+ *
+ * @param context Context passed to VlwFont::load()
+ * @param offset Byte offset in the file
+ * @param target Where to put the bytes
+ * @param length Number of bytes
+ * @return true if all bytes could be read
+ */
+typedef bool (*VlwReadCallback)(void* context, uint32_t offset, uint8_t* target, uint32_t length);
+
+/**
+ * @brief Metrics of one glyph
+ */
+struct VlwGlyph {
+  uint16_t codepoint;             // Unicode (Basic Multilingual Plane)
+  uint8_t width;                  // Bitmap size
+  uint8_t height;
+  uint8_t xAdvance;               // Cursor movement
+  int8_t dX;                      // Left edge of the bitmap relative to the cursor
+  int16_t dY;                     // Top edge of the bitmap above the baseline
+  uint32_t bitmapOffset;          // Position of the alpha bitmap in the file
+};
+
+class VlwFont {
+public:
+  VlwFont();
+
+  /**
+   * @brief Read the header and the glyph metrics
+   *
+   * @param read Read callback of the font file
+   * @param context Passed to the callback
+   * @param id Identifies the font in caches (one id per file)
+   * @param storage Table for the glyph metrics
+   * @param capacity Number of entries in storage
+   * @return true if the font could be read and all glyphs fit
+   */
+  bool load(VlwReadCallback read, void* context, uint8_t id, VlwGlyph* storage, uint16_t capacity);
+
+  /**
+   * @brief Find the glyph of a code point
+   *
+   * @return const VlwGlyph* Glyph or nullptr if the font does not have it
+   *         (always for code points above U+FFFF)
+   */
+  const VlwGlyph* find(uint32_t codepoint) const;
+
+  /**
+   * @brief Read the alpha bitmap of a glyph (width * height bytes)
+   */
+  bool readBitmap(const VlwGlyph& glyph, uint8_t* target) const;
+
+  bool isLoaded() const { return glyphs != nullptr; }
+  uint8_t id() const { return fontId; }
+  uint8_t size() const { return pointSize; }
+  uint16_t glyphCount() const { return count; }
+  int16_t ascent() const { return fontAscent; }
+  int16_t lineHeight() const { return yAdvance; }
+  int16_t spaceWidth() const { return space; }
+  uint16_t maxBitmapBytes() const { return maxBitmap; }
+
+private:
+  VlwReadCallback reader;
+  void* readerContext;
+  VlwGlyph* glyphs;               // Sorted by code point
+  uint16_t count;
+  uint8_t fontId;
+  uint8_t pointSize;
+  int16_t fontAscent;
+  int16_t yAdvance;               // Ascent + largest descent
+  int16_t space;                  // Advance of characters the font does not have
+  uint16_t maxBitmap;
+};
+
+#endif // VLW_FONT_H
@@ -0,0 +1,137 @@
+/*
+  Wall Clock for Chess Clock
+
+  This file defines the disciplined wall clock that is shown in the IDLE
+  state. It maps the local monotonic microsecond counter to Unix time
+  using SNTP samples and an estimated oscillator drift, so that the
+  displayed time stays accurate between (infrequent) network syncs.
+
+  The class contains no Arduino or network code and only works on
+  timestamps passed in by the caller (see sntp_client.h).
+
+  One task (the SNTP client) feeds the samples. The time base it derives
+  is published with a sequence counter, so toUnixUs() and isSynced() may
+  be called from any other task and never see a half-updated time base.
+*/
+
+#ifndef WALL_CLOCK_H
+#define WALL_CLOCK_H
+
+#include <stdint.h>
+#include <atomic>
+
+/**
+ * @brief One SNTP request/reply exchange
+ *
+ * Local timestamps are taken from the monotonic microsecond counter,
+ * server timestamps are Unix time in microseconds.
+ */
+struct SntpSample {
+  int64_t localSendUs;            // T1: request left the clock (local)
+  int64_t serverRecvUs;           // T2: request arrived at the server
+  int64_t serverSendUs;           // T3: reply left the server
+  int64_t localRecvUs;            // T4: reply arrived at the clock (local)
+};
+
+/**
+ * @brief Wall clock disciplined by SNTP samples
+ *
+ * Samples are collected in bursts. At the end of a burst the sample with
+ * the smallest round-trip delay is used, because its offset carries the
+ * least network jitter. Between bursts the local time base is corrected
+ * by the estimated drift rate of the local oscillator.
+ */
+class WallClock {
+public:
+  WallClock();
+
+  /**
+   * @brief Forget all sync state and drift estimation
+   */
+  void reset();
+
+  /**
+   * @brief Start collecting a new burst of samples
+   */
+  void beginBurst();
+
+  /**
+   * @brief Add one sample to the current burst
+   *
+   * @param sample The measured exchange
+   * @return true if the sample is plausible and was kept
+   */
+  bool addSample(const SntpSample& sample);
+
+  /**
+   * @brief Apply the best sample of the current burst
+   *
+   * @return true if the clock was updated
+   */
+  bool endBurst();
+
+  /**
+   * @brief Convert a local monotonic timestamp to Unix time
+   *
+   * @param localUs Local monotonic time in microseconds
+   * @return int64_t Unix time in microseconds (0 if never synced)
+   */
+  int64_t toUnixUs(int64_t localUs) const;
+
+  /**
+   * @brief Check whether at least one burst has been applied
+   */
+  bool isSynced() const;
+
+  /**
+   * @brief Estimated drift of the local oscillator in ppm
+   *
+   * Positive values mean the local oscillator runs slow.
+   */
+  double driftPpm() const;
+
+  /**
+   * @brief Offset error seen at the last applied burst in microseconds
+   */
+  int64_t lastErrorUs() const { return lastError; }
+
+  /**
+   * @brief Round-trip delay of the last applied sample in microseconds
+   */
+  int64_t lastDelayUs() const { return lastDelay; }
+
+  /**
+   * @brief Seconds until the next burst should be requested
+   *
+   * The interval grows while the drift estimate predicts the server
+   * time well and shrinks again when the error gets large.
+   */
+  uint32_t pollIntervalS() const { return pollInterval; }
+
+private:
+  /**
+   * @brief Everything toUnixUs() needs, read by other tasks
+   */
+  struct Timebase {
+    bool synced;
+    int64_t baseLocalUs;          // local time of the last applied sample
+    int64_t baseUnixUs;           // Unix time at baseLocalUs
+    double drift;                 // estimated rate correction (s/s)
+  };
+
+  Timebase readTimebase() const;
+  void publish(const Timebase& next);
+
+  Timebase timebase;              // Written by publish() only
+  std::atomic<uint32_t> sequence; // Odd while timebase is written
+  int64_t lastError;
+  int64_t lastDelay;
+  uint32_t pollInterval;
+  uint8_t syncCount;
+
+  bool haveBest;
+  SntpSample best;
+  int64_t bestDelay;
+};
+
+#endif // WALL_CLOCK_H
@@ -0,0 +1,104 @@
+#include "alloc_guard.h"
+
+#ifdef ALLOC_GUARD
+
+#include <stdlib.h>
+#include <esp_rom_sys.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "config.h"
+
+// Only ever appended to, the count is raised after the handle is in place
+static TaskHandle_t watchedTasks[ALLOC_GUARD_MAX_TASKS];
+static volatile uint8_t watchedCount = 0;
+static portMUX_TYPE watchLock = portMUX_INITIALIZER_UNLOCKED;
+static volatile bool armed = false;
+static volatile uint32_t violations = 0;
+
+void allocGuardWatchCurrentTask() {
+  TaskHandle_t task = xTaskGetCurrentTaskHandle();
+  portENTER_CRITICAL(&watchLock);
+  if (watchedCount < ALLOC_GUARD_MAX_TASKS) {
+    watchedTasks[watchedCount] = task;
+    watchedCount = watchedCount + 1;
+  }
+  portEXIT_CRITICAL(&watchLock);
+}
+
+static bool isWatched(TaskHandle_t task) {
+  uint8_t count = watchedCount;
+  for (uint8_t i = 0; i < count; i++) {
+    if (watchedTasks[i] == task) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void allocGuardSetArmed(bool enable) {
+  armed = enable;
+}
+
+uint32_t allocGuardViolations() {
+  return violations;
+}
+
+static void check(const char* function, size_t size, void* caller) {
+  // Interrupt handlers and other tasks (WiFi, ...) are not watched
+  if (!armed || xPortInIsrContext() || !isWatched(xTaskGetCurrentTaskHandle())) {
+    return;
+  }
+  violations++;
+
+  // Serial.printf could allocate itself, the ROM printf does not
+  esp_rom_printf("ERROR: %s(%u) while a time is running, called from %p\n", function,
+                 (unsigned)size, caller);
+  if (ALLOC_GUARD_ABORT) {
+    armed = false;
+    abort();
+  }
+}
+
+// Linked in place of the real functions by -Wl,--wrap=<name>
+extern "C" {
+
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* pointer, size_t size);
+void* __real_heap_caps_malloc(size_t size, uint32_t caps);
+void* __real_heap_caps_calloc(size_t count, size_t size, uint32_t caps);
+void* __real_heap_caps_realloc(void* pointer, size_t size, uint32_t caps);
+
+void* __wrap_malloc(size_t size) {
+  check("malloc", size, __builtin_return_address(0));
+  return __real_malloc(size);
+}
+
+void* __wrap_calloc(size_t count, size_t size) {
+  check("calloc", count * size, __builtin_return_address(0));
+  return __real_calloc(count, size);
+}
+
+void* __wrap_realloc(void* pointer, size_t size) {
+  check("realloc", size, __builtin_return_address(0));
+  return __real_realloc(pointer, size);
+}
+
+void* __wrap_heap_caps_malloc(size_t size, uint32_t caps) {
+  check("heap_caps_malloc", size, __builtin_return_address(0));
+  return __real_heap_caps_malloc(size, caps);
+}
+
+void* __wrap_heap_caps_calloc(size_t count, size_t size, uint32_t caps) {
+  check("heap_caps_calloc", count * size, __builtin_return_address(0));
+  return __real_heap_caps_calloc(count, size, caps);
+}
+
+void* __wrap_heap_caps_realloc(void* pointer, size_t size, uint32_t caps) {
+  check("heap_caps_realloc", size, __builtin_return_address(0));
+  return __real_heap_caps_realloc(pointer, size, caps);
+}
+
+} // extern "C"
+
+#endif // ALLOC_GUARD
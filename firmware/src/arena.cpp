@@ -0,0 +1,52 @@
+#include "arena.h"
+#include <esp_heap_caps.h>
+
+Arena::Arena() : block(nullptr), size(0), offset(0), peak(0), failures(0) {
+}
+
+Arena::~Arena() {
+  release();
+}
+
+bool Arena::begin(size_t capacity, uint32_t caps) {
+  release();
+  block = (uint8_t*)heap_caps_malloc(capacity, caps);
+  if (block == nullptr) {
+    return false;
+  }
+  size = capacity;
+  reset();
+  return true;
+}
+
+void Arena::release() {
+  heap_caps_free(block);
+  block = nullptr;
+  size = 0;
+  offset = 0;
+}
+
+void Arena::reset() {
+  offset = 0;
+  failures = 0;
+}
+
+void* Arena::allocate(size_t bytes, size_t alignment) {
+  if (block == nullptr) {
+    failures++;
+    return nullptr;
+  }
+
+  uintptr_t start = ((uintptr_t)block + offset + alignment - 1) & ~(uintptr_t)(alignment - 1);
+  size_t end = (size_t)(start - (uintptr_t)block) + bytes;
+  if (end > size) {
+    failures++;
+    return nullptr;
+  }
+
+  offset = end;
+  if (offset > peak) {
+    peak = offset;
+  }
+  return (void*)start;
+}
@@ -0,0 +1,204 @@
+#include "asset_pack.h"
+#include <string.h>
+
+#define ASSET_HEADER_SIZE 8
+#define ASSET_ENTRY_SIZE 32
+#define ASSET_MIN_MATCH 3
+
+static uint16_t readLe16(const uint8_t* bytes) {
+  return (uint16_t)(bytes[0] | (bytes[1] << 8));
+}
+
+static uint32_t readLe32(const uint8_t* bytes) {
+  return (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) | ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+}
+
+AssetPack::AssetPack() : reader(nullptr), readerContext(nullptr), assetCount(0), window(0), lookahead(0) {
+}
+
+bool AssetPack::open(AssetReadCallback read, void* context) {
+  reader = nullptr;
+  uint8_t header[ASSET_HEADER_SIZE];
+  if (!read(context, 0, header, sizeof(header)) || memcmp(header, "CAP1", 4) != 0) {
+    return false;
+  }
+  // The history has to fit the decoder's window buffer
+  if (header[4] == 0 || header[4] > ASSET_MAX_WINDOW_BITS || header[5] == 0 || header[5] > 8) {
+    return false;
+  }
+  window = header[4];
+  lookahead = header[5];
+  assetCount = readLe16(header + 6);
+  reader = read;
+  readerContext = context;
+  return true;
+}
+
+bool AssetPack::read(uint32_t offset, uint8_t* target, uint32_t length) const {
+  return reader != nullptr && reader(readerContext, offset, target, length);
+}
+
+bool AssetPack::info(uint16_t index, AssetInfo* info) const {
+  uint8_t entry[ASSET_ENTRY_SIZE];
+  if (index >= assetCount || !read(ASSET_HEADER_SIZE + (uint32_t)index * ASSET_ENTRY_SIZE, entry, sizeof(entry))) {
+    return false;
+  }
+  memcpy(info->name, entry, ASSET_NAME_LENGTH);
+  info->name[ASSET_NAME_LENGTH] = '\0';
+  info->width = readLe16(entry + 16);
+  info->height = readLe16(entry + 18);
+  info->frames = readLe16(entry + 20);
+  info->paletteSize = readLe16(entry + 22);
+  info->paletteOffset = readLe32(entry + 24);
+  info->frameTableOffset = readLe32(entry + 28);
+  return info->paletteSize <= 256;
+}
+
+int32_t AssetPack::find(const char* name) const {
+  AssetInfo entry;
+  for (uint16_t i = 0; i < assetCount; i++) {
+    if (info(i, &entry) && strncmp(entry.name, name, ASSET_NAME_LENGTH) == 0) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+AssetDecoder::AssetDecoder()
+    : source(nullptr), width(0), height(0), row(0), indexed(false), error(true), inputPosition(0),
+      inputEnd(0), inputLength(0), inputIndex(0), bitBuffer(0), bitCount(0), windowBits(0),
+      lookaheadBits(0), windowHead(0), matchDistance(0), matchLeft(0) {
+}
+
+bool AssetDecoder::begin(const AssetPack& pack, const AssetInfo& info, uint16_t frame) {
+  source = &pack;
+  width = info.width;
+  height = info.height;
+  row = 0;
+  indexed = info.paletteSize > 0;
+  error = true;
+
+  uint8_t offsets[8];
+  if (frame >= info.frames || !pack.read(info.frameTableOffset + frame * 4u, offsets, sizeof(offsets))) {
+    return false;
+  }
+  if (indexed) {
+    uint8_t colours[2 * 256];
+    if (!pack.read(info.paletteOffset, colours, 2u * info.paletteSize)) {
+      return false;
+    }
+    // Stored high byte first, the same order the display needs in memory
+    for (uint16_t i = 0; i < info.paletteSize; i++) {
+      palette[i] = (uint16_t)(colours[2 * i] | (colours[2 * i + 1] << 8));
+    }
+    for (uint16_t i = info.paletteSize; i < 256; i++) {
+      palette[i] = 0;
+    }
+  }
+
+  inputPosition = readLe32(offsets);
+  inputEnd = readLe32(offsets + 4);
+  inputLength = 0;
+  inputIndex = 0;
+  bitBuffer = 0;
+  bitCount = 0;
+  windowBits = pack.windowBits();
+  lookaheadBits = pack.lookaheadBits();
+  windowHead = 0;
+  matchLeft = 0;
+  error = inputEnd < inputPosition;
+  return !error;
+}
+
+bool AssetDecoder::refill() {
+  uint32_t length = inputEnd - inputPosition;
+  if (length == 0) {
+    return false;
+  }
+  if (length > sizeof(input)) {
+    length = sizeof(input);
+  }
+  if (!source->read(inputPosition, input, length)) {
+    return false;
+  }
+  inputPosition += length;
+  inputLength = (uint16_t)length;
+  inputIndex = 0;
+  return true;
+}
+
+bool AssetDecoder::readBits(uint8_t count, uint32_t* value) {
+  while (bitCount < count) {
+    if (inputIndex == inputLength && !refill()) {
+      return false;
+    }
+    bitBuffer = (bitBuffer << 8) | input[inputIndex++];
+    bitCount += 8;
+  }
+  bitCount -= count;
+  *value = (bitBuffer >> bitCount) & ((1u << count) - 1);
+  return true;
+}
+
+bool AssetDecoder::nextByte(uint8_t* value) {
+  uint16_t mask = (uint16_t)((1u << windowBits) - 1);
+  if (matchLeft == 0) {
+    uint32_t literal;
+    if (!readBits(1, &literal)) {
+      return false;
+    }
+    if (literal) {
+      uint32_t byte;
+      if (!readBits(8, &byte)) {
+        return false;
+      }
+      window[windowHead] = (uint8_t)byte;
+      windowHead = (windowHead + 1) & mask;
+      *value = (uint8_t)byte;
+      return true;
+    }
+    uint32_t distance, length;
+    if (!readBits(windowBits, &distance) || !readBits(lookaheadBits, &length)) {
+      return false;
+    }
+    matchDistance = (uint16_t)(distance + 1);
+    matchLeft = (uint16_t)(length + ASSET_MIN_MATCH);
+  }
+
+  uint8_t byte = window[(windowHead - matchDistance) & mask];
+  window[windowHead] = byte;
+  windowHead = (windowHead + 1) & mask;
+  matchLeft--;
+  *value = byte;
+  return true;
+}
+
+uint16_t AssetDecoder::readRows(uint16_t* target, uint16_t rows) {
+  if (error) {
+    return 0;
+  }
+  if (rows > height - row) {
+    rows = height - row;
+  }
+
+  uint32_t pixels = (uint32_t)rows * width;
+  for (uint32_t i = 0; i < pixels; i++) {
+    uint8_t first;
+    if (!nextByte(&first)) {
+      error = true;
+      return 0;
+    }
+    if (indexed) {
+      target[i] = palette[first];
+    } else {
+      uint8_t second;
+      if (!nextByte(&second)) {
+        error = true;
+        return 0;
+      }
+      target[i] = (uint16_t)(first | (second << 8));   // High byte first in memory
+    }
+  }
+  row += rows;
+  return rows;
+}
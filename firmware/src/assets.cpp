@@ -0,0 +1,150 @@
+#include "assets.h"
+#include <Arduino.h>
+#include <SPIFFS.h>
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include "config.h"
+#include "spi_bus.h"
+
+static File packFile;
+static AssetPack pack;
+static AssetDecoder decoder;
+static uint16_t* bands[2] = { nullptr, nullptr };   // Internal RAM for DMA
+static SpiTransaction bandTransactions[2];
+static SemaphoreHandle_t bandSent[2] = { nullptr, nullptr };
+static AssetStats stats;
+
+static bool readPack(void* context, uint32_t offset, uint8_t* target, uint32_t length) {
+  File* file = (File*)context;
+  return file->seek(offset) && file->read(target, length) == length;
+}
+
+static void bandDone(SpiTransaction* transaction) {
+  xSemaphoreGive((SemaphoreHandle_t)transaction->context);
+}
+
+// Gives back whatever assetsInit() got so far
+static void freeBands() {
+  for (uint8_t i = 0; i < 2; i++) {
+    heap_caps_free(bands[i]);
+    bands[i] = nullptr;
+    if (bandSent[i] != nullptr) {
+      vSemaphoreDelete(bandSent[i]);
+      bandSent[i] = nullptr;
+    }
+  }
+}
+
+bool assetsInit() {
+  packFile = SPIFFS.open(ASSET_PACK_FILE, "r");
+  if (!packFile || !pack.open(readPack, &packFile)) {
+    Serial.printf("WARNING: %s not found or invalid - no images\n", ASSET_PACK_FILE);
+    return false;
+  }
+
+  for (uint8_t i = 0; i < 2; i++) {
+    bands[i] = (uint16_t*)heap_caps_malloc(ASSET_MAX_WIDTH * ASSET_BAND_LINES * sizeof(uint16_t),
+                                           MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+    bandSent[i] = xSemaphoreCreateBinary();
+    if (bands[i] == nullptr || bandSent[i] == nullptr) {
+      Serial.println("ERROR: Asset band buffers could not be allocated!");
+      freeBands();
+      pack = AssetPack();   // Without bands nothing can be drawn
+      packFile.close();
+      return false;
+    }
+    bandTransactions[i].device = SpiDevice::DISPLAY;
+    bandTransactions[i].pixels = bands[i];
+    bandTransactions[i].command = nullptr;
+    bandTransactions[i].done = bandDone;
+    bandTransactions[i].context = bandSent[i];
+  }
+
+  memset(&stats, 0, sizeof(stats));
+  Serial.printf("Asset pack: %u assets\n", (unsigned)pack.count());
+  return true;
+}
+
+bool assetsFind(const char* name, AssetInfo* info) {
+  if (!pack.isOpen()) {
+    return false;
+  }
+  int32_t index = pack.find(name);
+  return index >= 0 && pack.info((uint16_t)index, info);
+}
+
+bool assetsDraw(const char* name, uint16_t frame, int32_t x, int32_t y) {
+  AssetInfo info;
+  if (!assetsFind(name, &info) || info.width > ASSET_MAX_WIDTH || !decoder.begin(pack, info, frame)) {
+    stats.failures++;
+    return false;
+  }
+  int64_t startUs = esp_timer_get_time();
+  int64_t decodeUs = 0;
+
+  // Decode into one band while the bus sends the other
+  bool inFlight[2] = { false, false };
+  uint8_t current = 0;
+  uint16_t row = 0;
+  while (row < info.height) {
+    if (inFlight[current]) {
+      xSemaphoreTake(bandSent[current], portMAX_DELAY);
+      inFlight[current] = false;
+    }
+
+    int64_t decodeStartUs = esp_timer_get_time();
+    uint16_t rows = decoder.readRows(bands[current], ASSET_BAND_LINES);
+    decodeUs += esp_timer_get_time() - decodeStartUs;
+    if (rows == 0) {
+      break;
+    }
+
+    SpiTransaction& transaction = bandTransactions[current];
+    transaction.x = x;
+    transaction.y = y + row;
+    transaction.width = info.width;
+    transaction.height = rows;
+    spiBusSubmit(&transaction);
+    inFlight[current] = true;
+    row += rows;
+    current ^= 1;
+  }
+
+  for (uint8_t i = 0; i < 2; i++) {
+    if (inFlight[i]) {
+      xSemaphoreTake(bandSent[i], portMAX_DELAY);
+    }
+  }
+
+  if (decoder.failed()) {
+    stats.failures++;
+    return false;
+  }
+  uint32_t frameUs = (uint32_t)(esp_timer_get_time() - startUs);
+  stats.framesDrawn++;
+  stats.totalFrameUs += frameUs;
+  stats.totalDecodeUs += (uint64_t)decodeUs;
+  stats.pixels += (uint64_t)info.width * info.height;
+  if (frameUs > stats.maxFrameUs) {
+    stats.maxFrameUs = frameUs;
+  }
+  return true;
+}
+
+const AssetStats& assetsStats() {
+  return stats;
+}
+
+void assetsPrintStats() {
+  if (stats.framesDrawn == 0) {
+    return;
+  }
+  Serial.printf("Assets: %u frames, avg %u us, max %u us, %u failures\n", (unsigned)stats.framesDrawn,
+                (unsigned)(stats.totalFrameUs / stats.framesDrawn), (unsigned)stats.maxFrameUs,
+                (unsigned)stats.failures);
+  if (stats.totalDecodeUs > 0) {
+    Serial.printf("  decode: %u pixels/ms\n", (unsigned)(stats.pixels * 1000 / stats.totalDecodeUs));
+  }
+}
@@ -0,0 +1,93 @@
+#include "boot.h"
+#include <Arduino.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/event_groups.h>
+#include <freertos/task.h>
+#include "config.h"
+
+static BootGraph graph;
+static EventGroupHandle_t doneEvents = nullptr;
+static int64_t startUs = 0;
+static int64_t usableUs = 0;
+
+static int64_t bootNow() {
+  return esp_timer_get_time();
+}
+
+static void runPhase(void* parameter) {
+  uint8_t index = (uint8_t)(uintptr_t)parameter;
+  uint32_t dependsOn = graph.phase(index).dependsOn;
+  if (dependsOn != 0) {
+    xEventGroupWaitBits(doneEvents, dependsOn, pdFALSE, pdTRUE, portMAX_DELAY);
+  }
+
+  graph.run(index, (int8_t)xPortGetCoreID(), bootNow);
+  xEventGroupSetBits(doneEvents, BOOT_AFTER(index));
+  vTaskDelete(NULL);
+}
+
+bool bootStart(const BootPhase* phases, uint8_t count) {
+  // FreeRTOS event groups carry 24 usable bits
+  if (count > 24 || !graph.begin(phases, count)) {
+    return false;
+  }
+
+  startUs = esp_timer_get_time();
+  doneEvents = xEventGroupCreate();
+  if (doneEvents == nullptr) {
+    return false;
+  }
+
+  bool ok = true;
+  for (uint8_t i = 0; i < count; i++) {
+    BaseType_t core = phases[i].core < 0 ? tskNO_AFFINITY : phases[i].core;
+    if (xTaskCreatePinnedToCore(runPhase, phases[i].name, phases[i].stackSize, (void*)(uintptr_t)i,
+                                BOOT_PHASE_PRIORITY, NULL, core) != pdPASS) {
+      // Mark it as failed so that dependents do not wait forever
+      graph.fail(i);
+      xEventGroupSetBits(doneEvents, BOOT_AFTER(i));
+      ok = false;
+    }
+  }
+  return ok;
+}
+
+bool bootWaitUntilUsable(uint32_t timeoutMs) {
+  if (doneEvents == nullptr) {
+    return false;
+  }
+  xEventGroupWaitBits(doneEvents, graph.requiredMask(), pdFALSE, pdTRUE, pdMS_TO_TICKS(timeoutMs));
+  usableUs = esp_timer_get_time();
+  return graph.usable();
+}
+
+bool bootFinished() {
+  return doneEvents != nullptr && graph.finished();
+}
+
+void bootPrintReport() {
+  Serial.println("Boot report (us since reset):");
+  Serial.printf("  %-12s %4s %10s %10s %10s  %s\n", "phase", "core", "start", "end", "duration", "result");
+  for (uint8_t i = 0; i < graph.count(); i++) {
+    const BootPhaseTiming& timing = graph.timing(i);
+    Serial.printf("  %-12s %4d %10lld %10lld %10lld  %s%s\n", graph.phase(i).name, timing.core,
+                  (long long)timing.startUs, (long long)timing.endUs,
+                  (long long)(timing.endUs - timing.startUs),
+                  timing.skipped ? "SKIPPED" : (timing.ok ? "OK" : "FAILED"),
+                  graph.phase(i).required ? " (required)" : "");
+  }
+
+  int64_t lastEndUs = startUs;
+  for (uint8_t i = 0; i < graph.count(); i++) {
+    if (graph.timing(i).endUs > lastEndUs) {
+      lastEndUs = graph.timing(i).endUs;
+    }
+  }
+
+  Serial.printf("  graph started at %lld us, usable at %lld us, all done at %lld us\n",
+                (long long)startUs, (long long)usableUs, (long long)lastEndUs);
+  if (usableUs > (int64_t)BOOT_USABLE_BUDGET_MS * 1000) {
+    Serial.printf("WARNING: Boot took longer than %d ms!\n", BOOT_USABLE_BUDGET_MS);
+  }
+}
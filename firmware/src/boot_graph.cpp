@@ -0,0 +1,64 @@
+#include "boot_graph.h"
+#include <string.h>
+
+BootGraph::BootGraph() : phases(nullptr), phaseCount(0), all(0), required(0), done(0), failed(0) {}
+
+bool BootGraph::begin(const BootPhase* table, uint8_t count) {
+  if (count > BOOT_MAX_PHASES) {
+    return false;
+  }
+  for (uint8_t i = 0; i < count; i++) {
+    // Only lower indices, so the graph has no cycles
+    if ((table[i].dependsOn & ~(BOOT_AFTER(i) - 1)) != 0) {
+      return false;
+    }
+  }
+
+  phases = table;
+  phaseCount = count;
+  all = 0;
+  required = 0;
+  for (uint8_t i = 0; i < count; i++) {
+    memset(&timings[i], 0, sizeof(timings[i]));
+    all |= BOOT_AFTER(i);
+    if (table[i].required) {
+      required |= BOOT_AFTER(i);
+    }
+  }
+  done.store(0, std::memory_order_relaxed);
+  failed.store(0, std::memory_order_release);
+  return true;
+}
+
+bool BootGraph::run(uint8_t index, int8_t core, int64_t (*now)()) {
+  const BootPhase& phase = phases[index];
+  BootPhaseTiming& timing = timings[index];
+
+  timing.core = core;
+  timing.startUs = now();
+  if ((failed.load(std::memory_order_acquire) & phase.dependsOn) != 0) {
+    timing.skipped = true;
+    timing.ok = false;
+  } else {
+    timing.ok = phase.init();
+  }
+  timing.endUs = now();
+
+  // Failed before done, whoever sees the done bit also sees the failure
+  if (!timing.ok) {
+    failed.fetch_or(BOOT_AFTER(index), std::memory_order_acq_rel);
+  }
+  done.fetch_or(BOOT_AFTER(index), std::memory_order_acq_rel);
+  return timing.ok;
+}
+
+void BootGraph::fail(uint8_t index) {
+  timings[index].skipped = true;
+  timings[index].ok = false;
+  failed.fetch_or(BOOT_AFTER(index), std::memory_order_acq_rel);
+  done.fetch_or(BOOT_AFTER(index), std::memory_order_acq_rel);
+}
+
+bool BootGraph::usable() const {
+  return (doneMask() & required) == required && (failedMask() & required) == 0;
+}
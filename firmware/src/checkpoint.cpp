@@ -0,0 +1,128 @@
+#include "checkpoint.h"
+#include <Arduino.h>
+#include <esp_attr.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <nvs.h>
+#include <string.h>
+#include "config.h"
+#include "flash_writer.h"
+#include "state_machine.h"
+
+#define NVS_KEY "game"
+
+// Not cleared on reset, a power-on leaves garbage that fails the CRC
+RTC_NOINIT_ATTR static uint8_t rtcSlots[2][GAME_CHECKPOINT_SIZE];
+
+static nvs_handle_t nvsHandle = 0;
+static bool nvsOpen = false;
+static uint16_t sequence = 0;
+static CheckpointStats stats;
+
+// Latest flash copy, set by the time task and written by the flash writer
+static portMUX_TYPE pendingMux = portMUX_INITIALIZER_UNLOCKED;
+static uint64_t pendingWord = 0;
+
+static bool writeFlash(void* context);
+
+static FlashWriteJob flashJob = {
+  "checkpoint", writeFlash, nullptr, CHECKPOINT_FLASH_MIN_INTERVAL_MS, CHECKPOINT_FLASH_BUDGET_US
+};
+
+bool checkpointRestore(GameSnapshot* snapshot) {
+  stats = CheckpointStats();
+  nvsOpen = nvs_open(CHECKPOINT_NVS_NAMESPACE, NVS_READWRITE, &nvsHandle) == ESP_OK;
+
+  uint64_t word = 0;
+  if (nvsOpen && nvs_get_u64(nvsHandle, NVS_KEY, &word) != ESP_OK) {
+    word = 0;
+  }
+  stats.source = checkpointSelect(rtcSlots[0], rtcSlots[1], word, snapshot);
+  if (stats.source == CheckpointSource::NONE) {
+    return false;
+  }
+
+  // Continue the sequence so the next slot written is the older one
+  sequence = snapshot->sequence;
+  if (stats.source == CheckpointSource::ENDED) {
+    // The reset came before the flash copy of the ended game was erased
+    if (word != 0) {
+      checkpointClear();
+    }
+    return false;
+  }
+  return true;
+}
+
+void checkpointResumed() {
+  stats.restoreUs = (uint32_t)esp_timer_get_time();
+}
+
+void checkpointSave(const GameSnapshot& snapshot, bool toFlash) {
+  GameSnapshot numbered = snapshot;
+  numbered.sequence = ++sequence;
+  checkpointPack(numbered, rtcSlots[sequence & 1]);
+  stats.rtcWrites++;
+
+  if (toFlash) {
+    portENTER_CRITICAL(&pendingMux);
+    pendingWord = checkpointPackCompact(snapshot);
+    portEXIT_CRITICAL(&pendingMux);
+    flashWriterRequest(&flashJob, snapshot.state == (uint8_t)ChessClockState::PAUSE);
+  }
+}
+
+void checkpointClear() {
+  // Both slots, a reset while the second one is written leaves the first
+  GameSnapshot ended = {};
+  ended.state = GAME_CHECKPOINT_ENDED;
+  for (uint8_t i = 0; i < 2; i++) {
+    ended.sequence = ++sequence;
+    checkpointPack(ended, rtcSlots[sequence & 1]);
+  }
+
+  portENTER_CRITICAL(&pendingMux);
+  pendingWord = 0;
+  portEXIT_CRITICAL(&pendingMux);
+  flashWriterRequest(&flashJob, true);
+}
+
+static bool writeFlash(void* context) {
+  portENTER_CRITICAL(&pendingMux);
+  uint64_t word = pendingWord;
+  portEXIT_CRITICAL(&pendingMux);
+
+  if (!nvsOpen) {
+    return false;
+  }
+
+  // One entry per write: NVS appends it and marks the old one erased
+  esp_err_t result = word == 0 ? nvs_erase_key(nvsHandle, NVS_KEY) : nvs_set_u64(nvsHandle, NVS_KEY, word);
+  if (result == ESP_ERR_NVS_NOT_FOUND) {
+    result = ESP_OK;   // Nothing to erase
+  }
+  if (result == ESP_OK) {
+    result = nvs_commit(nvsHandle);
+  }
+  return result == ESP_OK;
+}
+
+const CheckpointStats& checkpointStats() {
+  return stats;
+}
+
+void checkpointPrintStats() {
+  static const char* SOURCES[] = { "none", "RTC", "flash", "none (game ended)" };
+  Serial.printf("Checkpoint: %u RTC writes, %u flash writes, %u coalesced, %u errors\n",
+                (unsigned)stats.rtcWrites, (unsigned)flashJob.writes, (unsigned)flashJob.coalesced,
+                (unsigned)flashJob.failures);
+  if (stats.source != CheckpointSource::RTC && stats.source != CheckpointSource::FLASH) {
+    Serial.printf("  Restored from %s\n", SOURCES[(int)stats.source]);
+    return;
+  }
+  Serial.printf("  Restored from %s, in PAUSE %u us after reset\n", SOURCES[(int)stats.source],
+                (unsigned)stats.restoreUs);
+  if (stats.restoreUs > CHECKPOINT_RESTORE_BUDGET_MS * 1000UL) {
+    Serial.printf("WARNING: Resuming took longer than %d ms!\n", CHECKPOINT_RESTORE_BUDGET_MS);
+  }
+}
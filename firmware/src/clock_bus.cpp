@@ -0,0 +1,53 @@
+#include "clock_bus.h"
+#include <Arduino.h>
+#include <esp_timer.h>
+#include "task_topology.h"
+
+// Static storage, the bus exists for the whole runtime
+ClockBus clockBus;
+
+static int64_t busNow() {
+  return esp_timer_get_time();
+}
+
+static void wakeTask(uint8_t task) {
+  TaskHandle_t handle = taskTopologyHandle(task);
+  if (handle != nullptr) {
+    xTaskNotifyGive(handle);
+  }
+}
+
+bool clockBusStart(const ClockBus::Subscriber* subscribers, uint8_t count) {
+  if (!clockBus.begin(subscribers, count, busNow, wakeTask)) {
+    Serial.println("ERROR: Too many clock bus subscribers!");
+    return false;
+  }
+  // Each subscriber can hold a full inbox and the event in its handler, the publisher one more
+  uint32_t worstCase = (uint32_t)count * (CLOCK_BUS_INBOX_LENGTH + 1) + 1;
+  if (worstCase > CLOCK_BUS_POOL_SIZE) {
+    Serial.printf("WARNING: Clock bus pool of %u events can run dry, %u needed!\n", (unsigned)CLOCK_BUS_POOL_SIZE,
+                  (unsigned)worstCase);
+  }
+  return true;
+}
+
+void clockBusDrain(uint8_t task) {
+  for (uint8_t i = 0; i < clockBus.subscriberCount(); i++) {
+    if (clockBus.subscriber(i).owner == task) {
+      clockBus.drain(i);
+    }
+  }
+}
+
+void clockBusPrintStats() {
+  Serial.printf("Clock bus: pool %u/%u used (peak %u), %u exhausted, %u unclaimed\n",
+                (unsigned)clockBus.poolUsed(), (unsigned)CLOCK_BUS_POOL_SIZE, (unsigned)clockBus.poolHighWater(),
+                (unsigned)clockBus.poolExhausted(), (unsigned)clockBus.unclaimedCount());
+  for (uint8_t i = 0; i < clockBus.subscriberCount(); i++) {
+    BusSubscriberStats stats = clockBus.subscriberStats(i);
+    Serial.printf("  %-12s %6u delivered, %4u dropped, latency avg %u us, max %u us\n", clockBus.subscriber(i).name,
+                  (unsigned)stats.delivered, (unsigned)stats.dropped,
+                  stats.delivered > 0 ? (unsigned)(stats.totalLatencyUs / stats.delivered) : 0,
+                  (unsigned)stats.maxLatencyUs);
+  }
+}
@@ -0,0 +1,128 @@
+#include "clock_display.h"
+#include <Arduino.h>
+#include <esp_timer.h>
+#include <string.h>
+#include "config.h"
+#include "pixel_kernels.h"
+#include "shadow_screen.h"
+#include "trace.h"
+
+#define ACTIVE_COLOR   TFT_DARKGREEN
+#define NAME_Y         30
+#define TIME_HEIGHT    56              // Area cleared below the digits (font 7 is 48 px)
+
+static FrameGovernor governor;
+static bool fullFrame = true;
+static int64_t scheduledUs = INT64_MAX;
+static ClockDisplayStats stats;
+
+static void formatTime(char* buffer, size_t size, int64_t remainingUs, uint8_t decimals) {
+  uint32_t value = FrameGovernor::value(remainingUs, decimals);
+  if (decimals == 1) {
+    snprintf(buffer, size, "%u.%u", (unsigned)(value / 10), (unsigned)(value % 10));
+  } else if (decimals == 2) {
+    snprintf(buffer, size, "%u.%02u", (unsigned)(value / 100), (unsigned)(value % 100));
+  } else if (value >= 3600) {
+    snprintf(buffer, size, "%u:%02u:%02u", (unsigned)(value / 3600), (unsigned)(value / 60 % 60),
+             (unsigned)(value % 60));
+  } else {
+    snprintf(buffer, size, "%u:%02u", (unsigned)(value / 60), (unsigned)(value % 60));
+  }
+}
+
+static void drawSide(TFT_eSprite& canvas, int32_t x, int32_t width, int64_t remainingUs, bool active,
+                     const char* name) {
+  uint16_t background = active ? ACTIVE_COLOR : TFT_BLACK;
+  int32_t timeY = canvas.height() / 2;
+  canvas.setTextDatum(MC_DATUM);
+  canvas.setTextColor(TFT_WHITE, background);
+  if (fullFrame) {
+    canvas.fillRect(x, 0, width, canvas.height(), background);
+    canvas.drawString(name, x + width / 2, NAME_Y, 2);
+  }
+
+  // Seven segment digits if they fit, h:mm:ss does not
+  char text[16];
+  formatTime(text, sizeof(text), remainingUs, governor.decimals(remainingUs));
+  uint8_t font = canvas.textWidth(text, 7) <= width - 8 ? 7 : 4;
+  canvas.fillRect(x, timeY - TIME_HEIGHT / 2, width, TIME_HEIGHT, background);
+  canvas.drawString(text, x + width / 2, timeY, font);
+}
+
+void clockDisplayInit() {
+  governor.begin(CLOCK_FRAME_MAX_FPS, CLOCK_FRAME_SAVING_FPS, CLOCK_FINE_BELOW_MS, CLOCK_FINE_DECIMALS);
+  governor.setPower(CLOCK_FRAME_POWER_SAVING ? FramePower::SAVING : FramePower::NORMAL);
+  memset(&stats, 0, sizeof(stats));
+}
+
+void clockDisplaySetPower(FramePower power) {
+  governor.setPower(power);
+}
+
+void clockDisplayInvalidate() {
+  governor.markDirty();
+  fullFrame = true;
+}
+
+int64_t clockDisplayRun(const TimeEngine& engine, const char* white, const char* black, const char* banner,
+                        int64_t nowUs) {
+  Side active = engine.activeSide();
+  int64_t activeUs = engine.remainingUs(active, nowUs);
+  int64_t nextUs = governor.nextFrameUs(nowUs, activeUs, engine.isRunning());
+  if (nextUs > nowUs) {
+    scheduledUs = nextUs;
+    return nextUs;
+  }
+
+  TraceScope trace(TracePoint::CLOCK_FRAME);
+  TFT_eSprite& canvas = shadowScreenCanvas();
+  int32_t half = canvas.width() / 2;
+  bool running = engine.isRunning();
+  drawSide(canvas, 0, half, engine.remainingUs(Side::WHITE, nowUs), running && active == Side::WHITE, white);
+  drawSide(canvas, half, canvas.width() - half, engine.remainingUs(Side::BLACK, nowUs),
+           running && active == Side::BLACK, black);
+  if (fullFrame && !running) {
+    // A stopped clock is shown dimmed
+    pixelBlend((uint16_t*)canvas.getPointer(), (const uint16_t*)canvas.getPointer(), TFT_BLACK,
+               CLOCK_STOPPED_DIM_ALPHA, (uint32_t)(canvas.width() * canvas.height()));
+  }
+  if (fullFrame && banner != nullptr) {
+    canvas.setTextColor(TFT_YELLOW, TFT_BLACK);
+    canvas.drawString(banner, canvas.width() / 2, canvas.height() - 30, 4);
+  }
+  shadowScreenPush();
+
+  governor.frameDrawn(nowUs, scheduledUs, activeUs);
+  fullFrame = false;
+
+  uint32_t frameUs = (uint32_t)(esp_timer_get_time() - nowUs);
+  stats.frames++;
+  stats.totalFrameUs += frameUs;
+  if (frameUs > stats.maxFrameUs) {
+    stats.maxFrameUs = frameUs;
+  }
+  scheduledUs = governor.nextFrameUs(nowUs, activeUs, running);
+  return scheduledUs;
+}
+
+const ClockDisplayStats& clockDisplayStats() {
+  return stats;
+}
+
+const FrameGovernorStats& clockDisplayGovernorStats() {
+  return governor.stats();
+}
+
+void clockDisplayPrintStats() {
+  if (stats.frames == 0) {
+    return;
+  }
+  const FrameGovernorStats& frames = governor.stats();
+  uint32_t timed = frames.coarseFrames + frames.fineFrames;
+  Serial.printf("Clock display: %u frames (%u seconds, %u fractions, %u redraws), avg %u us, max %u us\n",
+                (unsigned)stats.frames, (unsigned)frames.coarseFrames, (unsigned)frames.fineFrames,
+                (unsigned)frames.dirtyFrames, (unsigned)(stats.totalFrameUs / stats.frames),
+                (unsigned)stats.maxFrameUs);
+  Serial.printf("  start after boundary: avg %u us, max %u us\n",
+                timed > 0 ? (unsigned)(frames.totalLateUs / timed) : 0, (unsigned)frames.maxLateUs);
+}
@@ -0,0 +1,47 @@
+#include "clock_event.h"
+#include <esp_attr.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+
+// The pools are in clock_event_pool.cpp
+
+static QueueHandle_t eventQueue = nullptr;
+
+bool clockEventQueueInit() {
+  if (eventQueue == nullptr) {
+    eventQueue = xQueueCreate(CLOCK_EVENT_QUEUE_LENGTH, sizeof(ClockEvent*));
+  }
+  return eventQueue != nullptr;
+}
+
+bool clockEventPost(ClockEvent* event) {
+  if (eventQueue == nullptr || xQueueSend(eventQueue, &event, 0) != pdTRUE) {
+    clockEventPool.release(event);
+    return false;
+  }
+  return true;
+}
+
+// In IRAM like the capture interrupt, so a press is posted even while flash is written
+bool IRAM_ATTR clockEventPostFromIsr(ClockEvent* event, bool* woken) {
+  BaseType_t higherPriorityWoken = pdFALSE;
+  if (eventQueue == nullptr || xQueueSendFromISR(eventQueue, &event, &higherPriorityWoken) != pdTRUE) {
+    clockEventPool.release(event);
+    return false;
+  }
+  *woken = higherPriorityWoken == pdTRUE;
+  return true;
+}
+
+ClockEvent* clockEventNext() {
+  return clockEventWait(0);
+}
+
+ClockEvent* clockEventWait(uint32_t timeoutMs) {
+  ClockEvent* event = nullptr;
+  TickType_t ticks = timeoutMs == CLOCK_EVENT_WAIT_FOREVER ? portMAX_DELAY : pdMS_TO_TICKS(timeoutMs);
+  if (eventQueue == nullptr || xQueueReceive(eventQueue, &event, ticks) != pdTRUE) {
+    return nullptr;
+  }
+  return event;
+}
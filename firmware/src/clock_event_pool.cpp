@@ -0,0 +1,6 @@
+#include "clock_event.h"
+
+// Static storage, the pool exists for the whole runtime. Apart from the
+// queue in clock_event.cpp, so the portable code using it also builds
+// for the host tests.
+ObjectPool<ClockEvent, CLOCK_EVENT_POOL_SIZE> clockEventPool;
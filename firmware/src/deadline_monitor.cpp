@@ -0,0 +1,80 @@
+#include "deadline_monitor.h"
+
+DeadlineMonitor::DeadlineMonitor(uint32_t windowRuns)
+    : windowRuns(windowRuns > 0 ? windowRuns : 1), breached(0), registered(0), stages{}, written(0), log{} {
+}
+
+bool DeadlineMonitor::add(DeadlineStage* stage) {
+  if (stage->budgetUs == 0) {
+    return false;
+  }
+  // Schedulers of both cores register their jobs at the same time
+  uint32_t index = registered.load(std::memory_order_relaxed);
+  do {
+    if (index >= DEADLINE_MAX_STAGES) {
+      return false;
+    }
+  } while (!registered.compare_exchange_weak(index, index + 1, std::memory_order_relaxed));
+
+  resetStats(stage);
+  stage->bucketUs = stage->budgetUs >= DEADLINE_BUCKETS_PER_BUDGET ? stage->budgetUs / DEADLINE_BUCKETS_PER_BUDGET : 1;
+  stage->index = (uint8_t)index;
+  __atomic_store_n(&stages[index], stage, __ATOMIC_RELEASE);
+  return true;
+}
+
+uint8_t DeadlineMonitor::stageCount() const {
+  return (uint8_t)registered.load(std::memory_order_relaxed);
+}
+
+DeadlineStage* DeadlineMonitor::stage(uint8_t index) const {
+  return index < DEADLINE_MAX_STAGES ? __atomic_load_n(&stages[index], __ATOMIC_ACQUIRE) : nullptr;
+}
+
+uint32_t DeadlineMonitor::oldestLogged() const {
+  uint32_t next = logged();
+  return next > DEADLINE_LOG_SIZE ? next - DEADLINE_LOG_SIZE : 0;
+}
+
+bool DeadlineMonitor::readOverrun(uint32_t slot, DeadlineOverrun* overrun) const {
+  const DeadlineOverrun& source = log[slot & (DEADLINE_LOG_SIZE - 1)];
+  if (__atomic_load_n(&source.sequence, __ATOMIC_ACQUIRE) != slot + 1) {
+    return false;
+  }
+  overrun->durationUs = source.durationUs;
+  overrun->startUs = source.startUs;
+  overrun->stage = source.stage;
+  __atomic_thread_fence(__ATOMIC_ACQUIRE);
+  // A writer that claimed the slot meanwhile has cleared the sequence first
+  overrun->sequence = __atomic_load_n(&source.sequence, __ATOMIC_RELAXED);
+  return overrun->sequence == slot + 1;
+}
+
+uint32_t DeadlineMonitor::percentileUs(const DeadlineStage* stage, uint8_t percent) {
+  if (stage->runs == 0) {
+    return 0;
+  }
+  uint32_t rank = (uint32_t)(((uint64_t)stage->runs * percent + 99) / 100);
+  uint32_t seen = 0;
+  for (uint8_t bucket = 0; bucket < DEADLINE_BUCKETS - 1; bucket++) {
+    seen += stage->histogram[bucket];
+    if (seen >= rank) {
+      uint32_t upperUs = (bucket + 1) * stage->bucketUs;
+      return upperUs < stage->maxUs ? upperUs : stage->maxUs;
+    }
+  }
+  return stage->maxUs;
+}
+
+void DeadlineMonitor::resetStats(DeadlineStage* stage) {
+  stage->runs = 0;
+  stage->overruns = 0;
+  stage->breaches = 0;
+  stage->maxUs = 0;
+  stage->totalUs = 0;
+  for (uint8_t bucket = 0; bucket < DEADLINE_BUCKETS; bucket++) {
+    stage->histogram[bucket] = 0;
+  }
+  stage->windowRuns = 0;
+  stage->windowOverruns = 0;
+}
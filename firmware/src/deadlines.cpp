@@ -0,0 +1,77 @@
+#include "deadlines.h"
+#include <Arduino.h>
+#include <esp_timer.h>
+#include "config.h"
+
+DeadlineMonitor deadlineMonitor(DEADLINE_WINDOW_RUNS);
+
+#if DEADLINE_ALARM_LED_PIN >= 0
+static int64_t ledOffUs = 0;
+#endif
+
+bool deadlinesInit() {
+#if DEADLINE_ALARM_LED_PIN >= 0
+  pinMode(DEADLINE_ALARM_LED_PIN, OUTPUT);
+  digitalWrite(DEADLINE_ALARM_LED_PIN, LOW);
+#endif
+  return true;
+}
+
+void deadlinesCheckAlarms() {
+  uint32_t breaches = deadlineMonitor.takeBreaches();
+  if (breaches != 0) {
+    for (uint8_t i = 0; i < DEADLINE_MAX_STAGES; i++) {
+      const DeadlineStage* stage = deadlineMonitor.stage(i);
+      if ((breaches & (1UL << i)) == 0 || stage == nullptr) {
+        continue;
+      }
+      if (DEADLINE_ALARM_SERIAL) {
+        Serial.printf("@W %s p99 %u budget %u overruns %u\n", stage->name,
+                      (unsigned)DeadlineMonitor::percentileUs(stage, 99), (unsigned)stage->budgetUs,
+                      (unsigned)stage->overruns);
+      }
+    }
+#if DEADLINE_ALARM_LED_PIN >= 0
+    digitalWrite(DEADLINE_ALARM_LED_PIN, HIGH);
+    ledOffUs = esp_timer_get_time() + DEADLINE_ALARM_FLASH_MS * 1000LL;
+#endif
+  }
+
+#if DEADLINE_ALARM_LED_PIN >= 0
+  if (ledOffUs != 0 && esp_timer_get_time() >= ledOffUs) {
+    digitalWrite(DEADLINE_ALARM_LED_PIN, LOW);
+    ledOffUs = 0;
+  }
+#endif
+}
+
+void deadlinesPrintReport() {
+  Serial.println("Deadline report:");
+  Serial.printf("  %-12s %8s %8s %8s %8s %8s %6s %6s\n", "stage", "runs", "avg us", "p99 us", "max us",
+                "budget", "over", "breach");
+  for (uint8_t i = 0; i < deadlineMonitor.stageCount(); i++) {
+    const DeadlineStage* stage = deadlineMonitor.stage(i);
+    if (stage == nullptr) {
+      continue;
+    }
+    Serial.printf("  %-12s %8u %8u %8u %8u %8u %6u %6u\n", stage->name, (unsigned)stage->runs,
+                  stage->runs > 0 ? (unsigned)(stage->totalUs / stage->runs) : 0,
+                  (unsigned)DeadlineMonitor::percentileUs(stage, 99), (unsigned)stage->maxUs,
+                  (unsigned)stage->budgetUs, (unsigned)stage->overruns, (unsigned)stage->breaches);
+  }
+
+  uint32_t next = deadlineMonitor.logged();
+  if (next == 0) {
+    return;
+  }
+  Serial.printf("  last overruns (%u in total):\n", (unsigned)next);
+  for (uint32_t slot = deadlineMonitor.oldestLogged(); slot != next; slot++) {
+    DeadlineOverrun overrun;
+    if (!deadlineMonitor.readOverrun(slot, &overrun)) {
+      continue;
+    }
+    const DeadlineStage* stage = deadlineMonitor.stage(overrun.stage);
+    Serial.printf("    at %10u ms  %-12s %8u us\n", (unsigned)(overrun.startUs / 1000),
+                  stage != nullptr ? stage->name : "?", (unsigned)overrun.durationUs);
+  }
+}
@@ -0,0 +1,213 @@
+#include "delta_patch.h"
+#include <string.h>
+
+#define DELTA_PATCH_MIN_MATCH 3           // Shortest LZSS back reference (see delta_patch.py)
+
+static uint32_t readLe32(const uint8_t* p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+void DeltaPatchDecoder::begin(const DeltaPatchIo& callbacks) {
+  io = callbacks;
+  status = DeltaPatchStatus::NEED_MORE;
+  headerLength = 0;
+  bitBuffer = 0;
+  bitCount = 0;
+  windowHead = 0;
+  memset(window, 0, sizeof(window));
+  field = Field::ADD_LENGTH;
+  varintValue = 0;
+  varintShift = 0;
+  addLength = 0;
+  extraLength = 0;
+  remaining = 0;
+  seekTarget = 0;
+  oldPosition = 0;
+  newPosition = 0;
+  oldBufferStart = 0;
+  oldBufferLength = 0;
+  outLength = 0;
+}
+
+bool DeltaPatchDecoder::parseHeader() {
+  if (memcmp(headerBuffer, "CDP1", 4) != 0) {
+    return false;
+  }
+  patchHeader.windowBits = headerBuffer[4];
+  patchHeader.lookaheadBits = headerBuffer[5];
+  patchHeader.oldSize = readLe32(headerBuffer + 8);
+  patchHeader.newSize = readLe32(headerBuffer + 12);
+  memcpy(patchHeader.oldSha256, headerBuffer + 16, 32);
+  memcpy(patchHeader.newSha256, headerBuffer + 48, 32);
+
+  if (patchHeader.windowBits < 4 || patchHeader.windowBits > DELTA_PATCH_MAX_WINDOW_BITS ||
+      patchHeader.lookaheadBits < 1 || patchHeader.lookaheadBits > 8) {
+    return false;
+  }
+  return io.checkHeader == nullptr || io.checkHeader(io.context, patchHeader);
+}
+
+DeltaPatchStatus DeltaPatchDecoder::write(const uint8_t* data, size_t length) {
+  size_t position = 0;
+
+  while (status == DeltaPatchStatus::NEED_MORE && headerLength < DELTA_PATCH_HEADER_SIZE &&
+         position < length) {
+    headerBuffer[headerLength++] = data[position++];
+    if (headerLength == DELTA_PATCH_HEADER_SIZE && !parseHeader()) {
+      status = DeltaPatchStatus::BAD_HEADER;
+    }
+  }
+
+  const uint8_t windowBits = patchHeader.windowBits;
+  const uint8_t lookaheadBits = patchHeader.lookaheadBits;
+  const uint16_t windowMask = (uint16_t)((1u << windowBits) - 1);
+  const uint8_t referenceBits = 1 + windowBits + lookaheadBits;
+
+  while (status == DeltaPatchStatus::NEED_MORE && position < length) {
+    bitBuffer = (bitBuffer << 8) | data[position++];
+    bitCount += 8;
+
+    // Decode every token that is complete: 1 + 8 bits for a literal,
+    // 1 + window + lookahead bits for a back reference
+    while (status == DeltaPatchStatus::NEED_MORE && bitCount > 0) {
+      bool literal = (bitBuffer >> (bitCount - 1)) & 1;
+      uint8_t needed = literal ? 9 : referenceBits;
+      if (bitCount < needed) {
+        break;
+      }
+      bitCount -= needed;
+      uint32_t token = (bitBuffer >> bitCount) & ((1u << (needed - 1)) - 1);
+      bitBuffer &= (1u << bitCount) - 1;
+
+      if (literal) {
+        window[windowHead] = (uint8_t)token;
+        windowHead = (windowHead + 1) & windowMask;
+        status = bodyByte((uint8_t)token);
+      } else {
+        uint16_t distance = (uint16_t)(token >> lookaheadBits) + 1;
+        uint16_t count = (uint16_t)(token & ((1u << lookaheadBits) - 1)) + DELTA_PATCH_MIN_MATCH;
+        while (count-- > 0 && status == DeltaPatchStatus::NEED_MORE) {
+          uint8_t value = window[(windowHead - distance) & windowMask];
+          window[windowHead] = value;
+          windowHead = (windowHead + 1) & windowMask;
+          status = bodyByte(value);
+        }
+      }
+    }
+  }
+
+  return status;
+}
+
+DeltaPatchStatus DeltaPatchDecoder::bodyByte(uint8_t value) {
+  switch (field) {
+    case Field::ADD_LENGTH:
+    case Field::EXTRA_LENGTH:
+    case Field::SEEK: {
+      if (varintShift > 28) {
+        return DeltaPatchStatus::BAD_BODY;
+      }
+      varintValue |= (uint32_t)(value & 0x7F) << varintShift;
+      varintShift += 7;
+      if (value & 0x80) {
+        return DeltaPatchStatus::NEED_MORE;
+      }
+
+      uint32_t number = varintValue;
+      varintValue = 0;
+      varintShift = 0;
+
+      if (field == Field::ADD_LENGTH) {
+        addLength = number;
+        field = Field::EXTRA_LENGTH;
+      } else if (field == Field::EXTRA_LENGTH) {
+        extraLength = number;
+        field = Field::SEEK;
+      } else {
+        // The seek is relative to the old position after the add bytes
+        int64_t seek = (number & 1) ? -(int64_t)((number + 1) >> 1) : (int64_t)(number >> 1);
+        int64_t target = (int64_t)oldPosition + addLength + seek;
+        if ((uint64_t)newPosition + addLength + extraLength > patchHeader.newSize ||
+            (uint64_t)oldPosition + addLength > patchHeader.oldSize ||
+            target < 0 || target > (int64_t)patchHeader.oldSize) {
+          return DeltaPatchStatus::BAD_BODY;
+        }
+        seekTarget = (uint32_t)target;
+        remaining = addLength;
+        field = Field::ADD_BYTES;
+        nextField();
+      }
+      return DeltaPatchStatus::NEED_MORE;
+    }
+
+    case Field::ADD_BYTES: {
+      uint8_t old;
+      if (!readOldByte(oldPosition++, &old)) {
+        return DeltaPatchStatus::READ_ERROR;
+      }
+      DeltaPatchStatus result = emit((uint8_t)(old + value));
+      remaining--;
+      nextField();
+      return result;
+    }
+
+    case Field::EXTRA_BYTES: {
+      DeltaPatchStatus result = emit(value);
+      remaining--;
+      nextField();
+      return result;
+    }
+  }
+  return DeltaPatchStatus::BAD_BODY;
+}
+
+void DeltaPatchDecoder::nextField() {
+  if (field == Field::ADD_BYTES && remaining == 0) {
+    remaining = extraLength;
+    field = Field::EXTRA_BYTES;
+  }
+  if (field == Field::EXTRA_BYTES && remaining == 0) {
+    oldPosition = seekTarget;
+    field = Field::ADD_LENGTH;
+  }
+}
+
+DeltaPatchStatus DeltaPatchDecoder::emit(uint8_t value) {
+  outBuffer[outLength++] = value;
+  newPosition++;
+
+  if (outLength == sizeof(outBuffer) || newPosition == patchHeader.newSize) {
+    DeltaPatchStatus result = flush();
+    if (result != DeltaPatchStatus::NEED_MORE) {
+      return result;
+    }
+  }
+  return newPosition == patchHeader.newSize ? DeltaPatchStatus::DONE : DeltaPatchStatus::NEED_MORE;
+}
+
+DeltaPatchStatus DeltaPatchDecoder::flush() {
+  if (outLength > 0 && !io.writeNew(io.context, outBuffer, outLength)) {
+    return DeltaPatchStatus::WRITE_ERROR;
+  }
+  outLength = 0;
+  return DeltaPatchStatus::NEED_MORE;
+}
+
+bool DeltaPatchDecoder::readOldByte(uint32_t offset, uint8_t* value) {
+  if (offset < oldBufferStart || offset >= oldBufferStart + oldBufferLength) {
+    if (offset >= patchHeader.oldSize) {
+      return false;
+    }
+    uint32_t length = patchHeader.oldSize - offset;
+    if (length > sizeof(oldBuffer)) {
+      length = sizeof(oldBuffer);
+    }
+    if (!io.readOld(io.context, offset, oldBuffer, length)) {
+      return false;
+    }
+    oldBufferStart = offset;
+    oldBufferLength = length;
+  }
+  *value = oldBuffer[offset - oldBufferStart];
+  return true;
+}
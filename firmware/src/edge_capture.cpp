@@ -0,0 +1,166 @@
+#include "edge_capture.h"
+#include <Arduino.h>
+#include <driver/mcpwm.h>
+#include <driver/gpio.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <soc/soc_caps.h>
+#include "config.h"
+#include "deadlines.h"
+
+// The ESP32-S3 has no pin glitch filter, newer chips (C6, H2, ...) have one
+#if INPUT_GLITCH_FILTER && SOC_GPIO_SUPPORT_PIN_GLITCH_FILTER
+#include <driver/gpio_filter.h>
+#define USE_GLITCH_FILTER 1
+#endif
+
+static EdgeCaptureStats stats;
+static portMUX_TYPE statsLock = portMUX_INITIALIZER_UNLOCKED;   // Interrupt and tasks on both cores
+static DeadlineStage isrDeadline = { "capture_isr", DEADLINE_CAPTURE_BUDGET_US };
+static bool isrDeadlineAdded = false;   // An unregistered stage has no bucket width
+
+// Capture ticks = esp_timer ticks + tickOffset (mod 2^32). Both counters are
+// derived from the same crystal, so only the offset has to be learned. Each
+// interrupt runs a bit after its edge, the smallest latency seen wins.
+static uint32_t tickOffset = 0;
+static bool haveOffset = false;
+
+static bool IRAM_ATTR handleCapture(int64_t isrUs, mcpwm_capture_channel_id_t channel, const cap_event_data_t* data) {
+  uint32_t isrTicks = (uint32_t)isrUs * EDGE_CAPTURE_TICKS_PER_US;
+  if (!haveOffset) {
+    tickOffset = data->cap_value - isrTicks;
+    haveOffset = true;
+  }
+
+  int32_t latencyTicks = (int32_t)(isrTicks + tickOffset - data->cap_value);
+  if (latencyTicks < 0) {
+    // Faster than every interrupt before, move the offset to this one
+    tickOffset -= (uint32_t)latencyTicks;
+    latencyTicks = 0;
+  }
+  uint32_t latencyUs = (uint32_t)latencyTicks / EDGE_CAPTURE_TICKS_PER_US;
+
+  ClockEvent* event = clockEventPool.acquire();
+  portENTER_CRITICAL_ISR(&statsLock);
+  stats.edges++;
+  stats.totalLatencyUs += latencyUs;
+  if (latencyUs < stats.minLatencyUs) {
+    stats.minLatencyUs = latencyUs;
+  }
+  if (latencyUs > stats.maxLatencyUs) {
+    stats.maxLatencyUs = latencyUs;
+  }
+  if (event == nullptr) {
+    stats.dropped++;
+  }
+  portEXIT_CRITICAL_ISR(&statsLock);
+  if (event == nullptr) {
+    return false;
+  }
+
+  bool rising = data->cap_edge == MCPWM_POS_EDGE;
+  if (channel == MCPWM_SELECT_CAP0) {
+    event->type = rising ? ClockEventType::ROCKER_WHITE : ClockEventType::ROCKER_BLACK;
+    event->source = ROCKER_PIN;
+  } else {
+    // Button is active low
+    event->type = rising ? ClockEventType::BUTTON_RELEASED : ClockEventType::BUTTON_PRESSED;
+    event->source = BUTTON_PIN;
+  }
+  event->value = data->cap_value;
+  event->timestampUs = isrUs - latencyUs;
+
+  bool woken = false;
+  if (!clockEventPostFromIsr(event, &woken)) {
+    portENTER_CRITICAL_ISR(&statsLock);
+    stats.dropped++;
+    portEXIT_CRITICAL_ISR(&statsLock);
+  }
+  return woken;
+}
+
+static bool IRAM_ATTR onCapture(mcpwm_unit_t unit, mcpwm_capture_channel_id_t channel,
+                                const cap_event_data_t* data, void* userData) {
+  int64_t isrUs = esp_timer_get_time();
+  bool woken = handleCapture(isrUs, channel, data);
+  if (DEADLINE_MONITOR && isrDeadlineAdded) {
+    deadlineMonitor.record(&isrDeadline, isrUs, (uint32_t)(esp_timer_get_time() - isrUs));
+  }
+  return woken;
+}
+
+static bool enableChannel(mcpwm_io_signals_t ioSignal, mcpwm_capture_channel_id_t channel, int pin) {
+  if (mcpwm_gpio_init(MCPWM_UNIT_0, ioSignal, pin) != ESP_OK) {
+    return false;
+  }
+  // mcpwm_gpio_init() only routes the pin, keep the pull-up of the switches
+  gpio_pullup_en((gpio_num_t)pin);
+
+#ifdef USE_GLITCH_FILTER
+  // Removes spikes of a few clock cycles before they reach the capture unit
+  gpio_pin_glitch_filter_config_t filterConfig = {};
+  filterConfig.clk_src = GLITCH_FILTER_CLK_SRC_DEFAULT;
+  filterConfig.gpio_num = (gpio_num_t)pin;
+  gpio_glitch_filter_handle_t filter = nullptr;
+  if (gpio_new_pin_glitch_filter(&filterConfig, &filter) == ESP_OK) {
+    gpio_glitch_filter_enable(filter);
+  }
+#endif
+
+  mcpwm_capture_config_t config = {};
+  config.cap_edge = MCPWM_BOTH_EDGE;
+  config.cap_prescale = 1;
+  config.capture_cb = onCapture;
+  config.user_data = nullptr;
+  return mcpwm_capture_enable_channel(MCPWM_UNIT_0, channel, &config) == ESP_OK;
+}
+
+bool edgeCaptureInit() {
+  edgeCaptureResetStats();
+  if (!clockEventQueueInit()) {
+    return false;
+  }
+  if (DEADLINE_MONITOR) {
+    isrDeadlineAdded = deadlineMonitor.add(&isrDeadline);
+    if (!isrDeadlineAdded) {
+      Serial.println("WARNING: Capture interrupt deadline could not be monitored!");
+    }
+  }
+
+  if (!enableChannel(MCPWM_CAP_0, MCPWM_SELECT_CAP0, ROCKER_PIN) ||
+      !enableChannel(MCPWM_CAP_1, MCPWM_SELECT_CAP1, BUTTON_PIN)) {
+    Serial.println("ERROR: MCPWM capture could not be enabled!");
+    return false;
+  }
+  return true;
+}
+
+EdgeCaptureStats edgeCaptureStats() {
+  portENTER_CRITICAL(&statsLock);
+  EdgeCaptureStats current = stats;
+  portEXIT_CRITICAL(&statsLock);
+  return current;
+}
+
+void edgeCaptureResetStats() {
+  portENTER_CRITICAL(&statsLock);
+  stats.edges = 0;
+  stats.dropped = 0;
+  stats.minLatencyUs = UINT32_MAX;
+  stats.maxLatencyUs = 0;
+  stats.totalLatencyUs = 0;
+  portEXIT_CRITICAL(&statsLock);
+}
+
+void edgeCapturePrintStats() {
+  EdgeCaptureStats current = edgeCaptureStats();
+  if (current.edges == 0) {
+    Serial.println("Edge capture: no edges");
+    return;
+  }
+  Serial.printf("Edge capture: %u edges, %u dropped\n", (unsigned)current.edges,
+                (unsigned)current.dropped);
+  Serial.printf("  interrupt jitter removed: min %u us, avg %u us, max %u us\n",
+                (unsigned)current.minLatencyUs, (unsigned)(current.totalLatencyUs / current.edges),
+                (unsigned)current.maxLatencyUs);
+}
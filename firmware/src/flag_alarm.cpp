@@ -0,0 +1,125 @@
+#include "flag_alarm.h"
+#include <Arduino.h>
+#include <esp_attr.h>
+#include <esp_timer.h>
+#include "config.h"
+#include "clock_event.h"
+
+// ISR dispatch needs CONFIG_ESP_TIMER_SUPPORTS_ISR_DISPATCH_METHOD in the SDK configuration
+#if CONFIG_ESP_TIMER_SUPPORTS_ISR_DISPATCH_METHOD
+#define FLAG_ALARM_FROM_ISR 1
+#else
+#define FLAG_ALARM_FROM_ISR 0
+#endif
+
+static esp_timer_handle_t timer = nullptr;
+static volatile int64_t armedExpiryUs = 0;
+static FlagAlarmStats stats;
+
+static void IRAM_ATTR fire(int64_t expiryUs, bool fromIsr) {
+  int64_t nowUs = esp_timer_get_time();
+  int64_t targetUs = expiryUs + FLAG_ALARM_GUARD_US;
+  uint32_t lateUs = nowUs > targetUs ? (uint32_t)(nowUs - targetUs) : 0;
+
+  stats.fired++;
+  stats.totalLateUs += lateUs;
+  if (lateUs > stats.maxLateUs) {
+    stats.maxLateUs = lateUs;
+  }
+
+  ClockEvent* event = clockEventPool.acquire();
+  if (event == nullptr) {
+    stats.dropped++;
+    return;
+  }
+  event->type = ClockEventType::FLAG_FALL;
+  event->source = 0;
+  event->value = lateUs;
+  event->timestampUs = expiryUs;
+#if FLAG_ALARM_FROM_ISR
+  if (fromIsr) {
+    bool woken = false;
+    if (!clockEventPostFromIsr(event, &woken)) {
+      stats.dropped++;
+    } else if (woken) {
+      esp_timer_isr_dispatch_need_yield();
+    }
+    return;
+  }
+#endif
+  if (!clockEventPost(event)) {
+    stats.dropped++;
+  }
+}
+
+static void IRAM_ATTR onTimer(void* argument) {
+  // A callback that was already due when the alarm got re-armed
+  int64_t expiryUs = armedExpiryUs;
+  if (esp_timer_get_time() < expiryUs + FLAG_ALARM_GUARD_US) {
+    return;
+  }
+  fire(expiryUs, FLAG_ALARM_FROM_ISR);
+}
+
+bool flagAlarmInit() {
+  flagAlarmResetStats();
+  if (!clockEventQueueInit()) {
+    return false;
+  }
+
+  esp_timer_create_args_t args = {};
+  args.callback = onTimer;
+  args.arg = nullptr;
+#if FLAG_ALARM_FROM_ISR
+  args.dispatch_method = ESP_TIMER_ISR;
+#else
+  args.dispatch_method = ESP_TIMER_TASK;
+  Serial.println("WARNING: No esp_timer ISR dispatch - flag alarm runs in the esp_timer task");
+#endif
+  args.name = "flag_alarm";
+  return esp_timer_create(&args, &timer) == ESP_OK;
+}
+
+void flagAlarmArm(int64_t expiryUs) {
+  if (timer == nullptr) {
+    return;
+  }
+  esp_timer_stop(timer);   // Fails harmlessly if the timer is not running
+  armedExpiryUs = expiryUs;
+  stats.armed++;
+
+  int64_t delayUs = expiryUs + FLAG_ALARM_GUARD_US - esp_timer_get_time();
+  if (delayUs <= 0) {
+    fire(expiryUs, false);
+    return;
+  }
+  esp_timer_start_once(timer, (uint64_t)delayUs);
+}
+
+void flagAlarmCancel() {
+  if (timer != nullptr) {
+    esp_timer_stop(timer);
+  }
+}
+
+FlagAlarmStats flagAlarmStats() {
+  return stats;
+}
+
+void flagAlarmResetStats() {
+  stats.armed = 0;
+  stats.fired = 0;
+  stats.dropped = 0;
+  stats.maxLateUs = 0;
+  stats.totalLateUs = 0;
+}
+
+void flagAlarmPrintStats() {
+  FlagAlarmStats current = stats;
+  Serial.printf("Flag alarm: armed %u times, fired %u, dropped %u\n", (unsigned)current.armed,
+                (unsigned)current.fired, (unsigned)current.dropped);
+  if (current.fired > 0) {
+    Serial.printf("  detection delay: avg %u us, max %u us\n",
+                  (unsigned)(current.totalLateUs / current.fired), (unsigned)current.maxLateUs);
+  }
+}
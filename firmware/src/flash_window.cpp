@@ -0,0 +1,34 @@
+#include "flash_window.h"
+
+FlashWindow::FlashWindow() {
+  begin(0, 0);
+}
+
+void FlashWindow::begin(uint32_t pressWindowUs, uint32_t flagMarginUs) {
+  this->pressWindowUs = pressWindowUs;
+  this->flagMarginUs = flagMarginUs;
+  lastPressUs = INT64_MIN / 2;
+  expiryUs = INT64_MAX;
+  running = false;
+}
+
+void FlashWindow::setGame(bool running, int64_t expiryUs) {
+  this->running = running;
+  this->expiryUs = expiryUs;
+}
+
+void FlashWindow::pressed(int64_t timestampUs) {
+  lastPressUs = timestampUs;
+}
+
+bool FlashWindow::allows(int64_t nowUs, uint32_t durationUs) const {
+  if (!running) {
+    return true;   // Menus, pause and the result screen
+  }
+
+  int64_t endUs = nowUs + durationUs;
+  if (nowUs < lastPressUs || endUs > lastPressUs + pressWindowUs) {
+    return false;
+  }
+  return expiryUs == INT64_MAX || endUs + flagMarginUs <= expiryUs;
+}
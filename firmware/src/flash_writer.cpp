@@ -0,0 +1,142 @@
+#include "flash_writer.h"
+#include <Arduino.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "config.h"
+#include "flash_window.h"
+#include "trace.h"
+
+static portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;
+static FlashWindow window;
+static FlashWriteJob* jobs[FLASH_WRITER_MAX_JOBS];
+static uint8_t jobCount = 0;
+static TaskHandle_t writerTask = nullptr;
+
+static void wake() {
+  if (writerTask != nullptr) {
+    xTaskNotifyGive(writerTask);
+  }
+}
+
+bool flashWriterRequest(FlashWriteJob* job, bool urgent) {
+  portENTER_CRITICAL(&mux);
+  if (!job->registered) {
+    if (jobCount >= FLASH_WRITER_MAX_JOBS) {
+      portEXIT_CRITICAL(&mux);
+      Serial.printf("ERROR: Too many flash write jobs, %s is not written!\n", job->name);
+      return false;
+    }
+    jobs[jobCount++] = job;
+    job->registered = true;
+    job->lastWriteUs = INT64_MIN / 2;
+  }
+  if (job->pending) {
+    job->coalesced++;
+  } else {
+    job->requestedUs = esp_timer_get_time();
+    job->held = false;
+  }
+  job->pending = true;
+  job->urgent = job->urgent || urgent;
+  portEXIT_CRITICAL(&mux);
+  wake();
+  return true;
+}
+
+void flashWriterSetGame(bool running, int64_t expiryUs) {
+  portENTER_CRITICAL(&mux);
+  window.setGame(running, expiryUs);
+  portEXIT_CRITICAL(&mux);
+  if (!running) {
+    wake();
+  }
+}
+
+void flashWriterPressed(int64_t timestampUs) {
+  portENTER_CRITICAL(&mux);
+  window.pressed(timestampUs);
+  portEXIT_CRITICAL(&mux);
+  wake();
+}
+
+// Takes the next job that is due and fits the window, nullptr if there is none
+static FlashWriteJob* takeJob(bool* duringGame) {
+  FlashWriteJob* taken = nullptr;
+  int64_t nowUs = esp_timer_get_time();
+
+  portENTER_CRITICAL(&mux);
+  for (uint8_t i = 0; i < jobCount && taken == nullptr; i++) {
+    FlashWriteJob* job = jobs[i];
+    bool due = job->pending &&
+               (job->urgent || nowUs - job->lastWriteUs >= job->minIntervalMs * 1000LL);
+    if (!due) {
+      continue;
+    }
+    uint32_t expectedUs = job->maxWriteUs > job->budgetUs ? job->maxWriteUs : job->budgetUs;
+    if (!window.allows(nowUs, expectedUs)) {
+      // Once per request, the poll finds the same request again and again
+      if (!job->held) {
+        job->held = true;
+        job->deferred++;
+      }
+      continue;
+    }
+    job->pending = false;
+    job->urgent = false;
+    taken = job;
+  }
+  *duringGame = window.gameRunning();
+  portEXIT_CRITICAL(&mux);
+  return taken;
+}
+
+void flashWriterTask(void* context) {
+  window.begin(FLASH_WRITE_PRESS_WINDOW_MS * 1000, FLASH_WRITE_FLAG_MARGIN_MS * 1000);
+  writerTask = xTaskGetCurrentTaskHandle();
+
+  for (;;) {
+    // Woken by requests and presses, the poll picks up jobs whose interval has passed
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(FLASH_WRITER_POLL_MS));
+
+    bool duringGame = false;
+    FlashWriteJob* job;
+    while ((job = takeJob(&duringGame)) != nullptr) {
+      int64_t startUs = esp_timer_get_time();
+      traceBegin(TracePoint::FLASH_WRITE);
+      bool ok = job->write(job->context);
+      traceEnd(TracePoint::FLASH_WRITE);
+      int64_t endUs = esp_timer_get_time();
+
+      uint32_t writeUs = (uint32_t)(endUs - startUs);
+      uint32_t waitUs = (uint32_t)(startUs - job->requestedUs);
+      if (writeUs > job->maxWriteUs) {
+        job->maxWriteUs = writeUs;
+      }
+      if (waitUs > job->maxWaitUs) {
+        job->maxWaitUs = waitUs;
+      }
+      if (ok) {
+        job->writes++;
+      } else {
+        job->failures++;
+      }
+      if (duringGame) {
+        job->duringGame++;
+      }
+      job->lastWriteUs = endUs;
+    }
+  }
+}
+
+void flashWriterPrintStats() {
+  Serial.println("Flash writer:");
+  Serial.printf("  %-12s %6s %6s %6s %6s %6s %8s %8s\n", "job", "writes", "fails", "merged", "defer",
+                "game", "max us", "wait ms");
+  for (uint8_t i = 0; i < jobCount; i++) {
+    const FlashWriteJob& job = *jobs[i];
+    Serial.printf("  %-12s %6u %6u %6u %6u %6u %8u %8u\n", job.name, (unsigned)job.writes,
+                  (unsigned)job.failures, (unsigned)job.coalesced, (unsigned)job.deferred,
+                  (unsigned)job.duringGame, (unsigned)job.maxWriteUs, (unsigned)(job.maxWaitUs / 1000));
+  }
+}
@@ -0,0 +1,110 @@
+#include "frame_governor.h"
+#include <string.h>
+
+static const int64_t UNIT_US[] = { 1000000, 100000, 10000 };
+
+FrameGovernor::FrameGovernor() {
+  begin(60, 30, 10000, 1);
+}
+
+void FrameGovernor::begin(uint16_t maxFps, uint16_t savingFps, uint32_t fineBelowMs, uint8_t fineDecimals) {
+  this->maxFps = maxFps > 0 ? maxFps : 1;
+  this->savingFps = savingFps > 0 ? savingFps : 1;
+  this->fineBelowUs = (int64_t)fineBelowMs * 1000;
+  this->fineDecimals = fineDecimals > 2 ? 2 : fineDecimals;
+  power = FramePower::NORMAL;
+  dirty = true;
+  lastFrameUs = INT64_MIN / 2;
+  lastValue = UINT32_MAX;
+  lastDecimals = 0;
+  resetStats();
+}
+
+void FrameGovernor::setPower(FramePower power) {
+  this->power = power;
+}
+
+void FrameGovernor::markDirty() {
+  dirty = true;
+}
+
+void FrameGovernor::resetStats() {
+  memset(&counters, 0, sizeof(counters));
+}
+
+uint32_t FrameGovernor::minIntervalUs() const {
+  return 1000000 / (power == FramePower::SAVING ? savingFps : maxFps);
+}
+
+uint8_t FrameGovernor::decimals(int64_t remainingUs) const {
+  return remainingUs < fineBelowUs ? fineDecimals : 0;
+}
+
+uint32_t FrameGovernor::value(int64_t remainingUs, uint8_t decimals) {
+  if (remainingUs <= 0) {
+    return 0;
+  }
+  int64_t unit = UNIT_US[decimals];
+  return (uint32_t)((remainingUs + unit - 1) / unit);
+}
+
+int64_t FrameGovernor::nextFrameUs(int64_t nowUs, int64_t remainingUs, bool running) const {
+  if (dirty) {
+    return nowUs;
+  }
+  if (!running || remainingUs <= 0) {
+    return INT64_MAX;
+  }
+
+  // Not before the frame rate cap allows it
+  int64_t earliestUs = lastFrameUs + minIntervalUs();
+  if (earliestUs < nowUs) {
+    earliestUs = nowUs;
+  }
+  int64_t left = remainingUs - (earliestUs - nowUs);
+  if (left <= 0) {
+    return earliestUs;   // Shows 0, the flag alarm takes over
+  }
+
+  // The value changed while the cap held the frame back
+  uint8_t shownDecimals = decimals(left);
+  uint32_t shown = value(left, shownDecimals);
+  if (shown != lastValue || shownDecimals != lastDecimals) {
+    return earliestUs;
+  }
+
+  // Next boundary: the shown value goes down by one unit
+  int64_t changeUs = earliestUs + left - (int64_t)(shown - 1) * UNIT_US[shownDecimals];
+  if (shownDecimals != fineDecimals && left >= fineBelowUs) {
+    // Switching to fractions happens between two second boundaries
+    int64_t fineUs = earliestUs + left - fineBelowUs + 1;
+    if (fineUs < changeUs) {
+      changeUs = fineUs;
+    }
+  }
+  return changeUs;
+}
+
+void FrameGovernor::frameDrawn(int64_t nowUs, int64_t plannedUs, int64_t remainingUs) {
+  uint8_t shownDecimals = decimals(remainingUs);
+  counters.frames++;
+  if (dirty) {
+    counters.dirtyFrames++;
+  } else if (shownDecimals == 0) {
+    counters.coarseFrames++;
+  } else {
+    counters.fineFrames++;
+  }
+  if (!dirty && plannedUs != INT64_MAX && nowUs > plannedUs) {
+    uint32_t lateUs = (uint32_t)(nowUs - plannedUs);
+    counters.totalLateUs += lateUs;
+    if (lateUs > counters.maxLateUs) {
+      counters.maxLateUs = lateUs;
+    }
+  }
+
+  dirty = false;
+  lastFrameUs = nowUs;
+  lastValue = value(remainingUs, shownDecimals);
+  lastDecimals = shownDecimals;
+}
@@ -0,0 +1,134 @@
+#include "game_checkpoint.h"
+#include <string.h>
+
+#define CHECKPOINT_MAGIC 0xC7
+#define COMPACT_MAX_CS ((1UL << 23) - 1)
+
+/**
+ * @brief Writes values of any bit width into a byte array, LSB first
+ */
+struct BitPacker {
+  uint8_t* bytes;
+  uint16_t position;
+
+  void put(uint32_t value, uint8_t bits) {
+    for (uint8_t i = 0; i < bits; i++, position++) {
+      if (value & (1UL << i)) {
+        bytes[position / 8] |= (uint8_t)(1 << (position % 8));
+      }
+    }
+  }
+};
+
+/**
+ * @brief Reads values written by BitPacker
+ */
+struct BitUnpacker {
+  const uint8_t* bytes;
+  uint16_t position;
+
+  uint32_t get(uint8_t bits) {
+    uint32_t value = 0;
+    for (uint8_t i = 0; i < bits; i++, position++) {
+      if (bytes[position / 8] & (1 << (position % 8))) {
+        value |= 1UL << i;
+      }
+    }
+    return value;
+  }
+};
+
+static uint16_t crc16(const uint8_t* data, uint8_t length) {
+  // CRC-16/CCITT-FALSE
+  uint16_t crc = 0xFFFF;
+  for (uint8_t i = 0; i < length; i++) {
+    crc ^= (uint16_t)data[i] << 8;
+    for (uint8_t bit = 0; bit < 8; bit++) {
+      crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+    }
+  }
+  return crc;
+}
+
+static uint32_t clampMs(uint32_t ms) {
+  return ms > GAME_CHECKPOINT_MAX_MS ? GAME_CHECKPOINT_MAX_MS : ms;
+}
+
+void checkpointPack(const GameSnapshot& snapshot, uint8_t* out) {
+  // magic 8 | sequence 16 | state 4 | side 1 | time control 5 | plies 10 | white 27 | black 27 | crc 16
+  memset(out, 0, GAME_CHECKPOINT_SIZE);
+  BitPacker packer = { out, 0 };
+  packer.put(CHECKPOINT_MAGIC, 8);
+  packer.put(snapshot.sequence, 16);
+  packer.put(snapshot.state, 4);
+  packer.put(snapshot.activeSide, 1);
+  packer.put(snapshot.timeControl, 5);
+  packer.put(snapshot.plies, 10);
+  packer.put(clampMs(snapshot.whiteMs), 27);
+  packer.put(clampMs(snapshot.blackMs), 27);
+
+  uint16_t crc = crc16(out, GAME_CHECKPOINT_SIZE - 2);
+  out[GAME_CHECKPOINT_SIZE - 2] = (uint8_t)crc;
+  out[GAME_CHECKPOINT_SIZE - 1] = (uint8_t)(crc >> 8);
+}
+
+bool checkpointUnpack(const uint8_t* in, GameSnapshot* snapshot) {
+  uint16_t crc = (uint16_t)(in[GAME_CHECKPOINT_SIZE - 2] | (in[GAME_CHECKPOINT_SIZE - 1] << 8));
+  if (in[0] != CHECKPOINT_MAGIC || crc16(in, GAME_CHECKPOINT_SIZE - 2) != crc) {
+    return false;
+  }
+
+  BitUnpacker unpacker = { in, 8 };
+  snapshot->sequence = (uint16_t)unpacker.get(16);
+  snapshot->state = (uint8_t)unpacker.get(4);
+  snapshot->activeSide = (uint8_t)unpacker.get(1);
+  snapshot->timeControl = (uint8_t)unpacker.get(5);
+  snapshot->plies = (uint16_t)unpacker.get(10);
+  snapshot->whiteMs = unpacker.get(27);
+  snapshot->blackMs = unpacker.get(27);
+  return true;
+}
+
+uint64_t checkpointPackCompact(const GameSnapshot& snapshot) {
+  // valid 1 | side 1 | time control 5 | plies 10 | white 23 cs | black 23 cs
+  uint32_t whiteCs = snapshot.whiteMs / 10;
+  uint32_t blackCs = snapshot.blackMs / 10;
+  uint64_t word = 1;
+  word |= (uint64_t)(snapshot.activeSide & 0x1) << 1;
+  word |= (uint64_t)(snapshot.timeControl & 0x1F) << 2;
+  word |= (uint64_t)(snapshot.plies & 0x3FF) << 7;
+  word |= (uint64_t)(whiteCs > COMPACT_MAX_CS ? COMPACT_MAX_CS : whiteCs) << 17;
+  word |= (uint64_t)(blackCs > COMPACT_MAX_CS ? COMPACT_MAX_CS : blackCs) << 40;
+  return word;
+}
+
+bool checkpointUnpackCompact(uint64_t word, GameSnapshot* snapshot) {
+  if ((word & 1) == 0) {
+    return false;
+  }
+  snapshot->state = 0;
+  snapshot->sequence = 0;
+  snapshot->activeSide = (uint8_t)((word >> 1) & 0x1);
+  snapshot->timeControl = (uint8_t)((word >> 2) & 0x1F);
+  snapshot->plies = (uint16_t)((word >> 7) & 0x3FF);
+  snapshot->whiteMs = (uint32_t)((word >> 17) & COMPACT_MAX_CS) * 10;
+  snapshot->blackMs = (uint32_t)((word >> 40) & COMPACT_MAX_CS) * 10;
+  return true;
+}
+
+CheckpointSource checkpointSelect(const uint8_t* slotA, const uint8_t* slotB, uint64_t compact,
+                                  GameSnapshot* snapshot) {
+  GameSnapshot a, b;
+  bool validA = checkpointUnpack(slotA, &a);
+  bool validB = checkpointUnpack(slotB, &b);
+  if (validA || validB) {
+    // Sequence numbers wrap, the newer one is less than half the range ahead
+    if (validA && validB) {
+      *snapshot = (int16_t)(a.sequence - b.sequence) > 0 ? a : b;
+    } else {
+      *snapshot = validA ? a : b;
+    }
+    return snapshot->state == GAME_CHECKPOINT_ENDED ? CheckpointSource::ENDED : CheckpointSource::RTC;
+  }
+  return checkpointUnpackCompact(compact, snapshot) ? CheckpointSource::FLASH : CheckpointSource::NONE;
+}
@@ -0,0 +1,75 @@
+#include "game_record.h"
+#include <stdio.h>
+#include <string.h>
+#include "time_control.h"
+
+void gameRecordReset(GameRecord& record, uint8_t timeControl) {
+  record.whiteName[0] = '\0';
+  record.blackName[0] = '\0';
+  record.timeControl = timeControl;
+  record.result = GameResult::UNDECIDED;
+  record.plyCount = 0;
+  record.revision++;
+}
+
+bool gameRecordAddMove(GameRecord& record, uint32_t timeMs) {
+  if (record.plyCount >= GAME_MAX_PLIES) {
+    return false;
+  }
+  record.moveTimesMs[record.plyCount++] = timeMs;
+  record.revision++;
+  return true;
+}
+
+void gameRecordSetResult(GameRecord& record, GameResult result) {
+  record.result = result;
+  record.revision++;
+}
+
+const char* gameResultToString(GameResult result) {
+  switch (result) {
+    case GameResult::WHITE_WINS:
+      return "1-0";
+    case GameResult::BLACK_WINS:
+      return "0-1";
+    case GameResult::DRAW:
+      return "1/2-1/2";
+    default:
+      return "*";
+  }
+}
+
+size_t gameRecordSerialize(const GameRecord& record, char* buffer, size_t size) {
+  if (size == 0) {
+    return 0;
+  }
+
+  const TimeControl& control = TIME_CONTROLS[record.timeControl < TIME_CONTROL_COUNT ? record.timeControl : 0];
+  int written = snprintf(buffer, size, "CC1;W=%s;B=%s;R=%s;TC=%lu+%lu;T=",
+                         record.whiteName, record.blackName, gameResultToString(record.result),
+                         (unsigned long)control.baseSeconds, (unsigned long)control.incrementSeconds);
+  if (written < 0 || (size_t)written >= size) {
+    buffer[size - 1] = '\0';
+    return size - 1;
+  }
+
+  size_t length = (size_t)written;
+  for (uint16_t i = 0; i < record.plyCount; i++) {
+    char number[12];
+    int numberLength = snprintf(number, sizeof(number), i == 0 ? "%lu" : ",%lu",
+                                (unsigned long)((record.moveTimesMs[i] + 50) / 100));
+
+    // Keep room for the "~" that marks a cut move list
+    if (length + numberLength + 2 > size) {
+      if (length + 2 <= size) {
+        buffer[length++] = '~';
+      }
+      break;
+    }
+    memcpy(buffer + length, number, numberLength);
+    length += numberLength;
+  }
+
+  buffer[length] = '\0';
+  return length;
+}
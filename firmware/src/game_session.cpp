@@ -0,0 +1,64 @@
+#include "game_session.h"
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+#include "config.h"
+#include "clock_event.h"
+#include "result_qr.h"
+#include "alloc_guard.h"
+
+static Arena arena;
+static GameRecord* record = nullptr;
+
+bool gameSessionBegin(uint8_t timeControl) {
+  gameSessionEnd();
+
+  if (!arena.begin(GAME_SESSION_ARENA_SIZE, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT)) {
+    Serial.println("ERROR: Could not allocate game session arena!");
+    return false;
+  }
+
+  record = arena.create<GameRecord>();
+  if (record == nullptr) {
+    Serial.println("ERROR: Game record does not fit into the session arena!");
+    arena.release();
+    return false;
+  }
+  gameRecordReset(*record, timeControl);
+  return true;
+}
+
+void gameSessionEnd() {
+  if (!arena.isReady()) {
+    return;
+  }
+  gameSessionPrintStats();
+
+  // The next record may land at the same address with the same revision
+  resultQrRelease();
+  record = nullptr;
+  arena.release();
+}
+
+bool gameSessionActive() {
+  return record != nullptr;
+}
+
+GameRecord* gameSessionRecord() {
+  return record;
+}
+
+Arena& gameSessionArena() {
+  return arena;
+}
+
+void gameSessionPrintStats() {
+  Serial.printf("Session arena: %u of %u bytes used (peak %u), %u failed allocations\n",
+                (unsigned)arena.used(), (unsigned)arena.capacity(), (unsigned)arena.highWater(),
+                (unsigned)arena.failedAllocations());
+  Serial.printf("Event pool: peak %u of %u, exhausted %u times\n", clockEventPool.highWater(),
+                clockEventPool.capacity(), (unsigned)clockEventPool.exhaustedCount());
+  if (allocGuardEnabled()) {
+    Serial.printf("Alloc guard: %u heap allocations while a time was running\n",
+                  (unsigned)allocGuardViolations());
+  }
+}
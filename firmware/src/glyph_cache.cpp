@@ -0,0 +1,297 @@
+#include "glyph_cache.h"
+#include <string.h>
+
+GlyphCache::GlyphCache()
+    : entries(nullptr), buckets(nullptr), bitmaps(nullptr), slots(0), bucketMask(0), slotSize(0),
+      used(0), newest(NONE), oldest(NONE) {
+  memset(widths, 0, sizeof(widths));
+  resetStats();
+}
+
+bool GlyphCache::begin(uint8_t* memory, size_t bytes, uint16_t slotBytes) {
+  slots = 0;
+  if (memory == nullptr || slotBytes == 0) {
+    return false;
+  }
+
+  // Per slot: entry, bitmap and up to two bucket heads (buckets are a power of two)
+  size_t perSlot = sizeof(Entry) + slotBytes + 2 * sizeof(uint16_t);
+  size_t count = bytes / perSlot;
+  if (count > NONE - 1) {
+    count = NONE - 1;
+  }
+  if (count == 0) {
+    return false;
+  }
+  size_t bucketCount = 1;
+  while (bucketCount < count) {
+    bucketCount <<= 1;
+  }
+
+  entries = (Entry*)memory;
+  buckets = (uint16_t*)(memory + count * sizeof(Entry));
+  bitmaps = (uint8_t*)(buckets + bucketCount);
+  slots = (uint16_t)count;
+  bucketMask = (uint16_t)(bucketCount - 1);
+  slotSize = slotBytes;
+  clear();
+  return true;
+}
+
+void GlyphCache::clear() {
+  for (uint16_t i = 0; i < slots; i++) {
+    entries[i].key = 0;
+  }
+  for (uint32_t i = 0; slots > 0 && i <= bucketMask; i++) {
+    buckets[i] = NONE;
+  }
+  used = 0;
+  newest = NONE;
+  oldest = NONE;
+  memset(widths, 0, sizeof(widths));
+}
+
+void GlyphCache::resetStats() {
+  memset(&counters, 0, sizeof(counters));
+}
+
+uint32_t GlyphCache::keyOf(const VlwFont& font, const VlwGlyph& glyph) {
+  // The bit above the code point keeps the key of font 0, size 0, U+0000 non-zero,
+  // which only works while code points stay below it
+  static_assert(sizeof(glyph.codepoint) == 2, "Glyph keys need code points up to U+FFFF");
+  return ((uint32_t)font.id() << 25) | ((uint32_t)(font.size() & 0x7F) << 17) | 0x10000 | glyph.codepoint;
+}
+
+void GlyphCache::unlink(uint16_t index) {
+  Entry& entry = entries[index];
+  if (entry.newer != NONE) {
+    entries[entry.newer].older = entry.older;
+  } else {
+    newest = entry.older;
+  }
+  if (entry.older != NONE) {
+    entries[entry.older].newer = entry.newer;
+  } else {
+    oldest = entry.newer;
+  }
+}
+
+void GlyphCache::pushNewest(uint16_t index) {
+  Entry& entry = entries[index];
+  entry.newer = NONE;
+  entry.older = newest;
+  if (newest != NONE) {
+    entries[newest].newer = index;
+  }
+  newest = index;
+  if (oldest == NONE) {
+    oldest = index;
+  }
+}
+
+void GlyphCache::pushOldest(uint16_t index) {
+  Entry& entry = entries[index];
+  entry.older = NONE;
+  entry.newer = oldest;
+  if (oldest != NONE) {
+    entries[oldest].older = index;
+  }
+  oldest = index;
+  if (newest == NONE) {
+    newest = index;
+  }
+}
+
+void GlyphCache::removeFromBucket(uint16_t index) {
+  uint16_t* link = &buckets[entries[index].key & bucketMask];
+  while (*link != NONE) {
+    if (*link == index) {
+      *link = entries[index].chain;
+      return;
+    }
+    link = &entries[*link].chain;
+  }
+}
+
+const uint8_t* GlyphCache::bitmap(const VlwFont& font, const VlwGlyph& glyph, uint8_t* scratch) {
+  uint32_t bytes = (uint32_t)glyph.width * glyph.height;
+  if (slots == 0 || bytes > slotSize) {
+    counters.uncached++;
+    counters.bytesRead += bytes;
+    return font.readBitmap(glyph, scratch) ? scratch : nullptr;
+  }
+
+  uint32_t key = keyOf(font, glyph);
+  for (uint16_t index = buckets[key & bucketMask]; index != NONE; index = entries[index].chain) {
+    if (entries[index].key == key) {
+      counters.hits++;
+      if (index != newest) {
+        unlink(index);
+        pushNewest(index);
+      }
+      return bitmaps + (size_t)index * slotSize;
+    }
+  }
+
+  // Miss: take a free slot or the least recently used one
+  uint16_t index;
+  bool wasFree = used < slots;
+  if (wasFree) {
+    index = used++;
+  } else {
+    index = oldest;
+    unlink(index);
+    removeFromBucket(index);
+    counters.evictions++;
+  }
+
+  uint8_t* target = bitmaps + (size_t)index * slotSize;
+  counters.misses++;
+  counters.bytesRead += bytes;
+  if (!font.readBitmap(glyph, target)) {
+    entries[index].key = 0;
+    if (wasFree) {
+      used--;
+    } else {
+      pushOldest(index);   // Reused by the next miss
+    }
+    return nullptr;
+  }
+
+  Entry& entry = entries[index];
+  entry.key = key;
+  entry.chain = buckets[key & bucketMask];
+  buckets[key & bucketMask] = index;
+  pushNewest(index);
+  return target;
+}
+
+uint32_t GlyphCache::nextCodepoint(const char** text) {
+  const uint8_t* bytes = (const uint8_t*)*text;
+  uint8_t lead = bytes[0];
+  if (lead == 0) {
+    return 0;
+  }
+
+  uint32_t codepoint;
+  uint8_t length;
+  if (lead < 0x80) {
+    *text += 1;
+    return lead;
+  } else if ((lead & 0xE0) == 0xC0) {
+    codepoint = lead & 0x1F;
+    length = 2;
+  } else if ((lead & 0xF0) == 0xE0) {
+    codepoint = lead & 0x0F;
+    length = 3;
+  } else if ((lead & 0xF8) == 0xF0) {
+    codepoint = lead & 0x07;
+    length = 4;
+  } else {
+    *text += 1;
+    return 0xFFFD;
+  }
+
+  for (uint8_t i = 1; i < length; i++) {
+    if ((bytes[i] & 0xC0) != 0x80) {
+      *text += i;   // Truncated sequence, continue with the byte that ended it
+      return 0xFFFD;
+    }
+    codepoint = (codepoint << 6) | (bytes[i] & 0x3F);
+  }
+  *text += length;
+  return codepoint;
+}
+
+int32_t GlyphCache::textWidth(const VlwFont& font, const char* text) {
+  uint32_t hash = 2166136261u ^ font.id();
+  hash *= 16777619u;
+  size_t length = 0;
+  for (const char* c = text; *c != '\0'; c++, length++) {
+    hash ^= (uint8_t)*c;
+    hash *= 16777619u;
+  }
+  if (hash == 0) {
+    hash = 1;
+  }
+
+  // The hash only picks the entry, the text decides
+  WidthEntry& entry = widths[hash % GLYPH_CACHE_WIDTH_ENTRIES];
+  if (entry.hash == hash) {
+    if (entry.fontId == font.id() && entry.fontSize == font.size() && strcmp(entry.text, text) == 0) {
+      counters.widthHits++;
+      return entry.width;
+    }
+    counters.widthCollisions++;
+  }
+
+  counters.widthMisses++;
+  int32_t width = 0;
+  const char* cursor = text;
+  uint32_t codepoint;
+  while ((codepoint = nextCodepoint(&cursor)) != 0) {
+    const VlwGlyph* glyph = font.find(codepoint);
+    width += glyph != nullptr ? glyph->xAdvance : font.spaceWidth();
+  }
+  if (length < sizeof(entry.text)) {
+    entry.hash = hash;
+    entry.width = width;
+    entry.fontId = font.id();
+    entry.fontSize = font.size();
+    memcpy(entry.text, text, length + 1);
+  }
+  return width;
+}
+
+static uint16_t blend(uint8_t alpha, uint16_t foreground, uint16_t background) {
+  // Same fixed-point interpolation as TFT_eSPI::alphaBlend()
+  uint16_t weight = (alpha + 4) >> 3;
+  uint32_t fg = (foreground | ((uint32_t)foreground << 16)) & 0x07E0F81F;
+  uint32_t bg = (background | ((uint32_t)background << 16)) & 0x07E0F81F;
+  uint32_t mixed = (((fg - bg) * weight) >> 5) + bg;
+  mixed &= 0x07E0F81F;
+  return (uint16_t)(mixed | (mixed >> 16));
+}
+
+static inline uint16_t toDisplayOrder(uint16_t color) {
+  return (uint16_t)((color << 8) | (color >> 8));
+}
+
+int32_t GlyphCache::drawText(const VlwFont& font, const char* text, int32_t x, int32_t y, uint16_t* buffer,
+                             int32_t bufferWidth, int32_t bufferHeight, uint16_t foreground,
+                             uint16_t background, uint8_t* scratch) {
+  int32_t baseline = y + font.ascent();
+  uint16_t solid = toDisplayOrder(foreground);
+  uint32_t codepoint;
+  while ((codepoint = nextCodepoint(&text)) != 0) {
+    const VlwGlyph* glyph = font.find(codepoint);
+    if (glyph == nullptr) {
+      x += font.spaceWidth();
+      continue;
+    }
+
+    int32_t left = x + glyph->dX;
+    int32_t top = baseline - glyph->dY;
+    if (left < bufferWidth && left + glyph->width > 0 && top < bufferHeight && top + glyph->height > 0) {
+      const uint8_t* alpha = bitmap(font, *glyph, scratch);
+      for (int32_t row = 0; alpha != nullptr && row < glyph->height; row++) {
+        int32_t py = top + row;
+        if (py < 0 || py >= bufferHeight) {
+          continue;
+        }
+        uint16_t* line = buffer + py * bufferWidth;
+        const uint8_t* source = alpha + row * glyph->width;
+        for (int32_t column = 0; column < glyph->width; column++) {
+          int32_t px = left + column;
+          uint8_t a = source[column];
+          if (a == 0 || px < 0 || px >= bufferWidth) {
+            continue;   // Background is already in the buffer
+          }
+          line[px] = a == 0xFF ? solid : toDisplayOrder(blend(a, foreground, background));
+        }
+      }
+    }
+    x += glyph->xAdvance;
+  }
+  return x;
+}
@@ -0,0 +1,197 @@
+#include "input_engine.h"
+
+Debouncer::Debouncer() {
+  reset(0);
+}
+
+void Debouncer::reset(uint32_t window) {
+  lockoutEndUs = 0;
+  lastEdgeUs = 0;
+  windowUs = window;
+  ignored = 0;
+  haveEdge = false;
+  level = false;
+  lastLevel = false;
+  checkPending = false;
+}
+
+bool Debouncer::accept(int64_t timestampUs, bool edgeLevel) {
+  lastEdgeUs = timestampUs;
+  lastLevel = edgeLevel;
+  if (haveEdge && (edgeLevel == level || timestampUs < lockoutEndUs)) {
+    ignored++;
+    return false;
+  }
+  // The lockout starts at the first edge and is not extended by bounce
+  lockoutEndUs = timestampUs + windowUs;
+  level = edgeLevel;
+  haveEdge = true;
+  checkPending = true;
+  return true;
+}
+
+bool Debouncer::check(int64_t nowUs, bool pinLevel, int64_t* timestampUs) {
+  if (!checkPending || nowUs < lockoutEndUs) {
+    return false;
+  }
+  checkPending = false;
+  if (pinLevel == level) {
+    return false;
+  }
+
+  // The edge back was ignored as bounce (or lost), take it as the change
+  *timestampUs = lastLevel == pinLevel ? lastEdgeUs : lockoutEndUs;
+  lockoutEndUs = *timestampUs + windowUs;
+  level = pinLevel;
+  lastLevel = pinLevel;
+  checkPending = lockoutEndUs > nowUs;
+  return true;
+}
+
+/**
+ * @brief Order of events with the same timestamp
+ */
+static uint8_t priority(ClockEventType type) {
+  switch (type) {
+    case ClockEventType::FLAG_FALL:
+      return 0;   // The time was already over
+    case ClockEventType::ROCKER_WHITE:
+    case ClockEventType::ROCKER_BLACK:
+      return 1;   // The move is completed before a pause
+    default:
+      return 2;
+  }
+}
+
+// A flag fall arrives after all earlier edges, see FLAG_ALARM_GUARD_US
+static int64_t dueUs(const ClockEvent* event, uint32_t resolveWindowUs) {
+  return event->type == ClockEventType::FLAG_FALL ? event->timestampUs : event->timestampUs + resolveWindowUs;
+}
+
+static bool before(const ClockEvent* a, const ClockEvent* b) {
+  if (a->timestampUs != b->timestampUs) {
+    return a->timestampUs < b->timestampUs;
+  }
+  return priority(a->type) < priority(b->type);
+}
+
+InputEngine::InputEngine() {
+  pendingCount = 0;
+  reset(0, 0, 0);
+}
+
+void InputEngine::reset(uint32_t rockerWindowUs, uint32_t buttonWindowUs, uint32_t resolveWindow) {
+  for (uint8_t i = 0; i < pendingCount; i++) {
+    clockEventPool.release(pending[i]);
+  }
+  pendingCount = 0;
+  rocker.reset(rockerWindowUs);
+  button.reset(buttonWindowUs);
+  resolveWindowUs = resolveWindow;
+  accepted = 0;
+  reordered = 0;
+  overflows = 0;
+  confirmed = 0;
+}
+
+void InputEngine::push(ClockEvent* event) {
+  bool isNew = true;
+  switch (event->type) {
+    case ClockEventType::ROCKER_WHITE:
+    case ClockEventType::ROCKER_BLACK:
+      isNew = rocker.accept(event->timestampUs, event->type == ClockEventType::ROCKER_WHITE);
+      break;
+    case ClockEventType::BUTTON_PRESSED:
+    case ClockEventType::BUTTON_RELEASED:
+      isNew = button.accept(event->timestampUs, event->type == ClockEventType::BUTTON_RELEASED);
+      break;
+    default:
+      break;
+  }
+
+  if (!isNew) {
+    clockEventPool.release(event);
+    return;
+  }
+  insert(event);
+}
+
+int64_t InputEngine::nextCheckUs() const {
+  int64_t rockerUs = rocker.checkDueUs();
+  int64_t buttonUs = button.checkDueUs();
+  return rockerUs < buttonUs ? rockerUs : buttonUs;
+}
+
+void InputEngine::check(int64_t nowUs, bool rockerLevel, bool buttonLevel) {
+  int64_t timestampUs;
+  if (rocker.check(nowUs, rockerLevel, &timestampUs)) {
+    confirm(rockerLevel ? ClockEventType::ROCKER_WHITE : ClockEventType::ROCKER_BLACK, ROCKER_PIN, timestampUs);
+  }
+  if (button.check(nowUs, buttonLevel, &timestampUs)) {
+    // Button is active low
+    confirm(buttonLevel ? ClockEventType::BUTTON_RELEASED : ClockEventType::BUTTON_PRESSED, BUTTON_PIN, timestampUs);
+  }
+}
+
+void InputEngine::confirm(ClockEventType type, uint8_t source, int64_t timestampUs) {
+  ClockEvent* event = clockEventPool.acquire();
+  if (event == nullptr) {
+    overflows++;
+    return;
+  }
+  event->type = type;
+  event->source = source;
+  event->value = 0;
+  event->timestampUs = timestampUs;
+  confirmed++;
+  insert(event);
+}
+
+void InputEngine::insert(ClockEvent* event) {
+  if (pendingCount == INPUT_ENGINE_MAX_PENDING) {
+    overflows++;
+    clockEventPool.release(event);
+    return;
+  }
+
+  // Insertion sort, there are only a few events pending at any time
+  uint8_t index = pendingCount;
+  while (index > 0 && before(event, pending[index - 1])) {
+    pending[index] = pending[index - 1];
+    index--;
+  }
+  if (index < pendingCount) {
+    reordered++;
+  }
+  pending[index] = event;
+  pendingCount++;
+}
+
+ClockEvent* InputEngine::pop(int64_t nowUs) {
+  if (pendingCount == 0 || dueUs(pending[0], resolveWindowUs) > nowUs) {
+    return nullptr;
+  }
+
+  ClockEvent* event = pending[0];
+  pendingCount--;
+  for (uint8_t i = 0; i < pendingCount; i++) {
+    pending[i] = pending[i + 1];
+  }
+  accepted++;
+  return event;
+}
+
+int64_t InputEngine::nextDueUs() const {
+  return pendingCount > 0 ? dueUs(pending[0], resolveWindowUs) : INT64_MAX;
+}
+
+InputEngineStats InputEngine::stats() const {
+  InputEngineStats result;
+  result.accepted = accepted;
+  result.rockerBounces = rocker.bounces();
+  result.buttonBounces = button.bounces();
+  result.reordered = reordered;
+  result.overflows = overflows;
+  result.confirmed = confirmed;
+  return result;
+}
@@ -0,0 +1,172 @@
+#include "latency_bench.h"
+#include <Arduino.h>
+#include <WiFi.h>
+#include <WiFiUdp.h>
+#include <esp_timer.h>
+#include <esp_partition.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "config.h"
+#include "flash_writer.h"
+#include "trace.h"
+
+static esp_timer_handle_t probeTimer = nullptr;
+static LatencyHistogram wake;     // Edge until the time task got the event
+static LatencyHistogram charge;   // Edge until the event was charged
+static LatencyHistogram press;    // Same for rocker and button edges only
+static volatile uint32_t flashWrites = 0;
+static volatile uint32_t networkPackets = 0;
+static volatile uint32_t redraws = 0;
+
+static void clear(LatencyHistogram& histogram) {
+  memset(&histogram, 0, sizeof(histogram));
+  histogram.minUs = UINT32_MAX;
+}
+
+static void record(LatencyHistogram& histogram, const ClockEvent& event) {
+  // Flag falls are stamped with the expiry, not with an edge
+  if (event.type == ClockEventType::FLAG_FALL) {
+    return;
+  }
+  int64_t latency = esp_timer_get_time() - event.timestampUs;
+  uint32_t latencyUs = latency > 0 ? (uint32_t)latency : 0;
+
+  histogram.samples++;
+  histogram.totalUs += latencyUs;
+  if (latencyUs < histogram.minUs) {
+    histogram.minUs = latencyUs;
+  }
+  if (latencyUs > histogram.maxUs) {
+    histogram.maxUs = latencyUs;
+  }
+  uint32_t bucket = latencyUs / LATENCY_BENCH_BUCKET_US;
+  histogram.buckets[bucket < LATENCY_BENCH_BUCKETS ? bucket : LATENCY_BENCH_BUCKETS - 1]++;
+}
+
+static uint32_t percentile(const LatencyHistogram& histogram, uint32_t percent) {
+  uint32_t target = (uint32_t)(((uint64_t)histogram.samples * percent + 99) / 100);
+  uint32_t count = 0;
+  for (uint32_t i = 0; i < LATENCY_BENCH_BUCKETS; i++) {
+    count += histogram.buckets[i];
+    if (count >= target) {
+      return (i + 1) * LATENCY_BENCH_BUCKET_US;   // Upper bound of the bucket
+    }
+  }
+  return histogram.maxUs;
+}
+
+static void printHistogram(const char* name, const LatencyHistogram& histogram) {
+  if (histogram.samples == 0) {
+    Serial.printf("  %-7s no samples\n", name);
+    return;
+  }
+  Serial.printf("  %-7s n=%u min %u avg %u p50 <%u p99 <%u max %u us\n", name,
+                (unsigned)histogram.samples, (unsigned)histogram.minUs,
+                (unsigned)(histogram.totalUs / histogram.samples), (unsigned)percentile(histogram, 50),
+                (unsigned)percentile(histogram, 99), (unsigned)histogram.maxUs);
+}
+
+static void onProbe(void* argument) {
+  ClockEvent* event = clockEventPool.acquire();
+  if (event == nullptr) {
+    return;
+  }
+  event->type = ClockEventType::LATENCY_PROBE;
+  event->source = 0;
+  event->value = 0;
+  event->timestampUs = esp_timer_get_time();
+  clockEventPost(event);
+}
+
+bool latencyBenchStart() {
+  clear(wake);
+  clear(charge);
+  clear(press);
+
+  esp_timer_create_args_t args = {};
+  args.callback = onProbe;
+  args.dispatch_method = ESP_TIMER_TASK;
+  args.name = "latency_probe";
+  if (esp_timer_create(&args, &probeTimer) != ESP_OK) {
+    return false;
+  }
+  return esp_timer_start_periodic(probeTimer, LATENCY_BENCH_PROBE_MS * 1000ULL) == ESP_OK;
+}
+
+void latencyBenchRecordWake(const ClockEvent& event) {
+  record(wake, event);
+}
+
+void latencyBenchRecordCharge(const ClockEvent& event) {
+  record(charge, event);
+  if (event.type != ClockEventType::LATENCY_PROBE && event.type != ClockEventType::TOUCH_GESTURE) {
+    record(press, event);
+  }
+}
+
+static const esp_partition_t* flashPartition = nullptr;
+
+static bool writeSector(void* context) {
+  static uint8_t sector[SPI_FLASH_SEC_SIZE];
+  size_t offset = flashPartition->size - SPI_FLASH_SEC_SIZE;
+  memset(sector, (uint8_t)flashWrites, sizeof(sector));
+  if (esp_partition_erase_range(flashPartition, offset, SPI_FLASH_SEC_SIZE) != ESP_OK ||
+      esp_partition_write(flashPartition, offset, sector, sizeof(sector)) != ESP_OK) {
+    return false;
+  }
+  flashWrites++;
+  return true;
+}
+
+static FlashWriteJob sectorJob = { "bench_flash", writeSector, nullptr, 0, LATENCY_BENCH_FLASH_BUDGET_US };
+
+void latencyBenchFlashLoad(void* context) {
+  // Own scratch partition, the sectors of SPIFFS or NVS must never be erased
+  flashPartition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, LATENCY_BENCH_PARTITION);
+  if (flashPartition == nullptr) {
+    Serial.println("WARNING: No bench partition, latency benchmark runs without flash load");
+    vTaskDelete(NULL);
+  }
+
+  for (;;) {
+    if (LATENCY_BENCH_FLASH_SCHEDULED) {
+      flashWriterRequest(&sectorJob, false);
+    } else {
+      writeSector(nullptr);
+    }
+    vTaskDelay(pdMS_TO_TICKS(LATENCY_BENCH_FLASH_PERIOD_MS));
+  }
+}
+
+void latencyBenchNetworkLoad(void* context) {
+  static uint8_t payload[1024];
+  WiFiUDP udp;
+  for (;;) {
+    if (WiFi.status() == WL_CONNECTED) {
+      TraceScope trace(TracePoint::NETWORK_SEND);
+      for (uint8_t i = 0; i < LATENCY_BENCH_UDP_BURST; i++) {
+        udp.beginPacket(IPAddress(255, 255, 255, 255), LATENCY_BENCH_UDP_PORT);
+        udp.write(payload, sizeof(payload));
+        if (udp.endPacket()) {
+          networkPackets++;
+        }
+      }
+    }
+    vTaskDelay(pdMS_TO_TICKS(100));
+  }
+}
+
+void latencyBenchRedraw(TFT_eSPI* tft) {
+  tft->fillScreen((redraws & 1) ? TFT_NAVY : TFT_MAROON);
+  redraws++;
+}
+
+void latencyBenchPrintReport() {
+  Serial.println("Latency benchmark (edge -> time task):");
+  printHistogram("wake", wake);
+  printHistogram("charge", charge);
+  printHistogram("press", press);
+  Serial.printf("  load: %u flash writes (%s), %u UDP packets, %u full redraws\n", (unsigned)flashWrites,
+                LATENCY_BENCH_FLASH_SCHEDULED ? "scheduled" : "direct",
+                (unsigned)networkPackets, (unsigned)redraws);
+}
@@ -0,0 +1,189 @@
+#include "lvgl_port.h"
+#include <Arduino.h>
+#include <driver/gpio.h>
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+#include <soc/gpio_reg.h>
+#include "config.h"
+#include "rotary_decoder.h"
+#include "spi_bus.h"
+#include "touch.h"
+
+static TFT_eSPI* tft = nullptr;
+static lv_disp_draw_buf_t drawBuffer;
+static lv_disp_drv_t displayDriver;
+static lv_indev_drv_t encoderDriver;
+static lv_indev_t* encoderInput = nullptr;
+static RotaryDecoder encoder;
+static lv_indev_drv_t touchDriver;
+
+static LvglPortStats stats;
+static int64_t frameStartUs = 0;
+static int64_t flushedFrameStartUs = 0;   // Start of the frame whose last flush is queued
+
+// LVGL waits for lv_disp_flush_ready() before it flushes again, so one
+// transaction is enough
+static SpiTransaction flushTransaction;
+
+static void flushDone(SpiTransaction* transaction) {
+  bool lastOfFrame = transaction->context != nullptr;
+  lv_disp_flush_ready(&displayDriver);
+  if (!lastOfFrame) {
+    return;
+  }
+
+  uint32_t frameUs = (uint32_t)(esp_timer_get_time() - flushedFrameStartUs);
+  stats.frames++;
+  stats.lastFrameUs = frameUs;
+  stats.totalFrameUs += frameUs;
+  if (frameUs > stats.maxFrameUs) {
+    stats.maxFrameUs = frameUs;
+  }
+}
+
+static void flushDisplay(lv_disp_drv_t* driver, const lv_area_t* area, lv_color_t* pixels) {
+  uint32_t width = area->x2 - area->x1 + 1;
+  uint32_t height = area->y2 - area->y1 + 1;
+
+  // The bus task sends this buffer while LVGL already renders into the other one
+  flushTransaction.device = SpiDevice::DISPLAY;
+  flushTransaction.x = area->x1;
+  flushTransaction.y = area->y1;
+  flushTransaction.width = width;
+  flushTransaction.height = height;
+  flushTransaction.pixels = (const uint16_t*)pixels;
+  flushTransaction.command = nullptr;
+  flushTransaction.done = flushDone;
+  flushTransaction.context = nullptr;
+  if (lv_disp_flush_is_last(driver)) {
+    flushedFrameStartUs = frameStartUs;
+    flushTransaction.context = &flushTransaction;
+  }
+  spiBusSubmit(&flushTransaction);
+
+  stats.flushes++;
+  stats.flushBytes += width * height * sizeof(lv_color_t);
+}
+
+static_assert(ROTARY_PIN_A < 32 && ROTARY_PIN_B < 32, "The encoder interrupt reads GPIO_IN_REG only");
+
+static void IRAM_ATTR onEncoderChange(void* argument) {
+  // One register read for both pins, gpio_get_level() is not in IRAM
+  uint32_t levels = REG_READ(GPIO_IN_REG);
+  encoder.update((levels >> ROTARY_PIN_A) & 1, (levels >> ROTARY_PIN_B) & 1);
+}
+
+static bool startEncoder() {
+  pinMode(ROTARY_PIN_A, INPUT_PULLUP);
+  pinMode(ROTARY_PIN_B, INPUT_PULLUP);
+  encoder.reset(digitalRead(ROTARY_PIN_A) == HIGH, digitalRead(ROTARY_PIN_B) == HIGH);
+
+  esp_err_t result = gpio_install_isr_service(0);
+  if (result != ESP_OK && result != ESP_ERR_INVALID_STATE) {
+    return false;   // INVALID_STATE: already installed by someone else
+  }
+  gpio_set_intr_type((gpio_num_t)ROTARY_PIN_A, GPIO_INTR_ANYEDGE);
+  gpio_set_intr_type((gpio_num_t)ROTARY_PIN_B, GPIO_INTR_ANYEDGE);
+  if (gpio_isr_handler_add((gpio_num_t)ROTARY_PIN_A, onEncoderChange, nullptr) != ESP_OK) {
+    return false;
+  }
+  if (gpio_isr_handler_add((gpio_num_t)ROTARY_PIN_B, onEncoderChange, nullptr) != ESP_OK) {
+    gpio_isr_handler_remove((gpio_num_t)ROTARY_PIN_A);
+    return false;
+  }
+  return true;
+}
+
+static void readEncoder(lv_indev_drv_t* driver, lv_indev_data_t* data) {
+  data->enc_diff = encoder.take();
+
+  data->state = (digitalRead(BUTTON_PIN) == LOW) ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+}
+
+static void readTouch(lv_indev_drv_t* driver, lv_indev_data_t* data) {
+  // Only the filtered position of the touch task, the bus is not touched here
+  TouchPoint point = touchPoint();
+  data->point.x = point.x;
+  data->point.y = point.y;
+  data->state = point.pressed ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+}
+
+bool lvglPortInit(TFT_eSPI* display) {
+  tft = display;
+
+  // Two partial draw buffers in internal RAM, DMA cannot read them from PSRAM fast enough
+  const size_t pixels = (size_t)tft->width() * LVGL_DRAW_BUFFER_LINES;
+  lv_color_t* buffer1 = (lv_color_t*)heap_caps_malloc(pixels * sizeof(lv_color_t),
+                                                      MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+  lv_color_t* buffer2 = (lv_color_t*)heap_caps_malloc(pixels * sizeof(lv_color_t),
+                                                      MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+  if (buffer1 == nullptr || buffer2 == nullptr) {
+    Serial.println("ERROR: LVGL draw buffers could not be allocated!");
+    heap_caps_free(buffer1);
+    heap_caps_free(buffer2);
+    return false;
+  }
+
+  if (!tft->initDMA()) {
+    Serial.println("ERROR: TFT DMA could not be initialized!");
+    heap_caps_free(buffer1);
+    heap_caps_free(buffer2);
+    return false;
+  }
+
+  // Every transition interrupts, no step is lost between two LVGL reads
+  if (!startEncoder()) {
+    Serial.println("ERROR: Encoder interrupt could not be set up!");
+    tft->deInitDMA();
+    heap_caps_free(buffer1);
+    heap_caps_free(buffer2);
+    return false;
+  }
+
+  lv_init();
+  lv_disp_draw_buf_init(&drawBuffer, buffer1, buffer2, pixels);
+
+  lv_disp_drv_init(&displayDriver);
+  displayDriver.hor_res = tft->width();
+  displayDriver.ver_res = tft->height();
+  displayDriver.flush_cb = flushDisplay;
+  displayDriver.draw_buf = &drawBuffer;
+  lv_disp_drv_register(&displayDriver);
+
+  pinMode(BUTTON_PIN, INPUT_PULLUP);
+  lv_indev_drv_init(&encoderDriver);
+  encoderDriver.type = LV_INDEV_TYPE_ENCODER;
+  encoderDriver.read_cb = readEncoder;
+  encoderInput = lv_indev_drv_register(&encoderDriver);
+
+  lv_indev_drv_init(&touchDriver);
+  touchDriver.type = LV_INDEV_TYPE_POINTER;
+  touchDriver.read_cb = readTouch;
+  lv_indev_drv_register(&touchDriver);
+
+  lvglPortResetStats();
+  Serial.printf("LVGL initialized - 2 x %u byte draw buffers\n",
+                (unsigned)(pixels * sizeof(lv_color_t)));
+  return true;
+}
+
+void lvglPortLoop() {
+  frameStartUs = esp_timer_get_time();
+  lv_timer_handler();
+}
+
+void lvglPortSetGroup(lv_group_t* group) {
+  lv_indev_set_group(encoderInput, group);
+}
+
+int16_t lvglPortEncoderSteps() {
+  return encoder.take();
+}
+
+const LvglPortStats& lvglPortStats() {
+  return stats;
+}
+
+void lvglPortResetStats() {
+  memset(&stats, 0, sizeof(stats));
+}
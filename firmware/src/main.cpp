@@ -1,7 +1,43 @@
 #include <Arduino.h>
 #include <TFT_eSPI.h>
+#include <WiFi.h>
+#include <SPIFFS.h>
+#include <esp_timer.h>
+#include <freertos/semphr.h>
+#include <time.h>
 #include "config.h"
 #include "state_machine.h"
+#include "wall_clock.h"
+#include "sntp_client.h"
+#include "ui.h"
+#include "game_record.h"
+#include "game_session.h"
+#include "time_control.h"
+#include "time_engine.h"
+#include "edge_capture.h"
+#include "flag_alarm.h"
+#include "input_engine.h"
+#include "scheduler.h"
+#include "task_topology.h"
+#include "latency_bench.h"
+#include "spi_bus.h"
+#include "touch.h"
+#include "smooth_text.h"
+#include "assets.h"
+#include "shadow_screen.h"
+#include "clock_display.h"
+#include "player_list.h"
+#include "pixels.h"
+#include "checkpoint.h"
+#include "flash_writer.h"
+#include "profiler.h"
+#include "trace.h"
+#include "deadlines.h"
+#include "clock_bus.h"
+#include "alloc_guard.h"
+#include "result_qr.h"
+#include "ota_delta.h"
+#include "boot.h"
 
 // Display-Objekt erstellen
 TFT_eSPI tft = TFT_eSPI();
@@ -9,12 +45,393 @@ TFT_eSPI tft = TFT_eSPI();
 // State Machine
 ChessClockState currentState = ChessClockState::START;
 
-void setup() {
-  // Serial Monitor initialisieren
-  Serial.begin(SERIAL_BAUD_RATE);
-  delay(1000);
-  Serial.println("Chess Clock - Display Test");
+// Uhrzeit für den IDLE-Zustand
+WallClock wallClock;
+time_t lastDisplayedSecond = 0;
+
+// Restzeit beider Spieler, wird nur über Zeitstempel der Flanken geführt
+TimeEngine timeEngine;
+
+// Entprellung und zeitliche Ordnung aller Eingaben
+InputEngine inputEngine;
+
+// Zeit von der Flanke (oder dem Fallblättchen) bis das Ereignis verarbeitet ist
+DeadlineStage eventDeadline = { "clock_event", DEADLINE_EVENT_BUDGET_US };
+bool eventDeadlineAdded = false;   // Nicht angemeldet hat die Stufe keine Bucket-Breite
+
+// Schützt Zustandswechsel zwischen Zeit-Task und Render-Task
+SemaphoreHandle_t stateMutex = nullptr;
+
+// In der Spielerauswahl gewählte Namen
+char whitePlayer[2 * PLAYER_NAME_MAX_LENGTH + 2] = "";
+char blackPlayer[2 * PLAYER_NAME_MAX_LENGTH + 2] = "";
+
+// Partie, die vor einem Reset oder Stromausfall lief
+GameSnapshot resumedGame;
+bool resumeGame = false;
+
+// Zuletzt gezeichneter Zustand, Zeichnen erfolgt nur im Render-Task
+ChessClockState renderedState = ChessClockState::START;
+
+// Button wurde im Ergebnis gedrückt, erst das Loslassen schließt es
+bool resultButtonPressed = false;
+
+void printSchedulerReport();
+
+bool initWiFi() {
+  if (strlen(WIFI_SSID) == 0) {
+    Serial.println("WiFi not configured - wall clock stays unsynced");
+    return true;
+  }
+  WiFi.mode(WIFI_STA);
+  WiFi.begin(WIFI_SSID, WIFI_PASSWORD);  // Verbindet sich im Hintergrund
+  return true;
+}
+
+void showGameResult() {
+  // Der Zeit-Task gibt die Partie beim Verlassen von SAVE_GAME_RESULT frei, nicht während hier gezeichnet wird
+  xSemaphoreTakeRecursive(stateMutex, portMAX_DELAY);
+  const GameRecord* record = currentState == ChessClockState::SAVE_GAME_RESULT ? gameSessionRecord() : nullptr;
+  if (record == nullptr) {
+    xSemaphoreGiveRecursive(stateMutex);
+    return;
+  }
+
+  TFT_eSprite& canvas = shadowScreenCanvas();
+  canvas.fillScreen(TFT_WHITE);
+  canvas.setTextColor(TFT_BLACK, TFT_WHITE);
+  canvas.setTextDatum(MC_DATUM);
+  int32_t textWidth = canvas.width() - canvas.height();
+  canvas.drawString(gameResultToString(record->result), textWidth / 2, canvas.height() / 2, 4);
+  shadowScreenPush();
+
+  // QR-Code rechts, so groß wie das Display hoch ist, direkt über die leere Fläche
+  spiBusAcquire();
+  resultQrShow(&tft, *record, textWidth, 0, tft.height());
+  spiBusRelease();
+  xSemaphoreGiveRecursive(stateMutex);
+}
+
+void showLogo() {
+  // Logo über der Uhrzeit, fehlt das Asset-Paket, bleibt der Platz leer
+  AssetInfo logo;
+  if (assetsFind("logo", &logo)) {
+    assetsDraw("logo", 0, (tft.width() - logo.width) / 2, 10);
+  }
+}
+
+void printInputStats() {
+  InputEngineStats stats = inputEngine.stats();
+  Serial.printf("Input: %u events, %u rocker / %u button bounces ignored\n", (unsigned)stats.accepted,
+                (unsigned)stats.rockerBounces, (unsigned)stats.buttonBounces);
+  Serial.printf("  %u reordered, %u dropped, %u found by reading the pin\n", (unsigned)stats.reordered,
+                (unsigned)stats.overflows, (unsigned)stats.confirmed);
+}
+
+bool isTimeRunning(ChessClockState state) {
+  return state == ChessClockState::WHITE_TIME_RUNNING || state == ChessClockState::BLACK_TIME_RUNNING;
+}
+
+bool isPlayerSelection(ChessClockState state) {
+  return state == ChessClockState::WAIT_FOR_WHITE_PLAYER_SELECTION ||
+         state == ChessClockState::WAIT_FOR_BLACK_PLAYER_SELECTION;
+}
+
+bool isGameRunning(ChessClockState state) {
+  return isTimeRunning(state) || state == ChessClockState::PAUSE;
+}
+
+bool isClockShown(ChessClockState state) {
+  return isGameRunning(state) || state == ChessClockState::WAIT_FOR_WHITE_START;
+}
+
+bool drawsOnShadowScreen(ChessClockState state) {
+  return isClockShown(state) || state == ChessClockState::IDLE || state == ChessClockState::SAVE_GAME_RESULT;
+}
+
+void saveCheckpoint(bool toFlash) {
+  const GameRecord* record = gameSessionRecord();
+  int64_t nowUs = esp_timer_get_time();
+  GameSnapshot snapshot;
+  snapshot.state = (uint8_t)currentState;
+  snapshot.activeSide = (uint8_t)timeEngine.activeSide();
+  snapshot.timeControl = record != nullptr ? record->timeControl : uiSelectedTimeControl();
+  snapshot.plies = record != nullptr ? record->plyCount : 0;
+  snapshot.whiteMs = (uint32_t)(timeEngine.remainingUs(Side::WHITE, nowUs) / 1000);
+  snapshot.blackMs = (uint32_t)(timeEngine.remainingUs(Side::BLACK, nowUs) / 1000);
+  checkpointSave(snapshot, toFlash);
+}
+
+// Zustandswechsel und Züge an die Abonnenten verteilen, deren Handler laufen in ihren eigenen Tasks
+void publishClockEvent(ClockTopic topic, ChessClockState previous, uint32_t moveMs, int64_t timestampUs) {
+  ClockBusEvent* event = clockBus.claim();
+  if (event == nullptr) {
+    return;   // Kann bei ausreichend großem Pool nicht passieren, clockBusStart() prüft das, der Pool zählt es
+  }
+  int64_t nowUs = esp_timer_get_time();
+  event->topic = topic;
+  event->state = currentState;
+  event->previous = previous;
+  event->side = timeEngine.activeSide() == Side::WHITE ? Side::BLACK : Side::WHITE;
+  event->moveMs = moveMs;
+  event->whiteMs = (uint32_t)(timeEngine.remainingUs(Side::WHITE, nowUs) / 1000);
+  event->blackMs = (uint32_t)(timeEngine.remainingUs(Side::BLACK, nowUs) / 1000);
+  event->timestampUs = timestampUs;
+  clockBus.publish(event, topic);
+}
+
+void changeState(ChessClockState next) {
+  xSemaphoreTakeRecursive(stateMutex, portMAX_DELAY);
+  ChessClockState previous = currentState;
+  traceInstant(TracePoint::STATE, (uint8_t)next);
+
+  // Während eine Zeit läuft, darf nichts auf dem Heap angelegt werden
+  allocGuardSetArmed(false);
+
+  if (currentState == ChessClockState::ENTER_PLAYER_NAME && next == ChessClockState::MAIN_MENU) {
+    Serial.printf("Player saved: %s %s\n", uiPlayerFirstName(), uiPlayerLastName());
+  }
+  if (currentState == ChessClockState::SAVE_GAME_RESULT) {
+    gameSessionEnd();   // Speicher der Partie auf einmal freigeben
+  }
+  if (next == ChessClockState::SAVE_GAME_RESULT) {
+    resultButtonPressed = false;   // Ein Button, der beim Ablauf gedrückt war, zählt nicht
+  }
+  if (next == ChessClockState::WAIT_FOR_WHITE_START) {
+    const TimeControl& timeControl = TIME_CONTROLS[uiSelectedTimeControl()];
+    timeEngine.reset(timeControl.baseSeconds * 1000, timeControl.incrementSeconds * 1000);
+    edgeCaptureResetStats();
+    flagAlarmResetStats();
+    inputEngine.reset(ROCKER_DEBOUNCE_MS * 1000, BUTTON_DEBOUNCE_MS * 1000, INPUT_RESOLVE_WINDOW_US);
+    if (gameSessionBegin(uiSelectedTimeControl())) {
+      GameRecord* record = gameSessionRecord();
+      strlcpy(record->whiteName, whitePlayer, sizeof(record->whiteName));
+      strlcpy(record->blackName, blackPlayer, sizeof(record->blackName));
+    } else {
+      Serial.println("ERROR: Could not start game session!");
+    }
+  }
+  currentState = next;
+  flashWriterSetGame(isTimeRunning(next), timeEngine.expiryUs());
+  otaDeltaSetAllowed(next == ChessClockState::IDLE);   // Ein laufendes Update bricht beim nächsten Block ab
+
+  // Jeder Druck landet sofort im RTC-Speicher, nach dem Ende wird die Partie vergessen
+  if (isGameRunning(next)) {
+    saveCheckpoint(true);
+  } else if (isGameRunning(previous)) {
+    checkpointClear();
+  }
+
+  // Alarm auf den Zeitpunkt legen, an dem die laufende Zeit abläuft
+  if (isTimeRunning(next)) {
+    flagAlarmArm(timeEngine.expiryUs());
+  } else {
+    flagAlarmCancel();
+  }
+  allocGuardSetArmed(isTimeRunning(next));
+
+  publishClockEvent(TOPIC_STATE, previous, 0, esp_timer_get_time());
+  xSemaphoreGiveRecursive(stateMutex);
+}
+
+void flagFall() {
+  GameRecord* record = gameSessionRecord();
+  if (record != nullptr) {
+    gameRecordSetResult(*record, timeEngine.activeSide() == Side::WHITE ? GameResult::BLACK_WINS
+                                                                        : GameResult::WHITE_WINS);
+  }
+  changeState(ChessClockState::SAVE_GAME_RESULT);
+}
+
+void handleClockEvent(const ClockEvent& event) {
+  // Alles, was nach dem Ablauf der Zeit passiert ist, zählt nicht mehr
+  if (isTimeRunning(currentState) && event.timestampUs >= timeEngine.expiryUs()) {
+    flagFall();
+    return;
+  }
+
+  switch (currentState) {
+    case ChessClockState::WAIT_FOR_WHITE_START:
+      // Wippe auf der weißen Seite hoch: Weiß beginnt
+      if (event.type == ClockEventType::ROCKER_WHITE) {
+        timeEngine.start(Side::WHITE, event.timestampUs);
+        changeState(ChessClockState::WHITE_TIME_RUNNING);
+        flashWriterPressed(event.timestampUs);
+      }
+      break;
 
+    case ChessClockState::WHITE_TIME_RUNNING:
+    case ChessClockState::BLACK_TIME_RUNNING: {
+      bool whiteMoves = currentState == ChessClockState::WHITE_TIME_RUNNING;
+      ClockEventType moveDone = whiteMoves ? ClockEventType::ROCKER_BLACK : ClockEventType::ROCKER_WHITE;
+      if (event.type == moveDone) {
+        uint32_t moveMs = timeEngine.press(event.timestampUs);
+        GameRecord* record = gameSessionRecord();
+        if (record != nullptr) {
+          gameRecordAddMove(*record, moveMs);
+        }
+        ChessClockState beforeMove = currentState;
+        changeState(whiteMoves ? ChessClockState::BLACK_TIME_RUNNING : ChessClockState::WHITE_TIME_RUNNING);
+        publishClockEvent(TOPIC_MOVE, beforeMove, moveMs, event.timestampUs);
+        // Direkt nach dem Zug ist Zeit für aufgeschobene Flash-Schreibvorgänge
+        flashWriterPressed(event.timestampUs);
+      } else if (event.type == ClockEventType::BUTTON_PRESSED) {
+        timeEngine.pause(event.timestampUs);
+        changeState(ChessClockState::PAUSE);
+      }
+      break;
+    }
+
+    case ChessClockState::PAUSE:
+      if (event.type == ClockEventType::BUTTON_PRESSED) {
+        timeEngine.resume(event.timestampUs);
+        changeState(timeEngine.activeSide() == Side::WHITE ? ChessClockState::WHITE_TIME_RUNNING
+                                                           : ChessClockState::BLACK_TIME_RUNNING);
+      }
+      break;
+
+    case ChessClockState::SAVE_GAME_RESULT:
+      // Ergebnis gespeichert: Drücken und Loslassen führt ins Hauptmenü, erst beim
+      // Loslassen, sonst sieht LVGL den Klick dort
+      if (event.type == ClockEventType::BUTTON_PRESSED) {
+        resultButtonPressed = true;
+      } else if (event.type == ClockEventType::BUTTON_RELEASED && resultButtonPressed) {
+        changeState(ChessClockState::MAIN_MENU);
+      }
+      break;
+
+    default:
+      break;   // In den Menüs kümmern sich handleIdleInput() und LVGL um den Button
+  }
+}
+
+void handleTouchGesture(const ClockEvent& event) {
+  TouchGestureType gesture = (TouchGestureType)event.value;
+  switch (currentState) {
+    case ChessClockState::IDLE:
+      // Antippen wirkt wie der Button
+      if (gesture == TouchGestureType::TAP) {
+        changeState(ChessClockState::MAIN_MENU);
+      }
+      break;
+
+    case ChessClockState::WAIT_FOR_MODE_SELECTION:
+    case ChessClockState::ENTER_PLAYER_NAME:
+    case ChessClockState::WAIT_FOR_WHITE_PLAYER_SELECTION:
+    case ChessClockState::WAIT_FOR_BLACK_PLAYER_SELECTION:
+      // Nach rechts wischen: zurück ins Hauptmenü
+      if (gesture == TouchGestureType::SWIPE_RIGHT) {
+        changeState(ChessClockState::MAIN_MENU);
+      }
+      break;
+
+    case ChessClockState::SAVE_GAME_RESULT:
+      // Lang drücken schließt das Ergebnis, damit es nicht versehentlich verschwindet
+      // (Button und Drehgeber führen stattdessen ins Hauptmenü)
+      if (gesture == TouchGestureType::LONG_PRESS) {
+        changeState(ChessClockState::IDLE);
+      }
+      break;
+
+    default:
+      break;   // Während einer Partie zählen nur Wippe und Button
+  }
+}
+
+void handleClockEvents() {
+  // Bis zum nächsten Ereignis schlafen, aber aufwachen, wenn ein wartendes fällig wird
+  int64_t dueUs = inputEngine.nextDueUs();
+  int64_t checkUs = inputEngine.nextCheckUs();
+  if (checkUs < dueUs) {
+    dueUs = checkUs;
+  }
+  uint32_t timeoutMs = CLOCK_EVENT_WAIT_FOREVER;
+  if (dueUs != INT64_MAX) {
+    int64_t waitUs = dueUs - esp_timer_get_time();
+    timeoutMs = waitUs > 0 ? (uint32_t)((waitUs + 999) / 1000) : 0;
+  }
+
+  ClockEvent* event = clockEventWait(timeoutMs);
+  while (event != nullptr) {
+    if (LATENCY_BENCHMARK) {
+      latencyBenchRecordWake(*event);
+    }
+    inputEngine.push(event);
+    event = clockEventNext();
+  }
+
+  // Nach der Sperrzeit den Pegel nachlesen, ein kurzer Tipp darin geht sonst verloren
+  int64_t nowUs = esp_timer_get_time();
+  if (inputEngine.nextCheckUs() <= nowUs) {
+    inputEngine.check(nowUs, digitalRead(ROCKER_PIN) == HIGH, digitalRead(BUTTON_PIN) == HIGH);
+  }
+
+  // Die Zeit wird über die Zeitstempel abgerechnet, die kurze Wartezeit kostet nichts
+  while ((event = inputEngine.pop(esp_timer_get_time())) != nullptr) {
+    xSemaphoreTakeRecursive(stateMutex, portMAX_DELAY);
+    traceInstant(TracePoint::EVENT, (uint8_t)event->type);
+    if (event->type == ClockEventType::TOUCH_GESTURE) {
+      handleTouchGesture(*event);
+    } else {
+      handleClockEvent(*event);
+    }
+    xSemaphoreGiveRecursive(stateMutex);
+    if (LATENCY_BENCHMARK) {
+      latencyBenchRecordCharge(*event);
+    }
+    if (event->type != ClockEventType::LATENCY_PROBE) {
+      int64_t handledUs = esp_timer_get_time();
+      traceCheckLatency((uint32_t)(handledUs - event->timestampUs));
+      if (DEADLINE_MONITOR && eventDeadlineAdded) {
+        // Ab der Freigabe messen, die feste Sperrzeit zur Sortierung zählt nicht zum Budget
+        int64_t releaseUs = event->timestampUs;
+        if (event->type != ClockEventType::FLAG_FALL) {
+          releaseUs += INPUT_RESOLVE_WINDOW_US;
+        }
+        uint32_t lateUs = handledUs > releaseUs ? (uint32_t)(handledUs - releaseUs) : 0;
+        deadlineMonitor.record(&eventDeadline, releaseUs, lateUs);
+      }
+    }
+    clockEventPool.release(event);
+  }
+}
+
+void handleIdleInput() {
+  static bool buttonWasPressed = false;
+  bool buttonPressed = digitalRead(BUTTON_PIN) == LOW;
+
+  // Erst beim Loslassen wechseln, sonst sieht LVGL den Klick im Hauptmenü
+  if (buttonWasPressed && !buttonPressed) {
+    changeState(ChessClockState::MAIN_MENU);
+  }
+  buttonWasPressed = buttonPressed;
+}
+
+void updateIdleDisplay() {
+  if (!wallClock.isSynced()) {
+    return;
+  }
+
+  time_t now = (time_t)(wallClock.toUnixUs(esp_timer_get_time()) / 1000000LL);
+  if (now == lastDisplayedSecond) {
+    return;   // Nur bei Änderung zeichnen
+  }
+  lastDisplayedSecond = now;
+
+  struct tm local;
+  localtime_r(&now, &local);
+  char buffer[16];
+  snprintf(buffer, sizeof(buffer), "%02d:%02d:%02d", local.tm_hour, local.tm_min, local.tm_sec);
+
+  // Nur die Kacheln der geänderten Ziffern werden gesendet
+  TFT_eSprite& canvas = shadowScreenCanvas();
+  canvas.setTextColor(TFT_WHITE, TFT_BLACK);
+  canvas.setTextDatum(MC_DATUM);
+  canvas.drawString(buffer, canvas.width() / 2, canvas.height() / 2 + 40, 4);
+  shadowScreenPush();
+}
+
+bool initDisplay() {
   // Backlight-Pin konfigurieren und aktivieren
   pinMode(TFT_BACKLIGHT_PIN, OUTPUT);
   digitalWrite(TFT_BACKLIGHT_PIN, HIGH);
@@ -35,14 +452,592 @@ void setup() {
   tft.drawString("Hello Vincenzo!", tft.width() / 2, tft.height() / 2, 2);
   
   Serial.println("Display initialized - Hello World displayed");
-  
+
+  // Ab jetzt laufen alle Transfers auf dem SPI-Bus über den Bus-Task
+  return spiBusInit(&tft);
+}
+
+bool initShadowScreen() {
+  // Bildschirme außerhalb der Menüs werden im PSRAM gezeichnet und nur geändert gesendet
+  clockDisplayInit();
+  return shadowScreenInit(&tft);
+}
+
+bool initPixels() {
+  // Vektor-Kernel für Füllen und Überblenden nur, wenn sie bitgenau rechnen
+  return pixelsInit();
+}
+
+bool initUi() {
+  // LVGL für die Menüs initialisieren, initDMA() konfiguriert den SPI-Bus um
+  pinMode(BUTTON_PIN, INPUT_PULLUP);
+  spiBusAcquire();
+  bool ok = uiInit(&tft, changeState);
+  spiBusRelease();
+  return ok;
+}
+
+bool initTouch() {
+  // Touch-Controller nur nach dem Pen-Interrupt abfragen
+  return touchInit(&tft, tft.width(), tft.height());
+}
+
+bool initFilesystem() {
+  // SPIFFS mit Schrift und Bildern (pio run -t uploadfs)
+  if (!SPIFFS.begin(false)) {
+    Serial.println("WARNING: SPIFFS not mounted - no smooth font and no images");
+    return false;
+  }
+  return true;
+}
+
+bool initFonts() {
+  // Kantengeglättete Schrift für Spielernamen, Glyphen werden im PSRAM gecacht
+  return smoothTextInit(tft.width());
+}
+
+bool initPlayers() {
+  // Vereinsliste für die Spielerauswahl, nur die Zeilenanfänge werden indiziert
+  return playerListInit(&tft);
+}
+
+bool initAssets() {
+  // Komprimierte Bilder werden beim Zeichnen bandweise entpackt
+  return assetsInit();
+}
+
+bool initEdgeCapture() {
+  // Wippe und Button mit Hardware-Zeitstempeln erfassen
+  pinMode(ROCKER_PIN, INPUT_PULLUP);
+  inputEngine.reset(ROCKER_DEBOUNCE_MS * 1000, BUTTON_DEBOUNCE_MS * 1000, INPUT_RESOLVE_WINDOW_US);
+  return edgeCaptureInit();
+}
+
+bool initFlagAlarm() {
+  // Einmal-Timer für den exakten Ablauf der Bedenkzeit
+  return flagAlarmInit();
+}
+
+bool initWallClock() {
+  // Zeitzone setzen und SNTP starten
+  setenv("TZ", TIMEZONE, 1);
+  tzset();
+  sntpClientBegin(&wallClock);
+  return true;
+}
+
+// Init-Graph: unabhängige Phasen laufen parallel auf beiden Kernen
+enum BootPhaseIndex {
+  BOOT_DISPLAY,
+  BOOT_UI,
+  BOOT_SHADOW_SCREEN,
+  BOOT_PIXELS,
+  BOOT_TOUCH,
+  BOOT_FILESYSTEM,
+  BOOT_FONTS,
+  BOOT_ASSETS,
+  BOOT_PLAYERS,
+  BOOT_EDGE_CAPTURE,
+  BOOT_FLAG_ALARM,
+  BOOT_WALL_CLOCK,
+  BOOT_WIFI,
+  BOOT_PHASE_COUNT
+};
+
+const BootPhase BOOT_PHASES[BOOT_PHASE_COUNT] = {
+  // name           init             core  dependsOn                  required  stack
+  { "display",      initDisplay,     1,    0,                         true,     4096 },
+  { "ui",           initUi,          1,    BOOT_AFTER(BOOT_DISPLAY),  true,     8192 },
+  { "shadow",       initShadowScreen, 1,    BOOT_AFTER(BOOT_DISPLAY),  true,     4096 },
+  { "pixels",       initPixels,      1,    0,                         false,    4096 },
+  { "touch",        initTouch,       1,    BOOT_AFTER(BOOT_DISPLAY),  false,    4096 },
+  { "filesystem",   initFilesystem,  0,    0,                         false,    4096 },
+  { "fonts",        initFonts,       0,    BOOT_AFTER(BOOT_DISPLAY) | BOOT_AFTER(BOOT_FILESYSTEM), false, 4096 },
+  { "assets",       initAssets,      0,    BOOT_AFTER(BOOT_FILESYSTEM), false,  4096 },
+  { "players",      initPlayers,     0,    BOOT_AFTER(BOOT_FONTS),    false,    4096 },
+  { "edge_capture", initEdgeCapture, 1,    BOOT_AFTER(BOOT_UI),       true,     4096 },
+  { "flag_alarm",   initFlagAlarm,   1,    0,                         true,     4096 },
+  { "wall_clock",   initWallClock,   0,    0,                         true,     4096 },
+  { "wifi",         initWiFi,        0,    0,                         false,    4096 },
+};
+
+// Periodische Aufgaben des Render- und des Netzwerk-Tasks
+Scheduler renderScheduler;
+Scheduler networkScheduler;
+
+int64_t schedulerNow() {
+  return esp_timer_get_time();
+}
+
+void runSntpJob(void*) {
+  // WiFiUDP legt beim Empfang Puffer an, daher kein SNTP während eine Zeit läuft
+  if (!isTimeRunning(currentState)) {
+    sntpClientLoop();
+  }
+}
+
+void runIdleJob(void*) {
+  if (currentState == ChessClockState::IDLE) {
+    handleIdleInput();
+    updateIdleDisplay();
+  }
+}
+
+void selectPlayer() {
+  bool white = currentState == ChessClockState::WAIT_FOR_WHITE_PLAYER_SELECTION;
+  char* name = white ? whitePlayer : blackPlayer;
+  if (!playerListSelectedName(name, sizeof(whitePlayer))) {
+    name[0] = '\0';   // Ohne Vereinsliste bleibt der Name leer
+  }
+  changeState(white ? ChessClockState::WAIT_FOR_BLACK_PLAYER_SELECTION : ChessClockState::WAIT_FOR_WHITE_START);
+}
+
+bool playerListButtonWasPressed = false;
+
+void runPlayerListJob(void*) {
+  if (!isPlayerSelection(currentState)) {
+    return;
+  }
+
+  // Drehgeber blättert, Loslassen des Buttons wählt den Spieler
+  playerListScroll(uiEncoderSteps());
+  bool buttonPressed = digitalRead(BUTTON_PIN) == LOW;
+  if (playerListButtonWasPressed && !buttonPressed) {
+    selectPlayer();
+  }
+  playerListButtonWasPressed = buttonPressed;
+}
+
+void runResultJob(void*) {
+  // Drehen am Drehgeber schließt das Ergebnis wie der Button
+  if (uiEncoderSteps() != 0) {
+    changeState(ChessClockState::MAIN_MENU);
+  }
+}
+
+void runUiJob(void*) {
+  if (uiHandlesState(currentState)) {
+    uiLoop();
+  }
+}
+
+void runCheckpointJob(void*) {
+  // Laufende Zeit regelmäßig in den RTC-Speicher, der Flash wird nur bei Zügen beschrieben
+  xSemaphoreTakeRecursive(stateMutex, portMAX_DELAY);
+  if (isTimeRunning(currentState)) {
+    saveCheckpoint(false);
+  }
+  xSemaphoreGiveRecursive(stateMutex);
+}
+
+void runBenchRedrawJob(void*) {
+  // Volle Bildschirme außerhalb der Menüs, damit eine Partie noch gestartet werden kann
+  if (!uiHandlesState(currentState)) {
+    spiBusAcquire();
+    latencyBenchRedraw(&tft);
+    spiBusRelease();
+    shadowScreenInvalidate();
+  }
+}
+
+void runBenchReportJob(void*) {
+  latencyBenchPrintReport();
+  clockDisplayPrintStats();
+  if (DEADLINE_MONITOR) {
+    deadlinesPrintReport();
+  }
+}
+
+void runTraceDumpJob(void*) {
+  traceDumpIfTriggered();
+}
+
+void runDeadlinesJob(void*) {
+  deadlinesCheckAlarms();
+}
+
+void runClockJob(void*);
+void runOtaCheckJob(void*);
+void runBootReportJob(void*);
+
+enum RenderJobIndex {
+  JOB_IDLE,
+  JOB_UI,
+  JOB_PLAYER_LIST,
+  JOB_RESULT,
+  JOB_BOOT_REPORT,
+  JOB_CHECKPOINT,
+  JOB_CLOCK,
+#if TRACE_ENABLED
+  JOB_TRACE_DUMP,
+#endif
+#if DEADLINE_MONITOR
+  JOB_DEADLINES,
+#endif
+#if LATENCY_BENCHMARK
+  JOB_BENCH_REDRAW,
+  JOB_BENCH_REPORT,
+#endif
+  RENDER_JOB_COUNT
+};
+
+SchedulerJob renderJobs[RENDER_JOB_COUNT] = {
+  // name           run                context  period  tolerance  budget us
+  { "idle",         runIdleJob,        nullptr, 20,     20,        2000 },
+  { "ui",           runUiJob,          nullptr, 5,      10,        10000 },
+  { "player_list",  runPlayerListJob,  nullptr, 20,     20,        5000 },
+  { "result",       runResultJob,      nullptr, 50,     50,        0 },
+  { "boot_report",  runBootReportJob,  nullptr, 50,     1000,      0 },
+  { "checkpoint",   runCheckpointJob,  nullptr, CHECKPOINT_REFRESH_MS, 50, 5000 },
+  { "clock",        runClockJob,       nullptr, 0,      2,         8000 },
+#if TRACE_ENABLED
+  { "trace_dump",   runTraceDumpJob,   nullptr, 100,    1000,      0 },
+#endif
+#if DEADLINE_MONITOR
+  { "deadlines",    runDeadlinesJob,   nullptr, 100,    1000,      0 },
+#endif
+#if LATENCY_BENCHMARK
+  { "bench_redraw", runBenchRedrawJob, nullptr, 40,     40,        0 },
+  { "bench_report", runBenchReportJob, nullptr, LATENCY_BENCH_REPORT_S * 1000, 1000, 0 },
+#endif
+};
+
+enum NetworkJobIndex {
+  JOB_SNTP,
+  JOB_OTA_CHECK,
+  NETWORK_JOB_COUNT
+};
+
+SchedulerJob networkJobs[NETWORK_JOB_COUNT] = {
+  // name           run                context  period  tolerance  budget us
+  { "sntp",         runSntpJob,        nullptr, 10,     50,        5000 },
+  { "ota_check",    runOtaCheckJob,    nullptr, 1000,   1000,      0 },
+};
+
+void runClockJob(void*) {
+  // Restzeiten nur zeichnen, wenn sich eine angezeigte Ziffer ändert, danach bis dahin schlafen
+  xSemaphoreTakeRecursive(stateMutex, portMAX_DELAY);
+  ChessClockState state = currentState;
+  TimeEngine engine = timeEngine;
+  xSemaphoreGiveRecursive(stateMutex);
+  if (!isClockShown(state) || state != renderedState) {
+    return;   // Der Zustandswechsel plant die Uhr neu ein
+  }
+
+  const char* banner = state == ChessClockState::PAUSE                  ? "PAUSE"
+                       : state == ChessClockState::WAIT_FOR_WHITE_START ? "Press to start"
+                                                                         : nullptr;
+  int64_t nowUs = esp_timer_get_time();
+  int64_t nextUs = clockDisplayRun(engine, whitePlayer, blackPlayer, banner, nowUs);
+  if (nextUs != INT64_MAX) {
+    renderScheduler.add(&renderJobs[JOB_CLOCK], (uint32_t)((nextUs - nowUs + 999) / 1000));
+  }
+}
+
+void runOtaCheckJob(void*) {
+  // Einmal nach dem Verbinden im IDLE-Zustand nach einem OTA-Patch für diesen Build suchen
+  if (currentState == ChessClockState::IDLE && WiFi.status() == WL_CONNECTED) {
+    networkScheduler.cancel(&networkJobs[JOB_OTA_CHECK]);
+    otaDeltaCheckForUpdate();
+  }
+}
+
+void runBootReportJob(void*) {
+  // Boot-Report ausgeben, sobald auch die Hintergrund-Phasen fertig sind
+  if (bootFinished()) {
+    renderScheduler.cancel(&renderJobs[JOB_BOOT_REPORT]);
+    bootPrintReport();
+    taskTopologyPrintReport();
+  }
+}
+
+void printJobs(const SchedulerJob* jobs, uint8_t count) {
+  for (uint8_t i = 0; i < count; i++) {
+    const SchedulerJob& job = jobs[i];
+    Serial.printf("  %-12s %8u %8u %8u %8u %6u\n", job.name, (unsigned)job.runs,
+                  job.runs > 0 ? (unsigned)(job.totalRunUs / job.runs) : 0, (unsigned)job.maxRunUs,
+                  (unsigned)job.maxLateUs, (unsigned)job.misses);
+  }
+}
+
+void printSchedulerReport() {
+  Serial.println("Scheduler report:");
+  Serial.printf("  %-12s %8s %8s %8s %8s %6s\n", "job", "runs", "avg us", "max us", "late us", "misses");
+  printJobs(renderJobs, RENDER_JOB_COUNT);
+  printJobs(networkJobs, NETWORK_JOB_COUNT);
+}
+
+// Jobs eines Bildschirms sind nur eingeplant, solange er gezeigt wird, damit der
+// Render-Task während einer Partie bis zur nächsten Ziffer schläft
+void scheduleScreenJob(uint8_t index, bool shown) {
+  SchedulerJob* job = &renderJobs[index];
+  if (!shown) {
+    renderScheduler.cancel(job);
+  } else if (!Scheduler::isScheduled(job)) {
+    renderScheduler.add(job, 0);   // Periodische Jobs behalten ihre Phase
+  }
+}
+
+bool isScreenJob(uint8_t index) {
+  return index == JOB_IDLE || index == JOB_UI || index == JOB_PLAYER_LIST || index == JOB_RESULT ||
+         index == JOB_CHECKPOINT;
+}
+
+void scheduleScreenJobs(ChessClockState state) {
+  if (isPlayerSelection(state) && !Scheduler::isScheduled(&renderJobs[JOB_PLAYER_LIST])) {
+    playerListButtonWasPressed = false;
+  }
+  if (state == ChessClockState::SAVE_GAME_RESULT) {
+    uiEncoderSteps();   // Drehungen während der Partie verwerfen
+  }
+  scheduleScreenJob(JOB_IDLE, state == ChessClockState::IDLE);
+  scheduleScreenJob(JOB_UI, uiHandlesState(state));
+  scheduleScreenJob(JOB_PLAYER_LIST, isPlayerSelection(state));
+  scheduleScreenJob(JOB_RESULT, state == ChessClockState::SAVE_GAME_RESULT);
+  scheduleScreenJob(JOB_CHECKPOINT, isTimeRunning(state));
+}
+
+// Zeichnet einen neuen Zustand, Zustandswechsel selbst zeichnen nicht
+void renderStateChange() {
+  ChessClockState state = currentState;
+  if (state == renderedState) {
+    return;
+  }
+  ChessClockState previous = renderedState;
+  renderedState = state;
+  TraceScope trace(TracePoint::RENDER_STATE, (uint8_t)state);
+  scheduleScreenJobs(state);
+  playerListHide();   // Hardware-Scrolling zurücksetzen, bevor etwas anderes gezeichnet wird
+  uiShowState(state);
+
+  // Menüs und Spielerliste haben den ganzen Bildschirm direkt überschrieben
+  if (!drawsOnShadowScreen(previous)) {
+    shadowScreenInvalidate();
+  }
+
+  if (isClockShown(state)) {
+    clockDisplayInvalidate();
+    renderScheduler.add(&renderJobs[JOB_CLOCK], 0);
+  }
+
+  if (isPlayerSelection(state)) {
+    playerListShow(state == ChessClockState::WAIT_FOR_WHITE_PLAYER_SELECTION ? "White" : "Black");
+  }
+
+  if (state == ChessClockState::IDLE) {
+    shadowScreenCanvas().fillScreen(TFT_BLACK);
+    shadowScreenPush();
+    lastDisplayedSecond = 0;
+    showLogo();
+  }
+
+  if (state == ChessClockState::SAVE_GAME_RESULT) {
+    showGameResult();
+    edgeCapturePrintStats();
+    flagAlarmPrintStats();
+    printInputStats();
+    printSchedulerReport();
+    if (DEADLINE_MONITOR) {
+      deadlinesPrintReport();
+    }
+    taskTopologyPrintReport();
+    spiBusPrintStats();
+    touchPrintStats();
+    smoothTextPrintStats();
+    assetsPrintStats();
+    shadowScreenPrintStats();
+    playerListPrintStats();
+    checkpointPrintStats();
+    flashWriterPrintStats();
+    clockDisplayPrintStats();
+    clockBusPrintStats();
+  }
+}
+
+// Abonnent im Render-Task: neuen Zustand sofort zeichnen. Gezeichnet wird der aktuelle Zustand,
+// ein wegen voller Inbox verworfenes Ereignis holt das nächste wartende nach
+void onRenderClockEvent(const ClockBusEvent&) {
+  renderStateChange();
+}
+
+// Abonnent im Netzwerk-Task: Zustände und Züge protokollieren, ohne den Zeit-Task aufzuhalten
+void onLogClockEvent(const ClockBusEvent& event) {
+  if (event.topic == TOPIC_STATE) {
+    Serial.printf("State: %s -> %s\n", stateToString(event.previous), stateToString(event.state));
+  } else {
+    Serial.printf("Move: %s %u ms (white %u ms, black %u ms left)\n", event.side == Side::WHITE ? "white" : "black",
+                  (unsigned)event.moveMs, (unsigned)event.whiteMs, (unsigned)event.blackMs);
+  }
+}
+
+// Task-Topologie: Eingaben und Zeit allein auf Kern 1, alles andere auf Kern 0
+enum TaskIndex {
+  TASK_TIME,
+  TASK_SPI_BUS,
+  TASK_TOUCH,
+  TASK_RENDER,
+  TASK_NETWORK,
+  TASK_FLASH_WRITER,
+#if PROFILER_ENABLED
+  TASK_PROFILER,
+#endif
+#if LATENCY_BENCHMARK
+  TASK_BENCH_FLASH,
+  TASK_BENCH_NETWORK,
+#endif
+  TASK_COUNT
+};
+
+void runTimeTask(void*) {
+  // Allocation Guard überwacht Zeit-, Render-, Bus- und Touch-Task (nur im allocguard-Build aktiv)
+  allocGuardWatchCurrentTask();
+  for (;;) {
+    handleClockEvents();
+  }
+}
+
+// Schläft bis zum nächsten fälligen Job, ohne Jobs bis zur nächsten Benachrichtigung
+void sleepUntilDue(const Scheduler& scheduler) {
+  uint32_t waitMs = scheduler.nextDueMs();
+  ulTaskNotifyTake(pdTRUE, waitMs == UINT32_MAX ? portMAX_DELAY : pdMS_TO_TICKS(waitMs));
+}
+
+void runRenderTask(void*) {
+  allocGuardWatchCurrentTask();
+  renderScheduler.begin(schedulerNow);
+  if (DEADLINE_MONITOR) {
+    renderScheduler.setMonitor(&deadlineMonitor);
+  }
+  for (uint8_t i = 0; i < RENDER_JOB_COUNT; i++) {
+    if (i != JOB_CLOCK && !isScreenJob(i)) {
+      renderScheduler.add(&renderJobs[i], 0);   // Die anderen plant renderStateChange() ein
+    }
+  }
+  renderStateChange();   // Zustand vom Start, danach zeichnen nur noch Ereignisse vom Bus
+  for (;;) {
+    clockBusDrain(TASK_RENDER);
+    renderScheduler.run();
+    sleepUntilDue(renderScheduler);   // Oder bis ein Zustandswechsel über den Bus kommt
+  }
+}
+
+void runNetworkTask(void*) {
+  networkScheduler.begin(schedulerNow);
+  if (DEADLINE_MONITOR) {
+    networkScheduler.setMonitor(&deadlineMonitor);
+  }
+  for (uint8_t i = 0; i < NETWORK_JOB_COUNT; i++) {
+    networkScheduler.add(&networkJobs[i], 0);
+  }
+  for (;;) {
+    clockBusDrain(TASK_NETWORK);
+    networkScheduler.run();
+    sleepUntilDue(networkScheduler);   // Oder bis ein Ereignis über den Bus kommt
+  }
+}
+
+const TaskSpec TASKS[TASK_COUNT] = {
+  // name            run                       core  priority  stack
+  { "time",          runTimeTask,              1,    20,       4096 },
+  { "spi_bus",       spiBusTask,               0,    4,        4096 },
+  { "touch",         touchTask,                0,    5,        4096 },
+  { "render",        runRenderTask,            0,    3,        8192 },
+  { "network",       runNetworkTask,           0,    2,        8192 },
+  { "flash_writer",  flashWriterTask,          0,    1,        4096 },
+#if PROFILER_ENABLED
+  { "profiler",      profilerTask,             0,    1,        4096 },
+#endif
+#if LATENCY_BENCHMARK
+  { "bench_flash",   latencyBenchFlashLoad,    0,    2,        4096 },
+  { "bench_network", latencyBenchNetworkLoad,  0,    2,        4096 },
+#endif
+};
+
+// Module, die auf die Uhr reagieren, abonnieren hier statt aus der State Machine aufgerufen zu werden
+const ClockBus::Subscriber BUS_SUBSCRIBERS[] = {
+  // name       topics                    handle              task
+  { "render",   TOPIC_STATE,              onRenderClockEvent, TASK_RENDER },
+  { "log",      TOPIC_STATE | TOPIC_MOVE, onLogClockEvent,    TASK_NETWORK },
+};
+
+void restoreGame() {
+  // Unterbrochene Partie pausiert fortsetzen, die Spieler starten sie mit dem Button
+  uint8_t index = resumedGame.timeControl < TIME_CONTROL_COUNT ? resumedGame.timeControl : 0;
+  const TimeControl& timeControl = TIME_CONTROLS[index];
+  timeEngine.restore(resumedGame.whiteMs, resumedGame.blackMs, timeControl.incrementSeconds * 1000,
+                     resumedGame.activeSide == 0 ? Side::WHITE : Side::BLACK);
+  inputEngine.reset(ROCKER_DEBOUNCE_MS * 1000, BUTTON_DEBOUNCE_MS * 1000, INPUT_RESOLVE_WINDOW_US);
+
+  // Die Zeiten der bisherigen Züge sind verloren, nur ihre Anzahl bleibt
+  if (gameSessionBegin(index)) {
+    GameRecord* record = gameSessionRecord();
+    for (uint16_t i = 0; i < resumedGame.plies; i++) {
+      gameRecordAddMove(*record, 0);
+    }
+  }
+  changeState(ChessClockState::PAUSE);
+  checkpointResumed();
+
+  Serial.printf("Game resumed after %u plies: white %u ms, black %u ms\n", (unsigned)resumedGame.plies,
+                (unsigned)resumedGame.whiteMs, (unsigned)resumedGame.blackMs);
+}
+
+void setup() {
+  // Serial Monitor initialisieren (ohne Warten, der Boot-Report kommt später)
+  Serial.begin(SERIAL_BAUD_RATE);
+  Serial.println("Chess Clock - Display Test");
+
+  if (TRACE_ENABLED && !traceInit()) {
+    Serial.println("ERROR: Trace could not be started!");
+  }
+
+  // Budgets überwachen, bevor die ersten Jobs und Interrupts laufen
+  if (DEADLINE_MONITOR) {
+    deadlinesInit();
+    eventDeadlineAdded = deadlineMonitor.add(&eventDeadline);
+    if (!eventDeadlineAdded) {
+      Serial.println("WARNING: Clock event deadline could not be monitored!");
+    }
+  }
+
+  // Abonnenten stehen fest, bevor der erste Zustandswechsel veröffentlicht wird
+  clockBusStart(BUS_SUBSCRIBERS, sizeof(BUS_SUBSCRIBERS) / sizeof(BUS_SUBSCRIBERS[0]));
+
+  // Vor allem anderen nachsehen, ob eine Partie unterbrochen wurde, und sie noch vor dem
+  // Boot-Graphen in PAUSE fortsetzen: Zeiten und Zustand brauchen weder Display noch WLAN
+  stateMutex = xSemaphoreCreateRecursiveMutex();
+  resumeGame = checkpointRestore(&resumedGame);
+  if (resumeGame) {
+    restoreGame();
+  }
+
+  if (!bootStart(BOOT_PHASES, BOOT_PHASE_COUNT) || !bootWaitUntilUsable(BOOT_TIMEOUT_MS)) {
+    Serial.println("ERROR: Boot failed!");
+  }
+
   // State Machine initialisieren
-  currentState = ChessClockState::IDLE;
+  if (!resumeGame) {
+    currentState = ChessClockState::IDLE;
+  }
   Serial.print("State Machine initialized: ");
   Serial.println(stateToString(currentState));
+
+  // Abtastung auf Kern 1 startet hier, auf Kern 0 mit dem Profiler-Task
+  if (PROFILER_ENABLED && !profilerStart()) {
+    Serial.println("ERROR: Profiler could not be started!");
+  }
+
+  if (LATENCY_BENCHMARK && !latencyBenchStart()) {
+    Serial.println("ERROR: Latency benchmark could not be started!");
+  }
+
+  // Ab hier läuft alles in den Tasks der Topologie
+  if (!taskTopologyStart(TASKS, TASK_COUNT)) {
+    Serial.println("ERROR: Not all tasks could be started!");
+  }
 }
 
 void loop() {
-  // Hier könnte später die State Machine laufen
-  delay(100);
-}
\ No newline at end of file
+  // Der Arduino-Loop-Task wird nicht mehr gebraucht
+  vTaskDelete(NULL);
+}
@@ -0,0 +1,280 @@
+#include "ota_delta.h"
+#include <Arduino.h>
+#include <HTTPClient.h>
+#include <esp_ota_ops.h>
+#include <esp_partition.h>
+#include <freertos/semphr.h>
+#include <mbedtls/md.h>
+#include "config.h"
+#include "delta_patch.h"
+#include "flash_writer.h"
+
+/**
+ * @brief State shared with the decoder callbacks during one update
+ */
+struct OtaDeltaContext {
+  const esp_partition_t* running;
+  const esp_partition_t* target;
+  esp_ota_handle_t handle;
+  bool otaStarted;
+  bool wrongBase;
+  bool cancelled;
+  mbedtls_md_context_t newHash;
+};
+
+// Large enough to keep it off the loop task stack
+static DeltaPatchDecoder decoder;
+
+static volatile bool allowed = false;
+
+// One block of the new image on its way to the flash writer, no data ends the update
+static OtaDeltaContext* blockOta = nullptr;
+static const uint8_t* blockData = nullptr;
+static size_t blockLength = 0;
+static bool blockWritten = false;
+static SemaphoreHandle_t blockDone = nullptr;
+
+static bool writeBlock(void* context);
+
+static FlashWriteJob blockJob = { "ota_block", writeBlock, nullptr, 0, OTA_FLASH_BLOCK_BUDGET_US };
+
+static bool writeBlock(void* context) {
+  // Runs in the flash writer task, with OTA_WITH_SEQUENTIAL_WRITES a block erases at most one sector
+  if (!allowed) {
+    blockWritten = false;
+  } else if (blockData != nullptr) {
+    blockWritten = esp_ota_write(blockOta->handle, blockData, blockLength) == ESP_OK;
+  } else {
+    blockWritten = esp_ota_end(blockOta->handle) == ESP_OK && esp_ota_set_boot_partition(blockOta->target) == ESP_OK;
+  }
+  xSemaphoreGive(blockDone);
+  return blockWritten;
+}
+
+static bool writeOnFlashWriter(OtaDeltaContext* ota, const uint8_t* data, size_t length) {
+  // The caller keeps the data until this returns, so the job can use it in place
+  blockOta = ota;
+  blockData = data;
+  blockLength = length;
+  flashWriterRequest(&blockJob, true);
+  xSemaphoreTake(blockDone, portMAX_DELAY);
+  if (!blockWritten && !allowed) {
+    ota->cancelled = true;
+  }
+  return blockWritten;
+}
+
+static bool hashPartition(const esp_partition_t* partition, uint32_t size, uint8_t* digest) {
+  mbedtls_md_context_t hash;
+  mbedtls_md_init(&hash);
+  mbedtls_md_setup(&hash, mbedtls_md_info_from_type(MBEDTLS_MD_SHA256), 0);
+  mbedtls_md_starts(&hash);
+
+  uint8_t buffer[512];
+  bool ok = true;
+  for (uint32_t offset = 0; offset < size && ok; offset += sizeof(buffer)) {
+    uint32_t length = size - offset < sizeof(buffer) ? size - offset : sizeof(buffer);
+    ok = esp_partition_read(partition, offset, buffer, length) == ESP_OK;
+    mbedtls_md_update(&hash, buffer, length);
+  }
+
+  mbedtls_md_finish(&hash, digest);
+  mbedtls_md_free(&hash);
+  return ok;
+}
+
+static bool checkHeader(void* context, const DeltaPatchHeader& header) {
+  OtaDeltaContext* ota = (OtaDeltaContext*)context;
+  if (header.oldSize > ota->running->size || header.newSize > ota->target->size) {
+    return false;
+  }
+
+  uint8_t digest[32];
+  if (!hashPartition(ota->running, header.oldSize, digest) ||
+      memcmp(digest, header.oldSha256, sizeof(digest)) != 0) {
+    ota->wrongBase = true;
+    return false;
+  }
+
+  // Erased sector by sector while writing, not the whole slot at once
+  if (esp_ota_begin(ota->target, OTA_WITH_SEQUENTIAL_WRITES, &ota->handle) != ESP_OK) {
+    return false;
+  }
+  ota->otaStarted = true;
+  return true;
+}
+
+static bool readOld(void* context, uint32_t offset, uint8_t* buffer, size_t length) {
+  OtaDeltaContext* ota = (OtaDeltaContext*)context;
+  return esp_partition_read(ota->running, offset, buffer, length) == ESP_OK;
+}
+
+static bool writeNew(void* context, const uint8_t* data, size_t length) {
+  OtaDeltaContext* ota = (OtaDeltaContext*)context;
+  if (!allowed) {
+    ota->cancelled = true;
+    return false;
+  }
+  mbedtls_md_update(&ota->newHash, data, length);
+  return writeOnFlashWriter(ota, data, length);
+}
+
+const char* otaDeltaResultToString(OtaDeltaResult result) {
+  switch (result) {
+    case OtaDeltaResult::UPDATED:
+      return "UPDATED";
+    case OtaDeltaResult::NO_UPDATE:
+      return "NO_UPDATE";
+    case OtaDeltaResult::WRONG_BASE:
+      return "WRONG_BASE";
+    case OtaDeltaResult::DOWNLOAD_FAILED:
+      return "DOWNLOAD_FAILED";
+    case OtaDeltaResult::PATCH_FAILED:
+      return "PATCH_FAILED";
+    case OtaDeltaResult::VERIFY_FAILED:
+      return "VERIFY_FAILED";
+    case OtaDeltaResult::FLASH_FAILED:
+      return "FLASH_FAILED";
+    case OtaDeltaResult::CANCELLED:
+      return "CANCELLED";
+    default:
+      return "UNKNOWN";
+  }
+}
+
+void otaDeltaSetAllowed(bool allow) {
+  allowed = allow;
+}
+
+void otaDeltaBuildId(char* buffer, size_t size) {
+  esp_ota_get_app_elf_sha256(buffer, size < 17 ? size : 17);
+}
+
+static OtaDeltaResult streamPatch(HTTPClient& http, OtaDeltaContext& ota) {
+  WiFiClient* stream = http.getStreamPtr();
+  int remaining = http.getSize();   // -1 if the server did not send a length
+  uint8_t chunk[1024];
+  uint32_t lastDataMs = millis();
+
+  DeltaPatchStatus status = DeltaPatchStatus::NEED_MORE;
+  while (status == DeltaPatchStatus::NEED_MORE && http.connected() && remaining != 0) {
+    size_t available = stream->available();
+    if (available == 0) {
+      if (millis() - lastDataMs > OTA_DOWNLOAD_TIMEOUT_MS) {
+        break;
+      }
+      delay(1);
+      continue;
+    }
+
+    int length = stream->readBytes(chunk, available < sizeof(chunk) ? available : sizeof(chunk));
+    if (remaining > 0) {
+      remaining -= length;
+    }
+    lastDataMs = millis();
+    status = decoder.write(chunk, length);
+  }
+
+  switch (status) {
+    case DeltaPatchStatus::DONE:
+      return OtaDeltaResult::UPDATED;
+    case DeltaPatchStatus::NEED_MORE:
+      return OtaDeltaResult::DOWNLOAD_FAILED;
+    case DeltaPatchStatus::BAD_HEADER:
+      return ota.wrongBase ? OtaDeltaResult::WRONG_BASE : OtaDeltaResult::PATCH_FAILED;
+    case DeltaPatchStatus::BAD_BODY:
+      return OtaDeltaResult::PATCH_FAILED;
+    default:
+      return ota.cancelled ? OtaDeltaResult::CANCELLED : OtaDeltaResult::FLASH_FAILED;
+  }
+}
+
+OtaDeltaResult otaDeltaApplyFromUrl(const char* url) {
+  OtaDeltaContext ota;
+  ota.running = esp_ota_get_running_partition();
+  ota.target = esp_ota_get_next_update_partition(NULL);
+  ota.otaStarted = false;
+  ota.wrongBase = false;
+  ota.cancelled = false;
+  if (ota.running == nullptr || ota.target == nullptr) {
+    return OtaDeltaResult::FLASH_FAILED;
+  }
+  if (blockDone == nullptr && (blockDone = xSemaphoreCreateBinary()) == nullptr) {
+    return OtaDeltaResult::FLASH_FAILED;
+  }
+  if (!allowed) {
+    return OtaDeltaResult::CANCELLED;
+  }
+
+  HTTPClient http;
+  http.begin(url);
+  int code = http.GET();
+  if (code == HTTP_CODE_NOT_FOUND) {
+    http.end();
+    return OtaDeltaResult::NO_UPDATE;
+  }
+  if (code != HTTP_CODE_OK) {
+    http.end();
+    return OtaDeltaResult::DOWNLOAD_FAILED;
+  }
+
+  mbedtls_md_init(&ota.newHash);
+  mbedtls_md_setup(&ota.newHash, mbedtls_md_info_from_type(MBEDTLS_MD_SHA256), 0);
+  mbedtls_md_starts(&ota.newHash);
+
+  DeltaPatchIo io = { &ota, checkHeader, readOld, writeNew };
+  decoder.begin(io);
+  uint32_t start = millis();
+  int patchSize = http.getSize();
+  OtaDeltaResult result = streamPatch(http, ota);
+  http.end();
+
+  uint8_t digest[32];
+  mbedtls_md_finish(&ota.newHash, digest);
+  mbedtls_md_free(&ota.newHash);
+
+  if (result == OtaDeltaResult::UPDATED &&
+      memcmp(digest, decoder.header().newSha256, sizeof(digest)) != 0) {
+    result = OtaDeltaResult::VERIFY_FAILED;
+  }
+
+  if (ota.otaStarted) {
+    if (result != OtaDeltaResult::UPDATED) {
+      esp_ota_abort(ota.handle);
+    } else if (!writeOnFlashWriter(&ota, nullptr, 0)) {
+      if (ota.cancelled) {
+        esp_ota_abort(ota.handle);   // esp_ota_end() did not run
+        result = OtaDeltaResult::CANCELLED;
+      } else {
+        result = OtaDeltaResult::VERIFY_FAILED;
+      }
+    }
+  }
+
+  if (result == OtaDeltaResult::UPDATED) {
+    Serial.printf("OTA: %d byte patch -> %lu byte image in %lu ms (%s)\n",
+                  patchSize, (unsigned long)decoder.bytesWritten(),
+                  (unsigned long)(millis() - start), ota.target->label);
+  }
+  return result;
+}
+
+void otaDeltaCheckForUpdate() {
+  if (strlen(OTA_PATCH_URL_FORMAT) == 0) {
+    return;
+  }
+
+  char buildId[17];
+  char url[160];
+  otaDeltaBuildId(buildId, sizeof(buildId));
+  snprintf(url, sizeof(url), OTA_PATCH_URL_FORMAT, buildId);
+
+  OtaDeltaResult result = otaDeltaApplyFromUrl(url);
+  Serial.print("OTA check: ");
+  Serial.println(otaDeltaResultToString(result));
+
+  if (result == OtaDeltaResult::UPDATED) {
+    delay(100);   // Let the serial output drain
+    ESP.restart();
+  }
+}
@@ -0,0 +1,292 @@
+#include "pixel_kernels.h"
+#include <stddef.h>
+#include <string.h>
+
+#define BLOCK_PIXELS  8               // Pixels per 128 bit vector
+#define VERIFY_PIXELS 80              // Longest buffer of the self-test
+
+static bool simdEnabled = false;
+
+static inline uint16_t swapBytes(uint16_t value) {
+  return (uint16_t)((value << 8) | (value >> 8));
+}
+
+void pixelFillScalar(uint16_t* target, uint16_t color, uint32_t count) {
+  uint16_t value = swapBytes(color);
+  for (uint32_t i = 0; i < count; i++) {
+    target[i] = value;
+  }
+}
+
+void pixelSwapScalar(uint16_t* target, const uint16_t* source, uint32_t count) {
+  for (uint32_t i = 0; i < count; i++) {
+    target[i] = swapBytes(source[i]);
+  }
+}
+
+void pixelBlendScalar(uint16_t* target, const uint16_t* source, uint16_t color, uint8_t alpha, uint32_t count) {
+  uint32_t weight = (alpha + 4) >> 3;
+  uint32_t inverse = 32 - weight;
+  uint32_t red = (color >> 11) * weight;
+  uint32_t green = ((color >> 5) & 0x3F) * weight;
+  uint32_t blue = (color & 0x1F) * weight;
+  for (uint32_t i = 0; i < count; i++) {
+    uint32_t pixel = swapBytes(source[i]);
+    uint32_t r = ((pixel >> 11) * inverse + red) >> 5;
+    uint32_t g = (((pixel >> 5) & 0x3F) * inverse + green) >> 5;
+    uint32_t b = ((pixel & 0x1F) * inverse + blue) >> 5;
+    target[i] = swapBytes((uint16_t)((r << 11) | (g << 5) | b));
+  }
+}
+
+#if PIXEL_KERNELS_HAVE_SIMD
+
+// The vector loops take whole blocks from 16-byte aligned buffers. The
+// PIE multiply (ee.vmul.u16) shifts its 32 bit products right by SAR and
+// keeps the lower 16 bits, so it also serves as the per-lane shift.
+
+static void fillBlocks(uint16_t* target, uint16_t value, uint32_t blocks) {
+  asm volatile(
+      "ee.vldbc.16 q0, %[value]\n"
+      "1:\n"
+      "ee.vst.128.ip q0, %[target], 16\n"
+      "addi %[blocks], %[blocks], -1\n"
+      "bnez %[blocks], 1b\n"
+      : [target] "+r"(target), [blocks] "+r"(blocks)
+      : [value] "r"(&value)
+      : "memory");
+}
+
+static void swapBlocks(uint16_t* target, const uint16_t* source, uint32_t blocks) {
+  static const uint16_t factors[] = { 1, 256 };
+  const uint16_t* factor = factors;
+  asm volatile(
+      "ee.vldbc.16.ip q4, %[factor], 2\n"
+      "ee.vldbc.16 q5, %[factor]\n"
+      "1:\n"
+      "ee.vld.128.ip q0, %[source], 16\n"
+      "ssai 8\n"
+      "ee.vmul.u16 q1, q0, q4\n"           // High byte down
+      "ssai 0\n"
+      "ee.vmul.u16 q2, q0, q5\n"           // Low byte up
+      "ee.orq q1, q1, q2\n"
+      "ee.vst.128.ip q1, %[target], 16\n"
+      "addi %[blocks], %[blocks], -1\n"
+      "bnez %[blocks], 1b\n"
+      : [target] "+r"(target), [source] "+r"(source), [blocks] "+r"(blocks), [factor] "+r"(factor)
+      :
+      : "memory");
+}
+
+static void blendBlocks(uint16_t* target, const uint16_t* source, uint16_t color, uint8_t alpha,
+                        uint32_t blocks) {
+  uint16_t weight = (alpha + 4) >> 3;
+  uint16_t factors[] = { 1, 256, (uint16_t)(32 - weight) };
+  // Read in this order once per block
+  uint16_t constants[] = {
+    (uint16_t)((color >> 11) * weight), 2048,
+    0x3F, (uint16_t)(((color >> 5) & 0x3F) * weight), 32,
+    0x1F, (uint16_t)((color & 0x1F) * weight),
+  };
+  const uint16_t* factor = factors;
+  const uint16_t* constant = constants;
+  asm volatile(
+      "ee.vldbc.16.ip q4, %[factor], 2\n"  // 1
+      "ee.vldbc.16.ip q5, %[factor], 2\n"  // 256
+      "ee.vldbc.16 q6, %[factor]\n"        // 32 - weight
+      "1:\n"
+      "ee.vld.128.ip q0, %[source], 16\n"
+      "ssai 8\n"
+      "ee.vmul.u16 q1, q0, q4\n"
+      "ssai 0\n"
+      "ee.vmul.u16 q2, q0, q5\n"
+      "ee.orq q0, q1, q2\n"                // RGB565
+      // Red
+      "ssai 11\n"
+      "ee.vmul.u16 q1, q0, q4\n"
+      "ssai 0\n"
+      "ee.vmul.u16 q1, q1, q6\n"
+      "ee.vldbc.16.ip q7, %[constant], 2\n"
+      "ee.vadds.s16 q1, q1, q7\n"
+      "ssai 5\n"
+      "ee.vmul.u16 q1, q1, q4\n"
+      "ssai 0\n"
+      "ee.vldbc.16.ip q7, %[constant], 2\n"
+      "ee.vmul.u16 q3, q1, q7\n"
+      // Green
+      "ssai 5\n"
+      "ee.vmul.u16 q1, q0, q4\n"
+      "ee.vldbc.16.ip q7, %[constant], 2\n"
+      "ee.andq q1, q1, q7\n"
+      "ssai 0\n"
+      "ee.vmul.u16 q1, q1, q6\n"
+      "ee.vldbc.16.ip q7, %[constant], 2\n"
+      "ee.vadds.s16 q1, q1, q7\n"
+      "ssai 5\n"
+      "ee.vmul.u16 q1, q1, q4\n"
+      "ssai 0\n"
+      "ee.vldbc.16.ip q7, %[constant], 2\n"
+      "ee.vmul.u16 q1, q1, q7\n"
+      "ee.orq q3, q3, q1\n"
+      // Blue
+      "ee.vldbc.16.ip q7, %[constant], 2\n"
+      "ee.andq q1, q0, q7\n"
+      "ee.vmul.u16 q1, q1, q6\n"
+      "ee.vldbc.16.ip q7, %[constant], 2\n"
+      "ee.vadds.s16 q1, q1, q7\n"
+      "ssai 5\n"
+      "ee.vmul.u16 q1, q1, q4\n"
+      "ee.orq q3, q3, q1\n"
+      // Back to display byte order
+      "ssai 8\n"
+      "ee.vmul.u16 q1, q3, q4\n"
+      "ssai 0\n"
+      "ee.vmul.u16 q2, q3, q5\n"
+      "ee.orq q1, q1, q2\n"
+      "ee.vst.128.ip q1, %[target], 16\n"
+      "addi %[constant], %[constant], -14\n"
+      "addi %[blocks], %[blocks], -1\n"
+      "bnez %[blocks], 1b\n"
+      : [target] "+r"(target), [source] "+r"(source), [blocks] "+r"(blocks), [factor] "+r"(factor),
+        [constant] "+r"(constant)
+      :
+      : "memory");
+}
+
+// Pixels before the first 16-byte boundary
+static uint32_t headPixels(const uint16_t* pointer, uint32_t count) {
+  uint32_t head = ((16 - ((uintptr_t)pointer & 15)) & 15) / sizeof(uint16_t);
+  return head < count ? head : count;
+}
+
+static bool sameAlignment(const uint16_t* a, const uint16_t* b) {
+  return (((uintptr_t)a ^ (uintptr_t)b) & 15) == 0;
+}
+
+#endif // PIXEL_KERNELS_HAVE_SIMD
+
+void pixelFill(uint16_t* target, uint16_t color, uint32_t count) {
+#if PIXEL_KERNELS_HAVE_SIMD
+  if (simdEnabled) {
+    uint32_t head = headPixels(target, count);
+    pixelFillScalar(target, color, head);
+    target += head;
+    count -= head;
+    uint32_t blocks = count / BLOCK_PIXELS;
+    if (blocks > 0) {
+      fillBlocks(target, swapBytes(color), blocks);
+      target += blocks * BLOCK_PIXELS;
+      count -= blocks * BLOCK_PIXELS;
+    }
+  }
+#endif
+  pixelFillScalar(target, color, count);
+}
+
+void pixelSwap(uint16_t* target, const uint16_t* source, uint32_t count) {
+#if PIXEL_KERNELS_HAVE_SIMD
+  if (simdEnabled && sameAlignment(target, source)) {
+    uint32_t head = headPixels(target, count);
+    pixelSwapScalar(target, source, head);
+    target += head;
+    source += head;
+    count -= head;
+    uint32_t blocks = count / BLOCK_PIXELS;
+    if (blocks > 0) {
+      swapBlocks(target, source, blocks);
+      target += blocks * BLOCK_PIXELS;
+      source += blocks * BLOCK_PIXELS;
+      count -= blocks * BLOCK_PIXELS;
+    }
+  }
+#endif
+  pixelSwapScalar(target, source, count);
+}
+
+void pixelBlend(uint16_t* target, const uint16_t* source, uint16_t color, uint8_t alpha, uint32_t count) {
+#if PIXEL_KERNELS_HAVE_SIMD
+  if (simdEnabled && sameAlignment(target, source)) {
+    uint32_t head = headPixels(target, count);
+    pixelBlendScalar(target, source, color, alpha, head);
+    target += head;
+    source += head;
+    count -= head;
+    uint32_t blocks = count / BLOCK_PIXELS;
+    if (blocks > 0) {
+      blendBlocks(target, source, color, alpha, blocks);
+      target += blocks * BLOCK_PIXELS;
+      source += blocks * BLOCK_PIXELS;
+      count -= blocks * BLOCK_PIXELS;
+    }
+  }
+#endif
+  pixelBlendScalar(target, source, color, alpha, count);
+}
+
+bool pixelKernelsVerify() {
+#if PIXEL_KERNELS_HAVE_SIMD
+  alignas(16) static uint16_t input[VERIFY_PIXELS + BLOCK_PIXELS];
+  alignas(16) static uint16_t expected[VERIFY_PIXELS + BLOCK_PIXELS];
+  alignas(16) static uint16_t actual[VERIFY_PIXELS + BLOCK_PIXELS];
+  static const uint32_t lengths[] = { 1, 7, 8, 9, 15, 16, 17, 63, 64, VERIFY_PIXELS };
+  const size_t bytes = sizeof(actual);
+
+  uint32_t seed = 0x12345678;
+  for (uint32_t i = 0; i < VERIFY_PIXELS + BLOCK_PIXELS; i++) {
+    seed = seed * 1664525 + 1013904223;
+    input[i] = (uint16_t)(seed >> 16);
+  }
+  input[0] = 0x0000;   // Extremes of every channel
+  input[1] = 0xFFFF;
+
+  bool saved = simdEnabled;
+  simdEnabled = true;
+  bool exact = true;
+  for (uint32_t offset = 0; offset < BLOCK_PIXELS && exact; offset++) {
+    for (uint32_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]) && exact; l++) {
+      uint32_t length = lengths[l];
+      if (offset + length > VERIFY_PIXELS + BLOCK_PIXELS) {
+        continue;
+      }
+      uint16_t color = input[(offset + length) % VERIFY_PIXELS];
+
+      memset(expected, 0, bytes);
+      memset(actual, 0, bytes);
+      pixelFillScalar(expected + offset, color, length);
+      pixelFill(actual + offset, color, length);
+      exact = exact && memcmp(expected, actual, bytes) == 0;
+
+      pixelSwapScalar(expected + offset, input + offset, length);
+      pixelSwap(actual + offset, input + offset, length);
+      exact = exact && memcmp(expected, actual, bytes) == 0;
+
+      // Every alpha once, a spread of them for the other cases
+      uint32_t step = offset == 0 && length == VERIFY_PIXELS ? 1 : 17;
+      for (uint32_t alpha = 0; alpha < 256 && exact; alpha += step) {
+        pixelBlendScalar(expected + offset, input + offset, color, (uint8_t)alpha, length);
+        pixelBlend(actual + offset, input + offset, color, (uint8_t)alpha, length);
+        exact = memcmp(expected, actual, bytes) == 0;
+      }
+
+      // In place
+      memcpy(actual, input, bytes);
+      memcpy(expected, input, bytes);
+      pixelBlendScalar(expected + offset, expected + offset, 0x0000, 96, length);
+      pixelBlend(actual + offset, actual + offset, 0x0000, 96, length);
+      exact = exact && memcmp(expected, actual, bytes) == 0;
+    }
+  }
+  simdEnabled = saved;
+  return exact;
+#else
+  return false;
+#endif
+}
+
+void pixelKernelsSetSimd(bool enabled) {
+  simdEnabled = enabled && PIXEL_KERNELS_HAVE_SIMD;
+}
+
+bool pixelKernelsSimd() {
+  return simdEnabled;
+}
@@ -0,0 +1,92 @@
+#include "pixels.h"
+#include <Arduino.h>
+#include <TFT_eSPI.h>
+#include <esp_heap_caps.h>
+#include "config.h"
+#include "pixel_kernels.h"
+
+#define BENCH_BAND_PIXELS   (320 * 8)
+#define BENCH_SCREEN_PIXELS (320 * 240)
+#define BENCH_RUNS          3
+
+static bool verified = false;
+
+enum BenchKernel {
+  BENCH_FILL,
+  BENCH_SWAP,
+  BENCH_BLEND,
+  BENCH_KERNEL_COUNT
+};
+
+static const char* const KERNEL_NAMES[BENCH_KERNEL_COUNT] = { "fill", "swap", "blend" };
+
+// Fastest of a few runs, so an interrupt does not count
+static uint32_t measureCycles(BenchKernel kernel, uint16_t* pixels, uint32_t count) {
+  uint32_t best = UINT32_MAX;
+  for (uint8_t run = 0; run < BENCH_RUNS; run++) {
+    uint32_t start = ESP.getCycleCount();
+    switch (kernel) {
+      case BENCH_FILL:
+        pixelFill(pixels, TFT_DARKGREEN, count);
+        break;
+      case BENCH_SWAP:
+        pixelSwap(pixels, pixels, count);
+        break;
+      default:
+        pixelBlend(pixels, pixels, TFT_BLACK, 128, count);
+        break;
+    }
+    uint32_t cycles = ESP.getCycleCount() - start;
+    if (cycles < best) {
+      best = cycles;
+    }
+  }
+  return best;
+}
+
+static void printMemory(const char* memory, uint16_t* pixels, uint32_t count) {
+  for (uint8_t kernel = 0; kernel < BENCH_KERNEL_COUNT; kernel++) {
+    pixelKernelsSetSimd(false);
+    uint32_t scalar = measureCycles((BenchKernel)kernel, pixels, count);
+    pixelKernelsSetSimd(true);
+    uint32_t vector = measureCycles((BenchKernel)kernel, pixels, count);
+    Serial.printf("  %-6s %-8s %6.2f %6.2f\n", KERNEL_NAMES[kernel], memory, (float)scalar / count,
+                  (float)vector / count);
+  }
+}
+
+bool pixelsInit() {
+  verified = pixelKernelsVerify();
+  pixelKernelsSetSimd(PIXEL_SIMD && verified);
+  if (PIXEL_KERNELS_HAVE_SIMD && !verified) {
+    Serial.println("WARNING: Vector pixel kernels differ from the scalar ones - using scalar");
+  }
+  Serial.printf("Pixel kernels: %s\n", pixelKernelsSimd() ? "PIE vector" : "scalar");
+
+  if (PIXEL_BENCHMARK) {
+    pixelsPrintBenchmark();
+  }
+  return true;
+}
+
+void pixelsPrintBenchmark() {
+  if (!verified) {
+    return;   // Nothing to compare with
+  }
+  uint16_t* band = (uint16_t*)heap_caps_aligned_alloc(16, BENCH_BAND_PIXELS * sizeof(uint16_t),
+                                                      MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+  uint16_t* screen = (uint16_t*)heap_caps_aligned_alloc(16, BENCH_SCREEN_PIXELS * sizeof(uint16_t),
+                                                        MALLOC_CAP_SPIRAM);
+  if (band == nullptr || screen == nullptr) {
+    Serial.println("ERROR: No memory for the pixel benchmark!");
+  } else {
+    bool enabled = pixelKernelsSimd();
+    Serial.println("Pixel benchmark (cycles per pixel):");
+    Serial.printf("  %-6s %-8s %6s %6s\n", "kernel", "memory", "scalar", "vector");
+    printMemory("internal", band, BENCH_BAND_PIXELS);
+    printMemory("psram", screen, BENCH_SCREEN_PIXELS);
+    pixelKernelsSetSimd(enabled);
+  }
+  heap_caps_free(band);
+  heap_caps_free(screen);
+}
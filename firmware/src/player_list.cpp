@@ -0,0 +1,261 @@
+#include "player_list.h"
+#include <Arduino.h>
+#include <SPIFFS.h>
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include "config.h"
+#include "pixel_kernels.h"
+#include "player_roster.h"
+#include "smooth_text.h"
+#include "spi_bus.h"
+#include "virtual_list.h"
+
+#define ILI9341_VSCRDEF  0x33
+#define ILI9341_VSCRSADD 0x37
+#define PANEL_LINES      320     // Lines along the scroll axis of the panel
+
+static TFT_eSPI* tft = nullptr;
+static File rosterFile;
+static PlayerRoster roster;
+static VirtualList list;
+static bool shown = false;
+static bool hardwareScroll = false;
+static int32_t width = 0;
+static int32_t rowHeight = 0;
+static int32_t listTop = 0;
+
+// Rendered rows in PSRAM, key = row * 2 + highlighted
+static uint16_t* cachePixels = nullptr;
+static uint32_t cacheKeys[PLAYER_LIST_CACHE_ROWS];
+static uint32_t cacheUsed[PLAYER_LIST_CACHE_ROWS];
+static uint32_t cacheClock = 0;
+
+static uint16_t* band = nullptr;          // One row, internal RAM for DMA
+static SpiTransaction rowTransaction;
+static SemaphoreHandle_t rowSent = nullptr;
+static PlayerListStats stats;
+
+static bool readRoster(void* context, uint32_t offset, uint8_t* target, uint32_t length) {
+  File* file = (File*)context;
+  return file->seek(offset) && file->read(target, length) == length;
+}
+
+static void rowDone(SpiTransaction* transaction) {
+  xSemaphoreGive(rowSent);
+}
+
+static void writeCommand(uint8_t command, const uint16_t* values, uint8_t count) {
+  spiBusAcquire();
+  tft->writecommand(command);
+  for (uint8_t i = 0; i < count; i++) {
+    tft->writedata((uint8_t)(values[i] >> 8));
+    tft->writedata((uint8_t)values[i]);
+  }
+  spiBusRelease();
+}
+
+static void defineScrollArea(uint16_t top, uint16_t lines) {
+  uint16_t values[] = { top, lines, (uint16_t)(PANEL_LINES - top - lines) };
+  writeCommand(ILI9341_VSCRDEF, values, 3);
+}
+
+static void setScrollStart(uint16_t line) {
+  writeCommand(ILI9341_VSCRSADD, &line, 1);
+}
+
+static const uint16_t* renderRow(uint32_t index, bool highlighted) {
+  uint32_t key = index * 2 + (highlighted ? 1 : 0);
+  uint8_t oldest = 0;
+  for (uint8_t i = 0; i < PLAYER_LIST_CACHE_ROWS; i++) {
+    if (cacheKeys[i] == key) {
+      cacheUsed[i] = ++cacheClock;
+      stats.cacheHits++;
+      return cachePixels + (size_t)i * width * rowHeight;
+    }
+    if (cacheUsed[i] < cacheUsed[oldest]) {
+      oldest = i;
+    }
+  }
+
+  // Materialize the row: read the name and render it into the least recently used slot
+  stats.cacheMisses++;
+  char name[2 * PLAYER_NAME_MAX_LENGTH + 2];
+  char text[sizeof(name) + 12];
+  roster.name(index, name, sizeof(name));
+  snprintf(text, sizeof(text), " %u  %s", (unsigned)(index + 1), name);
+
+  uint16_t* pixels = cachePixels + (size_t)oldest * width * rowHeight;
+  uint16_t foreground = highlighted ? TFT_BLACK : TFT_WHITE;
+  uint16_t background = highlighted ? TFT_WHITE : TFT_BLACK;
+  pixelFill(pixels, background, width * rowHeight);
+  smoothTextRender(pixels + PLAYER_LIST_ROW_PADDING * width, width, text, foreground, background, false);
+  cacheKeys[oldest] = key;
+  cacheUsed[oldest] = ++cacheClock;
+  return pixels;
+}
+
+static void drawRow(uint32_t index) {
+  if (!list.isVisible(index)) {
+    return;
+  }
+  const uint16_t* pixels = renderRow(index, index == list.selected());
+  memcpy(band, pixels, (size_t)width * rowHeight * sizeof(uint16_t));
+
+  rowTransaction.x = 0;
+  rowTransaction.y = listTop + list.slot(index) * rowHeight;
+  rowTransaction.width = width;
+  rowTransaction.height = rowHeight;
+  spiBusSubmit(&rowTransaction);
+  xSemaphoreTake(rowSent, portMAX_DELAY);   // The band is reused by the next row
+  stats.rowsDrawn++;
+}
+
+static void drawVisible() {
+  for (uint32_t i = list.top(); i < list.top() + list.visible() && i < list.count(); i++) {
+    drawRow(i);
+  }
+}
+
+bool playerListInit(TFT_eSPI* display) {
+  tft = display;
+  if (!smoothTextReady()) {
+    Serial.println("WARNING: No player font - player selection without list");
+    return false;
+  }
+  rosterFile = SPIFFS.open(PLAYER_ROSTER_FILE, "r");
+  if (!rosterFile) {
+    Serial.printf("WARNING: %s not found - player selection without list\n", PLAYER_ROSTER_FILE);
+    return false;
+  }
+
+  width = display->width() > display->height() ? display->width() : display->height();
+  rowHeight = smoothTextLineHeight() + 2 * PLAYER_LIST_ROW_PADDING;
+  uint32_t* offsets = (uint32_t*)heap_caps_malloc(PLAYER_ROSTER_MAX * sizeof(uint32_t), MALLOC_CAP_SPIRAM);
+  cachePixels = (uint16_t*)heap_caps_malloc((size_t)PLAYER_LIST_CACHE_ROWS * width * rowHeight * sizeof(uint16_t),
+                                            MALLOC_CAP_SPIRAM);
+  band = (uint16_t*)heap_caps_malloc((size_t)width * rowHeight * sizeof(uint16_t), MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+  rowSent = xSemaphoreCreateBinary();
+  if (offsets == nullptr || cachePixels == nullptr || band == nullptr || rowSent == nullptr ||
+      !roster.load(readRoster, &rosterFile, rosterFile.size(), offsets, PLAYER_ROSTER_MAX)) {
+    Serial.println("ERROR: Player roster could not be loaded!");
+    heap_caps_free(offsets);
+    return false;
+  }
+
+  rowTransaction.device = SpiDevice::DISPLAY;
+  rowTransaction.pixels = band;
+  rowTransaction.command = nullptr;
+  rowTransaction.done = rowDone;
+  rowTransaction.context = nullptr;
+
+  memset(&stats, 0, sizeof(stats));
+  Serial.printf("Player roster: %u players, %u cached rows of %d px\n", (unsigned)roster.count(),
+                (unsigned)PLAYER_LIST_CACHE_ROWS, (int)rowHeight);
+  return true;
+}
+
+void playerListShow(const char* title) {
+  if (band == nullptr) {
+    return;
+  }
+  // The width may differ from the one at init after a rotation
+  width = tft->width();
+  hardwareScroll = tft->getRotation() == 0 && tft->height() == PANEL_LINES;
+  listTop = rowHeight;   // The title takes the first row
+  uint16_t visible = (uint16_t)((tft->height() - listTop) / rowHeight);
+  int32_t listHeight = visible * rowHeight;
+  list.begin(roster.count(), visible, hardwareScroll);
+  for (uint8_t i = 0; i < PLAYER_LIST_CACHE_ROWS; i++) {
+    cacheKeys[i] = UINT32_MAX;
+    cacheUsed[i] = 0;
+  }
+
+  if (hardwareScroll) {
+    defineScrollArea((uint16_t)listTop, (uint16_t)listHeight);
+    setScrollStart((uint16_t)listTop);
+  }
+  smoothTextDraw(0, 0, width, title, TFT_WHITE, TFT_NAVY, true);
+  spiBusAcquire();
+  tft->fillRect(0, listTop + listHeight, width, tft->height() - listTop - listHeight, TFT_BLACK);
+  if (roster.count() < visible) {
+    tft->fillRect(0, listTop + roster.count() * rowHeight, width, (visible - roster.count()) * rowHeight,
+                  TFT_BLACK);
+  }
+  spiBusRelease();
+
+  shown = true;
+  drawVisible();
+}
+
+void playerListScroll(int16_t steps) {
+  if (!shown || steps == 0) {
+    return;
+  }
+  int64_t startUs = esp_timer_get_time();
+
+  ListUpdate update = list.move(steps);
+  if (update.full) {
+    if (hardwareScroll) {
+      setScrollStart((uint16_t)(listTop + list.scrollSlot() * rowHeight));
+    }
+    drawVisible();
+  } else {
+    if (update.newCount > 0) {
+      // The rows that left the view are reused for the ones coming in
+      setScrollStart((uint16_t)(listTop + list.scrollSlot() * rowHeight));
+      stats.hardwareScrolls++;
+      for (uint32_t i = 0; i < update.newCount; i++) {
+        drawRow(update.newFirst + i);
+      }
+    }
+    bool oldIsNew = update.oldSelected >= update.newFirst && update.oldSelected < update.newFirst + update.newCount;
+    bool selectedIsNew = update.selected >= update.newFirst && update.selected < update.newFirst + update.newCount;
+    if (update.selectionChanged && !oldIsNew) {
+      drawRow(update.oldSelected);
+    }
+    if (update.selectionChanged && !selectedIsNew) {
+      drawRow(update.selected);
+    }
+  }
+
+  uint32_t updateUs = (uint32_t)(esp_timer_get_time() - startUs);
+  stats.updates++;
+  stats.totalUpdateUs += updateUs;
+  if (updateUs > stats.maxUpdateUs) {
+    stats.maxUpdateUs = updateUs;
+  }
+}
+
+void playerListHide() {
+  if (!shown) {
+    return;
+  }
+  if (hardwareScroll) {
+    defineScrollArea(0, PANEL_LINES);
+    setScrollStart(0);
+  }
+  shown = false;
+}
+
+bool playerListSelectedName(char* buffer, size_t size) {
+  return roster.name(list.selected(), buffer, size);
+}
+
+const PlayerListStats& playerListStats() {
+  return stats;
+}
+
+void playerListPrintStats() {
+  if (stats.updates == 0) {
+    return;
+  }
+  uint32_t lookups = stats.cacheHits + stats.cacheMisses;
+  Serial.printf("Player list: %u moves (%u hardware scrolls), avg %u us, max %u us, %u rows drawn\n",
+                (unsigned)stats.updates, (unsigned)stats.hardwareScrolls,
+                (unsigned)(stats.totalUpdateUs / stats.updates), (unsigned)stats.maxUpdateUs,
+                (unsigned)stats.rowsDrawn);
+  Serial.printf("  row cache: %u hits, %u misses (%u%% hit rate)\n", (unsigned)stats.cacheHits,
+                (unsigned)stats.cacheMisses, lookups > 0 ? (unsigned)(stats.cacheHits * 100 / lookups) : 0);
+}
@@ -0,0 +1,71 @@
+#include "player_roster.h"
+
+#define ROSTER_CHUNK 256
+
+PlayerRoster::PlayerRoster()
+    : read(nullptr), context(nullptr), fileSize(0), offsets(nullptr), players(0) {
+}
+
+bool PlayerRoster::load(RosterReadCallback read, void* context, uint32_t fileSize, uint32_t* offsets,
+                        uint32_t capacity) {
+  this->read = read;
+  this->context = context;
+  this->fileSize = fileSize;
+  this->offsets = offsets;
+  players = 0;
+
+  uint8_t chunk[ROSTER_CHUNK];
+  bool lineStart = true;
+  for (uint32_t position = 0; position < fileSize; position += ROSTER_CHUNK) {
+    uint32_t length = fileSize - position < ROSTER_CHUNK ? fileSize - position : ROSTER_CHUNK;
+    if (!read(context, position, chunk, length)) {
+      players = 0;
+      return false;
+    }
+    for (uint32_t i = 0; i < length; i++) {
+      uint8_t c = chunk[i];
+      if (c == '\n' || c == '\r') {
+        lineStart = true;
+      } else if (lineStart) {
+        lineStart = false;
+        if (players == capacity) {
+          return true;
+        }
+        offsets[players++] = position + i;
+      }
+    }
+  }
+  return true;
+}
+
+bool PlayerRoster::name(uint32_t index, char* buffer, size_t size) const {
+  if (index >= players || size == 0) {
+    return false;
+  }
+  uint32_t offset = offsets[index];
+  uint32_t length = fileSize - offset < size - 1 ? fileSize - offset : (uint32_t)(size - 1);
+  if (!read(context, offset, (uint8_t*)buffer, length)) {
+    buffer[0] = '\0';
+    return false;
+  }
+
+  uint32_t end = 0;
+  while (end < length && buffer[end] != '\n' && buffer[end] != '\r') {
+    end++;
+  }
+
+  // A cut-off name must not end inside a UTF-8 sequence
+  if (end == length && end > 0) {
+    uint32_t lead = end - 1;
+    while (lead > 0 && ((uint8_t)buffer[lead] & 0xC0) == 0x80) {
+      lead--;
+    }
+    uint8_t c = (uint8_t)buffer[lead];
+    uint32_t bytes = c >= 0xF0 ? 4 : c >= 0xE0 ? 3 : c >= 0xC0 ? 2 : 1;
+    if (lead + bytes > end) {
+      end = lead;
+    }
+  }
+  buffer[end] = '\0';
+  return true;
+}
@@ -0,0 +1,106 @@
+#include "profiler.h"
+#include <Arduino.h>
+#include <driver/timer.h>
+#include <esp_heap_caps.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/xtensa_context.h>
+#include "config.h"
+#include "sample_ring.h"
+
+#define TIMER_CLOCK_HZ 1000000     // 80 MHz APB / 80
+
+static SampleRing rings[2];
+static bool started = false;
+static TaskHandle_t knownTasks[PROFILER_MAX_TASKS];
+static uint8_t knownTaskCount = 0;
+static ProfilerStats stats;
+
+static bool onSample(void* argument) {
+  // The interrupt entry stored the stack pointer of the interrupted task,
+  // which points to its saved frame
+  TaskHandle_t task = xTaskGetCurrentTaskHandle();
+  const XtExcFrame* frame = *(const XtExcFrame* const*)task;
+  uint32_t core = (uint32_t)(uintptr_t)argument;
+  rings[core].push((uint32_t)frame->pc, (uint32_t)(uintptr_t)task);
+  return false;
+}
+
+// Sampling on the core that calls this, timer n samples core n
+static bool startTimer(uint32_t core) {
+  timer_config_t config = {};
+  config.divider = APB_CLK_FREQ / TIMER_CLOCK_HZ;
+  config.counter_dir = TIMER_COUNT_UP;
+  config.counter_en = TIMER_PAUSE;
+  config.alarm_en = TIMER_ALARM_EN;
+  config.auto_reload = TIMER_AUTORELOAD_EN;
+  config.intr_type = TIMER_INTR_LEVEL;
+
+  timer_idx_t timer = core == 0 ? TIMER_0 : TIMER_1;
+  timer_group_t group = (timer_group_t)PROFILER_TIMER_GROUP;
+  return timer_init(group, timer, &config) == ESP_OK &&
+         timer_set_counter_value(group, timer, 0) == ESP_OK &&
+         timer_set_alarm_value(group, timer, TIMER_CLOCK_HZ / PROFILER_SAMPLE_HZ) == ESP_OK &&
+         timer_enable_intr(group, timer) == ESP_OK &&
+         timer_isr_callback_add(group, timer, onSample, (void*)(uintptr_t)core, 0) == ESP_OK &&
+         timer_start(group, timer) == ESP_OK;
+}
+
+static uint8_t taskId(uint32_t handle) {
+  TaskHandle_t task = (TaskHandle_t)(uintptr_t)handle;
+  for (uint8_t i = 0; i < knownTaskCount; i++) {
+    if (knownTasks[i] == task) {
+      return i;
+    }
+  }
+  if (knownTaskCount == PROFILER_MAX_TASKS) {
+    return PROFILER_MAX_TASKS;   // Shown as "other"
+  }
+  knownTasks[knownTaskCount] = task;
+  Serial.printf("@T %u %s\n", (unsigned)knownTaskCount, pcTaskGetName(task));
+  return knownTaskCount++;
+}
+
+bool profilerStart() {
+  uint32_t bytes = PROFILER_RING_SAMPLES * sizeof(ProfileSample);
+  for (uint32_t core = 0; core < 2; core++) {
+    ProfileSample* storage = (ProfileSample*)heap_caps_malloc(bytes, MALLOC_CAP_SPIRAM);
+    if (storage == nullptr || !rings[core].begin(storage, PROFILER_RING_SAMPLES)) {
+      Serial.println("ERROR: No memory for the profiler rings!");
+      return false;
+    }
+  }
+  memset(&stats, 0, sizeof(stats));
+  started = true;
+  Serial.printf("@T %u other\n", (unsigned)PROFILER_MAX_TASKS);
+  return startTimer(xPortGetCoreID());
+}
+
+void profilerTask(void*) {
+  if (!started || !startTimer(xPortGetCoreID())) {
+    Serial.println("ERROR: Profiler could not sample this core!");
+    vTaskDelete(nullptr);
+  }
+
+  uint32_t reportedDrops[2] = { 0, 0 };
+  for (;;) {
+    for (uint32_t core = 0; core < 2; core++) {
+      ProfileSample sample;
+      while (rings[core].pop(&sample)) {
+        Serial.printf("@S %u %u %08x\n", (unsigned)core, (unsigned)taskId(sample.task), (unsigned)sample.pc);
+        stats.samples[core]++;
+        stats.streamed++;
+      }
+      stats.dropped[core] = rings[core].dropped();
+      if (stats.dropped[core] != reportedDrops[core]) {
+        reportedDrops[core] = stats.dropped[core];
+        Serial.printf("@D %u %u\n", (unsigned)core, (unsigned)reportedDrops[core]);
+      }
+    }
+    vTaskDelay(pdMS_TO_TICKS(PROFILER_DRAIN_MS));
+  }
+}
+
+const ProfilerStats& profilerStats() {
+  return stats;
+}
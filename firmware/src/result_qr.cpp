@@ -0,0 +1,141 @@
+#include "result_qr.h"
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+#include "config.h"
+#include "src/extra/libs/qrcode/qrcodegen.h"
+
+#define QR_MAX_MODULES    177               // Modules per side of a version 40 code
+#define QR_ROW_BYTES      ((QR_MAX_MODULES + 7) / 8)
+#define QR_QUIET_ZONE     4                 // Light modules around the code (spec minimum)
+
+static uint8_t* bitmap = nullptr;           // 1 bit per module, rows of QR_ROW_BYTES, in PSRAM
+static bool cacheValid = false;
+static uint32_t cachedRevision = 0;
+static ResultQrStats stats;
+
+static bool encodeRecord(const GameRecord& record) {
+  int64_t start = esp_timer_get_time();
+
+  // qrcodegen needs two work buffers of ~4 KB, only while encoding
+  uint8_t* work = (uint8_t*)ps_malloc(2 * qrcodegen_BUFFER_LEN_MAX);
+  if (work == nullptr) {
+    return false;
+  }
+  uint8_t* dataAndTemp = work;
+  uint8_t* qrcode = work + qrcodegen_BUFFER_LEN_MAX;
+
+  size_t length = gameRecordSerialize(record, (char*)dataAndTemp, RESULT_QR_MAX_PAYLOAD + 1);
+  bool ok = qrcodegen_encodeBinary(dataAndTemp, length, qrcode, qrcodegen_Ecc_LOW,
+                                   qrcodegen_VERSION_MIN, qrcodegen_VERSION_MAX,
+                                   qrcodegen_Mask_AUTO, true);
+  if (ok) {
+    int size = qrcodegen_getSize(qrcode);
+    memset(bitmap, 0, QR_ROW_BYTES * QR_MAX_MODULES);
+    for (int row = 0; row < size; row++) {
+      uint8_t* line = bitmap + row * QR_ROW_BYTES;
+      for (int column = 0; column < size; column++) {
+        if (qrcodegen_getModule(qrcode, column, row)) {
+          line[column >> 3] |= (uint8_t)(0x80 >> (column & 7));
+        }
+      }
+    }
+
+    stats.modules = (uint8_t)size;
+    stats.version = (uint8_t)((size - 17) / 4);
+    stats.payloadBytes = (uint16_t)length;
+    stats.encodeUs = (uint32_t)(esp_timer_get_time() - start);
+    Serial.printf("Result QR: %u bytes, version %u, %u modules, encoded in %lu us\n",
+                  stats.payloadBytes, stats.version, stats.modules, (unsigned long)stats.encodeUs);
+  }
+
+  free(work);
+  return ok;
+}
+
+static inline bool isDark(int32_t module, int32_t row) {
+  int32_t size = stats.modules;
+  module -= QR_QUIET_ZONE;
+  row -= QR_QUIET_ZONE;
+  if (module < 0 || row < 0 || module >= size || row >= size) {
+    return false;
+  }
+  return (bitmap[row * QR_ROW_BYTES + (module >> 3)] & (0x80 >> (module & 7))) != 0;
+}
+
+bool resultQrShow(TFT_eSPI* display, const GameRecord& record, int32_t x, int32_t y, int32_t maxSize) {
+  if (bitmap == nullptr) {
+    bitmap = (uint8_t*)ps_malloc(QR_ROW_BYTES * QR_MAX_MODULES);
+    if (bitmap == nullptr) {
+      Serial.println("ERROR: No PSRAM for the result QR code!");
+      return false;
+    }
+  }
+
+  if (!cacheValid || cachedRevision != record.revision) {
+    cacheValid = encodeRecord(record);
+    cachedRevision = record.revision;
+    if (!cacheValid) {
+      Serial.println("ERROR: Game record does not fit into a QR code!");
+      return false;
+    }
+  }
+
+  int32_t modules = stats.modules + 2 * QR_QUIET_ZONE;
+  int32_t scale = maxSize / modules;
+  if (scale < 1) {
+    return false;
+  }
+  int32_t side = modules * scale;
+
+  // Two internal band buffers: one is expanded while the other is sent
+  const size_t bandPixels = (size_t)side * RESULT_QR_BAND_LINES;
+  uint16_t* bands[2];
+  bands[0] = (uint16_t*)heap_caps_malloc(bandPixels * sizeof(uint16_t), MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+  bands[1] = (uint16_t*)heap_caps_malloc(bandPixels * sizeof(uint16_t), MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+  if (bands[0] == nullptr || bands[1] == nullptr) {
+    heap_caps_free(bands[0]);
+    heap_caps_free(bands[1]);
+    return false;
+  }
+
+  int64_t start = esp_timer_get_time();
+
+  // One address window and one SPI transaction for the whole code; black and
+  // white are the same in both byte orders, so no swapping is needed
+  display->startWrite();
+  display->setAddrWindow(x, y, side, side);
+  uint8_t current = 0;
+  for (int32_t top = 0; top < side; top += RESULT_QR_BAND_LINES) {
+    int32_t lines = side - top < RESULT_QR_BAND_LINES ? side - top : RESULT_QR_BAND_LINES;
+    uint16_t* pixel = bands[current];
+    for (int32_t line = 0; line < lines; line++) {
+      int32_t row = (top + line) / scale;
+      for (int32_t module = 0; module < modules; module++) {
+        uint16_t color = isDark(module, row) ? TFT_BLACK : TFT_WHITE;
+        for (int32_t i = 0; i < scale; i++) {
+          *pixel++ = color;
+        }
+      }
+    }
+    display->pushPixelsDMA(bands[current], (uint32_t)(lines * side));
+    current ^= 1;
+  }
+  display->dmaWait();
+  display->endWrite();
+
+  stats.blitUs = (uint32_t)(esp_timer_get_time() - start);
+  heap_caps_free(bands[0]);
+  heap_caps_free(bands[1]);
+  return true;
+}
+
+void resultQrRelease() {
+  free(bitmap);
+  bitmap = nullptr;
+  cacheValid = false;
+}
+
+const ResultQrStats& resultQrStats() {
+  return stats;
+}
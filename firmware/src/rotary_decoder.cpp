@@ -0,0 +1,25 @@
+#include "rotary_decoder.h"
+
+// States 0, 2, 3, 1 count up, the direction of the RotaryEncoder library used before
+const int8_t RotaryDecoder::DIRECTION[16] = {
+  0, -1, 1, 0,
+  1, 0, 0, -1,
+  -1, 0, 0, 1,
+  0, 1, -1, 0,
+};
+
+RotaryDecoder::RotaryDecoder() : counted(0), taken(0), state(DETENT), quarters(0), skipped(0) {}
+
+void RotaryDecoder::reset(bool a, bool b) {
+  state = (uint8_t)((a ? 1 : 0) | (b ? 2 : 0));
+  quarters = 0;
+  skipped = 0;
+  taken = counted.load(std::memory_order_acquire);
+}
+
+int16_t RotaryDecoder::take() {
+  int32_t now = counted.load(std::memory_order_acquire);
+  int16_t steps = (int16_t)(now - taken);
+  taken = now;
+  return steps;
+}
@@ -0,0 +1,30 @@
+#include "sample_ring.h"
+
+SampleRing::SampleRing() : samples(nullptr), capacity(0), written(0), read(0), lost(0) {
+}
+
+bool SampleRing::begin(ProfileSample* storage, uint32_t capacity) {
+  if (capacity == 0 || (capacity & (capacity - 1)) != 0) {
+    return false;
+  }
+  samples = storage;
+  this->capacity = capacity;
+  written.store(0);
+  read.store(0);
+  lost = 0;
+  return true;
+}
+
+bool SampleRing::pop(ProfileSample* sample) {
+  uint32_t head = read.load(std::memory_order_relaxed);
+  if (head == written.load(std::memory_order_acquire)) {
+    return false;
+  }
+  *sample = samples[head & (capacity - 1)];
+  read.store(head + 1, std::memory_order_release);
+  return true;
+}
+
+uint32_t SampleRing::size() const {
+  return written.load(std::memory_order_acquire) - read.load(std::memory_order_acquire);
+}
@@ -0,0 +1,221 @@
+#include "scheduler.h"
+
+static const uint64_t SLOT_MASK = SCHEDULER_SLOTS - 1;
+static const uint64_t WHEEL_RANGE = 1ULL << (SCHEDULER_SLOT_BITS * SCHEDULER_LEVELS);
+
+void Scheduler::begin(int64_t (*now)()) {
+  nowUs = now;
+  monitor = nullptr;
+  originUs = now();
+  currentTick = 0;
+  runningJob = nullptr;
+  runningCancelled = false;
+  for (uint8_t level = 0; level < SCHEDULER_LEVELS; level++) {
+    for (uint16_t slot = 0; slot < SCHEDULER_SLOTS; slot++) {
+      slots[level][slot] = nullptr;
+    }
+  }
+}
+
+void Scheduler::setMonitor(DeadlineMonitor* monitor) {
+  this->monitor = monitor;
+}
+
+void Scheduler::link(SchedulerJob** head, SchedulerJob* job) {
+  job->prev = nullptr;
+  job->next = *head;
+  if (*head != nullptr) {
+    (*head)->prev = job;
+  }
+  *head = job;
+  job->head = head;
+}
+
+void Scheduler::unlink(SchedulerJob* job) {
+  if (job->prev != nullptr) {
+    job->prev->next = job->next;
+  } else {
+    *job->head = job->next;
+  }
+  if (job->next != nullptr) {
+    job->next->prev = job->prev;
+  }
+  job->next = nullptr;
+  job->prev = nullptr;
+  job->head = nullptr;
+}
+
+void Scheduler::insert(SchedulerJob* job, uint64_t earliestTick) {
+  uint64_t due = job->dueTick > earliestTick ? job->dueTick : earliestTick;
+  uint64_t delta = due - currentTick;
+
+  // Beyond the range of the wheel: park in the farthest slot, cascading
+  // puts it back in the right place later
+  if (delta >= WHEEL_RANGE) {
+    due = currentTick + WHEEL_RANGE - 1;
+  }
+
+  uint8_t level = 0;
+  while (level < SCHEDULER_LEVELS - 1 && delta >= (1ULL << (SCHEDULER_SLOT_BITS * (level + 1)))) {
+    level++;
+  }
+  uint8_t slot = (uint8_t)((due >> (SCHEDULER_SLOT_BITS * level)) & SLOT_MASK);
+  link(&slots[level][slot], job);
+}
+
+void Scheduler::cascade(uint8_t level) {
+  uint8_t slot = (uint8_t)((currentTick >> (SCHEDULER_SLOT_BITS * level)) & SLOT_MASK);
+  SchedulerJob* job = slots[level][slot];
+  slots[level][slot] = nullptr;
+  while (job != nullptr) {
+    SchedulerJob* next = job->next;
+    job->head = nullptr;
+    // Cascading runs before the current tick expires, so it may still be used
+    insert(job, currentTick);
+    job = next;
+  }
+}
+
+void Scheduler::add(SchedulerJob* job, uint32_t delayMs) {
+  if (job->head != nullptr) {
+    unlink(job);
+  }
+  if (monitor != nullptr && job->budgetUs > 0 && job->deadline.name == nullptr) {
+    job->deadline.name = job->name;
+    job->deadline.budgetUs = job->budgetUs;
+    if (!monitor->add(&job->deadline)) {
+      job->deadline.name = nullptr;
+    }
+  }
+  uint64_t nowTick = (uint64_t)((nowUs() - originUs) / SCHEDULER_TICK_US);
+  job->dueTick = nowTick + (uint64_t)delayMs * 1000 / SCHEDULER_TICK_US;
+  insert(job, currentTick + 1);
+}
+
+void Scheduler::cancel(SchedulerJob* job) {
+  if (job->head != nullptr) {
+    unlink(job);
+  }
+  if (job == runningJob) {
+    runningCancelled = true;
+  }
+}
+
+void Scheduler::run() {
+  int64_t startUs = nowUs();
+  uint64_t nowTick = (uint64_t)((startUs - originUs) / SCHEDULER_TICK_US);
+
+  while (currentTick < nowTick) {
+    currentTick++;
+
+    // Higher levels first, their jobs may land in the lower level slot
+    // that is cascaded next
+    for (uint8_t level = SCHEDULER_LEVELS - 1; level > 0; level--) {
+      if ((currentTick & ((1ULL << (SCHEDULER_SLOT_BITS * level)) - 1)) == 0) {
+        cascade(level);
+      }
+    }
+
+    // Detach the due jobs, so that jobs can reschedule themselves safely
+    SchedulerJob* due = nullptr;
+    SchedulerJob** slot = &slots[0][currentTick & SLOT_MASK];
+    while (*slot != nullptr) {
+      SchedulerJob* job = *slot;
+      unlink(job);
+      link(&due, job);
+    }
+
+    while (due != nullptr) {
+      SchedulerJob* job = due;
+      unlink(job);
+
+      int64_t beginUs = nowUs();
+      int64_t dueUs = originUs + (int64_t)job->dueTick * SCHEDULER_TICK_US;
+      uint32_t lateUs = beginUs > dueUs ? (uint32_t)(beginUs - dueUs) : 0;
+      if (lateUs > job->maxLateUs) {
+        job->maxLateUs = lateUs;
+      }
+      if (lateUs > job->toleranceMs * 1000 + SCHEDULER_TICK_US) {
+        job->misses++;
+      }
+
+      runningJob = job;
+      runningCancelled = false;
+      job->run(job->context);
+      runningJob = nullptr;
+
+      uint32_t runUs = (uint32_t)(nowUs() - beginUs);
+      job->runs++;
+      job->totalRunUs += runUs;
+      if (runUs > job->maxRunUs) {
+        job->maxRunUs = runUs;
+      }
+      if (monitor != nullptr && job->deadline.name != nullptr) {
+        monitor->record(&job->deadline, beginUs, runUs);
+      }
+
+      // Periodic jobs keep their phase unless the job rescheduled or cancelled itself
+      if (job->periodMs > 0 && job->head == nullptr && !runningCancelled) {
+        uint64_t periodTicks = (uint64_t)job->periodMs * 1000 / SCHEDULER_TICK_US;
+        job->dueTick += periodTicks > 0 ? periodTicks : 1;
+        if (job->dueTick <= currentTick) {
+          // Overrun: skip the periods that are already over
+          job->dueTick = currentTick + 1;
+        }
+        insert(job, currentTick + 1);
+      }
+    }
+  }
+}
+
+uint64_t Scheduler::nextDueTick() const {
+  // Level 0 holds exact ticks, its first used slot after the current one
+  uint64_t next = UINT64_MAX;
+  for (uint8_t offset = 1; offset < SCHEDULER_SLOTS; offset++) {
+    if (slots[0][(currentTick + offset) & SLOT_MASK] != nullptr) {
+      next = currentTick + offset;
+      break;
+    }
+  }
+
+  // Jobs of a higher level may still be earlier. Their slot spans many ticks
+  // and is only cascaded at its start, but run() catches up, so the earliest
+  // job of the first used slot of each level is enough
+  for (uint8_t level = 1; level < SCHEDULER_LEVELS; level++) {
+    uint64_t position = currentTick >> (SCHEDULER_SLOT_BITS * level);
+    for (uint16_t offset = 1; offset <= SCHEDULER_SLOTS; offset++) {
+      const SchedulerJob* job = slots[level][(position + offset) & SLOT_MASK];
+      if (job == nullptr) {
+        continue;
+      }
+      for (; job != nullptr; job = job->next) {
+        if (job->dueTick < next) {
+          next = job->dueTick;
+        }
+      }
+      break;
+    }
+  }
+  return next;
+}
+
+uint32_t Scheduler::nextDueMs() const {
+  uint64_t dueTick = nextDueTick();
+  if (dueTick == UINT64_MAX) {
+    return UINT32_MAX;
+  }
+  int64_t waitUs = originUs + (int64_t)dueTick * SCHEDULER_TICK_US - nowUs();
+  if (waitUs <= 0) {
+    return 0;
+  }
+  uint64_t waitMs = ((uint64_t)waitUs + 999) / 1000;
+  return waitMs < UINT32_MAX ? (uint32_t)waitMs : UINT32_MAX - 1;
+}
+
+void Scheduler::resetStats(SchedulerJob* job) {
+  job->runs = 0;
+  job->misses = 0;
+  job->maxRunUs = 0;
+  job->totalRunUs = 0;
+  job->maxLateUs = 0;
+}
@@ -0,0 +1,153 @@
+#include "shadow_screen.h"
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include "config.h"
+#include "spi_bus.h"
+#include "trace.h"
+
+static TFT_eSprite* canvas = nullptr;
+static TileDiff tileDiff;
+static TileRect rects[SHADOW_MAX_RECTS];
+static uint16_t* bands[2] = { nullptr, nullptr };   // Internal RAM for DMA
+static SpiTransaction bandTransactions[2];
+static SemaphoreHandle_t bandSent[2] = { nullptr, nullptr };
+static int32_t bandPixels = 0;
+static ShadowScreenStats stats;
+
+static void bandDone(SpiTransaction* transaction) {
+  xSemaphoreGive((SemaphoreHandle_t)transaction->context);
+}
+
+bool shadowScreenInit(TFT_eSPI* display) {
+  int32_t width = display->width();
+  int32_t height = display->height();
+
+  // Sprites are placed in PSRAM when it exists and store pixels in display byte order
+  canvas = new TFT_eSprite(display);
+  canvas->setColorDepth(16);
+  uint32_t tiles = TileDiff::tileCount(width, height);
+  uint32_t* hashes = (uint32_t*)heap_caps_malloc(tiles * sizeof(uint32_t), MALLOC_CAP_INTERNAL);
+  if (canvas->createSprite(width, height) == nullptr || hashes == nullptr ||
+      !tileDiff.begin(width, height, hashes, tiles)) {
+    Serial.println("ERROR: Shadow screen could not be allocated!");
+    heap_caps_free(hashes);
+    delete canvas;
+    canvas = nullptr;
+    return false;
+  }
+
+  bandPixels = width * SHADOW_BAND_LINES;
+  for (uint8_t i = 0; i < 2; i++) {
+    bands[i] = (uint16_t*)heap_caps_malloc(bandPixels * sizeof(uint16_t), MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+    bandSent[i] = xSemaphoreCreateBinary();
+    if (bands[i] == nullptr || bandSent[i] == nullptr) {
+      Serial.println("ERROR: Shadow screen band buffers could not be allocated!");
+      canvas->deleteSprite();
+      delete canvas;
+      canvas = nullptr;
+      return false;
+    }
+    bandTransactions[i].device = SpiDevice::DISPLAY;
+    bandTransactions[i].pixels = bands[i];
+    bandTransactions[i].command = nullptr;
+    bandTransactions[i].done = bandDone;
+    bandTransactions[i].context = bandSent[i];
+  }
+
+  memset(&stats, 0, sizeof(stats));
+  Serial.printf("Shadow screen: %dx%d in PSRAM, %u tiles\n", (int)width, (int)height, (unsigned)tiles);
+  return true;
+}
+
+bool shadowScreenReady() {
+  return canvas != nullptr;
+}
+
+TFT_eSprite& shadowScreenCanvas() {
+  return *canvas;
+}
+
+void shadowScreenPush() {
+  if (canvas == nullptr) {
+    return;
+  }
+  TraceScope trace(TracePoint::SHADOW_PUSH);
+  int64_t startUs = esp_timer_get_time();
+  const uint16_t* frame = (const uint16_t*)canvas->getPointer();
+  int32_t stride = canvas->width();
+  uint16_t count = tileDiff.diff(frame, rects, SHADOW_MAX_RECTS);
+  int64_t hashUs = esp_timer_get_time() - startUs;
+
+  // Copy a band out of PSRAM while the bus sends the other one
+  bool inFlight[2] = { false, false };
+  uint8_t current = 0;
+  for (uint16_t i = 0; i < count; i++) {
+    const TileRect& rect = rects[i];
+    int32_t linesPerBand = bandPixels / rect.width;
+    for (int32_t top = 0; top < rect.height; top += linesPerBand) {
+      int32_t lines = rect.height - top < linesPerBand ? rect.height - top : linesPerBand;
+      if (inFlight[current]) {
+        xSemaphoreTake(bandSent[current], portMAX_DELAY);
+        inFlight[current] = false;
+      }
+
+      uint16_t* target = bands[current];
+      for (int32_t line = 0; line < lines; line++) {
+        memcpy(target + line * rect.width, frame + (size_t)(rect.y + top + line) * stride + rect.x,
+               rect.width * sizeof(uint16_t));
+      }
+
+      SpiTransaction& transaction = bandTransactions[current];
+      transaction.x = rect.x;
+      transaction.y = rect.y + top;
+      transaction.width = rect.width;
+      transaction.height = lines;
+      spiBusSubmit(&transaction);
+      inFlight[current] = true;
+      current ^= 1;
+    }
+  }
+
+  for (uint8_t i = 0; i < 2; i++) {
+    if (inFlight[i]) {
+      xSemaphoreTake(bandSent[i], portMAX_DELAY);
+    }
+  }
+
+  uint32_t pushUs = (uint32_t)(esp_timer_get_time() - startUs);
+  stats.pushes++;
+  stats.totalPushUs += pushUs;
+  stats.totalHashUs += (uint64_t)hashUs;
+  if (pushUs > stats.maxPushUs) {
+    stats.maxPushUs = pushUs;
+  }
+}
+
+void shadowScreenInvalidate() {
+  tileDiff.invalidate();
+}
+
+const TileDiffStats& shadowScreenDiffStats() {
+  return tileDiff.stats();
+}
+
+const ShadowScreenStats& shadowScreenStats() {
+  return stats;
+}
+
+void shadowScreenPrintStats() {
+  const TileDiffStats& diff = tileDiff.stats();
+  if (stats.pushes == 0 || diff.pixelsFull == 0) {
+    return;
+  }
+  Serial.printf("Shadow screen: %u pushes, avg %u us (hash %u us), max %u us\n", (unsigned)stats.pushes,
+                (unsigned)(stats.totalPushUs / stats.pushes), (unsigned)(stats.totalHashUs / stats.pushes),
+                (unsigned)stats.maxPushUs);
+  Serial.printf("  %u KB sent instead of %u KB (%u%%), %u dirty tiles in %u rects, %u overflows\n",
+                (unsigned)(diff.pixelsSent * 2 / 1024), (unsigned)(diff.pixelsFull * 2 / 1024),
+                (unsigned)(diff.pixelsSent * 100 / diff.pixelsFull), (unsigned)diff.tilesDirty,
+                (unsigned)diff.rects, (unsigned)diff.overflows);
+}
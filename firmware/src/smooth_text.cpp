@@ -0,0 +1,141 @@
+#include "smooth_text.h"
+#include <Arduino.h>
+#include <SPIFFS.h>
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include "config.h"
+#include "pixel_kernels.h"
+#include "spi_bus.h"
+
+static File fontFile;
+static VlwFont font;
+static GlyphCache cache;
+static uint16_t* band = nullptr;          // One text line, internal RAM for DMA
+static uint8_t* scratch = nullptr;        // Glyphs that do not fit a cache slot
+static int32_t bandWidth = 0;
+static SpiTransaction lineTransaction;
+static SemaphoreHandle_t lineSent = nullptr;
+static uint32_t linesDrawn = 0;
+static uint64_t totalDrawUs = 0;
+
+static bool readFont(void* context, uint32_t offset, uint8_t* target, uint32_t length) {
+  File* file = (File*)context;
+  return file->seek(offset) && file->read(target, length) == length;
+}
+
+static void lineDone(SpiTransaction* transaction) {
+  xSemaphoreGive(lineSent);
+}
+
+bool smoothTextInit(int32_t maxWidth) {
+  fontFile = SPIFFS.open(PLAYER_FONT_FILE, "r");
+  if (!fontFile) {
+    Serial.printf("WARNING: %s not found - player names without smooth font\n", PLAYER_FONT_FILE);
+    return false;
+  }
+
+  VlwGlyph* metrics = (VlwGlyph*)heap_caps_malloc(PLAYER_FONT_MAX_GLYPHS * sizeof(VlwGlyph),
+                                                   MALLOC_CAP_SPIRAM);
+  uint8_t* cacheMemory = (uint8_t*)heap_caps_malloc(GLYPH_CACHE_SIZE, MALLOC_CAP_SPIRAM);
+  if (metrics == nullptr || cacheMemory == nullptr ||
+      !font.load(readFont, &fontFile, 0, metrics, PLAYER_FONT_MAX_GLYPHS) ||
+      !cache.begin(cacheMemory, GLYPH_CACHE_SIZE, font.maxBitmapBytes())) {
+    Serial.println("ERROR: Player font could not be loaded!");
+    heap_caps_free(metrics);
+    heap_caps_free(cacheMemory);
+    font = VlwFont();
+    return false;
+  }
+
+  bandWidth = maxWidth;
+  band = (uint16_t*)heap_caps_malloc((size_t)bandWidth * font.lineHeight() * sizeof(uint16_t),
+                                     MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+  scratch = (uint8_t*)heap_caps_malloc(font.maxBitmapBytes(), MALLOC_CAP_SPIRAM);
+  lineSent = xSemaphoreCreateBinary();
+  if (band == nullptr || scratch == nullptr || lineSent == nullptr) {
+    Serial.println("ERROR: Smooth text buffers could not be allocated!");
+    font = VlwFont();
+    return false;
+  }
+
+  lineTransaction.device = SpiDevice::DISPLAY;
+  lineTransaction.pixels = band;
+  lineTransaction.command = nullptr;
+  lineTransaction.done = lineDone;
+  lineTransaction.context = nullptr;
+
+  Serial.printf("Player font: %u glyphs, %d px line, %u cache slots of %u bytes\n",
+                (unsigned)font.glyphCount(), font.lineHeight(), (unsigned)cache.slotCount(),
+                (unsigned)font.maxBitmapBytes());
+  return true;
+}
+
+bool smoothTextReady() {
+  return font.isLoaded();
+}
+
+int16_t smoothTextLineHeight() {
+  return font.lineHeight();
+}
+
+int32_t smoothTextWidth(const char* text) {
+  return font.isLoaded() ? cache.textWidth(font, text) : 0;
+}
+
+void smoothTextDraw(int32_t x, int32_t y, int32_t width, const char* text, uint16_t foreground,
+                    uint16_t background, bool centered) {
+  if (!font.isLoaded()) {
+    return;
+  }
+  if (width > bandWidth) {
+    width = bandWidth;
+  }
+  int64_t startUs = esp_timer_get_time();
+  smoothTextRender(band, width, text, foreground, background, centered);
+
+  lineTransaction.x = x;
+  lineTransaction.y = y;
+  lineTransaction.width = width;
+  lineTransaction.height = font.lineHeight();
+  spiBusSubmit(&lineTransaction);
+  xSemaphoreTake(lineSent, portMAX_DELAY);   // The band is reused by the next line
+
+  linesDrawn++;
+  totalDrawUs += (uint64_t)(esp_timer_get_time() - startUs);
+}
+
+void smoothTextRender(uint16_t* target, int32_t width, const char* text, uint16_t foreground,
+                      uint16_t background, bool centered) {
+  if (!font.isLoaded()) {
+    return;
+  }
+  int32_t height = font.lineHeight();
+  pixelFill(target, background, width * height);
+  int32_t cursor = centered ? (width - cache.textWidth(font, text)) / 2 : 0;
+  cache.drawText(font, text, cursor, 0, target, width, height, foreground, background, scratch);
+}
+
+const GlyphCacheStats& smoothTextStats() {
+  return cache.stats();
+}
+
+void smoothTextPrintStats() {
+  if (!font.isLoaded()) {
+    return;
+  }
+  const GlyphCacheStats& stats = cache.stats();
+  uint32_t lookups = stats.hits + stats.misses + stats.uncached;
+  Serial.printf("Glyph cache: %u/%u slots, %u hits, %u misses, %u evicted, %u uncached (%u%% hit rate)\n",
+                (unsigned)cache.usedSlots(), (unsigned)cache.slotCount(), (unsigned)stats.hits,
+                (unsigned)stats.misses, (unsigned)stats.evictions, (unsigned)stats.uncached,
+                lookups > 0 ? (unsigned)(stats.hits * 100 / lookups) : 0);
+  Serial.printf("  %u bytes read from SPIFFS, widths %u hits / %u misses / %u collisions\n",
+                (unsigned)stats.bytesRead, (unsigned)stats.widthHits, (unsigned)stats.widthMisses,
+                (unsigned)stats.widthCollisions);
+  if (linesDrawn > 0) {
+    Serial.printf("  %u lines, avg %u us per line\n", (unsigned)linesDrawn,
+                  (unsigned)(totalDrawUs / linesDrawn));
+  }
+}
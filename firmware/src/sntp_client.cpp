@@ -0,0 +1,117 @@
+#include "sntp_client.h"
+#include <Arduino.h>
+#include <WiFi.h>
+#include <WiFiUdp.h>
+#include <esp_timer.h>
+#include "config.h"
+
+enum class SntpClientPhase {
+  WAIT_FOR_BURST,                 // Waiting until the next burst is due
+  SEND_REQUEST,                   // Next request of the burst can be sent
+  WAIT_FOR_REPLY                  // Request sent, waiting for the reply
+};
+
+static WallClock* wallClock = nullptr;
+static WiFiUDP udp;
+static bool udpOpen = false;
+static SntpClientPhase phase = SntpClientPhase::WAIT_FOR_BURST;
+static int64_t nextBurstUs = 0;
+static int64_t requestSentUs = 0;
+static uint64_t requestToken = 0;
+static uint8_t requestsSent = 0;
+
+void sntpClientBegin(WallClock* clock) {
+  wallClock = clock;
+  phase = SntpClientPhase::WAIT_FOR_BURST;
+  nextBurstUs = 0;
+}
+
+static void finishBurst() {
+  int64_t now = esp_timer_get_time();
+
+  if (wallClock->endBurst()) {
+    nextBurstUs = now + (int64_t)wallClock->pollIntervalS() * 1000000LL;
+    Serial.printf("SNTP sync: error %lld us, delay %lld us, drift %.2f ppm, next in %lu s\n",
+                  (long long)wallClock->lastErrorUs(), (long long)wallClock->lastDelayUs(),
+                  wallClock->driftPpm(), (unsigned long)wallClock->pollIntervalS());
+  } else {
+    nextBurstUs = now + (int64_t)WALL_CLOCK_RETRY_S * 1000000LL;
+    Serial.println("SNTP sync failed - retrying later");
+  }
+  phase = SntpClientPhase::WAIT_FOR_BURST;
+}
+
+void sntpClientLoop() {
+  if (wallClock == nullptr || WiFi.status() != WL_CONNECTED) {
+    return;
+  }
+
+  if (!udpOpen) {
+    udpOpen = udp.begin(SNTP_LOCAL_PORT);
+    if (!udpOpen) {
+      return;
+    }
+  }
+
+  int64_t now = esp_timer_get_time();
+
+  switch (phase) {
+    case SntpClientPhase::WAIT_FOR_BURST:
+      if (now >= nextBurstUs) {
+        wallClock->beginBurst();
+        requestsSent = 0;
+        phase = SntpClientPhase::SEND_REQUEST;
+      }
+      break;
+
+    case SntpClientPhase::SEND_REQUEST: {
+      uint8_t packet[SNTP_PACKET_SIZE];
+
+      // Drop replies that arrived after their request timed out
+      while (udp.parsePacket() > 0) {
+        udp.flush();
+      }
+
+      requestToken = ((uint64_t)esp_random() << 32) | (uint32_t)now;
+      sntpBuildRequest(packet, requestToken);
+      requestSentUs = esp_timer_get_time();
+      if (udp.beginPacket(NTP_SERVER, NTP_PORT) && udp.write(packet, sizeof(packet)) &&
+          udp.endPacket()) {
+        requestsSent++;
+        phase = SntpClientPhase::WAIT_FOR_REPLY;
+      } else {
+        finishBurst();
+      }
+      break;
+    }
+
+    case SntpClientPhase::WAIT_FOR_REPLY: {
+      int size = udp.parsePacket();
+      if (size > 0) {
+        int64_t receivedUs = esp_timer_get_time();
+        uint8_t packet[SNTP_PACKET_SIZE];
+        int length = udp.read(packet, sizeof(packet));
+
+        SntpSample sample;
+        sample.localSendUs = requestSentUs;
+        sample.localRecvUs = receivedUs;
+        if (length > 0 &&
+            sntpParseReply(packet, (size_t)length, requestToken,
+                           &sample.serverRecvUs, &sample.serverSendUs)) {
+          wallClock->addSample(sample);
+        } else {
+          break;    // Not our reply, keep waiting
+        }
+      } else if (now - requestSentUs < (int64_t)NTP_TIMEOUT_MS * 1000) {
+        break;
+      }
+
+      if (requestsSent < WALL_CLOCK_BURST_SIZE) {
+        phase = SntpClientPhase::SEND_REQUEST;
+      } else {
+        finishBurst();
+      }
+      break;
+    }
+  }
+}
@@ -0,0 +1,56 @@
+#include "sntp_packet.h"
+#include <string.h>
+
+// Seconds between the NTP era (1900) and the Unix epoch (1970)
+static const uint64_t NTP_UNIX_OFFSET_S = 2208988800ULL;
+
+static void writeBe32(uint8_t* p, uint32_t value) {
+  p[0] = (uint8_t)(value >> 24);
+  p[1] = (uint8_t)(value >> 16);
+  p[2] = (uint8_t)(value >> 8);
+  p[3] = (uint8_t)value;
+}
+
+static uint32_t readBe32(const uint8_t* p) {
+  return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+         ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+static int64_t ntpToUnixUs(const uint8_t* p) {
+  uint64_t seconds = readBe32(p);
+  uint64_t fraction = readBe32(p + 4);
+  return (int64_t)(seconds - NTP_UNIX_OFFSET_S) * 1000000LL +
+         (int64_t)((fraction * 1000000ULL) >> 32);
+}
+
+void sntpBuildRequest(uint8_t* packet, uint64_t token) {
+  memset(packet, 0, SNTP_PACKET_SIZE);
+  packet[0] = (0 << 6) | (4 << 3) | 3;    // LI 0, version 4, mode 3 (client)
+
+  // The transmit timestamp is echoed as originate timestamp by the server
+  writeBe32(packet + 40, (uint32_t)(token >> 32));
+  writeBe32(packet + 44, (uint32_t)token);
+}
+
+bool sntpParseReply(const uint8_t* packet, size_t length, uint64_t token,
+                    int64_t* serverRecvUs, int64_t* serverSendUs) {
+  if (length < SNTP_PACKET_SIZE) {
+    return false;
+  }
+
+  uint8_t leap = packet[0] >> 6;
+  uint8_t mode = packet[0] & 0x07;
+  uint8_t stratum = packet[1];
+  if (leap == 3 || mode != 4 || stratum == 0 || stratum > 15) {
+    return false;   // Unsynchronized server or kiss-of-death packet
+  }
+
+  uint64_t originate = ((uint64_t)readBe32(packet + 24) << 32) | readBe32(packet + 28);
+  if (originate != token) {
+    return false;   // Reply to an older or foreign request
+  }
+
+  *serverRecvUs = ntpToUnixUs(packet + 32);
+  *serverSendUs = ntpToUnixUs(packet + 40);
+  return true;
+}
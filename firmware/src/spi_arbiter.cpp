@@ -0,0 +1,121 @@
+#include "spi_arbiter.h"
+#include <string.h>
+
+SpiArbiter::SpiArbiter() {
+  reset(1, 0);
+}
+
+void SpiArbiter::reset(int32_t lines, int64_t nowUs) {
+  for (int i = 0; i < (int)SpiDevice::COUNT; i++) {
+    heads[i] = nullptr;
+    tails[i] = nullptr;
+  }
+  memset(deviceStats, 0, sizeof(deviceStats));
+  chunkLines = lines > 0 ? lines : 1;
+  periodStartUs = nowUs;
+  windowOpen = false;
+}
+
+void SpiArbiter::enqueue(SpiTransaction* transaction, int64_t nowUs) {
+  int device = (int)transaction->device;
+  transaction->sentLines = 0;
+  transaction->enqueuedUs = nowUs;
+  transaction->started = false;
+  transaction->next = nullptr;
+  if (tails[device] != nullptr) {
+    tails[device]->next = transaction;
+  } else {
+    heads[device] = transaction;
+  }
+  tails[device] = transaction;
+}
+
+bool SpiArbiter::next(SpiWork& work, int64_t nowUs) {
+  for (int device = 0; device < (int)SpiDevice::COUNT; device++) {
+    SpiTransaction* transaction = heads[device];
+    if (transaction == nullptr) {
+      continue;
+    }
+
+    SpiDeviceStats& deviceStat = deviceStats[device];
+    if (!transaction->started) {
+      transaction->started = true;
+      uint32_t waitUs = nowUs > transaction->enqueuedUs ? (uint32_t)(nowUs - transaction->enqueuedUs) : 0;
+      deviceStat.totalWaitUs += waitUs;
+      if (waitUs > deviceStat.maxWaitUs) {
+        deviceStat.maxWaitUs = waitUs;
+      }
+    }
+
+    work.transaction = transaction;
+    work.firstLine = transaction->sentLines;
+    if (transaction->pixels == nullptr) {
+      work.lines = 0;
+      work.continuesWindow = false;
+      work.lastChunk = true;
+      return true;
+    }
+
+    int32_t remaining = transaction->height - transaction->sentLines;
+    work.lines = remaining < chunkLines ? remaining : chunkLines;
+    work.lastChunk = work.lines == remaining;
+    work.continuesWindow = windowOpen && windowX == transaction->x && windowWidth == transaction->width &&
+                           windowNextY == transaction->y + transaction->sentLines;
+    return true;
+  }
+  return false;
+}
+
+bool SpiArbiter::complete(const SpiWork& work, uint32_t busyUs) {
+  SpiTransaction* transaction = work.transaction;
+  SpiDeviceStats& deviceStat = deviceStats[(int)transaction->device];
+  deviceStat.chunks++;
+  deviceStat.busyUs += busyUs;
+
+  if (transaction->pixels != nullptr) {
+    if (work.continuesWindow) {
+      deviceStat.coalesced++;
+    }
+    transaction->sentLines += work.lines;
+    windowOpen = true;
+    windowX = transaction->x;
+    windowWidth = transaction->width;
+    windowNextY = transaction->y + transaction->sentLines;
+  } else {
+    windowOpen = false;
+  }
+
+  if (!work.lastChunk) {
+    return false;
+  }
+
+  int device = (int)transaction->device;
+  heads[device] = transaction->next;
+  if (heads[device] == nullptr) {
+    tails[device] = nullptr;
+  }
+  transaction->next = nullptr;
+  deviceStat.transactions++;
+  return true;
+}
+
+bool SpiArbiter::idle() const {
+  for (int i = 0; i < (int)SpiDevice::COUNT; i++) {
+    if (heads[i] != nullptr) {
+      return false;
+    }
+  }
+  return true;
+}
+
+uint32_t SpiArbiter::utilizationPercent(int64_t nowUs) const {
+  int64_t periodUs = nowUs - periodStartUs;
+  if (periodUs <= 0) {
+    return 0;
+  }
+  uint64_t busyUs = 0;
+  for (int i = 0; i < (int)SpiDevice::COUNT; i++) {
+    busyUs += deviceStats[i].busyUs;
+  }
+  return (uint32_t)(busyUs * 100 / (uint64_t)periodUs);
+}
@@ -0,0 +1,137 @@
+#include "spi_bus.h"
+#include <Arduino.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#include "config.h"
+#include "alloc_guard.h"
+#include "trace.h"
+
+static TFT_eSPI* tft = nullptr;
+static SpiArbiter arbiter;
+static portMUX_TYPE arbiterLock = portMUX_INITIALIZER_UNLOCKED;
+static SemaphoreHandle_t busMutex = nullptr;
+static TaskHandle_t busTask = nullptr;
+static volatile uint32_t directWaiting = 0;
+static bool windowOpen = false;   // Display selected with an address window
+
+static const char* DEVICE_NAMES[(int)SpiDevice::COUNT] = { "touch", "display" };
+
+static void closeWindow() {
+  if (windowOpen) {
+    tft->dmaWait();
+    tft->endWrite();
+    windowOpen = false;
+  }
+}
+
+static void runChunk(const SpiWork& work) {
+  SpiTransaction* transaction = work.transaction;
+  if (transaction->pixels == nullptr) {
+    closeWindow();
+    transaction->command(transaction->context);
+    return;
+  }
+
+  // A direct drawing may have closed the window since next() was called
+  if (!work.continuesWindow || !windowOpen) {
+    closeWindow();
+    tft->startWrite();
+    // Window down to the bottom of the screen, so that the next band can continue it
+    int32_t top = transaction->y + work.firstLine;
+    tft->setAddrWindow(transaction->x, top, transaction->width, tft->height() - top);
+    windowOpen = true;
+  }
+
+  const uint16_t* pixels = transaction->pixels + (size_t)work.firstLine * transaction->width;
+  tft->pushPixelsDMA((uint16_t*)pixels, (uint32_t)(work.lines * transaction->width));
+  if (work.lastChunk) {
+    tft->dmaWait();   // The owner may reuse the buffer after the done callback
+  }
+}
+
+bool spiBusInit(TFT_eSPI* display) {
+  tft = display;
+  busMutex = xSemaphoreCreateMutex();
+  arbiter.reset(SPI_BUS_CHUNK_LINES, esp_timer_get_time());
+  return busMutex != nullptr;
+}
+
+void spiBusSubmit(SpiTransaction* transaction) {
+  portENTER_CRITICAL(&arbiterLock);
+  arbiter.enqueue(transaction, esp_timer_get_time());
+  portEXIT_CRITICAL(&arbiterLock);
+  if (busTask != nullptr) {
+    xTaskNotifyGive(busTask);
+  }
+}
+
+void spiBusAcquire() {
+  directWaiting++;
+  xSemaphoreTake(busMutex, portMAX_DELAY);
+  directWaiting--;
+  closeWindow();
+  portENTER_CRITICAL(&arbiterLock);
+  arbiter.breakWindow();
+  portEXIT_CRITICAL(&arbiterLock);
+}
+
+void spiBusRelease() {
+  xSemaphoreGive(busMutex);
+}
+
+void spiBusTask(void* context) {
+  busTask = xTaskGetCurrentTaskHandle();
+  allocGuardWatchCurrentTask();
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+    SpiWork work;
+    for (;;) {
+      portENTER_CRITICAL(&arbiterLock);
+      bool haveWork = arbiter.next(work, esp_timer_get_time());
+      portEXIT_CRITICAL(&arbiterLock);
+      if (!haveWork) {
+        break;
+      }
+
+      // One chunk at a time, direct drawing and touch get the bus in between
+      xSemaphoreTake(busMutex, portMAX_DELAY);
+      int64_t startUs = esp_timer_get_time();
+      traceBegin(TracePoint::SPI_CHUNK, (uint8_t)work.transaction->device);
+      runChunk(work);
+      traceEnd(TracePoint::SPI_CHUNK, (uint8_t)work.transaction->device);
+      uint32_t busyUs = (uint32_t)(esp_timer_get_time() - startUs);
+
+      portENTER_CRITICAL(&arbiterLock);
+      bool finished = arbiter.complete(work, busyUs);
+      bool close = arbiter.idle() || directWaiting > 0;
+      if (close) {
+        arbiter.breakWindow();
+      }
+      portEXIT_CRITICAL(&arbiterLock);
+      if (close) {
+        closeWindow();
+      }
+      xSemaphoreGive(busMutex);
+
+      if (finished && work.transaction->done != nullptr) {
+        work.transaction->done(work.transaction);
+      }
+    }
+  }
+}
+
+void spiBusPrintStats() {
+  int64_t nowUs = esp_timer_get_time();
+  Serial.printf("SPI bus: %u%% utilization\n", (unsigned)arbiter.utilizationPercent(nowUs));
+  for (int i = 0; i < (int)SpiDevice::COUNT; i++) {
+    const SpiDeviceStats& stats = arbiter.stats((SpiDevice)i);
+    Serial.printf("  %-8s %6u transactions, %7u chunks (%u coalesced), wait avg %u us max %u us\n",
+                  DEVICE_NAMES[i], (unsigned)stats.transactions, (unsigned)stats.chunks,
+                  (unsigned)stats.coalesced,
+                  stats.transactions > 0 ? (unsigned)(stats.totalWaitUs / stats.transactions) : 0,
+                  (unsigned)stats.maxWaitUs);
+  }
+}
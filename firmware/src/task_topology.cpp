@@ -0,0 +1,45 @@
+#include "task_topology.h"
+#include <Arduino.h>
+
+static const TaskSpec* taskTable = nullptr;
+static uint8_t taskCount = 0;
+static TaskHandle_t handles[TASK_TOPOLOGY_MAX_TASKS];
+
+bool taskTopologyStart(const TaskSpec* tasks, uint8_t count) {
+  if (count > TASK_TOPOLOGY_MAX_TASKS) {
+    return false;
+  }
+  taskTable = tasks;
+  taskCount = count;
+
+  bool ok = true;
+  for (uint8_t i = 0; i < count; i++) {
+    BaseType_t core = tasks[i].core < 0 ? tskNO_AFFINITY : tasks[i].core;
+    if (xTaskCreatePinnedToCore(tasks[i].run, tasks[i].name, tasks[i].stackSize, nullptr,
+                                tasks[i].priority, &handles[i], core) != pdPASS) {
+      Serial.printf("ERROR: Could not create task %s!\n", tasks[i].name);
+      handles[i] = nullptr;
+      ok = false;
+    }
+  }
+  return ok;
+}
+
+TaskHandle_t taskTopologyHandle(uint8_t index) {
+  return index < taskCount ? handles[index] : nullptr;
+}
+
+void taskTopologyPrintReport() {
+  Serial.println("Task report:");
+  Serial.printf("  %-12s %4s %4s %6s %10s\n", "task", "core", "prio", "stack", "stack free");
+  for (uint8_t i = 0; i < taskCount; i++) {
+    const TaskSpec& task = taskTable[i];
+    if (handles[i] == nullptr) {
+      Serial.printf("  %-12s not running\n", task.name);
+      continue;
+    }
+    // On ESP-IDF the high water mark is in bytes
+    Serial.printf("  %-12s %4d %4u %6u %10u\n", task.name, task.core, (unsigned)task.priority,
+                  (unsigned)task.stackSize, (unsigned)uxTaskGetStackHighWaterMark(handles[i]));
+  }
+}
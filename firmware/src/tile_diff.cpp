@@ -0,0 +1,158 @@
+#include "tile_diff.h"
+#include <string.h>
+
+TileDiff::TileDiff() : width(0), height(0), columns(0), rows(0), hashes(nullptr), invalid(true) {
+  resetStats();
+}
+
+uint32_t TileDiff::tileCount(int32_t width, int32_t height) {
+  return (uint32_t)(((width + TILE_DIFF_SIZE - 1) / TILE_DIFF_SIZE) *
+                    ((height + TILE_DIFF_SIZE - 1) / TILE_DIFF_SIZE));
+}
+
+bool TileDiff::begin(int32_t width, int32_t height, uint32_t* hashes, uint32_t capacity) {
+  int32_t columns = (width + TILE_DIFF_SIZE - 1) / TILE_DIFF_SIZE;
+  if (width <= 0 || height <= 0 || columns > TILE_DIFF_MAX_COLUMNS || hashes == nullptr ||
+      capacity < tileCount(width, height)) {
+    return false;
+  }
+  this->width = width;
+  this->height = height;
+  this->columns = columns;
+  this->rows = (height + TILE_DIFF_SIZE - 1) / TILE_DIFF_SIZE;
+  this->hashes = hashes;
+  invalid = true;
+  resetStats();
+  return true;
+}
+
+void TileDiff::invalidate() {
+  invalid = true;
+}
+
+void TileDiff::resetStats() {
+  memset(&counters, 0, sizeof(counters));
+}
+
+uint32_t TileDiff::hashTile(const uint16_t* frame, int32_t column, int32_t row) const {
+  int32_t x = column * TILE_DIFF_SIZE;
+  int32_t y = row * TILE_DIFF_SIZE;
+  int32_t tileWidth = width - x < TILE_DIFF_SIZE ? width - x : TILE_DIFF_SIZE;
+  int32_t tileHeight = height - y < TILE_DIFF_SIZE ? height - y : TILE_DIFF_SIZE;
+
+  // FNV-1a over two pixels at a time, the last odd pixel on its own. A
+  // multiply only carries upwards, so the shift folds the high half back:
+  // without it the second pixel of each pair never reaches the low 16
+  // bits and changes to those pixels alone are found with a 16 bit hash.
+  uint32_t hash = 2166136261u;
+  for (int32_t line = 0; line < tileHeight; line++) {
+    const uint16_t* pixel = frame + (size_t)(y + line) * width + x;
+    int32_t i = 0;
+    for (; i + 1 < tileWidth; i += 2) {
+      hash = (hash ^ ((uint32_t)pixel[i] | ((uint32_t)pixel[i + 1] << 16))) * 16777619u;
+      hash ^= hash >> 16;
+    }
+    if (i < tileWidth) {
+      hash = (hash ^ pixel[i]) * 16777619u;
+      hash ^= hash >> 16;
+    }
+  }
+  return hash;
+}
+
+uint16_t TileDiff::diff(const uint16_t* frame, TileRect* rects, uint16_t maxRects) {
+  // Rectangles that reached the previous tile row and may grow downwards
+  struct Open {
+    int16_t first;
+    int16_t last;
+    uint16_t rect;
+  };
+  Open open[TILE_DIFF_MAX_COLUMNS / 2 + 1];
+  Open next[TILE_DIFF_MAX_COLUMNS / 2 + 1];
+  uint8_t openCount = 0;
+
+  uint16_t count = 0;
+  bool overflow = false;
+  int32_t minColumn = columns, maxColumn = -1, minRow = rows, maxRow = -1;
+
+  counters.frames++;
+  counters.pixelsFull += (uint64_t)width * height;
+
+  for (int32_t row = 0; row < rows; row++) {
+    bool dirty[TILE_DIFF_MAX_COLUMNS];
+    for (int32_t column = 0; column < columns; column++) {
+      uint32_t& stored = hashes[row * columns + column];
+      uint32_t hash = hashTile(frame, column, row);
+      dirty[column] = invalid || hash != stored;
+      stored = hash;
+      if (dirty[column]) {
+        counters.tilesDirty++;
+        minColumn = column < minColumn ? column : minColumn;
+        maxColumn = column > maxColumn ? column : maxColumn;
+        minRow = row < minRow ? row : minRow;
+        maxRow = row;
+      }
+    }
+
+    int16_t y = (int16_t)(row * TILE_DIFF_SIZE);
+    int16_t lineCount = (int16_t)(height - y < TILE_DIFF_SIZE ? height - y : TILE_DIFF_SIZE);
+    uint8_t nextCount = 0;
+    int32_t column = 0;
+    while (column < columns) {
+      if (!dirty[column]) {
+        column++;
+        continue;
+      }
+      int16_t first = (int16_t)column;
+      while (column < columns && dirty[column]) {
+        column++;
+      }
+      int16_t last = (int16_t)(column - 1);
+
+      // Same columns as a rectangle of the row above: make it taller
+      bool extended = false;
+      for (uint8_t i = 0; i < openCount && !extended; i++) {
+        if (open[i].first == first && open[i].last == last) {
+          rects[open[i].rect].height += lineCount;
+          next[nextCount++] = open[i];
+          extended = true;
+        }
+      }
+      if (extended) {
+        continue;
+      }
+      if (count >= maxRects) {
+        overflow = true;
+        continue;
+      }
+      TileRect& rect = rects[count];
+      rect.x = (int16_t)(first * TILE_DIFF_SIZE);
+      rect.y = y;
+      rect.width = (int16_t)((last + 1) * TILE_DIFF_SIZE > width ? width - rect.x
+                                                                 : (last + 1 - first) * TILE_DIFF_SIZE);
+      rect.height = lineCount;
+      next[nextCount++] = { first, last, count };
+      count++;
+    }
+
+    memcpy(open, next, nextCount * sizeof(Open));
+    openCount = nextCount;
+  }
+  invalid = false;
+
+  if (overflow && maxRects > 0) {
+    TileRect& box = rects[0];
+    box.x = (int16_t)(minColumn * TILE_DIFF_SIZE);
+    box.y = (int16_t)(minRow * TILE_DIFF_SIZE);
+    box.width = (int16_t)(((maxColumn + 1) * TILE_DIFF_SIZE > width ? width : (maxColumn + 1) * TILE_DIFF_SIZE) - box.x);
+    box.height = (int16_t)(((maxRow + 1) * TILE_DIFF_SIZE > height ? height : (maxRow + 1) * TILE_DIFF_SIZE) - box.y);
+    count = 1;
+    counters.overflows++;
+  }
+
+  counters.rects += count;
+  for (uint16_t i = 0; i < count; i++) {
+    counters.pixelsSent += (uint64_t)rects[i].width * rects[i].height;
+  }
+  return count;
+}
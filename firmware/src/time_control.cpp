@@ -0,0 +1,12 @@
+#include "time_control.h"
+
+const TimeControl TIME_CONTROLS[] = {
+  { "Bullet 1+0",     60,    0 },
+  { "Blitz 3+2",      180,   2 },
+  { "Blitz 5+0",      300,   0 },
+  { "Rapid 10+5",     600,   5 },
+  { "Rapid 15+10",    900,   10 },
+  { "Classical 90+30", 5400, 30 },
+};
+
+const uint8_t TIME_CONTROL_COUNT = sizeof(TIME_CONTROLS) / sizeof(TIME_CONTROLS[0]);
@@ -0,0 +1,88 @@
+#include "time_engine.h"
+
+TimeEngine::TimeEngine() {
+  reset(0, 0);
+}
+
+void TimeEngine::reset(uint32_t baseMs, uint32_t incrementMs) {
+  remaining[(int)Side::WHITE] = (int64_t)baseMs * 1000;
+  remaining[(int)Side::BLACK] = (int64_t)baseMs * 1000;
+  incrementUs = (int64_t)incrementMs * 1000;
+  lastEventUs = 0;
+  moveStartUs = 0;
+  active = Side::WHITE;
+  running = false;
+}
+
+void TimeEngine::restore(uint32_t whiteMs, uint32_t blackMs, uint32_t incrementMs, Side side) {
+  reset(0, incrementMs);
+  remaining[(int)Side::WHITE] = (int64_t)whiteMs * 1000;
+  remaining[(int)Side::BLACK] = (int64_t)blackMs * 1000;
+  active = side;
+  moveStartUs = remaining[(int)side];
+}
+
+void TimeEngine::charge(int64_t timestampUs) {
+  // Edges may arrive slightly out of order between capture channels
+  int64_t elapsed = timestampUs > lastEventUs ? timestampUs - lastEventUs : 0;
+  int64_t& left = remaining[(int)active];
+  left = elapsed < left ? left - elapsed : 0;
+  if (timestampUs > lastEventUs) {
+    lastEventUs = timestampUs;
+  }
+}
+
+void TimeEngine::start(Side side, int64_t timestampUs) {
+  active = side;
+  moveStartUs = remaining[(int)side];
+  lastEventUs = timestampUs;
+  running = true;
+}
+
+uint32_t TimeEngine::press(int64_t timestampUs) {
+  if (!running) {
+    return 0;
+  }
+
+  charge(timestampUs);
+  uint32_t moveMs = (uint32_t)((moveStartUs - remaining[(int)active]) / 1000);
+
+  // No increment once the flag has fallen
+  if (remaining[(int)active] > 0) {
+    remaining[(int)active] += incrementUs;
+  }
+  active = active == Side::WHITE ? Side::BLACK : Side::WHITE;
+  moveStartUs = remaining[(int)active];
+  return moveMs;
+}
+
+void TimeEngine::pause(int64_t timestampUs) {
+  if (running) {
+    charge(timestampUs);
+    running = false;
+  }
+}
+
+void TimeEngine::resume(int64_t timestampUs) {
+  if (!running) {
+    lastEventUs = timestampUs;
+    running = true;
+  }
+}
+
+int64_t TimeEngine::remainingUs(Side side, int64_t nowUs) const {
+  int64_t left = remaining[(int)side];
+  if (running && side == active && nowUs > lastEventUs) {
+    int64_t elapsed = nowUs - lastEventUs;
+    left = elapsed < left ? left - elapsed : 0;
+  }
+  return left;
+}
+
+int64_t TimeEngine::expiryUs() const {
+  return running ? lastEventUs + remaining[(int)active] : INT64_MAX;
+}
+
+bool TimeEngine::flagFallen(int64_t nowUs) const {
+  return running && remainingUs(active, nowUs) == 0;
+}
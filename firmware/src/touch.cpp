@@ -0,0 +1,211 @@
+#include "touch.h"
+#include <Arduino.h>
+#include <driver/gpio.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#include "config.h"
+#include "alloc_guard.h"
+#include "clock_event.h"
+#include "spi_bus.h"
+
+/**
+ * @brief Readings of one sample, filled by the bus task
+ */
+struct TouchSample {
+  uint16_t x[TOUCH_OVERSAMPLE];
+  uint16_t y[TOUCH_OVERSAMPLE];
+  uint16_t z;
+};
+
+static TFT_eSPI* tft = nullptr;
+static TouchFilter filter;
+static TouchStats stats;
+static TouchPoint currentPoint = { 0, 0, false };
+static portMUX_TYPE pointLock = portMUX_INITIALIZER_UNLOCKED;
+static TaskHandle_t task = nullptr;
+static SemaphoreHandle_t sampleReady = nullptr;
+static SpiTransaction sampleTransaction;
+static TouchSample sample;
+static bool sampleQueued = false;   // Submitted and sampleDone() not taken yet (touch task only)
+
+static void IRAM_ATTR onPenDown(void* argument) {
+  // PENIRQ also toggles during conversions, stay off until the pen is up again
+  gpio_intr_disable((gpio_num_t)TOUCH_IRQ_PIN);
+  BaseType_t woken = pdFALSE;
+  if (task != nullptr) {
+    vTaskNotifyGiveFromISR(task, &woken);
+  }
+  if (woken == pdTRUE) {
+    portYIELD_FROM_ISR();
+  }
+}
+
+static void readSample(void* context) {
+  TouchSample* target = (TouchSample*)context;
+  for (uint8_t i = 0; i < TOUCH_OVERSAMPLE; i++) {
+    tft->getTouchRaw(&target->x[i], &target->y[i]);
+  }
+  target->z = tft->getTouchRawZ();
+}
+
+static void sampleDone(SpiTransaction* transaction) {
+  xSemaphoreGive(sampleReady);
+}
+
+static bool waitForSample() {
+  if (xSemaphoreTake(sampleReady, pdMS_TO_TICKS(TOUCH_BUS_TIMEOUT_MS)) != pdTRUE) {
+    stats.busTimeouts++;
+    return false;
+  }
+  sampleQueued = false;
+  return true;
+}
+
+static bool takeSample() {
+  // After a timeout the transaction can still be queued, it must not be
+  // linked into the queue a second time before the bus task is done with it
+  if (sampleQueued && !waitForSample()) {
+    return false;
+  }
+
+  // The bus task runs the readings between two display chunks
+  int64_t submitUs = esp_timer_get_time();
+  sampleQueued = true;
+  spiBusSubmit(&sampleTransaction);
+  if (!waitForSample()) {
+    return false;
+  }
+  uint32_t waitUs = (uint32_t)(esp_timer_get_time() - submitUs);
+  if (waitUs > stats.maxBusWaitUs) {
+    stats.maxBusWaitUs = waitUs;
+  }
+  return true;
+}
+
+static void setPoint(const TouchPoint& point) {
+  portENTER_CRITICAL(&pointLock);
+  currentPoint = point;
+  portEXIT_CRITICAL(&pointLock);
+}
+
+static void postGesture(const TouchGesture& gesture) {
+  ClockEvent* event = clockEventPool.acquire();
+  if (event == nullptr) {
+    stats.dropped++;
+    return;
+  }
+  event->type = ClockEventType::TOUCH_GESTURE;
+  event->source = TOUCH_IRQ_PIN;
+  event->value = (uint32_t)gesture.type;
+  event->timestampUs = gesture.timestampUs;
+  if (clockEventPost(event)) {
+    stats.gestures++;
+  } else {
+    stats.dropped++;
+  }
+}
+
+static void trackTouch() {
+  TouchGesture gesture;
+  for (;;) {
+    if (!takeSample()) {
+      break;
+    }
+    if (sample.z < TOUCH_Z_THRESHOLD || digitalRead(TOUCH_IRQ_PIN) == HIGH) {
+      stats.weakSamples++;
+      break;   // Pen lifted
+    }
+    stats.samples++;
+    if (filter.addSample(sample.x, sample.y, TOUCH_OVERSAMPLE, esp_timer_get_time(), &gesture)) {
+      postGesture(gesture);
+    }
+    setPoint(filter.point());
+    vTaskDelay(pdMS_TO_TICKS(TOUCH_SAMPLE_MS));
+  }
+
+  if (filter.penUp(esp_timer_get_time(), &gesture)) {
+    postGesture(gesture);
+  }
+  setPoint(filter.point());
+}
+
+bool touchInit(TFT_eSPI* display, int16_t width, int16_t height) {
+  tft = display;
+  touchResetStats();
+
+  TouchCalibration calibration;
+  calibration.rawXMin = TOUCH_CAL_RAW_X_MIN;
+  calibration.rawXMax = TOUCH_CAL_RAW_X_MAX;
+  calibration.rawYMin = TOUCH_CAL_RAW_Y_MIN;
+  calibration.rawYMax = TOUCH_CAL_RAW_Y_MAX;
+  calibration.swapXY = TOUCH_CAL_SWAP_XY;
+  calibration.invertX = TOUCH_CAL_INVERT_X;
+  calibration.invertY = TOUCH_CAL_INVERT_Y;
+  calibration.width = width;
+  calibration.height = height;
+  filter.begin(calibration);
+
+  sampleTransaction.device = SpiDevice::TOUCH;
+  sampleTransaction.pixels = nullptr;
+  sampleTransaction.command = readSample;
+  sampleTransaction.done = sampleDone;
+  sampleTransaction.context = &sample;
+
+  sampleReady = xSemaphoreCreateBinary();
+  if (sampleReady == nullptr || !clockEventQueueInit()) {
+    return false;
+  }
+
+  // The interrupt stays disabled until the touch task is running
+  pinMode(TOUCH_IRQ_PIN, INPUT_PULLUP);
+  gpio_set_intr_type((gpio_num_t)TOUCH_IRQ_PIN, GPIO_INTR_NEGEDGE);
+  esp_err_t result = gpio_install_isr_service(0);
+  if (result != ESP_OK && result != ESP_ERR_INVALID_STATE) {
+    return false;   // INVALID_STATE: already installed by someone else
+  }
+  gpio_intr_disable((gpio_num_t)TOUCH_IRQ_PIN);
+  return gpio_isr_handler_add((gpio_num_t)TOUCH_IRQ_PIN, onPenDown, nullptr) == ESP_OK;
+}
+
+void touchTask(void* context) {
+  task = xTaskGetCurrentTaskHandle();
+  allocGuardWatchCurrentTask();
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, 0);
+    gpio_intr_enable((gpio_num_t)TOUCH_IRQ_PIN);
+    // The pen may already be down again, the edge was missed then
+    if (digitalRead(TOUCH_IRQ_PIN) == HIGH) {
+      ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    } else {
+      gpio_intr_disable((gpio_num_t)TOUCH_IRQ_PIN);
+    }
+    stats.wakeups++;
+    trackTouch();
+  }
+}
+
+TouchPoint touchPoint() {
+  portENTER_CRITICAL(&pointLock);
+  TouchPoint point = currentPoint;
+  portEXIT_CRITICAL(&pointLock);
+  return point;
+}
+
+TouchStats touchStats() {
+  return stats;
+}
+
+void touchResetStats() {
+  memset(&stats, 0, sizeof(stats));
+}
+
+void touchPrintStats() {
+  TouchStats current = touchStats();
+  Serial.printf("Touch: %u wakeups, %u samples, %u weak, %u gestures, %u dropped\n",
+                (unsigned)current.wakeups, (unsigned)current.samples, (unsigned)current.weakSamples,
+                (unsigned)current.gestures, (unsigned)current.dropped);
+  Serial.printf("  max bus wait per sample: %u us, %u timeouts\n", (unsigned)current.maxBusWaitUs,
+                (unsigned)current.busTimeouts);
+}
@@ -0,0 +1,140 @@
+#include "touch_filter.h"
+#include <stdlib.h>
+#include "config.h"
+
+TouchFilter::TouchFilter() {
+  TouchCalibration calibration = {};
+  begin(calibration);
+}
+
+void TouchFilter::begin(const TouchCalibration& calibration) {
+  cal = calibration;
+  pressed = false;
+  longPressSent = false;
+  moved = false;
+  filteredX = 0;
+  filteredY = 0;
+  startX = 0;
+  startY = 0;
+  startUs = 0;
+}
+
+uint16_t TouchFilter::median(const uint16_t* values, uint8_t count) {
+  uint16_t sorted[TOUCH_FILTER_MAX_READINGS];
+  for (uint8_t i = 0; i < count; i++) {
+    uint16_t value = values[i];
+    uint8_t j = i;
+    while (j > 0 && sorted[j - 1] > value) {
+      sorted[j] = sorted[j - 1];
+      j--;
+    }
+    sorted[j] = value;
+  }
+  return sorted[count / 2];
+}
+
+static int32_t scale(uint16_t raw, uint16_t rawMin, uint16_t rawMax, int16_t size) {
+  if (rawMax <= rawMin) {
+    return 0;
+  }
+  int32_t value = ((int32_t)raw - rawMin) * size / (rawMax - rawMin);
+  return value < 0 ? 0 : (value >= size ? size - 1 : value);
+}
+
+void TouchFilter::calibrate(uint16_t rawX, uint16_t rawY, int32_t* x, int32_t* y) const {
+  if (cal.swapXY) {
+    *x = scale(rawY, cal.rawYMin, cal.rawYMax, cal.width);
+    *y = scale(rawX, cal.rawXMin, cal.rawXMax, cal.height);
+  } else {
+    *x = scale(rawX, cal.rawXMin, cal.rawXMax, cal.width);
+    *y = scale(rawY, cal.rawYMin, cal.rawYMax, cal.height);
+  }
+  if (cal.invertX) {
+    *x = cal.width - 1 - *x;
+  }
+  if (cal.invertY) {
+    *y = cal.height - 1 - *y;
+  }
+}
+
+bool TouchFilter::addSample(const uint16_t* rawX, const uint16_t* rawY, uint8_t count, int64_t nowUs,
+                            TouchGesture* gesture) {
+  if (count == 0 || count > TOUCH_FILTER_MAX_READINGS) {
+    return false;
+  }
+
+  int32_t x, y;
+  calibrate(median(rawX, count), median(rawY, count), &x, &y);
+
+  if (!pressed) {
+    // First sample of a touch, nothing to smooth with yet
+    pressed = true;
+    longPressSent = false;
+    moved = false;
+    filteredX = x << 8;
+    filteredY = y << 8;
+    startX = (int16_t)x;
+    startY = (int16_t)y;
+    startUs = nowUs;
+    return false;
+  }
+
+  filteredX += ((x << 8) - filteredX) >> TOUCH_IIR_SHIFT;
+  filteredY += ((y << 8) - filteredY) >> TOUCH_IIR_SHIFT;
+
+  int32_t dx = (filteredX >> 8) - startX;
+  int32_t dy = (filteredY >> 8) - startY;
+  if (abs(dx) > TOUCH_MOVE_MAX_PX || abs(dy) > TOUCH_MOVE_MAX_PX) {
+    moved = true;
+  }
+
+  if (!moved && !longPressSent && nowUs - startUs >= (int64_t)TOUCH_LONG_PRESS_MS * 1000) {
+    longPressSent = true;
+    gesture->type = TouchGestureType::LONG_PRESS;
+    gesture->x = startX;
+    gesture->y = startY;
+    gesture->timestampUs = nowUs;
+    return true;
+  }
+  return false;
+}
+
+bool TouchFilter::penUp(int64_t nowUs, TouchGesture* gesture) {
+  if (!pressed) {
+    return false;
+  }
+  pressed = false;
+  if (longPressSent) {
+    return false;   // Already reported while the pen was down
+  }
+
+  int32_t dx = (filteredX >> 8) - startX;
+  int32_t dy = (filteredY >> 8) - startY;
+  TouchGestureType type = TouchGestureType::NONE;
+  if (abs(dx) >= TOUCH_SWIPE_MIN_PX || abs(dy) >= TOUCH_SWIPE_MIN_PX) {
+    if (abs(dx) >= abs(dy)) {
+      type = dx > 0 ? TouchGestureType::SWIPE_RIGHT : TouchGestureType::SWIPE_LEFT;
+    } else {
+      type = dy > 0 ? TouchGestureType::SWIPE_DOWN : TouchGestureType::SWIPE_UP;
+    }
+  } else if (!moved && nowUs - startUs <= (int64_t)TOUCH_TAP_MAX_MS * 1000) {
+    type = TouchGestureType::TAP;
+  }
+
+  if (type == TouchGestureType::NONE) {
+    return false;
+  }
+  gesture->type = type;
+  gesture->x = startX;
+  gesture->y = startY;
+  gesture->timestampUs = nowUs;
+  return true;
+}
+
+TouchPoint TouchFilter::point() const {
+  TouchPoint result;
+  result.x = (int16_t)(filteredX >> 8);
+  result.y = (int16_t)(filteredY >> 8);
+  result.pressed = pressed;
+  return result;
+}
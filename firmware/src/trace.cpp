@@ -0,0 +1,97 @@
+#include "trace.h"
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <hal/cpu_hal.h>
+
+#define TRACE_DUMP_MAX_TASKS 32
+
+static const char* const POINT_NAMES[(int)TracePoint::COUNT] = {
+  "state", "event", "render_state", "clock_frame", "shadow_push", "spi_chunk", "flash_write", "network_send",
+  "trigger",
+};
+
+static TraceRing rings[2];
+static volatile bool recording = false;
+static volatile bool triggered = false;
+static uint32_t triggerUs = 0;
+
+bool traceInit() {
+  for (uint32_t core = 0; core < 2; core++) {
+    TraceEvent* storage = (TraceEvent*)heap_caps_malloc(TRACE_RING_EVENTS * sizeof(TraceEvent), MALLOC_CAP_SPIRAM);
+    if (storage == nullptr || !rings[core].begin(storage, TRACE_RING_EVENTS)) {
+      Serial.println("ERROR: No memory for the trace rings!");
+      return false;
+    }
+  }
+  recording = true;
+  return true;
+}
+
+void traceRecord(TracePoint point, TracePhase phase, uint8_t arg) {
+  if (!recording) {
+    return;
+  }
+  rings[xPortGetCoreID()].record(cpu_hal_get_cycle_count(), (uint32_t)esp_timer_get_time(),
+                                 (uint32_t)(uintptr_t)xTaskGetCurrentTaskHandle(), (uint16_t)point, phase, arg);
+}
+
+void traceCheckLatency(uint32_t lateUs) {
+  if (!TRACE_ENABLED || !recording || lateUs < TRACE_TRIGGER_US) {
+    return;
+  }
+  traceInstant(TracePoint::TRIGGER, lateUs / 1000 < 255 ? (uint8_t)(lateUs / 1000) : 255);
+  triggerUs = (uint32_t)esp_timer_get_time();
+  recording = false;
+  triggered = true;
+}
+
+static void printTask(uint32_t task, uint32_t* known, uint8_t* knownCount) {
+  for (uint8_t i = 0; i < *knownCount; i++) {
+    if (known[i] == task) {
+      return;
+    }
+  }
+  if (*knownCount < TRACE_DUMP_MAX_TASKS) {
+    known[(*knownCount)++] = task;
+  }
+  const char* name = task != 0 ? pcTaskGetName((TaskHandle_t)(uintptr_t)task) : "none";
+  Serial.printf("@K %08x %s\n", (unsigned)task, name);
+}
+
+void traceDumpIfTriggered() {
+  if (!triggered) {
+    return;
+  }
+
+  Serial.printf("@F %u\n", (unsigned)getCpuFrequencyMhz());
+  for (int i = 0; i < (int)TracePoint::COUNT; i++) {
+    Serial.printf("@N %d %s\n", i, POINT_NAMES[i]);
+  }
+
+  uint32_t known[TRACE_DUMP_MAX_TASKS];
+  uint8_t knownCount = 0;
+  uint32_t events = 0;
+  for (uint32_t core = 0; core < 2; core++) {
+    TraceRing& ring = rings[core];
+    for (uint32_t slot = ring.oldest(); slot != ring.recorded(); slot++) {
+      TraceEvent event;
+      if (!ring.read(slot, &event) || triggerUs - event.timeUs > TRACE_DUMP_WINDOW_MS * 1000UL) {
+        continue;
+      }
+      printTask(event.task, known, &knownCount);
+      Serial.printf("@E %u %08x %u %08x %u %c %u\n", (unsigned)core, (unsigned)event.cycles,
+                    (unsigned)event.timeUs, (unsigned)event.task, (unsigned)event.point, (char)event.phase,
+                    (unsigned)event.arg);
+      events++;
+    }
+  }
+  Serial.println("@X");
+  Serial.printf("Trace: %u events of the last %u ms before a late input\n", (unsigned)events,
+                (unsigned)TRACE_DUMP_WINDOW_MS);
+
+  triggered = false;
+  recording = true;
+}
@@ -0,0 +1,42 @@
+#include "trace_ring.h"
+
+TraceRing::TraceRing() : events(nullptr), capacity(0), written(0) {
+}
+
+bool TraceRing::begin(TraceEvent* storage, uint32_t capacity) {
+  if (capacity == 0 || (capacity & (capacity - 1)) != 0) {
+    return false;
+  }
+  for (uint32_t i = 0; i < capacity; i++) {
+    storage[i].sequence = 0;
+  }
+  this->capacity = capacity;
+  written.store(0);
+  events = storage;
+  return true;
+}
+
+uint32_t TraceRing::oldest() const {
+  uint32_t next = recorded();
+  return next > capacity ? next - capacity : 0;
+}
+
+bool TraceRing::read(uint32_t slot, TraceEvent* event) const {
+  if (events == nullptr) {
+    return false;
+  }
+  const TraceEvent& source = events[slot & (capacity - 1)];
+  if (__atomic_load_n(&source.sequence, __ATOMIC_ACQUIRE) != slot + 1) {
+    return false;
+  }
+  event->cycles = source.cycles;
+  event->timeUs = source.timeUs;
+  event->task = source.task;
+  event->point = source.point;
+  event->phase = source.phase;
+  event->arg = source.arg;
+  __atomic_thread_fence(__ATOMIC_ACQUIRE);
+  // A writer that claimed the slot meanwhile has cleared the sequence first
+  event->sequence = __atomic_load_n(&source.sequence, __ATOMIC_RELAXED);
+  return event->sequence == slot + 1;
+}
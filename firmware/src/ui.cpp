@@ -0,0 +1,51 @@
+#include "ui.h"
+#include <Arduino.h>
+#include <lvgl.h>
+#include "lvgl_port.h"
+
+static ChessClockState shownState = ChessClockState::START;
+static bool uiActive = false;
+
+static void printScreenStats(ChessClockState state) {
+  const LvglPortStats& stats = lvglPortStats();
+  if (stats.frames == 0) {
+    return;
+  }
+  Serial.printf("UI %s: %lu frames, avg %lu us, max %lu us, %lu flushes, %lu bytes\n",
+                stateToString(state), (unsigned long)stats.frames,
+                (unsigned long)(stats.totalFrameUs / stats.frames),
+                (unsigned long)stats.maxFrameUs, (unsigned long)stats.flushes,
+                (unsigned long)stats.flushBytes);
+}
+
+bool uiInit(TFT_eSPI* display, UiTransitionCallback onTransition) {
+  uiScreensBegin(onTransition);
+  return lvglPortInit(display);
+}
+
+void uiShowState(ChessClockState state) {
+  if (uiActive) {
+    printScreenStats(shownState);
+  }
+
+  UiScreen* target = uiScreenForState(state);
+  uiActive = (target != nullptr);
+  shownState = state;
+  if (!uiActive) {
+    return;
+  }
+
+  lv_scr_load(target->screen);
+  lvglPortSetGroup(target->group);
+  lvglPortResetStats();
+}
+
+void uiLoop() {
+  if (uiActive) {
+    lvglPortLoop();
+  }
+}
+
+int16_t uiEncoderSteps() {
+  return lvglPortEncoderSteps();
+}
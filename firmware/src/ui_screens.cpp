@@ -0,0 +1,157 @@
+#include "ui_screens.h"
+#include <stdio.h>
+#include "config.h"
+#include "time_control.h"
+
+static UiTransitionCallback transition = nullptr;
+static UiScreen mainMenu = { nullptr, nullptr };
+static UiScreen modeSelection = { nullptr, nullptr };
+static UiScreen playerEntry = { nullptr, nullptr };
+
+static uint8_t selectedTimeControl = 0;
+static lv_obj_t* firstNameArea = nullptr;
+static lv_obj_t* lastNameArea = nullptr;
+static char playerFirstName[PLAYER_NAME_MAX_LENGTH + 1] = "";
+static char playerLastName[PLAYER_NAME_MAX_LENGTH + 1] = "";
+
+static void requestTransition(lv_event_t* event) {
+  ChessClockState next = (ChessClockState)(uintptr_t)lv_event_get_user_data(event);
+  if (transition != nullptr) {
+    transition(next);
+  }
+}
+
+static void selectTimeControl(lv_event_t* event) {
+  selectedTimeControl = (uint8_t)(uintptr_t)lv_event_get_user_data(event);
+  if (transition != nullptr) {
+    transition(ChessClockState::WAIT_FOR_WHITE_PLAYER_SELECTION);
+  }
+}
+
+static void savePlayer(lv_event_t* event) {
+  snprintf(playerFirstName, sizeof(playerFirstName), "%s", lv_textarea_get_text(firstNameArea));
+  snprintf(playerLastName, sizeof(playerLastName), "%s", lv_textarea_get_text(lastNameArea));
+  lv_textarea_set_text(firstNameArea, "");
+  lv_textarea_set_text(lastNameArea, "");
+  if (transition != nullptr) {
+    transition(ChessClockState::MAIN_MENU);
+  }
+}
+
+static void attachKeyboard(lv_event_t* event) {
+  lv_obj_t* keyboard = (lv_obj_t*)lv_event_get_user_data(event);
+  lv_keyboard_set_textarea(keyboard, lv_event_get_target(event));
+}
+
+static UiScreen createScreen(const char* title) {
+  UiScreen result;
+  result.screen = lv_obj_create(NULL);
+  result.group = lv_group_create();
+  lv_obj_set_style_bg_color(result.screen, lv_color_black(), 0);
+  lv_obj_set_flex_flow(result.screen, LV_FLEX_FLOW_COLUMN);
+  lv_obj_set_flex_align(result.screen, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+
+  lv_obj_t* label = lv_label_create(result.screen);
+  lv_obj_set_style_text_font(label, &lv_font_montserrat_28, 0);
+  lv_obj_set_style_text_color(label, lv_color_white(), 0);
+  lv_label_set_text(label, title);
+  return result;
+}
+
+static lv_obj_t* addButton(UiScreen& target, const char* text, lv_event_cb_t callback, void* userData) {
+  lv_obj_t* button = lv_btn_create(target.screen);
+  lv_obj_set_width(button, LV_PCT(80));
+  lv_obj_add_event_cb(button, callback, LV_EVENT_CLICKED, userData);
+  lv_group_add_obj(target.group, button);
+
+  lv_obj_t* label = lv_label_create(button);
+  lv_obj_set_style_text_font(label, &lv_font_montserrat_20, 0);
+  lv_label_set_text(label, text);
+  lv_obj_center(label);
+  return button;
+}
+
+static void buildMainMenu() {
+  mainMenu = createScreen("Main menu");
+  addButton(mainMenu, "Play game", requestTransition,
+            (void*)(uintptr_t)ChessClockState::WAIT_FOR_MODE_SELECTION);
+  addButton(mainMenu, "Create player", requestTransition,
+            (void*)(uintptr_t)ChessClockState::ENTER_PLAYER_NAME);
+}
+
+static void buildModeSelection() {
+  modeSelection = createScreen("Select mode");
+  lv_obj_t* list = lv_list_create(modeSelection.screen);
+  lv_obj_set_size(list, LV_PCT(90), LV_PCT(75));
+
+  for (uint8_t i = 0; i < TIME_CONTROL_COUNT; i++) {
+    lv_obj_t* button = lv_list_add_btn(list, NULL, TIME_CONTROLS[i].name);
+    lv_obj_set_style_text_font(button, &lv_font_montserrat_20, 0);
+    lv_obj_add_event_cb(button, selectTimeControl, LV_EVENT_CLICKED, (void*)(uintptr_t)i);
+    lv_group_add_obj(modeSelection.group, button);
+  }
+}
+
+static void buildPlayerEntry() {
+  playerEntry = createScreen("New player");
+  lv_obj_set_style_pad_row(playerEntry.screen, 4, 0);
+
+  firstNameArea = lv_textarea_create(playerEntry.screen);
+  lastNameArea = lv_textarea_create(playerEntry.screen);
+  lv_obj_t* keyboard = lv_keyboard_create(playerEntry.screen);
+  lv_obj_set_size(keyboard, LV_PCT(100), LV_PCT(40));
+  lv_keyboard_set_textarea(keyboard, firstNameArea);
+
+  lv_obj_t* areas[] = { firstNameArea, lastNameArea };
+  const char* placeholders[] = { "First name", "Last name" };
+  for (uint8_t i = 0; i < 2; i++) {
+    lv_textarea_set_one_line(areas[i], true);
+    lv_textarea_set_max_length(areas[i], PLAYER_NAME_MAX_LENGTH);
+    lv_textarea_set_placeholder_text(areas[i], placeholders[i]);
+    lv_obj_set_width(areas[i], LV_PCT(80));
+    lv_obj_add_event_cb(areas[i], attachKeyboard, LV_EVENT_FOCUSED, keyboard);
+    lv_group_add_obj(playerEntry.group, areas[i]);
+  }
+
+  // Focus order: first name, last name, keyboard, save
+  lv_group_add_obj(playerEntry.group, keyboard);
+  addButton(playerEntry, "Save", savePlayer, NULL);
+}
+
+UiScreen* uiScreenForState(ChessClockState state) {
+  switch (state) {
+    case ChessClockState::MAIN_MENU:
+      if (mainMenu.screen == nullptr) buildMainMenu();
+      return &mainMenu;
+    case ChessClockState::WAIT_FOR_MODE_SELECTION:
+      if (modeSelection.screen == nullptr) buildModeSelection();
+      return &modeSelection;
+    case ChessClockState::ENTER_PLAYER_NAME:
+      if (playerEntry.screen == nullptr) buildPlayerEntry();
+      return &playerEntry;
+    default:
+      return nullptr;
+  }
+}
+
+void uiScreensBegin(UiTransitionCallback onTransition) {
+  transition = onTransition;
+}
+
+bool uiHandlesState(ChessClockState state) {
+  return state == ChessClockState::MAIN_MENU ||
+         state == ChessClockState::WAIT_FOR_MODE_SELECTION ||
+         state == ChessClockState::ENTER_PLAYER_NAME;
+}
+
+uint8_t uiSelectedTimeControl() {
+  return selectedTimeControl;
+}
+
+const char* uiPlayerFirstName() {
+  return playerFirstName;
+}
+
+const char* uiPlayerLastName() {
+  return playerLastName;
+}
@@ -0,0 +1,59 @@
+#include "virtual_list.h"
+
+VirtualList::VirtualList() {
+  begin(0, 1, false);
+}
+
+void VirtualList::begin(uint32_t count, uint16_t visible, bool ring) {
+  rows = count;
+  visibleRows = visible > 0 ? visible : 1;
+  ringMode = ring;
+  selection = 0;
+  first = 0;
+}
+
+ListUpdate VirtualList::move(int32_t delta) {
+  ListUpdate update = {};
+  update.oldSelected = selection;
+  update.selected = selection;
+  if (rows == 0) {
+    return update;
+  }
+
+  int64_t target = (int64_t)selection + delta;
+  selection = target < 0 ? 0 : (target >= (int64_t)rows ? rows - 1 : (uint32_t)target);
+  update.selected = selection;
+  update.selectionChanged = selection != update.oldSelected;
+
+  // Keep the selection in view with as little scrolling as possible
+  uint32_t oldFirst = first;
+  if (selection < first) {
+    first = selection;
+  } else if (selection >= first + visibleRows) {
+    first = selection - visibleRows + 1;
+  }
+  update.scrolled = (int32_t)(first - oldFirst);
+
+  if (update.scrolled != 0) {
+    uint32_t distance = update.scrolled > 0 ? (uint32_t)update.scrolled : (uint32_t)-update.scrolled;
+    if (!ringMode || distance >= visibleRows) {
+      update.full = true;
+    } else {
+      update.newCount = distance;
+      update.newFirst = update.scrolled > 0 ? oldFirst + visibleRows : first;
+    }
+  }
+  return update;
+}
+
+uint16_t VirtualList::slot(uint32_t index) const {
+  return (uint16_t)(ringMode ? index % visibleRows : index - first);
+}
+
+uint16_t VirtualList::scrollSlot() const {
+  return (uint16_t)(ringMode ? first % visibleRows : 0);
+}
+
+bool VirtualList::isVisible(uint32_t index) const {
+  return index >= first && index < first + visibleRows && index < rows;
+}
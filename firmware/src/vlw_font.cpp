@@ -0,0 +1,105 @@
+#include "vlw_font.h"
+
+#define VLW_HEADER_SIZE 24
+#define VLW_METRICS_SIZE 28
+
+static uint32_t readBigEndian(const uint8_t* bytes) {
+  return ((uint32_t)bytes[0] << 24) | ((uint32_t)bytes[1] << 16) | ((uint32_t)bytes[2] << 8) | bytes[3];
+}
+
+VlwFont::VlwFont()
+    : reader(nullptr), readerContext(nullptr), glyphs(nullptr), count(0), fontId(0), pointSize(0),
+      fontAscent(0), yAdvance(0), space(0), maxBitmap(0) {
+}
+
+bool VlwFont::load(VlwReadCallback read, void* context, uint8_t id, VlwGlyph* storage, uint16_t capacity) {
+  glyphs = nullptr;
+  uint8_t header[VLW_HEADER_SIZE];
+  if (!read(context, 0, header, sizeof(header))) {
+    return false;
+  }
+
+  uint32_t glyphsInFile = readBigEndian(header);
+  if (glyphsInFile == 0 || glyphsInFile > capacity) {
+    return false;
+  }
+  pointSize = (uint8_t)readBigEndian(header + 8);
+  fontAscent = (int16_t)readBigEndian(header + 16);
+  int16_t descent = (int16_t)readBigEndian(header + 20);
+  int16_t maxDescent = descent;
+
+  // Same rules as TFT_eSPI, so text lines up with its own smooth font rendering
+  uint32_t bitmapOffset = VLW_HEADER_SIZE + glyphsInFile * VLW_METRICS_SIZE;
+  maxBitmap = 0;
+  uint16_t stored = 0;
+  for (uint32_t i = 0; i < glyphsInFile; i++) {
+    uint8_t metrics[VLW_METRICS_SIZE];
+    if (!read(context, VLW_HEADER_SIZE + i * VLW_METRICS_SIZE, metrics, sizeof(metrics))) {
+      return false;
+    }
+    VlwGlyph glyph;
+    uint32_t codepoint = readBigEndian(metrics);
+    glyph.codepoint = (uint16_t)codepoint;
+    glyph.height = (uint8_t)readBigEndian(metrics + 4);
+    glyph.width = (uint8_t)readBigEndian(metrics + 8);
+    glyph.xAdvance = (uint8_t)readBigEndian(metrics + 12);
+    glyph.dY = (int16_t)readBigEndian(metrics + 16);
+    glyph.dX = (int8_t)readBigEndian(metrics + 20);
+    glyph.bitmapOffset = bitmapOffset;
+    bitmapOffset += (uint32_t)glyph.width * glyph.height;
+
+    // Outside the Basic Multilingual Plane: skip, it would alias a BMP glyph
+    if (codepoint > 0xFFFF) {
+      continue;
+    }
+
+    uint16_t bitmapBytes = (uint16_t)(glyph.width * glyph.height);
+    if (bitmapBytes > maxBitmap) {
+      maxBitmap = bitmapBytes;
+    }
+    bool printable = (glyph.codepoint > 0x20 && glyph.codepoint < 0xA0 && glyph.codepoint != 0x7F) ||
+                     glyph.codepoint > 0xFF;
+    if (printable && glyph.height - glyph.dY > maxDescent) {
+      maxDescent = glyph.height - glyph.dY;
+    }
+
+    // Keep the table sorted for the binary search, converters normally write it sorted already
+    uint16_t index = stored++;
+    while (index > 0 && storage[index - 1].codepoint > glyph.codepoint) {
+      storage[index] = storage[index - 1];
+      index--;
+    }
+    storage[index] = glyph;
+  }
+
+  reader = read;
+  readerContext = context;
+  glyphs = storage;
+  count = stored;
+  fontId = id;
+  yAdvance = fontAscent + maxDescent;
+  space = (int16_t)((fontAscent + descent) * 2 / 7);
+  return true;
+}
+
+const VlwGlyph* VlwFont::find(uint32_t codepoint) const {
+  if (codepoint > 0xFFFF) {
+    return nullptr;   // Not loaded, see load()
+  }
+  uint16_t low = 0;
+  uint16_t high = count;
+  while (low < high) {
+    uint16_t middle = (uint16_t)((low + high) / 2);
+    if (glyphs[middle].codepoint < codepoint) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  return low < count && glyphs[low].codepoint == codepoint ? &glyphs[low] : nullptr;
+}
+
+bool VlwFont::readBitmap(const VlwGlyph& glyph, uint8_t* target) const {
+  uint32_t length = (uint32_t)glyph.width * glyph.height;
+  return length == 0 || reader(readerContext, glyph.bitmapOffset, target, length);
+}
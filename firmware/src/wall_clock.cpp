@@ -0,0 +1,137 @@
+#include "wall_clock.h"
+#include "config.h"
+
+WallClock::WallClock() : sequence(0) {
+  reset();
+}
+
+void WallClock::reset() {
+  publish({ false, 0, 0, 0.0 });
+  lastError = 0;
+  lastDelay = 0;
+  pollInterval = WALL_CLOCK_MIN_POLL_S;
+  syncCount = 0;
+  haveBest = false;
+  bestDelay = 0;
+}
+
+WallClock::Timebase WallClock::readTimebase() const {
+  Timebase copy;
+  uint32_t before;
+  do {
+    before = sequence.load(std::memory_order_acquire);
+    copy = timebase;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    // Retry while the writer was in the middle of an update
+  } while ((before & 1) != 0 || sequence.load(std::memory_order_relaxed) != before);
+  return copy;
+}
+
+void WallClock::publish(const Timebase& next) {
+  uint32_t current = sequence.load(std::memory_order_relaxed);
+  sequence.store(current + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  timebase = next;
+  sequence.store(current + 2, std::memory_order_release);
+}
+
+bool WallClock::isSynced() const {
+  return readTimebase().synced;
+}
+
+double WallClock::driftPpm() const {
+  return readTimebase().drift * 1e6;
+}
+
+void WallClock::beginBurst() {
+  haveBest = false;
+}
+
+bool WallClock::addSample(const SntpSample& sample) {
+  int64_t delay = (sample.localRecvUs - sample.localSendUs) -
+                  (sample.serverSendUs - sample.serverRecvUs);
+
+  // Negative delays come from broken replies, huge ones carry too much jitter
+  if (delay < 0 || delay > (int64_t)WALL_CLOCK_MAX_DELAY_MS * 1000) {
+    return false;
+  }
+
+  if (!haveBest || delay < bestDelay) {
+    best = sample;
+    bestDelay = delay;
+    haveBest = true;
+  }
+  return true;
+}
+
+bool WallClock::endBurst() {
+  if (!haveBest) {
+    return false;
+  }
+  haveBest = false;
+
+  // Offset between server and local clock, taken at the local midpoint
+  int64_t offset = ((best.serverRecvUs - best.localSendUs) +
+                    (best.serverSendUs - best.localRecvUs)) / 2;
+  int64_t localMid = best.localSendUs + (best.localRecvUs - best.localSendUs) / 2;
+  int64_t measuredUnix = localMid + offset;
+
+  lastDelay = bestDelay;
+
+  // Only this task writes the time base, so it may read it directly
+  if (!timebase.synced) {
+    publish({ true, localMid, measuredUnix, 0.0 });
+    lastError = 0;
+    syncCount = 1;
+    return true;
+  }
+
+  int64_t elapsed = localMid - timebase.baseLocalUs;
+  lastError = measuredUnix - toUnixUs(localMid);
+
+  // Large errors mean a reboot of the server or a wrong sample: step and
+  // start the drift estimation over instead of learning a bogus rate.
+  if (lastError > (int64_t)WALL_CLOCK_STEP_THRESHOLD_MS * 1000 ||
+      lastError < -(int64_t)WALL_CLOCK_STEP_THRESHOLD_MS * 1000 ||
+      elapsed <= 0) {
+    publish({ true, localMid, measuredUnix, 0.0 });
+    syncCount = 1;
+    pollInterval = WALL_CLOCK_MIN_POLL_S;
+    return true;
+  }
+
+  // The remaining error over the elapsed interval is the part of the drift
+  // that has not been learned yet. Early estimates are taken as they are,
+  // later ones are blended in to smooth out residual network jitter.
+  double rateError = (double)lastError / (double)elapsed;
+  double drift = timebase.drift + ((syncCount < 3) ? rateError : rateError * 0.5);
+
+  const double maxDrift = WALL_CLOCK_MAX_DRIFT_PPM * 1e-6;
+  if (drift > maxDrift) drift = maxDrift;
+  if (drift < -maxDrift) drift = -maxDrift;
+
+  publish({ true, localMid, measuredUnix, drift });
+  if (syncCount < 255) syncCount++;
+
+  // Poll less often while the prediction holds, more often when it drifts off
+  int64_t absError = lastError < 0 ? -lastError : lastError;
+  const int64_t target = (int64_t)WALL_CLOCK_TARGET_ERROR_MS * 1000;
+  if (absError < target / 4 && pollInterval < WALL_CLOCK_MAX_POLL_S) {
+    pollInterval *= 2;
+    if (pollInterval > WALL_CLOCK_MAX_POLL_S) pollInterval = WALL_CLOCK_MAX_POLL_S;
+  } else if (absError > target && pollInterval > WALL_CLOCK_MIN_POLL_S) {
+    pollInterval /= 2;
+    if (pollInterval < WALL_CLOCK_MIN_POLL_S) pollInterval = WALL_CLOCK_MIN_POLL_S;
+  }
+
+  return true;
+}
+
+int64_t WallClock::toUnixUs(int64_t localUs) const {
+  Timebase current = readTimebase();
+  if (!current.synced) {
+    return 0;
+  }
+  int64_t elapsed = localUs - current.baseLocalUs;
+  return current.baseUnixUs + elapsed + (int64_t)((double)elapsed * current.drift);
+}
@@ -0,0 +1,25 @@
+/*
+  Host stand-in for esp_heap_caps.h, only used by the native tests.
+  The capabilities are ignored, everything comes from the C heap.
+*/
+
+#ifndef HOST_ESP_HEAP_CAPS_H
+#define HOST_ESP_HEAP_CAPS_H
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#define MALLOC_CAP_8BIT     (1 << 2)
+#define MALLOC_CAP_DMA      (1 << 3)
+#define MALLOC_CAP_SPIRAM   (1 << 10)
+#define MALLOC_CAP_INTERNAL (1 << 11)
+
+static inline void* heap_caps_malloc(size_t size, uint32_t caps) {
+  return malloc(size);
+}
+
+static inline void heap_caps_free(void* pointer) {
+  free(pointer);
+}
+
+#endif // HOST_ESP_HEAP_CAPS_H
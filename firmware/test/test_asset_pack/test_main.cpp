@@ -0,0 +1,471 @@
+/*
+  Host tests of the asset pack reader (asset_pack.h). The packs are built
+  in memory the way tools/asset_pack.py does it, with a small LZSS
+  encoder that writes the same bit stream, and are decoded band by band
+  like assets.cpp does before every DMA transfer. The last test measures
+  the decode throughput of a full screen logo and photo.
+*/
+
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+#include "asset_pack.h"
+
+#define WINDOW_BITS 11
+#define LOOKAHEAD_BITS 6
+#define MIN_MATCH 3
+
+struct PackFile {
+  std::vector<uint8_t> bytes;
+  uint32_t reads;
+  uint32_t bytesRead;
+  uint32_t largestRead;
+};
+
+struct TestAsset {
+  const char* name;
+  uint16_t width;
+  uint16_t height;
+  std::vector<std::vector<uint16_t>> frames;   // RGB565 values
+};
+
+static void putLe16(std::vector<uint8_t>& out, uint16_t value) {
+  out.push_back((uint8_t)value);
+  out.push_back((uint8_t)(value >> 8));
+}
+
+static void putLe32(std::vector<uint8_t>& out, uint32_t value) {
+  putLe16(out, (uint16_t)value);
+  putLe16(out, (uint16_t)(value >> 16));
+}
+
+static void setLe32(std::vector<uint8_t>& out, size_t at, uint32_t value) {
+  for (int i = 0; i < 4; i++) {
+    out[at + i] = (uint8_t)(value >> (8 * i));
+  }
+}
+
+struct BitWriter {
+  std::vector<uint8_t> bytes;
+  uint32_t buffer = 0;
+  uint8_t count = 0;
+
+  void write(uint32_t value, uint8_t bits) {
+    for (int i = bits - 1; i >= 0; i--) {
+      buffer = (buffer << 1) | ((value >> i) & 1);
+      if (++count == 8) {
+        bytes.push_back((uint8_t)buffer);
+        buffer = 0;
+        count = 0;
+      }
+    }
+  }
+
+  std::vector<uint8_t> finish() {
+    if (count > 0) {
+      bytes.push_back((uint8_t)(buffer << (8 - count)));
+    }
+    return bytes;
+  }
+};
+
+// Greedy LZSS with the bit stream of lzss_compress() in tools/delta_patch.py
+static std::vector<uint8_t> compress(const std::vector<uint8_t>& data) {
+  const size_t window = 1u << WINDOW_BITS;
+  const size_t maxMatch = (1u << LOOKAHEAD_BITS) + MIN_MATCH - 1;
+  std::vector<int32_t> head(1 << 16, -1);
+  std::vector<int32_t> previous(data.size(), -1);
+  BitWriter writer;
+
+  size_t pos = 0;
+  while (pos < data.size()) {
+    size_t bestLength = 0;
+    size_t bestDistance = 0;
+    if (pos + MIN_MATCH <= data.size()) {
+      uint32_t key = (data[pos] << 8 | data[pos + 1]) ^ (data[pos + 2] << 4);
+      int32_t tries = 32;
+      for (int32_t candidate = head[key & 0xFFFF]; candidate >= 0 && tries-- > 0; candidate = previous[candidate]) {
+        size_t distance = pos - (size_t)candidate;
+        if (distance > window) {
+          break;
+        }
+        size_t match = 0;
+        while (match < maxMatch && pos + match < data.size() && data[candidate + match] == data[pos + match]) {
+          match++;
+        }
+        if (match > bestLength) {
+          bestLength = match;
+          bestDistance = distance;
+        }
+      }
+    }
+
+    size_t step = bestLength >= MIN_MATCH ? bestLength : 1;
+    if (bestLength >= MIN_MATCH) {
+      writer.write(0, 1);
+      writer.write((uint32_t)(bestDistance - 1), WINDOW_BITS);
+      writer.write((uint32_t)(bestLength - MIN_MATCH), LOOKAHEAD_BITS);
+    } else {
+      writer.write(1, 1);
+      writer.write(data[pos], 8);
+    }
+    for (size_t p = pos; p < pos + step && p + MIN_MATCH <= data.size(); p++) {
+      uint32_t key = ((data[p] << 8 | data[p + 1]) ^ (data[p + 2] << 4)) & 0xFFFF;
+      previous[p] = head[key];
+      head[key] = (int32_t)p;
+    }
+    pos += step;
+  }
+  return writer.finish();
+}
+
+// Layout of pack() in tools/asset_pack.py
+static void buildPack(PackFile* file, const std::vector<TestAsset>& assets) {
+  std::vector<uint8_t>& out = file->bytes;
+  out.assign({ 'C', 'A', 'P', '1', WINDOW_BITS, LOOKAHEAD_BITS });
+  putLe16(out, (uint16_t)assets.size());
+  size_t indexAt = out.size();
+  out.resize(out.size() + 32 * assets.size());
+
+  for (size_t a = 0; a < assets.size(); a++) {
+    const TestAsset& asset = assets[a];
+    std::vector<uint16_t> colours;
+    for (const std::vector<uint16_t>& frame : asset.frames) {
+      colours.insert(colours.end(), frame.begin(), frame.end());
+    }
+    std::sort(colours.begin(), colours.end());
+    colours.erase(std::unique(colours.begin(), colours.end()), colours.end());
+    bool indexed = colours.size() <= 256;
+
+    uint32_t paletteOffset = (uint32_t)out.size();
+    if (indexed) {
+      for (uint16_t colour : colours) {
+        out.push_back((uint8_t)(colour >> 8));
+        out.push_back((uint8_t)colour);
+      }
+    }
+    std::vector<std::vector<uint8_t>> compressed;
+    for (const std::vector<uint16_t>& frame : asset.frames) {
+      std::vector<uint8_t> data;
+      for (uint16_t colour : frame) {
+        if (indexed) {
+          data.push_back((uint8_t)(std::lower_bound(colours.begin(), colours.end(), colour) - colours.begin()));
+        } else {
+          data.push_back((uint8_t)(colour >> 8));
+          data.push_back((uint8_t)colour);
+        }
+      }
+      compressed.push_back(compress(data));
+    }
+    uint32_t tableOffset = (uint32_t)out.size();
+    uint32_t dataOffset = tableOffset + 4 * (uint32_t)(compressed.size() + 1);
+    for (const std::vector<uint8_t>& frame : compressed) {
+      putLe32(out, dataOffset);
+      dataOffset += (uint32_t)frame.size();
+    }
+    putLe32(out, dataOffset);
+    for (const std::vector<uint8_t>& frame : compressed) {
+      out.insert(out.end(), frame.begin(), frame.end());
+    }
+
+    uint8_t* entry = out.data() + indexAt + 32 * a;
+    memset(entry, 0, 16);
+    memcpy(entry, asset.name, strnlen(asset.name, 16));
+    std::vector<uint8_t> fields;
+    putLe16(fields, asset.width);
+    putLe16(fields, asset.height);
+    putLe16(fields, (uint16_t)asset.frames.size());
+    putLe16(fields, indexed ? (uint16_t)colours.size() : 0);
+    putLe32(fields, paletteOffset);
+    putLe32(fields, tableOffset);
+    memcpy(entry + 16, fields.data(), fields.size());
+  }
+  file->reads = 0;
+  file->bytesRead = 0;
+  file->largestRead = 0;
+}
+
+static bool readPack(void* context, uint32_t offset, uint8_t* target, uint32_t length) {
+  PackFile* file = (PackFile*)context;
+  if ((uint64_t)offset + length > file->bytes.size()) {
+    return false;
+  }
+  memcpy(target, file->bytes.data() + offset, length);
+  file->reads++;
+  file->bytesRead += length;
+  if (length > file->largestRead) {
+    file->largestRead = length;
+  }
+  return true;
+}
+
+// A logo: a few colours, long runs and rows that repeat
+static std::vector<uint16_t> logoFrame(uint16_t width, uint16_t height, uint32_t shift) {
+  static const uint16_t colours[] = { 0x0000, 0xFFFF, 0xF800, 0x07E0, 0x001F, 0xFD20 };
+  std::vector<uint16_t> frame;
+  for (uint32_t y = 0; y < height; y++) {
+    for (uint32_t x = 0; x < width; x++) {
+      uint32_t dx = x + shift;
+      frame.push_back(colours[((dx / 12) + (y / 10)) % 6]);
+    }
+  }
+  return frame;
+}
+
+// A photo-like gradient with noise: far more than 256 colours
+static std::vector<uint16_t> gradientFrame(uint16_t width, uint16_t height, uint32_t seed) {
+  std::mt19937 random(seed);
+  std::vector<uint16_t> frame;
+  for (uint32_t y = 0; y < height; y++) {
+    for (uint32_t x = 0; x < width; x++) {
+      uint32_t r = (x * 31 / width + random() % 2) & 0x1F;
+      uint32_t g = (y * 63 / height) & 0x3F;
+      uint32_t b = ((x + y) * 31 / (width + height)) & 0x1F;
+      frame.push_back((uint16_t)(r << 11 | g << 5 | b));
+    }
+  }
+  return frame;
+}
+
+// Pixels leave the decoder in display byte order (high byte first in memory)
+static uint16_t displayOrder(uint16_t colour) {
+  return (uint16_t)(colour >> 8 | colour << 8);
+}
+
+// Decode one frame band by band, like assets.cpp feeds the DMA buffers
+static std::vector<uint16_t> decodeFrame(const AssetPack& pack, const AssetInfo& info, uint16_t frame,
+                                         uint16_t bandLines) {
+  AssetDecoder decoder;
+  std::vector<uint16_t> out;
+  if (!decoder.begin(pack, info, frame)) {
+    return out;
+  }
+  std::vector<uint16_t> band((size_t)bandLines * info.width);
+  while (uint16_t rows = decoder.readRows(band.data(), bandLines)) {
+    out.insert(out.end(), band.begin(), band.begin() + (size_t)rows * info.width);
+  }
+  return decoder.failed() ? std::vector<uint16_t>() : out;
+}
+
+static void assertDecodes(const AssetPack& pack, const TestAsset& asset, uint16_t bandLines) {
+  int32_t index = pack.find(asset.name);
+  TEST_ASSERT_TRUE(index >= 0);
+  AssetInfo info;
+  TEST_ASSERT_TRUE(pack.info((uint16_t)index, &info));
+  TEST_ASSERT_EQUAL_UINT16(asset.width, info.width);
+  TEST_ASSERT_EQUAL_UINT16(asset.height, info.height);
+  TEST_ASSERT_EQUAL_UINT16(asset.frames.size(), info.frames);
+  for (uint16_t f = 0; f < info.frames; f++) {
+    std::vector<uint16_t> decoded = decodeFrame(pack, info, f, bandLines);
+    TEST_ASSERT_EQUAL_size_t(asset.frames[f].size(), decoded.size());
+    for (size_t i = 0; i < decoded.size(); i++) {
+      if (displayOrder(asset.frames[f][i]) != decoded[i]) {
+        char line[96];
+        snprintf(line, sizeof(line), "%s frame %u pixel %u differs", asset.name, (unsigned)f, (unsigned)i);
+        TEST_FAIL_MESSAGE(line);
+      }
+    }
+  }
+}
+
+static PackFile file;
+static AssetPack pack;
+
+void setUp() {
+  file = PackFile();
+  pack = AssetPack();
+}
+
+void tearDown() {
+}
+
+static void test_open_checks_the_header() {
+  buildPack(&file, { { "logo", 16, 8, { logoFrame(16, 8, 0) } } });
+  TEST_ASSERT_TRUE(pack.open(readPack, &file));
+  TEST_ASSERT_EQUAL_UINT16(1, pack.count());
+  TEST_ASSERT_EQUAL_UINT8(WINDOW_BITS, pack.windowBits());
+
+  file.bytes[0] = 'X';
+  TEST_ASSERT_FALSE(pack.open(readPack, &file));
+  TEST_ASSERT_FALSE(pack.isOpen());
+
+  // A history larger than the decoder's window buffer is refused
+  file.bytes[0] = 'C';
+  file.bytes[4] = ASSET_MAX_WINDOW_BITS + 1;
+  TEST_ASSERT_FALSE(pack.open(readPack, &file));
+
+  file.bytes.resize(4);
+  TEST_ASSERT_FALSE(pack.open(readPack, &file));
+}
+
+static void test_assets_are_found_by_name() {
+  buildPack(&file, { { "logo", 16, 8, { logoFrame(16, 8, 0) } },
+                     { "exactly16bytes!!", 4, 4, { logoFrame(4, 4, 1) } },
+                     { "spinner", 8, 8, { logoFrame(8, 8, 0), logoFrame(8, 8, 3) } } });
+  TEST_ASSERT_TRUE(pack.open(readPack, &file));
+  TEST_ASSERT_EQUAL_INT32(0, pack.find("logo"));
+  TEST_ASSERT_EQUAL_INT32(1, pack.find("exactly16bytes!!"));
+  TEST_ASSERT_EQUAL_INT32(2, pack.find("spinner"));
+  TEST_ASSERT_EQUAL_INT32(-1, pack.find("missing"));
+
+  AssetInfo info;
+  TEST_ASSERT_TRUE(pack.info(1, &info));
+  TEST_ASSERT_EQUAL_STRING("exactly16bytes!!", info.name);
+  TEST_ASSERT_FALSE(pack.info(3, &info));
+}
+
+static void test_palette_image_round_trip() {
+  TestAsset logo = { "logo", 100, 37, { logoFrame(100, 37, 0) } };
+  buildPack(&file, { logo });
+  TEST_ASSERT_TRUE(pack.open(readPack, &file));
+  AssetInfo info;
+  TEST_ASSERT_TRUE(pack.info(0, &info));
+  TEST_ASSERT_EQUAL_UINT16(6, info.paletteSize);
+  assertDecodes(pack, logo, ASSET_BAND_LINES);
+}
+
+static void test_rgb565_image_round_trip() {
+  TestAsset photo = { "photo", 64, 50, { gradientFrame(64, 50, 1) } };
+  buildPack(&file, { photo });
+  TEST_ASSERT_TRUE(pack.open(readPack, &file));
+  AssetInfo info;
+  TEST_ASSERT_TRUE(pack.info(0, &info));
+  TEST_ASSERT_EQUAL_UINT16(0, info.paletteSize);
+  assertDecodes(pack, photo, ASSET_BAND_LINES);
+}
+
+static void test_animation_frames_decode_on_their_own() {
+  TestAsset spinner = { "spinner", 40, 40, {} };
+  for (uint32_t f = 0; f < 8; f++) {
+    spinner.frames.push_back(logoFrame(40, 40, f * 5));
+  }
+  buildPack(&file, { { "logo", 16, 8, { logoFrame(16, 8, 0) } }, spinner });
+  TEST_ASSERT_TRUE(pack.open(readPack, &file));
+  assertDecodes(pack, spinner, ASSET_BAND_LINES);
+
+  // Frames out of order give the same pixels
+  AssetInfo info;
+  TEST_ASSERT_TRUE(pack.info(1, &info));
+  std::vector<uint16_t> last = decodeFrame(pack, info, 7, ASSET_BAND_LINES);
+  std::vector<uint16_t> first = decodeFrame(pack, info, 0, ASSET_BAND_LINES);
+  TEST_ASSERT_EQUAL_UINT16(displayOrder(spinner.frames[7][0]), last[0]);
+  TEST_ASSERT_EQUAL_UINT16(displayOrder(spinner.frames[0][0]), first[0]);
+
+  AssetDecoder decoder;
+  TEST_ASSERT_FALSE(decoder.begin(pack, info, 8));
+}
+
+static void test_any_band_height_gives_the_same_pixels() {
+  TestAsset logo = { "logo", 53, 29, { logoFrame(53, 29, 2) } };
+  buildPack(&file, { logo });
+  TEST_ASSERT_TRUE(pack.open(readPack, &file));
+  const uint16_t bands[] = { 1, 3, 8, 28, 29, 64 };
+  for (uint16_t lines : bands) {
+    assertDecodes(pack, logo, lines);
+  }
+}
+
+static void test_decoder_streams_through_a_small_buffer() {
+  TestAsset photo = { "photo", 320, 60, { gradientFrame(320, 60, 2) } };
+  buildPack(&file, { photo });
+  TEST_ASSERT_TRUE(pack.open(readPack, &file));
+  AssetInfo info;
+  TEST_ASSERT_TRUE(pack.info(0, &info));
+
+  AssetDecoder decoder;
+  TEST_ASSERT_TRUE(decoder.begin(pack, info, 0));
+  uint32_t frameBytes = (uint32_t)file.bytes.size() - (info.frameTableOffset + 8);
+  file.reads = 0;
+  file.bytesRead = 0;
+  file.largestRead = 0;
+  uint16_t band[ASSET_BAND_LINES * 320];
+  TEST_ASSERT_EQUAL_UINT16(ASSET_BAND_LINES, decoder.readRows(band, ASSET_BAND_LINES));
+  TEST_ASSERT_EQUAL_UINT16(60 - ASSET_BAND_LINES, decoder.rowsLeft());
+
+  // One band only pulls the compressed bytes it needs, plus one buffer
+  uint32_t firstBandReads = file.reads;
+  TEST_ASSERT_LESS_OR_EQUAL(frameBytes * ASSET_BAND_LINES / 60 + ASSET_INPUT_BUFFER_SIZE, file.bytesRead);
+  while (decoder.readRows(band, ASSET_BAND_LINES) > 0) {
+  }
+  TEST_ASSERT_FALSE(decoder.failed());
+  TEST_ASSERT_EQUAL_UINT16(0, decoder.rowsLeft());
+  TEST_ASSERT_LESS_OR_EQUAL(ASSET_INPUT_BUFFER_SIZE, file.largestRead);
+  TEST_ASSERT_GREATER_THAN(firstBandReads, file.reads);
+  TEST_ASSERT_EQUAL_UINT32(frameBytes, file.bytesRead);
+}
+
+static void test_truncated_frame_fails() {
+  TestAsset photo = { "photo", 64, 32, { gradientFrame(64, 32, 3) } };
+  buildPack(&file, { photo });
+  TEST_ASSERT_TRUE(pack.open(readPack, &file));
+  AssetInfo info;
+  TEST_ASSERT_TRUE(pack.info(0, &info));
+
+  // The frame ends half way: the decoder runs out of input
+  uint32_t start = info.frameTableOffset + 8;
+  uint32_t end = (uint32_t)file.bytes.size();
+  setLe32(file.bytes, info.frameTableOffset + 4, start + (end - start) / 2);
+  TEST_ASSERT_TRUE(decodeFrame(pack, info, 0, ASSET_BAND_LINES).empty());
+
+  // An end before the start is refused at once
+  setLe32(file.bytes, info.frameTableOffset + 4, start - 1);
+  AssetDecoder decoder;
+  TEST_ASSERT_FALSE(decoder.begin(pack, info, 0));
+  uint16_t band[64];
+  TEST_ASSERT_EQUAL_UINT16(0, decoder.readRows(band, 1));
+}
+
+static void test_decode_throughput() {
+  TestAsset splash = { "splash", 320, 240, { logoFrame(320, 240, 0) } };
+  TestAsset photo = { "photo", 320, 240, { gradientFrame(320, 240, 4) } };
+  buildPack(&file, { splash, photo });
+  TEST_ASSERT_TRUE(pack.open(readPack, &file));
+
+  const char* names[] = { "splash", "photo" };
+  for (const char* name : names) {
+    AssetInfo info;
+    TEST_ASSERT_TRUE(pack.info((uint16_t)pack.find(name), &info));
+    uint8_t offsets[8];
+    TEST_ASSERT_TRUE(pack.read(info.frameTableOffset, offsets, sizeof(offsets)));
+    uint32_t compressed = (uint32_t)(offsets[4] | offsets[5] << 8 | offsets[6] << 16) -
+                          (uint32_t)(offsets[0] | offsets[1] << 8 | offsets[2] << 16);
+    uint32_t raw = 320u * 240u * 2u;
+
+    const int rounds = 20;
+    uint16_t band[ASSET_BAND_LINES * 320];
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; i++) {
+      AssetDecoder decoder;
+      TEST_ASSERT_TRUE(decoder.begin(pack, info, 0));
+      while (decoder.readRows(band, ASSET_BAND_LINES) > 0) {
+      }
+      TEST_ASSERT_FALSE(decoder.failed());
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    char line[128];
+    snprintf(line, sizeof(line), "%s: %u of %u bytes (%.1f %%), %.1f Mpixel/s on the host", name,
+             (unsigned)compressed, (unsigned)raw, 100.0 * compressed / raw,
+             rounds * 320.0 * 240.0 / (seconds > 0 ? seconds : 1e-9) / 1e6);
+    TEST_MESSAGE(line);
+    TEST_ASSERT_LESS_THAN(raw, compressed);
+  }
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_open_checks_the_header);
+  RUN_TEST(test_assets_are_found_by_name);
+  RUN_TEST(test_palette_image_round_trip);
+  RUN_TEST(test_rgb565_image_round_trip);
+  RUN_TEST(test_animation_frames_decode_on_their_own);
+  RUN_TEST(test_any_band_height_gives_the_same_pixels);
+  RUN_TEST(test_decoder_streams_through_a_small_buffer);
+  RUN_TEST(test_truncated_frame_fails);
+  RUN_TEST(test_decode_throughput);
+  return UNITY_END();
+}
@@ -0,0 +1,235 @@
+/*
+  Host simulation of the init graph (boot_graph.h): every phase runs in
+  its own thread as soon as its dependencies are done, like the phase
+  tasks on the device, with the phase durations measured on the clock,
+  and checked against the usable budget BOOT_USABLE_BUDGET_MS.
+*/
+
+#include <unity.h>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "boot_graph.h"
+#include "config.h"
+
+enum SimulatedPhase {
+  DISPLAY,
+  UI,
+  SHADOW,
+  PIXELS,
+  TOUCH,
+  FILESYSTEM,
+  FONTS,
+  ASSETS,
+  PLAYERS,
+  EDGE_CAPTURE,
+  FLAG_ALARM,
+  WALL_CLOCK,
+  WIFI,
+  PHASE_COUNT
+};
+
+// Rough durations of the device phases in ms
+static const uint32_t DURATION_MS[PHASE_COUNT] = { 30, 40, 5, 2, 3, 60, 20, 10, 30, 2, 1, 1, 80 };
+static uint32_t durationMs[PHASE_COUNT];
+static bool failing[PHASE_COUNT];
+
+template <int INDEX>
+static bool simulatedInit() {
+  std::this_thread::sleep_for(std::chrono::milliseconds(durationMs[INDEX]));
+  return !failing[INDEX];
+}
+
+// Same shape as BOOT_PHASES in main.cpp
+static const BootPhase PHASES[PHASE_COUNT] = {
+  { "display",      simulatedInit<DISPLAY>,      1, 0,                                              true,  0 },
+  { "ui",           simulatedInit<UI>,           1, BOOT_AFTER(DISPLAY),                            true,  0 },
+  { "shadow",       simulatedInit<SHADOW>,       1, BOOT_AFTER(DISPLAY),                            true,  0 },
+  { "pixels",       simulatedInit<PIXELS>,       1, 0,                                              false, 0 },
+  { "touch",        simulatedInit<TOUCH>,        1, BOOT_AFTER(DISPLAY),                            false, 0 },
+  { "filesystem",   simulatedInit<FILESYSTEM>,   0, 0,                                              false, 0 },
+  { "fonts",        simulatedInit<FONTS>,        0, BOOT_AFTER(DISPLAY) | BOOT_AFTER(FILESYSTEM),   false, 0 },
+  { "assets",       simulatedInit<ASSETS>,       0, BOOT_AFTER(FILESYSTEM),                         false, 0 },
+  { "players",      simulatedInit<PLAYERS>,      0, BOOT_AFTER(FONTS),                              false, 0 },
+  { "edge_capture", simulatedInit<EDGE_CAPTURE>, 1, BOOT_AFTER(UI),                                 true,  0 },
+  { "flag_alarm",   simulatedInit<FLAG_ALARM>,   1, 0,                                              true,  0 },
+  { "wall_clock",   simulatedInit<WALL_CLOCK>,   0, 0,                                              true,  0 },
+  { "wifi",         simulatedInit<WIFI>,         0, 0,                                              false, 0 },
+};
+
+static const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+static int64_t simulatedNow() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - epoch).count();
+}
+
+// Stands in for the event group of boot.cpp
+static std::mutex doneMutex;
+static std::condition_variable doneChanged;
+
+static BootGraph graph;
+
+struct SimulationResult {
+  int64_t startUs;
+  int64_t usableUs;
+  int64_t finishedUs;
+};
+
+static SimulationResult simulate(const BootPhase* phases, uint8_t count) {
+  TEST_ASSERT_TRUE(graph.begin(phases, count));
+  SimulationResult result;
+  result.startUs = simulatedNow();
+
+  std::vector<std::thread> tasks;
+  for (uint8_t i = 0; i < count; i++) {
+    tasks.emplace_back([i]() {
+      uint32_t dependsOn = graph.phase(i).dependsOn;
+      {
+        std::unique_lock<std::mutex> lock(doneMutex);
+        doneChanged.wait(lock, [dependsOn]() { return (graph.doneMask() & dependsOn) == dependsOn; });
+      }
+      graph.run(i, graph.phase(i).core, simulatedNow);
+      std::lock_guard<std::mutex> lock(doneMutex);
+      doneChanged.notify_all();
+    });
+  }
+
+  {
+    std::unique_lock<std::mutex> lock(doneMutex);
+    uint32_t required = graph.requiredMask();
+    doneChanged.wait(lock, [required]() { return (graph.doneMask() & required) == required; });
+  }
+  result.usableUs = simulatedNow();
+  for (std::thread& task : tasks) {
+    task.join();
+  }
+  result.finishedUs = simulatedNow();
+  return result;
+}
+
+void setUp() {
+  for (int i = 0; i < PHASE_COUNT; i++) {
+    failing[i] = false;
+    durationMs[i] = DURATION_MS[i];
+  }
+}
+
+void tearDown() {
+}
+
+static void test_forward_dependencies_are_rejected() {
+  BootPhase phases[2] = {
+    { "a", simulatedInit<PIXELS>, 0, BOOT_AFTER(1), false, 0 },
+    { "b", simulatedInit<PIXELS>, 0, 0, false, 0 },
+  };
+  TEST_ASSERT_FALSE(graph.begin(phases, 2));
+  phases[0].dependsOn = BOOT_AFTER(0);
+  TEST_ASSERT_FALSE(graph.begin(phases, 2));
+  TEST_ASSERT_FALSE(graph.begin(PHASES, BOOT_MAX_PHASES + 1));
+}
+
+static void test_phases_start_after_their_dependencies() {
+  SimulationResult result = simulate(PHASES, PHASE_COUNT);
+  TEST_ASSERT_TRUE(graph.usable());
+  TEST_ASSERT_TRUE(graph.finished());
+  for (uint8_t i = 0; i < PHASE_COUNT; i++) {
+    const BootPhaseTiming& timing = graph.timing(i);
+    TEST_ASSERT_TRUE(timing.ok);
+    for (uint8_t dependency = 0; dependency < i; dependency++) {
+      if (PHASES[i].dependsOn & BOOT_AFTER(dependency)) {
+        TEST_ASSERT_GREATER_OR_EQUAL_INT64(graph.timing(dependency).endUs, timing.startUs);
+      }
+    }
+  }
+  // Usable after the longest required chain display -> ui -> edge_capture,
+  // long before wifi, fonts and players are done
+  TEST_ASSERT_GREATER_OR_EQUAL_INT64(72000, result.usableUs - result.startUs);
+  TEST_ASSERT_LESS_THAN_INT64(result.finishedUs, result.usableUs + 20000);
+  TEST_ASSERT_LESS_THAN_INT64(BOOT_USABLE_BUDGET_MS * 1000LL, result.usableUs - result.startUs);
+}
+
+static void test_a_slow_required_phase_breaks_the_budget() {
+  // A slow background phase only delays the end of the boot
+  durationMs[WIFI] = BOOT_USABLE_BUDGET_MS + 100;
+  SimulationResult result = simulate(PHASES, PHASE_COUNT);
+  TEST_ASSERT_LESS_THAN_INT64(BOOT_USABLE_BUDGET_MS * 1000LL, result.usableUs - result.startUs);
+  TEST_ASSERT_GREATER_OR_EQUAL_INT64(BOOT_USABLE_BUDGET_MS * 1000LL, result.finishedUs - result.startUs);
+
+  // One on the required chain (display -> ui -> edge_capture) makes the clock usable too late
+  durationMs[WIFI] = DURATION_MS[WIFI];
+  durationMs[UI] = BOOT_USABLE_BUDGET_MS;
+  result = simulate(PHASES, PHASE_COUNT);
+  TEST_ASSERT_TRUE(graph.usable());
+  TEST_ASSERT_GREATER_OR_EQUAL_INT64(BOOT_USABLE_BUDGET_MS * 1000LL, result.usableUs - result.startUs);
+}
+
+static void test_phases_run_in_parallel() {
+  SimulationResult result = simulate(PHASES, PHASE_COUNT);
+  uint32_t sequentialMs = 0;
+  for (int i = 0; i < PHASE_COUNT; i++) {
+    sequentialMs += DURATION_MS[i];
+  }
+  // The longest chain is filesystem -> fonts -> players (110 ms)
+  TEST_ASSERT_LESS_THAN_INT64((int64_t)sequentialMs * 1000 / 2, result.finishedUs - result.startUs);
+}
+
+static void test_background_failure_skips_dependents_only() {
+  failing[FILESYSTEM] = true;
+  simulate(PHASES, PHASE_COUNT);
+  TEST_ASSERT_TRUE(graph.usable());
+  TEST_ASSERT_FALSE(graph.timing(FILESYSTEM).skipped);
+  TEST_ASSERT_TRUE(graph.timing(FONTS).skipped);
+  TEST_ASSERT_TRUE(graph.timing(ASSETS).skipped);
+  TEST_ASSERT_TRUE(graph.timing(PLAYERS).skipped);   // Only through fonts
+  TEST_ASSERT_EQUAL_HEX32(BOOT_AFTER(FILESYSTEM) | BOOT_AFTER(FONTS) | BOOT_AFTER(ASSETS) | BOOT_AFTER(PLAYERS),
+                          graph.failedMask());
+}
+
+static void test_required_failure_makes_the_clock_unusable() {
+  failing[DISPLAY] = true;
+  simulate(PHASES, PHASE_COUNT);
+  TEST_ASSERT_FALSE(graph.usable());
+  TEST_ASSERT_TRUE(graph.finished());
+  TEST_ASSERT_TRUE(graph.timing(EDGE_CAPTURE).skipped);   // Through ui
+  TEST_ASSERT_TRUE(graph.timing(WIFI).ok);
+}
+
+static bool failNow() {
+  return false;
+}
+
+static void test_concurrent_failures_are_never_lost() {
+  // Independent phases failing at the same moment on different threads
+  BootPhase phases[BOOT_MAX_PHASES];
+  for (uint8_t i = 0; i < BOOT_MAX_PHASES; i++) {
+    phases[i] = { "fail", failNow, -1, 0, true, 0 };
+  }
+  for (int round = 0; round < 200; round++) {
+    simulate(phases, BOOT_MAX_PHASES);
+    TEST_ASSERT_EQUAL_HEX32(graph.allMask(), graph.failedMask());
+    TEST_ASSERT_FALSE(graph.usable());
+  }
+}
+
+static void test_a_phase_without_task_releases_its_dependents() {
+  TEST_ASSERT_TRUE(graph.begin(PHASES, PHASE_COUNT));
+  graph.fail(FILESYSTEM);
+  TEST_ASSERT_EQUAL_HEX32(BOOT_AFTER(FILESYSTEM), graph.doneMask());
+  TEST_ASSERT_EQUAL_HEX32(BOOT_AFTER(FILESYSTEM), graph.failedMask());
+  TEST_ASSERT_TRUE(graph.timing(FILESYSTEM).skipped);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_forward_dependencies_are_rejected);
+  RUN_TEST(test_phases_start_after_their_dependencies);
+  RUN_TEST(test_phases_run_in_parallel);
+  RUN_TEST(test_a_slow_required_phase_breaks_the_budget);
+  RUN_TEST(test_background_failure_skips_dependents_only);
+  RUN_TEST(test_required_failure_makes_the_clock_unusable);
+  RUN_TEST(test_concurrent_failures_are_never_lost);
+  RUN_TEST(test_a_phase_without_task_releases_its_dependents);
+  return UNITY_END();
+}
@@ -0,0 +1,294 @@
+/*
+  Host tests of the deadline monitor (deadline_monitor.h) with injected
+  overruns: the overrun log and its wrap, the p99 breach at more than
+  1 % of a window, the percentile estimate from the histogram, and the
+  clock event stage as main.cpp records it, timed from the release of the
+  resolve window, under a load with rare and with frequent late events.
+*/
+
+#include <unity.h>
+#include <stdio.h>
+#include <atomic>
+#include <random>
+#include <thread>
+#include "deadline_monitor.h"
+
+#define WINDOW_RUNS 200
+#define RESOLVE_WINDOW_US 2000        // INPUT_RESOLVE_WINDOW_US
+#define EVENT_BUDGET_US 1000          // DEADLINE_EVENT_BUDGET_US
+
+static DeadlineStage makeStage(const char* name, uint32_t budgetUs) {
+  DeadlineStage stage = {};
+  stage.name = name;
+  stage.budgetUs = budgetUs;
+  return stage;
+}
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+static void test_runs_on_budget_are_not_overruns() {
+  DeadlineMonitor monitor(WINDOW_RUNS);
+  DeadlineStage stage = makeStage("job", 400);
+  TEST_ASSERT_TRUE(monitor.add(&stage));
+  for (uint32_t i = 0; i < 10 * WINDOW_RUNS; i++) {
+    monitor.record(&stage, i * 1000, i % 2 ? 400 : 10);
+  }
+  TEST_ASSERT_EQUAL_UINT32(10 * WINDOW_RUNS, stage.runs);
+  TEST_ASSERT_EQUAL_UINT32(0, stage.overruns);
+  TEST_ASSERT_EQUAL_UINT32(0, stage.breaches);
+  TEST_ASSERT_EQUAL_UINT32(400, stage.maxUs);
+  TEST_ASSERT_EQUAL_UINT64(5ULL * WINDOW_RUNS * 410, stage.totalUs);
+  TEST_ASSERT_EQUAL_UINT32(0, monitor.logged());
+  TEST_ASSERT_EQUAL_UINT32(0, monitor.takeBreaches());
+}
+
+static void test_injected_overruns_are_logged_with_stage_and_start() {
+  DeadlineMonitor monitor(WINDOW_RUNS);
+  DeadlineStage first = makeStage("first", 100);
+  DeadlineStage second = makeStage("second", 50);
+  TEST_ASSERT_TRUE(monitor.add(&first));
+  TEST_ASSERT_TRUE(monitor.add(&second));
+  TEST_ASSERT_EQUAL_UINT8(2, monitor.stageCount());
+  TEST_ASSERT_EQUAL_PTR(&second, monitor.stage(1));
+  TEST_ASSERT_NULL(monitor.stage(2));
+
+  monitor.record(&first, 1000, 20);
+  monitor.record(&first, 2000, 101);
+  monitor.record(&second, 3000, 50);
+  monitor.record(&second, 4000, 900);
+  TEST_ASSERT_EQUAL_UINT32(1, first.overruns);
+  TEST_ASSERT_EQUAL_UINT32(1, second.overruns);
+  TEST_ASSERT_EQUAL_UINT32(2, monitor.logged());
+  TEST_ASSERT_EQUAL_UINT32(0, monitor.oldestLogged());
+
+  DeadlineOverrun overrun;
+  TEST_ASSERT_TRUE(monitor.readOverrun(0, &overrun));
+  TEST_ASSERT_EQUAL_UINT8(0, overrun.stage);
+  TEST_ASSERT_EQUAL_INT64(2000, overrun.startUs);
+  TEST_ASSERT_EQUAL_UINT32(101, overrun.durationUs);
+  TEST_ASSERT_TRUE(monitor.readOverrun(1, &overrun));
+  TEST_ASSERT_EQUAL_UINT8(1, overrun.stage);
+  TEST_ASSERT_EQUAL_INT64(4000, overrun.startUs);
+  TEST_ASSERT_EQUAL_UINT32(900, overrun.durationUs);
+  TEST_ASSERT_FALSE(monitor.readOverrun(2, &overrun));
+}
+
+static void test_the_log_keeps_the_newest_overruns() {
+  DeadlineMonitor monitor(WINDOW_RUNS);
+  DeadlineStage stage = makeStage("job", 10);
+  TEST_ASSERT_TRUE(monitor.add(&stage));
+  const uint32_t count = DEADLINE_LOG_SIZE + 5;
+  for (uint32_t i = 0; i < count; i++) {
+    monitor.record(&stage, i, 11 + i);
+  }
+  TEST_ASSERT_EQUAL_UINT32(count, monitor.logged());
+  TEST_ASSERT_EQUAL_UINT32(5, monitor.oldestLogged());
+
+  DeadlineOverrun overrun;
+  for (uint32_t slot = 0; slot < 5; slot++) {
+    TEST_ASSERT_FALSE(monitor.readOverrun(slot, &overrun));
+  }
+  for (uint32_t slot = 5; slot < count; slot++) {
+    TEST_ASSERT_TRUE(monitor.readOverrun(slot, &overrun));
+    TEST_ASSERT_EQUAL_UINT32(slot + 1, overrun.sequence);
+    TEST_ASSERT_EQUAL_INT64(slot, overrun.startUs);
+    TEST_ASSERT_EQUAL_UINT32(11 + slot, overrun.durationUs);
+  }
+}
+
+static void test_breach_needs_more_than_one_percent_of_a_window() {
+  DeadlineMonitor monitor(WINDOW_RUNS);
+  DeadlineStage quiet = makeStage("quiet", 100);
+  DeadlineStage stage = makeStage("job", 100);
+  TEST_ASSERT_TRUE(monitor.add(&quiet));
+  TEST_ASSERT_TRUE(monitor.add(&stage));
+
+  // Exactly 1 %: the 99th percentile is still on budget
+  for (uint32_t i = 0; i < WINDOW_RUNS; i++) {
+    monitor.record(&stage, i, i < WINDOW_RUNS / 100 ? 500 : 50);
+  }
+  TEST_ASSERT_EQUAL_UINT32(WINDOW_RUNS / 100, stage.overruns);
+  TEST_ASSERT_EQUAL_UINT32(0, stage.breaches);
+  TEST_ASSERT_EQUAL_UINT32(0, monitor.takeBreaches());
+
+  // One more, at the end of the window
+  for (uint32_t i = 0; i < WINDOW_RUNS; i++) {
+    monitor.record(&stage, i, i < WINDOW_RUNS / 100 || i == WINDOW_RUNS - 1 ? 500 : 50);
+  }
+  TEST_ASSERT_EQUAL_UINT32(1, stage.breaches);
+  TEST_ASSERT_EQUAL_UINT32(1UL << 1, monitor.takeBreaches());
+  TEST_ASSERT_EQUAL_UINT32(0, monitor.takeBreaches());
+
+  // Overruns do not carry over into the next window
+  for (uint32_t i = 0; i < WINDOW_RUNS; i++) {
+    monitor.record(&stage, i, i == 0 ? 500 : 50);
+  }
+  TEST_ASSERT_EQUAL_UINT32(1, stage.breaches);
+  TEST_ASSERT_EQUAL_UINT32(0, monitor.takeBreaches());
+  TEST_ASSERT_EQUAL_UINT32(0, quiet.runs);
+}
+
+static void test_percentiles_from_the_histogram() {
+  DeadlineMonitor monitor(WINDOW_RUNS);
+  DeadlineStage stage = makeStage("job", 800);
+  TEST_ASSERT_TRUE(monitor.add(&stage));
+  TEST_ASSERT_EQUAL_UINT32(0, DeadlineMonitor::percentileUs(&stage, 99));
+
+  // Buckets of 100 us: the upper end of the bucket, but never above the maximum
+  for (uint32_t i = 0; i < 98; i++) {
+    monitor.record(&stage, i, 50);
+  }
+  TEST_ASSERT_EQUAL_UINT32(50, DeadlineMonitor::percentileUs(&stage, 99));
+  monitor.record(&stage, 98, 750);
+  monitor.record(&stage, 99, 2000);
+  TEST_ASSERT_EQUAL_UINT32(100, DeadlineMonitor::percentileUs(&stage, 50));
+  TEST_ASSERT_EQUAL_UINT32(100, DeadlineMonitor::percentileUs(&stage, 98));
+  TEST_ASSERT_EQUAL_UINT32(800, DeadlineMonitor::percentileUs(&stage, 99));
+  TEST_ASSERT_EQUAL_UINT32(2000, DeadlineMonitor::percentileUs(&stage, 100));
+
+  // Beyond the histogram the maximum is all that is known
+  monitor.record(&stage, 100, 60000);
+  TEST_ASSERT_EQUAL_UINT32(60000, DeadlineMonitor::percentileUs(&stage, 100));
+  TEST_ASSERT_EQUAL_UINT32(1, stage.histogram[DEADLINE_BUCKETS - 1]);
+
+  DeadlineMonitor::resetStats(&stage);
+  TEST_ASSERT_EQUAL_UINT32(0, stage.runs);
+  TEST_ASSERT_EQUAL_UINT32(0, stage.maxUs);
+  TEST_ASSERT_EQUAL_UINT32(0, DeadlineMonitor::percentileUs(&stage, 99));
+}
+
+static void test_add_rejects_zero_budget_and_too_many_stages() {
+  DeadlineMonitor monitor(WINDOW_RUNS);
+  DeadlineStage zero = makeStage("zero", 0);
+  TEST_ASSERT_FALSE(monitor.add(&zero));
+
+  static DeadlineStage stages[DEADLINE_MAX_STAGES + 1];
+  for (uint32_t i = 0; i < DEADLINE_MAX_STAGES; i++) {
+    stages[i] = makeStage("job", 1 + i);
+    TEST_ASSERT_TRUE(monitor.add(&stages[i]));
+    TEST_ASSERT_EQUAL_UINT8(i, stages[i].index);
+  }
+  stages[DEADLINE_MAX_STAGES] = makeStage("late", 100);
+  TEST_ASSERT_FALSE(monitor.add(&stages[DEADLINE_MAX_STAGES]));
+  TEST_ASSERT_EQUAL_UINT8(DEADLINE_MAX_STAGES, monitor.stageCount());
+
+  // Budgets below one bucket per eighth still get 1 us buckets
+  TEST_ASSERT_EQUAL_UINT32(1, stages[0].bucketUs);
+  monitor.record(&stages[0], 0, 2);
+  TEST_ASSERT_EQUAL_UINT32(1, stages[0].overruns);
+  TEST_ASSERT_EQUAL_UINT32(1, stages[0].histogram[2]);
+
+  // The highest index still fits the breach mask
+  DeadlineStage& last = stages[DEADLINE_MAX_STAGES - 1];
+  for (uint32_t i = 0; i < WINDOW_RUNS; i++) {
+    monitor.record(&last, i, 1000);
+  }
+  TEST_ASSERT_EQUAL_UINT32(1UL << (DEADLINE_MAX_STAGES - 1), monitor.takeBreaches());
+}
+
+// Events handled by the main loop: released after the resolve window, then
+// handled after a short busy time, with late handling injected at a rate
+static uint32_t eventStageBreaches(DeadlineMonitor& monitor, DeadlineStage& stage, uint32_t latePerMille) {
+  std::mt19937 random(11);
+  int64_t edgeUs = 0;
+  for (uint32_t i = 0; i < 50 * WINDOW_RUNS; i++) {
+    edgeUs += 5000 + random() % 200000;
+    int64_t releaseUs = edgeUs + RESOLVE_WINDOW_US;
+    uint32_t handlingUs = 50 + random() % 300;
+    if (random() % 1000 < latePerMille) {
+      handlingUs += EVENT_BUDGET_US;
+    }
+    int64_t handledUs = releaseUs + handlingUs;
+    uint32_t lateUs = handledUs > releaseUs ? (uint32_t)(handledUs - releaseUs) : 0;
+    monitor.record(&stage, releaseUs, lateUs);
+  }
+  monitor.takeBreaches();
+  return stage.breaches;
+}
+
+static void test_clock_events_are_timed_from_their_release() {
+  DeadlineMonitor monitor(WINDOW_RUNS);
+  DeadlineStage stage = makeStage("clock_event", EVENT_BUDGET_US);
+  TEST_ASSERT_TRUE(monitor.add(&stage));
+
+  // The fixed hold is not charged, an event handled in time is on budget
+  TEST_ASSERT_EQUAL_UINT32(0, eventStageBreaches(monitor, stage, 0));
+  TEST_ASSERT_EQUAL_UINT32(0, stage.overruns);
+  TEST_ASSERT_LESS_THAN_UINT32(EVENT_BUDGET_US, DeadlineMonitor::percentileUs(&stage, 99));
+
+  // Rare late events stay below the p99 line, frequent ones breach it
+  DeadlineMonitor::resetStats(&stage);
+  uint32_t rare = eventStageBreaches(monitor, stage, 2);
+  uint32_t rareOverruns = stage.overruns;
+  DeadlineMonitor::resetStats(&stage);
+  uint32_t frequent = eventStageBreaches(monitor, stage, 30);
+  char line[96];
+  snprintf(line, sizeof(line), "0.2 %% late: %u overruns, %u of 50 windows breached; 3 %% late: %u breached",
+           (unsigned)rareOverruns, (unsigned)rare, (unsigned)frequent);
+  TEST_MESSAGE(line);
+  TEST_ASSERT_GREATER_THAN_UINT32(0, rareOverruns);
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(2, rare);
+  TEST_ASSERT_GREATER_OR_EQUAL_UINT32(40, frequent);
+  TEST_ASSERT_GREATER_THAN_UINT32(EVENT_BUDGET_US, DeadlineMonitor::percentileUs(&stage, 99));
+}
+
+static void test_log_reads_are_consistent_while_stages_record() {
+  DeadlineMonitor monitor(WINDOW_RUNS);
+  DeadlineStage stages[2] = { makeStage("core0", 100), makeStage("core1", 100) };
+  TEST_ASSERT_TRUE(monitor.add(&stages[0]));
+  TEST_ASSERT_TRUE(monitor.add(&stages[1]));
+
+  // Each stage from its own thread, every run an overrun whose duration encodes stage and start
+  const uint32_t runs = 200000;
+  std::atomic<bool> done(false);
+  std::thread writers[2];
+  for (int i = 0; i < 2; i++) {
+    writers[i] = std::thread([&monitor, &stages, i]() {
+      for (uint32_t run = 0; run < runs; run++) {
+        monitor.record(&stages[i], run, 1000 + run * 2 + i);
+      }
+    });
+  }
+  uint32_t reads = 0;
+  uint32_t torn = 0;
+  std::thread reader([&]() {
+    while (!done.load()) {
+      DeadlineOverrun overrun;
+      for (uint32_t slot = monitor.oldestLogged(); slot < monitor.logged(); slot++) {
+        if (monitor.readOverrun(slot, &overrun)) {
+          reads++;
+          if (overrun.durationUs != 1000 + overrun.startUs * 2 + overrun.stage) {
+            torn++;
+          }
+        }
+      }
+    }
+  });
+  writers[0].join();
+  writers[1].join();
+  done = true;
+  reader.join();
+
+  TEST_ASSERT_EQUAL_UINT32(0, torn);
+  TEST_ASSERT_EQUAL_UINT32(2 * runs, monitor.logged());
+  TEST_ASSERT_EQUAL_UINT32(runs, stages[0].overruns);
+  TEST_ASSERT_EQUAL_UINT32(runs, stages[1].overruns);
+  TEST_ASSERT_GREATER_THAN_UINT32(0, reads);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_runs_on_budget_are_not_overruns);
+  RUN_TEST(test_injected_overruns_are_logged_with_stage_and_start);
+  RUN_TEST(test_the_log_keeps_the_newest_overruns);
+  RUN_TEST(test_breach_needs_more_than_one_percent_of_a_window);
+  RUN_TEST(test_percentiles_from_the_histogram);
+  RUN_TEST(test_add_rejects_zero_budget_and_too_many_stages);
+  RUN_TEST(test_clock_events_are_timed_from_their_release);
+  RUN_TEST(test_log_reads_are_consistent_while_stages_record);
+  return UNITY_END();
+}
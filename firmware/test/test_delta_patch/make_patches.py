@@ -0,0 +1,123 @@
+#!/usr/bin/env python3
+"""
+Creates patches.h for the delta patch host tests
+
+The old and new images are built from a fixed xorshift sequence exactly
+like images() in test_main.cpp, patched with tools/delta_patch.py and
+written out as C arrays. Run it again after a change of the patch format:
+
+  python3 test/test_delta_patch/make_patches.py
+"""
+
+import os
+import sys
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+sys.path.insert(0, os.path.join(HERE, "..", "..", "tools"))
+import delta_patch  # noqa: E402
+
+OLD_SIZE = 32768
+BLOCK = 256
+TEXT = b"CHESS CLOCK "
+
+
+def xorshift(state):
+    state ^= (state << 13) & 0xFFFFFFFF
+    state ^= state >> 17
+    state ^= (state << 5) & 0xFFFFFFFF
+    return state
+
+
+def random_bytes(seed, size):
+    out = bytearray()
+    state = seed
+    for _ in range(size):
+        state = xorshift(state)
+        out.append(state & 0xFF)
+    return out
+
+
+def old_image():
+    """Code-like random blocks, zero padding and repeated strings."""
+    out = bytearray()
+    state = 0x2545F491
+    while len(out) < OLD_SIZE:
+        state = xorshift(state)
+        kind = state % 4
+        if kind == 0:
+            out += bytes(BLOCK)
+        elif kind == 1:
+            out += (TEXT * (BLOCK // len(TEXT) + 1))[:BLOCK]
+        else:
+            for _ in range(BLOCK):
+                state = xorshift(state)
+                out.append(state & 0xFF)
+    return bytes(out)
+
+
+def new_images(old):
+    # A changed version string and constants, the layout stays
+    constants = bytearray(old)
+    constants[64:68] = b"v1.1"
+    for i in range(24):
+        constants[1000 + i * 1301] ^= 0x5A
+
+    # Code inserted and removed, everything behind it moves
+    relinked = bytearray(old[:8192] + bytes((i * 7) & 0xFF for i in range(512)) + old[8192:20000] + old[20100:])
+    for offset in range(12000, 24000, 64):
+        relinked[offset] = (relinked[offset] + 0x20) & 0xFF
+
+    # Nothing in common with the old image
+    rewritten = random_bytes(0x9E3779B9, 4000)
+    return [("constants", bytes(constants)), ("relinked", bytes(relinked)), ("rewritten", bytes(rewritten))]
+
+
+def bad_seek_patch(old):
+    """A valid header and a record that seeks behind the old image."""
+    body = bytearray()
+    delta_patch.put_varint(body, 0)
+    delta_patch.put_varint(body, 1)
+    delta_patch.put_svarint(body, len(old) + 1)
+    body.append(0)
+    header = delta_patch.HEADER.pack(delta_patch.MAGIC, delta_patch.WINDOW_BITS, delta_patch.LOOKAHEAD_BITS, 0,
+                                     len(old), 16, bytes(32), bytes(32))
+    return header + delta_patch.lzss_compress(bytes(body))
+
+
+def c_array(name, data):
+    lines = [f"static const uint8_t {name}[{len(data)}] = {{"]
+    for start in range(0, len(data), 16):
+        lines.append("  " + ", ".join(f"0x{b:02x}" for b in data[start:start + 16]) + ",")
+    lines.append("};")
+    return "\n".join(lines)
+
+
+def main():
+    old = old_image()
+    parts = [
+        "/*",
+        "  CDP1 patches for the delta patch host tests, created by",
+        "  make_patches.py with tools/delta_patch.py. Do not edit.",
+        "*/",
+        "",
+        "#ifndef TEST_DELTA_PATCHES_H",
+        "#define TEST_DELTA_PATCHES_H",
+        "",
+        "#include <stdint.h>",
+        "",
+    ]
+    for name, new in new_images(old):
+        patch, _ = delta_patch.make_patch(old, new)
+        if delta_patch.apply_patch(old, patch) != new:
+            raise SystemExit(f"{name}: patch does not round-trip")
+        parts.append(c_array(f"PATCH_{name.upper()}", patch))
+        parts.append("")
+        print(f"{name}: {len(patch)} bytes for a {len(new)} byte image")
+    parts.append(c_array("PATCH_BAD_SEEK", bad_seek_patch(old)))
+    parts += ["", "#endif // TEST_DELTA_PATCHES_H", ""]
+    with open(os.path.join(HERE, "patches.h"), "w") as f:
+        f.write("\n".join(parts))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,495 @@
+/*
+  CDP1 patches for the delta patch host tests, created by
+  make_patches.py with tools/delta_patch.py. Do not edit.
+*/
+
+#ifndef TEST_DELTA_PATCHES_H
+#define TEST_DELTA_PATCHES_H
+
+#include <stdint.h>
+
+static const uint8_t PATCH_CONSTANTS[1306] = {
+  0x43, 0x44, 0x50, 0x31, 0x0b, 0x06, 0x00, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0x80, 0x00, 0x00,
+  0xcf, 0xa2, 0x8e, 0x31, 0xf8, 0xef, 0x42, 0x18, 0xfe, 0x0c, 0x68, 0x90, 0x5b, 0x07, 0xe5, 0x3e,
+  0x26, 0x2b, 0x5c, 0x29, 0x87, 0xf7, 0xe4, 0x9a, 0x8b, 0xdb, 0x5f, 0xae, 0x51, 0x48, 0xf6, 0xf6,
+  0x3a, 0x1f, 0x40, 0xa5, 0xa0, 0xeb, 0xc5, 0xea, 0xdb, 0xe5, 0x3c, 0xab, 0x05, 0x6e, 0x7d, 0xc6,
+  0x3e, 0xba, 0x94, 0x2d, 0x29, 0xdb, 0xbf, 0xae, 0x58, 0xf8, 0x1d, 0xfa, 0x5f, 0x2b, 0x79, 0xaf,
+  0x80, 0x40, 0x20, 0x18, 0x0c, 0x04, 0x08, 0x01, 0x40, 0x00, 0x0f, 0x32, 0xd7, 0x89, 0x45, 0xfc,
+  0x05, 0x4f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0,
+  0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0,
+  0x03, 0x5d, 0x30, 0x09, 0x1e, 0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f,
+  0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e,
+  0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01, 0xf8,
+  0x00, 0x33, 0xc6, 0x01, 0x23, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03,
+  0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f,
+  0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f,
+  0x00, 0x06, 0x6b, 0x40, 0x24, 0x78, 0x00, 0x7e, 0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00,
+  0x7e, 0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01,
+  0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80, 0x07,
+  0xe0, 0x00, 0xcc, 0xe8, 0x04, 0x8f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00,
+  0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00,
+  0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00,
+  0xfc, 0x00, 0x19, 0xab, 0x00, 0x91, 0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80, 0x07, 0xe0,
+  0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80,
+  0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00,
+  0x1f, 0x80, 0x03, 0x35, 0xa0, 0x12, 0x3c, 0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc,
+  0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0,
+  0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0,
+  0x03, 0xf0, 0x00, 0x67, 0xac, 0x02, 0x47, 0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f,
+  0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e,
+  0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01, 0xf8,
+  0x00, 0x7e, 0x00, 0x0c, 0xd6, 0x80, 0x48, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03,
+  0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f,
+  0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f,
+  0x00, 0x0f, 0xc0, 0x01, 0x9e, 0xb0, 0x09, 0x1e, 0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00,
+  0x7e, 0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01,
+  0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80, 0x07,
+  0xe0, 0x01, 0xf8, 0x00, 0x33, 0xca, 0x01, 0x23, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00,
+  0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00,
+  0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00,
+  0xfc, 0x00, 0x3f, 0x00, 0x06, 0x76, 0xc0, 0x24, 0x78, 0x00, 0x7e, 0x00, 0x1f, 0x80, 0x07, 0xe0,
+  0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80,
+  0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00,
+  0x1f, 0x80, 0x07, 0xe0, 0x00, 0xcd, 0x68, 0x04, 0x8f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc,
+  0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0,
+  0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0,
+  0x03, 0xf0, 0x00, 0xfc, 0x00, 0x19, 0xeb, 0x00, 0x91, 0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f,
+  0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e,
+  0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01, 0xf8,
+  0x00, 0x7e, 0x00, 0x1f, 0x80, 0x03, 0x2a, 0x29, 0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80, 0x07, 0xe0,
+  0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80,
+  0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00,
+  0x1f, 0x80, 0x05, 0x9d, 0xa0, 0x12, 0x3c, 0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc,
+  0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0,
+  0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0,
+  0x03, 0xf0, 0x00, 0x66, 0xac, 0x02, 0x47, 0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f,
+  0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e,
+  0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01, 0xf8,
+  0x00, 0x7e, 0x00, 0x0c, 0xf1, 0x80, 0x48, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03,
+  0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f,
+  0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f,
+  0x00, 0x0f, 0xc0, 0x01, 0x9e, 0x50, 0x09, 0x1e, 0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00,
+  0x7e, 0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01,
+  0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80, 0x07,
+  0xe0, 0x01, 0xf8, 0x00, 0x33, 0xda, 0x01, 0x23, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00,
+  0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00,
+  0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00,
+  0xfc, 0x00, 0x3f, 0x00, 0x06, 0x6b, 0x40, 0x24, 0x78, 0x00, 0x7e, 0x00, 0x1f, 0x80, 0x07, 0xe0,
+  0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80,
+  0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00,
+  0x1f, 0x80, 0x07, 0xe0, 0x00, 0xcc, 0xe8, 0x04, 0x8f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc,
+  0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0,
+  0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0,
+  0x03, 0xf0, 0x00, 0xfc, 0x00, 0x19, 0x9b, 0x00, 0x91, 0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f,
+  0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e,
+  0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01, 0xf8,
+  0x00, 0x7e, 0x00, 0x1f, 0x80, 0x03, 0x3d, 0xa0, 0x12, 0x3c, 0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03,
+  0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f,
+  0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f,
+  0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00, 0x66, 0xb4, 0x02, 0x47, 0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00,
+  0x7e, 0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01,
+  0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80, 0x07,
+  0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f,
+  0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00, 0x14, 0x80,
+};
+
+static const uint8_t PATCH_RELINKED[1543] = {
+  0x43, 0x44, 0x50, 0x31, 0x0b, 0x06, 0x00, 0x00, 0x00, 0x80, 0x00, 0x00, 0x9c, 0x81, 0x00, 0x00,
+  0xcf, 0xa2, 0x8e, 0x31, 0xf8, 0xef, 0x42, 0x18, 0xfe, 0x0c, 0x68, 0x90, 0x5b, 0x07, 0xe5, 0x3e,
+  0x26, 0x2b, 0x5c, 0x29, 0x87, 0xf7, 0xe4, 0x9a, 0x8b, 0xdb, 0x5f, 0xae, 0x51, 0x48, 0xf6, 0xf6,
+  0xa3, 0x70, 0x3d, 0x64, 0x76, 0xb0, 0xc8, 0x62, 0x5c, 0xf5, 0xa1, 0x30, 0xdb, 0x7e, 0xa8, 0x8e,
+  0x62, 0x9e, 0x08, 0xf8, 0xa7, 0x01, 0x63, 0xf3, 0x26, 0xb8, 0x13, 0xe1, 0x63, 0xf1, 0x56, 0x45,
+  0x80, 0x40, 0x20, 0x18, 0x1a, 0x07, 0xfe, 0x07, 0x81, 0xb2, 0x00, 0x40, 0x00, 0x01, 0xf8, 0x00,
+  0x7e, 0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01,
+  0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80, 0x07,
+  0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f,
+  0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e,
+  0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01, 0xf8,
+  0x00, 0x7e, 0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80, 0x07, 0xe0,
+  0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80,
+  0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00,
+  0x1f, 0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00,
+  0x7e, 0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01,
+  0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80, 0x07,
+  0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f,
+  0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e,
+  0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01, 0xf8,
+  0x00, 0x7e, 0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80, 0x07, 0xe0,
+  0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80,
+  0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80, 0x07, 0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00,
+  0x1f, 0x80, 0x07, 0xe0, 0x00, 0x1c, 0x1e, 0x1d, 0x15, 0x8e, 0x48, 0xe5, 0x53, 0x19, 0xc4, 0xfe,
+  0x8d, 0x4d, 0xaa, 0x56, 0xec, 0x56, 0x9b, 0x85, 0xde, 0xfd, 0x85, 0xc6, 0x64, 0xf3, 0x5a, 0x1d,
+  0x46, 0xbf, 0x6d, 0xbd, 0xe2, 0x72, 0xfa, 0x5d, 0x9f, 0x07, 0x9f, 0xdd, 0xf5, 0xfe, 0x40, 0xe1,
+  0x51, 0x18, 0xc4, 0x7e, 0x4d, 0x2d, 0x9a, 0x4e, 0xe8, 0x54, 0x9a, 0x85, 0x5e, 0xbd, 0x65, 0xb6,
+  0x5c, 0xef, 0x58, 0x1c, 0x46, 0x3f, 0x2d, 0x9d, 0xd2, 0x6a, 0xf6, 0x5b, 0x9e, 0x07, 0x1f, 0x9d,
+  0xd5, 0xee, 0x78, 0xfd, 0x5f, 0x1f, 0xc7, 0xfe, 0x0d, 0x0d, 0x8a, 0x46, 0xe4, 0x52, 0x99, 0x84,
+  0xde, 0x7d, 0x45, 0xa6, 0x54, 0xeb, 0x56, 0x1b, 0x45, 0xbe, 0xed, 0x7d, 0xc2, 0x62, 0xf2, 0x59,
+  0x9d, 0x06, 0x9f, 0x5d, 0xb5, 0xde, 0x70, 0xf9, 0x5d, 0x1e, 0xc7, 0x7f, 0xcd, 0xed, 0xfa, 0x7e,
+  0xe0, 0x50, 0x98, 0x84, 0x5e, 0x3d, 0x25, 0x96, 0x4c, 0xe7, 0x54, 0x1a, 0x45, 0x3e, 0xad, 0x5d,
+  0xb2, 0x5a, 0xee, 0x57, 0x9c, 0x06, 0x1f, 0x1d, 0x95, 0xce, 0x68, 0xf5, 0x5b, 0x1d, 0xc6, 0xff,
+  0x8d, 0xcd, 0xea, 0x76, 0xfc, 0x5e, 0x9f, 0x87, 0xdf, 0xfd, 0x05, 0x86, 0x44, 0xe3, 0x52, 0x19,
+  0x44, 0xbe, 0x6d, 0x3d, 0xa2, 0x52, 0xea, 0x55, 0x9b, 0x05, 0x9e, 0xdd, 0x75, 0xbe, 0x60, 0xf1,
+  0x59, 0x1c, 0xc6, 0x7f, 0x4d, 0xad, 0xda, 0x6e, 0xf8, 0x5c, 0x9e, 0x87, 0x5f, 0xbd, 0xe5, 0xf6,
+  0x7c, 0xff, 0x50, 0x18, 0x44, 0x3e, 0x2d, 0x1d, 0x92, 0x4a, 0xe6, 0x53, 0x9a, 0x05, 0x1e, 0x9d,
+  0x55, 0xae, 0x58, 0xed, 0x57, 0x1b, 0xc5, 0xff, 0x0d, 0x8d, 0xca, 0x66, 0xf4, 0x5a, 0x9d, 0x86,
+  0xdf, 0x7d, 0xc5, 0xe6, 0x74, 0xfb, 0x5e, 0x1f, 0x47, 0xbf, 0xed, 0xfd, 0x82, 0x42, 0xe2, 0x51,
+  0x99, 0x04, 0x9e, 0x5d, 0x35, 0x9e, 0x50, 0xe9, 0x55, 0x1a, 0xc5, 0x7e, 0xcd, 0x6d, 0xba, 0x5e,
+  0xf0, 0x58, 0x9c, 0x86, 0x5f, 0x3d, 0xa5, 0xd6, 0x6c, 0xf7, 0x5c, 0x1e, 0x47, 0x3f, 0xad, 0xdd,
+  0xf2, 0x7a, 0xfe, 0x5f, 0x90, 0xff, 0xfc, 0x3f, 0xff, 0x0f, 0xff, 0xc3, 0xff, 0x7c, 0x04, 0x0a,
+  0x01, 0x80, 0xb2, 0x10, 0xa9, 0xe0, 0x01, 0xf8, 0x00, 0x7e, 0x00, 0x1f, 0x80, 0x04, 0xba, 0x0a,
+  0xd4, 0x07, 0x95, 0x01, 0x01, 0x63, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0,
+  0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00,
+  0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00,
+  0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00,
+  0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03,
+  0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f,
+  0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xc6, 0x40, 0x02,
+  0x47, 0x80, 0x05, 0x40, 0x7f, 0xf8, 0x00, 0x76, 0x07, 0xff, 0x80, 0x07, 0x60, 0x7f, 0xf8, 0x00,
+  0x76, 0x07, 0xff, 0x80, 0x07, 0x60, 0x7f, 0xf8, 0x00, 0x76, 0x07, 0xff, 0x80, 0x07, 0x60, 0x7f,
+  0xf8, 0x00, 0x76, 0x07, 0xff, 0x80, 0x07, 0x60, 0x7f, 0xf8, 0x00, 0x76, 0x07, 0xff, 0x80, 0x07,
+  0x60, 0x7f, 0xf8, 0x00, 0x76, 0x07, 0xff, 0x80, 0x07, 0x60, 0x7f, 0xf8, 0x00, 0x76, 0x07, 0xff,
+  0x80, 0x07, 0x60, 0x7f, 0xf8, 0x00, 0x76, 0x07, 0xff, 0x80, 0x07, 0x60, 0x7f, 0xf8, 0x00, 0x76,
+  0x07, 0xff, 0x80, 0x07, 0x60, 0x7f, 0xf8, 0x00, 0x76, 0x07, 0xff, 0x80, 0x07, 0x60, 0x7f, 0xf8,
+  0x00, 0x76, 0x07, 0xff, 0x80, 0x07, 0x60, 0x7f, 0xf8, 0x00, 0x76, 0x07, 0xff, 0x80, 0x07, 0x60,
+  0x7f, 0xf8, 0x00, 0x76, 0x07, 0xff, 0x80, 0x07, 0x60, 0x7f, 0xf8, 0x00, 0x76, 0x07, 0xff, 0x80,
+  0x07, 0x60, 0x7f, 0xf8, 0x00, 0x76, 0x07, 0xff, 0x80, 0x07, 0x60, 0x7f, 0xf8, 0x00, 0x76, 0x07,
+  0xff, 0x80, 0x07, 0x60, 0x7f, 0xf8, 0x00, 0x76, 0x07, 0xff, 0x80, 0x07, 0x60, 0x7f, 0xf8, 0x00,
+  0x76, 0x07, 0xff, 0x80, 0x07, 0x60, 0x7f, 0xf8, 0x00, 0x76, 0x07, 0xff, 0x80, 0x07, 0x60, 0x7f,
+  0xf8, 0x00, 0x76, 0x07, 0xff, 0x80, 0x07, 0x60, 0x7f, 0xf8, 0x00, 0x76, 0x07, 0xff, 0x80, 0x07,
+  0x60, 0x7f, 0xf8, 0x00, 0x76, 0x07, 0xff, 0x80, 0x07, 0x60, 0x7f, 0xf8, 0x00, 0x76, 0x07, 0xff,
+  0x80, 0x07, 0x60, 0x7f, 0xf8, 0x00, 0x76, 0x07, 0xff, 0x80, 0x07, 0x60, 0x7f, 0xf8, 0x00, 0x76,
+  0x07, 0xff, 0x80, 0x07, 0x60, 0x7f, 0xf8, 0x00, 0x76, 0x07, 0xff, 0x80, 0x07, 0x60, 0x7f, 0xf8,
+  0x00, 0x76, 0x07, 0xff, 0x80, 0x07, 0x60, 0x7f, 0xf8, 0x00, 0x76, 0x07, 0xff, 0x80, 0x07, 0x60,
+  0x7f, 0xf8, 0x00, 0x76, 0x07, 0xff, 0x80, 0x07, 0x60, 0x7f, 0xf8, 0x00, 0x76, 0x07, 0xff, 0x80,
+  0x07, 0x60, 0x7f, 0xf8, 0x00, 0x76, 0x07, 0xff, 0x80, 0x07, 0x60, 0x7f, 0xf8, 0x00, 0x76, 0x07,
+  0xff, 0x80, 0x07, 0x60, 0x7f, 0xf8, 0x00, 0x76, 0x07, 0xff, 0x80, 0x07, 0x71, 0x9f, 0xdd, 0x88,
+  0x05, 0x0f, 0x00, 0x0b, 0x03, 0x0f, 0xf0, 0x00, 0xec, 0x0f, 0xff, 0x00, 0x0e, 0xc0, 0xff, 0xf0,
+  0x00, 0xec, 0x0f, 0xff, 0x00, 0x0e, 0xc0, 0xff, 0xf0, 0x00, 0xec, 0x0f, 0xff, 0x00, 0x0e, 0xc0,
+  0xff, 0xf0, 0x00, 0xec, 0x0f, 0xff, 0x00, 0x0e, 0xc0, 0xff, 0xf0, 0x00, 0xec, 0x0f, 0xff, 0x00,
+  0x0e, 0xc0, 0xff, 0xf0, 0x00, 0xec, 0x0f, 0xff, 0x00, 0x0e, 0xc0, 0xff, 0xf0, 0x00, 0xec, 0x0f,
+  0xff, 0x00, 0x0e, 0xc0, 0xff, 0xf0, 0x00, 0xec, 0x0f, 0xff, 0x00, 0x0e, 0xc0, 0xff, 0xf0, 0x00,
+  0xec, 0x0f, 0xff, 0x00, 0x0e, 0xc0, 0xff, 0xf0, 0x00, 0xec, 0x0f, 0xff, 0x00, 0x0e, 0xc0, 0xff,
+  0xf0, 0x00, 0xec, 0x0f, 0xff, 0x00, 0x0e, 0xc0, 0xff, 0xf0, 0x00, 0xec, 0x0f, 0xff, 0x00, 0x0e,
+  0xc0, 0xff, 0xf0, 0x00, 0xec, 0x0f, 0xff, 0x00, 0x0e, 0xc0, 0xff, 0xf0, 0x00, 0xfc, 0x00, 0x3f,
+  0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc,
+  0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0,
+  0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0,
+  0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00,
+  0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00,
+  0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00,
+  0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03,
+  0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f,
+  0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f,
+  0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc,
+  0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0,
+  0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0,
+  0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00,
+  0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00,
+  0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00,
+  0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03,
+  0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f,
+  0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f,
+  0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc, 0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x03, 0xf0, 0x00, 0xfc,
+  0x00, 0x3f, 0x00, 0x0f, 0xc0, 0x02, 0x10,
+};
+
+static const uint8_t PATCH_REWRITTEN[4585] = {
+  0x43, 0x44, 0x50, 0x31, 0x0b, 0x06, 0x00, 0x00, 0x00, 0x80, 0x00, 0x00, 0xa0, 0x0f, 0x00, 0x00,
+  0xcf, 0xa2, 0x8e, 0x31, 0xf8, 0xef, 0x42, 0x18, 0xfe, 0x0c, 0x68, 0x90, 0x5b, 0x07, 0xe5, 0x3e,
+  0x26, 0x2b, 0x5c, 0x29, 0x87, 0xf7, 0xe4, 0x9a, 0x8b, 0xdb, 0x5f, 0xae, 0x51, 0x48, 0xf6, 0xf6,
+  0x13, 0x81, 0xbb, 0xfe, 0x38, 0x35, 0xfd, 0x0c, 0x60, 0x33, 0xd5, 0xf8, 0x11, 0xb1, 0x13, 0x60,
+  0x1f, 0xc8, 0x31, 0x34, 0x6d, 0x3b, 0xf2, 0x8a, 0x29, 0x5f, 0x5c, 0x2b, 0x07, 0xc0, 0x4a, 0x88,
+  0x80, 0x68, 0x23, 0xf0, 0x08, 0xcc, 0xfa, 0x75, 0xb5, 0x8f, 0xcd, 0xfa, 0x1b, 0xf9, 0xce, 0xe3,
+  0xdd, 0xb4, 0xe9, 0xcf, 0x37, 0x15, 0xfc, 0x57, 0x7a, 0xfb, 0x3f, 0xdf, 0xf7, 0xbb, 0x1a, 0x28,
+  0xe5, 0x27, 0xd5, 0x8e, 0xf0, 0xdd, 0x34, 0xd9, 0xab, 0x5d, 0x07, 0x8f, 0x7a, 0xbf, 0x5f, 0xb5,
+  0xdd, 0xfc, 0xed, 0xce, 0x53, 0xb4, 0xbb, 0x59, 0x67, 0xba, 0x6e, 0xdd, 0xd3, 0x9d, 0xfd, 0xbe,
+  0xd1, 0x21, 0xf6, 0x8b, 0xbf, 0x96, 0x53, 0xb8, 0xca, 0x66, 0x25, 0xdc, 0x0a, 0x9f, 0x3f, 0xc5,
+  0xec, 0xd8, 0x6a, 0xe5, 0x9b, 0xde, 0x5e, 0xdf, 0x8f, 0xc0, 0xc3, 0xca, 0xee, 0xd0, 0x18, 0x2e,
+  0x7f, 0xf7, 0xe0, 0xc2, 0x69, 0x30, 0xdd, 0x88, 0xdd, 0xb3, 0xe3, 0x69, 0x8e, 0x42, 0x61, 0xff,
+  0x88, 0xdc, 0x33, 0xdb, 0xdd, 0xe5, 0x68, 0x77, 0xb4, 0x2c, 0xec, 0x33, 0xbd, 0xbf, 0xd4, 0xcd,
+  0x7c, 0x15, 0x5a, 0x7e, 0xcf, 0xaf, 0x78, 0xc1, 0xd9, 0x77, 0x78, 0xf8, 0xb6, 0xee, 0x61, 0x1b,
+  0xa6, 0xf8, 0x63, 0xbc, 0x1f, 0x2d, 0xe3, 0x33, 0xd8, 0xb9, 0x6b, 0x35, 0xd2, 0xde, 0x36, 0x36,
+  0x5f, 0x91, 0xc8, 0x5e, 0x2b, 0xb7, 0x4b, 0xa4, 0x67, 0x85, 0xf4, 0xbb, 0xcb, 0xa6, 0x3e, 0xc9,
+  0x5c, 0x0e, 0x2d, 0x06, 0xfd, 0x44, 0x30, 0xba, 0x2c, 0xcc, 0x93, 0xa7, 0xb1, 0xe4, 0x40, 0x38,
+  0xff, 0xcd, 0x36, 0x0e, 0x99, 0xbe, 0xf3, 0x42, 0x2a, 0x3f, 0x3f, 0x7e, 0xd6, 0x21, 0xaf, 0x86,
+  0xe1, 0xb1, 0x59, 0x39, 0x75, 0x97, 0xd3, 0x86, 0x95, 0xf5, 0xa9, 0x3b, 0x5f, 0xf4, 0xdb, 0x59,
+  0xcd, 0xf3, 0xfd, 0xbd, 0xd1, 0x8d, 0x64, 0x1b, 0x81, 0x75, 0xfe, 0xc6, 0x25, 0xd8, 0xad, 0xd4,
+  0x6a, 0xb5, 0x30, 0xfc, 0xff, 0xe0, 0x54, 0x1f, 0x8e, 0xda, 0x89, 0x6a, 0xec, 0x48, 0xe2, 0x7e,
+  0xae, 0x26, 0xc3, 0x41, 0xc2, 0xd7, 0x49, 0x36, 0xff, 0x6d, 0xc6, 0x82, 0xcb, 0xa2, 0xec, 0x6d,
+  0x72, 0x30, 0xcd, 0x7d, 0xbb, 0x79, 0x3d, 0xc0, 0xf5, 0xb2, 0x73, 0x28, 0xce, 0x26, 0x11, 0xee,
+  0xb9, 0x73, 0x2d, 0x59, 0x3f, 0xb7, 0x17, 0x61, 0x87, 0x8c, 0x64, 0xae, 0x1a, 0xd9, 0xbc, 0x27,
+  0x9d, 0x7d, 0xa9, 0x7f, 0x61, 0x77, 0x99, 0xa7, 0xf3, 0x51, 0xd3, 0x81, 0xf8, 0x3b, 0x13, 0x5b,
+  0xf4, 0x9f, 0xcf, 0x1d, 0xd2, 0x41, 0xb7, 0x57, 0x0c, 0xce, 0xaf, 0xdf, 0xf8, 0x82, 0x59, 0xe5,
+  0xd5, 0xba, 0x95, 0xc6, 0x0b, 0xb3, 0x8f, 0x56, 0x39, 0x57, 0xae, 0xf6, 0x76, 0x2f, 0x50, 0xe2,
+  0x7a, 0x34, 0x36, 0x8c, 0xde, 0x2f, 0xc1, 0xee, 0x98, 0xe6, 0x7b, 0xb1, 0x7c, 0x06, 0x6f, 0xf1,
+  0x63, 0x97, 0xec, 0xe2, 0x1b, 0xbf, 0x0e, 0x52, 0x2f, 0x63, 0xd3, 0xd7, 0xeb, 0x3e, 0x2d, 0x16,
+  0x56, 0x5b, 0x5f, 0xa5, 0xd7, 0xb4, 0x37, 0x4b, 0x77, 0xae, 0xad, 0x38, 0xee, 0xe3, 0xe2, 0xd4,
+  0xda, 0x6e, 0xc7, 0xa5, 0x46, 0x8d, 0xe6, 0xfb, 0xf8, 0xf9, 0x7d, 0xae, 0xbd, 0x44, 0xc9, 0x4c,
+  0x62, 0x33, 0x88, 0xb5, 0xf2, 0x23, 0xf5, 0xc4, 0xd9, 0xec, 0x13, 0xea, 0x5d, 0xf3, 0xaf, 0x3b,
+  0xfe, 0x64, 0xb2, 0xfd, 0xed, 0x34, 0x93, 0x2d, 0x29, 0xcf, 0x43, 0x2f, 0xd8, 0x8f, 0x14, 0x8b,
+  0x2d, 0x9b, 0xa8, 0xcf, 0xa5, 0x7b, 0x2a, 0x56, 0xfb, 0x5d, 0x41, 0xa4, 0xf7, 0x32, 0xbe, 0x4a,
+  0x74, 0x5f, 0xeb, 0x89, 0x9c, 0x73, 0x28, 0xf7, 0x7d, 0x3c, 0xb7, 0x7d, 0xe0, 0x96, 0xda, 0x79,
+  0x3a, 0x8c, 0xcd, 0x6f, 0x13, 0xed, 0x94, 0xd7, 0xfa, 0x35, 0x2e, 0x7e, 0xb2, 0x4d, 0x41, 0xf2,
+  0x7d, 0x72, 0x1a, 0x08, 0x64, 0xb2, 0xd1, 0x61, 0x9a, 0x79, 0xfc, 0x5e, 0x9b, 0x65, 0xdf, 0x93,
+  0x35, 0xbc, 0xe2, 0x25, 0x54, 0x09, 0x16, 0xef, 0x3d, 0x55, 0x82, 0x40, 0xa9, 0x13, 0x08, 0x17,
+  0x1b, 0xfd, 0x5e, 0xf6, 0x55, 0xf5, 0xdd, 0xfc, 0x2f, 0xaf, 0x07, 0x36, 0x80, 0x7a, 0xf1, 0x38,
+  0x1a, 0xc4, 0xbb, 0xdd, 0xfd, 0x86, 0xee, 0xf4, 0x36, 0x2b, 0x47, 0xe2, 0xf3, 0xac, 0xc6, 0xd5,
+  0x2e, 0x9e, 0x8e, 0x25, 0x1f, 0x67, 0x68, 0xbf, 0xcc, 0xb7, 0xdb, 0xe8, 0xaf, 0xda, 0xbf, 0x15,
+  0xe5, 0xce, 0xb1, 0xf5, 0x5a, 0x64, 0xc7, 0x19, 0x24, 0x95, 0x72, 0x33, 0xd1, 0xc8, 0xb4, 0xf2,
+  0x11, 0x5a, 0xed, 0xdd, 0xf8, 0x98, 0x59, 0x6d, 0xaf, 0x15, 0x9e, 0xe9, 0x41, 0xb4, 0xd3, 0xdf,
+  0x5c, 0x7f, 0x55, 0xfa, 0xd6, 0xe3, 0x38, 0x5b, 0x88, 0x27, 0xae, 0xaf, 0x86, 0x94, 0x77, 0xf1,
+  0xbe, 0xfa, 0x65, 0x5b, 0xdd, 0x09, 0x8f, 0x76, 0xb1, 0x93, 0x09, 0x1f, 0xae, 0xcf, 0x49, 0xc1,
+  0x41, 0xaa, 0xd0, 0x4e, 0xaf, 0xf2, 0x87, 0xda, 0xb6, 0x60, 0xe2, 0xf1, 0x99, 0x14, 0x16, 0x8b,
+  0x41, 0xa7, 0xea, 0x72, 0x79, 0xaf, 0x9e, 0xc7, 0x2d, 0x1c, 0xa6, 0x47, 0xfb, 0xf1, 0xbb, 0x07,
+  0x9b, 0xc3, 0x85, 0xd2, 0x46, 0x32, 0xf1, 0xbd, 0x37, 0x3f, 0xd3, 0x40, 0xab, 0xe8, 0xad, 0x1c,
+  0x5f, 0xd4, 0xf7, 0x33, 0x2d, 0xaf, 0xd1, 0xf4, 0x7f, 0xde, 0xaf, 0x0a, 0x05, 0xda, 0xea, 0x7a,
+  0x64, 0x74, 0x38, 0x24, 0x93, 0x57, 0x2a, 0xaa, 0xc2, 0x65, 0xfb, 0xcc, 0x55, 0xf7, 0x5d, 0xbb,
+  0xfc, 0x72, 0x62, 0xb6, 0x98, 0x15, 0xde, 0xa7, 0xf1, 0xac, 0x42, 0xe6, 0xd2, 0xc8, 0xc4, 0xb6,
+  0x5b, 0x37, 0xd1, 0xfd, 0x68, 0xb9, 0x3d, 0x66, 0x6a, 0xaf, 0xda, 0xda, 0x43, 0x3d, 0xdc, 0x6c,
+  0x9d, 0xeb, 0xbf, 0xb8, 0xd7, 0xcb, 0x63, 0xfc, 0x5b, 0x06, 0x4a, 0x01, 0xb1, 0xe0, 0x42, 0x7e,
+  0xdb, 0x6b, 0x85, 0x1a, 0xa5, 0x84, 0xcd, 0x7f, 0xa6, 0x7b, 0xd8, 0x46, 0xa3, 0x6d, 0x64, 0xc4,
+  0x7f, 0xa3, 0x70, 0xed, 0x57, 0xe2, 0xad, 0x1c, 0xd0, 0x7b, 0x38, 0x58, 0xba, 0x95, 0xf2, 0xa7,
+  0xba, 0x83, 0xd0, 0xf6, 0x31, 0xd8, 0x04, 0xb6, 0xeb, 0x5d, 0x89, 0xc2, 0x76, 0xb0, 0x7b, 0x9c,
+  0xd6, 0xf9, 0xfb, 0x8c, 0xda, 0x6d, 0x95, 0x4d, 0x3e, 0xea, 0xcd, 0xe4, 0xb2, 0xc8, 0x60, 0x9a,
+  0xcd, 0xf7, 0xef, 0xf7, 0x22, 0xd8, 0x42, 0xa3, 0xd9, 0x8e, 0x25, 0x9f, 0xd1, 0xff, 0xa4, 0x42,
+  0x71, 0x9c, 0x0c, 0xad, 0xa2, 0xc9, 0xdc, 0xd4, 0x75, 0xa6, 0x72, 0x3f, 0x7d, 0xaf, 0x57, 0xb8,
+  0x9d, 0xdf, 0xfd, 0x10, 0xa9, 0x2c, 0xaf, 0x1f, 0x80, 0xd5, 0xcc, 0xab, 0x94, 0xd8, 0x66, 0xc2,
+  0x77, 0x7c, 0xbd, 0x41, 0xa9, 0x1c, 0x4c, 0x94, 0x16, 0x6b, 0xac, 0xf6, 0x4e, 0xe5, 0xb9, 0x6d,
+  0xb7, 0x72, 0x7d, 0xd1, 0xee, 0x62, 0xf7, 0x19, 0x88, 0x75, 0xa3, 0x51, 0xa0, 0xf2, 0xea, 0x64,
+  0xd9, 0x6c, 0xf5, 0x87, 0x93, 0x0e, 0xab, 0x59, 0x32, 0x7f, 0x1b, 0x7d, 0x66, 0xd1, 0x0e, 0xdb,
+  0xe4, 0x71, 0x7f, 0x2a, 0x16, 0x0a, 0x63, 0xcb, 0x95, 0x5a, 0x6b, 0x1b, 0xf9, 0x95, 0x8a, 0xbf,
+  0xbb, 0x83, 0x41, 0x6d, 0xf9, 0x78, 0xb6, 0xa6, 0x0f, 0xc5, 0xc5, 0xfa, 0x33, 0xda, 0x18, 0x26,
+  0x7f, 0xe3, 0x76, 0xa4, 0xff, 0xfe, 0xf3, 0x5c, 0x47, 0x73, 0x3d, 0x59, 0xff, 0x69, 0xa2, 0xf8,
+  0xfb, 0x2e, 0x46, 0x2b, 0x0b, 0x83, 0xda, 0x6a, 0xb1, 0xec, 0xb7, 0x33, 0x71, 0xf4, 0xc4, 0x6d,
+  0xfb, 0xf8, 0xaa, 0xb7, 0xef, 0xf5, 0x63, 0x8b, 0xc5, 0x3c, 0x15, 0x4f, 0xd5, 0x8a, 0x69, 0x87,
+  0xc0, 0xe1, 0xb1, 0xf3, 0xbe, 0x46, 0x46, 0x1d, 0x03, 0xd4, 0xcb, 0xa5, 0x7a, 0x1e, 0x84, 0xa6,
+  0x43, 0x35, 0xdf, 0x74, 0x7e, 0x99, 0x0b, 0xdf, 0x27, 0xa1, 0xc2, 0xfa, 0xf9, 0x32, 0x34, 0xc9,
+  0xe6, 0xa6, 0x71, 0xc7, 0xd9, 0x48, 0xfb, 0x1b, 0x5b, 0x25, 0xa2, 0xaf, 0x7d, 0xf3, 0xea, 0x26,
+  0x5a, 0x6f, 0xbe, 0xbe, 0x6d, 0x00, 0x9b, 0xf0, 0x69, 0xf7, 0x29, 0x1c, 0xef, 0x03, 0xca, 0xd0,
+  0x66, 0xe2, 0x3c, 0x8b, 0xbe, 0x57, 0x65, 0x39, 0xcf, 0xff, 0xe9, 0xd9, 0x7c, 0x7f, 0x23, 0x21,
+  0xca, 0xfd, 0xc1, 0x3d, 0xb3, 0x89, 0x25, 0x1b, 0x7b, 0x8a, 0xe3, 0xec, 0xb9, 0xbc, 0x98, 0x9c,
+  0x46, 0xd1, 0x96, 0x82, 0x75, 0xf1, 0x7c, 0x39, 0x04, 0x06, 0xdd, 0x93, 0xc4, 0x7e, 0xf9, 0xb3,
+  0x08, 0xe4, 0xc6, 0x63, 0x89, 0xda, 0x75, 0xa5, 0xf9, 0x19, 0xfd, 0x1e, 0x09, 0x62, 0xd7, 0x55,
+  0x7b, 0x92, 0x9c, 0x7d, 0x97, 0x47, 0xfc, 0x9c, 0xdd, 0xbb, 0xd6, 0xdd, 0xc7, 0xbf, 0xdf, 0xd4,
+  0xa1, 0xcb, 0x71, 0xfd, 0xcf, 0xa7, 0x33, 0x0d, 0xe2, 0x94, 0x69, 0xbc, 0xdc, 0xcc, 0x7f, 0x0b,
+  0x93, 0xf7, 0x83, 0x43, 0x6c, 0xd3, 0x1e, 0x5f, 0x0f, 0x63, 0x31, 0xaf, 0x52, 0x6e, 0x18, 0x19,
+  0x36, 0x96, 0x3f, 0xac, 0x87, 0xcd, 0xbb, 0x34, 0x8e, 0x9f, 0x52, 0x43, 0x94, 0xab, 0xcd, 0x6e,
+  0xf0, 0xcf, 0xa6, 0xdb, 0x69, 0xab, 0xf6, 0xd6, 0x2f, 0x55, 0x4c, 0x65, 0x9b, 0x63, 0x83, 0xe7,
+  0x5c, 0xa0, 0x99, 0x6a, 0x67, 0x92, 0x55, 0x3a, 0xcc, 0x79, 0xb7, 0x7b, 0xde, 0xa4, 0xfa, 0x73,
+  0x7a, 0xe0, 0xee, 0x6b, 0x98, 0xef, 0x85, 0x72, 0xa3, 0x61, 0x9a, 0x6a, 0x29, 0x15, 0xfb, 0x7f,
+  0x53, 0xfb, 0xa2, 0xc3, 0x59, 0xe9, 0x7e, 0x9f, 0x5f, 0xeb, 0x85, 0x2c, 0x96, 0x71, 0x3a, 0x77,
+  0x6d, 0x4c, 0x93, 0xe5, 0x93, 0xd9, 0xf1, 0x78, 0x1b, 0x69, 0x94, 0xa7, 0xd9, 0xef, 0xd6, 0x66,
+  0xea, 0xb9, 0xba, 0x47, 0xde, 0x49, 0x90, 0xa4, 0xce, 0x79, 0x33, 0x5b, 0xbe, 0x6f, 0xeb, 0xcf,
+  0xf9, 0x60, 0x6e, 0x30, 0xdd, 0xee, 0x83, 0x19, 0x3e, 0xac, 0xd0, 0xec, 0x9b, 0x1d, 0xf7, 0xb2,
+  0x31, 0x8d, 0xb5, 0xc4, 0xbf, 0x1d, 0x3b, 0x75, 0x2e, 0xe1, 0xa4, 0xa5, 0xdf, 0xeb, 0x58, 0x2b,
+  0x9c, 0x07, 0xf7, 0xfe, 0xda, 0x50, 0xf8, 0x5a, 0x0d, 0xac, 0x3b, 0xa5, 0x1d, 0xa9, 0x62, 0x23,
+  0xb2, 0xb9, 0x36, 0x3b, 0x97, 0x57, 0xfd, 0xeb, 0x62, 0x57, 0x8a, 0x64, 0xbf, 0x6f, 0x07, 0x95,
+  0x56, 0x71, 0x72, 0xee, 0x6e, 0x9b, 0x21, 0x97, 0xeb, 0x54, 0x68, 0xd4, 0x8d, 0x06, 0x4a, 0x23,
+  0xeb, 0x89, 0xef, 0xb5, 0xfa, 0x2c, 0xc5, 0x93, 0xeb, 0x4d, 0xbf, 0xd3, 0x62, 0x32, 0x0d, 0x56,
+  0x07, 0x29, 0xcc, 0xaf, 0x5d, 0x2b, 0xdf, 0x5f, 0xd5, 0x7a, 0xd3, 0x2e, 0xcb, 0x6a, 0x72, 0xd1,
+  0xfd, 0x4d, 0x8f, 0x45, 0x9e, 0xc4, 0x45, 0xb9, 0x91, 0xac, 0x2c, 0xc7, 0x5f, 0xba, 0x99, 0x61,
+  0xad, 0x9e, 0xff, 0x17, 0x16, 0xb9, 0x08, 0xeb, 0x45, 0xfe, 0x5b, 0xca, 0x4e, 0xc6, 0xcf, 0x8e,
+  0x8a, 0xe2, 0xe5, 0x9c, 0x3c, 0x3e, 0xf2, 0x7b, 0xc2, 0xaa, 0x73, 0xef, 0xb9, 0xfd, 0x24, 0xb2,
+  0x85, 0x89, 0xe7, 0xc3, 0xb3, 0xf8, 0x6c, 0xb5, 0x0e, 0x37, 0xf0, 0xb0, 0x42, 0xec, 0x78, 0xe8,
+  0xef, 0x87, 0xf7, 0x46, 0xf7, 0x69, 0x73, 0xd6, 0x78, 0x66, 0x4b, 0x67, 0xe2, 0xf4, 0xe8, 0xf2,
+  0x1c, 0x0c, 0x15, 0x2a, 0x59, 0x0e, 0xd0, 0x78, 0x72, 0x58, 0xdb, 0x27, 0x5a, 0x4d, 0x46, 0xaa,
+  0x5b, 0x31, 0x55, 0xeb, 0x46, 0x1b, 0x1b, 0x61, 0xc8, 0x7c, 0xb5, 0x3b, 0x3a, 0x3d, 0x16, 0x4f,
+  0x7c, 0x89, 0x66, 0xbb, 0x33, 0x18, 0xd7, 0xc3, 0xf3, 0xb8, 0xf6, 0x78, 0xe2, 0x19, 0x9f, 0x27,
+  0xee, 0x63, 0x48, 0xf4, 0x4c, 0x77, 0x7e, 0xfe, 0x95, 0x9e, 0xc5, 0x5d, 0x8c, 0xe9, 0x2f, 0x54,
+  0xed, 0xe7, 0xae, 0xbf, 0xf5, 0xd0, 0xc4, 0x62, 0x12, 0xfa, 0x06, 0x76, 0x69, 0x9b, 0x8a, 0x5a,
+  0x23, 0x3f, 0x8f, 0xee, 0x3b, 0x27, 0x4d, 0xbb, 0xe5, 0x20, 0x39, 0x09, 0x97, 0x4f, 0xe1, 0xde,
+  0x81, 0x73, 0xfb, 0xbb, 0x4b, 0x1f, 0x27, 0x91, 0x21, 0xe3, 0xca, 0x68, 0x1e, 0x2b, 0xb5, 0xaa,
+  0x3f, 0x86, 0x98, 0xfc, 0xf8, 0x9c, 0x8c, 0x45, 0xfb, 0x71, 0xa7, 0x9b, 0x74, 0x27, 0xde, 0x1d,
+  0xae, 0x93, 0xcd, 0xe3, 0xb9, 0xd6, 0xe3, 0x70, 0x3e, 0x16, 0xce, 0xa1, 0x30, 0x95, 0x74, 0xb5,
+  0x51, 0x0c, 0xd5, 0xe3, 0xe5, 0x7e, 0xb7, 0x70, 0xe5, 0x3d, 0x69, 0x0e, 0x2b, 0xdb, 0x4b, 0xb0,
+  0xe6, 0x39, 0x10, 0x0f, 0xf5, 0xd7, 0xb5, 0x83, 0xf5, 0x5a, 0x2a, 0xfc, 0xd9, 0xd4, 0xc6, 0xcb,
+  0x8e, 0xb3, 0x4d, 0xa7, 0x39, 0xaa, 0xfc, 0xc7, 0x11, 0x18, 0xdd, 0xf7, 0x7c, 0xf0, 0x9c, 0x64,
+  0x97, 0xcd, 0x2c, 0xe1, 0xf8, 0x7b, 0x71, 0x8f, 0xe4, 0x27, 0x21, 0x69, 0xd9, 0xf7, 0x74, 0xf3,
+  0xe8, 0x8e, 0x56, 0x8d, 0xda, 0x97, 0x60, 0x37, 0xb4, 0xee, 0x04, 0x2a, 0x87, 0x81, 0xc2, 0xea,
+  0xee, 0x95, 0x8b, 0x04, 0x36, 0xe1, 0xd8, 0xd5, 0xe8, 0x77, 0xd6, 0x4e, 0xdd, 0x9e, 0x25, 0xf9,
+  0xae, 0xe3, 0xee, 0x9c, 0xf9, 0x2e, 0xf2, 0xc5, 0x23, 0xd4, 0xdc, 0xab, 0x39, 0x09, 0xef, 0x43,
+  0xaf, 0x1e, 0x89, 0x4a, 0x6f, 0xda, 0x89, 0x25, 0x4b, 0xf5, 0x13, 0x90, 0xd5, 0x68, 0x7d, 0x3f,
+  0xc7, 0xae, 0x15, 0x22, 0x86, 0xe8, 0xe8, 0x36, 0x9d, 0xae, 0xa7, 0x81, 0x55, 0xb4, 0x6a, 0x6f,
+  0xfb, 0xdf, 0x65, 0xba, 0xaf, 0xbf, 0x81, 0x68, 0xb8, 0x50, 0x6a, 0xcd, 0xf2, 0xd5, 0x73, 0xfa,
+  0x47, 0x26, 0x37, 0xbf, 0xa6, 0x67, 0x67, 0xe7, 0xe7, 0xef, 0xe1, 0xd8, 0x4f, 0x6f, 0x72, 0xcf,
+  0x79, 0xdf, 0xf1, 0xfa, 0x39, 0xdd, 0x2e, 0x9e, 0x1b, 0x0a, 0x92, 0x45, 0x32, 0xdc, 0xfe, 0x0d,
+  0xaa, 0x0b, 0x0f, 0xb7, 0xdc, 0x33, 0x51, 0xef, 0xd7, 0x8e, 0x8d, 0x86, 0xc7, 0x73, 0xae, 0x5a,
+  0xad, 0xef, 0x37, 0xef, 0xf4, 0xa0, 0xf8, 0x3c, 0x5f, 0x5d, 0xf5, 0xef, 0x89, 0x8f, 0xfb, 0xf5,
+  0xaf, 0xdc, 0xb8, 0x7d, 0x96, 0x97, 0x50, 0xeb, 0x49, 0xec, 0x91, 0x6a, 0x1f, 0x87, 0xa3, 0x2e,
+  0xed, 0xcd, 0x2b, 0xbf, 0xb8, 0xf6, 0xda, 0xff, 0x96, 0xdf, 0xe5, 0xac, 0x9e, 0x99, 0x37, 0x8e,
+  0xbd, 0x5b, 0xaf, 0x59, 0xbd, 0x73, 0x8a, 0xd7, 0x8f, 0x79, 0x21, 0x82, 0x5a, 0xe8, 0x95, 0x0f,
+  0xdd, 0xf2, 0x59, 0x2b, 0x9d, 0xc5, 0x65, 0xfe, 0x6a, 0xdf, 0x57, 0xc3, 0xf4, 0xf1, 0x6f, 0x37,
+  0xb4, 0x1b, 0x7f, 0x2a, 0xdd, 0x50, 0xee, 0x6d, 0x7d, 0x9e, 0xb9, 0xaf, 0x53, 0x69, 0x9f, 0xe6,
+  0xd3, 0xa3, 0xb5, 0x8b, 0x07, 0xba, 0x31, 0xe3, 0x85, 0xe0, 0xb8, 0x96, 0xba, 0xbe, 0x46, 0xcd,
+  0x24, 0xcb, 0xe0, 0x64, 0x9e, 0xcc, 0x74, 0x6f, 0x1f, 0xce, 0x9b, 0x74, 0x23, 0xf9, 0x0d, 0x67,
+  0x62, 0x17, 0xdd, 0xe4, 0xc2, 0x2a, 0x7c, 0xaa, 0x0c, 0xe6, 0xb3, 0xb4, 0xc3, 0x62, 0xad, 0x7c,
+  0x09, 0x46, 0x2b, 0xaf, 0xc3, 0xfb, 0xff, 0x23, 0x9d, 0x88, 0x46, 0x07, 0x2b, 0x30, 0xad, 0xec,
+  0xac, 0xd7, 0x9f, 0xc6, 0x82, 0xa1, 0xf8, 0xdf, 0xce, 0xfd, 0x5f, 0xfd, 0x4f, 0x53, 0xfb, 0xd3,
+  0xfe, 0xca, 0x64, 0x9a, 0xf9, 0x36, 0x03, 0xbd, 0xd1, 0x95, 0xde, 0x22, 0xde, 0xdf, 0xac, 0x82,
+  0xc9, 0x7f, 0x8d, 0x5f, 0x7e, 0x96, 0x4c, 0x8d, 0x87, 0xeb, 0xd2, 0x99, 0x5f, 0x39, 0x14, 0xad,
+  0x54, 0xd6, 0xaf, 0x5a, 0xae, 0xc7, 0xa6, 0xd4, 0xec, 0x45, 0x77, 0x75, 0x19, 0xba, 0x56, 0x7f,
+  0xd7, 0xac, 0xcc, 0xa7, 0xb3, 0xfd, 0x96, 0xdd, 0xfe, 0xf9, 0x8e, 0x3f, 0x2a, 0xc1, 0x6d, 0xda,
+  0xe4, 0x23, 0x1c, 0x28, 0x96, 0xaf, 0x7d, 0x71, 0xc7, 0xca, 0xff, 0x5b, 0xbe, 0x96, 0x46, 0x83,
+  0x5a, 0x92, 0x55, 0xbb, 0x5b, 0xbd, 0xf6, 0x42, 0xbd, 0xa0, 0x9d, 0xef, 0xf8, 0xfb, 0x7e, 0x6d,
+  0xb2, 0x13, 0x34, 0x91, 0x5d, 0x26, 0xb5, 0xcf, 0x97, 0xa6, 0x99, 0x33, 0x84, 0x7a, 0x39, 0x59,
+  0x5f, 0x7d, 0x43, 0xeb, 0x59, 0xff, 0x46, 0x67, 0x1e, 0x48, 0x57, 0x56, 0x61, 0x1b, 0x98, 0xe4,
+  0x3b, 0xff, 0xea, 0xad, 0xd6, 0x2b, 0x41, 0x98, 0x46, 0x6b, 0xfb, 0xff, 0x5c, 0xcb, 0x7d, 0xad,
+  0xaf, 0x6d, 0xff, 0x78, 0xd9, 0x5c, 0x36, 0x99, 0xff, 0x95, 0x4a, 0xf5, 0x7f, 0x3c, 0x45, 0xaf,
+  0x9f, 0x66, 0xe4, 0xd8, 0x74, 0x3f, 0xff, 0x8f, 0x2f, 0xa7, 0xbd, 0x8d, 0x7b, 0xa6, 0x92, 0x09,
+  0x7c, 0xa2, 0x33, 0x29, 0xca, 0xfe, 0xe4, 0x3a, 0x0f, 0x26, 0x47, 0x8b, 0x8a, 0x8b, 0xd0, 0x6f,
+  0xd1, 0xbc, 0x04, 0xde, 0x85, 0x8d, 0xe5, 0xd9, 0x6d, 0xfc, 0x9f, 0x27, 0x46, 0x33, 0xe7, 0x92,
+  0x7a, 0xe6, 0x9b, 0x3d, 0x67, 0x62, 0x8b, 0x36, 0x94, 0x70, 0xf0, 0x38, 0x4f, 0x5f, 0x82, 0xa5,
+  0x5a, 0xeb, 0x75, 0xa0, 0xf6, 0xaf, 0xcf, 0x87, 0xdb, 0xe0, 0xc3, 0xfd, 0x32, 0x91, 0x9f, 0x2d,
+  0x1f, 0x7f, 0x31, 0x84, 0xd2, 0x3c, 0xfd, 0x89, 0xfd, 0xdf, 0xe5, 0x17, 0xbd, 0x5a, 0x6f, 0x7e,
+  0xe8, 0x46, 0xcf, 0x4d, 0x85, 0xbf, 0x47, 0xf5, 0xb0, 0x3c, 0xa4, 0xb7, 0xc1, 0xa5, 0xe9, 0x71,
+  0xe4, 0x19, 0xa8, 0x8d, 0x92, 0xcd, 0x72, 0xdc, 0xca, 0x3d, 0xb2, 0x59, 0x27, 0x63, 0x99, 0xa9,
+  0xc7, 0x67, 0xfd, 0x15, 0xae, 0x9e, 0xcf, 0x93, 0x05, 0xa8, 0xea, 0x79, 0x10, 0x7d, 0xa5, 0x32,
+  0xeb, 0x1c, 0xda, 0x59, 0x2b, 0x71, 0xc8, 0x8f, 0xe3, 0x73, 0xdd, 0xdc, 0x5f, 0xea, 0xf2, 0xda,
+  0x2c, 0x6a, 0xd3, 0xf4, 0xa6, 0xfb, 0x7f, 0xf4, 0xda, 0x5c, 0xe3, 0xd1, 0x44, 0xbf, 0x71, 0xe9,
+  0x1d, 0x5a, 0x55, 0x0e, 0x01, 0x76, 0xe1, 0xdf, 0xbf, 0x99, 0x5e, 0x1f, 0x9e, 0x37, 0x34, 0xe1,
+  0xf6, 0xa8, 0x9b, 0x8c, 0xbc, 0x5f, 0x9b, 0xe6, 0x93, 0xc0, 0xae, 0xf8, 0xaf, 0xc7, 0x26, 0x43,
+  0x4a, 0xc4, 0xc2, 0xe2, 0x97, 0xad, 0xa6, 0x6e, 0x93, 0xa8, 0xf3, 0xc8, 0xae, 0x57, 0xea, 0x6c,
+  0x77, 0xfb, 0xb4, 0x96, 0xe0, 0x3b, 0xf7, 0x4f, 0xc4, 0x92, 0x63, 0xf0, 0xc9, 0x6c, 0xa4, 0xd5,
+  0x1c, 0x17, 0xcb, 0xbf, 0x28, 0xae, 0x43, 0xa9, 0x3c, 0x5d, 0xad, 0x4f, 0x97, 0x58, 0xf7, 0x7c,
+  0xfb, 0xb4, 0x9c, 0xb5, 0x9e, 0xe7, 0x44, 0x9e, 0xe0, 0xff, 0xd9, 0x8b, 0xee, 0x27, 0x59, 0xd9,
+  0xa3, 0x5c, 0xe5, 0xb3, 0xff, 0x15, 0x52, 0xbf, 0x24, 0xa1, 0x73, 0x29, 0x31, 0xad, 0x07, 0x86,
+  0x27, 0xe2, 0xde, 0x4b, 0x77, 0xf6, 0x6a, 0x94, 0xcb, 0x31, 0xfd, 0xa3, 0xc4, 0x34, 0x78, 0x0e,
+  0xb6, 0x33, 0x03, 0x27, 0xd8, 0x58, 0x70, 0xf8, 0x3c, 0x9f, 0xe3, 0xe9, 0x71, 0xb8, 0x74, 0xf7,
+  0x19, 0xaf, 0xae, 0xe6, 0x29, 0xdc, 0xce, 0x5f, 0xf8, 0x9d, 0x8d, 0x3e, 0xf7, 0xe5, 0xb9, 0xcf,
+  0xf2, 0xe5, 0xb0, 0x18, 0xcd, 0xee, 0x19, 0x5a, 0x93, 0x47, 0x20, 0xfd, 0x09, 0x64, 0xee, 0x0d,
+  0x7a, 0xea, 0xeb, 0xf3, 0xbb, 0x6d, 0xbf, 0x83, 0xbf, 0x48, 0x97, 0xd4, 0x7b, 0x7a, 0xf8, 0xdf,
+  0x5f, 0x1b, 0x3f, 0x90, 0x66, 0xba, 0xfe, 0xc8, 0x3e, 0x7a, 0x9f, 0x9a, 0xf8, 0xea, 0x79, 0x71,
+  0xcf, 0xd4, 0xe7, 0x17, 0x69, 0xe8, 0xf3, 0xa0, 0xf0, 0xcc, 0x9d, 0xbe, 0xef, 0x1b, 0xa8, 0x53,
+  0x6e, 0x5a, 0x0a, 0x0d, 0xa3, 0x5d, 0x65, 0x8e, 0xfc, 0xf7, 0x3b, 0x6f, 0x06, 0x57, 0xe9, 0xe4,
+  0xb7, 0x76, 0x69, 0x38, 0x18, 0x6c, 0xff, 0x5d, 0x91, 0xd4, 0xd4, 0x79, 0x54, 0x1d, 0xa7, 0x67,
+  0x7b, 0x7d, 0x9f, 0x53, 0xfc, 0x58, 0x7a, 0xee, 0xae, 0xf5, 0xc8, 0xdc, 0x4f, 0x68, 0x56, 0xab,
+  0xac, 0x72, 0xd9, 0x5f, 0xc6, 0xca, 0x22, 0x73, 0x5f, 0x3d, 0xb3, 0xe9, 0x7f, 0xca, 0xe4, 0xf8,
+  0xdf, 0xba, 0xfe, 0xfb, 0x3b, 0x7a, 0xe7, 0xd3, 0xb4, 0x16, 0x1e, 0x24, 0xd3, 0x3f, 0xa5, 0x9c,
+  0x76, 0xa0, 0x33, 0x9f, 0x7e, 0xfe, 0x5f, 0x01, 0xb9, 0x62, 0xaa, 0xfe, 0x5d, 0x95, 0xda, 0xbd,
+  0x90, 0xe7, 0x64, 0xf9, 0xba, 0x6c, 0xd4, 0x5f, 0xcf, 0x1e, 0xac, 0x6c, 0x76, 0xd4, 0xd9, 0x6c,
+  0xae, 0x27, 0xec, 0x93, 0x74, 0xe3, 0x37, 0x3d, 0x16, 0x7b, 0x19, 0x76, 0x85, 0x5f, 0xec, 0x53,
+  0x4d, 0x95, 0x13, 0x5f, 0xda, 0xf1, 0x4a, 0xf3, 0x13, 0xcb, 0xe5, 0xd6, 0x9f, 0x90, 0xde, 0xcd,
+  0xe4, 0x34, 0x08, 0x25, 0xdb, 0x0d, 0x82, 0x93, 0x47, 0x60, 0x96, 0x68, 0x04, 0xc7, 0x2d, 0x05,
+  0xba, 0xe1, 0x60, 0x12, 0x5b, 0xbd, 0x23, 0xd5, 0xbb, 0xe8, 0x7e, 0xf3, 0x5c, 0x18, 0xde, 0xda,
+  0x51, 0xc5, 0x95, 0x4c, 0x7b, 0x56, 0x69, 0x34, 0xd2, 0xef, 0x0f, 0xb4, 0xeb, 0x7f, 0xd9, 0xfa,
+  0x9c, 0x23, 0x2b, 0x82, 0x8b, 0x64, 0xa0, 0xd2, 0xdb, 0x7e, 0x8f, 0x19, 0x92, 0x93, 0x4b, 0x78,
+  0x3d, 0xf8, 0x7f, 0xfa, 0xef, 0xc5, 0xc9, 0x4f, 0xea, 0xff, 0x8a, 0x6e, 0xa3, 0xdb, 0x24, 0xd9,
+  0x41, 0x6a, 0x55, 0xf8, 0x4c, 0xc6, 0xbd, 0xc1, 0xb8, 0x4c, 0x70, 0xdf, 0x99, 0x4e, 0x4a, 0x7b,
+  0x08, 0xcb, 0xd0, 0xbc, 0x92, 0xd8, 0x97, 0x97, 0xb3, 0xa7, 0x88, 0x40, 0x71, 0x95, 0xa9, 0x1d,
+  0xf7, 0x15, 0xc4, 0xca, 0x4e, 0xb5, 0x57, 0x8a, 0xf4, 0xa7, 0xd1, 0x1c, 0xfc, 0x5a, 0x2c, 0xfa,
+  0x0b, 0x1d, 0x56, 0xdd, 0x28, 0xcf, 0x5d, 0x3f, 0x7e, 0x4b, 0xe4, 0x42, 0x05, 0xbb, 0xe6, 0xc5,
+  0x24, 0x1d, 0xfc, 0xf5, 0xe6, 0x47, 0xa7, 0xaa, 0xe1, 0xa5, 0x3e, 0x48, 0x1c, 0xfe, 0xa5, 0x7d,
+  0xab, 0xfd, 0xaf, 0x1a, 0xaa, 0xce, 0x33, 0xef, 0xb2, 0xbd, 0xef, 0xb9, 0xb8, 0x5a, 0xcf, 0xf6,
+  0x13, 0xd0, 0xdb, 0x50, 0x21, 0x53, 0xfa, 0xb5, 0xc7, 0x6f, 0x60, 0xf3, 0x6b, 0xfd, 0x3f, 0x3b,
+  0x6e, 0x6e, 0x1d, 0xeb, 0xca, 0xd2, 0xb7, 0xf1, 0x1d, 0x9c, 0x7a, 0xd5, 0x01, 0xd3, 0x40, 0x3d,
+  0xb5, 0x3c, 0xcd, 0xba, 0xa7, 0x10, 0x81, 0x77, 0xa2, 0xf6, 0x8a, 0xcc, 0x3b, 0x0b, 0x9b, 0xc0,
+  0x51, 0xa5, 0x95, 0x1c, 0x1e, 0x8b, 0xf1, 0x94, 0xa5, 0x46, 0x76, 0xf8, 0x8c, 0xcf, 0x6f, 0x29,
+  0xde, 0x97, 0xee, 0x2b, 0xbb, 0x9b, 0x07, 0x66, 0x91, 0x31, 0xe4, 0xd7, 0xa2, 0xb2, 0x4f, 0x74,
+  0xda, 0xfb, 0x2f, 0xe7, 0x60, 0x60, 0x13, 0xd9, 0xe6, 0x73, 0x23, 0xb9, 0xd4, 0x7d, 0xa3, 0x15,
+  0xf8, 0x3f, 0xf6, 0x81, 0xcb, 0xbb, 0xdc, 0x69, 0x5a, 0x8c, 0xa7, 0xbf, 0x13, 0xda, 0xab, 0x67,
+  0x72, 0xd7, 0x1a, 0x2c, 0x16, 0x5b, 0xd6, 0xe5, 0x63, 0x2e, 0x38, 0x9a, 0x66, 0xc7, 0xa1, 0x3c,
+  0xf8, 0x5c, 0x78, 0xdc, 0x0f, 0xec, 0x92, 0x4d, 0xa8, 0x88, 0xfd, 0x36, 0x76, 0xc9, 0x1f, 0x76,
+  0xb9, 0x0e, 0xda, 0xc3, 0xf8, 0x74, 0x0e, 0x66, 0xe6, 0x2d, 0x8c, 0x98, 0x6c, 0xac, 0x95, 0xba,
+  0x24, 0xce, 0x99, 0x7d, 0xc4, 0xcc, 0x75, 0xd0, 0x4d, 0x8f, 0x92, 0x9f, 0x96, 0x91, 0x60, 0x7b,
+  0x3b, 0x6e, 0xe6, 0xce, 0x09, 0x5b, 0xf7, 0x68, 0xf3, 0x18, 0x7d, 0x7e, 0xe2, 0x41, 0x8d, 0x8a,
+  0xf4, 0x79, 0x95, 0xde, 0x06, 0x62, 0x1b, 0xf1, 0xd9, 0xf8, 0xe9, 0x5c, 0xd8, 0xaf, 0x6e, 0x0f,
+  0xc6, 0x98, 0x47, 0xb1, 0xbb, 0x0a, 0xcd, 0xbe, 0xb1, 0xa1, 0xa4, 0xfb, 0xa8, 0x50, 0x0a, 0x45,
+  0x4a, 0x15, 0x30, 0x97, 0xf3, 0xfc, 0x7b, 0xea, 0xee, 0x9f, 0x59, 0x80, 0xf2, 0xc4, 0xa9, 0xb2,
+  0x99, 0xed, 0x0a, 0xd1, 0x58, 0xea, 0x7a, 0x69, 0x90, 0x9b, 0x44, 0x43, 0x93, 0x79, 0xd4, 0xca,
+  0xe8, 0x55, 0x69, 0x3c, 0x57, 0x11, 0x48, 0xba, 0xde, 0xba, 0x75, 0x59, 0xaf, 0xde, 0xbd, 0x7e,
+  0xec, 0xde, 0x36, 0xd4, 0x6d, 0x7f, 0xbf, 0x15, 0xc0, 0xe4, 0x7d, 0x61, 0x79, 0x7e, 0x7e, 0x66,
+  0x97, 0x4e, 0xd9, 0xcb, 0x71, 0xf1, 0x5b, 0x5e, 0x2f, 0xc5, 0x6d, 0x93, 0x4e, 0xf6, 0xb9, 0xcf,
+  0x95, 0xde, 0x5b, 0xe4, 0xfa, 0x75, 0xa1, 0xb9, 0x7d, 0xf5, 0xab, 0x65, 0x45, 0xdb, 0x7f, 0xac,
+  0x1e, 0x7b, 0xf7, 0x9b, 0x29, 0xbf, 0x9d, 0xc6, 0x74, 0x79, 0x2f, 0x37, 0x33, 0x55, 0x87, 0xe5,
+  0xea, 0xb9, 0x5e, 0x2f, 0xed, 0x87, 0xc5, 0xbf, 0xc8, 0xf1, 0xbd, 0x76, 0x1c, 0x4f, 0xaf, 0x2f,
+  0x4a, 0x84, 0x7e, 0x31, 0x72, 0x8a, 0x94, 0x82, 0x17, 0x6f, 0xa4, 0x41, 0x60, 0x75, 0xf8, 0x0e,
+  0x0b, 0x27, 0x0a, 0x8d, 0xd9, 0xbe, 0x98, 0x0a, 0xbf, 0x1e, 0x5b, 0x67, 0xa0, 0x5b, 0x38, 0x7c,
+  0xc8, 0xc6, 0x1a, 0x55, 0x6d, 0x8e, 0xd3, 0x37, 0x72, 0x48, 0x36, 0x7b, 0xa9, 0x27, 0x85, 0x59,
+  0xf4, 0x30, 0x5d, 0x6d, 0x5b, 0x3d, 0xe9, 0xab, 0x58, 0x6c, 0xd6, 0x2c, 0x6c, 0xf2, 0x5d, 0xd2,
+  0xf6, 0xd5, 0xa3, 0xd9, 0xac, 0x7f, 0xe2, 0x55, 0x8f, 0x86, 0xfb, 0xb5, 0x94, 0x9c, 0x76, 0xcf,
+  0x99, 0x85, 0xd6, 0x43, 0xac, 0xd7, 0xee, 0x6f, 0x96, 0x7f, 0x62, 0xde, 0xce, 0xf9, 0xf2, 0x1e,
+  0xb7, 0x1a, 0x59, 0x2f, 0xaf, 0x54, 0xfe, 0x75, 0xad, 0xb7, 0x6a, 0x07, 0xf4, 0xab, 0xc0, 0x39,
+  0x53, 0x39, 0x5f, 0xe3, 0xf1, 0x25, 0x9e, 0xc5, 0x26, 0xdf, 0xf8, 0xbd, 0xbb, 0xe1, 0xa6, 0x8f,
+  0xe5, 0xb4, 0x33, 0xd8, 0x55, 0x16, 0xf1, 0x55, 0x92, 0x4d, 0x6d, 0xd6, 0x3f, 0xe6, 0x1f, 0x8f,
+  0xb0, 0xd4, 0x40, 0x7b, 0xd4, 0x1c, 0xb6, 0x4a, 0x9f, 0x89, 0x9a, 0xf4, 0xed, 0x59, 0xcd, 0x3e,
+  0xd2, 0xa5, 0x27, 0xdf, 0xd8, 0x79, 0x9d, 0xce, 0x75, 0xf3, 0x53, 0x10, 0x89, 0x54, 0x33, 0x79,
+  0x4a, 0xcf, 0x56, 0x45, 0xf1, 0xc1, 0x5c, 0x6f, 0xd8, 0x1e, 0xfc, 0xba, 0x41, 0x43, 0xb6, 0x66,
+  0xf0, 0x12, 0x5f, 0x6d, 0x4b, 0xfb, 0x6d, 0xf5, 0x6d, 0xf5, 0x52, 0x4e, 0x2e, 0x03, 0xc3, 0xf6,
+  0xd1, 0xc5, 0xec, 0xbe, 0x49, 0x9f, 0x6f, 0x7f, 0x0a, 0xea, 0xc7, 0xe3, 0x91, 0xbd, 0x07, 0x46,
+  0x4d, 0x9c, 0xa7, 0xf7, 0xe8, 0x7a, 0xdf, 0x14, 0x8f, 0xc3, 0x47, 0xe0, 0x6a, 0xfe, 0xf8, 0x7c,
+  0x3c, 0x26, 0x97, 0x93, 0xa4, 0xc7, 0x3e, 0x36, 0x0f, 0xf6, 0x4e, 0x3d, 0xca, 0xef, 0xfc, 0xa8,
+  0x96, 0x59, 0xa7, 0x86, 0xb5, 0x07, 0x9e, 0xd5, 0xf1, 0x10, 0xaf, 0x3f, 0x32, 0xbd, 0xb2, 0xa2,
+  0xdc, 0xa3, 0xd6, 0x68, 0x96, 0x66, 0x8b, 0x6b, 0x83, 0x57, 0xfd, 0x9f, 0xbe, 0x76, 0x13, 0xf7,
+  0xd9, 0xdf, 0xcf, 0x30, 0xf1, 0xaf, 0x35, 0x6b, 0x43, 0xd2, 0x9e, 0xcc, 0x2c, 0x30, 0xea, 0x97,
+  0xf3, 0x55, 0xaa, 0xb0, 0x44, 0xf6, 0xbb, 0xee, 0x1d, 0xea, 0xbd, 0x9b, 0xa1, 0xe1, 0x7c, 0x9b,
+  0xef, 0x9e, 0x97, 0x67, 0x53, 0xc7, 0xea, 0x60, 0xbe, 0x18, 0x4d, 0x93, 0xcf, 0x05, 0xe4, 0x52,
+  0x2e, 0x38, 0x6d, 0x26, 0x4a, 0x6b, 0x4e, 0xbd, 0xf7, 0xa0, 0x12, 0x3b, 0x06, 0x33, 0xc3, 0xe1,
+  0x99, 0x7a, 0xb8, 0x31, 0x19, 0x4d, 0x7e, 0x83, 0xbe, 0xa5, 0x71, 0xa4, 0x30, 0xdc, 0xee, 0x36,
+  0x11, 0xa0, 0xb7, 0xcc, 0xad, 0x3d, 0x0e, 0xa4, 0xeb, 0xb9, 0xd3, 0xba, 0xcf, 0xa3, 0x5d, 0x0d,
+  0x57, 0x42, 0x45, 0x41, 0xbc, 0x4c, 0x7d, 0x58, 0x5a, 0x14, 0x03, 0x81, 0x91, 0xf8, 0xce, 0xe3,
+  0x9a, 0xef, 0xf4, 0xee, 0x25, 0x79, 0xf9, 0x4b, 0xe2, 0x77, 0xdf, 0x56, 0x23, 0x39, 0x3d, 0xbd,
+  0xe4, 0x25, 0xbd, 0x8b, 0xfd, 0x83, 0xfd, 0xc0, 0xe5, 0xe9, 0xfa, 0xdc, 0x4e, 0x4d, 0x32, 0x0d,
+  0x2d, 0x8b, 0xc0, 0xf0, 0x33, 0xcd, 0x17, 0xe6, 0xc9, 0xa3, 0xf8, 0x69, 0x76, 0xd5, 0xae, 0x34,
+  0x76, 0x45, 0xd7, 0xf6, 0x4f, 0xb2, 0xd5, 0x89, 0x9c, 0x62, 0xb7, 0x79, 0xcd, 0xd3, 0x7b, 0x9b,
+  0x4b, 0x3c, 0xe6, 0x2f, 0x34, 0xfc, 0x64, 0xf5, 0x16, 0x59, 0x5f, 0x0b, 0x33, 0xc8, 0xda, 0xc9,
+  0xe3, 0xb4, 0x3a, 0x8c, 0xb7, 0x49, 0xf7, 0xb7, 0x7a, 0xa1, 0xf4, 0x48, 0xd4, 0xaf, 0xcb, 0x7e,
+  0xa5, 0xca, 0xb7, 0xf7, 0x7d, 0x4c, 0x3f, 0x61, 0x1f, 0xc2, 0xd0, 0x26, 0x91, 0x7c, 0x0c, 0xfb,
+  0xb3, 0x45, 0x92, 0x4d, 0x25, 0x1a, 0xae, 0xc4, 0x33, 0x3f, 0x4f, 0xe9, 0x7d, 0x38, 0x5b, 0x49,
+  0xdf, 0x7a, 0x77, 0x59, 0xa2, 0xea, 0x72, 0x77, 0xce, 0xde, 0x1f, 0x7f, 0xfd, 0xef, 0xc6, 0x35,
+  0xf0, 0xfc, 0x1e, 0x67, 0xe3, 0xa6, 0x9b, 0xea, 0x78, 0x19, 0xe9, 0x4c, 0x3a, 0x77, 0x08, 0xd0,
+  0x55, 0xef, 0xd0, 0xbe, 0xfe, 0x62, 0xc3, 0x80, 0xb2, 0xca, 0x2a, 0xf3, 0xab, 0xcd, 0xd2, 0x6f,
+  0x3b, 0xe8, 0xe1, 0x6b, 0x96, 0x58, 0x64, 0x4e, 0x6f, 0xa8, 0xf9, 0x5b, 0x63, 0xbb, 0x9c, 0x74,
+  0x8e, 0x7f, 0xd7, 0xa3, 0x5e, 0xf2, 0x1f, 0x1e, 0xb7, 0x87, 0x5f, 0xb4, 0x96, 0x48, 0xf0, 0x1c,
+  0x0b, 0x25, 0x53, 0x6b, 0x4c, 0xa7, 0x56, 0x3e, 0xf6, 0xdd, 0x34, 0x9b, 0x45, 0xa8, 0xff, 0x5d,
+  0xf5, 0x93, 0x08, 0x27, 0x07, 0x5b, 0xd1, 0xb8, 0xfd, 0x71, 0xb6, 0xd9, 0xed, 0xc3, 0x75, 0x3b,
+  0xf2, 0xce, 0xb4, 0x72, 0xd8, 0x87, 0x6b, 0x97, 0xa1, 0xdf, 0xfa, 0xe3, 0x94, 0xf8, 0x2c, 0x5a,
+  0xa1, 0x93, 0xac, 0xde, 0xbc, 0x57, 0xec, 0x9c, 0x27, 0x8f, 0x57, 0x98, 0x58, 0xf1, 0xd3, 0x9f,
+  0x0f, 0x7a, 0x69, 0x34, 0xbd, 0x63, 0x20, 0x96, 0x1a, 0x65, 0x96, 0xe9, 0x25, 0xf7, 0x50, 0x6d,
+  0xd0, 0xeb, 0x8e, 0x16, 0x19, 0x9f, 0x9e, 0xf5, 0x60, 0x9e, 0x29, 0xee, 0xe7, 0xa3, 0x5c, 0x86,
+  0x40, 0x2a, 0x78, 0xc8, 0xf7, 0x2e, 0x71, 0x05, 0xb5, 0xf5, 0xbc, 0xf8, 0x5b, 0xcd, 0xab, 0x23,
+  0x38, 0xd8, 0x6e, 0x3b, 0x33, 0x6a, 0xc5, 0x0e, 0xc5, 0x7f, 0xbb, 0x55, 0x20, 0xdc, 0x78, 0x66,
+  0x26, 0x0d, 0xb8, 0x83, 0xff, 0x30, 0xb3, 0x28, 0x06, 0x23, 0xfd, 0x11, 0xa7, 0xdf, 0x37, 0xf0,
+  0xbf, 0x74, 0xd7, 0x8f, 0xce, 0xfd, 0xef, 0xf8, 0xd3, 0xf9, 0xa7, 0x4f, 0x91, 0xee, 0xb8, 0x67,
+  0xfb, 0x3d, 0x1e, 0x6c, 0xaf, 0x7f, 0x04, 0x96, 0xec, 0x6f, 0x76, 0x8b, 0x4d, 0x7e, 0x61, 0xee,
+  0xb0, 0x6e, 0xe3, 0x1b, 0x6f, 0xfe, 0x0a, 0xe1, 0x1f, 0xc1, 0xed, 0x2f, 0x72, 0xfc, 0x7e, 0x87,
+  0x59, 0x0d, 0xe4, 0x73, 0x7c, 0x73, 0xbc, 0xec, 0x66, 0x73, 0x25, 0x83, 0xc3, 0x67, 0x5a, 0x4d,
+  0x15, 0xfa, 0x5d, 0xa2, 0xca, 0x5f, 0xe2, 0x53, 0xcf, 0x96, 0x2f, 0x8f, 0x60, 0xd8, 0xc5, 0x2e,
+  0xd8, 0xcf, 0x97, 0x43, 0x5f, 0x74, 0xac, 0x5d, 0x29, 0x39, 0x6b, 0xf4, 0xa6, 0xff, 0x2e, 0x9e,
+  0xc6, 0xe8, 0x5e, 0xaf, 0x35, 0x16, 0x33, 0x6a, 0xb0, 0x6c, 0xb2, 0x7d, 0xce, 0xad, 0xd7, 0x6d,
+  0xd6, 0x95, 0xca, 0x34, 0x96, 0xfe, 0xf4, 0x1f, 0x57, 0x74, 0x89, 0x52, 0xea, 0x1a, 0x19, 0x04,
+  0x52, 0x9b, 0xde, 0xe6, 0x69, 0xb2, 0x91, 0x5a, 0x55, 0x22, 0x3f, 0x10, 0xd7, 0xcb, 0xb1, 0x15,
+  0xab, 0x55, 0x76, 0x3b, 0x3b, 0xbe, 0xe0, 0xac, 0xb9, 0x4e, 0xee, 0xca, 0x29, 0xc2, 0x9e, 0xd1,
+  0xa8, 0x78, 0x7d, 0x56, 0x4a, 0x2b, 0xaa, 0xe3, 0xfc, 0xb6, 0x73, 0x2b, 0x8e, 0xa2, 0xb9, 0x83,
+  0xae, 0x59, 0xa3, 0x54, 0x0b, 0x0f, 0x26, 0x49, 0xf6, 0x9d, 0x5a, 0xbb, 0xd6, 0x3e, 0x06, 0x72,
+  0x5d, 0x62, 0xc8, 0xd5, 0xb6, 0xd3, 0x8d, 0x06, 0x06, 0xa9, 0x9e, 0xd2, 0x5a, 0x31, 0x90, 0x08,
+  0x45, 0x4b, 0x79, 0x2b, 0xd3, 0xd1, 0xaa, 0xf4, 0x59, 0x56, 0x5a, 0xf3, 0x66, 0x9b, 0x7b, 0xae,
+  0xd1, 0xba, 0xff, 0x67, 0x25, 0x70, 0xe9, 0x47, 0xe2, 0xbd, 0xc9, 0xef, 0x8e, 0x31, 0x6e, 0xa2,
+  0x4f, 0x79, 0x34, 0x2a, 0x94, 0x42, 0x05, 0xf9, 0xed, 0x7e, 0xf8, 0x71, 0x2d, 0x04, 0xe2, 0x29,
+  0x36, 0x9c, 0xda, 0xbf, 0x5a, 0xef, 0x44, 0x53, 0x15, 0x95, 0xdf, 0x71, 0xb3, 0x50, 0x8b, 0xe6,
+  0x6a, 0x35, 0x67, 0xae, 0xca, 0xa3, 0xfd, 0x4c, 0x76, 0xb6, 0x2f, 0xf0, 0x84, 0xdc, 0xb7, 0xf0,
+  0xaa, 0x65, 0xf6, 0xa9, 0x2e, 0xe5, 0x68, 0x25, 0x7e, 0xc8, 0x95, 0xff, 0x19, 0x6a, 0xcf, 0xe5,
+  0xe5, 0x3e, 0x08, 0xb4, 0x93, 0xad, 0x55, 0xa4, 0x69, 0xe2, 0x37, 0x58, 0xd7, 0x2b, 0x67, 0x63,
+  0xbb, 0xeb, 0xf8, 0x1f, 0xfc, 0xce, 0x5b, 0x81, 0xad, 0xa0, 0xfe, 0x79, 0xda, 0xcd, 0xcf, 0xbb,
+  0x37, 0x01, 0xd0, 0xcd, 0xea, 0x31, 0x1d, 0x8e, 0x7f, 0xaf, 0xdd, 0xfa, 0xd1, 0xa8, 0x11, 0x8e,
+  0x66, 0xf6, 0x0f, 0xa6, 0xc6, 0xf5, 0x71, 0xd0, 0x8e, 0xff, 0xe2, 0xc1, 0x8d, 0xc4, 0x6b, 0xe0,
+  0xb7, 0x1b, 0x5e, 0x2f, 0xfd, 0xd0, 0xf2, 0xd0, 0x24, 0xd8, 0x2f, 0xc6, 0x62, 0x89, 0x4d, 0xf8,
+  0xc0, 0x6b, 0xb9, 0x3e, 0x75, 0x8a, 0xc9, 0x5a, 0xf4, 0x7a, 0x27, 0x33, 0x2c, 0xa6, 0xa7, 0x91,
+  0xcf, 0xae, 0x78, 0xf2, 0x7e, 0xfa, 0x3c, 0x5f, 0x6d, 0x20, 0xa0, 0x47, 0x29, 0x9f, 0xae, 0xef,
+  0x8b, 0xc3, 0x22, 0xda, 0xda, 0xe2, 0x31, 0x9f, 0xfe, 0xdb, 0x4b, 0x39, 0xe0, 0x6f, 0x3a, 0x18,
+  0xfa, 0xcf, 0x6e, 0xc9, 0xb2, 0x8f, 0xff, 0x27, 0x74, 0x1d, 0xbf, 0x6a, 0x35, 0x1e, 0x9b, 0xdb,
+  0xe8, 0xf4, 0x9e, 0x5e, 0x1b, 0x1d, 0xc5, 0xc8, 0xc8, 0xb2, 0xb6, 0x58, 0x46, 0xc2, 0xd7, 0xa0,
+  0xb8, 0x74, 0x73, 0x37, 0xbe, 0x45, 0xbe, 0x0d, 0x1c, 0xa5, 0xf4, 0xbc, 0x15, 0x1a, 0xe6, 0x0e,
+  0x9f, 0x59, 0xe2, 0x6b, 0x3a, 0x9d, 0xdf, 0x05, 0x63, 0x6b, 0x18, 0xc6, 0xdb, 0x73, 0xf4, 0x3d,
+  0x95, 0xaa, 0xb1, 0xc9, 0xd7, 0xed, 0x24, 0x71, 0x50,
+};
+
+static const uint8_t PATCH_BAD_SEEK[87] = {
+  0x43, 0x44, 0x50, 0x31, 0x0b, 0x06, 0x00, 0x00, 0x00, 0x80, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x80, 0x40, 0x70, 0x58, 0x08, 0x24, 0x00,
+};
+
+#endif // TEST_DELTA_PATCHES_H
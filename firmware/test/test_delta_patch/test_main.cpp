@@ -0,0 +1,254 @@
+/*
+  Host tests of the delta patch decoder (delta_patch.h) with patches
+  created by tools/delta_patch.py (see make_patches.py and patches.h).
+  Every patch is streamed in chunks of a few sizes like the OTA download
+  delivers them, the rebuilt image must match byte for byte. Corrupt and
+  truncated patches must never complete or write past the new image.
+*/
+
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include "config.h"
+#include "delta_patch.h"
+#include "patches.h"
+
+#define OLD_SIZE 32768
+#define BLOCK 256
+
+struct TestImage {
+  const char* name;
+  std::vector<uint8_t> bytes;
+  const uint8_t* patch;
+  size_t patchSize;
+};
+
+// Where the decoder reads the old image from and writes the new one to
+struct Slots {
+  const std::vector<uint8_t>* oldImage;
+  uint32_t expectedNewSize;
+  std::vector<uint8_t> written;
+  size_t largestWrite;
+};
+
+static std::vector<uint8_t> oldImage;
+static std::vector<TestImage> images;
+static DeltaPatchDecoder decoder;
+static Slots slots;
+
+// --- Images, built like make_patches.py does --------------------------------
+
+static uint32_t xorshift(uint32_t state) {
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+  return state;
+}
+
+static std::vector<uint8_t> randomBytes(uint32_t seed, size_t size) {
+  std::vector<uint8_t> out;
+  uint32_t state = seed;
+  for (size_t i = 0; i < size; i++) {
+    state = xorshift(state);
+    out.push_back((uint8_t)state);
+  }
+  return out;
+}
+
+static void buildImages() {
+  const char* text = "CHESS CLOCK ";
+  uint32_t state = 0x2545F491;
+  while (oldImage.size() < OLD_SIZE) {
+    state = xorshift(state);
+    uint32_t kind = state % 4;
+    for (int i = 0; i < BLOCK; i++) {
+      if (kind == 0) {
+        oldImage.push_back(0);
+      } else if (kind == 1) {
+        oldImage.push_back((uint8_t)text[i % strlen(text)]);
+      } else {
+        state = xorshift(state);
+        oldImage.push_back((uint8_t)state);
+      }
+    }
+  }
+
+  std::vector<uint8_t> constants = oldImage;
+  memcpy(&constants[64], "v1.1", 4);
+  for (int i = 0; i < 24; i++) {
+    constants[1000 + i * 1301] ^= 0x5A;
+  }
+
+  std::vector<uint8_t> relinked(oldImage.begin(), oldImage.begin() + 8192);
+  for (int i = 0; i < 512; i++) {
+    relinked.push_back((uint8_t)(i * 7));
+  }
+  relinked.insert(relinked.end(), oldImage.begin() + 8192, oldImage.begin() + 20000);
+  relinked.insert(relinked.end(), oldImage.begin() + 20100, oldImage.end());
+  for (size_t offset = 12000; offset < 24000; offset += 64) {
+    relinked[offset] += 0x20;
+  }
+
+  images.push_back({ "constants", constants, PATCH_CONSTANTS, sizeof(PATCH_CONSTANTS) });
+  images.push_back({ "relinked", relinked, PATCH_RELINKED, sizeof(PATCH_RELINKED) });
+  images.push_back({ "rewritten", randomBytes(0x9E3779B9, 4000), PATCH_REWRITTEN, sizeof(PATCH_REWRITTEN) });
+}
+
+// --- Decoder callbacks -------------------------------------------------------
+
+static bool checkHeader(void* context, const DeltaPatchHeader& header) {
+  Slots* target = (Slots*)context;
+  return header.oldSize == target->oldImage->size() && header.newSize == target->expectedNewSize;
+}
+
+static bool readOld(void* context, uint32_t offset, uint8_t* buffer, size_t length) {
+  Slots* target = (Slots*)context;
+  if ((size_t)offset + length > target->oldImage->size()) {
+    return false;
+  }
+  memcpy(buffer, target->oldImage->data() + offset, length);
+  return true;
+}
+
+static bool writeNew(void* context, const uint8_t* data, size_t length) {
+  Slots* target = (Slots*)context;
+  target->written.insert(target->written.end(), data, data + length);
+  target->largestWrite = length > target->largestWrite ? length : target->largestWrite;
+  return true;
+}
+
+// Streams a patch in chunks of chunkSize bytes until the decoder stops asking for more
+static DeltaPatchStatus apply(const uint8_t* patch, size_t size, size_t chunkSize, uint32_t newSize) {
+  slots.oldImage = &oldImage;
+  slots.expectedNewSize = newSize;
+  slots.written.clear();
+  slots.largestWrite = 0;
+  DeltaPatchIo io = { &slots, checkHeader, readOld, writeNew };
+  decoder.begin(io);
+
+  DeltaPatchStatus status = DeltaPatchStatus::NEED_MORE;
+  for (size_t position = 0; position < size && status == DeltaPatchStatus::NEED_MORE; position += chunkSize) {
+    size_t length = size - position < chunkSize ? size - position : chunkSize;
+    status = decoder.write(patch + position, length);
+  }
+  return status;
+}
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+static void test_tool_patches_rebuild_the_image_byte_for_byte() {
+  const size_t chunkSizes[] = { 1, 2, 3, 7, 64, 1000, SIZE_MAX };
+  for (const TestImage& image : images) {
+    for (size_t chunkSize : chunkSizes) {
+      DeltaPatchStatus status = apply(image.patch, image.patchSize, chunkSize, image.bytes.size());
+      TEST_ASSERT_TRUE_MESSAGE(status == DeltaPatchStatus::DONE, image.name);
+      TEST_ASSERT_EQUAL_UINT32(image.bytes.size(), decoder.bytesWritten());
+      TEST_ASSERT_EQUAL_size_t(image.bytes.size(), slots.written.size());
+      TEST_ASSERT_EQUAL_MEMORY(image.bytes.data(), slots.written.data(), image.bytes.size());
+      TEST_ASSERT_LESS_OR_EQUAL(DELTA_PATCH_OUT_BUFFER_SIZE, slots.largestWrite);
+    }
+  }
+}
+
+static void test_patch_size_against_the_full_image() {
+  for (const TestImage& image : images) {
+    char line[96];
+    snprintf(line, sizeof(line), "%-9s patch %5u bytes for a %5u byte image (%.1f %%)", image.name,
+             (unsigned)image.patchSize, (unsigned)image.bytes.size(), 100.0 * image.patchSize / image.bytes.size());
+    TEST_MESSAGE(line);
+  }
+  // Small changes cost a small part of a full download, even when everything behind them moves
+  TEST_ASSERT_LESS_THAN(images[0].bytes.size() / 10, images[0].patchSize);
+  TEST_ASSERT_LESS_THAN(images[1].bytes.size() / 10, images[1].patchSize);
+}
+
+static void test_corrupt_headers_are_rejected() {
+  const TestImage& image = images[1];
+  std::vector<uint8_t> patch(image.patch, image.patch + image.patchSize);
+
+  patch[0] = 'X';                                     // Magic
+  TEST_ASSERT_TRUE(apply(patch.data(), patch.size(), 64, image.bytes.size()) == DeltaPatchStatus::BAD_HEADER);
+  patch[0] = image.patch[0];
+  patch[4] = DELTA_PATCH_MAX_WINDOW_BITS + 1;         // History larger than the decoder's window
+  TEST_ASSERT_TRUE(apply(patch.data(), patch.size(), 64, image.bytes.size()) == DeltaPatchStatus::BAD_HEADER);
+  patch[4] = image.patch[4];
+  patch[5] = 0;                                       // Lookahead bits
+  TEST_ASSERT_TRUE(apply(patch.data(), patch.size(), 64, image.bytes.size()) == DeltaPatchStatus::BAD_HEADER);
+
+  // A patch for another image, refused by checkHeader
+  TEST_ASSERT_TRUE(apply(image.patch, image.patchSize, 64, image.bytes.size() + 1) == DeltaPatchStatus::BAD_HEADER);
+  TEST_ASSERT_EQUAL_size_t(0, slots.written.size());
+}
+
+static void test_corrupt_bodies_never_write_past_the_image() {
+  TEST_ASSERT_TRUE(apply(PATCH_BAD_SEEK, sizeof(PATCH_BAD_SEEK), 1, 16) == DeltaPatchStatus::BAD_BODY);
+
+  // Single flipped bits anywhere in the body: the decoder may not notice
+  // (the SHA-256 check of ota_delta.cpp does), but it must stay in bounds
+  srand(29);
+  uint32_t rejected = 0;
+  uint32_t unfinished = 0;
+  uint32_t wrong = 0;
+  uint32_t harmless = 0;   // E.g. a back reference to an equal byte
+  for (const TestImage& image : images) {
+    std::vector<uint8_t> patch(image.patch, image.patch + image.patchSize);
+    for (int i = 0; i < 300; i++) {
+      size_t offset = DELTA_PATCH_HEADER_SIZE + rand() % (patch.size() - DELTA_PATCH_HEADER_SIZE);
+      uint8_t bit = (uint8_t)(1 << (rand() % 8));
+      patch[offset] ^= bit;
+      DeltaPatchStatus status = apply(patch.data(), patch.size(), 1 + rand() % 256, image.bytes.size());
+      patch[offset] ^= bit;
+
+      // Up to one block may still wait in the decoder
+      TEST_ASSERT_LESS_OR_EQUAL(image.bytes.size(), decoder.bytesWritten());
+      TEST_ASSERT_LESS_OR_EQUAL(decoder.bytesWritten(), slots.written.size());
+      if (status == DeltaPatchStatus::BAD_BODY || status == DeltaPatchStatus::READ_ERROR) {
+        rejected++;
+      } else if (status == DeltaPatchStatus::NEED_MORE) {
+        unfinished++;
+      } else {
+        TEST_ASSERT_TRUE(status == DeltaPatchStatus::DONE);
+        if (memcmp(image.bytes.data(), slots.written.data(), image.bytes.size()) != 0) {
+          wrong++;
+        } else {
+          harmless++;
+        }
+      }
+    }
+  }
+  char line[160];
+  snprintf(line, sizeof(line),
+           "900 flipped bits: %u rejected, %u unfinished, %u complete but wrong (left to SHA-256), %u harmless",
+           (unsigned)rejected, (unsigned)unfinished, (unsigned)wrong, (unsigned)harmless);
+  TEST_MESSAGE(line);
+}
+
+static void test_truncated_patches_never_finish() {
+  for (const TestImage& image : images) {
+    const size_t cuts[] = { 0, DELTA_PATCH_HEADER_SIZE - 1, DELTA_PATCH_HEADER_SIZE, DELTA_PATCH_HEADER_SIZE + 1,
+                            image.patchSize / 2, image.patchSize - 1 };
+    for (size_t cut : cuts) {
+      DeltaPatchStatus status = apply(image.patch, cut, 7, image.bytes.size());
+      TEST_ASSERT_TRUE(status == DeltaPatchStatus::NEED_MORE);
+      TEST_ASSERT_LESS_THAN(image.bytes.size(), decoder.bytesWritten());
+      TEST_ASSERT_EQUAL_MEMORY(image.bytes.data(), slots.written.data(), slots.written.size());
+    }
+  }
+}
+
+int main() {
+  buildImages();
+  UNITY_BEGIN();
+  RUN_TEST(test_tool_patches_rebuild_the_image_byte_for_byte);
+  RUN_TEST(test_patch_size_against_the_full_image);
+  RUN_TEST(test_corrupt_headers_are_rejected);
+  RUN_TEST(test_corrupt_bodies_never_write_past_the_image);
+  RUN_TEST(test_truncated_patches_never_finish);
+  return UNITY_END();
+}
@@ -0,0 +1,263 @@
+/*
+  Host tests of the event bus (event_bus.h): delivery by topic without
+  copies, reference counting back into the pool, drops of full inboxes,
+  and a stress test and benchmark with 1 to 16 subscribers, each drained
+  by its own thread while one publisher hands out events.
+*/
+
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "event_bus.h"
+
+#define SUBSCRIBERS 16
+#define POOL 64
+#define INBOX 128                     // Larger than the pool: inboxes never overflow
+
+struct TestEvent {
+  uint32_t sequence;
+  uint32_t value;
+};
+
+typedef EventBus<TestEvent, POOL, SUBSCRIBERS, INBOX> TestBus;
+typedef EventBus<TestEvent, 8, 2, 4> SmallBus;
+
+static TestBus bus;
+static SmallBus smallBus;
+
+// What every subscriber saw, written only by the thread that drains it
+struct Seen {
+  uint32_t count;
+  uint32_t nextSequence;
+  uint32_t outOfOrder;
+  uint64_t valueSum;
+  const TestEvent* last;
+};
+
+static Seen seen[SUBSCRIBERS];
+static uint32_t wakes[SUBSCRIBERS];
+
+template <int I>
+static void handle(const TestEvent& event) {
+  Seen& mine = seen[I];
+  if (event.sequence < mine.nextSequence) {
+    mine.outOfOrder++;
+  }
+  mine.nextSequence = event.sequence + 1;
+  mine.count++;
+  mine.valueSum += event.value;
+  mine.last = &event;
+}
+
+static void (*const HANDLERS[SUBSCRIBERS])(const TestEvent&) = {
+  handle<0>, handle<1>, handle<2>, handle<3>, handle<4>, handle<5>, handle<6>, handle<7>,
+  handle<8>, handle<9>, handle<10>, handle<11>, handle<12>, handle<13>, handle<14>, handle<15>,
+};
+
+static int64_t nowUs() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void wake(uint8_t owner) {
+  wakes[owner]++;
+}
+
+static std::vector<TestBus::Subscriber> makeTable(uint8_t count, uint32_t topics) {
+  std::vector<TestBus::Subscriber> table;
+  for (uint8_t i = 0; i < count; i++) {
+    table.push_back({ "sub", topics, HANDLERS[i], i });
+  }
+  return table;
+}
+
+template <typename Bus>
+static uint8_t publishValue(Bus& target, uint32_t sequence, uint32_t topic) {
+  TestEvent* event = target.claim();
+  TEST_ASSERT_NOT_NULL(event);
+  event->sequence = sequence;
+  event->value = sequence * 3;
+  return target.publish(event, topic);
+}
+
+void setUp() {
+  memset(seen, 0, sizeof(seen));
+  memset(wakes, 0, sizeof(wakes));
+}
+
+void tearDown() {
+}
+
+static void test_events_reach_only_subscribers_of_their_topic() {
+  TestBus::Subscriber table[] = {
+    { "state", 1, HANDLERS[0], 0 },
+    { "move", 2, HANDLERS[1], 1 },
+    { "both", 3, HANDLERS[2], 1 },
+  };
+  TEST_ASSERT_TRUE(bus.begin(table, 3, nowUs, wake));
+
+  TEST_ASSERT_EQUAL_UINT8(2, publishValue(bus, 0, 1));
+  TEST_ASSERT_EQUAL_UINT8(2, publishValue(bus, 1, 2));
+  TEST_ASSERT_EQUAL_UINT8(0, publishValue(bus, 2, 4));
+  TEST_ASSERT_EQUAL_UINT32(1, bus.unclaimedCount());
+
+  // A task with two interested subscribers is woken once per event
+  TEST_ASSERT_EQUAL_UINT32(1, wakes[0]);
+  TEST_ASSERT_EQUAL_UINT32(2, wakes[1]);
+
+  TEST_ASSERT_EQUAL_UINT16(2, bus.poolUsed());
+  TEST_ASSERT_EQUAL_UINT16(1, bus.drain(0));
+  TEST_ASSERT_EQUAL_UINT16(1, bus.drain(1));
+  TEST_ASSERT_EQUAL_UINT16(2, bus.poolUsed());   // Both still wait for "both"
+  TEST_ASSERT_EQUAL_UINT16(2, bus.drain(2));
+  TEST_ASSERT_EQUAL_UINT16(0, bus.poolUsed());
+  TEST_ASSERT_EQUAL_UINT16(0, bus.drain(3));
+
+  TEST_ASSERT_EQUAL_UINT32(1, seen[0].nextSequence);
+  TEST_ASSERT_EQUAL_UINT32(2, seen[1].nextSequence);
+  TEST_ASSERT_EQUAL_UINT32(2, seen[2].count);
+  TEST_ASSERT_EQUAL_UINT64(3, seen[2].valueSum);
+  TEST_ASSERT_EQUAL_UINT32(2, bus.subscriberStats(2).delivered);
+  TEST_ASSERT_EQUAL_UINT32(0, bus.subscriberStats(2).dropped);
+}
+
+static void test_subscribers_share_the_claimed_event() {
+  std::vector<TestBus::Subscriber> table = makeTable(4, 1);
+  TEST_ASSERT_TRUE(bus.begin(table.data(), 4, nowUs, nullptr));
+  TestEvent* event = bus.claim();
+  TEST_ASSERT_NOT_NULL(event);
+  event->sequence = 7;
+  TEST_ASSERT_EQUAL_UINT8(4, bus.publish(event, 1));
+  for (uint8_t i = 0; i < 4; i++) {
+    bus.drain(i);
+    TEST_ASSERT_EQUAL_PTR(event, seen[i].last);
+  }
+  TEST_ASSERT_EQUAL_UINT16(0, bus.poolUsed());
+}
+
+static void test_a_full_inbox_drops_for_that_subscriber_only() {
+  SmallBus::Subscriber table[] = {
+    { "slow", 1, HANDLERS[0], 0 },
+    { "fast", 1, HANDLERS[1], 1 },
+  };
+  TEST_ASSERT_TRUE(smallBus.begin(table, 2, nowUs, nullptr));
+  for (uint32_t i = 0; i < 6; i++) {
+    publishValue(smallBus, i, 1);
+    TEST_ASSERT_EQUAL_UINT16(1, smallBus.drain(1));
+  }
+  BusSubscriberStats slow = smallBus.subscriberStats(0);
+  TEST_ASSERT_EQUAL_UINT32(2, slow.dropped);
+  TEST_ASSERT_EQUAL_UINT32(0, smallBus.subscriberStats(1).dropped);
+  TEST_ASSERT_EQUAL_UINT32(6, smallBus.subscriberStats(1).delivered);
+  TEST_ASSERT_EQUAL_UINT16(4, smallBus.poolUsed());
+
+  // The oldest events are kept, a drain takes at most one inbox length
+  TEST_ASSERT_EQUAL_UINT16(4, smallBus.drain(0));
+  TEST_ASSERT_EQUAL_UINT32(4, seen[0].nextSequence);
+  TEST_ASSERT_EQUAL_UINT32(0, seen[0].outOfOrder);
+  TEST_ASSERT_EQUAL_UINT16(0, smallBus.poolUsed());
+  TEST_ASSERT_EQUAL_UINT16(5, smallBus.poolHighWater());   // The full inbox and the one just claimed
+}
+
+static void test_an_empty_pool_is_counted() {
+  SmallBus::Subscriber table[] = { { "sub", 1, HANDLERS[0], 0 } };
+  TEST_ASSERT_TRUE(smallBus.begin(table, 1, nowUs, nullptr));
+  std::vector<TestEvent*> claimed;
+  for (int i = 0; i < 8; i++) {
+    claimed.push_back(smallBus.claim());
+    TEST_ASSERT_NOT_NULL(claimed.back());
+  }
+  uint32_t exhausted = smallBus.poolExhausted();
+  TEST_ASSERT_NULL(smallBus.claim());
+  TEST_ASSERT_EQUAL_UINT32(exhausted + 1, smallBus.poolExhausted());
+  for (TestEvent* event : claimed) {
+    smallBus.publish(event, 2);   // Nobody wants it, it goes straight back
+  }
+  TEST_ASSERT_EQUAL_UINT16(0, smallBus.poolUsed());
+}
+
+static void test_begin_rejects_a_table_that_is_too_long() {
+  std::vector<TestBus::Subscriber> table = makeTable(SUBSCRIBERS, 1);
+  table.push_back(table[0]);
+  TEST_ASSERT_FALSE(bus.begin(table.data(), SUBSCRIBERS + 1, nowUs, nullptr));
+  TEST_ASSERT_TRUE(bus.begin(table.data(), SUBSCRIBERS, nowUs, nullptr));
+  TEST_ASSERT_EQUAL_UINT8(SUBSCRIBERS, bus.subscriberCount());
+}
+
+// One publisher, every subscriber drained by its own thread; the publisher
+// waits for a free event when the pool is empty
+static double publishUnderLoad(uint8_t subscribers, uint32_t events) {
+  std::vector<TestBus::Subscriber> table = makeTable(subscribers, 1);
+  TEST_ASSERT_TRUE(bus.begin(table.data(), subscribers, nowUs, nullptr));
+  memset(seen, 0, sizeof(seen));
+
+  std::atomic<bool> done(false);
+  std::vector<std::thread> threads;
+  for (uint8_t i = 0; i < subscribers; i++) {
+    threads.emplace_back([i, &done]() {
+      while (!done.load(std::memory_order_acquire)) {
+        if (bus.drain(i) == 0) {
+          std::this_thread::yield();
+        }
+      }
+      while (bus.drain(i) > 0) {
+      }
+    });
+  }
+
+  double publishNs = 0;
+  for (uint32_t sequence = 0; sequence < events; sequence++) {
+    TestEvent* event;
+    while ((event = bus.claim()) == nullptr) {
+      std::this_thread::yield();
+    }
+    event->sequence = sequence;
+    event->value = sequence * 3;
+    auto start = std::chrono::steady_clock::now();
+    bus.publish(event, 1);
+    publishNs += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+  }
+  done.store(true, std::memory_order_release);
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  uint64_t valueSum = 3ULL * events * (events - 1) / 2;
+  for (uint8_t i = 0; i < subscribers; i++) {
+    BusSubscriberStats stats = bus.subscriberStats(i);
+    TEST_ASSERT_EQUAL_UINT32(events, stats.delivered);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.dropped);
+    TEST_ASSERT_EQUAL_UINT32(events, seen[i].count);
+    TEST_ASSERT_EQUAL_UINT32(0, seen[i].outOfOrder);
+    TEST_ASSERT_EQUAL_UINT64(valueSum, seen[i].valueSum);
+  }
+  TEST_ASSERT_EQUAL_UINT16(0, bus.poolUsed());
+  TEST_ASSERT_LESS_OR_EQUAL(POOL, bus.poolHighWater());
+  return publishNs / events;
+}
+
+static void test_one_to_sixteen_subscribers_in_their_own_threads() {
+  const uint32_t events = 100000;
+  for (uint8_t subscribers : { 1, 2, 4, 8, 16 }) {
+    double ns = publishUnderLoad(subscribers, events);
+    char line[96];
+    snprintf(line, sizeof(line), "%2u subscribers: publish %.0f ns on the host, no drops, no leaks",
+             (unsigned)subscribers, ns);
+    TEST_MESSAGE(line);
+  }
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_events_reach_only_subscribers_of_their_topic);
+  RUN_TEST(test_subscribers_share_the_claimed_event);
+  RUN_TEST(test_a_full_inbox_drops_for_that_subscriber_only);
+  RUN_TEST(test_an_empty_pool_is_counted);
+  RUN_TEST(test_begin_rejects_a_table_that_is_too_long);
+  RUN_TEST(test_one_to_sixteen_subscribers_in_their_own_threads);
+  return UNITY_END();
+}
@@ -0,0 +1,312 @@
+/*
+  Randomized virtual-time test of flag falls in the input engine
+  (input_engine.h): rocker edges reach the queue after a random
+  interrupt latency, the flag alarm fires FLAG_ALARM_GUARD_US plus a
+  modeled callback latency after the expiry, and a simulated time task
+  pushes and pops like handleClockEvents() in main.cpp. Whole games run
+  through the time engine (time_engine.h) with increments, the alarm is
+  re-armed on every press, and the time from the true expiry to the
+  handled flag fall is reported.
+*/
+
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <vector>
+#include "config.h"
+#include "input_engine.h"
+#include "time_engine.h"
+
+static const uint32_t MAX_CAPTURE_LATENCY_US = FLAG_ALARM_GUARD_US - 1;
+static const uint32_t MAX_ALARM_LATENCY_US = 150;   // esp_timer ISR behind a flash write or a critical section
+static const uint32_t LAST_MOMENT_US = 300;         // Presses this close to the flag
+
+struct Posted {
+  int64_t postedUs;               // Interrupt ran and queued the event
+  ClockEventType type;
+  int64_t timestampUs;            // Edge or expiry
+};
+
+struct Handled {
+  ClockEventType type;
+  int64_t timestampUs;
+  int64_t handledUs;
+};
+
+static InputEngine engine;
+
+void setUp() {
+  engine.reset(0, 0, INPUT_RESOLVE_WINDOW_US);
+}
+
+void tearDown() {
+  engine.reset(0, 0, 0);
+}
+
+// Time task: wakes on the next posted event or when a held one is due
+static std::vector<Handled> runTimeTask(std::vector<Posted> queue) {
+  std::vector<Handled> handled;
+  size_t next = 0;
+  while (next < queue.size() || engine.nextDueUs() != INT64_MAX) {
+    int64_t nowUs = engine.nextDueUs();
+    if (next < queue.size() && queue[next].postedUs < nowUs) {
+      nowUs = queue[next].postedUs;
+    }
+    while (next < queue.size() && queue[next].postedUs <= nowUs) {
+      ClockEvent* event = clockEventPool.acquire();
+      TEST_ASSERT_NOT_NULL(event);
+      event->type = queue[next].type;
+      event->timestampUs = queue[next].timestampUs;
+      engine.push(event);
+      next++;
+    }
+    ClockEvent* event;
+    while ((event = engine.pop(nowUs)) != nullptr) {
+      handled.push_back({ event->type, event->timestampUs, nowUs });
+      clockEventPool.release(event);
+    }
+  }
+  return handled;
+}
+
+static void sortByPostTime(std::vector<Posted>& queue) {
+  for (size_t i = 1; i < queue.size(); i++) {
+    Posted item = queue[i];
+    size_t j = i;
+    while (j > 0 && queue[j - 1].postedUs > item.postedUs) {
+      queue[j] = queue[j - 1];
+      j--;
+    }
+    queue[j] = item;
+  }
+}
+
+static void test_lone_flag_fall_is_not_held() {
+  std::vector<Posted> queue = { { 1000000 + FLAG_ALARM_GUARD_US + 7, ClockEventType::FLAG_FALL, 1000000 } };
+  std::vector<Handled> handled = runTimeTask(queue);
+  TEST_ASSERT_EQUAL_size_t(1, handled.size());
+  TEST_ASSERT_EQUAL_INT64(1000000 + FLAG_ALARM_GUARD_US + 7, handled[0].handledUs);
+}
+
+static void test_press_just_before_the_expiry_wins() {
+  // Edge 1 us before the flag, its interrupt ran as late as possible
+  std::vector<Posted> queue = {
+    { 1000000 + FLAG_ALARM_GUARD_US, ClockEventType::FLAG_FALL, 1000000 },
+    { 999999 + MAX_CAPTURE_LATENCY_US, ClockEventType::ROCKER_BLACK, 999999 },
+  };
+  sortByPostTime(queue);
+  std::vector<Handled> handled = runTimeTask(queue);
+  TEST_ASSERT_EQUAL_size_t(2, handled.size());
+  TEST_ASSERT_TRUE(handled[0].type == ClockEventType::ROCKER_BLACK);
+  TEST_ASSERT_TRUE(handled[1].type == ClockEventType::FLAG_FALL);
+}
+
+// A game through TimeEngine: presses charged by their edge, the flag alarm
+// re-armed on every press like changeState() does with flagAlarmArm(), and
+// handled like handleClockEvent() in main.cpp
+struct GameSimulation {
+  TimeEngine clock;
+  std::vector<Posted> posted;     // Not yet pushed, any order
+  int64_t alarmExpiryUs = INT64_MAX;
+  int64_t alarmFireUs = INT64_MAX;
+  bool alarmArmedLate = false;    // The expiry passed while the press was held
+  bool running = true;
+  int64_t nextPressEdgeUs = 0;
+  bool nextPressInTime = true;
+  uint32_t presses = 0;
+  uint32_t staleFlags = 0;
+  int64_t flagHandledUs = 0;
+  int64_t flagExpiryUs = 0;
+};
+
+// Alarm callback latency with ISR dispatch: a few microseconds, rarely more
+static uint32_t alarmLatencyUs() {
+  return rand() % 100 == 0 ? (uint32_t)(rand() % (MAX_ALARM_LATENCY_US + 1)) : 3 + rand() % 18;
+}
+
+static void armAlarm(GameSimulation& game, int64_t nowUs) {
+  game.alarmExpiryUs = game.clock.expiryUs();
+  int64_t fireUs = game.alarmExpiryUs + FLAG_ALARM_GUARD_US + alarmLatencyUs();
+  game.alarmArmedLate = fireUs <= nowUs;
+  game.alarmFireUs = game.alarmArmedLate ? nowUs : fireUs;   // Already due: flagAlarmArm() fires at once
+}
+
+// The player on move presses after some thinking, now and then just before or just after the flag
+static void planPress(GameSimulation& game, int64_t fromUs) {
+  int64_t remainingUs = game.clock.remainingUs(game.clock.activeSide(), fromUs);
+  int mode = rand() % 10;
+  int64_t thinkUs;
+  if (mode < 6) {
+    thinkUs = remainingUs / 20 + rand() % (remainingUs / 3 + 1);
+  } else if (mode < 8) {
+    thinkUs = remainingUs - 1 - rand() % LAST_MOMENT_US;
+  } else {
+    thinkUs = remainingUs + rand() % LAST_MOMENT_US;
+  }
+  // Without increment a last-moment press leaves the opponent almost nothing
+  thinkUs = thinkUs > 1 ? thinkUs : 1;
+  game.nextPressEdgeUs = fromUs + thinkUs;
+  game.nextPressInTime = game.nextPressEdgeUs < game.clock.expiryUs();
+  uint32_t latencyUs = rand() % (MAX_CAPTURE_LATENCY_US + 1);
+  ClockEventType rocker = game.clock.activeSide() == Side::WHITE ? ClockEventType::ROCKER_BLACK
+                                                                  : ClockEventType::ROCKER_WHITE;
+  game.posted.push_back({ game.nextPressEdgeUs + latencyUs, rocker, game.nextPressEdgeUs });
+}
+
+static void handleEvent(GameSimulation& game, const ClockEvent& event, int64_t nowUs) {
+  if (!game.running) {
+    return;
+  }
+  // Everything from after the expiry no longer counts
+  if (event.timestampUs >= game.clock.expiryUs()) {
+    TEST_ASSERT_FALSE(event.type != ClockEventType::FLAG_FALL && game.nextPressInTime);
+    game.running = false;
+    game.flagHandledUs = nowUs;
+    game.flagExpiryUs = game.clock.expiryUs();
+    game.alarmFireUs = INT64_MAX;   // flagAlarmCancel()
+    return;
+  }
+  ClockEventType moveDone = game.clock.activeSide() == Side::WHITE ? ClockEventType::ROCKER_BLACK
+                                                                   : ClockEventType::ROCKER_WHITE;
+  if (event.type == moveDone) {
+    TEST_ASSERT_TRUE(game.nextPressInTime);
+    game.clock.press(event.timestampUs);
+    game.presses++;
+    armAlarm(game, nowUs);
+    planPress(game, event.timestampUs);
+  } else if (event.type == ClockEventType::FLAG_FALL) {
+    game.staleFlags++;   // Fired for the expiry before a last-moment press
+  }
+}
+
+static GameSimulation playGame(uint32_t baseMs, uint32_t incrementMs) {
+  GameSimulation game;
+  engine.reset(0, 0, INPUT_RESOLVE_WINDOW_US);
+  game.clock.reset(baseMs, incrementMs);
+  game.clock.start(Side::WHITE, 0);
+  armAlarm(game, 0);
+  planPress(game, 0);
+
+  // Time task: wakes on the next posted event, the alarm or a held event that is due
+  while (game.running) {
+    int64_t nowUs = engine.nextDueUs();
+    for (const Posted& item : game.posted) {
+      nowUs = item.postedUs < nowUs ? item.postedUs : nowUs;
+    }
+    if (game.alarmFireUs <= nowUs) {
+      nowUs = game.alarmFireUs;
+      game.posted.push_back({ nowUs, ClockEventType::FLAG_FALL, game.alarmExpiryUs });
+      game.alarmFireUs = INT64_MAX;
+    }
+    TEST_ASSERT_TRUE(nowUs != INT64_MAX);
+    sortByPostTime(game.posted);
+    while (!game.posted.empty() && game.posted.front().postedUs <= nowUs) {
+      ClockEvent* event = clockEventPool.acquire();
+      TEST_ASSERT_NOT_NULL(event);
+      event->type = game.posted.front().type;
+      event->timestampUs = game.posted.front().timestampUs;
+      engine.push(event);
+      game.posted.erase(game.posted.begin());
+    }
+    ClockEvent* event;
+    while ((event = engine.pop(nowUs)) != nullptr) {
+      handleEvent(game, *event, nowUs);
+      clockEventPool.release(event);
+    }
+  }
+  // Leave nothing behind in the pool
+  ClockEvent* event;
+  while ((event = engine.pop(INT64_MAX / 2)) != nullptr) {
+    clockEventPool.release(event);
+  }
+  return game;
+}
+
+static void test_flag_falls_in_random_games() {
+  srand(33);
+  const int games = 20000;
+  std::vector<int64_t> errors;
+  int64_t maxLateArmedErrorUs = 0;
+  uint32_t lateArmed = 0;
+  uint32_t presses = 0;
+  uint32_t staleFlags = 0;
+  for (int i = 0; i < games; i++) {
+    // Bullet and blitz with and without increment, short enough to run out
+    uint32_t baseMs = 200 + rand() % 3000;
+    uint32_t incrementMs = rand() % 2 ? 100 + rand() % 2000 : 0;
+    GameSimulation game = playGame(baseMs, incrementMs);
+    presses += game.presses;
+    staleFlags += game.staleFlags;
+    int64_t errorUs = game.flagHandledUs - game.flagExpiryUs;
+    if (game.alarmArmedLate) {
+      // Only known once the held press was handled: no alarm could be earlier
+      lateArmed++;
+      maxLateArmedErrorUs = errorUs > maxLateArmedErrorUs ? errorUs : maxLateArmedErrorUs;
+    } else {
+      errors.push_back(errorUs);
+    }
+  }
+  std::sort(errors.begin(), errors.end());
+  int64_t p50 = errors[errors.size() / 2];
+  int64_t p99 = errors[errors.size() * 99 / 100];
+  char line[200];
+  snprintf(line, sizeof(line),
+           "%d games, %u presses: flag detected after the expiry min %lld us, p50 %lld us, p99 %lld us, "
+           "max %lld us; %u stale alarms ignored",
+           games, (unsigned)presses, (long long)errors.front(), (long long)p50, (long long)p99,
+           (long long)errors.back(), (unsigned)staleFlags);
+  TEST_MESSAGE(line);
+  snprintf(line, sizeof(line), "%u flags ran out while the press before was held: detected up to %lld us late",
+           (unsigned)lateArmed, (long long)maxLateArmedErrorUs);
+  TEST_MESSAGE(line);
+
+  // Never before the expiry, and late only by the guard and the alarm latency
+  TEST_ASSERT_GREATER_OR_EQUAL_INT64(FLAG_ALARM_GUARD_US, errors.front());
+  TEST_ASSERT_LESS_OR_EQUAL_INT64(FLAG_ALARM_GUARD_US + 21, p50);
+  TEST_ASSERT_LESS_OR_EQUAL_INT64(FLAG_ALARM_GUARD_US + MAX_ALARM_LATENCY_US, errors.back());
+  TEST_ASSERT_LESS_OR_EQUAL_INT64(INPUT_RESOLVE_WINDOW_US + MAX_CAPTURE_LATENCY_US, maxLateArmedErrorUs);
+  TEST_ASSERT_GREATER_THAN(0, staleFlags);
+}
+
+static void test_flag_fall_left_over_after_a_last_moment_press_is_ignored() {
+  GameSimulation game;
+  engine.reset(0, 0, INPUT_RESOLVE_WINDOW_US);
+  game.clock.reset(1000, 0);
+  game.clock.start(Side::WHITE, 0);
+  armAlarm(game, 0);
+  const int64_t expiryUs = game.clock.expiryUs();
+
+  // White presses 1 us before the flag, the alarm posts before the press is handled
+  game.nextPressInTime = true;
+  std::vector<Posted> queue = {
+    { expiryUs - 1 + MAX_CAPTURE_LATENCY_US, ClockEventType::ROCKER_BLACK, expiryUs - 1 },
+    { expiryUs + FLAG_ALARM_GUARD_US, ClockEventType::FLAG_FALL, expiryUs },
+  };
+  for (const Posted& item : queue) {
+    ClockEvent* event = clockEventPool.acquire();
+    event->type = item.type;
+    event->timestampUs = item.timestampUs;
+    engine.push(event);
+  }
+  int64_t nowUs = expiryUs + INPUT_RESOLVE_WINDOW_US;
+  ClockEvent* event;
+  while ((event = engine.pop(nowUs)) != nullptr) {
+    handleEvent(game, *event, nowUs);
+    clockEventPool.release(event);
+  }
+  TEST_ASSERT_TRUE(game.running);
+  TEST_ASSERT_EQUAL_UINT32(1, game.presses);
+  TEST_ASSERT_EQUAL_UINT32(1, game.staleFlags);
+  TEST_ASSERT_TRUE(game.clock.activeSide() == Side::BLACK);
+  TEST_ASSERT_EQUAL_INT64(expiryUs - 1 + 1000000, game.clock.expiryUs());
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_lone_flag_fall_is_not_held);
+  RUN_TEST(test_press_just_before_the_expiry_wins);
+  RUN_TEST(test_flag_falls_in_random_games);
+  RUN_TEST(test_flag_fall_left_over_after_a_last_moment_press_is_ignored);
+  return UNITY_END();
+}
@@ -0,0 +1,112 @@
+/*
+  Host tests of the flash window (flash_window.h), the only thing that
+  keeps flash writes away from presses and flag falls: writes outside a
+  game, the window after a press and its end, the margin before the
+  flag fall, and a clock without expiry.
+*/
+
+#include <unity.h>
+#include <stdint.h>
+#include "config.h"
+#include "flash_window.h"
+
+#define PRESS_WINDOW_US (FLASH_WRITE_PRESS_WINDOW_MS * 1000)
+#define FLAG_MARGIN_US (FLASH_WRITE_FLAG_MARGIN_MS * 1000)
+#define WRITE_US 30000                // A sector erase and write
+
+static FlashWindow window;
+
+void setUp() {
+  window.begin(PRESS_WINDOW_US, FLAG_MARGIN_US);
+}
+
+void tearDown() {
+}
+
+static void test_writes_are_free_outside_a_game() {
+  TEST_ASSERT_FALSE(window.gameRunning());
+  TEST_ASSERT_TRUE(window.allows(0, WRITE_US));
+  TEST_ASSERT_TRUE(window.allows(INT64_MAX / 2, UINT32_MAX));
+
+  // Pause and the result screen: stopped clock, the old expiry does not matter
+  window.setGame(true, 10000000);
+  window.pressed(9000000);
+  window.setGame(false, 10000000);
+  TEST_ASSERT_TRUE(window.allows(9990000, WRITE_US));
+}
+
+static void test_no_write_while_a_time_runs_without_a_press() {
+  window.setGame(true, 60000000);
+  TEST_ASSERT_TRUE(window.gameRunning());
+  TEST_ASSERT_FALSE(window.allows(1000000, WRITE_US));
+  TEST_ASSERT_FALSE(window.allows(1000000, 0));
+}
+
+static void test_the_press_opens_a_window_that_the_write_must_end_in() {
+  const int64_t pressUs = 5000000;
+  window.setGame(true, 60000000);
+  window.pressed(pressUs);
+
+  // Start of the window, and a write that ends exactly at its end
+  TEST_ASSERT_TRUE(window.allows(pressUs, WRITE_US));
+  TEST_ASSERT_TRUE(window.allows(pressUs + PRESS_WINDOW_US - WRITE_US, WRITE_US));
+  // One microsecond too late, or too long for the rest of the window
+  TEST_ASSERT_FALSE(window.allows(pressUs + PRESS_WINDOW_US - WRITE_US + 1, WRITE_US));
+  TEST_ASSERT_FALSE(window.allows(pressUs, PRESS_WINDOW_US + 1));
+  // Before the press (a stale now) and after the window
+  TEST_ASSERT_FALSE(window.allows(pressUs - 1, WRITE_US));
+  TEST_ASSERT_FALSE(window.allows(pressUs + PRESS_WINDOW_US + 1, 0));
+
+  // The next press opens the next window
+  window.pressed(pressUs + 3000000);
+  TEST_ASSERT_FALSE(window.allows(pressUs + 10000, WRITE_US));
+  TEST_ASSERT_TRUE(window.allows(pressUs + 3000000 + 10000, WRITE_US));
+}
+
+static void test_writes_keep_the_margin_to_the_flag_fall() {
+  const int64_t pressUs = 5000000;
+  const int64_t expiryUs = pressUs + 100000 + WRITE_US + FLAG_MARGIN_US;
+  window.setGame(true, expiryUs);
+  window.pressed(pressUs);
+
+  // Ends exactly one margin before the flag fall
+  TEST_ASSERT_TRUE(window.allows(pressUs + 100000, WRITE_US));
+  TEST_ASSERT_FALSE(window.allows(pressUs + 100001, WRITE_US));
+
+  // Short on time: inside the press window, but too close to the flag
+  window.setGame(true, pressUs + FLAG_MARGIN_US);
+  TEST_ASSERT_FALSE(window.allows(pressUs, WRITE_US));
+  TEST_ASSERT_TRUE(window.allows(pressUs, 0));
+  window.setGame(true, pressUs);
+  TEST_ASSERT_FALSE(window.allows(pressUs, 0));
+}
+
+static void test_no_expiry_leaves_only_the_press_window() {
+  const int64_t pressUs = INT64_MAX / 4;
+  window.setGame(true, INT64_MAX);
+  window.pressed(pressUs);
+  TEST_ASSERT_TRUE(window.allows(pressUs, WRITE_US));
+  TEST_ASSERT_TRUE(window.allows(pressUs + PRESS_WINDOW_US - WRITE_US, WRITE_US));
+  TEST_ASSERT_FALSE(window.allows(pressUs + PRESS_WINDOW_US, WRITE_US));
+}
+
+static void test_begin_closes_the_window_again() {
+  window.setGame(true, 60000000);
+  window.pressed(1000000);
+  TEST_ASSERT_TRUE(window.allows(1000000, WRITE_US));
+  window.begin(PRESS_WINDOW_US, FLAG_MARGIN_US);
+  TEST_ASSERT_FALSE(window.gameRunning());
+  window.setGame(true, 60000000);
+  TEST_ASSERT_FALSE(window.allows(1000000, WRITE_US));
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_writes_are_free_outside_a_game);
+  RUN_TEST(test_no_write_while_a_time_runs_without_a_press);
+  RUN_TEST(test_the_press_opens_a_window_that_the_write_must_end_in);
+  RUN_TEST(test_writes_keep_the_margin_to_the_flag_fall);
+  RUN_TEST(test_no_expiry_leaves_only_the_press_window);
+  RUN_TEST(test_begin_closes_the_window_again);
+  return UNITY_END();
+}
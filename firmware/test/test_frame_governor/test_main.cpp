@@ -0,0 +1,178 @@
+/*
+  Host tests of the frame governor (frame_governor.h) on a virtual clock:
+  frames on second and tenth boundaries, the switch to fractions below
+  CLOCK_FINE_BELOW_MS, the frame rate caps of both power modes, a stopped
+  clock that draws nothing and dirty state that draws at once.
+*/
+
+#include <unity.h>
+#include <stdint.h>
+#include <vector>
+#include "config.h"
+#include "frame_governor.h"
+
+#define SECOND_US 1000000LL
+#define TENTH_US 100000LL
+
+// A running clock: the frames the governor asks for, drawn on time
+struct Frame {
+  int64_t nowUs;
+  int64_t remainingUs;
+  uint8_t decimals;
+  uint32_t value;
+};
+
+static FrameGovernor governor;
+
+static std::vector<Frame> runClock(int64_t startUs, int64_t remainingUs, int64_t untilRemainingUs) {
+  std::vector<Frame> frames;
+  int64_t nowUs = startUs;
+  int64_t endUs = startUs + remainingUs;
+  for (;;) {
+    int64_t plannedUs = governor.nextFrameUs(nowUs, endUs - nowUs, true);
+    TEST_ASSERT_TRUE(plannedUs >= nowUs);
+    if (plannedUs == INT64_MAX || endUs - plannedUs < untilRemainingUs) {
+      break;
+    }
+    nowUs = plannedUs;
+    int64_t left = endUs - nowUs;
+    governor.frameDrawn(nowUs, plannedUs, left);
+    uint8_t shownDecimals = governor.decimals(left);
+    frames.push_back({ nowUs, left, shownDecimals, FrameGovernor::value(left, shownDecimals) });
+    if (left <= 0) {
+      break;
+    }
+  }
+  return frames;
+}
+
+void setUp() {
+  governor.begin(CLOCK_FRAME_MAX_FPS, CLOCK_FRAME_SAVING_FPS, CLOCK_FINE_BELOW_MS, CLOCK_FINE_DECIMALS);
+}
+
+void tearDown() {
+}
+
+static void test_shown_values_round_up() {
+  TEST_ASSERT_EQUAL_UINT32(0, FrameGovernor::value(0, 0));
+  TEST_ASSERT_EQUAL_UINT32(0, FrameGovernor::value(-5, 1));
+  TEST_ASSERT_EQUAL_UINT32(1, FrameGovernor::value(1, 0));
+  TEST_ASSERT_EQUAL_UINT32(1, FrameGovernor::value(SECOND_US, 0));
+  TEST_ASSERT_EQUAL_UINT32(2, FrameGovernor::value(SECOND_US + 1, 0));
+  TEST_ASSERT_EQUAL_UINT32(100, FrameGovernor::value(10 * SECOND_US - 1, 1));
+  TEST_ASSERT_EQUAL_UINT32(999, FrameGovernor::value(9990000, 2));
+  TEST_ASSERT_EQUAL_UINT8(0, governor.decimals(CLOCK_FINE_BELOW_MS * 1000LL));
+  TEST_ASSERT_EQUAL_UINT8(CLOCK_FINE_DECIMALS, governor.decimals(CLOCK_FINE_BELOW_MS * 1000LL - 1));
+}
+
+static void test_frames_fall_on_second_boundaries() {
+  // 5 min 3.3 s left: the first frame is dirty, then one per second
+  std::vector<Frame> frames = runClock(1000, 303300000, 20 * SECOND_US);
+  TEST_ASSERT_EQUAL_UINT32(1 + 303 - 20 + 1, frames.size());
+  TEST_ASSERT_EQUAL_UINT32(304, frames[0].value);
+  for (size_t i = 1; i < frames.size(); i++) {
+    TEST_ASSERT_EQUAL_INT64(0, frames[i].remainingUs % SECOND_US);
+    TEST_ASSERT_EQUAL_UINT32(frames[i - 1].value - 1, frames[i].value);
+    TEST_ASSERT_EQUAL_UINT8(0, frames[i].decimals);
+  }
+  TEST_ASSERT_EQUAL_UINT32(1, governor.stats().dirtyFrames);
+  TEST_ASSERT_EQUAL_UINT32(frames.size() - 1, governor.stats().coarseFrames);
+  TEST_ASSERT_EQUAL_UINT32(0, governor.stats().maxLateUs);
+}
+
+static void test_fractions_start_below_the_threshold() {
+  const int64_t fineBelowUs = CLOCK_FINE_BELOW_MS * 1000LL;
+  std::vector<Frame> frames = runClock(0, fineBelowUs + 2 * SECOND_US + 400000, 0);
+
+  size_t firstFine = 0;
+  while (firstFine < frames.size() && frames[firstFine].decimals == 0) {
+    firstFine++;
+  }
+  TEST_ASSERT_LESS_THAN(frames.size(), firstFine);
+  // The last whole second is the threshold itself, fractions follow as soon as the cap allows
+  TEST_ASSERT_EQUAL_INT64(fineBelowUs, frames[firstFine - 1].remainingUs);
+  TEST_ASSERT_EQUAL_INT64(fineBelowUs - SECOND_US / CLOCK_FRAME_MAX_FPS, frames[firstFine].remainingUs);
+  TEST_ASSERT_EQUAL_UINT32(fineBelowUs / TENTH_US, frames[firstFine].value);
+
+  // Then one frame per tenth, on its boundary, down to 0
+  for (size_t i = firstFine + 1; i < frames.size(); i++) {
+    TEST_ASSERT_EQUAL_UINT8(1, frames[i].decimals);
+    TEST_ASSERT_EQUAL_INT64(0, frames[i].remainingUs % TENTH_US);
+    TEST_ASSERT_EQUAL_UINT32(frames[i - 1].value - 1, frames[i].value);
+  }
+  TEST_ASSERT_EQUAL_INT64(0, frames.back().remainingUs);
+  TEST_ASSERT_EQUAL_UINT32(fineBelowUs / TENTH_US + 1, governor.stats().fineFrames);   // 10.0 down to 0.0
+  TEST_ASSERT_EQUAL_UINT32(1 + 2 + 1, governor.stats().coarseFrames + governor.stats().dirtyFrames);
+}
+
+static void test_hundredths_are_capped_by_the_frame_rate() {
+  for (FramePower power : { FramePower::NORMAL, FramePower::SAVING }) {
+    governor.begin(CLOCK_FRAME_MAX_FPS, CLOCK_FRAME_SAVING_FPS, CLOCK_FINE_BELOW_MS, 2);
+    governor.setPower(power);
+    uint32_t fps = power == FramePower::SAVING ? CLOCK_FRAME_SAVING_FPS : CLOCK_FRAME_MAX_FPS;
+    int64_t intervalUs = SECOND_US / fps;
+
+    std::vector<Frame> frames = runClock(0, 5 * SECOND_US, 0);
+    for (size_t i = 2; i < frames.size(); i++) {
+      TEST_ASSERT_GREATER_OR_EQUAL_INT64(intervalUs, frames[i].nowUs - frames[i - 1].nowUs);
+      TEST_ASSERT_LESS_THAN(frames[i - 1].value, frames[i].value);
+    }
+    // Close to the cap: 100 boundaries a second, at most fps of them drawn
+    TEST_ASSERT_INT_WITHIN(fps / 10 + 1, 5 * fps, governor.stats().fineFrames);
+    TEST_ASSERT_LESS_THAN_INT64(intervalUs, frames.back().remainingUs);   // 0 is the flag alarm's
+  }
+}
+
+static void test_a_stopped_clock_draws_nothing() {
+  TEST_ASSERT_EQUAL_INT64(5000, governor.nextFrameUs(5000, 30 * SECOND_US, false));   // Dirty after begin
+  governor.frameDrawn(5000, 5000, 30 * SECOND_US);
+  TEST_ASSERT_EQUAL_INT64(INT64_MAX, governor.nextFrameUs(6000, 30 * SECOND_US, false));
+  TEST_ASSERT_EQUAL_INT64(INT64_MAX, governor.nextFrameUs(100 * SECOND_US, 30 * SECOND_US, false));
+
+  // A time that ran out draws nothing more either
+  TEST_ASSERT_EQUAL_INT64(INT64_MAX, governor.nextFrameUs(7000, 0, true));
+  TEST_ASSERT_EQUAL_INT64(INT64_MAX, governor.nextFrameUs(7000, -100, true));
+}
+
+static void test_dirty_draws_at_once_and_does_not_move_the_boundaries() {
+  const int64_t endUs = 42 * SECOND_US + 250000;
+  std::vector<Frame> frames = runClock(0, endUs, 40 * SECOND_US);
+  int64_t nowUs = frames.back().nowUs + 300000;   // Between two boundaries
+  int64_t boundaryUs = governor.nextFrameUs(nowUs, endUs - nowUs, true);
+  TEST_ASSERT_EQUAL_INT64(0, (endUs - boundaryUs) % SECOND_US);
+
+  // A press or state change: frame right now, even inside the frame rate cap
+  governor.markDirty();
+  TEST_ASSERT_EQUAL_INT64(nowUs, governor.nextFrameUs(nowUs, endUs - nowUs, true));
+  governor.frameDrawn(nowUs, nowUs, endUs - nowUs);
+  governor.markDirty();
+  TEST_ASSERT_EQUAL_INT64(nowUs + 1, governor.nextFrameUs(nowUs + 1, endUs - nowUs - 1, false));
+  governor.frameDrawn(nowUs + 1, nowUs + 1, endUs - nowUs - 1);
+  TEST_ASSERT_EQUAL_UINT32(3, governor.stats().dirtyFrames);
+
+  // Afterwards the next second boundary again
+  TEST_ASSERT_EQUAL_INT64(boundaryUs, governor.nextFrameUs(nowUs + 2, endUs - nowUs - 2, true));
+}
+
+static void test_late_frames_are_counted() {
+  governor.frameDrawn(0, 0, 20 * SECOND_US);
+  int64_t plannedUs = governor.nextFrameUs(0, 20 * SECOND_US, true);
+  TEST_ASSERT_EQUAL_INT64(SECOND_US, plannedUs);
+  governor.frameDrawn(plannedUs + 700, plannedUs, 20 * SECOND_US - plannedUs - 700);
+  TEST_ASSERT_EQUAL_UINT32(700, governor.stats().maxLateUs);
+  TEST_ASSERT_EQUAL_UINT64(700, governor.stats().totalLateUs);
+  governor.resetStats();
+  TEST_ASSERT_EQUAL_UINT32(0, governor.stats().frames);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_shown_values_round_up);
+  RUN_TEST(test_frames_fall_on_second_boundaries);
+  RUN_TEST(test_fractions_start_below_the_threshold);
+  RUN_TEST(test_hundredths_are_capped_by_the_frame_rate);
+  RUN_TEST(test_a_stopped_clock_draws_nothing);
+  RUN_TEST(test_dirty_draws_at_once_and_does_not_move_the_boundaries);
+  RUN_TEST(test_late_frames_are_counted);
+  return UNITY_END();
+}
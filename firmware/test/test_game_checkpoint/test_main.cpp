@@ -0,0 +1,286 @@
+/*
+  Host tests of the game checkpoint encoding (game_checkpoint.h) and a
+  random reset injection: a model of checkpoint.cpp writes snapshots to
+  two RTC slots and a flash word, and resets tear the writes at random
+  points. After every reset checkpointSelect() has to find either the
+  snapshot before or after the torn write, and never a finished game.
+*/
+
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include <random>
+#include "game_checkpoint.h"
+
+#define STATE_WHITE_RUNNING 8
+#define STATE_PAUSE 10
+
+// RTC slots and NVS word of the clock, written like checkpoint.cpp does it
+struct CheckpointModel {
+  uint8_t slots[2][GAME_CHECKPOINT_SIZE];
+  uint64_t flash;
+  uint64_t pendingWord;
+  uint16_t sequence;
+
+  // Full write of the next slot, or only the first tornWords 32-bit words
+  void writeSlot(const GameSnapshot& snapshot, int tornWords) {
+    GameSnapshot numbered = snapshot;
+    numbered.sequence = ++sequence;
+    uint8_t packed[GAME_CHECKPOINT_SIZE];
+    checkpointPack(numbered, packed);
+    size_t length = tornWords < 0 ? GAME_CHECKPOINT_SIZE : (size_t)tornWords * 4;
+    memcpy(slots[sequence & 1], packed, length);
+  }
+
+  void save(const GameSnapshot& snapshot, bool toFlash, int tornWords = -1) {
+    writeSlot(snapshot, tornWords);
+    if (toFlash) {
+      pendingWord = checkpointPackCompact(snapshot);
+    }
+  }
+
+  void clear(int tornSlot = -1, int tornWords = 0) {
+    GameSnapshot ended = {};
+    ended.state = GAME_CHECKPOINT_ENDED;
+    for (int i = 0; i < 2; i++) {
+      writeSlot(ended, i == tornSlot ? tornWords : -1);
+      if (i == tornSlot) {
+        return;
+      }
+    }
+    pendingWord = 0;
+  }
+
+  void flashWriter() {
+    flash = pendingWord;
+  }
+
+  // What checkpointRestore() does after the reset
+  CheckpointSource restore(GameSnapshot* snapshot) {
+    CheckpointSource source = checkpointSelect(slots[0], slots[1], flash, snapshot);
+    sequence = source == CheckpointSource::NONE ? 0 : snapshot->sequence;
+    if (source == CheckpointSource::ENDED && flash != 0) {
+      clear();
+      flashWriter();
+    }
+    return source;
+  }
+};
+
+static GameSnapshot makeSnapshot(uint8_t state, uint8_t side, uint16_t plies, uint32_t whiteMs, uint32_t blackMs) {
+  GameSnapshot snapshot = {};
+  snapshot.state = state;
+  snapshot.activeSide = side;
+  snapshot.timeControl = 7;
+  snapshot.plies = plies;
+  snapshot.whiteMs = whiteMs;
+  snapshot.blackMs = blackMs;
+  return snapshot;
+}
+
+static bool sameGame(const GameSnapshot& a, const GameSnapshot& b) {
+  return a.state == b.state && a.activeSide == b.activeSide && a.timeControl == b.timeControl &&
+         a.plies == b.plies && a.whiteMs == b.whiteMs && a.blackMs == b.blackMs;
+}
+
+static CheckpointModel model;
+
+void setUp() {
+  memset(&model, 0, sizeof(model));
+  // A power-on leaves garbage in RTC memory
+  std::mt19937 random(99);
+  for (auto& slot : model.slots) {
+    for (uint8_t& byte : slot) {
+      byte = (uint8_t)random();
+    }
+  }
+}
+
+void tearDown() {
+}
+
+static void test_full_snapshot_round_trip() {
+  GameSnapshot snapshot = makeSnapshot(STATE_PAUSE, 1, 1023, 5400123, 17);
+  snapshot.sequence = 0xBEEF;
+  uint8_t packed[GAME_CHECKPOINT_SIZE];
+  checkpointPack(snapshot, packed);
+  GameSnapshot decoded;
+  TEST_ASSERT_TRUE(checkpointUnpack(packed, &decoded));
+  TEST_ASSERT_TRUE(sameGame(snapshot, decoded));
+  TEST_ASSERT_EQUAL_UINT16(0xBEEF, decoded.sequence);
+
+  // Every flipped bit is caught by the magic or the CRC
+  for (uint8_t bit = 0; bit < GAME_CHECKPOINT_SIZE * 8; bit++) {
+    packed[bit / 8] ^= (uint8_t)(1 << (bit % 8));
+    TEST_ASSERT_FALSE(checkpointUnpack(packed, &decoded));
+    packed[bit / 8] ^= (uint8_t)(1 << (bit % 8));
+  }
+
+  snapshot.whiteMs = 0xFFFFFFFF;
+  checkpointPack(snapshot, packed);
+  TEST_ASSERT_TRUE(checkpointUnpack(packed, &decoded));
+  TEST_ASSERT_EQUAL_UINT32(GAME_CHECKPOINT_MAX_MS, decoded.whiteMs);
+}
+
+static void test_compact_snapshot_keeps_centiseconds() {
+  GameSnapshot snapshot = makeSnapshot(STATE_PAUSE, 1, 321, 180009, 59990);
+  uint64_t word = checkpointPackCompact(snapshot);
+  TEST_ASSERT_TRUE(word != 0);
+  GameSnapshot decoded;
+  TEST_ASSERT_TRUE(checkpointUnpackCompact(word, &decoded));
+  TEST_ASSERT_EQUAL_UINT32(180000, decoded.whiteMs);
+  TEST_ASSERT_EQUAL_UINT32(59990, decoded.blackMs);
+  TEST_ASSERT_EQUAL_UINT16(321, decoded.plies);
+  TEST_ASSERT_EQUAL_UINT8(1, decoded.activeSide);
+  TEST_ASSERT_FALSE(checkpointUnpackCompact(0, &decoded));
+}
+
+static void test_newer_slot_wins_across_the_wrap() {
+  GameSnapshot selected;
+  TEST_ASSERT_TRUE(CheckpointSource::NONE == checkpointSelect(model.slots[0], model.slots[1], 0, &selected));
+
+  model.sequence = 0xFFFE;
+  model.save(makeSnapshot(STATE_WHITE_RUNNING, 0, 40, 1000, 2000), false);
+  model.save(makeSnapshot(STATE_WHITE_RUNNING, 1, 41, 900, 2000), false);
+  model.save(makeSnapshot(STATE_WHITE_RUNNING, 0, 42, 900, 1900), false);   // Sequence 1
+  TEST_ASSERT_TRUE(CheckpointSource::RTC == checkpointSelect(model.slots[0], model.slots[1], 0, &selected));
+  TEST_ASSERT_EQUAL_UINT16(42, selected.plies);
+  TEST_ASSERT_EQUAL_UINT16(1, selected.sequence);
+}
+
+static void test_ended_game_is_not_resumed_from_flash() {
+  GameSnapshot running = makeSnapshot(STATE_PAUSE, 0, 10, 60000, 50000);
+  model.save(running, true);
+  model.flashWriter();
+  model.clear();
+
+  // Reset before the flash writer erased the copy
+  GameSnapshot selected;
+  TEST_ASSERT_TRUE(model.flash != 0);
+  TEST_ASSERT_TRUE(CheckpointSource::ENDED == model.restore(&selected));
+  TEST_ASSERT_EQUAL_UINT64(0, model.flash);
+
+  // The next game continues the sequence and beats the ended snapshots
+  model.save(makeSnapshot(STATE_WHITE_RUNNING, 0, 0, 300000, 300000), false);
+  TEST_ASSERT_TRUE(CheckpointSource::RTC == model.restore(&selected));
+  TEST_ASSERT_EQUAL_UINT32(300000, selected.whiteMs);
+}
+
+static void test_power_loss_falls_back_to_the_flash_copy() {
+  GameSnapshot paused = makeSnapshot(STATE_PAUSE, 1, 33, 123450, 98760);
+  model.save(paused, true);
+  model.flashWriter();
+  model.save(makeSnapshot(STATE_WHITE_RUNNING, 1, 34, 120000, 98760), false);
+
+  // RTC memory is lost, the flash copy is the last one written
+  memset(model.slots, 0xA5, sizeof(model.slots));
+  GameSnapshot selected;
+  TEST_ASSERT_TRUE(CheckpointSource::FLASH == model.restore(&selected));
+  TEST_ASSERT_EQUAL_UINT16(33, selected.plies);
+  TEST_ASSERT_EQUAL_UINT32(123450, selected.whiteMs);
+}
+
+static void test_random_resets_never_lose_or_resurrect_a_game() {
+  std::mt19937 random(2024);
+  uint32_t resets = 0;
+  uint32_t torn = 0;
+  uint32_t endedResets = 0;
+  bool gameRunning = false;
+  GameSnapshot game = {};
+
+  for (uint32_t step = 0; step < 200000; step++) {
+    uint32_t action = random() % 100;
+    GameSnapshot before;
+    CheckpointSource beforeSource = checkpointSelect(model.slots[0], model.slots[1], model.flash, &before);
+
+    if (action < 60) {
+      // Press or periodic refresh, torn by a reset one time in ten
+      if (!gameRunning) {
+        game = makeSnapshot(STATE_WHITE_RUNNING, 0, 0, 300000, 300000);
+        gameRunning = true;
+      }
+      game.activeSide ^= 1;
+      game.plies = (uint16_t)((game.plies + 1) & 0x3FF);
+      game.whiteMs = game.whiteMs > 1000 ? game.whiteMs - random() % 1000 : 300000;
+      game.state = random() % 8 == 0 ? STATE_PAUSE : STATE_WHITE_RUNNING;
+      bool tear = random() % 10 == 0;
+      int tornWords = tear ? (int)(random() % 4) : -1;
+      model.save(game, random() % 2 == 0, tornWords);
+      if (!tear) {
+        continue;
+      }
+
+      resets++;
+      torn += tornWords > 0;
+      GameSnapshot selected;
+      CheckpointSource source = model.restore(&selected);
+      bool isNew = source == CheckpointSource::RTC && sameGame(selected, game);
+      bool isOld = source == beforeSource && (source == CheckpointSource::NONE || sameGame(selected, before) ||
+                                              source == CheckpointSource::ENDED);
+      if (!isNew && !isOld) {
+        char line[96];
+        snprintf(line, sizeof(line), "step %u: torn write after %d words lost the game", (unsigned)step, tornWords);
+        TEST_FAIL_MESSAGE(line);
+      }
+      gameRunning = source == CheckpointSource::RTC || source == CheckpointSource::FLASH;
+      if (gameRunning) {
+        game = selected;
+      }
+    } else if (action < 65 && gameRunning) {
+      // The game ends, a reset may hit either slot write
+      bool tear = random() % 2 == 0;
+      int tornSlot = tear ? (int)(random() % 2) : -1;
+      model.clear(tornSlot, (int)(random() % 4));
+      gameRunning = false;
+      if (!tear) {
+        continue;
+      }
+
+      resets++;
+      GameSnapshot selected;
+      CheckpointSource source = model.restore(&selected);
+      if (tornSlot == 1) {
+        // The first slot already says the game ended, the flash copy is never used
+        TEST_ASSERT_TRUE(CheckpointSource::ENDED == source);
+        endedResets++;
+      } else {
+        // Torn before the first slot was complete: the last snapshot of the game
+        TEST_ASSERT_TRUE(CheckpointSource::RTC == source);
+        TEST_ASSERT_TRUE(sameGame(selected, before));
+        gameRunning = true;
+        game = selected;
+      }
+    } else if (action < 95) {
+      model.flashWriter();
+    } else {
+      // Reset between two writes: the last snapshot, or the end of the game
+      resets++;
+      GameSnapshot selected;
+      CheckpointSource source = model.restore(&selected);
+      if (gameRunning) {
+        TEST_ASSERT_TRUE(CheckpointSource::RTC == source);
+        TEST_ASSERT_TRUE(sameGame(selected, game));
+      } else {
+        TEST_ASSERT_TRUE(CheckpointSource::RTC != source && CheckpointSource::FLASH != source);
+        endedResets += source == CheckpointSource::ENDED;
+      }
+    }
+  }
+
+  char line[96];
+  snprintf(line, sizeof(line), "%u resets, %u torn slot writes, %u after a game ended", (unsigned)resets,
+           (unsigned)torn, (unsigned)endedResets);
+  TEST_MESSAGE(line);
+  TEST_ASSERT_GREATER_THAN(1000, endedResets);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_full_snapshot_round_trip);
+  RUN_TEST(test_compact_snapshot_keeps_centiseconds);
+  RUN_TEST(test_newer_slot_wins_across_the_wrap);
+  RUN_TEST(test_ended_game_is_not_resumed_from_flash);
+  RUN_TEST(test_power_loss_falls_back_to_the_flash_copy);
+  RUN_TEST(test_random_resets_never_lose_or_resurrect_a_game);
+  return UNITY_END();
+}
@@ -0,0 +1,97 @@
+/*
+  Host tests of the game record (game_record.h) and its text format,
+  which is what the result QR code encodes.
+*/
+
+#include <unity.h>
+#include <string.h>
+#include "game_record.h"
+
+static GameRecord record;
+
+void setUp() {
+  memset(&record, 0, sizeof(record));
+  gameRecordReset(record, 1);   // Blitz 3+2
+  strcpy(record.whiteName, "Anna Weiss");
+  strcpy(record.blackName, "Bernd Schwarz");
+}
+
+void tearDown() {
+}
+
+static void test_empty_record_serializes_header_only() {
+  char text[128];
+  size_t length = gameRecordSerialize(record, text, sizeof(text));
+  TEST_ASSERT_EQUAL_STRING("CC1;W=Anna Weiss;B=Bernd Schwarz;R=*;TC=180+2;T=", text);
+  TEST_ASSERT_EQUAL_size_t(strlen(text), length);
+}
+
+static void test_move_times_are_rounded_to_tenths() {
+  gameRecordAddMove(record, 1049);
+  gameRecordAddMove(record, 1050);
+  gameRecordAddMove(record, 0);
+  gameRecordSetResult(record, GameResult::BLACK_WINS);
+  char text[128];
+  gameRecordSerialize(record, text, sizeof(text));
+  TEST_ASSERT_EQUAL_STRING("CC1;W=Anna Weiss;B=Bernd Schwarz;R=0-1;TC=180+2;T=10,11,0", text);
+}
+
+static void test_cut_move_list_ends_with_a_marker() {
+  for (int i = 0; i < 20; i++) {
+    gameRecordAddMove(record, 12300);
+  }
+  char text[70];
+  size_t length = gameRecordSerialize(record, text, sizeof(text));
+  TEST_ASSERT_TRUE(length < sizeof(text));
+  TEST_ASSERT_EQUAL_size_t(strlen(text), length);
+  TEST_ASSERT_EQUAL_CHAR('~', text[length - 1]);
+  TEST_ASSERT_EQUAL_INT(0, strncmp(text, "CC1;W=Anna Weiss;B=Bernd Schwarz;R=*;TC=180+2;T=123,123", 55));
+}
+
+static void test_too_small_buffer_is_terminated() {
+  char text[10];
+  size_t length = gameRecordSerialize(record, text, sizeof(text));
+  TEST_ASSERT_EQUAL_size_t(9, length);
+  TEST_ASSERT_EQUAL_STRING("CC1;W=Ann", text);
+  TEST_ASSERT_EQUAL_size_t(0, gameRecordSerialize(record, text, 0));
+}
+
+static void test_full_record_rejects_more_moves() {
+  for (int i = 0; i < GAME_MAX_PLIES; i++) {
+    TEST_ASSERT_TRUE(gameRecordAddMove(record, 1000));
+  }
+  TEST_ASSERT_FALSE(gameRecordAddMove(record, 1000));
+  TEST_ASSERT_EQUAL_UINT16(GAME_MAX_PLIES, record.plyCount);
+}
+
+static void test_every_change_moves_the_revision() {
+  // The QR code is only encoded again when the revision changed
+  uint32_t revision = record.revision;
+  gameRecordAddMove(record, 500);
+  TEST_ASSERT_TRUE(record.revision != revision);
+  revision = record.revision;
+  gameRecordSetResult(record, GameResult::DRAW);
+  TEST_ASSERT_TRUE(record.revision != revision);
+  revision = record.revision;
+  gameRecordReset(record, 0);
+  TEST_ASSERT_TRUE(record.revision != revision);
+}
+
+static void test_results_use_pgn_notation() {
+  TEST_ASSERT_EQUAL_STRING("1-0", gameResultToString(GameResult::WHITE_WINS));
+  TEST_ASSERT_EQUAL_STRING("0-1", gameResultToString(GameResult::BLACK_WINS));
+  TEST_ASSERT_EQUAL_STRING("1/2-1/2", gameResultToString(GameResult::DRAW));
+  TEST_ASSERT_EQUAL_STRING("*", gameResultToString(GameResult::UNDECIDED));
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_empty_record_serializes_header_only);
+  RUN_TEST(test_move_times_are_rounded_to_tenths);
+  RUN_TEST(test_cut_move_list_ends_with_a_marker);
+  RUN_TEST(test_too_small_buffer_is_terminated);
+  RUN_TEST(test_full_record_rejects_more_moves);
+  RUN_TEST(test_every_change_moves_the_revision);
+  RUN_TEST(test_results_use_pgn_notation);
+  return UNITY_END();
+}
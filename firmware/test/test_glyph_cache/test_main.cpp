@@ -0,0 +1,311 @@
+/*
+  Host tests of the glyph cache (glyph_cache.h) and the vlw font loader
+  (vlw_font.h) with a font file built in memory, and a simulation of the
+  player list that compares the bytes read from the font file with and
+  without the cache.
+*/
+
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "glyph_cache.h"
+#include "vlw_font.h"
+
+struct FontFile {
+  std::vector<uint8_t> bytes;
+  uint32_t reads;
+  uint32_t bytesRead;
+};
+
+static void putBigEndian(std::vector<uint8_t>& out, uint32_t value) {
+  out.push_back((uint8_t)(value >> 24));
+  out.push_back((uint8_t)(value >> 16));
+  out.push_back((uint8_t)(value >> 8));
+  out.push_back((uint8_t)value);
+}
+
+struct GlyphSpec {
+  uint32_t codepoint;
+  uint8_t width;
+  uint8_t height;
+  uint8_t xAdvance;
+};
+
+// vlw layout: 24 byte header, 28 bytes of metrics per glyph, then the bitmaps
+static void buildFont(FontFile* file, const std::vector<GlyphSpec>& glyphs) {
+  std::vector<uint8_t>& out = file->bytes;
+  out.clear();
+  putBigEndian(out, (uint32_t)glyphs.size());
+  putBigEndian(out, 11);          // Version
+  putBigEndian(out, 20);          // Point size
+  putBigEndian(out, 0);
+  putBigEndian(out, 16);          // Ascent
+  putBigEndian(out, 4);           // Descent
+  for (const GlyphSpec& glyph : glyphs) {
+    putBigEndian(out, glyph.codepoint);
+    putBigEndian(out, glyph.height);
+    putBigEndian(out, glyph.width);
+    putBigEndian(out, glyph.xAdvance);
+    putBigEndian(out, glyph.height);   // dY: bitmap sits on the baseline
+    putBigEndian(out, 0);              // dX
+    putBigEndian(out, 0);
+  }
+  for (const GlyphSpec& glyph : glyphs) {
+    for (uint32_t i = 0; i < (uint32_t)glyph.width * glyph.height; i++) {
+      out.push_back((uint8_t)(glyph.codepoint + i));
+    }
+  }
+  file->reads = 0;
+  file->bytesRead = 0;
+}
+
+static bool readFont(void* context, uint32_t offset, uint8_t* target, uint32_t length) {
+  FontFile* file = (FontFile*)context;
+  if (offset + length > file->bytes.size()) {
+    return false;
+  }
+  memcpy(target, file->bytes.data() + offset, length);
+  file->reads++;
+  file->bytesRead += length;
+  return true;
+}
+
+// Printable ASCII and the German umlauts, advance depends on the character
+static std::vector<GlyphSpec> latinGlyphs() {
+  std::vector<GlyphSpec> glyphs;
+  for (uint32_t c = 0x21; c < 0x7F; c++) {
+    glyphs.push_back({ c, (uint8_t)(6 + c % 5), 14, (uint8_t)(7 + c % 6) });
+  }
+  const uint32_t umlauts[] = { 0xC4, 0xD6, 0xDC, 0xDF, 0xE4, 0xF6, 0xFC };
+  for (uint32_t c : umlauts) {
+    glyphs.push_back({ c, 8, 16, 9 });
+  }
+  return glyphs;
+}
+
+static FontFile file;
+static VlwFont font;
+static VlwGlyph metrics[256];
+static uint8_t cacheMemory[64 * 1024];
+static uint8_t scratch[1024];
+static GlyphCache cache;
+
+void setUp() {
+  buildFont(&file, latinGlyphs());
+  TEST_ASSERT_TRUE(font.load(readFont, &file, 3, metrics, 256));
+  TEST_ASSERT_TRUE(cache.begin(cacheMemory, sizeof(cacheMemory), font.maxBitmapBytes()));
+  cache.resetStats();
+  file.reads = 0;
+  file.bytesRead = 0;
+}
+
+void tearDown() {
+}
+
+static void test_font_loads_sorted_metrics() {
+  TEST_ASSERT_EQUAL_UINT16(94 + 7, font.glyphCount());
+  TEST_ASSERT_EQUAL_INT16(16, font.ascent());
+  const VlwGlyph* glyph = font.find('A');
+  TEST_ASSERT_NOT_NULL(glyph);
+  TEST_ASSERT_EQUAL_UINT16('A', glyph->codepoint);
+  TEST_ASSERT_EQUAL_UINT8(7 + 'A' % 6, glyph->xAdvance);
+  TEST_ASSERT_NOT_NULL(font.find(0xFC));
+  TEST_ASSERT_NULL(font.find(' '));
+}
+
+static void test_glyphs_beyond_the_bmp_are_skipped() {
+  std::vector<GlyphSpec> glyphs = { { 'A', 4, 4, 5 }, { 0x1F600, 6, 6, 20 }, { 0xF600, 5, 5, 11 } };
+  buildFont(&file, glyphs);
+  TEST_ASSERT_TRUE(font.load(readFont, &file, 4, metrics, 256));
+  TEST_ASSERT_EQUAL_UINT16(2, font.glyphCount());
+
+  // The truncated code point must not replace the real U+F600
+  const VlwGlyph* glyph = font.find(0xF600);
+  TEST_ASSERT_NOT_NULL(glyph);
+  TEST_ASSERT_EQUAL_UINT8(11, glyph->xAdvance);
+  TEST_ASSERT_NULL(font.find(0x1F600));
+
+  // The bitmap of U+F600 comes after the skipped glyph's bitmap
+  uint8_t bitmap[25];
+  TEST_ASSERT_TRUE(font.readBitmap(*glyph, bitmap));
+  TEST_ASSERT_EQUAL_UINT8((uint8_t)0xF600, bitmap[0]);
+
+  // A 4 byte UTF-8 sequence takes the advance of a missing glyph
+  TEST_ASSERT_TRUE(cache.begin(cacheMemory, sizeof(cacheMemory), font.maxBitmapBytes()));
+  TEST_ASSERT_EQUAL_INT32(font.spaceWidth(), cache.textWidth(font, "\xF0\x9F\x98\x80"));
+}
+
+static void test_utf8_decoding() {
+  const char* text = "A\xC3\xA4\xE2\x82\xAC\xF0\x9F\x98\x80\xC3";
+  TEST_ASSERT_EQUAL_UINT32('A', GlyphCache::nextCodepoint(&text));
+  TEST_ASSERT_EQUAL_UINT32(0xE4, GlyphCache::nextCodepoint(&text));
+  TEST_ASSERT_EQUAL_UINT32(0x20AC, GlyphCache::nextCodepoint(&text));
+  TEST_ASSERT_EQUAL_UINT32(0x1F600, GlyphCache::nextCodepoint(&text));
+  TEST_ASSERT_EQUAL_UINT32(0xFFFD, GlyphCache::nextCodepoint(&text));   // Truncated
+  TEST_ASSERT_EQUAL_UINT32(0, GlyphCache::nextCodepoint(&text));
+}
+
+static void test_bitmap_is_read_once() {
+  const VlwGlyph* glyph = font.find('g');
+  const uint8_t* first = cache.bitmap(font, *glyph, scratch);
+  TEST_ASSERT_NOT_NULL(first);
+  TEST_ASSERT_EQUAL_UINT8((uint8_t)'g', first[0]);
+  uint32_t reads = file.reads;
+  const uint8_t* second = cache.bitmap(font, *glyph, scratch);
+  TEST_ASSERT_EQUAL_PTR(first, second);
+  TEST_ASSERT_EQUAL_UINT32(reads, file.reads);
+  TEST_ASSERT_EQUAL_UINT32(1, cache.stats().hits);
+  TEST_ASSERT_EQUAL_UINT32(1, cache.stats().misses);
+}
+
+static void test_least_recently_used_glyph_is_evicted() {
+  // Room for three slots only: entry (12 bytes), bitmap and two bucket heads
+  size_t perSlot = 12 + font.maxBitmapBytes() + 4;
+  TEST_ASSERT_TRUE(cache.begin(cacheMemory, 3 * perSlot + 2, font.maxBitmapBytes()));
+  TEST_ASSERT_EQUAL_UINT16(3, cache.slotCount());
+
+  cache.bitmap(font, *font.find('a'), scratch);
+  cache.bitmap(font, *font.find('b'), scratch);
+  cache.bitmap(font, *font.find('c'), scratch);
+  cache.bitmap(font, *font.find('a'), scratch);   // b is the oldest now
+  cache.bitmap(font, *font.find('d'), scratch);
+  TEST_ASSERT_EQUAL_UINT32(1, cache.stats().evictions);
+
+  uint32_t misses = cache.stats().misses;
+  cache.bitmap(font, *font.find('a'), scratch);
+  cache.bitmap(font, *font.find('c'), scratch);
+  TEST_ASSERT_EQUAL_UINT32(misses, cache.stats().misses);
+  const uint8_t* b = cache.bitmap(font, *font.find('b'), scratch);
+  TEST_ASSERT_EQUAL_UINT32(misses + 1, cache.stats().misses);
+  TEST_ASSERT_EQUAL_UINT8((uint8_t)'b', b[0]);
+}
+
+static void test_text_width_is_cached() {
+  int32_t width = cache.textWidth(font, "M\xC3\xBCller");
+  int32_t expected = font.find('M')->xAdvance + font.find(0xFC)->xAdvance + 2 * font.find('l')->xAdvance +
+                     font.find('e')->xAdvance + font.find('r')->xAdvance;
+  TEST_ASSERT_EQUAL_INT32(expected, width);
+  TEST_ASSERT_EQUAL_INT32(expected, cache.textWidth(font, "M\xC3\xBCller"));
+  TEST_ASSERT_EQUAL_UINT32(1, cache.stats().widthHits);
+  TEST_ASSERT_EQUAL_UINT32(1, cache.stats().widthMisses);
+}
+
+static uint32_t widthHash(uint8_t fontId, const std::string& text) {
+  uint32_t hash = 2166136261u ^ fontId;
+  hash *= 16777619u;
+  for (char c : text) {
+    hash ^= (uint8_t)c;
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+static void test_colliding_hashes_keep_their_own_width() {
+  // Birthday search for two names with the same 32-bit hash
+  std::unordered_map<uint32_t, std::string> seen;
+  std::string first;
+  std::string second;
+  const char letters[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+  for (uint32_t n = 0; first.empty(); n++) {
+    std::string name;
+    for (uint32_t value = n; name.size() < 6; value /= 52) {
+      name += letters[value % 52];
+    }
+    uint32_t hash = widthHash(font.id(), name);
+    auto found = seen.find(hash);
+    if (found != seen.end()) {
+      first = found->second;
+      second = name;
+    } else {
+      seen.emplace(hash, name);
+    }
+  }
+
+  int32_t firstWidth = cache.textWidth(font, first.c_str());
+  int32_t secondWidth = cache.textWidth(font, second.c_str());
+  cache.resetStats();
+  GlyphCache uncached;
+  TEST_ASSERT_EQUAL_INT32(uncached.textWidth(font, second.c_str()), secondWidth);
+  TEST_ASSERT_EQUAL_INT32(uncached.textWidth(font, first.c_str()), firstWidth);
+  TEST_ASSERT_EQUAL_INT32(firstWidth, cache.textWidth(font, first.c_str()));
+  TEST_ASSERT_EQUAL_UINT32(1, cache.stats().widthCollisions);
+}
+
+static void test_long_text_is_measured_every_time() {
+  std::string name(GLYPH_CACHE_WIDTH_TEXT + 10, 'x');
+  int32_t width = cache.textWidth(font, name.c_str());
+  TEST_ASSERT_EQUAL_INT32(width, cache.textWidth(font, name.c_str()));
+  TEST_ASSERT_EQUAL_UINT32(0, cache.stats().widthHits);
+  TEST_ASSERT_EQUAL_UINT32(2, cache.stats().widthMisses);
+}
+
+static void test_draw_text_blends_into_the_buffer() {
+  static uint16_t buffer[100 * 24];
+  for (uint16_t& pixel : buffer) {
+    pixel = 0;
+  }
+  int32_t end = cache.drawText(font, "Hi", 2, 0, buffer, 100, 24, 0xFFFF, 0x0000, scratch);
+  TEST_ASSERT_EQUAL_INT32(2 + font.find('H')->xAdvance + font.find('i')->xAdvance, end);
+
+  uint32_t written = 0;
+  for (uint16_t pixel : buffer) {
+    written += pixel != 0;
+  }
+  TEST_ASSERT_GREATER_THAN(50, written);
+
+  // Clipped at the buffer edge, nothing written outside
+  int32_t clipped = cache.drawText(font, "WWW", 95, 0, buffer, 100, 24, 0xFFFF, 0x0000, scratch);
+  TEST_ASSERT_GREATER_THAN(100, clipped);
+}
+
+// Player list: 12 visible rows of 200 names scrolled one row per frame
+static uint32_t renderList(GlyphCache* glyphs, uint32_t frames) {
+  static const char* first[] = { "Anna", "J\xC3\xBCrgen", "Max", "S\xC3\xB6ren", "Lea", "Bj\xC3\xB6rn", "Eva",
+                                 "Tom" };
+  static const char* last[] = { "M\xC3\xBCller", "Schmidt", "Schneider", "Fischer", "Wei\xC3\x9F", "Becker",
+                                "Hoffmann", "Sch\xC3\xA4" "fer", "Koch", "Richter" };
+  static uint16_t row[240 * 24];
+  char name[64];
+  file.bytesRead = 0;
+  for (uint32_t frame = 0; frame < frames; frame++) {
+    for (uint32_t line = 0; line < 12; line++) {
+      uint32_t index = (frame + line) % 200;
+      snprintf(name, sizeof(name), "%s %s", first[index % 8], last[index % 10]);
+      int32_t x = (240 - glyphs->textWidth(font, name)) / 2;
+      glyphs->drawText(font, name, x, 0, row, 240, 24, 0xFFFF, 0x0000, scratch);
+    }
+  }
+  return file.bytesRead;
+}
+
+static void test_list_render_reads_the_font_far_less_with_the_cache() {
+  GlyphCache uncached;   // No slots: every glyph is read from the file
+  uint32_t uncachedBytes = renderList(&uncached, 400);
+  uint32_t cachedBytes = renderList(&cache, 400);
+
+  char line[96];
+  snprintf(line, sizeof(line), "font bytes read: %u uncached, %u cached (%ux less), %u%% width hits",
+           (unsigned)uncachedBytes, (unsigned)cachedBytes, (unsigned)(uncachedBytes / (cachedBytes > 0 ? cachedBytes : 1)),
+           (unsigned)(cache.stats().widthHits * 100 / (cache.stats().widthHits + cache.stats().widthMisses)));
+  TEST_MESSAGE(line);
+  TEST_ASSERT_LESS_THAN(uncachedBytes / 100, cachedBytes);
+  TEST_ASSERT_EQUAL_UINT32(0, cache.stats().evictions);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_font_loads_sorted_metrics);
+  RUN_TEST(test_glyphs_beyond_the_bmp_are_skipped);
+  RUN_TEST(test_utf8_decoding);
+  RUN_TEST(test_bitmap_is_read_once);
+  RUN_TEST(test_least_recently_used_glyph_is_evicted);
+  RUN_TEST(test_text_width_is_cached);
+  RUN_TEST(test_colliding_hashes_keep_their_own_width);
+  RUN_TEST(test_long_text_is_measured_every_time);
+  RUN_TEST(test_draw_text_blends_into_the_buffer);
+  RUN_TEST(test_list_render_reads_the_font_far_less_with_the_cache);
+  return UNITY_END();
+}
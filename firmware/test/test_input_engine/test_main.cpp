@@ -0,0 +1,205 @@
+/*
+  Host tests of the debounce in the input engine (input_engine.h) with
+  recorded-like bounce traces of the rocker and the button
+*/
+
+#include <unity.h>
+#include "config.h"
+#include "input_engine.h"
+
+static const uint32_t LOCKOUT_US = 20000;
+static const uint32_t RESOLVE_US = 2000;
+
+struct Edge {
+  int64_t timestampUs;
+  ClockEventType type;
+};
+
+static InputEngine engine;
+
+void setUp() {
+  engine.reset(LOCKOUT_US, LOCKOUT_US, RESOLVE_US);
+}
+
+void tearDown() {
+  engine.reset(0, 0, 0);
+}
+
+static void pushAll(const Edge* edges, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    ClockEvent* event = clockEventPool.acquire();
+    TEST_ASSERT_NOT_NULL(event);
+    event->type = edges[i].type;
+    event->timestampUs = edges[i].timestampUs;
+    engine.push(event);
+  }
+}
+
+// Pops everything that is due, returns the number of events
+static size_t popAll(int64_t nowUs, Edge* out, size_t capacity) {
+  size_t count = 0;
+  ClockEvent* event;
+  while ((event = engine.pop(nowUs)) != nullptr) {
+    TEST_ASSERT_LESS_THAN(capacity, count);
+    out[count].timestampUs = event->timestampUs;
+    out[count].type = event->type;
+    count++;
+    clockEventPool.release(event);
+  }
+  return count;
+}
+
+static void test_bounce_after_a_change_is_ignored() {
+  const Edge trace[] = {
+    { 100000, ClockEventType::ROCKER_BLACK },
+    { 100040, ClockEventType::ROCKER_WHITE },
+    { 100090, ClockEventType::ROCKER_BLACK },
+    { 100350, ClockEventType::ROCKER_WHITE },
+    { 100400, ClockEventType::ROCKER_BLACK },
+  };
+  pushAll(trace, 5);
+
+  Edge out[4];
+  TEST_ASSERT_EQUAL_size_t(1, popAll(200000, out, 4));
+  TEST_ASSERT_EQUAL_INT64(100000, out[0].timestampUs);
+  TEST_ASSERT_TRUE(out[0].type == ClockEventType::ROCKER_BLACK);
+  TEST_ASSERT_EQUAL_UINT32(4, engine.stats().rockerBounces);
+}
+
+static void test_same_level_edge_after_the_lockout_is_ignored() {
+  const Edge trace[] = {
+    { 100000, ClockEventType::ROCKER_BLACK },
+    { 150000, ClockEventType::ROCKER_BLACK },   // The edge back in between was lost
+    { 300000, ClockEventType::ROCKER_WHITE },
+  };
+  pushAll(trace, 3);
+
+  Edge out[4];
+  TEST_ASSERT_EQUAL_size_t(2, popAll(400000, out, 4));
+  TEST_ASSERT_TRUE(out[0].type == ClockEventType::ROCKER_BLACK);
+  TEST_ASSERT_TRUE(out[1].type == ClockEventType::ROCKER_WHITE);
+  TEST_ASSERT_EQUAL_INT64(300000, out[1].timestampUs);
+}
+
+static void test_change_after_the_lockout_is_accepted() {
+  const Edge trace[] = {
+    { 100000, ClockEventType::ROCKER_BLACK },
+    { 100000 + LOCKOUT_US, ClockEventType::ROCKER_WHITE },
+  };
+  pushAll(trace, 2);
+
+  Edge out[4];
+  TEST_ASSERT_EQUAL_size_t(2, popAll(200000, out, 4));
+  TEST_ASSERT_EQUAL_INT64(100000 + LOCKOUT_US, out[1].timestampUs);
+}
+
+static void test_pin_is_read_back_at_the_end_of_the_lockout() {
+  const Edge trace[] = { { 100000, ClockEventType::ROCKER_BLACK } };
+  pushAll(trace, 1);
+  TEST_ASSERT_EQUAL_INT64(100000 + LOCKOUT_US, engine.nextCheckUs());
+
+  // Too early, nothing happens
+  engine.check(100000 + LOCKOUT_US - 1, true, true);
+  TEST_ASSERT_EQUAL_INT64(100000 + LOCKOUT_US, engine.nextCheckUs());
+
+  // Still on black's side
+  engine.check(100000 + LOCKOUT_US, false, true);
+  TEST_ASSERT_EQUAL_INT64(INT64_MAX, engine.nextCheckUs());
+  Edge out[4];
+  TEST_ASSERT_EQUAL_size_t(1, popAll(200000, out, 4));
+  TEST_ASSERT_EQUAL_UINT32(0, engine.stats().confirmed);
+}
+
+static void test_short_tap_inside_the_lockout_is_not_lost() {
+  // Pressed and released within 6 ms, the release bounces as well
+  const Edge trace[] = {
+    { 100000, ClockEventType::BUTTON_PRESSED },
+    { 100030, ClockEventType::BUTTON_RELEASED },
+    { 100060, ClockEventType::BUTTON_PRESSED },
+    { 106000, ClockEventType::BUTTON_RELEASED },
+    { 106020, ClockEventType::BUTTON_PRESSED },
+    { 106050, ClockEventType::BUTTON_RELEASED },
+  };
+  pushAll(trace, 6);
+  Edge out[4];
+  TEST_ASSERT_EQUAL_size_t(1, popAll(110000, out, 4));
+  TEST_ASSERT_TRUE(out[0].type == ClockEventType::BUTTON_PRESSED);
+
+  // Button is active low, the pin is high again
+  engine.check(100000 + LOCKOUT_US, true, true);
+  TEST_ASSERT_EQUAL_size_t(1, popAll(100000 + LOCKOUT_US, out, 4));
+  TEST_ASSERT_TRUE(out[0].type == ClockEventType::BUTTON_RELEASED);
+  TEST_ASSERT_EQUAL_INT64(106050, out[0].timestampUs);
+  TEST_ASSERT_EQUAL_UINT32(1, engine.stats().confirmed);
+
+  // The release has its own lockout that is read back again
+  TEST_ASSERT_EQUAL_INT64(106050 + LOCKOUT_US, engine.nextCheckUs());
+  engine.check(106050 + LOCKOUT_US, true, true);
+  TEST_ASSERT_EQUAL_INT64(INT64_MAX, engine.nextCheckUs());
+}
+
+static void test_lost_edge_is_dated_to_the_end_of_the_lockout() {
+  const Edge trace[] = { { 100000, ClockEventType::ROCKER_WHITE } };
+  pushAll(trace, 1);
+  Edge out[4];
+  popAll(200000, out, 4);
+
+  engine.check(130000, false, true);
+  TEST_ASSERT_EQUAL_size_t(1, popAll(200000, out, 4));
+  TEST_ASSERT_TRUE(out[0].type == ClockEventType::ROCKER_BLACK);
+  TEST_ASSERT_EQUAL_INT64(100000 + LOCKOUT_US, out[0].timestampUs);
+
+  // The real edge arrives late and is the level that is already accepted
+  const Edge late[] = { { 125000, ClockEventType::ROCKER_BLACK } };
+  pushAll(late, 1);
+  TEST_ASSERT_EQUAL_size_t(0, popAll(200000, out, 4));
+}
+
+static void test_confirmed_change_is_rechecked_in_its_own_lockout() {
+  const Edge trace[] = {
+    { 100000, ClockEventType::ROCKER_WHITE },
+    { 119000, ClockEventType::ROCKER_BLACK },   // Inside the lockout
+  };
+  pushAll(trace, 2);
+  engine.check(100000 + LOCKOUT_US, false, true);
+  TEST_ASSERT_EQUAL_INT64(119000 + LOCKOUT_US, engine.nextCheckUs());
+
+  // Back to white inside the new lockout, only the pin tells
+  engine.check(119000 + LOCKOUT_US, true, true);
+  Edge out[4];
+  TEST_ASSERT_EQUAL_size_t(3, popAll(200000, out, 4));
+  TEST_ASSERT_TRUE(out[0].type == ClockEventType::ROCKER_WHITE);
+  TEST_ASSERT_TRUE(out[1].type == ClockEventType::ROCKER_BLACK);
+  TEST_ASSERT_EQUAL_INT64(119000, out[1].timestampUs);
+  TEST_ASSERT_TRUE(out[2].type == ClockEventType::ROCKER_WHITE);
+  TEST_ASSERT_EQUAL_INT64(119000 + LOCKOUT_US, out[2].timestampUs);
+}
+
+static void test_rocker_and_button_are_independent() {
+  const Edge trace[] = {
+    { 100000, ClockEventType::ROCKER_BLACK },
+    { 100500, ClockEventType::BUTTON_PRESSED },
+    { 100600, ClockEventType::ROCKER_WHITE },
+    { 100700, ClockEventType::BUTTON_RELEASED },
+  };
+  pushAll(trace, 4);
+  Edge out[4];
+  TEST_ASSERT_EQUAL_size_t(2, popAll(200000, out, 4));
+  TEST_ASSERT_TRUE(out[0].type == ClockEventType::ROCKER_BLACK);
+  TEST_ASSERT_TRUE(out[1].type == ClockEventType::BUTTON_PRESSED);
+  TEST_ASSERT_EQUAL_UINT32(1, engine.stats().rockerBounces);
+  TEST_ASSERT_EQUAL_UINT32(1, engine.stats().buttonBounces);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_bounce_after_a_change_is_ignored);
+  RUN_TEST(test_same_level_edge_after_the_lockout_is_ignored);
+  RUN_TEST(test_change_after_the_lockout_is_accepted);
+  RUN_TEST(test_pin_is_read_back_at_the_end_of_the_lockout);
+  RUN_TEST(test_short_tap_inside_the_lockout_is_not_lost);
+  RUN_TEST(test_lost_edge_is_dated_to_the_end_of_the_lockout);
+  RUN_TEST(test_confirmed_change_is_rechecked_in_its_own_lockout);
+  RUN_TEST(test_rocker_and_button_are_independent);
+  return UNITY_END();
+}
@@ -0,0 +1,222 @@
+/*
+  Host tests of the scalar pixel kernels (pixel_kernels.h), which are the
+  reference of the vector ones: exhaustive checks against the channel
+  formula, a lane by lane model of the PIE blend loop that has to give
+  the same results, and a time-per-pixel benchmark at 320x240 (the
+  cycles per pixel on the device are printed by pixelsPrintBenchmark()).
+*/
+
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+#include <vector>
+#include "pixel_kernels.h"
+
+#define FRAME_PIXELS (320 * 240)
+#define GUARD 0xA5A5
+
+static uint16_t swapped(uint16_t value) {
+  return (uint16_t)((value << 8) | (value >> 8));
+}
+
+// The documented formula, one channel at a time
+static uint16_t blendReference(uint16_t pixel, uint16_t color, uint8_t alpha) {
+  uint32_t w = (alpha + 4) >> 3;
+  uint32_t r = ((color >> 11) * w + (pixel >> 11) * (32 - w)) >> 5;
+  uint32_t g = (((color >> 5) & 0x3F) * w + ((pixel >> 5) & 0x3F) * (32 - w)) >> 5;
+  uint32_t b = ((color & 0x1F) * w + (pixel & 0x1F) * (32 - w)) >> 5;
+  return (uint16_t)((r << 11) | (g << 5) | b);
+}
+
+// Lane operations of the PIE instructions used by blendBlocks()
+static uint16_t vmul(uint16_t a, uint16_t b, uint8_t sar) {
+  return (uint16_t)(((uint32_t)a * b) >> sar);   // ee.vmul.u16
+}
+
+static uint16_t vadds(uint16_t a, uint16_t b) {
+  int32_t sum = (int16_t)a + (int16_t)b;         // ee.vadds.s16
+  return (uint16_t)(sum > 32767 ? 32767 : (sum < -32768 ? -32768 : sum));
+}
+
+// One lane of the blendBlocks() loop, instruction by instruction
+static uint16_t blendLane(uint16_t source, uint16_t color, uint8_t alpha) {
+  uint16_t weight = (alpha + 4) >> 3;
+  uint16_t inverse = (uint16_t)(32 - weight);
+  uint16_t pixel = (uint16_t)(vmul(source, 1, 8) | vmul(source, 256, 0));
+
+  uint16_t red = vmul(pixel, 1, 11);
+  red = vmul(red, inverse, 0);
+  red = vadds(red, (uint16_t)((color >> 11) * weight));
+  red = vmul(red, 1, 5);
+  uint16_t result = vmul(red, 2048, 0);
+
+  uint16_t green = (uint16_t)(vmul(pixel, 1, 5) & 0x3F);
+  green = vmul(green, inverse, 0);
+  green = vadds(green, (uint16_t)(((color >> 5) & 0x3F) * weight));
+  green = vmul(green, 1, 5);
+  result |= vmul(green, 32, 0);
+
+  uint16_t blue = (uint16_t)(pixel & 0x1F);
+  blue = vmul(blue, inverse, 0);
+  blue = vadds(blue, (uint16_t)((color & 0x1F) * weight));
+  result |= vmul(blue, 1, 5);
+
+  return (uint16_t)(vmul(result, 1, 8) | vmul(result, 256, 0));
+}
+
+static std::vector<uint16_t> allPixels() {
+  std::vector<uint16_t> pixels(65536);
+  for (uint32_t i = 0; i < pixels.size(); i++) {
+    pixels[i] = (uint16_t)i;
+  }
+  return pixels;
+}
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+static void test_fill_writes_display_byte_order() {
+  uint16_t buffer[20];
+  for (uint16_t& pixel : buffer) {
+    pixel = GUARD;
+  }
+  pixelFillScalar(buffer + 1, 0xF800, 18);
+  TEST_ASSERT_EQUAL_HEX16(GUARD, buffer[0]);
+  TEST_ASSERT_EQUAL_HEX16(GUARD, buffer[19]);
+  for (int i = 1; i < 19; i++) {
+    TEST_ASSERT_EQUAL_HEX16(0x00F8, buffer[i]);
+  }
+  pixelFillScalar(buffer, 0x1234, 0);
+  TEST_ASSERT_EQUAL_HEX16(GUARD, buffer[0]);
+}
+
+static void test_swap_round_trip_in_place() {
+  std::vector<uint16_t> pixels = allPixels();
+  std::vector<uint16_t> converted(pixels.size());
+  pixelSwapScalar(converted.data(), pixels.data(), (uint32_t)pixels.size());
+  for (uint32_t i = 0; i < pixels.size(); i++) {
+    TEST_ASSERT_EQUAL_HEX16(swapped((uint16_t)i), converted[i]);
+  }
+  pixelSwapScalar(converted.data(), converted.data(), (uint32_t)converted.size());
+  TEST_ASSERT_TRUE(converted == pixels);
+}
+
+static void test_blend_matches_the_formula_for_every_pixel_and_alpha() {
+  static const uint16_t colors[] = { 0x0000, 0xFFFF, 0xF800, 0x07E0, 0x001F, 0x39E7, 0xA5A5 };
+  std::vector<uint16_t> source(65536);
+  for (uint32_t i = 0; i < source.size(); i++) {
+    source[i] = swapped((uint16_t)i);
+  }
+  std::vector<uint16_t> target(source.size());
+  for (uint16_t color : colors) {
+    for (uint32_t alpha = 0; alpha < 256; alpha++) {
+      pixelBlendScalar(target.data(), source.data(), color, (uint8_t)alpha, (uint32_t)target.size());
+      for (uint32_t i = 0; i < target.size(); i++) {
+        if (swapped(target[i]) != blendReference((uint16_t)i, color, (uint8_t)alpha)) {
+          char line[80];
+          snprintf(line, sizeof(line), "pixel %04x color %04x alpha %u", (unsigned)i, color, (unsigned)alpha);
+          TEST_FAIL_MESSAGE(line);
+        }
+      }
+    }
+  }
+}
+
+static void test_blend_ends_keep_the_pixel_or_give_the_color() {
+  uint16_t pixel = swapped(0x1234);
+  uint16_t result;
+  pixelBlendScalar(&result, &pixel, 0xFFFF, 0, 1);
+  TEST_ASSERT_EQUAL_HEX16(pixel, result);
+  pixelBlendScalar(&result, &pixel, 0xF81F, 255, 1);
+  TEST_ASSERT_EQUAL_HEX16(swapped(0xF81F), result);
+  pixelBlendScalar(&pixel, &pixel, 0xF81F, 252, 1);
+  TEST_ASSERT_EQUAL_HEX16(swapped(0xF81F), pixel);
+}
+
+static void test_vector_blend_lanes_match_the_scalar_kernel() {
+  static const uint16_t colors[] = { 0x0000, 0xFFFF, 0xF81F, 0x07E0, 0x1234 };
+  std::vector<uint16_t> pixels = allPixels();
+  std::vector<uint16_t> expected(pixels.size());
+  for (uint16_t color : colors) {
+    for (uint32_t alpha = 0; alpha < 256; alpha++) {
+      pixelBlendScalar(expected.data(), pixels.data(), color, (uint8_t)alpha, (uint32_t)pixels.size());
+      for (uint32_t i = 0; i < pixels.size(); i++) {
+        if (blendLane(pixels[i], color, (uint8_t)alpha) != expected[i]) {
+          char line[80];
+          snprintf(line, sizeof(line), "pixel %04x color %04x alpha %u", (unsigned)i, color, (unsigned)alpha);
+          TEST_FAIL_MESSAGE(line);
+        }
+      }
+    }
+  }
+}
+
+static void test_dispatch_uses_the_scalar_kernels_without_vector_unit() {
+  TEST_ASSERT_FALSE(pixelKernelsVerify());
+  pixelKernelsSetSimd(true);
+  TEST_ASSERT_FALSE(pixelKernelsSimd());
+
+  alignas(16) uint16_t input[48];
+  alignas(16) uint16_t expected[48];
+  alignas(16) uint16_t actual[48];
+  for (uint32_t i = 0; i < 48; i++) {
+    input[i] = (uint16_t)(i * 2654435761u >> 16);
+  }
+  for (uint32_t offset = 0; offset < 8; offset++) {
+    for (uint32_t length = 0; length + offset <= 40; length++) {
+      memset(expected, 0, sizeof(expected));
+      memset(actual, 0, sizeof(actual));
+      pixelBlendScalar(expected + offset, input + offset, 0x39E7, 96, length);
+      pixelBlend(actual + offset, input + offset, 0x39E7, 96, length);
+      TEST_ASSERT_EQUAL_MEMORY(expected, actual, sizeof(actual));
+      pixelSwapScalar(expected + offset, input, length);
+      pixelSwap(actual + offset, input, length);
+      TEST_ASSERT_EQUAL_MEMORY(expected, actual, sizeof(actual));
+      pixelFillScalar(expected + offset, 0xF800, length);
+      pixelFill(actual + offset, 0xF800, length);
+      TEST_ASSERT_EQUAL_MEMORY(expected, actual, sizeof(actual));
+    }
+  }
+}
+
+static void test_time_per_pixel() {
+  std::vector<uint16_t> source(FRAME_PIXELS, 0x3412);
+  std::vector<uint16_t> target(FRAME_PIXELS);
+  const int rounds = 50;
+  const char* names[] = { "fill", "swap", "blend" };
+  for (int kernel = 0; kernel < 3; kernel++) {
+    auto start = std::chrono::steady_clock::now();
+    for (int round = 0; round < rounds; round++) {
+      if (kernel == 0) {
+        pixelFillScalar(target.data(), (uint16_t)round, FRAME_PIXELS);
+      } else if (kernel == 1) {
+        pixelSwapScalar(target.data(), source.data(), FRAME_PIXELS);
+      } else {
+        pixelBlendScalar(target.data(), source.data(), 0x0000, (uint8_t)(96 + round), FRAME_PIXELS);
+      }
+      source[round] = target[FRAME_PIXELS - 1 - round];   // Keep the results in use
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() /
+                ((double)rounds * FRAME_PIXELS);
+    char line[96];
+    snprintf(line, sizeof(line), "%-5s %.3f ns/pixel on the host, %.2f ms per frame", names[kernel], ns,
+             ns * FRAME_PIXELS / 1e6);
+    TEST_MESSAGE(line);
+  }
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_fill_writes_display_byte_order);
+  RUN_TEST(test_swap_round_trip_in_place);
+  RUN_TEST(test_blend_matches_the_formula_for_every_pixel_and_alpha);
+  RUN_TEST(test_blend_ends_keep_the_pixel_or_give_the_color);
+  RUN_TEST(test_vector_blend_lanes_match_the_scalar_kernel);
+  RUN_TEST(test_dispatch_uses_the_scalar_kernels_without_vector_unit);
+  RUN_TEST(test_time_per_pixel);
+  return UNITY_END();
+}
@@ -0,0 +1,127 @@
+/*
+  Host benchmark of the result QR code (result_qr.h): full game records
+  of GAME_MAX_PLIES half-moves are serialized and encoded with the
+  qrcodegen of LVGL exactly like encodeRecord() does on the clock. The
+  payload must fit RESULT_QR_MAX_PAYLOAD or end with the "~" of a cut
+  move list.
+*/
+
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include "config.h"
+#include "game_record.h"
+#include "time_control.h"
+#include "src/extra/libs/qrcode/qrcodegen.h"
+
+#define RUNS 5                        // Encodings per record, the fastest is reported
+
+struct Encoded {
+  size_t payloadBytes;
+  int version;
+  double encodeUs;
+  bool cut;
+};
+
+static GameRecord record;
+static uint8_t dataAndTemp[qrcodegen_BUFFER_LEN_MAX];
+static uint8_t qrcode[qrcodegen_BUFFER_LEN_MAX];
+
+void setUp() {
+  memset(&record, 0, sizeof(record));
+  gameRecordReset(record, TIME_CONTROL_COUNT - 1);
+
+  // Longest names the player entry accepts
+  memset(record.whiteName, 'W', 2 * PLAYER_NAME_MAX_LENGTH + 1);
+  memset(record.blackName, 'B', 2 * PLAYER_NAME_MAX_LENGTH + 1);
+  record.whiteName[PLAYER_NAME_MAX_LENGTH] = ' ';
+  record.blackName[PLAYER_NAME_MAX_LENGTH] = ' ';
+  gameRecordSetResult(record, GameResult::DRAW);
+}
+
+void tearDown() {
+}
+
+static void fillMoves(uint32_t minMs, uint32_t maxMs) {
+  for (int i = 0; i < GAME_MAX_PLIES; i++) {
+    TEST_ASSERT_TRUE(gameRecordAddMove(record, minMs + (uint32_t)rand() % (maxMs - minMs + 1)));
+  }
+  TEST_ASSERT_FALSE(gameRecordAddMove(record, minMs));
+}
+
+static Encoded encode() {
+  Encoded result = { 0, 0, 1e12, false };
+  for (int run = 0; run < RUNS; run++) {
+    auto start = std::chrono::steady_clock::now();
+    size_t length = gameRecordSerialize(record, (char*)dataAndTemp, RESULT_QR_MAX_PAYLOAD + 1);
+    result.cut = length > 0 && dataAndTemp[length - 1] == '~';
+    bool ok = qrcodegen_encodeBinary(dataAndTemp, length, qrcode, qrcodegen_Ecc_LOW,
+                                     qrcodegen_VERSION_MIN, qrcodegen_VERSION_MAX,
+                                     qrcodegen_Mask_AUTO, true);
+    double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    TEST_ASSERT_TRUE(ok);
+    result.payloadBytes = length;
+    result.version = (qrcodegen_getSize(qrcode) - 17) / 4;
+    result.encodeUs = us < result.encodeUs ? us : result.encodeUs;
+  }
+  return result;
+}
+
+static void report(const char* game, const Encoded& encoded) {
+  char line[128];
+  snprintf(line, sizeof(line), "%-9s %d plies: %4u bytes, version %2d, %s, encoded in %.0f us on the host",
+           game, GAME_MAX_PLIES, (unsigned)encoded.payloadBytes, encoded.version,
+           encoded.cut ? "move list cut" : "complete", encoded.encodeUs);
+  TEST_MESSAGE(line);
+}
+
+// Every ply in the text, or the cut marker
+static void assertFitsOrIsCut(const Encoded& encoded) {
+  TEST_ASSERT_LESS_OR_EQUAL(RESULT_QR_MAX_PAYLOAD, encoded.payloadBytes);
+  if (!encoded.cut) {
+    const char* times = strstr((const char*)dataAndTemp, ";T=");
+    TEST_ASSERT_NOT_NULL(times);
+    size_t commas = 0;
+    for (const char* p = times; *p != '\0'; p++) {
+      commas += *p == ',';
+    }
+    TEST_ASSERT_EQUAL_size_t(GAME_MAX_PLIES - 1, commas);
+  }
+}
+
+static void test_bullet_game_fits_completely() {
+  srand(28);
+  fillMoves(200, 3000);
+  Encoded encoded = encode();
+  report("bullet", encoded);
+  assertFitsOrIsCut(encoded);
+  TEST_ASSERT_FALSE(encoded.cut);
+}
+
+static void test_rapid_game() {
+  srand(28);
+  fillMoves(2000, 90000);
+  Encoded encoded = encode();
+  report("rapid", encoded);
+  assertFitsOrIsCut(encoded);
+}
+
+static void test_long_thinks_are_cut_with_a_marker() {
+  srand(28);
+  fillMoves(600000, 3600000);
+  Encoded encoded = encode();
+  report("classical", encoded);
+  assertFitsOrIsCut(encoded);
+  TEST_ASSERT_TRUE(encoded.cut);
+  TEST_ASSERT_EQUAL_INT(qrcodegen_VERSION_MAX, encoded.version);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_bullet_game_fits_completely);
+  RUN_TEST(test_rapid_game);
+  RUN_TEST(test_long_thinks_are_cut_with_a_marker);
+  return UNITY_END();
+}
@@ -0,0 +1,115 @@
+/*
+  Host tests of the rotary decoder (rotary_decoder.h): pin level traces
+  of clean turns, contact bounce and missed interrupts.
+*/
+
+#include <unity.h>
+#include <stdlib.h>
+#include "rotary_decoder.h"
+
+// Pin levels (bit 0 = A, bit 1 = B) of one detent to the next, counting up
+static const uint8_t UP[4] = { 1, 0, 2, 3 };
+static const uint8_t DOWN[4] = { 2, 0, 1, 3 };
+
+static RotaryDecoder decoder;
+
+void setUp() {
+  decoder.reset(true, true);
+}
+
+void tearDown() {
+}
+
+static void feed(uint8_t levels) {
+  decoder.update((levels & 1) != 0, (levels & 2) != 0);
+}
+
+static void turn(const uint8_t* sequence, int detents) {
+  for (int i = 0; i < detents; i++) {
+    for (int j = 0; j < 4; j++) {
+      feed(sequence[j]);
+    }
+  }
+}
+
+static void test_clean_turns_count_one_step_per_detent() {
+  turn(UP, 5);
+  TEST_ASSERT_EQUAL_INT16(5, decoder.take());
+  turn(DOWN, 3);
+  TEST_ASSERT_EQUAL_INT16(-3, decoder.take());
+  TEST_ASSERT_EQUAL_INT16(0, decoder.take());
+}
+
+static void test_steps_accumulate_until_taken() {
+  // Like a long render frame between two reads
+  turn(UP, 200);
+  turn(DOWN, 50);
+  TEST_ASSERT_EQUAL_INT16(150, decoder.take());
+}
+
+static void test_bounce_at_the_detent_is_not_a_step() {
+  for (int i = 0; i < 20; i++) {
+    feed(1);
+    feed(3);
+  }
+  TEST_ASSERT_EQUAL_INT16(0, decoder.take());
+}
+
+static void test_bounce_inside_a_step_counts_once() {
+  feed(1);
+  feed(0);
+  feed(1);   // Contact A bounces
+  feed(0);
+  feed(2);
+  feed(0);   // Contact B bounces
+  feed(2);
+  feed(3);
+  TEST_ASSERT_EQUAL_INT16(1, decoder.take());
+}
+
+static void test_half_a_turn_and_back_is_not_a_step() {
+  feed(1);
+  feed(0);
+  feed(1);
+  feed(3);
+  TEST_ASSERT_EQUAL_INT16(0, decoder.take());
+}
+
+static void test_a_missed_interrupt_still_counts_the_step() {
+  // 0 was never seen, the jump 1 -> 2 has no direction
+  feed(1);
+  feed(2);
+  feed(3);
+  TEST_ASSERT_EQUAL_INT16(1, decoder.take());
+  TEST_ASSERT_EQUAL_UINT32(1, decoder.skippedCount());
+}
+
+static void test_random_bounce_never_changes_the_direction() {
+  srand(7);
+  for (int detent = 0; detent < 1000; detent++) {
+    for (int j = 0; j < 4; j++) {
+      // Every new state may flicker back to the previous one a few times
+      uint8_t previous = UP[(j + 3) & 3];
+      int bounces = rand() % 4;
+      for (int b = 0; b < bounces; b++) {
+        feed(UP[j]);
+        feed(previous);
+      }
+      feed(UP[j]);
+    }
+  }
+  TEST_ASSERT_EQUAL_INT16(1000, decoder.take());
+  TEST_ASSERT_EQUAL_UINT32(0, decoder.skippedCount());
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_clean_turns_count_one_step_per_detent);
+  RUN_TEST(test_steps_accumulate_until_taken);
+  RUN_TEST(test_bounce_at_the_detent_is_not_a_step);
+  RUN_TEST(test_bounce_inside_a_step_counts_once);
+  RUN_TEST(test_half_a_turn_and_back_is_not_a_step);
+  RUN_TEST(test_a_missed_interrupt_still_counts_the_step);
+  RUN_TEST(test_random_bounce_never_changes_the_direction);
+  return UNITY_END();
+}
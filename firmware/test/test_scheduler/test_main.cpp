@@ -0,0 +1,320 @@
+/*
+  Host tests of the timing wheel (scheduler.h) in virtual time: due
+  ticks, nextDueMs(), determinism of sleeping until the next job against
+  polling every tick, and a benchmark with thousands of timers.
+*/
+
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <vector>
+#include "scheduler.h"
+
+static int64_t virtualUs;
+
+static int64_t virtualNow() {
+  return virtualUs;
+}
+
+struct Run {
+  uint16_t job;
+  int64_t atUs;
+
+  bool operator==(const Run& other) const { return job == other.job && atUs == other.atUs; }
+};
+
+// Context of the jobs of one simulation
+struct Simulation {
+  Scheduler* scheduler;
+  std::vector<SchedulerJob> jobs;
+  std::vector<uint32_t> seeds;    // Per job, so the delays do not depend on the run order
+  std::vector<Run> runs;
+};
+
+struct JobContext {
+  Simulation* simulation;
+  uint16_t index;
+};
+
+static Scheduler scheduler;
+
+void setUp() {
+  virtualUs = 1000000;
+  scheduler.begin(virtualNow);
+}
+
+void tearDown() {
+}
+
+static SchedulerJob makeJob(const char* name, void (*run)(void*), void* context, uint32_t periodMs) {
+  SchedulerJob job = {};
+  job.name = name;
+  job.run = run;
+  job.context = context;
+  job.periodMs = periodMs;
+  job.toleranceMs = 0;
+  return job;
+}
+
+static void advanceMs(uint32_t ms) {
+  for (uint32_t i = 0; i < ms; i++) {
+    virtualUs += 1000;
+    scheduler.run();
+  }
+}
+
+static void countRun(void* context) {
+  (*(uint32_t*)context)++;
+}
+
+static void test_one_shot_runs_at_its_due_tick() {
+  uint32_t count = 0;
+  SchedulerJob job = makeJob("once", countRun, &count, 0);
+  scheduler.add(&job, 10);
+  advanceMs(9);
+  TEST_ASSERT_EQUAL_UINT32(0, count);
+  advanceMs(1);
+  TEST_ASSERT_EQUAL_UINT32(1, count);
+  advanceMs(100);
+  TEST_ASSERT_EQUAL_UINT32(1, count);
+  TEST_ASSERT_FALSE(Scheduler::isScheduled(&job));
+}
+
+static void test_periodic_job_keeps_its_phase() {
+  uint32_t count = 0;
+  SchedulerJob job = makeJob("periodic", countRun, &count, 7);
+  scheduler.add(&job, 3);
+  advanceMs(3 + 7 * 99);
+  TEST_ASSERT_EQUAL_UINT32(100, count);
+  TEST_ASSERT_EQUAL_UINT32(0, job.maxLateUs);
+  TEST_ASSERT_EQUAL_UINT32(0, job.misses);
+}
+
+static void test_next_due_ms_of_an_empty_wheel() {
+  TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, scheduler.nextDueMs());
+}
+
+static void test_next_due_ms_counts_down() {
+  uint32_t count = 0;
+  SchedulerJob job = makeJob("once", countRun, &count, 0);
+  scheduler.add(&job, 10);
+  TEST_ASSERT_EQUAL_UINT32(10, scheduler.nextDueMs());
+  advanceMs(4);
+  TEST_ASSERT_EQUAL_UINT32(6, scheduler.nextDueMs());
+
+  // Between two ticks it rounds up, the job must not be missed
+  virtualUs += 300;
+  TEST_ASSERT_EQUAL_UINT32(6, scheduler.nextDueMs());
+
+  // Overdue because run() was not called
+  virtualUs += 20000;
+  TEST_ASSERT_EQUAL_UINT32(0, scheduler.nextDueMs());
+  scheduler.run();
+  TEST_ASSERT_EQUAL_UINT32(1, count);
+  TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, scheduler.nextDueMs());
+}
+
+static void test_next_due_ms_finds_a_higher_level_job_that_is_earlier() {
+  uint32_t farCount = 0;
+  uint32_t nearCount = 0;
+  SchedulerJob far = makeJob("far", countRun, &farCount, 0);
+  SchedulerJob near = makeJob("near", countRun, &nearCount, 0);
+
+  // Level 1, due in 70 ms
+  scheduler.add(&far, 70);
+  advanceMs(20);
+  // Level 0, due in 60 ms, but the level 1 job is due in 50 ms
+  scheduler.add(&near, 60);
+  TEST_ASSERT_EQUAL_UINT32(50, scheduler.nextDueMs());
+  advanceMs(50);
+  TEST_ASSERT_EQUAL_UINT32(1, farCount);
+  TEST_ASSERT_EQUAL_UINT32(10, scheduler.nextDueMs());
+}
+
+static void test_next_due_ms_beyond_the_wheel() {
+  uint32_t count = 0;
+  SchedulerJob job = makeJob("hours", countRun, &count, 0);
+  const uint32_t FIVE_HOURS_MS = 5 * 3600 * 1000;
+  scheduler.add(&job, FIVE_HOURS_MS);
+  TEST_ASSERT_EQUAL_UINT32(FIVE_HOURS_MS, scheduler.nextDueMs());
+}
+
+static uint32_t nextRandom(uint32_t* seed) {
+  *seed = *seed * 1664525 + 1013904223;
+  return *seed >> 8;
+}
+
+// Runs and sometimes reschedules itself with a random delay or cancels a neighbour
+static void simulatedJob(void* context) {
+  JobContext* job = (JobContext*)context;
+  Simulation* simulation = job->simulation;
+  simulation->runs.push_back({ job->index, virtualUs });
+
+  uint32_t* seed = &simulation->seeds[job->index];
+  switch (nextRandom(seed) % 8) {
+    case 0:
+      simulation->scheduler->add(&simulation->jobs[job->index], nextRandom(seed) % 3000);
+      break;
+    case 1: {
+      uint16_t other = (uint16_t)(nextRandom(seed) % simulation->jobs.size());
+      if (other != job->index && simulation->jobs[other].periodMs == 0) {
+        simulation->scheduler->add(&simulation->jobs[other], nextRandom(seed) % 500);
+      }
+      break;
+    }
+    default:
+      break;
+  }
+}
+
+static void setUpSimulation(Simulation* simulation, Scheduler* wheel, std::vector<JobContext>* contexts,
+                            uint16_t count, uint32_t seed) {
+  simulation->scheduler = wheel;
+  simulation->jobs.clear();
+  simulation->seeds.clear();
+  simulation->runs.clear();
+  contexts->resize(count);
+  for (uint16_t i = 0; i < count; i++) {
+    (*contexts)[i] = { simulation, i };
+    uint32_t periodMs = nextRandom(&seed) % 3 == 0 ? 1 + nextRandom(&seed) % 200 : 0;
+    simulation->jobs.push_back(makeJob("sim", simulatedJob, &(*contexts)[i], periodMs));
+    simulation->seeds.push_back(nextRandom(&seed));
+  }
+  for (uint16_t i = 0; i < count; i++) {
+    wheel->add(&simulation->jobs[i], nextRandom(&seed) % 5000);
+  }
+}
+
+static void test_sleeping_until_due_runs_like_polling() {
+  const int64_t END_US = 1000000 + 60LL * 1000000;
+
+  // Reference: wake on every tick
+  Scheduler polled;
+  Simulation reference;
+  std::vector<JobContext> referenceContexts;
+  virtualUs = 1000000;
+  polled.begin(virtualNow);
+  setUpSimulation(&reference, &polled, &referenceContexts, 200, 35);
+  uint32_t pollWakes = 0;
+  while (virtualUs < END_US) {
+    virtualUs += 1000;
+    polled.run();
+    pollWakes++;
+  }
+
+  // Sleep until the next job, wake up a bit late like a real task
+  Scheduler sleeping;
+  Simulation sleeper;
+  std::vector<JobContext> sleeperContexts;
+  virtualUs = 1000000;
+  sleeping.begin(virtualNow);
+  setUpSimulation(&sleeper, &sleeping, &sleeperContexts, 200, 35);
+  uint32_t sleepWakes = 0;
+  while (virtualUs < END_US) {
+    uint32_t waitMs = sleeping.nextDueMs();
+    TEST_ASSERT_TRUE(waitMs != UINT32_MAX);
+    // Only run on tick boundaries like the polled reference, so the times compare
+    virtualUs += (int64_t)(waitMs > 0 ? waitMs : 1) * 1000;
+    if (virtualUs > END_US) {
+      virtualUs = END_US;
+    }
+    sleeping.run();
+    sleepWakes++;
+  }
+
+  TEST_ASSERT_EQUAL_size_t(reference.runs.size(), sleeper.runs.size());
+  for (size_t i = 0; i < reference.runs.size(); i++) {
+    TEST_ASSERT_EQUAL_UINT16(reference.runs[i].job, sleeper.runs[i].job);
+    TEST_ASSERT_EQUAL_INT64(reference.runs[i].atUs, sleeper.runs[i].atUs);
+  }
+  TEST_ASSERT_LESS_THAN(pollWakes, sleepWakes);
+
+  char line[96];
+  snprintf(line, sizeof(line), "%u runs, %u wakes instead of %u", (unsigned)sleeper.runs.size(),
+           (unsigned)sleepWakes, (unsigned)pollWakes);
+  TEST_MESSAGE(line);
+}
+
+static void test_same_schedule_gives_the_same_runs() {
+  Simulation first;
+  Simulation second;
+  std::vector<JobContext> firstContexts;
+  std::vector<JobContext> secondContexts;
+
+  virtualUs = 1000000;
+  scheduler.begin(virtualNow);
+  setUpSimulation(&first, &scheduler, &firstContexts, 500, 7);
+  advanceMs(20000);
+
+  virtualUs = 1000000;
+  scheduler.begin(virtualNow);
+  setUpSimulation(&second, &scheduler, &secondContexts, 500, 7);
+  advanceMs(20000);
+
+  TEST_ASSERT_GREATER_THAN(1000, first.runs.size());
+  TEST_ASSERT_TRUE(first.runs == second.runs);
+}
+
+static void test_benchmark_thousands_of_timers() {
+  const uint32_t COUNT = 10000;
+  std::vector<SchedulerJob> jobs(COUNT);
+  std::vector<uint32_t> counts(COUNT, 0);
+  uint32_t seed = 45;
+
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < COUNT; i++) {
+    uint32_t periodMs = i % 4 == 0 ? 10 + nextRandom(&seed) % 1000 : 0;
+    jobs[i] = makeJob("bench", countRun, &counts[i], periodMs);
+    scheduler.add(&jobs[i], nextRandom(&seed) % (10 * 60 * 1000));
+  }
+  auto added = std::chrono::steady_clock::now();
+
+  const uint32_t DURATION_MS = 10 * 60 * 1000;
+  advanceMs(DURATION_MS);
+  auto finished = std::chrono::steady_clock::now();
+
+  uint64_t runs = 0;
+  uint32_t maxLateUs = 0;
+  for (uint32_t i = 0; i < COUNT; i++) {
+    runs += jobs[i].runs;
+    if (jobs[i].maxLateUs > maxLateUs) {
+      maxLateUs = jobs[i].maxLateUs;
+    }
+    if (jobs[i].periodMs == 0) {
+      TEST_ASSERT_EQUAL_UINT32(1, counts[i]);
+    }
+  }
+  // Every job ran exactly at its tick
+  TEST_ASSERT_EQUAL_UINT32(0, maxLateUs);
+
+  auto probeStart = std::chrono::steady_clock::now();
+  uint32_t probes = 0;
+  for (; probes < 1000; probes++) {
+    TEST_ASSERT_TRUE(scheduler.nextDueMs() != UINT32_MAX);
+  }
+  auto probeEnd = std::chrono::steady_clock::now();
+
+  double addNs = std::chrono::duration<double, std::nano>(added - start).count() / COUNT;
+  double runNs = std::chrono::duration<double, std::nano>(finished - added).count() / (double)runs;
+  double tickNs = std::chrono::duration<double, std::nano>(finished - added).count() / DURATION_MS;
+  double probeNs = std::chrono::duration<double, std::nano>(probeEnd - probeStart).count() / probes;
+  char line[160];
+  snprintf(line, sizeof(line), "%u timers, %llu runs: add %.0f ns, per run %.0f ns, per tick %.0f ns, nextDueMs %.0f ns",
+           (unsigned)COUNT, (unsigned long long)runs, addNs, runNs, tickNs, probeNs);
+  TEST_MESSAGE(line);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_one_shot_runs_at_its_due_tick);
+  RUN_TEST(test_periodic_job_keeps_its_phase);
+  RUN_TEST(test_next_due_ms_of_an_empty_wheel);
+  RUN_TEST(test_next_due_ms_counts_down);
+  RUN_TEST(test_next_due_ms_finds_a_higher_level_job_that_is_earlier);
+  RUN_TEST(test_next_due_ms_beyond_the_wheel);
+  RUN_TEST(test_sleeping_until_due_runs_like_polling);
+  RUN_TEST(test_same_schedule_gives_the_same_runs);
+  RUN_TEST(test_benchmark_thousands_of_timers);
+  return UNITY_END();
+}
@@ -0,0 +1,148 @@
+/*
+  Host tests of the memory a game runs on: the session arena (arena.h)
+  and the lock-free object pool (object_pool.h) of the clock events.
+*/
+
+#include <unity.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "arena.h"
+#include "object_pool.h"
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+static void test_arena_hands_out_aligned_memory() {
+  Arena arena;
+  TEST_ASSERT_TRUE(arena.begin(256, 0));
+  uint8_t* byte = (uint8_t*)arena.allocate(1, 1);
+  uint64_t* word = (uint64_t*)arena.allocate(sizeof(uint64_t), alignof(uint64_t));
+  TEST_ASSERT_NOT_NULL(byte);
+  TEST_ASSERT_NOT_NULL(word);
+  TEST_ASSERT_EQUAL_UINT32(0, (uintptr_t)word % alignof(uint64_t));
+  TEST_ASSERT_TRUE((uint8_t*)word > byte);
+  TEST_ASSERT_EQUAL_size_t((size_t)((uint8_t*)word - byte) + sizeof(uint64_t), arena.used());
+}
+
+static void test_arena_reports_exhaustion() {
+  Arena arena;
+  TEST_ASSERT_NULL(arena.allocate(1, 1));   // Not started
+  TEST_ASSERT_TRUE(arena.begin(64, 0));
+  TEST_ASSERT_EQUAL_UINT32(0, arena.failedAllocations());
+  TEST_ASSERT_NOT_NULL(arena.allocate(60, 1));
+  TEST_ASSERT_NULL(arena.allocate(8, 1));
+  TEST_ASSERT_NOT_NULL(arena.allocate(4, 1));
+  TEST_ASSERT_EQUAL_UINT32(1, arena.failedAllocations());
+  TEST_ASSERT_EQUAL_size_t(64, arena.used());
+}
+
+static void test_arena_reset_keeps_the_block_and_the_peak() {
+  Arena arena;
+  TEST_ASSERT_TRUE(arena.begin(128, 0));
+  void* first = arena.allocate(100, 1);
+  arena.reset();
+  TEST_ASSERT_EQUAL_size_t(0, arena.used());
+  TEST_ASSERT_EQUAL_size_t(100, arena.highWater());
+  TEST_ASSERT_EQUAL_PTR(first, arena.allocate(10, 1));
+
+  arena.release();
+  TEST_ASSERT_FALSE(arena.isReady());
+  TEST_ASSERT_EQUAL_size_t(0, arena.capacity());
+}
+
+struct Constructed {
+  uint32_t a;
+  uint16_t b;
+  Constructed(uint32_t a, uint16_t b) : a(a), b(b) {}
+};
+
+static void test_arena_constructs_objects_in_place() {
+  Arena arena;
+  TEST_ASSERT_TRUE(arena.begin(sizeof(Constructed) * 3, 0));
+  Constructed* object = arena.create<Constructed>(7u, (uint16_t)9);
+  TEST_ASSERT_NOT_NULL(object);
+  TEST_ASSERT_EQUAL_UINT32(7, object->a);
+  TEST_ASSERT_EQUAL_UINT16(9, object->b);
+  TEST_ASSERT_NOT_NULL(arena.create<Constructed>(1u, (uint16_t)2));
+  TEST_ASSERT_NOT_NULL(arena.create<Constructed>(1u, (uint16_t)2));
+  TEST_ASSERT_NULL(arena.create<Constructed>(1u, (uint16_t)2));
+}
+
+struct PoolItem {
+  uint32_t value;
+  PoolItem() : value(0) {}
+};
+
+static void test_pool_gives_every_slot_once() {
+  ObjectPool<PoolItem, 8> pool;
+  PoolItem* items[8];
+  for (int i = 0; i < 8; i++) {
+    items[i] = pool.acquire();
+    TEST_ASSERT_NOT_NULL(items[i]);
+    TEST_ASSERT_TRUE(pool.owns(items[i]));
+    for (int j = 0; j < i; j++) {
+      TEST_ASSERT_TRUE(items[i] != items[j]);
+    }
+  }
+  TEST_ASSERT_NULL(pool.acquire());
+  TEST_ASSERT_EQUAL_UINT32(1, pool.exhaustedCount());
+  TEST_ASSERT_EQUAL_UINT16(8, pool.used());
+
+  pool.release(items[3]);
+  PoolItem* again = pool.acquire();
+  TEST_ASSERT_EQUAL_PTR(items[3], again);
+  TEST_ASSERT_EQUAL_UINT32(0, again->value);   // Constructed again
+  TEST_ASSERT_EQUAL_UINT16(8, pool.highWater());
+}
+
+static void test_pool_rejects_foreign_objects() {
+  ObjectPool<PoolItem, 2> pool;
+  PoolItem outside;
+  TEST_ASSERT_FALSE(pool.owns(&outside));
+  pool.release(nullptr);
+  TEST_ASSERT_EQUAL_UINT16(0, pool.used());
+}
+
+static void test_pool_never_hands_out_a_slot_twice_across_threads() {
+  // Like the interrupt handlers and tasks on both cores
+  static ObjectPool<PoolItem, 16> pool;
+  std::atomic<uint32_t> collisions(0);
+  std::vector<std::thread> threads;
+  for (uint32_t id = 1; id <= 4; id++) {
+    threads.emplace_back([id, &collisions]() {
+      for (int round = 0; round < 100000; round++) {
+        PoolItem* item = pool.acquire();
+        if (item == nullptr) {
+          continue;
+        }
+        item->value = id;
+        std::this_thread::yield();
+        if (item->value != id) {
+          collisions.fetch_add(1);
+        }
+        pool.release(item);
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  TEST_ASSERT_EQUAL_UINT32(0, collisions.load());
+  TEST_ASSERT_EQUAL_UINT16(0, pool.used());
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_arena_hands_out_aligned_memory);
+  RUN_TEST(test_arena_reports_exhaustion);
+  RUN_TEST(test_arena_reset_keeps_the_block_and_the_peak);
+  RUN_TEST(test_arena_constructs_objects_in_place);
+  RUN_TEST(test_pool_gives_every_slot_once);
+  RUN_TEST(test_pool_rejects_foreign_objects);
+  RUN_TEST(test_pool_never_hands_out_a_slot_twice_across_threads);
+  return UNITY_END();
+}
@@ -0,0 +1,102 @@
+/*
+  Host tests of the SNTP packets (sntp_packet.h): the client request, the
+  timestamps of a server reply, and replies that must be rejected.
+*/
+
+#include <unity.h>
+#include <stdint.h>
+#include <string.h>
+#include "sntp_packet.h"
+
+#define NTP_UNIX_OFFSET_S 2208988800ULL
+#define TOKEN 0x0123456789abcdefULL
+
+static uint8_t request[SNTP_PACKET_SIZE];
+static uint8_t reply[SNTP_PACKET_SIZE];
+
+static void writeBe64(uint8_t* p, uint64_t value) {
+  for (int i = 0; i < 8; i++) {
+    p[i] = (uint8_t)(value >> (56 - 8 * i));
+  }
+}
+
+// Unix seconds and a 32 bit NTP fraction as NTP timestamp
+static void writeNtp(uint8_t* p, uint64_t unixSeconds, uint32_t fraction) {
+  writeBe64(p, ((unixSeconds + NTP_UNIX_OFFSET_S) << 32) | fraction);
+}
+
+// What a stratum 2 server answers to request
+static void answer(const uint8_t* to) {
+  memset(reply, 0, sizeof(reply));
+  reply[0] = (0 << 6) | (4 << 3) | 4;     // LI 0, version 4, mode 4 (server)
+  reply[1] = 2;
+  memcpy(reply + 24, to + 40, 8);         // Originate: the transmit timestamp of the request
+  writeNtp(reply + 32, 1700000000ULL, 0x80000000UL);
+  writeNtp(reply + 40, 1700000001ULL, 0x00418938UL);
+}
+
+void setUp() {
+  sntpBuildRequest(request, TOKEN);
+  answer(request);
+}
+
+void tearDown() {
+}
+
+static void test_request_is_a_version_4_client_packet() {
+  TEST_ASSERT_EQUAL_HEX8(0x23, request[0]);
+  const uint8_t token[8] = { 0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef };
+  TEST_ASSERT_EQUAL_MEMORY(token, request + 40, 8);
+  for (int i = 1; i < 40; i++) {
+    TEST_ASSERT_EQUAL_HEX8(0, request[i]);
+  }
+}
+
+static void test_reply_timestamps_are_unix_microseconds() {
+  int64_t serverRecvUs = 0;
+  int64_t serverSendUs = 0;
+  TEST_ASSERT_TRUE(sntpParseReply(reply, sizeof(reply), TOKEN, &serverRecvUs, &serverSendUs));
+  TEST_ASSERT_EQUAL_INT64(1700000000LL * 1000000LL + 500000, serverRecvUs);
+  TEST_ASSERT_EQUAL_INT64(1700000001LL * 1000000LL + 1000, serverSendUs);   // Just above 1 ms, truncated
+
+  // Longer datagrams (extension fields, MAC) are fine
+  uint8_t longer[SNTP_PACKET_SIZE + 20] = {};
+  memcpy(longer, reply, sizeof(reply));
+  TEST_ASSERT_TRUE(sntpParseReply(longer, sizeof(longer), TOKEN, &serverRecvUs, &serverSendUs));
+}
+
+static void test_short_and_foreign_replies_are_rejected() {
+  int64_t serverRecvUs = 0;
+  int64_t serverSendUs = 0;
+  TEST_ASSERT_FALSE(sntpParseReply(reply, SNTP_PACKET_SIZE - 1, TOKEN, &serverRecvUs, &serverSendUs));
+  TEST_ASSERT_FALSE(sntpParseReply(reply, sizeof(reply), TOKEN + 1, &serverRecvUs, &serverSendUs));
+
+  // Our own request echoed back
+  TEST_ASSERT_FALSE(sntpParseReply(request, sizeof(request), 0, &serverRecvUs, &serverSendUs));
+  TEST_ASSERT_EQUAL_INT64(0, serverRecvUs);
+  TEST_ASSERT_EQUAL_INT64(0, serverSendUs);
+}
+
+static void test_unsynchronized_servers_are_rejected() {
+  int64_t serverRecvUs = 0;
+  int64_t serverSendUs = 0;
+  reply[0] |= 3 << 6;                     // Leap indicator: clock not synchronized
+  TEST_ASSERT_FALSE(sntpParseReply(reply, sizeof(reply), TOKEN, &serverRecvUs, &serverSendUs));
+
+  answer(request);
+  reply[1] = 0;                           // Kiss-of-death
+  TEST_ASSERT_FALSE(sntpParseReply(reply, sizeof(reply), TOKEN, &serverRecvUs, &serverSendUs));
+  reply[1] = 16;
+  TEST_ASSERT_FALSE(sntpParseReply(reply, sizeof(reply), TOKEN, &serverRecvUs, &serverSendUs));
+  reply[1] = 15;
+  TEST_ASSERT_TRUE(sntpParseReply(reply, sizeof(reply), TOKEN, &serverRecvUs, &serverSendUs));
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_request_is_a_version_4_client_packet);
+  RUN_TEST(test_reply_timestamps_are_unix_microseconds);
+  RUN_TEST(test_short_and_foreign_replies_are_rejected);
+  RUN_TEST(test_unsynchronized_servers_are_rejected);
+  return UNITY_END();
+}
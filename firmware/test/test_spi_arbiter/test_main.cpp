@@ -0,0 +1,247 @@
+/*
+  Host tests of the SPI arbiter (spi_arbiter.h): priorities, chunking,
+  coalescing of address windows and the wait of a touch sample behind a
+  running frame, with a simulated executor in virtual time.
+*/
+
+#include <unity.h>
+#include <stdlib.h>
+#include "spi_arbiter.h"
+
+static const int32_t CHUNK_LINES = 8;
+static uint16_t framePixels[320 * 240];
+
+static SpiArbiter arbiter;
+
+void setUp() {
+  arbiter.reset(CHUNK_LINES, 0);
+}
+
+void tearDown() {
+}
+
+static SpiTransaction pixelTransaction(int32_t x, int32_t y, int32_t width, int32_t height) {
+  SpiTransaction transaction = {};
+  transaction.device = SpiDevice::DISPLAY;
+  transaction.x = x;
+  transaction.y = y;
+  transaction.width = width;
+  transaction.height = height;
+  transaction.pixels = framePixels;
+  return transaction;
+}
+
+static SpiTransaction touchTransaction() {
+  SpiTransaction transaction = {};
+  transaction.device = SpiDevice::TOUCH;
+  return transaction;
+}
+
+static void test_empty_arbiter_is_idle() {
+  SpiWork work;
+  TEST_ASSERT_TRUE(arbiter.idle());
+  TEST_ASSERT_FALSE(arbiter.next(work, 0));
+}
+
+static void test_pixel_transfer_is_split_into_chunks() {
+  SpiTransaction frame = pixelTransaction(0, 0, 320, 40);
+  arbiter.enqueue(&frame, 0);
+
+  SpiWork work;
+  for (int32_t chunk = 0; chunk < 5; chunk++) {
+    TEST_ASSERT_TRUE(arbiter.next(work, 0));
+    TEST_ASSERT_EQUAL_PTR(&frame, work.transaction);
+    TEST_ASSERT_EQUAL_INT32(chunk * CHUNK_LINES, work.firstLine);
+    TEST_ASSERT_EQUAL_INT32(CHUNK_LINES, work.lines);
+    TEST_ASSERT_EQUAL_INT(chunk == 4, work.lastChunk);
+    TEST_ASSERT_EQUAL_INT(chunk > 0, work.continuesWindow);
+    TEST_ASSERT_EQUAL_INT(chunk == 4, arbiter.complete(work, 100));
+  }
+  TEST_ASSERT_TRUE(arbiter.idle());
+
+  const SpiDeviceStats& stats = arbiter.stats(SpiDevice::DISPLAY);
+  TEST_ASSERT_EQUAL_UINT32(1, stats.transactions);
+  TEST_ASSERT_EQUAL_UINT32(5, stats.chunks);
+  TEST_ASSERT_EQUAL_UINT32(4, stats.coalesced);
+}
+
+static void test_last_chunk_takes_the_remaining_lines() {
+  SpiTransaction frame = pixelTransaction(0, 0, 100, 19);
+  arbiter.enqueue(&frame, 0);
+
+  SpiWork work;
+  arbiter.next(work, 0);
+  arbiter.complete(work, 10);
+  arbiter.next(work, 0);
+  arbiter.complete(work, 10);
+  TEST_ASSERT_TRUE(arbiter.next(work, 0));
+  TEST_ASSERT_EQUAL_INT32(3, work.lines);
+  TEST_ASSERT_TRUE(work.lastChunk);
+}
+
+static void test_touch_goes_first() {
+  SpiTransaction frame = pixelTransaction(0, 0, 320, 8);
+  SpiTransaction sample = touchTransaction();
+  arbiter.enqueue(&frame, 0);
+  arbiter.enqueue(&sample, 10);
+
+  SpiWork work;
+  TEST_ASSERT_TRUE(arbiter.next(work, 20));
+  TEST_ASSERT_EQUAL_PTR(&sample, work.transaction);
+  TEST_ASSERT_EQUAL_INT32(0, work.lines);
+  TEST_ASSERT_TRUE(work.lastChunk);
+  TEST_ASSERT_TRUE(arbiter.complete(work, 30));
+  TEST_ASSERT_TRUE(arbiter.next(work, 50));
+  TEST_ASSERT_EQUAL_PTR(&frame, work.transaction);
+}
+
+static void test_touch_interrupts_a_frame_between_chunks() {
+  SpiTransaction frame = pixelTransaction(0, 0, 320, 24);
+  SpiTransaction sample = touchTransaction();
+  arbiter.enqueue(&frame, 0);
+
+  SpiWork work;
+  arbiter.next(work, 0);
+  arbiter.complete(work, 500);
+  arbiter.enqueue(&sample, 200);
+
+  TEST_ASSERT_TRUE(arbiter.next(work, 500));
+  TEST_ASSERT_EQUAL_PTR(&sample, work.transaction);
+  arbiter.complete(work, 40);
+
+  // The frame continues where it stopped, but needs a new address window
+  TEST_ASSERT_TRUE(arbiter.next(work, 540));
+  TEST_ASSERT_EQUAL_PTR(&frame, work.transaction);
+  TEST_ASSERT_EQUAL_INT32(CHUNK_LINES, work.firstLine);
+  TEST_ASSERT_FALSE(work.continuesWindow);
+
+  TEST_ASSERT_EQUAL_UINT32(300, arbiter.stats(SpiDevice::TOUCH).maxWaitUs);
+}
+
+static void test_adjacent_bands_share_the_address_window() {
+  SpiTransaction upper = pixelTransaction(10, 0, 200, CHUNK_LINES);
+  SpiTransaction lower = pixelTransaction(10, CHUNK_LINES, 200, CHUNK_LINES);
+  SpiTransaction shifted = pixelTransaction(12, 2 * CHUNK_LINES, 200, CHUNK_LINES);
+  arbiter.enqueue(&upper, 0);
+  arbiter.enqueue(&lower, 0);
+  arbiter.enqueue(&shifted, 0);
+
+  SpiWork work;
+  arbiter.next(work, 0);
+  TEST_ASSERT_FALSE(work.continuesWindow);
+  arbiter.complete(work, 10);
+  arbiter.next(work, 0);
+  TEST_ASSERT_EQUAL_PTR(&lower, work.transaction);
+  TEST_ASSERT_TRUE(work.continuesWindow);
+  arbiter.complete(work, 10);
+  arbiter.next(work, 0);
+  TEST_ASSERT_EQUAL_PTR(&shifted, work.transaction);
+  TEST_ASSERT_FALSE(work.continuesWindow);
+}
+
+static void test_break_window_forgets_the_address_window() {
+  SpiTransaction upper = pixelTransaction(0, 0, 320, CHUNK_LINES);
+  SpiTransaction lower = pixelTransaction(0, CHUNK_LINES, 320, CHUNK_LINES);
+  arbiter.enqueue(&upper, 0);
+  arbiter.enqueue(&lower, 0);
+
+  SpiWork work;
+  arbiter.next(work, 0);
+  arbiter.complete(work, 10);
+  arbiter.breakWindow();
+  arbiter.next(work, 0);
+  TEST_ASSERT_FALSE(work.continuesWindow);
+}
+
+static void test_each_device_is_fifo() {
+  SpiTransaction first = touchTransaction();
+  SpiTransaction second = touchTransaction();
+  arbiter.enqueue(&first, 0);
+  arbiter.enqueue(&second, 0);
+
+  SpiWork work;
+  arbiter.next(work, 0);
+  TEST_ASSERT_EQUAL_PTR(&first, work.transaction);
+  arbiter.complete(work, 10);
+  arbiter.next(work, 0);
+  TEST_ASSERT_EQUAL_PTR(&second, work.transaction);
+  arbiter.complete(work, 10);
+  TEST_ASSERT_TRUE(arbiter.idle());
+
+  // A finished transaction can be enqueued again
+  arbiter.enqueue(&first, 100);
+  TEST_ASSERT_TRUE(arbiter.next(work, 100));
+  TEST_ASSERT_EQUAL_PTR(&first, work.transaction);
+}
+
+static void test_utilization() {
+  SpiTransaction sample = touchTransaction();
+  arbiter.enqueue(&sample, 0);
+  SpiWork work;
+  arbiter.next(work, 0);
+  arbiter.complete(work, 250);
+  TEST_ASSERT_EQUAL_UINT32(25, arbiter.utilizationPercent(1000));
+  TEST_ASSERT_EQUAL_UINT32(0, arbiter.utilizationPercent(0));
+}
+
+// Executor in virtual time: full frames back to back, touch samples at random times
+static void test_touch_waits_at_most_one_chunk() {
+  const uint32_t US_PER_LINE = 40;         // 320 pixels at 40 MHz, 16 bit
+  const uint32_t SAMPLE_US = 30;
+  const int64_t DURATION_US = 2000000;
+
+  srand(37);
+  SpiTransaction frame = pixelTransaction(0, 0, 320, 240);
+  SpiTransaction sample = touchTransaction();
+  bool sampleQueued = false;
+  int64_t nextSampleUs = rand() % 5000;
+  int64_t nowUs = 0;
+  uint32_t frames = 0;
+  uint32_t samples = 0;
+
+  arbiter.enqueue(&frame, 0);
+  while (nowUs < DURATION_US) {
+    if (!sampleQueued && nowUs >= nextSampleUs) {
+      arbiter.enqueue(&sample, nextSampleUs);
+      sampleQueued = true;
+    }
+    SpiWork work;
+    if (!arbiter.next(work, nowUs)) {
+      nowUs = nextSampleUs;
+      continue;
+    }
+    uint32_t busyUs = work.lines > 0 ? work.lines * US_PER_LINE : SAMPLE_US;
+    nowUs += busyUs;
+    if (arbiter.complete(work, busyUs)) {
+      if (work.transaction == &sample) {
+        sampleQueued = false;
+        samples++;
+        nextSampleUs = nowUs + 1000 + rand() % 9000;
+      } else {
+        frames++;
+        arbiter.enqueue(&frame, nowUs);
+      }
+    }
+  }
+
+  const SpiDeviceStats& touch = arbiter.stats(SpiDevice::TOUCH);
+  TEST_ASSERT_GREATER_THAN(100, samples);
+  TEST_ASSERT_GREATER_THAN(100, frames);
+  TEST_ASSERT_LESS_OR_EQUAL_UINT32(CHUNK_LINES * US_PER_LINE, touch.maxWaitUs);
+  TEST_ASSERT_GREATER_OR_EQUAL_UINT32(95, arbiter.utilizationPercent(nowUs));
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_empty_arbiter_is_idle);
+  RUN_TEST(test_pixel_transfer_is_split_into_chunks);
+  RUN_TEST(test_last_chunk_takes_the_remaining_lines);
+  RUN_TEST(test_touch_goes_first);
+  RUN_TEST(test_touch_interrupts_a_frame_between_chunks);
+  RUN_TEST(test_adjacent_bands_share_the_address_window);
+  RUN_TEST(test_break_window_forgets_the_address_window);
+  RUN_TEST(test_each_device_is_fifo);
+  RUN_TEST(test_utilization);
+  RUN_TEST(test_touch_waits_at_most_one_chunk);
+  return UNITY_END();
+}
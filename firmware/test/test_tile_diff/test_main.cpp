@@ -0,0 +1,302 @@
+/*
+  Host tests of the tile diff (tile_diff.h) and a benchmark over scripted
+  UI sessions (menu, pause overlay, result screen) that compares the bytes
+  sent to the display with full redraws. Every frame is also copied onto
+  a simulated display through the returned rectangles only, which then
+  has to match the frame.
+*/
+
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include <random>
+#include <vector>
+#include "tile_diff.h"
+
+#define WIDTH 320
+#define HEIGHT 240
+#define MAX_RECTS 32                  // SHADOW_MAX_RECTS
+
+struct Screen {
+  std::vector<uint16_t> frame;
+  std::vector<uint16_t> display;
+  std::vector<uint32_t> hashes;
+  TileDiff diff;
+  TileRect rects[MAX_RECTS];
+
+  void begin(int32_t width, int32_t height) {
+    frame.assign((size_t)width * height, 0);
+    display.assign(frame.size(), 0xDEAD);
+    hashes.assign(TileDiff::tileCount(width, height), 0);
+    TEST_ASSERT_TRUE(diff.begin(width, height, hashes.data(), (uint32_t)hashes.size()));
+  }
+
+  void fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t colour, int32_t width = WIDTH) {
+    for (int32_t line = y; line < y + h; line++) {
+      for (int32_t column = x; column < x + w; column++) {
+        frame[(size_t)line * width + column] = colour;
+      }
+    }
+  }
+
+  // Text as 8x12 cells with a pattern per character
+  void drawText(int32_t x, int32_t y, const char* text, uint16_t colour, uint16_t background) {
+    for (; *text != '\0'; text++, x += 8) {
+      for (int32_t line = 0; line < 12; line++) {
+        for (int32_t column = 0; column < 8; column++) {
+          bool set = ((*text * 37 + line * 7 + column) % 5) < 2;
+          frame[(size_t)(y + line) * WIDTH + x + column] = set ? colour : background;
+        }
+      }
+    }
+  }
+
+  // Diff and copy the rectangles onto the display, returns their count
+  uint16_t push(int32_t width = WIDTH) {
+    uint16_t count = diff.diff(frame.data(), rects, MAX_RECTS);
+    for (uint16_t i = 0; i < count; i++) {
+      const TileRect& rect = rects[i];
+      for (int32_t line = rect.y; line < rect.y + rect.height; line++) {
+        memcpy(&display[(size_t)line * width + rect.x], &frame[(size_t)line * width + rect.x],
+               (size_t)rect.width * sizeof(uint16_t));
+      }
+    }
+    TEST_ASSERT_TRUE(display == frame);
+    return count;
+  }
+};
+
+static Screen screen;
+
+void setUp() {
+  screen = Screen();
+}
+
+void tearDown() {
+}
+
+static void test_begin_checks_the_size() {
+  uint32_t hashes[16];
+  TileDiff diff;
+  TEST_ASSERT_EQUAL_UINT32(300, TileDiff::tileCount(WIDTH, HEIGHT));
+  TEST_ASSERT_EQUAL_UINT32(4, TileDiff::tileCount(17, 17));
+  TEST_ASSERT_FALSE(diff.begin(64, 64, hashes, 15));
+  TEST_ASSERT_TRUE(diff.begin(64, 64, hashes, 16));
+  TEST_ASSERT_FALSE(diff.begin(TILE_DIFF_MAX_COLUMNS * TILE_DIFF_SIZE + 1, 16, hashes, 16));
+  TEST_ASSERT_FALSE(diff.begin(0, 16, hashes, 16));
+}
+
+static void test_first_frame_is_sent_whole() {
+  screen.begin(WIDTH, HEIGHT);
+  TEST_ASSERT_EQUAL_UINT16(1, screen.push());
+  TEST_ASSERT_EQUAL_INT16(0, screen.rects[0].x);
+  TEST_ASSERT_EQUAL_INT16(WIDTH, screen.rects[0].width);
+  TEST_ASSERT_EQUAL_INT16(HEIGHT, screen.rects[0].height);
+
+  TEST_ASSERT_EQUAL_UINT16(0, screen.push());
+
+  screen.diff.invalidate();
+  TEST_ASSERT_EQUAL_UINT16(1, screen.push());
+  TEST_ASSERT_EQUAL_UINT32(3, screen.diff.stats().frames);
+}
+
+static void test_one_pixel_sends_one_tile() {
+  screen.begin(WIDTH, HEIGHT);
+  screen.push();
+  screen.fillRect(100, 50, 1, 1, 0xFFFF);
+  TEST_ASSERT_EQUAL_UINT16(1, screen.push());
+  TEST_ASSERT_EQUAL_INT16(96, screen.rects[0].x);
+  TEST_ASSERT_EQUAL_INT16(48, screen.rects[0].y);
+  TEST_ASSERT_EQUAL_INT16(TILE_DIFF_SIZE, screen.rects[0].width);
+  TEST_ASSERT_EQUAL_INT16(TILE_DIFF_SIZE, screen.rects[0].height);
+}
+
+static void test_partial_tiles_at_the_edges_are_clipped() {
+  const int32_t width = 50;
+  const int32_t height = 37;
+  screen.begin(width, height);
+  screen.push(width);
+  screen.fillRect(49, 36, 1, 1, 0x1234, width);
+  TEST_ASSERT_EQUAL_UINT16(1, screen.push(width));
+  TEST_ASSERT_EQUAL_INT16(48, screen.rects[0].x);
+  TEST_ASSERT_EQUAL_INT16(32, screen.rects[0].y);
+  TEST_ASSERT_EQUAL_INT16(2, screen.rects[0].width);
+  TEST_ASSERT_EQUAL_INT16(5, screen.rects[0].height);
+}
+
+static void test_adjacent_tiles_are_merged() {
+  screen.begin(WIDTH, HEIGHT);
+  screen.push();
+
+  // A block across 3 x 2 tiles becomes one rectangle
+  screen.fillRect(40, 40, 40, 20, 0xF800);
+  TEST_ASSERT_EQUAL_UINT16(1, screen.push());
+  TEST_ASSERT_EQUAL_INT16(32, screen.rects[0].x);
+  TEST_ASSERT_EQUAL_INT16(32, screen.rects[0].y);
+  TEST_ASSERT_EQUAL_INT16(3 * TILE_DIFF_SIZE, screen.rects[0].width);
+  TEST_ASSERT_EQUAL_INT16(2 * TILE_DIFF_SIZE, screen.rects[0].height);
+
+  // An L shape: the wider row cannot extend the narrower one
+  screen.fillRect(0, 160, 16, 32, 0x07E0);
+  screen.fillRect(0, 192, 48, 16, 0x07E0);
+  TEST_ASSERT_EQUAL_UINT16(2, screen.push());
+  TEST_ASSERT_EQUAL_INT16(2 * TILE_DIFF_SIZE, screen.rects[0].height);
+  TEST_ASSERT_EQUAL_INT16(3 * TILE_DIFF_SIZE, screen.rects[1].width);
+}
+
+static void test_too_many_areas_become_one_box() {
+  screen.begin(WIDTH, HEIGHT);
+  screen.push();
+  // A checkerboard of dirty tiles cannot be merged
+  for (int32_t row = 2; row < 12; row++) {
+    for (int32_t column = (row & 1); column < 20; column += 2) {
+      screen.fillRect(column * TILE_DIFF_SIZE + 3, row * TILE_DIFF_SIZE + 3, 2, 2, 0x001F);
+    }
+  }
+  TEST_ASSERT_EQUAL_UINT16(1, screen.push());
+  TEST_ASSERT_EQUAL_INT16(0, screen.rects[0].x);
+  TEST_ASSERT_EQUAL_INT16(2 * TILE_DIFF_SIZE, screen.rects[0].y);
+  TEST_ASSERT_EQUAL_INT16(WIDTH, screen.rects[0].width);
+  TEST_ASSERT_EQUAL_INT16(10 * TILE_DIFF_SIZE, screen.rects[0].height);
+  TEST_ASSERT_EQUAL_UINT32(1, screen.diff.stats().overflows);
+}
+
+static void test_random_changes_always_reach_the_display() {
+  std::mt19937 random(7);
+  screen.begin(WIDTH, HEIGHT);
+  screen.push();
+  for (int frame = 0; frame < 500; frame++) {
+    int changes = 1 + random() % 12;
+    for (int i = 0; i < changes; i++) {
+      int32_t w = 1 + random() % 60;
+      int32_t h = 1 + random() % 60;
+      int32_t x = random() % (WIDTH - w);
+      int32_t y = random() % (HEIGHT - h);
+      screen.fillRect(x, y, w, h, (uint16_t)random());
+    }
+    uint16_t count = screen.push();   // Checks the display
+    TEST_ASSERT_TRUE(count >= 1 && count <= MAX_RECTS);
+  }
+}
+
+static void test_changes_to_every_second_pixel_are_found() {
+  // Only the high half of the pixel pairs changes, in three rows: with a
+  // plain FNV step this was a 16 bit hash and missed about 1 in 65536
+  std::mt19937 random(11);
+  uint16_t frame[TILE_DIFF_SIZE * TILE_DIFF_SIZE] = {};
+  uint32_t hash;
+  TileDiff diff;
+  TEST_ASSERT_TRUE(diff.begin(TILE_DIFF_SIZE, TILE_DIFF_SIZE, &hash, 1));
+  TileRect rect;
+  diff.diff(frame, &rect, 1);
+  uint32_t missed = 0;
+  for (uint32_t trial = 0; trial < 300000; trial++) {
+    for (int32_t line = 0; line < 3; line++) {
+      frame[line * TILE_DIFF_SIZE + 11] = (uint16_t)random();
+    }
+    missed += diff.diff(frame, &rect, 1) == 0;
+  }
+  TEST_ASSERT_EQUAL_UINT32(0, missed);
+}
+
+// --- Scripted sessions -------------------------------------------------------
+
+static void drawMenu(uint8_t selected) {
+  static const char* ITEMS[] = { "New game", "Players", "Time control", "Results", "Settings" };
+  screen.fillRect(0, 0, WIDTH, 30, 0x001F);
+  screen.drawText(8, 9, "Main menu", 0xFFFF, 0x001F);
+  for (uint8_t i = 0; i < 5; i++) {
+    uint16_t background = i == selected ? 0xFFE0 : 0x0000;
+    uint16_t colour = i == selected ? 0x0000 : 0xFFFF;
+    screen.fillRect(0, 40 + i * 40, WIDTH, 36, background);
+    screen.drawText(16, 52 + i * 40, ITEMS[i], colour, background);
+  }
+}
+
+static void drawClock(uint32_t whiteMs, uint32_t blackMs) {
+  char text[16];
+  screen.fillRect(0, 0, WIDTH, HEIGHT, 0x0000);
+  snprintf(text, sizeof(text), "%02u:%02u", (unsigned)(whiteMs / 60000), (unsigned)(whiteMs / 1000 % 60));
+  screen.drawText(20, 100, text, 0xFFFF, 0x0000);
+  snprintf(text, sizeof(text), "%02u:%02u", (unsigned)(blackMs / 60000), (unsigned)(blackMs / 1000 % 60));
+  screen.drawText(200, 100, text, 0xFFFF, 0x0000);
+}
+
+struct SessionResult {
+  uint64_t bytesSent;
+  uint64_t bytesFull;
+  uint32_t rects;
+};
+
+static SessionResult runSession(const char* name) {
+  screen.begin(WIDTH, HEIGHT);
+  if (strcmp(name, "menu") == 0) {
+    // Scroll through the menu and back, one frame per encoder step
+    for (int step = 0; step < 40; step++) {
+      drawMenu((uint8_t)(step < 20 ? step % 5 : 4 - step % 5));
+      screen.push();
+    }
+  } else if (strcmp(name, "pause") == 0) {
+    // The running clock, then the dimmed pause box with a blinking label
+    uint32_t whiteMs = 300000;
+    for (int tick = 0; tick < 60; tick++) {
+      drawClock(whiteMs, 180000);
+      if (tick >= 30) {
+        screen.fillRect(80, 60, 160, 120, 0x39E7);
+        if (tick % 4 < 2) {
+          screen.drawText(136, 114, "PAUSE", 0xFFFF, 0x39E7);
+        }
+      } else {
+        whiteMs -= 1000;
+      }
+      screen.push();
+    }
+  } else {
+    // Result screen: drawn once, then a QR code appears and stays
+    for (int frame = 0; frame < 20; frame++) {
+      screen.fillRect(0, 0, WIDTH, HEIGHT, 0xFFFF);
+      screen.drawText(60, 20, "White wins on time", 0x0000, 0xFFFF);
+      if (frame >= 5) {
+        for (int32_t module = 0; module < 29 * 29; module++) {
+          uint16_t colour = (module * 7919 % 3) == 0 ? 0x0000 : 0xFFFF;
+          screen.fillRect(102 + (module % 29) * 4, 80 + (module / 29) * 4, 4, 4, colour);
+        }
+      }
+      screen.push();
+    }
+  }
+  const TileDiffStats& stats = screen.diff.stats();
+  return { stats.pixelsSent * 2, stats.pixelsFull * 2, stats.rects };
+}
+
+static void test_scripted_sessions_send_far_less_than_full_redraws() {
+  const char* sessions[] = { "menu", "pause", "result" };
+  uint64_t sent = 0;
+  uint64_t full = 0;
+  for (const char* name : sessions) {
+    SessionResult result = runSession(name);
+    char line[112];
+    snprintf(line, sizeof(line), "%-6s %8u of %8u bytes (%4.1f %%) in %u rectangles", name,
+             (unsigned)result.bytesSent, (unsigned)result.bytesFull, 100.0 * result.bytesSent / result.bytesFull,
+             (unsigned)result.rects);
+    TEST_MESSAGE(line);
+    TEST_ASSERT_LESS_THAN(result.bytesFull / 2, result.bytesSent);
+    sent += result.bytesSent;
+    full += result.bytesFull;
+  }
+  TEST_ASSERT_LESS_THAN(full / 4, sent);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_begin_checks_the_size);
+  RUN_TEST(test_first_frame_is_sent_whole);
+  RUN_TEST(test_one_pixel_sends_one_tile);
+  RUN_TEST(test_partial_tiles_at_the_edges_are_clipped);
+  RUN_TEST(test_adjacent_tiles_are_merged);
+  RUN_TEST(test_too_many_areas_become_one_box);
+  RUN_TEST(test_random_changes_always_reach_the_display);
+  RUN_TEST(test_changes_to_every_second_pixel_are_found);
+  RUN_TEST(test_scripted_sessions_send_far_less_than_full_redraws);
+  return UNITY_END();
+}
@@ -0,0 +1,118 @@
+/*
+  Host tests of the time engine (time_engine.h): both clocks are charged
+  by edge timestamps only.
+*/
+
+#include <unity.h>
+#include <stdlib.h>
+#include "time_engine.h"
+
+static TimeEngine engine;
+
+void setUp() {
+  engine.reset(60000, 2000);   // 1 min + 2 s
+}
+
+void tearDown() {
+}
+
+static void test_reset_stops_both_clocks() {
+  TEST_ASSERT_FALSE(engine.isRunning());
+  TEST_ASSERT_EQUAL_INT64(60000000, engine.remainingUs(Side::WHITE, 5000000));
+  TEST_ASSERT_EQUAL_INT64(60000000, engine.remainingUs(Side::BLACK, 5000000));
+  TEST_ASSERT_TRUE(engine.expiryUs() == INT64_MAX);
+  TEST_ASSERT_EQUAL_UINT32(0, engine.press(1000));
+}
+
+static void test_press_charges_the_edge_time_and_adds_the_increment() {
+  engine.start(Side::WHITE, 1000000);
+  // The handler may run much later, only the edge timestamp counts
+  TEST_ASSERT_EQUAL_INT64(57000000, engine.remainingUs(Side::WHITE, 4000000));
+  uint32_t moveMs = engine.press(4000000);
+  TEST_ASSERT_EQUAL_UINT32(3000, moveMs);
+  TEST_ASSERT_EQUAL_INT64(59000000, engine.remainingUs(Side::WHITE, 9000000));
+  TEST_ASSERT_TRUE(engine.activeSide() == Side::BLACK);
+  TEST_ASSERT_EQUAL_INT64(55000000, engine.remainingUs(Side::BLACK, 9000000));
+}
+
+static void test_late_edge_of_the_other_channel_costs_nothing() {
+  engine.start(Side::WHITE, 1000000);
+  engine.press(2000000);
+  // An edge stamped before the last one charges zero time, black only gets the increment
+  TEST_ASSERT_EQUAL_UINT32(0, engine.press(1999000));
+  TEST_ASSERT_EQUAL_INT64(62000000, engine.remainingUs(Side::BLACK, 3000000));
+  TEST_ASSERT_EQUAL_INT64(61000000, engine.remainingUs(Side::WHITE, 2000000));
+}
+
+static void test_pause_stops_the_running_clock() {
+  engine.start(Side::WHITE, 0);
+  engine.pause(10000000);
+  TEST_ASSERT_FALSE(engine.isRunning());
+  TEST_ASSERT_EQUAL_INT64(50000000, engine.remainingUs(Side::WHITE, 500000000));
+  engine.resume(600000000);
+  TEST_ASSERT_EQUAL_INT64(49000000, engine.remainingUs(Side::WHITE, 601000000));
+  TEST_ASSERT_EQUAL_UINT32(12000, engine.press(602000000));   // Time before and after the pause
+}
+
+static void test_flag_falls_exactly_at_expiry() {
+  engine.start(Side::WHITE, 1000000);
+  TEST_ASSERT_EQUAL_INT64(61000000, engine.expiryUs());
+  TEST_ASSERT_FALSE(engine.flagFallen(60999999));
+  TEST_ASSERT_TRUE(engine.flagFallen(61000000));
+  TEST_ASSERT_EQUAL_INT64(0, engine.remainingUs(Side::WHITE, 70000000));
+}
+
+static void test_no_increment_after_the_flag_fell() {
+  engine.start(Side::WHITE, 0);
+  engine.press(65000000);
+  TEST_ASSERT_EQUAL_INT64(0, engine.remainingUs(Side::WHITE, 65000000));
+}
+
+static void test_restore_continues_with_the_saved_times() {
+  engine.restore(12345, 54321, 2000, Side::BLACK);
+  TEST_ASSERT_FALSE(engine.isRunning());
+  TEST_ASSERT_TRUE(engine.activeSide() == Side::BLACK);
+  engine.resume(1000000);
+  TEST_ASSERT_EQUAL_UINT32(321, engine.press(1321000));
+  TEST_ASSERT_EQUAL_INT64(56000000, engine.remainingUs(Side::BLACK, 2000000));
+  TEST_ASSERT_EQUAL_INT64(12345000 - 679000, engine.remainingUs(Side::WHITE, 2000000));
+}
+
+static void test_random_games_charge_exactly_the_running_time() {
+  srand(11);
+  for (int game = 0; game < 200; game++) {
+    engine.reset(600000, 0);   // No increment, so the sum is conserved
+    int64_t nowUs = rand() % 1000000;
+    int64_t runningUs = 0;
+    engine.start(Side::WHITE, nowUs);
+    for (int move = 0; move < 40; move++) {
+      int64_t thinkUs = rand() % 20000000;
+      if (rand() % 8 == 0) {
+        int64_t beforePauseUs = thinkUs / 2;
+        engine.pause(nowUs + beforePauseUs);
+        nowUs += beforePauseUs + rand() % 100000000;
+        engine.resume(nowUs);
+        thinkUs -= beforePauseUs;
+        runningUs += beforePauseUs;
+      }
+      nowUs += thinkUs;
+      runningUs += thinkUs;
+      engine.press(nowUs);
+    }
+    int64_t left = engine.remainingUs(Side::WHITE, nowUs) + engine.remainingUs(Side::BLACK, nowUs);
+    TEST_ASSERT_EQUAL_INT64(2 * 600000000LL - runningUs, left);
+  }
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_reset_stops_both_clocks);
+  RUN_TEST(test_press_charges_the_edge_time_and_adds_the_increment);
+  RUN_TEST(test_late_edge_of_the_other_channel_costs_nothing);
+  RUN_TEST(test_pause_stops_the_running_clock);
+  RUN_TEST(test_flag_falls_exactly_at_expiry);
+  RUN_TEST(test_no_increment_after_the_flag_fell);
+  RUN_TEST(test_restore_continues_with_the_saved_times);
+  RUN_TEST(test_random_games_charge_exactly_the_running_time);
+  return UNITY_END();
+}
@@ -0,0 +1,217 @@
+/*
+  Host tests of the touch filter (touch_filter.h): median, smoothing,
+  calibration and the gesture recognizer, fed with synthetic sample
+  streams at the touch task's sample interval.
+*/
+
+#include <unity.h>
+#include "config.h"
+#include "touch_filter.h"
+
+static const int64_t SAMPLE_US = TOUCH_SAMPLE_MS * 1000;
+
+static TouchFilter filter;
+static TouchGesture gesture;
+
+// 10 raw units per pixel, no swapping or inverting
+static TouchCalibration plainCalibration() {
+  TouchCalibration calibration = {};
+  calibration.rawXMin = 0;
+  calibration.rawXMax = 3200;
+  calibration.rawYMin = 0;
+  calibration.rawYMax = 2400;
+  calibration.width = 320;
+  calibration.height = 240;
+  return calibration;
+}
+
+void setUp() {
+  filter.begin(plainCalibration());
+  gesture = {};
+}
+
+void tearDown() {
+}
+
+// One sample at a pixel position, optionally with one wild reading
+static bool sampleAt(int16_t x, int16_t y, int64_t nowUs, bool outlier = false) {
+  uint16_t rawX[TOUCH_OVERSAMPLE];
+  uint16_t rawY[TOUCH_OVERSAMPLE];
+  for (uint8_t i = 0; i < TOUCH_OVERSAMPLE; i++) {
+    rawX[i] = (uint16_t)(x * 10 + 5 + (i % 3) - 1);
+    rawY[i] = (uint16_t)(y * 10 + 5 + (i % 3) - 1);
+  }
+  if (outlier) {
+    rawX[1] = 4095;
+    rawY[3] = 0;
+  }
+  return filter.addSample(rawX, rawY, TOUCH_OVERSAMPLE, nowUs, &gesture);
+}
+
+// Holds the pen at one place, returns the time after the last sample
+static int64_t holdAt(int16_t x, int16_t y, int64_t startUs, int64_t durationUs) {
+  int64_t nowUs = startUs;
+  for (; nowUs < startUs + durationUs; nowUs += SAMPLE_US) {
+    sampleAt(x, y, nowUs);
+  }
+  return nowUs;
+}
+
+static void test_first_sample_sets_the_point() {
+  TEST_ASSERT_FALSE(filter.point().pressed);
+  TEST_ASSERT_FALSE(sampleAt(100, 50, 0));
+  TouchPoint point = filter.point();
+  TEST_ASSERT_TRUE(point.pressed);
+  TEST_ASSERT_EQUAL_INT16(100, point.x);
+  TEST_ASSERT_EQUAL_INT16(50, point.y);
+}
+
+static void test_median_removes_an_outlier() {
+  sampleAt(100, 50, 0);
+  for (int i = 1; i < 10; i++) {
+    sampleAt(100, 50, i * SAMPLE_US, true);
+  }
+  TouchPoint point = filter.point();
+  TEST_ASSERT_EQUAL_INT16(100, point.x);
+  TEST_ASSERT_EQUAL_INT16(50, point.y);
+}
+
+static void test_iir_follows_a_jump_gradually() {
+  sampleAt(100, 100, 0);
+  sampleAt(180, 100, SAMPLE_US);
+  int16_t firstStep = filter.point().x;
+  TEST_ASSERT_GREATER_THAN(100, firstStep);
+  TEST_ASSERT_LESS_THAN(180, firstStep);
+
+  for (int i = 2; i < 40; i++) {
+    sampleAt(180, 100, i * SAMPLE_US);
+  }
+  TEST_ASSERT_INT_WITHIN(1, 180, filter.point().x);
+}
+
+static void test_calibration_swaps_inverts_and_clamps() {
+  TouchCalibration calibration = plainCalibration();
+  calibration.rawXMax = 2400;     // Raw X runs along the screen's Y axis
+  calibration.rawYMax = 3200;
+  calibration.swapXY = true;
+  calibration.invertY = true;
+  filter.begin(calibration);
+
+  // Raw X 200 -> y 20 -> inverted 219, raw Y 1000 -> x 100
+  uint16_t rawX[3] = { 205, 205, 205 };
+  uint16_t rawY[3] = { 1005, 1005, 1005 };
+  filter.addSample(rawX, rawY, 3, 0, &gesture);
+  TEST_ASSERT_EQUAL_INT16(100, filter.point().x);
+  TEST_ASSERT_EQUAL_INT16(219, filter.point().y);
+
+  // Beyond the calibrated range
+  filter.penUp(SAMPLE_US, &gesture);
+  uint16_t farX[1] = { 4095 };
+  uint16_t farY[1] = { 4095 };
+  filter.addSample(farX, farY, 1, 2 * SAMPLE_US, &gesture);
+  TEST_ASSERT_EQUAL_INT16(319, filter.point().x);
+  TEST_ASSERT_EQUAL_INT16(0, filter.point().y);
+}
+
+static void test_invalid_reading_count_is_ignored() {
+  uint16_t raw[TOUCH_FILTER_MAX_READINGS + 1] = {};
+  TEST_ASSERT_FALSE(filter.addSample(raw, raw, 0, 0, &gesture));
+  TEST_ASSERT_FALSE(filter.addSample(raw, raw, TOUCH_FILTER_MAX_READINGS + 1, 0, &gesture));
+  TEST_ASSERT_FALSE(filter.point().pressed);
+}
+
+static void test_short_touch_is_a_tap() {
+  int64_t endUs = holdAt(160, 120, 0, (TOUCH_TAP_MAX_MS - 50) * 1000);
+  TEST_ASSERT_TRUE(filter.penUp(endUs, &gesture));
+  TEST_ASSERT_TRUE(gesture.type == TouchGestureType::TAP);
+  TEST_ASSERT_EQUAL_INT16(160, gesture.x);
+  TEST_ASSERT_EQUAL_INT16(120, gesture.y);
+  TEST_ASSERT_EQUAL_INT64(endUs, gesture.timestampUs);
+  TEST_ASSERT_FALSE(filter.point().pressed);
+}
+
+static void test_slow_touch_is_no_tap() {
+  int64_t endUs = holdAt(160, 120, 0, (TOUCH_TAP_MAX_MS + 100) * 1000);
+  TEST_ASSERT_FALSE(filter.penUp(endUs, &gesture));
+}
+
+static void test_holding_still_is_one_long_press() {
+  uint32_t longPresses = 0;
+  int64_t nowUs = 0;
+  for (; nowUs < 2 * TOUCH_LONG_PRESS_MS * 1000; nowUs += SAMPLE_US) {
+    if (sampleAt(50, 60, nowUs)) {
+      longPresses++;
+      TEST_ASSERT_TRUE(gesture.type == TouchGestureType::LONG_PRESS);
+      TEST_ASSERT_GREATER_OR_EQUAL_INT64((int64_t)TOUCH_LONG_PRESS_MS * 1000, gesture.timestampUs);
+      TEST_ASSERT_LESS_THAN_INT64((int64_t)TOUCH_LONG_PRESS_MS * 1000 + SAMPLE_US, gesture.timestampUs);
+    }
+  }
+  TEST_ASSERT_EQUAL_UINT32(1, longPresses);
+  // Already reported, lifting the pen adds nothing
+  TEST_ASSERT_FALSE(filter.penUp(nowUs, &gesture));
+}
+
+static void test_small_jitter_still_counts_as_holding() {
+  int64_t nowUs = 0;
+  bool recognized = false;
+  for (int i = 0; nowUs < 2 * TOUCH_LONG_PRESS_MS * 1000 && !recognized; i++, nowUs += SAMPLE_US) {
+    int16_t jitter = (int16_t)((i % 5) - 2) * TOUCH_MOVE_MAX_PX / 3;
+    recognized = sampleAt(200 + jitter, 100 - jitter, nowUs);
+  }
+  TEST_ASSERT_TRUE(recognized);
+}
+
+static void test_drag_is_no_long_press() {
+  int64_t nowUs = 0;
+  for (int i = 0; nowUs < 2 * TOUCH_LONG_PRESS_MS * 1000; i++, nowUs += SAMPLE_US) {
+    // Moves away and comes back, leaving the circle once is enough
+    int16_t x = (int16_t)(i < 20 ? 100 + i * 3 : 100);
+    TEST_ASSERT_FALSE(sampleAt(x, 100, nowUs));
+  }
+  TEST_ASSERT_FALSE(filter.penUp(nowUs, &gesture));
+}
+
+static void swipe(int16_t fromX, int16_t fromY, int16_t toX, int16_t toY) {
+  const int STEPS = 15;
+  int64_t nowUs = 0;
+  for (int i = 0; i <= STEPS; i++, nowUs += SAMPLE_US) {
+    sampleAt((int16_t)(fromX + (toX - fromX) * i / STEPS), (int16_t)(fromY + (toY - fromY) * i / STEPS), nowUs);
+  }
+  // The filter needs a few samples at the end to catch up
+  nowUs = holdAt(toX, toY, nowUs, 5 * SAMPLE_US);
+  TEST_ASSERT_TRUE(filter.penUp(nowUs, &gesture));
+  TEST_ASSERT_EQUAL_INT16(fromX, gesture.x);
+  TEST_ASSERT_EQUAL_INT16(fromY, gesture.y);
+}
+
+static void test_swipes_in_all_directions() {
+  swipe(40, 120, 240, 130);
+  TEST_ASSERT_TRUE(gesture.type == TouchGestureType::SWIPE_RIGHT);
+  swipe(240, 120, 40, 100);
+  TEST_ASSERT_TRUE(gesture.type == TouchGestureType::SWIPE_LEFT);
+  swipe(160, 20, 170, 200);
+  TEST_ASSERT_TRUE(gesture.type == TouchGestureType::SWIPE_DOWN);
+  swipe(160, 200, 150, 20);
+  TEST_ASSERT_TRUE(gesture.type == TouchGestureType::SWIPE_UP);
+}
+
+static void test_pen_up_without_touch() {
+  TEST_ASSERT_FALSE(filter.penUp(1000, &gesture));
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_first_sample_sets_the_point);
+  RUN_TEST(test_median_removes_an_outlier);
+  RUN_TEST(test_iir_follows_a_jump_gradually);
+  RUN_TEST(test_calibration_swaps_inverts_and_clamps);
+  RUN_TEST(test_invalid_reading_count_is_ignored);
+  RUN_TEST(test_short_touch_is_a_tap);
+  RUN_TEST(test_slow_touch_is_no_tap);
+  RUN_TEST(test_holding_still_is_one_long_press);
+  RUN_TEST(test_small_jitter_still_counts_as_holding);
+  RUN_TEST(test_drag_is_no_long_press);
+  RUN_TEST(test_swipes_in_all_directions);
+  RUN_TEST(test_pen_up_without_touch);
+  return UNITY_END();
+}
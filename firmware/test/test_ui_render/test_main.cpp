@@ -0,0 +1,136 @@
+/*
+  Host benchmark of the menu screens (ui_screens.h): LVGL renders every
+  screen into a framebuffer in memory, through draw buffers of
+  LVGL_DRAW_BUFFER_LINES lines like on the clock. The flush callback
+  only copies and counts, so the time is LVGL's own rendering.
+*/
+
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+#include <lvgl.h>
+#include "config.h"
+#include "ui_screens.h"
+
+#define WIDTH 320                     // ILI9341 in landscape, see setRotation() in main.cpp
+#define HEIGHT 240
+#define DRAW_BUFFER_PIXELS (WIDTH * LVGL_DRAW_BUFFER_LINES)
+
+struct FlushCount {
+  uint32_t flushes;
+  uint32_t bytes;
+};
+
+static lv_color_t framebuffer[WIDTH * HEIGHT];
+static lv_color_t drawBuffer1[DRAW_BUFFER_PIXELS];
+static lv_color_t drawBuffer2[DRAW_BUFFER_PIXELS];
+static lv_disp_draw_buf_t drawBuffer;
+static lv_disp_drv_t displayDriver;
+static FlushCount flushed;
+static ChessClockState requested = ChessClockState::START;
+
+static void flushToMemory(lv_disp_drv_t* driver, const lv_area_t* area, lv_color_t* pixels) {
+  uint32_t width = area->x2 - area->x1 + 1;
+  for (int32_t y = area->y1; y <= area->y2; y++) {
+    memcpy(&framebuffer[y * WIDTH + area->x1], pixels, width * sizeof(lv_color_t));
+    pixels += width;
+  }
+  flushed.flushes++;
+  flushed.bytes += width * (area->y2 - area->y1 + 1) * sizeof(lv_color_t);
+  lv_disp_flush_ready(driver);
+}
+
+static void onTransition(ChessClockState next) {
+  requested = next;
+}
+
+// Loads the screen of a state and renders it once, returns the time of lv_refr_now()
+static double renderState(ChessClockState state) {
+  UiScreen* target = uiScreenForState(state);
+  TEST_ASSERT_NOT_NULL(target);
+  lv_scr_load(target->screen);
+  memset(&flushed, 0, sizeof(flushed));
+  memset(framebuffer, 0, sizeof(framebuffer));
+
+  auto start = std::chrono::steady_clock::now();
+  lv_refr_now(NULL);
+  return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+static uint32_t litPixels() {
+  uint32_t lit = 0;
+  for (const lv_color_t& pixel : framebuffer) {
+    lit += pixel.full != 0;
+  }
+  return lit;
+}
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+static void test_menu_screens_render_the_whole_display() {
+  const ChessClockState states[] = {
+    ChessClockState::MAIN_MENU,
+    ChessClockState::WAIT_FOR_MODE_SELECTION,
+    ChessClockState::ENTER_PLAYER_NAME,
+  };
+  for (ChessClockState state : states) {
+    TEST_ASSERT_TRUE(uiHandlesState(state));
+    double us = renderState(state);
+    char line[128];
+    snprintf(line, sizeof(line), "%-24s lv_refr %6.0f us on the host, %2u flushes, %u bytes",
+             stateToString(state), us, (unsigned)flushed.flushes, (unsigned)flushed.bytes);
+    TEST_MESSAGE(line);
+
+    // A new screen is drawn completely, one flush per draw buffer
+    TEST_ASSERT_EQUAL_UINT32(WIDTH * HEIGHT * sizeof(lv_color_t), flushed.bytes);
+    TEST_ASSERT_EQUAL_UINT32((HEIGHT + LVGL_DRAW_BUFFER_LINES - 1) / LVGL_DRAW_BUFFER_LINES, flushed.flushes);
+    TEST_ASSERT_GREATER_THAN(0, litPixels());
+  }
+}
+
+static void test_an_unchanged_screen_flushes_nothing() {
+  renderState(ChessClockState::MAIN_MENU);
+  memset(&flushed, 0, sizeof(flushed));
+  lv_refr_now(NULL);
+  TEST_ASSERT_EQUAL_UINT32(0, flushed.flushes);
+  TEST_ASSERT_EQUAL_UINT32(0, flushed.bytes);
+}
+
+static void test_screens_are_built_once() {
+  UiScreen* first = uiScreenForState(ChessClockState::WAIT_FOR_MODE_SELECTION);
+  TEST_ASSERT_EQUAL_PTR(first, uiScreenForState(ChessClockState::WAIT_FOR_MODE_SELECTION));
+  TEST_ASSERT_NULL(uiScreenForState(ChessClockState::IDLE));
+  TEST_ASSERT_FALSE(uiHandlesState(ChessClockState::IDLE));
+}
+
+static void test_a_clicked_menu_button_requests_its_state() {
+  UiScreen* menu = uiScreenForState(ChessClockState::MAIN_MENU);
+  requested = ChessClockState::START;
+  lv_obj_t* playButton = lv_obj_get_child(menu->screen, 1);   // After the title
+  lv_event_send(playButton, LV_EVENT_CLICKED, NULL);
+  TEST_ASSERT_TRUE(requested == ChessClockState::WAIT_FOR_MODE_SELECTION);
+}
+
+int main() {
+  lv_init();
+  lv_disp_draw_buf_init(&drawBuffer, drawBuffer1, drawBuffer2, DRAW_BUFFER_PIXELS);
+  lv_disp_drv_init(&displayDriver);
+  displayDriver.hor_res = WIDTH;
+  displayDriver.ver_res = HEIGHT;
+  displayDriver.flush_cb = flushToMemory;
+  displayDriver.draw_buf = &drawBuffer;
+  lv_disp_drv_register(&displayDriver);
+  uiScreensBegin(onTransition);
+
+  UNITY_BEGIN();
+  RUN_TEST(test_menu_screens_render_the_whole_display);
+  RUN_TEST(test_an_unchanged_screen_flushes_nothing);
+  RUN_TEST(test_screens_are_built_once);
+  RUN_TEST(test_a_clicked_menu_button_requests_its_state);
+  return UNITY_END();
+}
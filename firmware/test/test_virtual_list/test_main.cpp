@@ -0,0 +1,283 @@
+/*
+  Host tests of the virtual list (virtual_list.h) with a simulated
+  display: rows are drawn into screen slots the way player_list.cpp does
+  it, and the ring of slots is read back through the scroll start like
+  the ILI9341 shows it after VSCRSADD. A roster of thousands of players
+  (player_roster.h) is scrolled with the encoder, and the rows drawn and
+  the SPI time per scroll step are compared with and without hardware
+  scrolling.
+*/
+
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include "player_roster.h"
+#include "virtual_list.h"
+
+#define ROW_WIDTH 240                 // Portrait, the only rotation with hardware scrolling
+#define ROW_HEIGHT 24
+#define VISIBLE_ROWS 12               // (320 panel lines - title row) / ROW_HEIGHT
+#define SPI_HZ 40000000.0             // SPI_FREQUENCY
+#define ROW_COMMAND_BYTES 11          // CASET, RASET and RAMWR of one row
+#define SCROLL_COMMAND_BYTES 3        // VSCRSADD
+
+struct Slot {
+  uint32_t row;
+  bool highlighted;
+};
+
+// The list area of the display and the row drawing of player_list.cpp
+struct ListScreen {
+  VirtualList list;
+  std::vector<Slot> slots;
+  const PlayerRoster* roster = nullptr;
+  uint32_t rowsDrawn = 0;
+  uint32_t scrolls = 0;
+  uint64_t bytes = 0;
+  std::vector<uint16_t> rowPixels = std::vector<uint16_t>(ROW_WIDTH * ROW_HEIGHT);
+
+  void show(uint32_t count, bool ring) {
+    list.begin(count, VISIBLE_ROWS, ring);
+    slots.assign(VISIBLE_ROWS, { UINT32_MAX, false });
+    drawVisible();
+  }
+
+  void drawRow(uint32_t index) {
+    if (!list.isVisible(index)) {
+      return;
+    }
+    // Stands in for the smooth text rendering of the name
+    if (roster != nullptr) {
+      char name[48];
+      TEST_ASSERT_TRUE(roster->name(index, name, sizeof(name)));
+      uint16_t colour = index == list.selected() ? 0xFFE0 : 0xFFFF;
+      for (size_t i = 0; i < rowPixels.size(); i++) {
+        rowPixels[i] = (uint8_t)name[i % strlen(name)] & 1 ? colour : 0x0000;
+      }
+    }
+    slots[list.slot(index)] = { index, index == list.selected() };
+    rowsDrawn++;
+    bytes += ROW_COMMAND_BYTES + (uint64_t)ROW_WIDTH * ROW_HEIGHT * 2;
+  }
+
+  void drawVisible() {
+    for (uint32_t i = list.top(); i < list.top() + list.visible() && i < list.count(); i++) {
+      drawRow(i);
+    }
+  }
+
+  void scroll(int32_t steps) {
+    ListUpdate update = list.move(steps);
+    if (update.full) {
+      if (list.ring()) {
+        scrolls++;
+        bytes += SCROLL_COMMAND_BYTES;
+      }
+      drawVisible();
+      return;
+    }
+    if (update.newCount > 0) {
+      scrolls++;
+      bytes += SCROLL_COMMAND_BYTES;
+      for (uint32_t i = 0; i < update.newCount; i++) {
+        drawRow(update.newFirst + i);
+      }
+    }
+    bool oldIsNew = update.oldSelected >= update.newFirst && update.oldSelected < update.newFirst + update.newCount;
+    bool selectedIsNew = update.selected >= update.newFirst && update.selected < update.newFirst + update.newCount;
+    if (update.selectionChanged && !oldIsNew) {
+      drawRow(update.oldSelected);
+    }
+    if (update.selectionChanged && !selectedIsNew) {
+      drawRow(update.selected);
+    }
+  }
+
+  // What the panel shows, line by line from the top of the list area
+  void assertShown() {
+    for (uint16_t line = 0; line < list.visible(); line++) {
+      uint32_t row = list.top() + line;
+      if (row >= list.count()) {
+        break;
+      }
+      const Slot& slot = slots[(list.scrollSlot() + line) % list.visible()];
+      if (slot.row != row || slot.highlighted != (row == list.selected())) {
+        char message[96];
+        snprintf(message, sizeof(message), "line %u shows row %u%s, expected %u%s", (unsigned)line,
+                 (unsigned)slot.row, slot.highlighted ? "*" : "", (unsigned)row, row == list.selected() ? "*" : "");
+        TEST_FAIL_MESSAGE(message);
+      }
+    }
+  }
+};
+
+struct RosterFile {
+  std::string text;
+};
+
+static bool readRoster(void* context, uint32_t offset, uint8_t* target, uint32_t length) {
+  RosterFile* file = (RosterFile*)context;
+  if ((uint64_t)offset + length > file->text.size()) {
+    return false;
+  }
+  memcpy(target, file->text.data() + offset, length);
+  return true;
+}
+
+static ListScreen screen;
+
+void setUp() {
+  screen = ListScreen();
+}
+
+void tearDown() {
+}
+
+static void test_selection_is_clamped_to_the_list() {
+  VirtualList list;
+  list.begin(5, VISIBLE_ROWS, true);
+  ListUpdate update = list.move(-3);
+  TEST_ASSERT_FALSE(update.selectionChanged);
+  TEST_ASSERT_EQUAL_UINT32(0, list.selected());
+  update = list.move(100);
+  TEST_ASSERT_TRUE(update.selectionChanged);
+  TEST_ASSERT_EQUAL_UINT32(4, list.selected());
+  TEST_ASSERT_EQUAL_INT32(0, update.scrolled);
+
+  list.begin(0, VISIBLE_ROWS, true);
+  update = list.move(1);
+  TEST_ASSERT_FALSE(update.selectionChanged);
+}
+
+static void test_moving_inside_the_view_redraws_two_rows() {
+  screen.show(1000, true);
+  screen.rowsDrawn = 0;
+  screen.scroll(3);
+  TEST_ASSERT_EQUAL_UINT32(2, screen.rowsDrawn);
+  TEST_ASSERT_EQUAL_UINT32(0, screen.scrolls);
+  TEST_ASSERT_EQUAL_UINT32(0, screen.list.top());
+  screen.assertShown();
+}
+
+static void test_one_row_scroll_draws_the_new_row_only() {
+  screen.show(1000, true);
+  screen.scroll(VISIBLE_ROWS - 1);
+  screen.rowsDrawn = 0;
+  screen.scrolls = 0;
+
+  // The new row carries the highlight, the old selection loses it
+  screen.scroll(1);
+  TEST_ASSERT_EQUAL_UINT32(1, screen.list.top());
+  TEST_ASSERT_EQUAL_UINT32(1, screen.scrolls);
+  TEST_ASSERT_EQUAL_UINT32(2, screen.rowsDrawn);
+  TEST_ASSERT_EQUAL_UINT16(1, screen.list.scrollSlot());
+  screen.assertShown();
+
+  // Upwards again at the top of the view
+  screen.scroll(-(int32_t)VISIBLE_ROWS + 1);
+  screen.rowsDrawn = 0;
+  screen.scroll(-1);
+  TEST_ASSERT_EQUAL_UINT32(0, screen.list.top());
+  TEST_ASSERT_EQUAL_UINT32(2, screen.rowsDrawn);
+  screen.assertShown();
+}
+
+static void test_a_jump_redraws_the_view() {
+  screen.show(1000, true);
+  screen.rowsDrawn = 0;
+  screen.scroll(500);
+  TEST_ASSERT_EQUAL_UINT32(VISIBLE_ROWS, screen.rowsDrawn);
+  TEST_ASSERT_EQUAL_UINT32(500 - VISIBLE_ROWS + 1, screen.list.top());
+  screen.assertShown();
+}
+
+static void test_without_hardware_scrolling_every_scroll_is_full() {
+  screen.show(1000, false);
+  screen.scroll(VISIBLE_ROWS - 1);
+  screen.rowsDrawn = 0;
+  screen.scroll(1);
+  TEST_ASSERT_EQUAL_UINT32(VISIBLE_ROWS, screen.rowsDrawn);
+  TEST_ASSERT_EQUAL_UINT16(0, screen.list.scrollSlot());
+  TEST_ASSERT_EQUAL_UINT16(0, screen.list.slot(1));
+  screen.assertShown();
+}
+
+static void test_random_encoder_turns_keep_the_screen_right() {
+  std::mt19937 random(5);
+  const uint32_t counts[] = { 1, VISIBLE_ROWS - 1, VISIBLE_ROWS, VISIBLE_ROWS + 1, 4000 };
+  for (bool ring : { true, false }) {
+    for (uint32_t count : counts) {
+      screen.show(count, ring);
+      screen.assertShown();
+      for (int turn = 0; turn < 5000; turn++) {
+        // Mostly single detents, sometimes a fast spin
+        int32_t steps = random() % 10 == 0 ? (int32_t)(random() % 41) - 20 : (random() % 2 ? 1 : -1);
+        screen.scroll(steps);
+        screen.assertShown();
+      }
+    }
+  }
+}
+
+static void test_scrolling_a_large_roster() {
+  RosterFile file;
+  std::mt19937 random(3);
+  static const char* FIRST[] = { "Anna", "Bernd", "Clara", "Dieter", "Emil", "Frieda", "Jürgen", "Özlem" };
+  static const char* LAST[] = { "Müller", "Schmidt", "Schneider", "Fischer", "Weber", "Meyer", "Wagner" };
+  const uint32_t players = 5000;
+  for (uint32_t i = 0; i < players; i++) {
+    file.text += std::string(FIRST[random() % 8]) + " " + LAST[random() % 7] + " " + std::to_string(i) + "\n";
+  }
+  std::vector<uint32_t> offsets(players);
+  PlayerRoster roster;
+  TEST_ASSERT_TRUE(roster.load(readRoster, &file, (uint32_t)file.text.size(), offsets.data(), players));
+  TEST_ASSERT_EQUAL_UINT32(players, roster.count());
+
+  // The same encoder session with and without hardware scrolling
+  double spiUs[2];
+  double hostUs[2];
+  uint32_t rows[2];
+  const int turns = 3000;
+  for (int ring = 0; ring < 2; ring++) {
+    screen = ListScreen();
+    screen.roster = &roster;
+    screen.show(players, ring == 1);
+    screen.rowsDrawn = 0;
+    screen.bytes = 0;
+    std::mt19937 turnsRandom(9);
+    auto start = std::chrono::steady_clock::now();
+    for (int turn = 0; turn < turns; turn++) {
+      screen.scroll(turnsRandom() % 4 == 0 ? -1 : 1);
+    }
+    hostUs[ring] = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / turns;
+    screen.assertShown();
+    spiUs[ring] = screen.bytes * 8.0 / SPI_HZ * 1e6 / turns;
+    rows[ring] = screen.rowsDrawn;
+  }
+
+  char line[128];
+  snprintf(line, sizeof(line), "full redraw:    %.2f rows, %7.0f us SPI, %5.1f us host per step",
+           (double)rows[0] / turns, spiUs[0], hostUs[0]);
+  TEST_MESSAGE(line);
+  snprintf(line, sizeof(line), "hardware scroll: %.2f rows, %7.0f us SPI, %5.1f us host per step",
+           (double)rows[1] / turns, spiUs[1], hostUs[1]);
+  TEST_MESSAGE(line);
+  TEST_ASSERT_LESS_OR_EQUAL(2 * turns, rows[1]);
+  TEST_ASSERT_LESS_THAN(spiUs[0] / 3, spiUs[1]);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_selection_is_clamped_to_the_list);
+  RUN_TEST(test_moving_inside_the_view_redraws_two_rows);
+  RUN_TEST(test_one_row_scroll_draws_the_new_row_only);
+  RUN_TEST(test_a_jump_redraws_the_view);
+  RUN_TEST(test_without_hardware_scrolling_every_scroll_is_full);
+  RUN_TEST(test_random_encoder_turns_keep_the_screen_right);
+  RUN_TEST(test_scrolling_a_large_roster);
+  return UNITY_END();
+}
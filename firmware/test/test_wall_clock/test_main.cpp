@@ -0,0 +1,249 @@
+/*
+  Host tests of the wall clock (wall_clock.h): SNTP bursts from a
+  simulated server against a local oscillator with a known drift, and a
+  schedule of several days with jittered, now and then asymmetric
+  network delays.
+*/
+
+#include <unity.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <atomic>
+#include <thread>
+#include "config.h"
+#include "wall_clock.h"
+
+static const int64_t UNIX_START_US = 1700000000LL * 1000000LL;
+static const double DAY_US = 86400e6;
+
+// Local oscillator running slow by driftPpm (plus a daily temperature
+// swing of wanderPpm), server delays in microseconds. Every sample adds
+// up to upJitterUs and downJitterUs; queuedUs delays one direction only.
+struct SimulatedNetwork {
+  double driftPpm;
+  int64_t upUs;
+  int64_t downUs;
+  int64_t serverProcessingUs;
+  double wanderPpm = 0.0;
+  int64_t upJitterUs = 0;
+  int64_t downJitterUs = 0;
+  int64_t queuedUpUs = 0;
+  int64_t queuedDownUs = 0;
+
+  int64_t unixAt(int64_t localUs) const {
+    // Integral of driftPpm + wanderPpm * sin(2 pi t / day)
+    double wanderUs = wanderPpm * 1e-6 * DAY_US / (2 * M_PI) * (1.0 - cos(2 * M_PI * (double)localUs / DAY_US));
+    return UNIX_START_US + localUs + (int64_t)((double)localUs * driftPpm * 1e-6 + wanderUs);
+  }
+
+  SntpSample exchange(int64_t localSendUs) const {
+    int64_t up = upUs + queuedUpUs + (upJitterUs > 0 ? rand() % upJitterUs : 0);
+    int64_t down = downUs + queuedDownUs + (downJitterUs > 0 ? rand() % downJitterUs : 0);
+    SntpSample sample;
+    sample.localSendUs = localSendUs;
+    sample.serverRecvUs = unixAt(localSendUs + up);
+    sample.serverSendUs = sample.serverRecvUs + serverProcessingUs;
+    sample.localRecvUs = localSendUs + up + serverProcessingUs + down;
+    return sample;
+  }
+};
+
+static WallClock wallClock;
+
+void setUp() {
+  wallClock.reset();
+}
+
+void tearDown() {
+}
+
+static void syncOnce(const SimulatedNetwork& network, int64_t localUs) {
+  wallClock.beginBurst();
+  TEST_ASSERT_TRUE(wallClock.addSample(network.exchange(localUs)));
+  TEST_ASSERT_TRUE(wallClock.endBurst());
+}
+
+static void test_unsynced_clock_reports_zero() {
+  TEST_ASSERT_FALSE(wallClock.isSynced());
+  TEST_ASSERT_EQUAL_INT64(0, wallClock.toUnixUs(123456));
+  TEST_ASSERT_FALSE(wallClock.endBurst());
+}
+
+static void test_first_burst_sets_the_time() {
+  SimulatedNetwork network = { 0.0, 2000, 2000, 100 };
+  syncOnce(network, 5000000);
+  TEST_ASSERT_TRUE(wallClock.isSynced());
+  TEST_ASSERT_INT64_WITHIN(10, network.unixAt(6000000), wallClock.toUnixUs(6000000));
+}
+
+static void test_burst_uses_the_sample_with_the_smallest_delay() {
+  SimulatedNetwork symmetric = { 0.0, 1000, 1000, 0 };
+  SimulatedNetwork asymmetric = { 0.0, 90000, 1000, 0 };   // Queued on the way up
+  wallClock.beginBurst();
+  TEST_ASSERT_TRUE(wallClock.addSample(asymmetric.exchange(1000000)));
+  TEST_ASSERT_TRUE(wallClock.addSample(symmetric.exchange(2000000)));
+  TEST_ASSERT_TRUE(wallClock.addSample(asymmetric.exchange(3000000)));
+  TEST_ASSERT_TRUE(wallClock.endBurst());
+  TEST_ASSERT_EQUAL_INT64(2000, wallClock.lastDelayUs());
+  TEST_ASSERT_INT64_WITHIN(10, symmetric.unixAt(4000000), wallClock.toUnixUs(4000000));
+}
+
+static void test_implausible_samples_are_dropped() {
+  SimulatedNetwork network = { 0.0, 1000, 1000, 0 };
+  SntpSample negative = network.exchange(1000000);
+  negative.serverSendUs = negative.serverRecvUs + 10000;   // Server claims more time than the round trip
+  TEST_ASSERT_FALSE(wallClock.addSample(negative));
+
+  SimulatedNetwork slow = { 0.0, WALL_CLOCK_MAX_DELAY_MS * 1000, 1000, 0 };
+  TEST_ASSERT_FALSE(wallClock.addSample(slow.exchange(2000000)));
+  TEST_ASSERT_FALSE(wallClock.endBurst());
+}
+
+static void test_drift_is_learned_and_predicted() {
+  SimulatedNetwork network = { 80.0, 1500, 1500, 50 };
+  int64_t localUs = 1000000;
+  for (int burst = 0; burst < 8; burst++) {
+    syncOnce(network, localUs);
+    localUs += (int64_t)wallClock.pollIntervalS() * 1000000LL;
+  }
+  TEST_ASSERT_FLOAT_WITHIN(2.0, 80.0, wallClock.driftPpm());
+
+  // One hour without a sync stays well within the target error
+  int64_t laterUs = localUs + 3600LL * 1000000LL;
+  TEST_ASSERT_INT64_WITHIN(WALL_CLOCK_TARGET_ERROR_MS * 1000, network.unixAt(laterUs), wallClock.toUnixUs(laterUs));
+}
+
+static void test_poll_interval_grows_while_the_prediction_holds() {
+  SimulatedNetwork network = { 0.0, 1000, 1000, 0 };
+  int64_t localUs = 1000000;
+  for (int burst = 0; burst < 20; burst++) {
+    syncOnce(network, localUs);
+    localUs += (int64_t)wallClock.pollIntervalS() * 1000000LL;
+  }
+  TEST_ASSERT_EQUAL_UINT32(WALL_CLOCK_MAX_POLL_S, wallClock.pollIntervalS());
+}
+
+static void test_large_error_steps_and_restarts_the_estimation() {
+  SimulatedNetwork network = { 50.0, 1000, 1000, 0 };
+  syncOnce(network, 1000000);
+  syncOnce(network, 200000000);
+  TEST_ASSERT_TRUE(wallClock.driftPpm() != 0.0);
+
+  // Server jumps by a minute, e.g. after its own reboot
+  SimulatedNetwork jumped = network;
+  jumped.driftPpm = 50.0;
+  SntpSample sample = jumped.exchange(400000000);
+  sample.serverRecvUs += 60000000;
+  sample.serverSendUs += 60000000;
+  wallClock.beginBurst();
+  TEST_ASSERT_TRUE(wallClock.addSample(sample));
+  TEST_ASSERT_TRUE(wallClock.endBurst());
+  TEST_ASSERT_TRUE(wallClock.driftPpm() == 0.0);
+  TEST_ASSERT_EQUAL_UINT32(WALL_CLOCK_MIN_POLL_S, wallClock.pollIntervalS());
+  TEST_ASSERT_INT64_WITHIN(10, network.unixAt(400002000) + 60000000, wallClock.toUnixUs(400002000));
+}
+
+static void test_readers_never_see_a_torn_time_base() {
+  // Without drift every time base maps the same local time to the same
+  // Unix time, a mix of two of them would not
+  SimulatedNetwork network = { 0.0, 1000, 1000, 0 };
+  syncOnce(network, 1000);
+  const int64_t probeUs = 500000000;
+  const int64_t expected = wallClock.toUnixUs(probeUs);
+  std::atomic<bool> done(false);
+  std::atomic<uint32_t> torn(0);
+
+  std::thread reader([&]() {
+    while (!done.load()) {
+      if (wallClock.toUnixUs(probeUs) != expected) {
+        torn.fetch_add(1);
+      }
+    }
+  });
+  for (int64_t burst = 1; burst <= 200000; burst++) {
+    syncOnce(network, 1000 + burst * 1000);
+  }
+  done.store(true);
+  reader.join();
+  TEST_ASSERT_EQUAL_UINT32(0, torn.load());
+}
+
+// Bursts every WALL_CLOCK_MAX_POLL_S, the longest the clock ever runs on
+// its own, over a Wi-Fi link with jitter and congested bursts in which
+// every sample queues in one direction
+static void test_days_at_the_longest_poll_interval_stay_within_a_second() {
+  srand(26);
+  const int days = 5;
+  const int64_t pollUs = (int64_t)WALL_CLOCK_MAX_POLL_S * 1000000LL;
+  const int64_t checkUs = 60LL * 1000000LL;
+  SimulatedNetwork network = { 45.0, 3000, 3000, 200, 3.0, 40000, 40000 };
+
+  int64_t localUs = 1000000;
+  int64_t nextBurstUs = localUs;
+  int64_t maxErrorUs = 0;
+  int64_t maxLearnedErrorUs = 0;   // From the second day on, with the drift learned
+  int64_t maxDelayUs = 0;
+  uint32_t bursts = 0;
+  uint32_t congested = 0;
+  uint32_t timeouts = 0;
+  while (localUs < days * (int64_t)DAY_US) {
+    if (localUs >= nextBurstUs) {
+      network.queuedUpUs = 0;
+      network.queuedDownUs = 0;
+      if (rand() % 5 == 0) {
+        // Upload or download queued behind other traffic for the whole burst
+        (rand() % 2 ? network.queuedUpUs : network.queuedDownUs) = 20000 + rand() % 180000;
+        congested++;
+      }
+      wallClock.beginBurst();
+      int64_t sendUs = localUs;
+      for (int i = 0; i < WALL_CLOCK_BURST_SIZE; i++) {
+        SntpSample sample = network.exchange(sendUs);
+        if (sample.localRecvUs - sendUs < (int64_t)NTP_TIMEOUT_MS * 1000) {
+          wallClock.addSample(sample);
+          sendUs = sample.localRecvUs;
+        } else {
+          timeouts++;
+          sendUs += (int64_t)NTP_TIMEOUT_MS * 1000;
+        }
+      }
+      TEST_ASSERT_TRUE(wallClock.endBurst());
+      bursts++;
+      maxDelayUs = wallClock.lastDelayUs() > maxDelayUs ? wallClock.lastDelayUs() : maxDelayUs;
+      nextBurstUs = localUs + pollUs;
+    }
+    localUs += checkUs;
+    int64_t errorUs = wallClock.toUnixUs(localUs) - network.unixAt(localUs);
+    errorUs = errorUs < 0 ? -errorUs : errorUs;
+    maxErrorUs = errorUs > maxErrorUs ? errorUs : maxErrorUs;
+    if (localUs > (int64_t)DAY_US && errorUs > maxLearnedErrorUs) {
+      maxLearnedErrorUs = errorUs;
+    }
+  }
+
+  char line[200];
+  snprintf(line, sizeof(line),
+           "%d days, %u bursts every %u s (%u congested, %u timeouts): max error %lld ms, "
+           "%lld ms after the first day, max delay %lld ms, drift %.1f ppm",
+           days, (unsigned)bursts, (unsigned)WALL_CLOCK_MAX_POLL_S, (unsigned)congested, (unsigned)timeouts,
+           (long long)(maxErrorUs / 1000), (long long)(maxLearnedErrorUs / 1000), (long long)(maxDelayUs / 1000),
+           wallClock.driftPpm());
+  TEST_MESSAGE(line);
+  TEST_ASSERT_GREATER_THAN(0, congested);
+  TEST_ASSERT_LESS_THAN_INT64(1000000, maxErrorUs);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_unsynced_clock_reports_zero);
+  RUN_TEST(test_first_burst_sets_the_time);
+  RUN_TEST(test_burst_uses_the_sample_with_the_smallest_delay);
+  RUN_TEST(test_implausible_samples_are_dropped);
+  RUN_TEST(test_drift_is_learned_and_predicted);
+  RUN_TEST(test_poll_interval_grows_while_the_prediction_holds);
+  RUN_TEST(test_large_error_steps_and_restarts_the_estimation);
+  RUN_TEST(test_readers_never_see_a_torn_time_base);
+  RUN_TEST(test_days_at_the_longest_poll_interval_stay_within_a_second);
+  return UNITY_END();
+}
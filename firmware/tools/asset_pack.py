@@ -0,0 +1,317 @@
+#!/usr/bin/env python3
+"""
+Asset packer for Chess Clock
+
+Packs images and animations into one CAP1 blob that is uploaded to SPIFFS
+(data/assets.cap, "pio run -t uploadfs"). The clock decodes an asset band
+by band straight into the DMA buffers of the SPI bus, see src/assets.cpp
+and src/asset_pack.cpp; a whole frame is never held in RAM.
+
+Blob layout (little endian):
+  "CAP1", window bits (u8), lookahead bits (u8), asset count (u16),
+  asset count index entries:
+    name (16 bytes, zero padded), width (u16), height (u16), frames (u16),
+    palette size (u16, 0 = RGB565 pixels), palette offset (u32),
+    frame table offset (u32)
+  followed by the palettes, frame tables and frame data.
+
+Colours are RGB565 with the high byte first (display byte order). Assets
+with up to 256 colours store one palette index byte per pixel, others two
+bytes per pixel. Every frame is compressed on its own with the LZSS bit
+stream of delta_patch.py, so the previous row (and runs) cost only a few
+bits. The frame table holds frames + 1 offsets, the last one is the end
+of the last frame.
+
+Images are 8 bit PNG (grey, RGB, palette, with or without alpha) or
+binary PPM. Transparent pixels are blended onto the background colour.
+
+Usage:
+  asset_pack.py pack out.cap logo=logo.png spinner=s0.png,s1.png,s2.png
+  asset_pack.py list assets.cap
+  asset_pack.py verify assets.cap [logo=logo.png ...]
+"""
+
+import argparse
+import struct
+import sys
+import time
+import zlib
+
+from delta_patch import lzss_compress, lzss_stream
+
+MAGIC = b"CAP1"
+HEADER = struct.Struct("<4sBBH")
+ENTRY = struct.Struct("<16sHHHHII")
+WINDOW_BITS = 11            # ASSET_MAX_WINDOW_BITS on the device
+LOOKAHEAD_BITS = 6
+NAME_LENGTH = 16
+
+
+# --- image loading -----------------------------------------------------------
+
+def paeth(a, b, c):
+    p = a + b - c
+    pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+    if pa <= pb and pa <= pc:
+        return a
+    return b if pb <= pc else c
+
+
+def load_png(data):
+    if data[:8] != b"\x89PNG\r\n\x1a\n":
+        raise ValueError("not a PNG file")
+    pos = 8
+    idat = bytearray()
+    palette = []
+    transparency = b""
+    while pos < len(data):
+        length, kind = struct.unpack_from(">I4s", data, pos)
+        chunk = data[pos + 8:pos + 8 + length]
+        pos += 12 + length
+        if kind == b"IHDR":
+            width, height, depth, color_type, _, _, interlace = struct.unpack(">IIBBBBB", chunk)
+        elif kind == b"PLTE":
+            palette = [tuple(chunk[i:i + 3]) for i in range(0, len(chunk), 3)]
+        elif kind == b"tRNS":
+            transparency = chunk
+        elif kind == b"IDAT":
+            idat += chunk
+        elif kind == b"IEND":
+            break
+    if depth != 8 or interlace != 0:
+        raise ValueError("only 8 bit, non-interlaced PNG files are supported")
+
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}[color_type]
+    stride = width * channels
+    raw = zlib.decompress(bytes(idat))
+    rows = []
+    previous = bytearray(stride)
+    for y in range(height):
+        kind = raw[y * (stride + 1)]
+        line = bytearray(raw[y * (stride + 1) + 1:(y + 1) * (stride + 1)])
+        for i in range(stride):
+            left = line[i - channels] if i >= channels else 0
+            up = previous[i]
+            upper_left = previous[i - channels] if i >= channels else 0
+            if kind == 1:
+                line[i] = (line[i] + left) & 0xFF
+            elif kind == 2:
+                line[i] = (line[i] + up) & 0xFF
+            elif kind == 3:
+                line[i] = (line[i] + ((left + up) >> 1)) & 0xFF
+            elif kind == 4:
+                line[i] = (line[i] + paeth(left, up, upper_left)) & 0xFF
+        rows.append(line)
+        previous = line
+
+    pixels = []
+    for line in rows:
+        for x in range(width):
+            p = line[x * channels:(x + 1) * channels]
+            if color_type == 0:
+                pixels.append((p[0], p[0], p[0], 255))
+            elif color_type == 2:
+                pixels.append((p[0], p[1], p[2], 255))
+            elif color_type == 3:
+                alpha = transparency[p[0]] if p[0] < len(transparency) else 255
+                pixels.append(palette[p[0]] + (alpha,))
+            elif color_type == 4:
+                pixels.append((p[0], p[0], p[0], p[1]))
+            else:
+                pixels.append(tuple(p))
+    return width, height, pixels
+
+
+def load_ppm(data):
+    fields = []
+    pos = 2
+    while len(fields) < 3:
+        while data[pos:pos + 1].isspace():
+            pos += 1
+        if data[pos:pos + 1] == b"#":
+            pos = data.index(b"\n", pos)
+            continue
+        start = pos
+        while not data[pos:pos + 1].isspace():
+            pos += 1
+        fields.append(int(data[start:pos]))
+    width, height, maximum = fields
+    if maximum != 255:
+        raise ValueError("only 8 bit PPM files are supported")
+    pos += 1
+    body = data[pos:pos + width * height * 3]
+    return width, height, [tuple(body[i:i + 3]) + (255,) for i in range(0, len(body), 3)]
+
+
+def load_image(path):
+    with open(path, "rb") as f:
+        data = f.read()
+    if data[:2] == b"P6":
+        return load_ppm(data)
+    return load_png(data)
+
+
+def to_rgb565(pixel, background):
+    r, g, b, a = pixel
+    if a != 255:
+        r = (r * a + background[0] * (255 - a)) // 255
+        g = (g * a + background[1] * (255 - a)) // 255
+        b = (b * a + background[2] * (255 - a)) // 255
+    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3)
+
+
+# --- packing -----------------------------------------------------------------
+
+def encode_asset(name, paths, background):
+    frames = []
+    size = None
+    for path in paths:
+        width, height, pixels = load_image(path)
+        if size is not None and size != (width, height):
+            raise ValueError(f"{path}: all frames of '{name}' must have the same size")
+        size = (width, height)
+        frames.append([to_rgb565(p, background) for p in pixels])
+
+    colours = sorted({c for frame in frames for c in frame})
+    if len(colours) <= 256:
+        lookup = {c: i for i, c in enumerate(colours)}
+        palette = b"".join(struct.pack(">H", c) for c in colours)
+        data = [bytes(lookup[c] for c in frame) for frame in frames]
+    else:
+        colours = []
+        palette = b""
+        data = [b"".join(struct.pack(">H", c) for c in frame) for frame in frames]
+    return {
+        "name": name,
+        "width": size[0],
+        "height": size[1],
+        "palette_size": len(colours),
+        "palette": palette,
+        "frames": [lzss_compress(d, WINDOW_BITS, LOOKAHEAD_BITS) for d in data],
+        "raw_size": size[0] * size[1] * 2 * len(frames),
+    }
+
+
+def pack(assets):
+    offset = HEADER.size + ENTRY.size * len(assets)
+    index = bytearray()
+    body = bytearray()
+    for asset in assets:
+        palette_offset = offset + len(body)
+        body += asset["palette"]
+        table_offset = offset + len(body)
+        data_offset = table_offset + 4 * (len(asset["frames"]) + 1)
+        table = bytearray()
+        for frame in asset["frames"]:
+            table += struct.pack("<I", data_offset)
+            data_offset += len(frame)
+        table += struct.pack("<I", data_offset)
+        body += table
+        for frame in asset["frames"]:
+            body += frame
+        index += ENTRY.pack(asset["name"].encode()[:NAME_LENGTH], asset["width"], asset["height"],
+                            len(asset["frames"]), asset["palette_size"], palette_offset, table_offset)
+    return HEADER.pack(MAGIC, WINDOW_BITS, LOOKAHEAD_BITS, len(assets)) + bytes(index) + bytes(body)
+
+
+# --- reading -----------------------------------------------------------------
+
+def read_index(blob):
+    magic, window_bits, lookahead_bits, count = HEADER.unpack_from(blob)
+    if magic != MAGIC:
+        raise ValueError("not a CAP1 asset pack")
+    assets = []
+    for i in range(count):
+        name, width, height, frames, palette_size, palette_offset, table_offset = \
+            ENTRY.unpack_from(blob, HEADER.size + i * ENTRY.size)
+        table = struct.unpack_from(f"<{frames + 1}I", blob, table_offset)
+        assets.append({
+            "name": name.rstrip(b"\0").decode(),
+            "width": width,
+            "height": height,
+            "palette_size": palette_size,
+            "palette": [struct.unpack_from(">H", blob, palette_offset + 2 * c)[0] for c in range(palette_size)],
+            "frames": [blob[table[f]:table[f + 1]] for f in range(frames)],
+        })
+    return window_bits, lookahead_bits, assets
+
+
+def decode_frame(asset, frame, window_bits, lookahead_bits):
+    """RGB565 values of one frame, decoded like the clock does it."""
+    count = asset["width"] * asset["height"] * (1 if asset["palette_size"] else 2)
+    stream = lzss_stream(asset["frames"][frame], window_bits, lookahead_bits)
+    data = bytes(next(stream) for _ in range(count))
+    if asset["palette_size"]:
+        return [asset["palette"][i] for i in data]
+    return [(data[i] << 8) | data[i + 1] for i in range(0, len(data), 2)]
+
+
+def parse_specs(specs):
+    result = []
+    for spec in specs:
+        name, _, paths = spec.partition("=")
+        if not paths or len(name.encode()) > NAME_LENGTH:
+            raise ValueError(f"'{spec}': expected name=image[,image...] with a name of max. {NAME_LENGTH} bytes")
+        result.append((name, paths.split(",")))
+    return result
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    sub = parser.add_subparsers(dest="command", required=True)
+    make = sub.add_parser("pack", help="create an asset pack")
+    make.add_argument("out")
+    make.add_argument("assets", nargs="+", metavar="name=image[,image...]")
+    make.add_argument("--background", default="000000", help="colour behind transparent pixels (RRGGBB)")
+    listing = sub.add_parser("list", help="show the assets of a pack")
+    listing.add_argument("pack")
+    verify = sub.add_parser("verify", help="decode every frame, compare with the images and time it")
+    verify.add_argument("pack")
+    verify.add_argument("assets", nargs="*", metavar="name=image[,image...]")
+    verify.add_argument("--background", default="000000")
+    args = parser.parse_args()
+
+    if args.command == "pack":
+        background = bytes.fromhex(args.background)
+        assets = [encode_asset(name, paths, background) for name, paths in parse_specs(args.assets)]
+        blob = pack(assets)
+        with open(args.out, "wb") as f:
+            f.write(blob)
+        raw = sum(a["raw_size"] for a in assets)
+        print(f"{args.out}: {len(assets)} assets, {len(blob)} bytes ({100.0 * len(blob) / raw:.1f} % of raw RGB565)")
+
+    elif args.command == "list":
+        with open(args.pack, "rb") as f:
+            _, _, assets = read_index(f.read())
+        for a in assets:
+            size = sum(len(frame) for frame in a["frames"])
+            colours = f"{a['palette_size']} colours" if a["palette_size"] else "RGB565"
+            print(f"{a['name']:16s} {a['width']:4d} x {a['height']:<4d} {len(a['frames']):3d} frames  "
+                  f"{colours:12s} {size:8d} bytes")
+
+    elif args.command == "verify":
+        with open(args.pack, "rb") as f:
+            window_bits, lookahead_bits, assets = read_index(f.read())
+        expected = {}
+        background = bytes.fromhex(args.background)
+        for name, paths in parse_specs(args.assets):
+            expected[name] = [[to_rgb565(p, background) for p in load_image(path)[2]] for path in paths]
+
+        pixels = 0
+        start = time.time()
+        for a in assets:
+            for frame in range(len(a["frames"])):
+                decoded = decode_frame(a, frame, window_bits, lookahead_bits)
+                pixels += len(decoded)
+                if a["name"] in expected and decoded != expected[a["name"]][frame]:
+                    print(f"FAILED: {a['name']} frame {frame} differs from its image")
+                    return 1
+        elapsed = max(time.time() - start, 1e-6)
+        print(f"{len(assets)} assets, {pixels} pixels decoded, {pixels / elapsed / 1e6:.2f} Mpixel/s (Python)")
+        if expected:
+            print(f"{len(expected)} assets match their images")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
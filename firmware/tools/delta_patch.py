@@ -0,0 +1,363 @@
+#!/usr/bin/env python3
+"""
+Delta patch tool for Chess Clock OTA updates
+
+Creates and applies CDP1 delta patches between two firmware images
+(.pio/build/<env>/firmware.bin). The clock applies a patch while streaming
+it from the running image in app0/app1 into the inactive slot, see
+src/ota_delta.cpp and src/delta_patch.cpp.
+
+Patch layout (little endian):
+  "CDP1", window bits (u8), lookahead bits (u8), reserved (u16),
+  old size (u32), new size (u32), SHA-256 old image, SHA-256 new image,
+  followed by the LZSS compressed body.
+
+The body is a bsdiff-like sequence of records:
+  add length (varint), extra length (varint), old seek (zigzag varint),
+  add length diff bytes (new = old + diff), extra length literal bytes.
+
+Usage:
+  delta_patch.py make old.bin new.bin patch.cdp
+  delta_patch.py apply old.bin patch.cdp out.bin
+  delta_patch.py verify old.bin new.bin [patch.cdp]
+"""
+
+import argparse
+import hashlib
+import struct
+import sys
+import time
+
+MAGIC = b"CDP1"
+HEADER = struct.Struct("<4sBBHII32s32s")
+WINDOW_BITS = 11            # 2 KB history on the device
+LOOKAHEAD_BITS = 6
+MIN_MATCH = 3               # Shorter back references cost more than literals
+
+KMER = 8                    # Bytes used to find a matching region in the old image
+MIN_REGION = 16             # Shortest region worth an add record
+APP_DESC_OFFSET = 32        # esp_app_desc_t behind image and segment header
+ELF_SHA_OFFSET = APP_DESC_OFFSET + 144
+
+
+# --- varints -----------------------------------------------------------------
+
+def put_varint(out, value):
+    while True:
+        byte = value & 0x7F
+        value >>= 7
+        if value:
+            out.append(byte | 0x80)
+        else:
+            out.append(byte)
+            return
+
+
+def put_svarint(out, value):
+    put_varint(out, (value << 1) if value >= 0 else ((-value << 1) - 1))
+
+
+# --- region matching (bsdiff-like) --------------------------------------------
+
+def extend(old, new, old_pos, new_pos):
+    """Length of the approximate match that maximizes 2 * equal - length."""
+    limit = min(len(old) - old_pos, len(new) - new_pos)
+    score = 0
+    best_score = 0
+    best_length = 0
+    for i in range(limit):
+        if old[old_pos + i] == new[new_pos + i]:
+            score += 1
+            if score > best_score:
+                best_score = score
+                best_length = i + 1
+        else:
+            score -= 1
+            if score < best_score - 64:
+                break
+    return best_length
+
+
+def find_regions(old, new):
+    index = {}
+    for pos in range(len(old) - KMER + 1):
+        index.setdefault(old[pos:pos + KMER], pos)
+
+    regions = []
+    new_pos = 0
+    delta = 0
+    while new_pos < len(new) - KMER:
+        candidates = []
+        predicted = new_pos + delta
+        if 0 <= predicted < len(old):
+            candidates.append(predicted)
+        found = index.get(new[new_pos:new_pos + KMER])
+        if found is not None and found != predicted:
+            candidates.append(found)
+
+        best = None
+        for old_pos in candidates:
+            length = extend(old, new, old_pos, new_pos)
+            if length >= MIN_REGION and (best is None or length > best[1]):
+                best = (old_pos, length)
+
+        if best is None:
+            new_pos += 1
+            continue
+        regions.append((new_pos, best[0], best[1]))
+        delta = best[0] - new_pos
+        new_pos += best[1]
+    return regions
+
+
+def build_body(old, new, regions):
+    body = bytearray()
+
+    # Leading literal bytes before the first region
+    first_new = regions[0][0] if regions else len(new)
+    first_old = regions[0][1] if regions else 0
+    put_varint(body, 0)
+    put_varint(body, first_new)
+    put_svarint(body, first_old)
+    body += new[:first_new]
+
+    for i, (region_new, region_old, length) in enumerate(regions):
+        next_new = regions[i + 1][0] if i + 1 < len(regions) else len(new)
+        next_old = regions[i + 1][1] if i + 1 < len(regions) else region_old + length
+        extra = next_new - (region_new + length)
+
+        put_varint(body, length)
+        put_varint(body, extra)
+        put_svarint(body, next_old - (region_old + length))
+        body += bytes((new[region_new + j] - old[region_old + j]) & 0xFF for j in range(length))
+        body += new[region_new + length:next_new]
+    return bytes(body)
+
+
+# --- LZSS (heatshrink-like bit stream) ---------------------------------------
+
+class BitWriter:
+    def __init__(self):
+        self.out = bytearray()
+        self.value = 0
+        self.bits = 0
+
+    def write(self, value, count):
+        for shift in range(count - 1, -1, -1):
+            self.value = (self.value << 1) | ((value >> shift) & 1)
+            self.bits += 1
+            if self.bits == 8:
+                self.out.append(self.value)
+                self.value = 0
+                self.bits = 0
+
+    def finish(self):
+        if self.bits:
+            self.out.append(self.value << (8 - self.bits))
+        return bytes(self.out)
+
+
+def lzss_compress(data, window_bits=WINDOW_BITS, lookahead_bits=LOOKAHEAD_BITS):
+    window = 1 << window_bits
+    max_match = (1 << lookahead_bits) + MIN_MATCH - 1
+    chains = {}
+    writer = BitWriter()
+    pos = 0
+    length = len(data)
+
+    while pos < length:
+        best_length = 0
+        best_distance = 0
+
+        # Runs are very common in the diff bytes, check distance 1 first
+        if pos > 0:
+            run = 0
+            while run < max_match and pos + run < length and data[pos + run] == data[pos - 1]:
+                run += 1
+            if run >= MIN_MATCH:
+                best_length, best_distance = run, 1
+
+        key = data[pos:pos + MIN_MATCH]
+        candidates = chains.get(key, ())
+        if best_length < max_match:
+            for candidate in reversed(candidates):
+                distance = pos - candidate
+                if distance > window:
+                    break
+                match = 0
+                while match < max_match and pos + match < length and data[candidate + match] == data[pos + match]:
+                    match += 1
+                if match > best_length:
+                    best_length, best_distance = match, distance
+                    if match == max_match:
+                        break
+
+        step = best_length if best_length >= MIN_MATCH else 1
+        if best_length >= MIN_MATCH:
+            writer.write(0, 1)
+            writer.write(best_distance - 1, window_bits)
+            writer.write(best_length - MIN_MATCH, lookahead_bits)
+        else:
+            writer.write(1, 1)
+            writer.write(data[pos], 8)
+
+        for p in range(pos, min(pos + step, length - MIN_MATCH + 1)):
+            chain = chains.setdefault(data[p:p + MIN_MATCH], [])
+            chain.append(p)
+            if len(chain) > 16:
+                del chain[0]
+        pos += step
+
+    return writer.finish()
+
+
+def lzss_stream(data, window_bits, lookahead_bits):
+    """Yields the decompressed bytes one by one with a bounded history."""
+    window = 1 << window_bits
+    history = bytearray(window)
+    head = 0
+    value = 0
+    bits = 0
+    pos = 0
+
+    def read(count):
+        nonlocal value, bits, pos
+        while bits < count:
+            if pos >= len(data):
+                raise EOFError("patch body is truncated")
+            value = ((value << 8) | data[pos]) & 0xFFFFFFFF
+            pos += 1
+            bits += 8
+        bits -= count
+        return (value >> bits) & ((1 << count) - 1)
+
+    while True:
+        if read(1):
+            literal = read(8)
+            history[head] = literal
+            head = (head + 1) % window
+            yield literal
+        else:
+            distance = read(window_bits) + 1
+            count = read(lookahead_bits) + MIN_MATCH
+            for _ in range(count):
+                byte = history[(head - distance) % window]
+                history[head] = byte
+                head = (head + 1) % window
+                yield byte
+
+
+# --- patch files -------------------------------------------------------------
+
+def make_patch(old, new):
+    body = build_body(old, new, find_regions(old, new))
+    header = HEADER.pack(MAGIC, WINDOW_BITS, LOOKAHEAD_BITS, 0, len(old), len(new),
+                         hashlib.sha256(old).digest(), hashlib.sha256(new).digest())
+    return header + lzss_compress(body), len(body)
+
+
+def apply_patch(old, patch):
+    magic, window_bits, lookahead_bits, _, old_size, new_size, old_sha, new_sha = HEADER.unpack_from(patch)
+    if magic != MAGIC:
+        raise ValueError("not a CDP1 patch")
+    if len(old) < old_size or hashlib.sha256(old[:old_size]).digest() != old_sha:
+        raise ValueError("patch does not belong to this old image")
+
+    stream = lzss_stream(patch[HEADER.size:], window_bits, lookahead_bits)
+    next_byte = stream.__next__
+
+    def varint():
+        value = 0
+        shift = 0
+        while True:
+            byte = next_byte()
+            value |= (byte & 0x7F) << shift
+            shift += 7
+            if not byte & 0x80:
+                return value
+
+    new = bytearray()
+    old_pos = 0
+    while len(new) < new_size:
+        add = varint()
+        extra = varint()
+        seek = varint()
+        seek = (seek >> 1) if not seek & 1 else -((seek + 1) >> 1)
+        for i in range(add):
+            new.append((old[old_pos + i] + next_byte()) & 0xFF)
+        old_pos += add
+        for _ in range(extra):
+            new.append(next_byte())
+        old_pos += seek
+
+    if hashlib.sha256(new).digest() != new_sha:
+        raise ValueError("result does not match the new image")
+    return bytes(new)
+
+
+def patch_name(old):
+    """Name under which the clock running 'old' looks for its patch."""
+    return old[ELF_SHA_OFFSET:ELF_SHA_OFFSET + 8].hex() + ".cdp"
+
+
+def read(path):
+    with open(path, "rb") as f:
+        return f.read()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    sub = parser.add_subparsers(dest="command", required=True)
+    make = sub.add_parser("make", help="create a patch")
+    make.add_argument("old")
+    make.add_argument("new")
+    make.add_argument("patch", nargs="?", help="default: name expected by the clock")
+    apply = sub.add_parser("apply", help="apply a patch to an image file")
+    apply.add_argument("old")
+    apply.add_argument("patch")
+    apply.add_argument("out")
+    verify = sub.add_parser("verify", help="round-trip a patch and report the savings")
+    verify.add_argument("old")
+    verify.add_argument("new")
+    verify.add_argument("patch", nargs="?", help="existing patch, created if omitted")
+    args = parser.parse_args()
+
+    if args.command == "make":
+        old = read(args.old)
+        patch, _ = make_patch(old, read(args.new))
+        path = args.patch or patch_name(old)
+        with open(path, "wb") as f:
+            f.write(patch)
+        print(f"{path}: {len(patch)} bytes")
+
+    elif args.command == "apply":
+        new = apply_patch(read(args.old), read(args.patch))
+        with open(args.out, "wb") as f:
+            f.write(new)
+        print(f"{args.out}: {len(new)} bytes")
+
+    elif args.command == "verify":
+        old = read(args.old)
+        new = read(args.new)
+        start = time.time()
+        if args.patch:
+            patch = read(args.patch)
+            body_size = None
+        else:
+            patch, body_size = make_patch(old, new)
+        made = time.time()
+        if apply_patch(old, patch) != new:
+            print("FAILED: patched image differs from the new image")
+            return 1
+        applied = time.time()
+        print(f"new image:   {len(new):9d} bytes")
+        if body_size is not None:
+            print(f"patch body:  {body_size:9d} bytes (uncompressed)")
+        print(f"patch:       {len(patch):9d} bytes ({100.0 * len(patch) / len(new):.1f} % of a full image)")
+        print(f"saved:       {len(new) - len(patch):9d} bytes per clock")
+        print(f"make {made - start:.1f} s, apply {applied - made:.1f} s")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
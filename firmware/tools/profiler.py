@@ -0,0 +1,199 @@
+#!/usr/bin/env python3
+"""
+Profile symbolizer for Chess Clock
+
+Turns the samples of the on-device profiler (PROFILER_ENABLED, see
+src/profiler.cpp) into a flat profile and a flame graph. Capture the
+serial output while the clock runs, e.g.
+
+  pio device monitor > capture.log
+
+and pass the log together with the ELF of the same build
+(.pio/build/esp32-s3/firmware.elf). Lines of the profiler start with "@",
+everything else in the log is ignored:
+
+  @T <id> <task name>
+  @S <core> <id> <pc hex>
+  @D <core> <dropped>
+
+PCs are resolved to functions with the symbol table of the ELF (nm of
+the Xtensa toolchain). The profiler records no call stacks, so the flame
+graph has the levels core, task and function.
+
+Usage:
+  profiler.py flat capture.log firmware.elf [--top 40] [--core 0]
+  profiler.py flame capture.log firmware.elf -o profile.svg [--collapsed stacks.txt]
+"""
+
+import argparse
+import bisect
+import collections
+import re
+import subprocess
+import sys
+import zlib
+
+SAMPLE = re.compile(r"@S (\d) (\d+) ([0-9a-fA-F]{8})")
+TASK = re.compile(r"@T (\d+) (\S+)")
+DROPPED = re.compile(r"@D (\d) (\d+)")
+ROM_END = 0x40060000        # Functions below are in the mask ROM, not in the ELF
+
+
+# --- symbols -----------------------------------------------------------------
+
+class Symbols:
+    def __init__(self, elf, nm):
+        output = subprocess.run([nm, "-n", "-S", "-C", "--defined-only", elf], check=True,
+                                capture_output=True, text=True).stdout
+        self.starts, self.ends, self.names = [], [], []
+        for line in output.splitlines():
+            parts = line.split(None, 3)
+            if len(parts) == 4 and parts[2] in "tTwW":
+                address, size, name = int(parts[0], 16), int(parts[1], 16), parts[3]
+            elif len(parts) == 3 and parts[1] in "tTwW":
+                address, size, name = int(parts[0], 16), 0, parts[2]
+            else:
+                continue
+            self.starts.append(address)
+            self.ends.append(address + size if size else None)
+            self.names.append(name)
+
+    def lookup(self, pc):
+        if pc < ROM_END:
+            return "[rom]"
+        i = bisect.bisect_right(self.starts, pc) - 1
+        if i < 0:
+            return "[unknown]"
+        end = self.ends[i]
+        if end is not None and pc >= end:
+            return "[unknown]"
+        return self.names[i]
+
+
+# --- capture -----------------------------------------------------------------
+
+def read_capture(path):
+    tasks = {}
+    samples = []
+    dropped = collections.Counter()
+    with open(path, errors="replace") as f:
+        for line in f:
+            match = SAMPLE.search(line)
+            if match:
+                samples.append((int(match.group(1)), int(match.group(2)), int(match.group(3), 16)))
+                continue
+            match = TASK.search(line)
+            if match:
+                tasks[int(match.group(1))] = match.group(2)
+                continue
+            match = DROPPED.search(line)
+            if match:
+                dropped[int(match.group(1))] = int(match.group(2))
+    return tasks, samples, dropped
+
+
+def symbolize(samples, tasks, symbols, core=None):
+    counts = collections.Counter()
+    for sample_core, task, pc in samples:
+        if core is None or sample_core == core:
+            counts[(sample_core, tasks.get(task, f"task{task}"), symbols.lookup(pc))] += 1
+    return counts
+
+
+# --- flame graph -------------------------------------------------------------
+
+def colour(name):
+    h = zlib.crc32(name.encode())
+    return f"rgb({205 + h % 50},{80 + (h >> 8) % 120},{(h >> 16) % 60})"
+
+
+def flame_svg(counts, width=1200, row=18):
+    total = sum(counts.values())
+    tree = {}
+    for stack, count in counts.items():
+        node = tree
+        for frame in stack:
+            entry = node.setdefault(frame, [0, {}])
+            entry[0] += count
+            node = entry[1]
+
+    depth = max(len(stack) for stack in counts) + 1
+    height = depth * row + 30
+    parts = [f'<svg xmlns="http://www.w3.org/2000/svg" width="{width}" height="{height}" '
+             f'font-family="monospace" font-size="11">',
+             f'<text x="4" y="14">{total} samples</text>']
+
+    def emit(node, x, level):
+        for name, (count, children) in sorted(node.items()):
+            w = width * count / total
+            y = height - (level + 1) * row
+            label = f"{name} ({count}, {100.0 * count / total:.1f} %)"
+            label = label.replace("&", "&amp;").replace("<", "&lt;").replace(">", "&gt;")
+            parts.append(f'<g><title>{label}</title><rect x="{x:.2f}" y="{y}" width="{max(w - 0.5, 0.1):.2f}" '
+                         f'height="{row - 1}" fill="{colour(str(name))}"/>')
+            if w > 40:
+                chars = int(w / 7)
+                text = label if len(label) <= chars else label[:max(chars - 2, 0)] + ".."
+                parts.append(f'<text x="{x + 3:.2f}" y="{y + row - 5}">{text}</text>')
+            parts.append("</g>")
+            emit(children, x, level + 1)
+            x += w
+
+    emit(tree, 0.0, 0)
+    parts.append("</svg>")
+    return "\n".join(parts)
+
+
+# --- main --------------------------------------------------------------------
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    sub = parser.add_subparsers(dest="command", required=True)
+    for name, text in (("flat", "functions by samples"), ("flame", "SVG flame graph core/task/function")):
+        command = sub.add_parser(name, help=text)
+        command.add_argument("capture")
+        command.add_argument("elf")
+        command.add_argument("--nm", default="xtensa-esp32s3-elf-nm")
+        command.add_argument("--core", type=int)
+    sub.choices["flat"].add_argument("--top", type=int, default=40)
+    sub.choices["flame"].add_argument("-o", "--out", required=True)
+    sub.choices["flame"].add_argument("--collapsed", help="also write folded stacks (flamegraph.pl, speedscope)")
+    args = parser.parse_args()
+
+    tasks, samples, dropped = read_capture(args.capture)
+    if not samples:
+        print(f"{args.capture}: no profiler samples")
+        return 1
+    counts = symbolize(samples, tasks, Symbols(args.elf, args.nm), args.core)
+    total = sum(counts.values())
+    lost = sum(dropped.values())
+    print(f"{total} samples, {lost} dropped on the device")
+
+    if args.command == "flat":
+        functions = collections.Counter()
+        per_task = collections.Counter()
+        for (core, task, function), count in counts.items():
+            functions[function] += count
+            per_task[(core, task)] += count
+        print(f"\n{'samples':>8} {'%':>6}  function")
+        for function, count in functions.most_common(args.top):
+            print(f"{count:8d} {100.0 * count / total:6.2f}  {function}")
+        print(f"\n{'samples':>8} {'%':>6}  core task")
+        for (core, task), count in per_task.most_common():
+            print(f"{count:8d} {100.0 * count / total:6.2f}  {core:4d} {task}")
+
+    elif args.command == "flame":
+        stacks = collections.Counter({(f"core{core}", task, function): count
+                                      for (core, task, function), count in counts.items()})
+        with open(args.out, "w") as f:
+            f.write(flame_svg(stacks))
+        if args.collapsed:
+            with open(args.collapsed, "w") as f:
+                for stack, count in sorted(stacks.items()):
+                    f.write(";".join(stack) + f" {count}\n")
+        print(f"{args.out}: {len(stacks)} stacks")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
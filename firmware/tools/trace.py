@@ -0,0 +1,130 @@
+#!/usr/bin/env python3
+"""
+Trace converter for Chess Clock
+
+Turns a dump of the on-device event trace (TRACE_ENABLED, see
+src/trace.cpp) into Chrome trace JSON, which the Perfetto UI
+(ui.perfetto.dev) and chrome://tracing open. Capture the serial output
+until a late input triggers a dump, e.g.
+
+  pio device monitor > capture.log
+
+Lines of the trace start with "@", everything else in the log is ignored:
+
+  @F <cpu MHz>
+  @N <point> <name>
+  @K <task> <task name>
+  @E <core> <cycles hex> <us> <task hex> <point> <phase> <arg>
+  @X
+
+A log may contain several dumps, the last one is converted unless
+--dump selects another (0 is the first). Each core becomes a process and
+each task a thread. Timestamps are taken from the cycle counter of the
+recording core, anchored at the microsecond time of its first event; the
+microsecond time resolves wraps of the 32 bit cycle counter.
+
+Usage:
+  trace.py json capture.log -o trace.json [--dump N]
+  trace.py list capture.log
+"""
+
+import argparse
+import json
+import re
+import sys
+
+FREQUENCY = re.compile(r"@F (\d+)")
+POINT = re.compile(r"@N (\d+) (\S+)")
+TASK = re.compile(r"@K ([0-9a-fA-F]{8}) (\S+)")
+EVENT = re.compile(r"@E (\d) ([0-9a-fA-F]{8}) (\d+) ([0-9a-fA-F]{8}) (\d+) ([BEi]) (\d+)")
+END = re.compile(r"@X")
+
+
+def read_dumps(path):
+    dumps, current = [], None
+    with open(path, errors="replace") as f:
+        for line in f:
+            if m := FREQUENCY.search(line):
+                current = {"mhz": int(m[1]), "points": {}, "tasks": {}, "events": []}
+            elif current is None:
+                continue
+            elif m := POINT.search(line):
+                current["points"][int(m[1])] = m[2]
+            elif m := TASK.search(line):
+                current["tasks"][int(m[1], 16)] = m[2]
+            elif m := EVENT.search(line):
+                current["events"].append((int(m[1]), int(m[2], 16), int(m[3]), int(m[4], 16), int(m[5]),
+                                          m[6], int(m[7])))
+            elif END.search(line):
+                dumps.append(current)
+                current = None
+    return dumps
+
+
+def timestamps(events, mhz):
+    """Microseconds relative to the earliest event, from the cycles of each core"""
+    wrap = (1 << 32) / mhz
+    first = {}
+    for core, cycles, us, *_ in events:
+        first.setdefault(core, (cycles, us))
+    base = min(us for _, us in first.values())
+    result = []
+    for core, cycles, us, *_ in events:
+        cycles0, us0 = first[core]
+        elapsed_us = (us - us0) & 0xFFFFFFFF
+        elapsed = ((cycles - cycles0) & 0xFFFFFFFF) / mhz
+        # The counter wrapped as often as the coarse time says it must have
+        elapsed += round((elapsed_us - elapsed) / wrap) * wrap
+        result.append(((us0 - base) & 0xFFFFFFFF) + elapsed)
+    return result
+
+
+def chrome_trace(dump):
+    events = dump["events"]
+    trace = []
+    for core in sorted({event[0] for event in events}):
+        trace.append({"name": "process_name", "ph": "M", "pid": core, "tid": 0, "args": {"name": f"core {core}"}})
+        for task in sorted({event[3] for event in events if event[0] == core}):
+            name = dump["tasks"].get(task, f"{task:08x}")
+            trace.append({"name": "thread_name", "ph": "M", "pid": core, "tid": task, "args": {"name": name}})
+    for (core, _, _, task, point, phase, arg), ts in zip(events, timestamps(events, dump["mhz"])):
+        event = {"name": dump["points"].get(point, str(point)), "ph": phase, "ts": round(ts, 3), "pid": core,
+                 "tid": task, "args": {"arg": arg}}
+        if phase == "i":
+            event["s"] = "t"
+        trace.append(event)
+    return {"traceEvents": trace, "displayTimeUnit": "ms"}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    sub = parser.add_subparsers(dest="command", required=True)
+    convert = sub.add_parser("json", help="Chrome trace JSON of one dump")
+    convert.add_argument("capture")
+    convert.add_argument("-o", "--out", required=True)
+    convert.add_argument("--dump", type=int, default=-1)
+    listing = sub.add_parser("list", help="dumps in the log")
+    listing.add_argument("capture")
+    args = parser.parse_args()
+
+    dumps = read_dumps(args.capture)
+    if not dumps:
+        print(f"{args.capture}: no complete trace dump", file=sys.stderr)
+        return 1
+
+    if args.command == "list":
+        for index, dump in enumerate(dumps):
+            events = dump["events"]
+            span = max(timestamps(events, dump["mhz"]), default=0) / 1000
+            print(f"{index:3d}: {len(events):6d} events, {span:8.1f} ms, cores {sorted({e[0] for e in events})}")
+
+    elif args.command == "json":
+        dump = dumps[args.dump]
+        with open(args.out, "w") as f:
+            json.dump(chrome_trace(dump), f)
+        print(f"{args.out}: {len(dump['events'])} events")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())